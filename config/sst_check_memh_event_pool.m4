@@ -0,0 +1,12 @@
+AC_DEFUN([SST_CHECK_MEMH_EVENT_POOL], [
+
+AC_ARG_ENABLE([memh-event-pool],
+  [AS_HELP_STRING([--(dis|en)able-memh-event-pool],
+    [allocate memHierarchy events from memHierarchy's per-thread pool instead of SST-Core's allocator [default=disable]])],
+  [sst_check_memh_event_pool_happy="$enableval"],
+  [sst_check_memh_event_pool_happy="no"])
+if test "X$sst_check_memh_event_pool_happy" = "Xyes"; then
+  AC_DEFINE_UNQUOTED([SST_MEMH_EVENT_POOL], 1, "Whether memHierarchy events use memHierarchy's own per-thread pool")
+fi
+
+])
@@ -66,6 +66,7 @@ enum ArielShmemCmd_t {
     ARIEL_ISSUE_RTL = 150,
     ARIEL_FLUSHLINE_INSTRUCTION = 154,
     ARIEL_FENCE_INSTRUCTION = 155,
+    ARIEL_START_ROI = 156,
 };
 
 #ifdef HAVE_CUDA
@@ -20,6 +20,8 @@
 #include <exception>
 #include <stdexcept>
 
+#include "sst/elements/memHierarchy/warmup.h"
+
 #ifdef HAVE_CUDA
 #include <../balar/balar_event.h>
 using namespace SST::BalarComponent;
@@ -858,6 +860,13 @@ bool ArielCore::refillQueue() {
                 performGlobalStatisticOutput();
                 break;
 
+            case ARIEL_START_ROI:
+                // Ends functional warmup in memHierarchy components in this process
+                output->verbose(CALL_INFO, 1, 0, "Core %" PRIu32 " starting the region of interest at %" PRIu64 "ns\n", coreID, getCurrentSimTimeNano());
+                if (!SST::MemHierarchy::Warmup::startROIExternal())
+                    output->verbose(CALL_INFO, 1, 0, "Core %" PRIu32 ": memHierarchy is not loaded, no warmup to end\n", coreID);
+                break;
+
             case ARIEL_START_INSTRUCTION:
                 if(ARIEL_INST_SP_FP == ac.inst.instClass) {
                         statFPSPIns->addData(1);
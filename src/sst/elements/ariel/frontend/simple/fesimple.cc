@@ -105,6 +105,7 @@ SST::Core::Interprocess::SHMChild<GpuReturnTunnel> * tunnelRmgr;
 SST::Core::Interprocess::SHMChild<GpuDataTunnel> * tunnelDmgr;
 #endif
 bool enable_output;
+bool roi_started = false;
 std::vector<void*> allocated_list;
 PIN_LOCK mainLock;
 PIN_LOCK mallocIndexLock;
@@ -604,6 +605,20 @@ VOID InstrumentInstruction(INS ins, VOID *v)
     }
 }
 
+/*
+ * Tell the simulator that the region of interest has started. Components in
+ * functional warmup (e.g., memHierarchy caches) switch to timing mode. Sent on
+ * the first ariel_enable() call, even if tracing was already on (arielmode=1),
+ * so the code before it can be used for warmup.
+ */
+void mapped_ariel_start_roi(THREADID thr)
+{
+    ArielCommand ac;
+    ac.command = ARIEL_START_ROI;
+    ac.instPtr = (uint64_t) 0;
+    tunnel->writeMessage(thr, ac);
+}
+
 /* Intercept ariel_enable() in application & start simulating instructions */
 void mapped_ariel_enable()
 {
@@ -618,8 +633,12 @@ void mapped_ariel_enable()
     THREADID thr = PIN_ThreadId();
     PIN_GetLock(&mainLock, thr);
 
+    bool startROI = !roi_started;
+    roi_started = true;
+
     if (enable_output) {
         PIN_ReleaseLock(&mainLock);
+        if (startROI) mapped_ariel_start_roi(thr);
         return;
     }
 
@@ -645,6 +664,8 @@ void mapped_ariel_enable()
     /* UNLOCK */
     PIN_ReleaseLock(&mainLock);
 
+    if (startROI) mapped_ariel_start_roi(thr);
+
     fprintf(stderr, "ARIEL: Enabling memory and instruction tracing from program control at simulated Ariel cycle %" PRIu64 ".\n",
             tunnel->getCycles());
     fflush(stdout);
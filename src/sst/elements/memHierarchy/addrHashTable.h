@@ -0,0 +1,206 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_ADDRHASHTABLE_H
+#define MEMHIERARCHY_ADDRHASHTABLE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+#include <deque>
+#include <utility>
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ * Open-addressed hash table keyed by address
+ *
+ * The key may also be a pair, e.g., an event ID (SST::Event::id_type).
+ * Pairs are compared in full and both halves are hashed, so two IDs never
+ * share an entry.
+ *
+ * Values live in a pooled slot array and are recycled through an intrusive
+ * free list, so steady-state insert/erase does not allocate. The bucket
+ * array holds slot indices and uses linear probing with backward-shift
+ * deletion (no tombstones). Pointers to values stay valid until the value
+ * is erased.
+ *
+ * Capacity: size the table with the structure's maximum occupancy (e.g.,
+ * the MSHR size). Up to that many entries it behaves as a fixed-capacity
+ * table: buckets are never rehashed and slots are recycled rather than
+ * allocated. Beyond it the bucket array doubles once the load factor
+ * exceeds 1/2 instead of refusing the insert. This is deliberate. MSHRs
+ * also hold entries that are not counted against their limit (evictions,
+ * writebacks, unlimited MSHRs) and these must not fail, so the owner
+ * enforces its own bound and the table only has to stay correct past it.
+ *
+ * T must be default constructible and provide reset(), which is called when
+ * a slot is released so the value's storage (e.g., vector capacity) can be
+ * reused by the next insert.
+ */
+template <typename T, typename K = uint64_t>
+class AddrHashTable {
+    public:
+        typedef K Key;
+
+        AddrHashTable(size_t expectedEntries = 16) : size_(0), freeHead_(NONE) {
+            size_t cap = 16;
+            while (cap < expectedEntries * 2) cap <<= 1;
+            resizeBuckets(cap);
+        }
+
+        size_t size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+
+        /* Return value for 'key' or nullptr */
+        T* find(const Key &key) {
+            size_t b = bucketFor(key);
+            while (buckets_[b] != NONE) {
+                Slot &s = slots_[buckets_[b]];
+                if (s.key == key) return &s.value;
+                b = (b + 1) & mask_;
+            }
+            return nullptr;
+        }
+
+        bool contains(const Key &key) { return find(key) != nullptr; }
+
+        /* Return value for 'key', inserting a (reset) value if not present */
+        T& insert(const Key &key) {
+            T* val = find(key);
+            if (val) return *val;
+            if ((size_ + 1) * 2 > buckets_.size())
+                resizeBuckets(buckets_.size() * 2);
+            uint32_t idx = allocSlot();
+            slots_[idx].key = key;
+            size_t b = bucketFor(key);
+            while (buckets_[b] != NONE)
+                b = (b + 1) & mask_;
+            buckets_[b] = idx;
+            size_++;
+            return slots_[idx].value;
+        }
+
+        /* Remove 'key' and recycle its slot. Returns false if key was not present */
+        bool erase(const Key &key) {
+            size_t b = bucketFor(key);
+            while (buckets_[b] != NONE) {
+                if (slots_[buckets_[b]].key == key) break;
+                b = (b + 1) & mask_;
+            }
+            if (buckets_[b] == NONE) return false;
+
+            freeSlot(buckets_[b]);
+            size_--;
+
+            // Backward-shift following entries so probe sequences stay unbroken
+            size_t hole = b;
+            size_t next = (b + 1) & mask_;
+            while (buckets_[next] != NONE) {
+                size_t home = bucketFor(slots_[buckets_[next]].key);
+                // Move entry into the hole if its home bucket is not in (hole, next]
+                if (((next - home) & mask_) >= ((next - hole) & mask_)) {
+                    buckets_[hole] = buckets_[next];
+                    hole = next;
+                }
+                next = (next + 1) & mask_;
+            }
+            buckets_[hole] = NONE;
+            return true;
+        }
+
+        /* Iterate over occupied entries (order is unspecified) */
+        class iterator {
+            public:
+                iterator(AddrHashTable * t, size_t b) : t_(t), b_(b) { skip(); }
+                const Key& key() const { return t_->slots_[t_->buckets_[b_]].key; }
+                T& value() const { return t_->slots_[t_->buckets_[b_]].value; }
+                iterator& operator++() { b_++; skip(); return *this; }
+                bool operator==(const iterator &o) const { return b_ == o.b_; }
+                bool operator!=(const iterator &o) const { return b_ != o.b_; }
+            private:
+                void skip() { while (b_ < t_->buckets_.size() && t_->buckets_[b_] == NONE) b_++; }
+                AddrHashTable * t_;
+                size_t b_;
+        };
+
+        iterator begin() { return iterator(this, 0); }
+        iterator end() { return iterator(this, buckets_.size()); }
+
+    private:
+        static constexpr uint32_t NONE = (uint32_t)-1;
+
+        struct Slot {
+            Key key;
+            uint32_t nextFree;
+            T value;
+            Slot() : key(), nextFree(NONE) { }
+        };
+
+        /* Fibonacci hashing - addresses are usually line-aligned so the low bits carry no information */
+        size_t bucketFor(const Key &key) const {
+            return (size_t)((fold(key) * 0x9E3779B97F4A7C15ULL) >> shift_);
+        }
+
+        static uint64_t fold(uint64_t key) { return key; }
+
+        /* Scramble the first half so pairs that differ in either half land apart */
+        template <typename A, typename B>
+        static uint64_t fold(const std::pair<A, B> &key) {
+            return (uint64_t)key.first * 0xC2B2AE3D27D4EB4FULL + (uint64_t)key.second;
+        }
+
+        uint32_t allocSlot() {
+            if (freeHead_ != NONE) {
+                uint32_t idx = freeHead_;
+                freeHead_ = slots_[idx].nextFree;
+                return idx;
+            }
+            slots_.emplace_back();  // deque: existing values do not move
+            return slots_.size() - 1;
+        }
+
+        void freeSlot(uint32_t idx) {
+            slots_[idx].value.reset();
+            slots_[idx].nextFree = freeHead_;
+            freeHead_ = idx;
+        }
+
+        void resizeBuckets(size_t cap) {
+            std::vector<uint32_t> old;
+            old.swap(buckets_);
+            buckets_.assign(cap, NONE);
+            mask_ = cap - 1;
+            shift_ = 64;
+            for (size_t c = cap; c > 1; c >>= 1) shift_--;
+            for (size_t i = 0; i < old.size(); i++) {
+                if (old[i] == NONE) continue;
+                size_t b = bucketFor(slots_[old[i]].key);
+                while (buckets_[b] != NONE)
+                    b = (b + 1) & mask_;
+                buckets_[b] = old[i];
+            }
+        }
+
+        std::vector<uint32_t> buckets_;
+        std::deque<Slot> slots_;
+        size_t mask_;
+        unsigned shift_;
+        size_t size_;
+        uint32_t freeHead_;
+};
+
+}}
+#endif // MEMHIERARCHY_ADDRHASHTABLE_H
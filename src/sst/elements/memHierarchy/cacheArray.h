@@ -17,6 +17,13 @@
 #define CACHEARRAY_H
 
 #include <vector>
+#include <functional>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 #include <sst/core/output.h>
 
@@ -25,14 +32,49 @@
 #include "sst/elements/memHierarchy/util.h"
 #include "sst/elements/memHierarchy/replacementManager.h"
 #include "sst/elements/memHierarchy/lineTypes.h"
+#include "sst/elements/memHierarchy/cacheCheckpoint.h"
 
 using namespace std;
 
 namespace SST { namespace MemHierarchy {
 
+/*
+ * Return the index of the first tag in tags[0..n) equal to addr, or -1.
+ * Compares all ways of a set at once with AVX2 (4 tags per compare) or SSE2
+ * (2 tags per compare) when the compiler targets them; scalar otherwise.
+ */
+inline int findTag(const Addr* tags, unsigned int n, Addr addr) {
+    unsigned int i = 0;
+#if defined(__AVX2__)
+    const __m256i key = _mm256_set1_epi64x(addr);
+    for (; i + 4 <= n; i += 4) {
+        __m256i cmp = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i*)(tags + i)), key);
+        int mask = _mm256_movemask_pd(_mm256_castsi256_pd(cmp));
+        if (mask) return i + __builtin_ctz(mask);
+    }
+#elif defined(__SSE2__)
+    const __m128i key = _mm_set1_epi64x(addr);
+    for (; i + 2 <= n; i += 2) {
+        // No 64-bit compare in SSE2: compare 32-bit halves and require both to match
+        __m128i cmp = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(tags + i)), key);
+        cmp = _mm_and_si128(cmp, _mm_shuffle_epi32(cmp, _MM_SHUFFLE(2,3,0,1)));
+        int mask = _mm_movemask_pd(_mm_castsi128_pd(cmp));
+        if (mask) return i + __builtin_ctz(mask);
+    }
+#endif
+    for (; i < n; i++) {
+        if (tags[i] == addr) return i;
+    }
+    return -1;
+}
+
 /*
  * CacheArrays should  be templated on a line type
  * See the comment in lineTypes.h for the required API
+ *
+ * Line addresses are mirrored in a contiguous tag array (tags_, indexed like
+ * lines_) so that lookup() scans a set without dereferencing line objects.
+ * replace() is the only place a line's address changes, and it keeps both in sync.
  */
 
 template <class T>
@@ -50,8 +92,9 @@ class CacheArray {
         Addr            sliceStep_; // For cache slices
         unsigned int    banks_;
         vector<T*>      lines_; // The actual cache
-        State* setStates;
-        std::map<unsigned int, std::vector<ReplacementInfo*> > rInfo;   // Lookup a vector of replacementInfo by set ID
+        vector<Addr>    tags_;  // Structure-of-arrays copy of each line's address for fast set lookup
+        std::vector<std::vector<ReplacementInfo*> > rInfo;  // Lookup a vector of replacementInfo by set ID
+        std::vector<uint64_t> invalidWays_; // Per set, bit per way set while the line is invalid (associativity <= 64)
     public:
 
         CacheArray(Output* dbg, unsigned int numLines, unsigned int associativity, uint32_t lineSize, ReplacementPolicy* replacementMgr, HashFunction* hash);
@@ -85,6 +128,17 @@ class CacheArray {
         /** Deallocate a line and notify replacement manager that it's been deallocated */
         void deallocate(T* candidate);
 
+    /**** Checkpointing */
+
+        /** Record geometry, replacement state, and all lines in a stable state */
+        void saveCheckpoint(CacheCheckpoint::Section &sec);
+
+        /** Restore lines from a section. Lines keep their saved index when geometry and set mapping allow,
+            otherwise they are re-inserted through the replacement policy. 'onRestore' is called on each
+            restored line (e.g., to link a data line to its directory entry). */
+        void loadCheckpoint(const CacheCheckpoint::Section &sec, CacheCheckpoint::LoadStats &stats,
+                std::function<void(T*)> onRestore = nullptr);
+
     /**** Configuration and output */
         void setSliceAware(Addr size, Addr step);
         void setBanked(unsigned int numBanks);
@@ -121,22 +175,31 @@ CacheArray<T>::CacheArray(Output* dbg, unsigned int numLines, unsigned int assoc
     sliceSize_ = 1;
     banks_ = 1;
 
+    tags_.resize(numLines_);
     for (unsigned int i = 0; i < numLines_; i++) {
         lines_[i] = new T(lineSize_, i);
+        tags_[i] = lines_[i]->getAddr();
     }
 
     // Construct rInfo
+    rInfo.resize(numSets_);
     for (unsigned int i = 0; i < numSets_; i++) {
-        std::vector<ReplacementInfo*> setInfo;
+        rInfo[i].reserve(associativity);
         for (unsigned int j = 0; j < associativity; j++)
-            setInfo.push_back(lines_[i*associativity + j]->getReplacementInfo());
-        rInfo.insert(std::make_pair(i, setInfo));
+            rInfo[i].push_back(lines_[i*associativity + j]->getReplacementInfo());
     }
-    ReplacementInfo * info = rInfo.find(0)->second.front();
+
+    // Lines keep their set's invalid-way mask current so policies find an invalid way without scanning
+    if (associativity_ <= 64) {
+        invalidWays_.resize(numSets_, 0);
+        for (unsigned int i = 0; i < numSets_; i++) {
+            for (unsigned int j = 0; j < associativity; j++)
+                rInfo[i][j]->trackInvalid(&invalidWays_[i], 1ULL << j);
+        }
+    }
+    ReplacementInfo * info = rInfo[0].front();
     if (!replacementMgr_->checkCompatibility(info))
         dbg_->fatal(CALL_INFO, -1, "CacheArray, Error: The replacement policy expects cache line state that is not provided by the cache line type of this cache. Check the type of the ReplacementInfo returned by the coherence protocol's line type and the ReplacementInfo type expected by the replacement policy.\n");
-
-    setStates = new State[associativity_];
 }
 
 template <class T>
@@ -145,7 +208,6 @@ CacheArray<T>::~CacheArray() {
         delete lines_[i];
     delete replacementMgr_;
     delete hash_;
-    delete [] setStates;
 }
 
 template <class T>
@@ -161,16 +223,15 @@ T* CacheArray<T>::lookup(const Addr addr, bool updateReplacement) {
     Addr laddr = toLineAddr(addr);
     int set = hash_->hash(0, laddr) % numSets_;
     int setBegin = set * associativity_;
-    int setEnd = setBegin + associativity_;
 
-    for (int i = setBegin; i < setEnd; i++) {
-        if (lines_[i]->getAddr() == addr) {
-            if (updateReplacement)
-                replacementMgr_->update(i, lines_[i]->getReplacementInfo());
-            return lines_[i];
-        }
-    }
-    return nullptr; // Not found
+    int way = findTag(&tags_[setBegin], associativity_, addr);
+    if (way < 0)
+        return nullptr; // Not found
+
+    int i = setBegin + way;
+    if (updateReplacement)
+        replacementMgr_->update(i, lines_[i]->getReplacementInfo());
+    return lines_[i];
 }
 
 template <class T>
@@ -189,7 +250,8 @@ void CacheArray<T>::replace(Addr addr, T* candidate) {
     replacementMgr_->replaced(index);
     candidate->reset();
     candidate->setAddr(addr);
-    replacementMgr_->update(index, lines_[index]->getReplacementInfo());
+    tags_[index] = addr;
+    replacementMgr_->insert(index, addr, lines_[index]->getReplacementInfo());
 }
 
 template <class T>
@@ -199,6 +261,87 @@ void CacheArray<T>::deallocate(T* candidate) {
     candidate->reset();
 }
 
+template <class T>
+void CacheArray<T>::saveCheckpoint(CacheCheckpoint::Section &sec) {
+    sec.lineSize = lineSize_;
+    sec.numLines = numLines_;
+    sec.associativity = associativity_;
+    sec.policy = replacementMgr_->getType();
+    replacementMgr_->saveState(sec.replState);
+
+    // Transient states belong to in-flight transactions, which are not checkpointed
+    for (unsigned int i = 0; i < numLines_; i++) {
+        State state = lines_[i]->getState();
+        if (state != S && state != E && state != O && state != M)
+            continue;
+        sec.lines.push_back(CacheCheckpoint::Line());
+        lines_[i]->saveCheckpoint(sec.lines.back());
+    }
+}
+
+template <class T>
+void CacheArray<T>::loadCheckpoint(const CacheCheckpoint::Section &sec, CacheCheckpoint::LoadStats &stats, std::function<void(T*)> onRestore) {
+    bool exact = sec.numLines == numLines_ && sec.associativity == associativity_ && sec.lineSize == lineSize_;
+    bool split = sec.lineSize > lineSize_ && (sec.lineSize % lineSize_) == 0;
+    std::vector<unsigned int> restored;
+    uint64_t reinserted = stats.reinserted;
+
+    // Sub-lines cannot be merged: a larger line would need every piece, in compatible states, from the same checkpoint
+    if (sec.lineSize != lineSize_ && !split && !sec.lines.empty())
+        dbg_->fatal(CALL_INFO, -1, "CacheArray, Error: checkpoint section '%s' has %" PRIu32 "B lines but this cache has %" PRIu32 "B lines. "
+                "Saved lines can be split into smaller lines but not merged into larger ones. Restore into a cache whose line size divides %" PRIu32 ".\n",
+                sec.name.c_str(), sec.lineSize, lineSize_, sec.lineSize);
+
+    for (size_t r = 0; r < sec.lines.size(); r++) {
+        const CacheCheckpoint::Line &saved = sec.lines[r];
+
+        // Saved lines larger than ours are split into several lines with the same state
+        unsigned int pieces = split ? sec.lineSize / lineSize_ : 1;
+        for (unsigned int p = 0; p < pieces; p++) {
+            CacheCheckpoint::Line piece;
+            const CacheCheckpoint::Line * rec = &saved;
+            if (split) {
+                piece = saved;
+                piece.addr = saved.addr + p * lineSize_;
+                if (saved.data.size() == sec.lineSize)
+                    piece.data.assign(saved.data.begin() + p * lineSize_, saved.data.begin() + (p + 1) * lineSize_);
+                rec = &piece;
+            }
+
+            T* line = nullptr;
+            if (exact && rec->index < numLines_) {
+                unsigned int set = hash_->hash(0, toLineAddr(rec->addr)) % numSets_;
+                if (rec->index / associativity_ == set && lines_[rec->index]->getState() == I)
+                    line = lines_[rec->index];
+            }
+            if (!line) {
+                line = findReplacementCandidate(rec->addr);
+                if (line->getState() != I) {
+                    stats.dropped++;
+                    if (rec->state == M) stats.droppedDirty++;
+                    continue;
+                }
+                stats.reinserted++;
+            }
+
+            replace(rec->addr, line);
+            line->loadCheckpoint(*rec);
+            if (onRestore)
+                onRestore(line);
+            restored.push_back(line->getIndex());
+            stats.restored++;
+        }
+    }
+
+    // Replacement state only makes sense if every line is where it was; otherwise replay accesses in saved order
+    if (exact && stats.reinserted == reinserted && sec.policy == replacementMgr_->getType() && replacementMgr_->loadState(sec.replState)) {
+        stats.replacementRestored = true;
+    } else {
+        for (size_t i = 0; i < restored.size(); i++)
+            replacementMgr_->update(restored[i], lines_[restored[i]]->getReplacementInfo());
+    }
+}
+
 template <class T>
 void CacheArray<T>::setSliceAware(Addr size, Addr step) {
     sliceSize_ = size >> lineOffset_;
@@ -0,0 +1,231 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_CACHECHECKPOINT_H
+#define MEMHIERARCHY_CACHECHECKPOINT_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <deque>
+
+#include "sst/elements/memHierarchy/util.h"
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ * Checkpoint of cache contents
+ *
+ * A checkpoint holds one named section per cache array (e.g., "cache", or
+ * "directory" and "data" for caches with a separate directory). A section
+ * records the array geometry, the replacement policy's type and state, and
+ * every valid line: address, index, coherence state, owner/sharers (by name,
+ * since sharer IDs are per-run) and data if the line holds any.
+ *
+ * File layout (host byte order):
+ *   "SSTCACHE" | version:u32 | sections:u32 | section*
+ *   section: name | lineSize:u32 | lines:u64 | assoc:u64 | policy | replState:u64[] | records:u64 | record*
+ *   record:  addr:u64 | index:u64 | state:u8 | flags:u8 | owner | sharers:u32 | name* | data:u32 | byte*
+ * Strings are a u32 length followed by the bytes.
+ */
+class CacheCheckpoint {
+    public:
+        static constexpr uint32_t VERSION = 1;
+
+        struct Line {
+            enum Flags : uint8_t { PREFETCH = 0x1, SHARED = 0x2, OWNED = 0x4 };
+
+            Addr addr;
+            uint64_t index;
+            uint8_t state;
+            uint8_t flags;
+            std::string owner;
+            std::vector<std::string> sharers;
+            std::vector<uint8_t> data;
+
+            Line() : addr(0), index(0), state(0), flags(0) { }
+        };
+
+        struct Section {
+            std::string name;
+            uint32_t lineSize;
+            uint64_t numLines;
+            uint64_t associativity;
+            std::string policy;                 // Replacement policy type, state is only restored into the same type
+            std::vector<uint64_t> replState;
+            std::vector<Line> lines;
+        };
+
+        /* Summary of a restore, for reporting */
+        struct LoadStats {
+            uint64_t restored;      // Lines restored
+            uint64_t reinserted;    // Of those, lines that could not keep their saved index
+            uint64_t dropped;       // Lines that found no free way
+            uint64_t droppedDirty;  // Of those, lines in M state
+            bool replacementRestored;
+            LoadStats() : restored(0), reinserted(0), dropped(0), droppedDirty(0), replacementRestored(false) { }
+        };
+
+        Section& addSection(const std::string &name) {
+            sections_.push_back(Section());
+            sections_.back().name = name;
+            return sections_.back();
+        }
+
+        const Section* getSection(const std::string &name) const {
+            for (size_t i = 0; i < sections_.size(); i++) {
+                if (sections_[i].name == name) return &sections_[i];
+            }
+            return nullptr;
+        }
+
+        /* Returns false on an I/O error */
+        bool write(const std::string &file) const {
+            std::vector<uint8_t> buf;
+            buf.insert(buf.end(), MAGIC, MAGIC + 8);
+            put32(buf, VERSION);
+            put32(buf, sections_.size());
+            for (size_t s = 0; s < sections_.size(); s++) {
+                const Section &sec = sections_[s];
+                putString(buf, sec.name);
+                put32(buf, sec.lineSize);
+                put64(buf, sec.numLines);
+                put64(buf, sec.associativity);
+                putString(buf, sec.policy);
+                put64(buf, sec.replState.size());
+                for (size_t i = 0; i < sec.replState.size(); i++)
+                    put64(buf, sec.replState[i]);
+                put64(buf, sec.lines.size());
+                for (size_t l = 0; l < sec.lines.size(); l++) {
+                    const Line &line = sec.lines[l];
+                    put64(buf, line.addr);
+                    put64(buf, line.index);
+                    buf.push_back(line.state);
+                    buf.push_back(line.flags);
+                    putString(buf, line.owner);
+                    put32(buf, line.sharers.size());
+                    for (size_t i = 0; i < line.sharers.size(); i++)
+                        putString(buf, line.sharers[i]);
+                    put32(buf, line.data.size());
+                    buf.insert(buf.end(), line.data.begin(), line.data.end());
+                }
+            }
+
+            FILE* fp = fopen(file.c_str(), "wb");
+            if (!fp) return false;
+            bool ok = fwrite(buf.data(), 1, buf.size(), fp) == buf.size();
+            return (fclose(fp) == 0) && ok;
+        }
+
+        /* Returns an empty string on success, otherwise a description of the error */
+        std::string read(const std::string &file) {
+            FILE* fp = fopen(file.c_str(), "rb");
+            if (!fp) return "unable to open file";
+            std::vector<uint8_t> buf;
+            uint8_t chunk[65536];
+            size_t n;
+            while ((n = fread(chunk, 1, sizeof(chunk), fp)) > 0)
+                buf.insert(buf.end(), chunk, chunk + n);
+            fclose(fp);
+
+            Reader rd(buf);
+            if (buf.size() < 8 || memcmp(buf.data(), MAGIC, 8) != 0) return "not a cache checkpoint";
+            rd.pos = 8;
+            uint32_t version = rd.get32();
+            if (version != VERSION) return "unsupported checkpoint version " + std::to_string(version);
+            uint32_t count = rd.get32();
+            sections_.clear();
+            for (uint32_t s = 0; s < count && rd.ok; s++) {
+                Section &sec = addSection(rd.getString());
+                sec.lineSize = rd.get32();
+                sec.numLines = rd.get64();
+                sec.associativity = rd.get64();
+                sec.policy = rd.getString();
+                uint64_t words = rd.get64();
+                for (uint64_t i = 0; i < words && rd.ok; i++)
+                    sec.replState.push_back(rd.get64());
+                uint64_t lines = rd.get64();
+                for (uint64_t l = 0; l < lines && rd.ok; l++) {
+                    sec.lines.push_back(Line());
+                    Line &line = sec.lines.back();
+                    line.addr = rd.get64();
+                    line.index = rd.get64();
+                    line.state = rd.get8();
+                    line.flags = rd.get8();
+                    line.owner = rd.getString();
+                    uint32_t sharers = rd.get32();
+                    for (uint32_t i = 0; i < sharers && rd.ok; i++)
+                        line.sharers.push_back(rd.getString());
+                    uint32_t bytes = rd.get32();
+                    if (rd.need(bytes)) {
+                        line.data.assign(buf.begin() + rd.pos, buf.begin() + rd.pos + bytes);
+                        rd.pos += bytes;
+                    }
+                }
+            }
+            return rd.ok ? "" : "file is truncated or corrupt";
+        }
+
+    private:
+        static constexpr const char* MAGIC = "SSTCACHE";
+
+        static void put32(std::vector<uint8_t> &buf, uint32_t v) {
+            buf.insert(buf.end(), (uint8_t*)&v, (uint8_t*)&v + sizeof(v));
+        }
+        static void put64(std::vector<uint8_t> &buf, uint64_t v) {
+            buf.insert(buf.end(), (uint8_t*)&v, (uint8_t*)&v + sizeof(v));
+        }
+        static void putString(std::vector<uint8_t> &buf, const std::string &str) {
+            put32(buf, str.size());
+            buf.insert(buf.end(), str.begin(), str.end());
+        }
+
+        /* Bounds-checked cursor; once a read overruns, 'ok' stays false and reads return 0 */
+        struct Reader {
+            const std::vector<uint8_t> &buf;
+            size_t pos;
+            bool ok;
+            Reader(const std::vector<uint8_t> &b) : buf(b), pos(0), ok(true) { }
+            bool need(size_t n) {
+                ok = ok && (buf.size() - pos >= n);
+                return ok;
+            }
+            uint8_t get8() { return need(1) ? buf[pos++] : 0; }
+            uint32_t get32() {
+                uint32_t v = 0;
+                if (need(sizeof(v))) { memcpy(&v, &buf[pos], sizeof(v)); pos += sizeof(v); }
+                return v;
+            }
+            uint64_t get64() {
+                uint64_t v = 0;
+                if (need(sizeof(v))) { memcpy(&v, &buf[pos], sizeof(v)); pos += sizeof(v); }
+                return v;
+            }
+            std::string getString() {
+                uint32_t len = get32();
+                if (!need(len)) return "";
+                std::string str((const char*)&buf[pos], len);
+                pos += len;
+                return str;
+            }
+        };
+
+        std::deque<Section> sections_;  // deque so references returned by addSection() stay valid
+};
+
+}}
+#endif // MEMHIERARCHY_CACHECHECKPOINT_H
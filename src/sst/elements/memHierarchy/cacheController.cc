@@ -22,6 +22,7 @@
 #include "memEvent.h"
 #include "mshr.h"
 #include "coherencemgr/coherenceController.h"
+#include "sharerSet.h"
 
 
 using namespace SST;
@@ -40,10 +41,28 @@ void Cache::handleEvent(SST::Event * ev) {
     if (!clockIsOn_)
         turnClockOn();
 
+    if (warmup_.active()) {
+        if (warmupHasROIAddr_ && MemEventTypeArr[(int)event->getCmd()] == MemEventType::Cache
+                && static_cast<MemEvent*>(event)->getAddr() == warmupROIAddr_)
+            Warmup::startROI();
+        if (warmup_.roiStarted())
+            endWarmup();
+    }
+
     // Record the time at which requests arrive for latency statistics
-    if (CommandClassArr[(int)event->getCmd()] == CommandClass::Request && !CommandWriteback[(int)event->getCmd()])
+    if (CommandClassArr[(int)event->getCmd()] == CommandClass::Request && !CommandWriteback[(int)event->getCmd()]) {
         coherenceMgr_->recordIncomingRequest(event);
 
+        // Sample requests for latency tracing
+        if (traceRate_ != 0 && !event->isTraced() && ++traceCount_ == traceRate_) {
+            traceCount_ = 0;
+            event->startTrace(LatencyTrace::makeID(traceWire_, ++traceSeq_));
+        }
+    }
+    if (event->isTraced())
+        event->addTraceStamp(LatencyTrace::Point::CacheArrive, getCurrentSimCycle());
+    flightRecorder_.record(getCurrentSimCycle(), FlightRecorder::Recv, event);
+
     // Record that an event was received
     if (MemEventTypeArr[(int)event->getCmd()] != MemEventType::Cache || event->queryFlag(MemEventBase::F_NONCACHEABLE)) {
         statUncacheRecv[(int)event->getCmd()]->addData(1);
@@ -235,6 +254,9 @@ bool Cache::processEvent(MemEventBase* ev, bool inMSHR) {
     }
 
     if (MemEventTypeArr[(int)ev->getCmd()] != MemEventType::Cache || ev->queryFlag(MemEventBase::F_NONCACHEABLE)) {
+        if (ev->isTraced())
+            ev->addTraceStamp(LatencyTrace::Point::CacheStart, getCurrentSimCycle());
+        flightRecorder_.record(getCurrentSimCycle(), FlightRecorder::Handle, ev);
         processNoncacheable(ev);
         return true;
     }
@@ -256,6 +278,9 @@ bool Cache::processEvent(MemEventBase* ev, bool inMSHR) {
         return false;
     }
 
+    if (event->isTraced())
+        traceEvent(event, inMSHR);
+
     bool dbgevent = is_debug_event(event);
     bool accepted = false;
 
@@ -343,6 +368,10 @@ bool Cache::processEvent(MemEventBase* ev, bool inMSHR) {
     if (dbgevent)
         coherenceMgr_->printDebugInfo();
 
+    // Record the state the line was left in
+    if (flightRecorder_.enabled())
+        flightRecorder_.record(getCurrentSimCycle(), accepted ? FlightRecorder::Handle : FlightRecorder::Stall, event, coherenceMgr_->getLineState(addr));
+
     if (accepted)
         updateAccessStatus(addr);
 
@@ -434,6 +463,8 @@ void Cache::checkTimeout() {
  **************************************************************************/
 
 void Cache::init(unsigned int phase) {
+    if (phase == 0 && !checkpointLoadDir_.empty())
+        loadCheckpoint();
 
     // Case: 1 link
     if (linkUp_ == linkDown_) {
@@ -523,6 +554,12 @@ void Cache::setup() {
     if (linkUp_ != linkDown_) 
         linkDown_->setup();
 
+    // Assign compact sharer IDs to our sources in name order
+    std::set<std::string> srcNames;
+    for (std::set<MemLinkBase::EndpointInfo>::iterator it = linkUp_->getSources()->begin(); it != linkUp_->getSources()->end(); it++)
+        srcNames.insert(it->name);
+    SharerIDMap::registerNames(srcNames);
+
     // Enqueue the first wakeup event to check for deadlock
     if (timeout_ != 0)
         timeoutSelfLink_->send(1, nullptr);
@@ -537,12 +574,116 @@ void Cache::finish() {
         listeners_[i]->printStats(*out_);
     linkDown_->finish();
     if (linkUp_ != linkDown_) linkUp_->finish();
+
+    if (checkpointAtFinish_ && !checkpointSaveDir_.empty())
+        saveCheckpoint();
+
+    if (traceFile_) {
+        fclose(traceFile_);
+        traceFile_ = nullptr;
+    }
+
+    if (flightRecorderAtFinish_)
+        dumpFlightRecorder();
+}
+
+
+/* Checkpoint lines in a stable state. Lines in the middle of a transaction are skipped,
+ * so checkpoints are best taken when the cache is quiescent (e.g., at the end of simulation) */
+void Cache::saveCheckpoint() {
+    CacheCheckpoint ckpt;
+    coherenceMgr_->saveCheckpoint(ckpt);
+    std::string file = checkpointSaveDir_ + "/" + getName() + ".ckpt";
+    if (!ckpt.write(file))
+        out_->fatal(CALL_INFO, -1, "%s, Error: unable to write cache checkpoint to '%s'\n", getName().c_str(), file.c_str());
+}
+
+
+void Cache::loadCheckpoint() {
+    CacheCheckpoint ckpt;
+    std::string file = checkpointLoadDir_ + "/" + getName() + ".ckpt";
+    std::string error = ckpt.read(file);
+    if (!error.empty())
+        out_->fatal(CALL_INFO, -1, "%s, Error: unable to load cache checkpoint '%s': %s\n", getName().c_str(), file.c_str(), error.c_str());
+
+    CacheCheckpoint::LoadStats stats;
+    coherenceMgr_->loadCheckpoint(ckpt, stats);
+    if (stats.reinserted != 0 || stats.dropped != 0 || !stats.replacementRestored) {
+        out_->verbose(CALL_INFO, 1, 0, "%s, Notice: cache geometry or replacement policy differs from checkpoint '%s'. "
+                "Restored %" PRIu64 " lines (%" PRIu64 " re-inserted), dropped %" PRIu64 " lines (%" PRIu64 " dirty).\n",
+                getName().c_str(), file.c_str(), stats.restored, stats.reinserted, stats.dropped, stats.droppedDirty);
+    }
+}
+
+
+/*
+ * Stamp a traced event as the cache starts handling it. A response hands its
+ * stamps to the request waiting for it, so the response this cache sends
+ * up carries the whole path.
+ */
+void Cache::traceEvent(MemEvent* event, bool inMSHR) {
+    event->addTraceStamp(inMSHR ? LatencyTrace::Point::CacheReplay : LatencyTrace::Point::CacheStart, getCurrentSimCycle());
+    if (BasicCommandClassArr[(int)event->getCmd()] == BasicCommandClass::Response) {
+        MemEventBase* req = mshr_->getEntryEvent(event->getBaseAddr(), 0);
+        if (req)
+            req->adoptTrace(event);
+    }
+}
+
+
+/* A traced request started here has been answered. Record its breakdown. */
+void Cache::finishTrace(MemEventBase* event) {
+    const std::vector<uint64_t>& trace = event->getTrace();
+    uint64_t stages[LatencyTrace::NUM_STAGES];
+    uint64_t total = LatencyTrace::breakdown(trace, stages);
+    for (unsigned i = 0; i < LatencyTrace::NUM_STAGES; i++)
+        statTraceStage[i]->addData(traceTimeBase_->convertFromCoreTime(stages[i]));
+    statTraceTotal->addData(traceTimeBase_->convertFromCoreTime(total));
+
+    if (!traceFile_)
+        return;
+    uint64_t id = event->getTraceID();
+    uint32_t header[2] = { (uint32_t)event->getCmd(), (uint32_t)trace.size() };
+    fwrite(&id, sizeof(id), 1, traceFile_);
+    fwrite(header, sizeof(header), 1, traceFile_);
+    for (size_t i = 0; i < trace.size(); i++) {
+        uint64_t stamp = LatencyTrace::pack(LatencyTrace::point(trace[i]), traceTimeBase_->convertFromCoreTime(LatencyTrace::time(trace[i])));
+        fwrite(&stamp, sizeof(stamp), 1, traceFile_);
+    }
+}
+
+
+void Cache::dumpFlightRecorder() {
+    if (!flightRecorder_.enabled())
+        return;
+    std::string file = flightRecorderDir_ + "/" + getName() + ".flight";
+    if (!flightRecorder_.dump(file, getName(), getCurrentSimCycle(), CommandString, (uint32_t)Command::LAST_CMD, StateString, LAST_STATE, EndpointRegistry::getName))
+        out_->output("%s, Warning: unable to write flight recorder to '%s'\n", getName().c_str(), file.c_str());
+}
+
+
+/* Switch to timing mode. Events already in flight finish with warmup timing. */
+void Cache::endWarmup() {
+    if (!warmup_.end())
+        return;
+    coherenceMgr_->setWarmup(false);
+    maxRequestsPerCycle_ = warmupMaxRequestsPerCycle_;
+    banked_ = warmupBanked_;
+    mshr_->setMaxSize(warmupMSHRSize_);
+    out_->verbose(CALL_INFO, 2, 0, "%s, Notice: warmup ended at %" PRIu64 "ns\n", getName().c_str(), getCurrentSimTimeNano());
+    if (Warmup::firstToEnd())
+        performGlobalStatisticOutput();
 }
 
 
 void Cache::printStatus(Output &out) {
+    if (checkpointOnSignal_ && !checkpointSaveDir_.empty())
+        saveCheckpoint();
+    dumpFlightRecorder();
     out.output("MemHierarchy::Cache %s\n", getName().c_str());
     out.output("  Clock is %s. Last active cycle: %" PRIu64 "\n", clockIsOn_ ? "on" : "off", timestamp_);
+    if (warmup_.active())
+        out.output("  In functional warmup\n");
     out.output("  Events in queues: Retry = %zu, Event = %zu, Prefetch = %zu\n", retryBuffer_.size(), eventBuffer_.size(), prefetchBuffer_.size());
     if (mshr_) {
         out.output("  MSHR Status:\n");
@@ -575,6 +716,8 @@ void Cache::emergencyShutdown() {
             out_->output("  Checking for unreceived events on link: \n");
         }
         linkDown_->emergencyShutdownDebug(*out_);
+    } else {
+        dumpFlightRecorder(); // printStatus() does this otherwise
     }
 }
 
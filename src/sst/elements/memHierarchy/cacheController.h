@@ -17,6 +17,7 @@
 #define MEMHIERARCHY_CACHECONTROLLER_H_
 
 #include <queue>
+#include <cstdio>
 #include <map>
 #include <string>
 #include <sstream>
@@ -35,6 +36,9 @@
 #include "sst/elements/memHierarchy/util.h"
 #include "sst/elements/memHierarchy/cacheListener.h"
 #include "sst/elements/memHierarchy/memLinkBase.h"
+#include "sst/elements/memHierarchy/warmup.h"
+#include "sst/elements/memHierarchy/latencyTrace.h"
+#include "sst/elements/memHierarchy/flightRecorder.h"
 
 namespace SST { namespace MemHierarchy {
 
@@ -90,6 +94,18 @@ public:
             {"force_noncacheable_reqs", "(bool) Used for verification purposes. All requests are considered to be 'noncacheable'. Options: 0[off], 1[on]", "false"},
             {"min_packet_size",         "(string) Number of bytes in a request/response not including payload (e.g., addr + cmd). Specify in B.", "8B"},
             {"banks",                   "(uint) Number of cache banks: One access per bank per cycle. Use '0' to simulate no bank limits (only limits on bandwidth then are max_requests_per_cycle and *_link_width", "0"},
+            {"checkpoint_load_dir",     "(string) Directory to restore cache contents from during init. Reads '<dir>/<cache name>.ckpt'. The saved line size must be a multiple of this cache's line size. Empty to disable.", ""},
+            {"checkpoint_save_dir",     "(string) Directory to write cache contents to as '<dir>/<cache name>.ckpt'. Empty to disable.", ""},
+            {"checkpoint_save_time",    "(string) Simulation time at which to write the checkpoint (e.g., '1ms'). If empty, the checkpoint is written at the end of simulation.", ""},
+            {"checkpoint_on_signal",    "(bool) Also write the checkpoint whenever the status dump signal (SIGUSR2) is received", "false"},
+            {"warmup",                  "(bool) Start in functional warmup mode: cache state updates but access latencies, request/bank/bandwidth limits, and MSHR limits are not modeled", "false"},
+            {"warmup_end",              "(string) Simulation time at which warmup ends (e.g., '10ms'). If empty, warmup ends when the region of interest starts.", ""},
+            {"warmup_roi_addr",         "(uint) A request to this address starts the region of interest, ending warmup in every memHierarchy component in this process. Empty to disable.", ""},
+            {"latency_trace_rate",      "(uint) Trace the latency breakdown of 1 in every N requests received by this cache. 0 to disable.", "0"},
+            {"latency_trace_file",      "(string) File to write each traced latency breakdown to, in the binary format described in latencyTrace.h. Empty for statistics only.", ""},
+            {"flight_recorder_size",    "(uint) Number of recent events to keep in the flight recorder (rounded up to a power of 2). 0 to disable.", "1024"},
+            {"flight_recorder_dir",     "(string) Directory to write the flight recorder to as '<dir>/<cache name>.flight' on a fatal error or the status dump signal (SIGUSR2). Decode with sst-memh-flightdecode.", "."},
+            {"flight_recorder_dump_at_finish", "(bool) Also write the flight recorder at the end of simulation", "false"},
             /* Old parameters - deprecated or moved */
             {"network_address",             "DEPRECATED - Now auto-detected by link control."}, // Remove 9.0
             {"network_bw",                  "MOVED - Now a member of the MemNIC subcomponent.", "80GiB/s"}, // Remove 9.0
@@ -157,6 +173,12 @@ public:
             {"GetSX_uncache_recv",      "Noncacheable Event: GetSX received", "count", 4},
             {"GetSResp_uncache_recv",   "Noncacheable Event: GetSResp received", "count", 4},
             {"WriteResp_uncache_recv",  "Noncacheable Event: WriteResp received", "count", 4},
+            {"latency_trace_queue",     "Traced requests: time spent in event buffers, NIC send queues, and memory request queues", "ps", 3},
+            {"latency_trace_mshr",      "Traced requests: time spent stalled in an MSHR", "ps", 3},
+            {"latency_trace_access",    "Traced requests: cache and directory access time", "ps", 3},
+            {"latency_trace_network",   "Traced requests: time spent on links and in the network", "ps", 3},
+            {"latency_trace_memory",    "Traced requests: time spent in the memory backend", "ps", 3},
+            {"latency_trace_total",     "Traced requests: total latency from arrival at this cache to the response leaving it", "ps", 3},
             {"default_stat",            "Default statistic used for unexpected events/cases/etc. Should be 0, if not, check for missing statistic registrations.", "none", 7})
 
     SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(
@@ -251,6 +273,20 @@ private:
     // Process coherence initialization events
     void processInitCoherenceEvent(MemEventInitCoherence* event, bool src);
 
+    // Checkpoint cache contents to/from '<dir>/<name>.ckpt'
+    void saveCheckpoint();
+    void loadCheckpoint();
+
+    // Switch from functional warmup to timing mode
+    void endWarmup();
+
+    // Latency tracing - stamp an event, and record a finished trace
+    void traceEvent(MemEvent* event, bool inMSHR);
+    void finishTrace(MemEventBase* event);
+
+    // Write the flight recorder to '<dir>/<name>.flight'
+    void dumpFlightRecorder();
+
 
     /** Cache structures *******************************************************/
     std::vector<CacheListener*> listeners_; // Cache listeners, including prefetchers
@@ -272,6 +308,31 @@ private:
     SimTime_t           timeout_;
     uint64_t            maxOutstandingPrefetch_;
     bool                banked_;
+    std::string         checkpointLoadDir_;
+    std::string         checkpointSaveDir_;
+    bool                checkpointAtFinish_;    // Save at finish() rather than at checkpoint_save_time
+    bool                checkpointOnSignal_;
+
+    /** Functional warmup ******************************************************/
+    Warmup              warmup_;
+    bool                warmupHasROIAddr_;
+    Addr                warmupROIAddr_;
+    int                 warmupMaxRequestsPerCycle_; // Timing-mode values, restored when warmup ends
+    bool                warmupBanked_;
+    int                 warmupMSHRSize_;
+
+    /** Latency tracing ********************************************************/
+    uint32_t            traceRate_;         // Trace 1 in traceRate_ requests, 0 if off
+    uint32_t            traceCount_;
+    uint32_t            traceSeq_;
+    uint32_t            traceWire_;
+    TimeConverter*      traceTimeBase_;     // ps
+    FILE*               traceFile_;
+
+    /** Flight recorder ********************************************************/
+    FlightRecorder      flightRecorder_;
+    std::string         flightRecorderDir_;
+    bool                flightRecorderAtFinish_;
 
     /** Clocks *****************************************************************/
     Clock::Handler<Cache>*  clockHandler_;
@@ -310,6 +371,10 @@ private:
     Statistic<uint64_t>* statRetryEvents;
     Statistic<uint64_t>* statUncacheRecv[(int)Command::LAST_CMD];
     Statistic<uint64_t>* statCacheRecv[(int)Command::LAST_CMD];
+
+    // Latency trace breakdown
+    Statistic<uint64_t>* statTraceStage[LatencyTrace::NUM_STAGES];
+    Statistic<uint64_t>* statTraceTotal;
 };
 
 }}
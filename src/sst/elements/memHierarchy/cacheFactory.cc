@@ -82,9 +82,63 @@ Cache::Cache(ComponentId_t id, Params &params) : Component(id) {
 
     createCoherenceManager(params);
 
+    /* Checkpointing */
+    checkpointLoadDir_ = params.find<std::string>("checkpoint_load_dir", "");
+    checkpointSaveDir_ = params.find<std::string>("checkpoint_save_dir", "");
+    checkpointOnSignal_ = params.find<bool>("checkpoint_on_signal", false);
+    std::string saveTime = params.find<std::string>("checkpoint_save_time", "");
+    checkpointAtFinish_ = saveTime.empty();
+    if (!checkpointSaveDir_.empty() && !saveTime.empty())
+        registerOneShot(saveTime, new OneShot::Handler<Cache>(this, &Cache::saveCheckpoint));
+
     /* Register statistics */
     registerStatistics();
 
+    /* Functional warmup */
+    warmupHasROIAddr_ = !params.find<std::string>("warmup_roi_addr", "").empty();
+    warmupROIAddr_ = params.find<Addr>("warmup_roi_addr", 0);
+    if (params.find<bool>("warmup", false)) {
+        warmup_.start();
+        coherenceMgr_->setWarmup(true);
+        warmupMaxRequestsPerCycle_ = maxRequestsPerCycle_;
+        warmupBanked_ = banked_;
+        warmupMSHRSize_ = mshr_->getMaxSize();
+        maxRequestsPerCycle_ = -1;
+        banked_ = false;
+        mshr_->setMaxSize(-1);
+
+        std::string endTime = params.find<std::string>("warmup_end", "");
+        if (!endTime.empty())
+            registerOneShot(endTime, new OneShot::Handler<Cache>(this, &Cache::endWarmup));
+    }
+
+    /* Latency tracing */
+    traceRate_ = params.find<uint32_t>("latency_trace_rate", 0);
+    traceCount_ = 0;
+    traceSeq_ = 0;
+    traceFile_ = nullptr;
+    if (traceRate_ != 0) {
+        traceWire_ = EndpointRegistry::getWireID(EndpointRegistry::getID(getName()));
+        traceTimeBase_ = getTimeConverter("1ps");
+        coherenceMgr_->setTraceHandler(std::bind(&Cache::finishTrace, this, std::placeholders::_1));
+
+        std::string traceFile = params.find<std::string>("latency_trace_file", "");
+        if (!traceFile.empty()) {
+            traceFile_ = fopen(traceFile.c_str(), "wb");
+            if (!traceFile_)
+                out_->fatal(CALL_INFO, -1, "%s, Error: unable to open latency_trace_file '%s'\n", getName().c_str(), traceFile.c_str());
+            uint32_t version = 1;
+            fwrite("MHLT", 1, 4, traceFile_);
+            fwrite(&version, sizeof(version), 1, traceFile_);
+        }
+    }
+
+    /* Flight recorder */
+    flightRecorder_.init(params.find<size_t>("flight_recorder_size", 1024));
+    flightRecorderDir_ = params.find<std::string>("flight_recorder_dir", ".");
+    flightRecorderAtFinish_ = params.find<bool>("flight_recorder_dump_at_finish", false);
+    if (flightRecorder_.enabled())
+        coherenceMgr_->setFlightRecorder(&flightRecorder_);
 }
 
 
@@ -794,4 +848,11 @@ void Cache::registerStatistics() {
 
     statMSHROccupancy               = registerStatistic<uint64_t>("MSHR_occupancy");
     statBankConflicts               = registerStatistic<uint64_t>("Bank_conflicts");
+
+    statTraceStage[(int)LatencyTrace::Stage::Queue]     = registerStatistic<uint64_t>("latency_trace_queue");
+    statTraceStage[(int)LatencyTrace::Stage::MSHR]      = registerStatistic<uint64_t>("latency_trace_mshr");
+    statTraceStage[(int)LatencyTrace::Stage::Access]    = registerStatistic<uint64_t>("latency_trace_access");
+    statTraceStage[(int)LatencyTrace::Stage::Network]   = registerStatistic<uint64_t>("latency_trace_network");
+    statTraceStage[(int)LatencyTrace::Stage::Memory]    = registerStatistic<uint64_t>("latency_trace_memory");
+    statTraceTotal                                      = registerStatistic<uint64_t>("latency_trace_total");
 }
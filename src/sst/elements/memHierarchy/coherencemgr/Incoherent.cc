@@ -35,7 +35,7 @@ using namespace SST::MemHierarchy;
 bool Incoherent::handleGetS(MemEvent * event, bool inMSHR) {
     Addr addr = event->getBaseAddr();
     PrivateCacheLine * line = cacheArray_->lookup(addr, true);
-    bool localPrefetch = event->isPrefetch() && (event->getRqstr() == cachename_);
+    bool localPrefetch = event->isPrefetch() && (event->getRqstrID() == cacheID_);
     State state = line ? line->getState() : I;
     uint64_t sendTime = 0;
     MemEventStatus status = MemEventStatus::OK;
@@ -84,7 +84,7 @@ bool Incoherent::handleGetS(MemEvent * event, bool inMSHR) {
             recordPrefetchResult(line, statPrefetchHit);
             recordLatencyType(event->getID(), LatType::HIT);
 
-            sendTime = sendResponseUp(event, line->getData(), inMSHR, line->getTimestamp());
+            sendTime = sendResponseUp(event, line->getDataBuffer(), inMSHR, line->getTimestamp());
             line->setTimestamp(sendTime);
             if (is_debug_event(event))
                 eventDI.reason = "hit";
@@ -149,7 +149,7 @@ bool Incoherent::handleGetX(MemEvent * event, bool inMSHR) {
                 stat_hits->addData(1);
             }
             recordPrefetchResult(line, statPrefetchHit);
-            sendTime = sendResponseUp(event, line->getData(), inMSHR, line->getTimestamp());
+            sendTime = sendResponseUp(event, line->getDataBuffer(), inMSHR, line->getTimestamp());
             line->setTimestamp(sendTime);
             recordLatencyType(event->getID(), LatType::HIT);
 
@@ -204,14 +204,14 @@ bool Incoherent::handleFlushLine(MemEvent * event, bool inMSHR) {
     switch (state) {
         case I:
             if (status == MemEventStatus::OK) {
-                forwardFlush(event, event->getEvict(), &(event->getPayload()), event->getDirty(), 0);
+                forwardFlush(event, event->getEvict(), event->getPayloadBuffer(), event->getDirty(), 0);
                 mshr_->setInProgress(addr);
             }
             break;
         case E:
         case M:
             if (status == MemEventStatus::OK) {
-                forwardFlush(event, state == M, line->getData(), state == M, 0);
+                forwardFlush(event, state == M, line->getDataBuffer(), state == M, 0);
                 line->setState(S_B);
                 mshr_->setInProgress(addr);
             }
@@ -254,7 +254,7 @@ bool Incoherent::handleFlushLineInv(MemEvent * event, bool inMSHR) {
     switch (state) {
         case I:
             if (status == MemEventStatus::OK) {
-                forwardFlush(event, event->getEvict(), &(event->getPayload()), event->getDirty(), 0);
+                forwardFlush(event, event->getEvict(), event->getPayloadBuffer(), event->getDirty(), 0);
                 mshr_->setInProgress(addr);
             }
             break;
@@ -262,7 +262,7 @@ bool Incoherent::handleFlushLineInv(MemEvent * event, bool inMSHR) {
         case M:
             if (status == MemEventStatus::OK) {
                 recordPrefetchResult(line, statPrefetchEvict);
-                forwardFlush(event, true, line->getData(), state == M, line->getTimestamp());
+                forwardFlush(event, true, line->getDataBuffer(), state == M, line->getTimestamp());
                 line->setState(I_B);
                 mshr_->setInProgress(addr);
             }
@@ -297,7 +297,7 @@ bool Incoherent::handlePutE(MemEvent * event, bool inMSHR) {
         case I:
             status = allocateLine(event, line, inMSHR);
             if (status == MemEventStatus::OK) {
-                line->setData(event->getPayload(), 0);
+                line->setData(event->getPayloadBuffer(), 0);
                 line->setState(E);
                 if (sendWritebackAck_)
                     sendWritebackAck(event);
@@ -340,7 +340,7 @@ bool Incoherent::handlePutM(MemEvent * event, bool inMSHR) {
         case I:
             status = allocateLine(event, line, inMSHR);
             if (status == MemEventStatus::OK) {
-                line->setData(event->getPayload(), 0);
+                line->setData(event->getPayloadBuffer(), 0);
                 line->setState(M);
                 if (sendWritebackAck_)
                     sendWritebackAck(event);
@@ -350,7 +350,7 @@ bool Incoherent::handlePutM(MemEvent * event, bool inMSHR) {
         case E:
             line->setState(M);
         case M:
-            line->setData(event->getPayload(), 0);
+            line->setData(event->getPayloadBuffer(), 0);
             if (sendWritebackAck_)
                 sendWritebackAck(event);
             cleanUpAfterRequest(event, inMSHR);
@@ -385,11 +385,11 @@ bool Incoherent::handleGetSResp(MemEvent * event, bool inMSHR) {
     MemEvent * req = static_cast<MemEvent*>(mshr_->getFrontEvent(addr));
     req->setFlags(event->getMemFlags());
 
-    sendResponseUp(req, &event->getPayload(), true, 0);
+    sendResponseUp(req, event->getPayloadBuffer(), true, 0);
 
     if (line) {
         line->setState(E);
-        line->setData(event->getPayload(), 0);
+        line->setData(event->getPayloadBuffer(), 0);
         // Has to be a local prefetch
         line->setPrefetch(true);
         recordPrefetchLatency(req->getID(), LatType::MISS);
@@ -419,7 +419,7 @@ bool Incoherent::handleGetXResp(MemEvent * event, bool inMSHR) {
     MemEvent * req = static_cast<MemEvent*>(mshr_->getFrontEvent(addr));
     req->setFlags(event->getMemFlags());
 
-    sendResponseUp(req, &event->getPayload(), true, 0);
+    sendResponseUp(req, event->getPayloadBuffer(), true, 0);
 
     cleanUpAfterResponse(event);
 
@@ -609,7 +609,7 @@ bool Incoherent::handleEviction(Addr addr, PrivateCacheLine* &line, dbgin &diStr
             if (is_debug_addr(line->getAddr())) {
                 std::stringstream note;
                 note << "InProg, " << StateString[state];
-                printDebugAlloc(false, line->getAddr(), note.str());
+                printDebugAlloc(false, line->getAddr(), note.str().c_str());
             }
             return false;
     }
@@ -672,7 +672,7 @@ void Incoherent::doEvict(MemEvent * event, PrivateCacheLine * line) {
     if (state == E || state == M) {
         if (event->getDirty()) {
             line->setState(M);
-            line->setData(event->getPayload(), 0);
+            line->setData(event->getPayloadBuffer(), 0);
         }
 
         event->setEvict(false);
@@ -684,14 +684,38 @@ void Incoherent::doEvict(MemEvent * event, PrivateCacheLine * line) {
  ***********************************************************************************************************/
 
 SimTime_t Incoherent::sendResponseUp(MemEvent * event, vector<uint8_t> * data, bool inMSHR, SimTime_t time, Command cmd, bool success) {
+    if (data) {
+        LineBuffer buffer;
+        buffer.assign(*data);
+        return sendResponseUp(event, buffer, inMSHR, time, cmd, success);
+    }
+
     MemEvent * responseEvent = event->makeResponse();
     if (cmd != Command::NULLCMD)
         responseEvent->setCmd(cmd);
 
-    if (data) {
-        responseEvent->setPayload(*data);
-        responseEvent->setSize(data->size());
-    }
+    if (!success)
+        responseEvent->setFail();
+
+    if (time < timestamp_) time = timestamp_;
+    SimTime_t deliveryTime = time + (inMSHR ? mshrLatency_ : accessLatency_);
+    forwardByDestination(responseEvent, deliveryTime);
+
+    if (is_debug_event(event))
+        eventDI.action = "Respond";
+
+    return deliveryTime;
+}
+
+
+/* Respond with 'data', sharing the buffer instead of copying it */
+SimTime_t Incoherent::sendResponseUp(MemEvent * event, const LineBuffer& data, bool inMSHR, SimTime_t time, Command cmd, bool success) {
+    MemEvent * responseEvent = event->makeResponse();
+    if (cmd != Command::NULLCMD)
+        responseEvent->setCmd(cmd);
+
+    responseEvent->setPayload(data);
+    responseEvent->setSize(data.size());
 
     if (!success)
         responseEvent->setFail();
@@ -714,13 +738,13 @@ void Incoherent::sendWriteback(Command cmd, PrivateCacheLine * line, bool dirty)
     uint64_t latency = tagLatency_;
 
     if (dirty) {
-        writeback->setPayload(*(line->getData()));
+        writeback->setPayload(line->getDataBuffer());
         writeback->setDirty(dirty);
 
         latency = accessLatency_;
     }
 
-    writeback->setRqstr(cachename_);
+    writeback->setRqstrID(cacheID_);
 
     uint64_t time = (timestamp_ > line->getTimestamp()) ? timestamp_ : line->getTimestamp();
     time += latency;
@@ -729,13 +753,14 @@ void Incoherent::sendWriteback(Command cmd, PrivateCacheLine * line, bool dirty)
 }
 
 
-void Incoherent::forwardFlush(MemEvent * event, bool evict, std::vector<uint8_t>* data, bool dirty, uint64_t time) {
+/* Forward a flush, sharing 'data' instead of copying it. 'data' is only sent if 'evict' is set. */
+void Incoherent::forwardFlush(MemEvent * event, bool evict, const LineBuffer& data, bool dirty, uint64_t time) {
     MemEvent * flush = new MemEvent(*event);
 
     uint64_t latency = tagLatency_;
     if (evict) {
         flush->setEvict(true);
-        flush->setPayload(*data);
+        flush->setPayload(data);
         flush->setDirty(dirty);
         latency = accessLatency_;
     } else {
@@ -254,8 +254,15 @@ public:
     virtual bool handleNACK(MemEvent * event, bool inMSHR);
 
     Addr getBank(Addr addr) { return cacheArray_->getBank(addr); }
+    State getLineState(Addr addr) { PrivateCacheLine* line = cacheArray_->lookup(addr, false); return line ? line->getState() : NP; }
     void setSliceAware(uint64_t interleaveSize, uint64_t interleaveStep) { cacheArray_->setSliceAware(interleaveSize, interleaveStep); }
 
+    void saveCheckpoint(CacheCheckpoint &ckpt) { cacheArray_->saveCheckpoint(ckpt.addSection("cache")); }
+    void loadCheckpoint(const CacheCheckpoint &ckpt, CacheCheckpoint::LoadStats &stats) {
+        if (const CacheCheckpoint::Section * sec = ckpt.getSection("cache"))
+            cacheArray_->loadCheckpoint(*sec, stats);
+    }
+
     MemEventInitCoherence * getInitCoherenceEvent();
 
     void recordLatency(Command cmd, int type, uint64_t latency);
@@ -293,10 +300,11 @@ private:
     void doEvict(MemEvent * event, PrivateCacheLine * line);
 
     SimTime_t sendResponseUp(MemEvent * event, vector<uint8_t> * data, bool inMSHR, SimTime_t time, Command cmd = Command::NULLCMD, bool success = true);
+    SimTime_t sendResponseUp(MemEvent * event, const LineBuffer& data, bool inMSHR, SimTime_t time, Command cmd = Command::NULLCMD, bool success = true);
 
     void sendWriteback(Command cmd, PrivateCacheLine * line, bool dirty);
 
-    void forwardFlush(MemEvent * event, bool evict, std::vector<uint8_t> * data, bool dirty, uint64_t time);
+    void forwardFlush(MemEvent * event, bool evict, const LineBuffer& data, bool dirty, uint64_t time);
 
     void sendWritebackAck(MemEvent * event);
 
@@ -38,7 +38,7 @@ using namespace SST::MemHierarchy;
 bool IncoherentL1::handleGetS(MemEvent* event, bool inMSHR){
     Addr addr = event->getBaseAddr();
     L1CacheLine * line = cacheArray_->lookup(addr, true);
-    bool localPrefetch = event->isPrefetch() && (event->getRqstr() == cachename_);
+    bool localPrefetch = event->isPrefetch() && (event->getRqstrID() == cacheID_);
     State state = line ? line->getState() : I;
     uint64_t sendTime = 0;
     MemEventStatus status = MemEventStatus::OK;
@@ -82,7 +82,7 @@ bool IncoherentL1::handleGetS(MemEvent* event, bool inMSHR){
             if (event->isLoadLink())
                 line->atomicStart(timestamp_ + llscBlockCycles_);
 
-            data.assign(line->getData()->begin() + (event->getAddr() - event->getBaseAddr()), line->getData()->begin() + (event->getAddr() - event->getBaseAddr() + event->getSize()));
+            data.assign(line->getDataBuffer().data().begin() + (event->getAddr() - event->getBaseAddr()), line->getDataBuffer().data().begin() + (event->getAddr() - event->getBaseAddr() + event->getSize()));
             sendTime = sendResponseUp(event, &data, inMSHR, line->getTimestamp());
             line->setTimestamp(sendTime-1);
             cleanUpAfterRequest(event, inMSHR);
@@ -169,10 +169,10 @@ bool IncoherentL1::handleGetX(MemEvent* event, bool inMSHR) {
 
             // Handle
             if (!event->isStoreConditional() || line->isAtomic()) { /* Don't write on a non-atomic SC */
-                line->setData(event->getPayload(), event->getAddr() - event->getBaseAddr());
+                line->setData(event->readPayload(), event->getAddr() - event->getBaseAddr());
                 line->atomicEnd();
                 if (is_debug_addr(addr))
-                    printDataValue(addr, line->getData(), true);
+                    printDataValue(addr, line->getDataBuffer(), true);
             } else {
                 success = false;
             }
@@ -244,7 +244,7 @@ bool IncoherentL1::handleGetSX(MemEvent* event, bool inMSHR) {
             recordLatencyType(event->getID(), LatType::HIT);
             // Handle
             line->incLock();
-            std::copy(line->getData()->begin() + (event->getAddr() - event->getBaseAddr()), line->getData()->begin() + (event->getAddr() - event->getBaseAddr())  + event->getSize(), data.begin());
+            std::copy(line->getDataBuffer().data().begin() + (event->getAddr() - event->getBaseAddr()), line->getDataBuffer().data().begin() + (event->getAddr() - event->getBaseAddr())  + event->getSize(), data.begin());
             sendTime = sendResponseUp(event, &data, inMSHR, line->getTimestamp());
             line->setTimestamp(sendTime-1);
             if (is_debug_addr(addr))
@@ -388,22 +388,22 @@ bool IncoherentL1::handleGetSResp(MemEvent * event, bool inMSHR) {
     stat_eventState[(int)(event->getCmd())][state]->addData(1);
 
     MemEvent * req = static_cast<MemEvent*>(mshr_->getFrontEvent(addr));
-    bool localPrefetch = req->isPrefetch() && (req->getRqstr() == cachename_);
+    bool localPrefetch = req->isPrefetch() && (req->getRqstrID() == cacheID_);
 
    if (is_debug_addr(addr))
         eventDI.prefill(event->getID(), Command::GetSResp, localPrefetch, addr, state);
 
     // Update line
-    line->setData(event->getPayload(), 0);
+    line->setData(event->getPayloadBuffer(), 0);
     line->setState(E);
     if (is_debug_addr(addr))
-        printDataValue(addr, line->getData(), false);
+        printDataValue(addr, line->getDataBuffer(), false);
     
     if (req->isLoadLink())
         line->atomicStart(timestamp_ + llscBlockCycles_);
 
     if (is_debug_addr(addr))
-        printDataValue(addr, line->getData(), true);
+        printDataValue(addr, line->getDataBuffer(), true);
 
     // Notify processor or set prefetch so we can track prefetch results
     if (localPrefetch) {
@@ -414,7 +414,7 @@ bool IncoherentL1::handleGetSResp(MemEvent * event, bool inMSHR) {
     } else {
         req->setMemFlags(event->getMemFlags());
         Addr offset = req->getAddr() - req->getBaseAddr();
-        vector<uint8_t> data(line->getData()->begin() + offset, line->getData()->begin() + offset + req->getSize());
+        vector<uint8_t> data(line->getDataBuffer().data().begin() + offset, line->getDataBuffer().data().begin() + offset + req->getSize());
         uint64_t sendTime = sendResponseUp(req, &data, true, line->getTimestamp());
         line->setTimestamp(sendTime-1);
     }
@@ -445,9 +445,9 @@ bool IncoherentL1::handleGetXResp(MemEvent * event, bool inMSHR) {
     req->setMemFlags(event->getMemFlags());
 
     // Set line data
-    line->setData(event->getPayload(), 0);
+    line->setData(event->getPayloadBuffer(), 0);
     if (is_debug_addr(line->getAddr()))
-        printDataValue(line->getAddr(), line->getData(), true);
+        printDataValue(line->getAddr(), line->getDataBuffer(), true);
 
 
     line->setState(M);
@@ -458,9 +458,9 @@ bool IncoherentL1::handleGetXResp(MemEvent * event, bool inMSHR) {
     bool success = true;
     if (req->getCmd() == Command::GetX || req->getCmd() == Command::Write) {
         if (!req->isStoreConditional() || line->isAtomic()) {
-            line->setData(req->getPayload(), offset);
+            line->setData(req->readPayload(), offset);
             if (is_debug_addr(line->getAddr()))
-                printDataValue(line->getAddr(), line->getData(), true);
+                printDataValue(line->getAddr(), line->getDataBuffer(), true);
             line->atomicEnd();
         } else {
             success = false;
@@ -475,7 +475,7 @@ bool IncoherentL1::handleGetXResp(MemEvent * event, bool inMSHR) {
     }
 
     // Return response
-    data.assign(line->getData()->begin() + offset, line->getData()->begin() + offset + req->getSize());
+    data.assign(line->getDataBuffer().data().begin() + offset, line->getDataBuffer().data().begin() + offset + req->getSize());
     uint64_t sendTime = sendResponseUp(req, &data, true, line->getTimestamp(), success);
     line->setTimestamp(sendTime-1);
 
@@ -689,7 +689,7 @@ bool IncoherentL1::handleEviction(Addr addr, L1CacheLine*& line) {
                 } else {
                     note << "InProg, " << StateString[state];
                 }
-                printDebugAlloc(false, line->getAddr(), note.str());
+                printDebugAlloc(false, line->getAddr(), note.str().c_str());
             }
             return false;
     }
@@ -807,7 +807,7 @@ void IncoherentL1::sendResponseDown(MemEvent * event, L1CacheLine * line, bool d
     MemEvent * responseEvent = event->makeResponse();
 
     if (data) {
-        responseEvent->setPayload(*line->getData());
+        responseEvent->setPayload(line->getDataBuffer());
         if (line->getState() == M)
             responseEvent->setDirty(true);
     }
@@ -830,7 +830,7 @@ void IncoherentL1::forwardFlush(MemEvent * event, L1CacheLine * line, bool evict
     if (evict) {
         flush->setEvict(true);
         // TODO only send payload when needed
-        flush->setPayload(*(line->getData()));
+        flush->setPayload(line->getDataBuffer());
         flush->setDirty(line->getState() == M);
         latency = accessLatency_;
     } else {
@@ -868,17 +868,17 @@ void IncoherentL1::sendWriteback(Command cmd, L1CacheLine* line, bool dirty) {
 
     /* Writeback data */
     if (dirty || writebackCleanBlocks_) {
-        writeback->setPayload(*line->getData());
+        writeback->setPayload(line->getDataBuffer());
         writeback->setDirty(dirty);
 
         if (is_debug_addr(line->getAddr())) {
-            printDataValue(line->getAddr(), line->getData(), false);
+            printDataValue(line->getAddr(), line->getDataBuffer(), false);
         }
 
         latency = accessLatency_;
     }
 
-    writeback->setRqstr(cachename_);
+    writeback->setRqstrID(cacheID_);
 
     uint64_t baseTime = (timestamp_ > line->getTimestamp()) ? timestamp_ : line->getTimestamp();
     uint64_t deliveryTime = baseTime + latency;
@@ -239,8 +239,15 @@ public:
     bool handleNACK(MemEvent * event, bool inMSHR);
 
     virtual Addr getBank(Addr addr) { return cacheArray_->getBank(addr); }
+    virtual State getLineState(Addr addr) { L1CacheLine* line = cacheArray_->lookup(addr, false); return line ? line->getState() : NP; }
     virtual void setSliceAware(uint64_t size, uint64_t step) { cacheArray_->setSliceAware(size, step); }
 
+    void saveCheckpoint(CacheCheckpoint &ckpt) { cacheArray_->saveCheckpoint(ckpt.addSection("cache")); }
+    void loadCheckpoint(const CacheCheckpoint &ckpt, CacheCheckpoint::LoadStats &stats) {
+        if (const CacheCheckpoint::Section * sec = ckpt.getSection("cache"))
+            cacheArray_->loadCheckpoint(*sec, stats);
+    }
+
     MemEventInitCoherence * getInitCoherenceEvent();
 
     std::set<Command> getValidReceiveEvents() {
@@ -37,7 +37,7 @@ using namespace SST::MemHierarchy;
 bool MESIInclusive::handleGetS(MemEvent * event, bool inMSHR) {
     Addr addr = event->getBaseAddr();
     SharedCacheLine * line = cacheArray_->lookup(addr, true);
-    bool localPrefetch = event->isPrefetch() && (event->getRqstr() == cachename_);
+    bool localPrefetch = event->isPrefetch() && (event->getRqstrID() == cacheID_);
     State state = line ? line->getState() : I;
 
     MemEventStatus status = MemEventStatus::OK;
@@ -101,7 +101,7 @@ bool MESIInclusive::handleGetS(MemEvent * event, bool inMSHR) {
             recordPrefetchResult(line, statPrefetchHit);
             line->addSharer(event->getSrc());
 
-            sendTime = sendResponseUp(event, line->getData(), inMSHR, line->getTimestamp());
+            sendTime = sendResponseUp(event, line->getDataBuffer(), inMSHR, line->getTimestamp());
             line->setTimestamp(sendTime - 1);
             cleanUpAfterRequest(event, inMSHR);
 
@@ -168,7 +168,7 @@ bool MESIInclusive::handleGetS(MemEvent * event, bool inMSHR) {
                 }
             }
 
-            sendTime = sendResponseUp(event, line->getData(), inMSHR, line->getTimestamp(), respcmd);
+            sendTime = sendResponseUp(event, line->getDataBuffer(), inMSHR, line->getTimestamp(), respcmd);
             line->setTimestamp(sendTime);
             cleanUpAfterRequest(event, inMSHR);
 
@@ -300,7 +300,7 @@ bool MESIInclusive::handleGetX(MemEvent * event, bool inMSHR) {
             line->setOwner(event->getSrc());
             if (line->isSharer(event->getSrc()))
                 line->removeSharer(event->getSrc());
-            sendTime = sendResponseUp(event, line->getData(), inMSHR, line->getTimestamp());
+            sendTime = sendResponseUp(event, line->getDataBuffer(), inMSHR, line->getTimestamp());
             line->setTimestamp(sendTime);
 
             if (is_debug_event(event))
@@ -1295,7 +1295,7 @@ bool MESIInclusive::handleGetSResp(MemEvent * event, bool inMSHR) {
     MemEvent * req = static_cast<MemEvent*>(mshr_->getFrontEvent(event->getBaseAddr()));
     //if (is_debug_addr(addr))
         //debug->debug(_L5_, "    Request: %s\n", req->getBriefString().c_str());
-    bool localPrefetch = req->isPrefetch() && (req->getRqstr() == cachename_);
+    bool localPrefetch = req->isPrefetch() && (req->getRqstrID() == cacheID_);
     req->setFlags(event->getMemFlags());
 
     // Sanity check line state
@@ -1305,18 +1305,18 @@ bool MESIInclusive::handleGetSResp(MemEvent * event, bool inMSHR) {
     }
 
     // Update line
-    line->setData(event->getPayload(), 0);
+    line->setData(event->getPayloadBuffer(), 0);
     line->setState(S);
 
     if (is_debug_addr(addr))
-        printDataValue(addr, line->getData(), true);
+        printDataValue(addr, line->getDataBuffer(), true);
 
     if (localPrefetch) {
         line->setPrefetch(true);
     } else {
         line->addSharer(req->getSrc());
         Addr offset = req->getAddr() - req->getBaseAddr();
-        uint64_t sendTime = sendResponseUp(req, line->getData(), true, line->getTimestamp());
+        uint64_t sendTime = sendResponseUp(req, line->getDataBuffer(), true, line->getTimestamp());
         line->setTimestamp(sendTime-1);
 
     }
@@ -1344,7 +1344,7 @@ bool MESIInclusive::handleGetXResp(MemEvent * event, bool inMSHR) {
 
     // Get matching request
     MemEvent * req = static_cast<MemEvent*>(mshr_->getFrontEvent(event->getBaseAddr()));
-    bool localPrefetch = req->isPrefetch() && (req->getRqstr() == cachename_);
+    bool localPrefetch = req->isPrefetch() && (req->getRqstrID() == cacheID_);
     req->setFlags(event->getMemFlags());
 
     std::vector<uint8_t> data;
@@ -1353,7 +1353,7 @@ bool MESIInclusive::handleGetXResp(MemEvent * event, bool inMSHR) {
     switch (state) {
         case IS:
         {
-            line->setData(event->getPayload(), 0);
+            line->setData(event->getPayloadBuffer(), 0);
 
             if (event->getDirty())  {
                 line->setState(M); // Sometimes get dirty data from a noninclusive cache
@@ -1362,7 +1362,7 @@ bool MESIInclusive::handleGetXResp(MemEvent * event, bool inMSHR) {
             }
 
             if (is_debug_addr(addr))
-                printDataValue(addr, line->getData(), true);
+                printDataValue(addr, line->getDataBuffer(), true);
 
             if (localPrefetch) {
                 line->setPrefetch(true);
@@ -1371,11 +1371,11 @@ bool MESIInclusive::handleGetXResp(MemEvent * event, bool inMSHR) {
             } else {
                 if (protocol_ && line->getState() != S && mshr_->getSize(addr) == 1) {
                     line->setOwner(req->getSrc());
-                    uint64_t sendTime = sendResponseUp(req, line->getData(), true, line->getTimestamp(), Command::GetXResp);
+                    uint64_t sendTime = sendResponseUp(req, line->getDataBuffer(), true, line->getTimestamp(), Command::GetXResp);
                     line->setTimestamp(sendTime - 1);
                 } else {
                     line->addSharer(req->getSrc());
-                    uint64_t sendTime = sendResponseUp(req, line->getData(), true, line->getTimestamp(), Command::GetSResp);
+                    uint64_t sendTime = sendResponseUp(req, line->getDataBuffer(), true, line->getTimestamp(), Command::GetSResp);
                     line->setTimestamp(sendTime - 1);
                 }
             }
@@ -1383,9 +1383,9 @@ bool MESIInclusive::handleGetXResp(MemEvent * event, bool inMSHR) {
             break;
         }
         case IM:
-            line->setData(event->getPayload(), 0);
+            line->setData(event->getPayloadBuffer(), 0);
             if (is_debug_addr(line->getAddr()))
-                printDataValue(addr, line->getData(), true);
+                printDataValue(addr, line->getDataBuffer(), true);
         case SM:
         {
             line->setState(M);
@@ -1393,7 +1393,7 @@ bool MESIInclusive::handleGetXResp(MemEvent * event, bool inMSHR) {
             if (line->isSharer(req->getSrc()))
                 line->removeSharer(req->getSrc());
 
-            uint64_t sendTime = sendResponseUp(req, line->getData(), true, line->getTimestamp());
+            uint64_t sendTime = sendResponseUp(req, line->getDataBuffer(), true, line->getTimestamp());
             line->setTimestamp(sendTime-1);
             cleanUpAfterResponse(event, inMSHR);
             break;
@@ -1831,7 +1831,7 @@ bool MESIInclusive::handleEviction(Addr addr, SharedCacheLine *& line) {
             if (is_debug_addr(line->getAddr())) {
                 std::stringstream note;
                 note << "InProg, " << StateString[state];
-                printDebugAlloc(false, line->getAddr(), note.str());
+                printDebugAlloc(false, line->getAddr(), note.str().c_str());
             }
             return false;
     }
@@ -1940,9 +1940,9 @@ State MESIInclusive::doEviction(MemEvent * event, SharedCacheLine * line, State
     recordPrefetchResult(line, statPrefetchEvict);
 
     if (event->getDirty()) {
-        line->setData(event->getPayload(), 0);
+        line->setData(event->getPayloadBuffer(), 0);
         if (is_debug_addr(event->getBaseAddr())) {
-                printDataValue(event->getBaseAddr(), line->getData(), true);
+                printDataValue(event->getBaseAddr(), line->getDataBuffer(), true);
         }
 
         switch (state) {
@@ -1975,17 +1975,41 @@ State MESIInclusive::doEviction(MemEvent * event, SharedCacheLine * line, State
  ***********************************************************************************************************/
 
 SimTime_t MESIInclusive::sendResponseUp(MemEvent * event, vector<uint8_t>* data, bool inMSHR, uint64_t time, Command cmd, bool success) {
+    if (data) {
+        LineBuffer buffer;
+        buffer.assign(*data);
+        return sendResponseUp(event, buffer, inMSHR, time, cmd, success);
+    }
+
     MemEvent * responseEvent = event->makeResponse();
     if (cmd != Command::NULLCMD)
         responseEvent->setCmd(cmd);
 
-    /* Only return the desired word */
-    if (data) {
-        responseEvent->setPayload(*data);
-        responseEvent->setSize(data->size()); // Return size that was written
-        if (is_debug_event(event)) {
-            printDataValue(event->getBaseAddr(), data, false);
-        }
+    if (!success)
+        responseEvent->setFail();
+
+    if (time < timestamp_) time = timestamp_;
+    uint64_t deliveryTime = time + (inMSHR ? mshrLatency_ : accessLatency_);
+    forwardByDestination(responseEvent, deliveryTime);
+
+    if (is_debug_event(responseEvent)) {
+        eventDI.action = "Respond";
+    }
+
+    return deliveryTime;
+}
+
+
+/* Respond with 'data', sharing the buffer instead of copying it */
+SimTime_t MESIInclusive::sendResponseUp(MemEvent * event, const LineBuffer& data, bool inMSHR, uint64_t time, Command cmd, bool success) {
+    MemEvent * responseEvent = event->makeResponse();
+    if (cmd != Command::NULLCMD)
+        responseEvent->setCmd(cmd);
+
+    responseEvent->setPayload(data);
+    responseEvent->setSize(data.size()); // Return size that was written
+    if (is_debug_event(event)) {
+        printDataValue(event->getBaseAddr(), data, false);
     }
 
     if (!success)
@@ -2009,7 +2033,7 @@ void MESIInclusive::sendResponseDown(MemEvent * event, SharedCacheLine * line, b
     MemEvent * responseEvent = event->makeResponse();
 
     if (data) {
-        responseEvent->setPayload(*line->getData());
+        responseEvent->setPayload(line->getDataBuffer());
         if (line->getState() == M)
             responseEvent->setDirty(true);
     }
@@ -2034,7 +2058,7 @@ void MESIInclusive::forwardFlush(MemEvent * event, SharedCacheLine * line, bool
     if (evict) {
         flush->setEvict(true);
         // TODO only send payload when needed
-        flush->setPayload(*(line->getData()));
+        flush->setPayload(line->getDataBuffer());
         flush->setDirty(line->getState() == M);
         latency = accessLatency_;
     } else {
@@ -2067,17 +2091,17 @@ void MESIInclusive::sendWriteback(Command cmd, SharedCacheLine* line, bool dirty
 
     /* Writeback data */
     if (dirty || writebackCleanBlocks_) {
-        writeback->setPayload(*line->getData());
+        writeback->setPayload(line->getDataBuffer());
         writeback->setDirty(dirty);
 
         if (is_debug_addr(line->getAddr())) {
-            printDataValue(line->getAddr(), line->getData(), false);
+            printDataValue(line->getAddr(), line->getDataBuffer(), false);
         }
 
         latency = accessLatency_;
     }
 
-    writeback->setRqstr(cachename_);
+    writeback->setRqstrID(cacheID_);
 
     uint64_t baseTime = (timestamp_ > line->getTimestamp()) ? timestamp_ : line->getTimestamp();
     uint64_t deliveryTime = baseTime + latency;
@@ -2139,10 +2163,10 @@ void MESIInclusive::downgradeOwner(MemEvent * event, SharedCacheLine* line, bool
 
 bool MESIInclusive::invalidateExceptRequestor(MemEvent * event, SharedCacheLine * line, bool inMSHR) {
     uint64_t deliveryTime = 0;
-    std::string rqstr = event->getSrc();
+    uint32_t rqstr = SharerIDMap::findID(event->getSrcID());
 
-    for (set<std::string>::iterator it = line->getSharers()->begin(); it != line->getSharers()->end(); it++) {
-        if (*it == rqstr) continue;
+    for (SharerSet::iterator it = line->getSharers()->begin(); it != line->getSharers()->end(); it++) {
+        if (it.id() == rqstr) continue;
 
         deliveryTime =  invalidateSharer(*it, event, line, inMSHR);
     }
@@ -2160,7 +2184,7 @@ bool MESIInclusive::invalidateAll(MemEvent * event, SharedCacheLine * line, bool
     } else {
         if (cmd == Command::NULLCMD)
             cmd = Command::Inv;
-        for (std::set<std::string>::iterator it = line->getSharers()->begin(); it != line->getSharers()->end(); it++) {
+        for (SharerSet::iterator it = line->getSharers()->begin(); it != line->getSharers()->end(); it++) {
             deliveryTime = invalidateSharer(*it, event, line, inMSHR, cmd);
         }
         if (deliveryTime != 0) {
@@ -2178,7 +2202,7 @@ uint64_t MESIInclusive::invalidateSharer(std::string shr, MemEvent * event, Shar
         if (event) {
             inv->copyMetadata(event);
         } else {
-            inv->setRqstr(cachename_);
+            inv->setRqstrID(cacheID_);
         }
         inv->setDst(shr);
         inv->setSize(lineSize_);
@@ -2215,7 +2239,7 @@ bool MESIInclusive::invalidateOwner(MemEvent * event, SharedCacheLine * line, bo
     if (event) {
         inv->copyMetadata(event);
     } else {
-        inv->setRqstr(cachename_);
+        inv->setRqstrID(cacheID_);
     }
     inv->setDst(line->getOwner());
     inv->setSize(lineSize_);
@@ -502,8 +502,15 @@ public:
 
     /** Cache interface **/
     virtual Addr getBank(Addr addr) { return cacheArray_->getBank(addr); }
+    virtual State getLineState(Addr addr) { SharedCacheLine* line = cacheArray_->lookup(addr, false); return line ? line->getState() : NP; }
     virtual void setSliceAware(uint64_t size, uint64_t step) { cacheArray_->setSliceAware(size, step); }
 
+    void saveCheckpoint(CacheCheckpoint &ckpt) { cacheArray_->saveCheckpoint(ckpt.addSection("cache")); }
+    void loadCheckpoint(const CacheCheckpoint &ckpt, CacheCheckpoint::LoadStats &stats) {
+        if (const CacheCheckpoint::Section * sec = ckpt.getSection("cache"))
+            cacheArray_->loadCheckpoint(*sec, stats);
+    }
+
     /** Initialization **/
     MemEventInitCoherence * getInitCoherenceEvent();
 
@@ -559,6 +566,7 @@ private:
 
     /** Send response up (towards processor) */
     SimTime_t sendResponseUp(MemEvent * event, vector<uint8_t>* data, bool inMSHR, uint64_t time, Command cmd = Command::NULLCMD, bool success = true);
+    SimTime_t sendResponseUp(MemEvent * event, const LineBuffer& data, bool inMSHR, uint64_t time, Command cmd = Command::NULLCMD, bool success = true);
 
     /** Send response down (towards memory) */
     void sendResponseDown(MemEvent * event, SharedCacheLine * line, bool data, bool evict);
@@ -16,19 +16,11 @@
 #include <sst_config.h>
 #include <vector>
 #include "coherencemgr/MESI_L1.h"
+#include "coherencemgr/MESI_L1_Table.h"
 
 using namespace SST;
 using namespace SST::MemHierarchy;
 
-/* Debug macros */
-#ifdef __SST_DEBUG_OUTPUT__ /* From sst-core, enable with --enable-debug */
-#define is_debug_addr(addr) (DEBUG_ADDR.empty() || DEBUG_ADDR.find(addr) != DEBUG_ADDR.end())
-#define is_debug_event(ev) (DEBUG_ADDR.empty() || ev->doDebug(DEBUG_ADDR))
-#else
-#define is_debug_addr(addr) false
-#define is_debug_event(ev) false
-#endif
-
 /*----------------------------------------------------------------------------------------------------------------------
  * L1 Coherence Controller
  *---------------------------------------------------------------------------------------------------------------------*/
@@ -37,94 +29,19 @@ using namespace SST::MemHierarchy;
  * Event handlers
  ***********************************************************************************************************/
 
+namespace {
+/* Index into stat_hit/stat_miss */
+inline int requestStatIndex(Command cmd) {
+    return cmd == Command::GetS ? 0 : (cmd == Command::GetX ? 1 : 2);
+}
+}
+
 /*
  * Handle GetS (load/read) request
  * GetS may be the start of an LLSC
  */
 bool MESIL1::handleGetS(MemEvent * event, bool inMSHR) {
-    Addr addr = event->getBaseAddr();
-    L1CacheLine * line = cacheArray_->lookup(addr, true);
-    bool localPrefetch = event->isPrefetch() && (event->getRqstr() == cachename_);
-    State state = line ?  line->getState() : I;
-    uint64_t sendTime = 0;
-    MemEventStatus status = MemEventStatus::OK;
-    vector<uint8_t> data;
-
-    if (inMSHR)
-        mshr_->removePendingRetry(addr);
-
-    if (is_debug_addr(addr)) {
-        eventDI.prefill(event->getID(), Command::GetS, localPrefetch, addr, state);
-        eventDI.reason = "hit";
-    }
-
-    switch (state) {
-        case I: /* Miss */
-            status = processCacheMiss(event, line, inMSHR); // Attempt to allocate an MSHR entry and/or line
-
-            if (status == MemEventStatus::OK) {
-                line = cacheArray_->lookup(addr, false);
-                //eventProfileAndNotify(event, I, NotifyAccessType::READ, NotifyResultType::MISS, true, LatType::MISS);
-                if (!mshr_->getProfiled(addr)) {
-                    recordLatencyType(event->getID(), LatType::MISS);
-                    stat_eventState[(int)Command::GetS][I]->addData(1);
-                    stat_miss[0][inMSHR]->addData(1);
-                    stat_misses->addData(1);
-                    notifyListenerOfAccess(event, NotifyAccessType::READ, NotifyResultType::MISS);
-                    mshr_->setProfiled(addr);
-                }
-                sendTime = forwardMessage(event, lineSize_, 0, nullptr);
-                line->setState(IS);
-                line->setTimestamp(sendTime);
-                if (is_debug_addr(addr))
-                    eventDI.reason = "miss";
-                mshr_->setInProgress(addr);
-            } else {
-                recordMiss(event->getID());
-            }
-            break;
-        case S: /* Hit */
-        case E:
-        case M:
-            if (!inMSHR || !mshr_->getProfiled(addr)) {
-                recordLatencyType(event->getID(), LatType::HIT);
-                stat_eventState[(int)Command::GetS][state]->addData(1);
-                stat_hit[0][inMSHR]->addData(1);
-                stat_hits->addData(1);
-                notifyListenerOfAccess(event, NotifyAccessType::READ, NotifyResultType::HIT);
-            }
-
-            if (localPrefetch) {
-                statPrefetchRedundant->addData(1); // Unneccessary prefetch
-                recordPrefetchLatency(event->getID(), LatType::HIT);
-                cleanUpAfterRequest(event, inMSHR);
-                break;
-            }
-
-            recordPrefetchResult(line, statPrefetchHit);
-
-            if (event->isLoadLink())
-                line->atomicStart(timestamp_ + llscBlockCycles_);
-            data.assign(line->getData()->begin() + (event->getAddr() - event->getBaseAddr()), line->getData()->begin() + (event->getAddr() - event->getBaseAddr() + event->getSize()));
-            sendTime = sendResponseUp(event, &data, inMSHR, line->getTimestamp());
-            line->setTimestamp(sendTime - 1);
-            cleanUpAfterRequest(event, inMSHR);
-            break;
-        default:
-            if (!inMSHR) {
-                status = allocateMSHR(event, false);
-            } else if (is_debug_event(event)) {
-                eventDI.action = "Stall";
-            }
-            break;
-    }
-
-    if (is_debug_addr(addr) && line) {
-        eventDI.newst = line->getState();
-        eventDI.verboseline = line->getString();
-    }
-
-    return (status == MemEventStatus::Reject) ? false : true;
+    return handleRequest(event, inMSHR);
 }
 
 
@@ -133,7 +50,7 @@ bool MESIL1::handleGetS(MemEvent * event, bool inMSHR) {
  * May also be a store-conditional or write-unlock
  */
 bool MESIL1::handleWrite(MemEvent* event, bool inMSHR) {
-    return handleGetX(event, inMSHR);
+    return handleRequest(event, inMSHR);
 }
 
 /*
@@ -141,104 +58,60 @@ bool MESIL1::handleWrite(MemEvent* event, bool inMSHR) {
  * May also be store-conditional or write-unlock
  */
 bool MESIL1::handleGetX(MemEvent* event, bool inMSHR) {
+    return handleRequest(event, inMSHR);
+}
+
+/*
+ * Handle GetSX (read-exclusive) request
+ * GetSX acquires a line in exclusive state and locks it until any future GetX arrives
+ */
+bool MESIL1::handleGetSX(MemEvent* event, bool inMSHR) {
+    return handleRequest(event, inMSHR);
+}
+
+/*
+ * Common path for GetS, GetX, Write, and GetSX
+ * Looks up the action for the line's state in l1RequestTable and dispatches to it
+ */
+bool MESIL1::handleRequest(MemEvent* event, bool inMSHR) {
     Addr addr = event->getBaseAddr();
-    L1CacheLine* line = cacheArray_->lookup(addr, true);
+    L1CacheLine * line = cacheArray_->lookup(addr, true);
     State state = line ? line->getState() : I;
-
-    if (is_debug_addr(addr))
-        eventDI.prefill(event->getID(), Command::GetX, false, addr, state);
+    Command cmd = (event->getCmd() == Command::Write) ? Command::GetX : event->getCmd();
+    bool localPrefetch = event->isPrefetch() && (event->getRqstrID() == cacheID_);
+    MemEventStatus status = MemEventStatus::OK;
 
     if (inMSHR)
         mshr_->removePendingRetry(addr);
 
+    if (is_debug_addr(addr))
+        eventDI.prefill(event->getID(), cmd, cmd == Command::GetS && localPrefetch, addr, state);
+
     /* Special case - if this is the last coherence level (e.g., just mem below),
      * can upgrade without forwarding request */
-    if (state == S && lastLevel_) {
+    if (state == S && lastLevel_ && cmd != Command::GetS) {
         state = M;
         line->setState(M);
     }
 
-    MemEventStatus status = MemEventStatus::OK;
-    bool success = true;
-    uint64_t sendTime = 0;
-
-    switch (state) {
-        case I:
-            status = processCacheMiss(event, line, inMSHR);
-
-            if (status == MemEventStatus::OK) {
-                line = cacheArray_->lookup(addr, false);
-                if (!mshr_->getProfiled(addr)) {
-                    notifyListenerOfAccess(event, NotifyAccessType::WRITE, NotifyResultType::MISS);
-                    stat_eventState[(int)Command::GetX][I]->addData(1);
-                    stat_miss[1][inMSHR]->addData(1);
-                    stat_misses->addData(1);
-                    recordLatencyType(event->getID(), LatType::MISS);
-                    mshr_->setProfiled(addr);
-                }
-
-                sendTime = forwardMessage(event, lineSize_, 0, nullptr, Command::GetX);
-                line->setState(IM);
-                line->setTimestamp(sendTime);
-                mshr_->setInProgress(addr);
-                if (is_debug_addr(addr))
-                    eventDI.reason = "miss";
-            } else {
-                recordMiss(event->getID());
-            }
+    L1Request action = l1RequestTable.get(state, cmd);
+    switch (action) {
+        case L1Request::Miss:
+            status = requestMiss(event, line, cmd, inMSHR);
             break;
-        case S:
-            status = processCacheMiss(event, line, inMSHR); // Just acquire an MSHR entry
-            if (status == MemEventStatus::OK) {
-                if (!mshr_->getProfiled(addr)) {
-                    notifyListenerOfAccess(event, NotifyAccessType::WRITE, NotifyResultType::MISS);
-                    recordLatencyType(event->getID(), LatType::UPGRADE);
-                    stat_eventState[(int)Command::GetX][S]->addData(1);
-                    stat_miss[1][inMSHR]->addData(1);
-                    stat_misses->addData(1);
-                    mshr_->setProfiled(addr);
-                }
-                recordPrefetchResult(line, statPrefetchUpgradeMiss);
-
-                sendTime = forwardMessage(event, lineSize_, 0, nullptr, Command::GetX);
-                line->setState(SM);
-                line->setTimestamp(sendTime);
-                mshr_->setInProgress(addr);
-                if (is_debug_addr(addr))
-                    eventDI.reason = "miss";
-            }
+        case L1Request::Upgrade:
+            status = requestUpgrade(event, line, cmd, inMSHR);
             break;
-        case E:
-            line->setState(M);
-        case M:
-            recordPrefetchResult(line, statPrefetchHit);
-            if (!inMSHR || !mshr_->getProfiled(addr)) {
-                notifyListenerOfAccess(event, NotifyAccessType::WRITE, NotifyResultType::HIT);
-                recordLatencyType(event->getID(), LatType::HIT);
-                stat_eventState[(int)Command::GetX][state]->addData(1);
-                stat_hit[1][inMSHR]->addData(1);
-                stat_hits->addData(1);
-            }
-
-            if (!event->isStoreConditional() || line->isAtomic()) { // Don't write on a non-atomic SC
-                line->setData(event->getPayload(), event->getAddr() - event->getBaseAddr());
-                line->atomicEnd();
-                if (is_debug_addr(addr))
-                    printDataValue(addr, line->getData(), true);
-            } else {
-                success = false;
-            }
-            if (event->queryFlag(MemEvent::F_LOCKED)) {
-                line->decLock();
-            }
-
-            sendTime = sendResponseUp(event, nullptr, inMSHR, line->getTimestamp(), success);
-            line->setTimestamp(sendTime-1);
-            if (is_debug_addr(addr))
-                eventDI.reason = "hit";
-            cleanUpAfterRequest(event, inMSHR);
+        case L1Request::ReadHit:
+            requestReadHit(event, line, state, inMSHR, localPrefetch);
             break;
-        default:
+        case L1Request::WriteHit:
+            requestWriteHit(event, line, state, inMSHR);
+            break;
+        case L1Request::LockHit:
+            requestLockHit(event, line, state, inMSHR);
+            break;
+        case L1Request::Stall:
             if (!inMSHR) {
                 status = allocateMSHR(event, false);
             } else if (is_debug_addr(addr)) {
@@ -247,120 +120,170 @@ bool MESIL1::handleGetX(MemEvent* event, bool inMSHR) {
             break;
     }
 
+    /* Check the table and its actions against the switches they replaced */
+    if constexpr (debugEnabled) {
+        if (action != l1RequestSwitch(state, cmd))
+            debug->fatal(CALL_INFO, -1, "%s, Error: Request table chose a different action than the switch for %s in state %s. Event: %s. Time = %" PRIu64 "ns\n",
+                    cachename_.c_str(), CommandString[(int)cmd], StateString[state], event->getVerboseString().c_str(), getCurrentSimTimeNano());
+        if (status == MemEventStatus::OK && action != L1Request::Stall && line->getState() != l1RequestNextState(state, cmd))
+            debug->fatal(CALL_INFO, -1, "%s, Error: %s in state %s left the line in %s, expected %s. Event: %s. Time = %" PRIu64 "ns\n",
+                    cachename_.c_str(), CommandString[(int)cmd], StateString[state], StateString[line->getState()],
+                    StateString[l1RequestNextState(state, cmd)], event->getVerboseString().c_str(), getCurrentSimTimeNano());
+    }
+
     if (is_debug_addr(addr) && line) {
         eventDI.newst = line->getState();
         eventDI.verboseline = line->getString();
     }
 
-    return (status == MemEventStatus::Reject) ? false: true;
+    return (status == MemEventStatus::Reject) ? false : true;
 }
 
-/*
- * Handle GetSX (read-exclusive) request
- * GetSX acquires a line in exclusive state and locks it until any future GetX arrives
- */
-bool MESIL1::handleGetSX(MemEvent* event, bool inMSHR) {
+/* Miss in I: allocate an MSHR entry and a line, then forward the request */
+MemEventStatus MESIL1::requestMiss(MemEvent* event, L1CacheLine*& line, Command cmd, bool inMSHR) {
     Addr addr = event->getBaseAddr();
-    L1CacheLine * line = cacheArray_->lookup(addr, true);
-    State state = line ? line->getState() : I;
+    MemEventStatus status = processCacheMiss(event, line, inMSHR); // Attempt to allocate an MSHR entry and/or line
 
-    if (inMSHR)
-        mshr_->removePendingRetry(addr);
+    if (status != MemEventStatus::OK) {
+        recordMiss(event->getID());
+        return status;
+    }
+
+    line = cacheArray_->lookup(addr, false);
+    if (!mshr_->getProfiled(addr)) {
+        recordLatencyType(event->getID(), LatType::MISS);
+        stat_eventState[(int)cmd][I]->addData(1);
+        stat_miss[requestStatIndex(cmd)][inMSHR]->addData(1);
+        stat_misses->addData(1);
+        notifyListenerOfAccess(event, cmd == Command::GetX ? NotifyAccessType::WRITE : NotifyAccessType::READ, NotifyResultType::MISS);
+        mshr_->setProfiled(addr);
+    }
 
+    uint64_t sendTime = forwardMessage(event, lineSize_, 0, nullptr, cmd);
+    line->setState(cmd == Command::GetS ? IS : IM);
+    line->setTimestamp(sendTime);
+    mshr_->setInProgress(addr);
     if (is_debug_addr(addr))
-        eventDI.prefill(event->getID(), Command::GetSX, false, addr, state);
+        eventDI.reason = "miss";
+    return status;
+}
 
-    /* Special case - if this is the last coherence level (e.g., just mem below),
-     * can upgrade without forwarding request */
-    if (state == S && lastLevel_) {
-        state = M;
-        line->setState(M);
+/* GetX/GetSX to a shared line: acquire an MSHR entry and request exclusive permission */
+MemEventStatus MESIL1::requestUpgrade(MemEvent* event, L1CacheLine* line, Command cmd, bool inMSHR) {
+    Addr addr = event->getBaseAddr();
+    MemEventStatus status = processCacheMiss(event, line, inMSHR); // Just acquire an MSHR entry
+
+    if (status != MemEventStatus::OK)
+        return status;
+
+    if (!mshr_->getProfiled(addr)) {
+        notifyListenerOfAccess(event, NotifyAccessType::WRITE, NotifyResultType::MISS);
+        recordLatencyType(event->getID(), LatType::UPGRADE);
+        stat_eventState[(int)cmd][S]->addData(1);
+        stat_miss[requestStatIndex(cmd)][inMSHR]->addData(1);
+        stat_misses->addData(1);
+        mshr_->setProfiled(addr);
     }
+    recordPrefetchResult(line, statPrefetchUpgradeMiss);
 
-    MemEventStatus status = MemEventStatus::OK;
-    bool success = true;
-    uint64_t sendTime = 0;
-    vector<uint8_t> data;
+    uint64_t sendTime = forwardMessage(event, lineSize_, 0, nullptr, cmd);
+    line->setState(SM);
+    line->setTimestamp(sendTime);
+    mshr_->setInProgress(addr);
+    if (is_debug_addr(addr))
+        eventDI.reason = "miss";
+    return status;
+}
 
-    switch (state) {
-        case I:
-            status = processCacheMiss(event, line, inMSHR);
-
-            if (status == MemEventStatus::OK) {
-                if (!mshr_->getProfiled(addr)) {
-                    notifyListenerOfAccess(event, NotifyAccessType::READ, NotifyResultType::MISS);
-                    stat_eventState[(int)Command::GetSX][I]->addData(1);
-                    stat_miss[2][inMSHR]->addData(1);
-                    stat_misses->addData(1);
-                    recordLatencyType(event->getID(), LatType::MISS);
-                    mshr_->setProfiled(addr);
-                }
+/* GetS to a line in S, E, or M */
+void MESIL1::requestReadHit(MemEvent* event, L1CacheLine* line, State state, bool inMSHR, bool localPrefetch) {
+    Addr addr = event->getBaseAddr();
 
-                sendTime = forwardMessage(event, lineSize_, 0, nullptr);
-                line->setState(IM);
-                line->setTimestamp(sendTime);
-                mshr_->setInProgress(addr);
-                if (is_debug_addr(addr))
-                    eventDI.reason = "miss";
-            } else {
-                recordMiss(event->getID());
-            }
-            break;
-        case S:
-            status = processCacheMiss(event, line, inMSHR); // Just acquire an MSHR entry
-            if (status == MemEventStatus::OK) {
-                if (!mshr_->getProfiled(addr)) {
-                    notifyListenerOfAccess(event, NotifyAccessType::WRITE, NotifyResultType::MISS);
-                    recordLatencyType(event->getID(), LatType::UPGRADE);
-                    stat_eventState[(int)Command::GetSX][S]->addData(1);
-                    stat_miss[2][inMSHR]->addData(1);
-                    stat_misses->addData(1);
-                    mshr_->setProfiled(addr);
-                }
-                recordPrefetchResult(line, statPrefetchUpgradeMiss);
+    if (!inMSHR || !mshr_->getProfiled(addr)) {
+        recordLatencyType(event->getID(), LatType::HIT);
+        stat_eventState[(int)Command::GetS][state]->addData(1);
+        stat_hit[0][inMSHR]->addData(1);
+        stat_hits->addData(1);
+        notifyListenerOfAccess(event, NotifyAccessType::READ, NotifyResultType::HIT);
+    }
+    if (is_debug_addr(addr))
+        eventDI.reason = "hit";
 
-                sendTime = forwardMessage(event, lineSize_, 0, nullptr);
-                line->setState(SM);
-                line->setTimestamp(sendTime);
-                mshr_->setInProgress(addr);
-                if (is_debug_addr(addr))
-                    eventDI.reason = "miss";
-            }
-            break;
-        case E:
-            line->setState(M);
-        case M:
-            recordPrefetchResult(line, statPrefetchHit);
-            if (!inMSHR || !mshr_->getProfiled(addr)) {
-                notifyListenerOfAccess(event, NotifyAccessType::READ, NotifyResultType::HIT);
-                recordLatencyType(event->getID(), LatType::HIT);
-                stat_eventState[(int)Command::GetSX][state]->addData(1);
-                stat_hit[2][inMSHR]->addData(1);
-                stat_hits->addData(1);
-            }
-            line->incLock();
-            std::copy(line->getData()->begin() + (event->getAddr() - event->getBaseAddr()), line->getData()->begin() + (event->getAddr() - event->getBaseAddr()) + event->getSize(), data.begin());
-            sendTime = sendResponseUp(event, &data, inMSHR, line->getTimestamp());
-            line->setTimestamp(sendTime-1);
-            cleanUpAfterRequest(event, inMSHR);
-            if (is_debug_addr(addr))
-                eventDI.reason = "hit";
-            break;
-        default:
-            if (!inMSHR) {
-                status = allocateMSHR(event, false);
-            } else if (is_debug_addr(addr)) {
-                eventDI.action = "Stall";
-            }
-            break;
+    if (localPrefetch) {
+        statPrefetchRedundant->addData(1); // Unneccessary prefetch
+        recordPrefetchLatency(event->getID(), LatType::HIT);
+        cleanUpAfterRequest(event, inMSHR);
+        return;
     }
 
-    if (is_debug_addr(addr) && line) {
-        eventDI.newst = line->getState();
-        eventDI.verboseline = line->getString();
+    recordPrefetchResult(line, statPrefetchHit);
+
+    if (event->isLoadLink())
+        line->atomicStart(timestamp_ + llscBlockCycles_);
+    vector<uint8_t> data(line->getDataBuffer().data().begin() + (event->getAddr() - addr), line->getDataBuffer().data().begin() + (event->getAddr() - addr + event->getSize()));
+    uint64_t sendTime = sendResponseUp(event, &data, inMSHR, line->getTimestamp());
+    line->setTimestamp(sendTime - 1);
+    cleanUpAfterRequest(event, inMSHR);
+}
+
+/* GetX/Write to a line in E or M */
+void MESIL1::requestWriteHit(MemEvent* event, L1CacheLine* line, State state, bool inMSHR) {
+    Addr addr = event->getBaseAddr();
+    bool success = true;
+
+    if (state == E)
+        line->setState(M);
+
+    recordPrefetchResult(line, statPrefetchHit);
+    if (!inMSHR || !mshr_->getProfiled(addr)) {
+        notifyListenerOfAccess(event, NotifyAccessType::WRITE, NotifyResultType::HIT);
+        recordLatencyType(event->getID(), LatType::HIT);
+        stat_eventState[(int)Command::GetX][state]->addData(1);
+        stat_hit[1][inMSHR]->addData(1);
+        stat_hits->addData(1);
     }
 
-    return (status == MemEventStatus::Reject) ? false: true;
+    if (!event->isStoreConditional() || line->isAtomic()) { // Don't write on a non-atomic SC
+        line->setData(event->readPayload(), event->getAddr() - addr);
+        line->atomicEnd();
+        if (is_debug_addr(addr))
+            printDataValue(addr, line->getDataBuffer(), true);
+    } else {
+        success = false;
+    }
+    if (event->queryFlag(MemEvent::F_LOCKED)) {
+        line->decLock();
+    }
+
+    uint64_t sendTime = sendResponseUp(event, nullptr, inMSHR, line->getTimestamp(), success);
+    line->setTimestamp(sendTime-1);
+    if (is_debug_addr(addr))
+        eventDI.reason = "hit";
+    cleanUpAfterRequest(event, inMSHR);
+}
+
+/* GetSX to a line in E or M: lock the line until the matching GetX */
+void MESIL1::requestLockHit(MemEvent* event, L1CacheLine* line, State state, bool inMSHR) {
+    Addr addr = event->getBaseAddr();
+
+    if (state == E)
+        line->setState(M);
+
+    recordPrefetchResult(line, statPrefetchHit);
+    if (!inMSHR || !mshr_->getProfiled(addr)) {
+        notifyListenerOfAccess(event, NotifyAccessType::READ, NotifyResultType::HIT);
+        recordLatencyType(event->getID(), LatType::HIT);
+        stat_eventState[(int)Command::GetSX][state]->addData(1);
+        stat_hit[2][inMSHR]->addData(1);
+        stat_hits->addData(1);
+    }
+    line->incLock();
+    vector<uint8_t> data(line->getDataBuffer().data().begin() + (event->getAddr() - addr), line->getDataBuffer().data().begin() + (event->getAddr() - addr + event->getSize()));
+    uint64_t sendTime = sendResponseUp(event, &data, inMSHR, line->getTimestamp());
+    line->setTimestamp(sendTime-1);
+    cleanUpAfterRequest(event, inMSHR);
+    if (is_debug_addr(addr))
+        eventDI.reason = "hit";
 }
 
 bool MESIL1::handleFlushLine(MemEvent* event, bool inMSHR) {
@@ -780,7 +703,7 @@ bool MESIL1::handleGetSResp(MemEvent* event, bool inMSHR) {
     stat_eventState[(int)Command::GetSResp][state]->addData(1);
 
     MemEvent * req = static_cast<MemEvent*>(mshr_->getFrontEvent(addr));
-    bool localPrefetch = req->isPrefetch() && (req->getRqstr() == cachename_);
+    bool localPrefetch = req->isPrefetch() && (req->getRqstrID() == cacheID_);
 
     if (is_debug_addr(addr))
         eventDI.prefill(event->getID(), Command::GetSResp, localPrefetch, addr, state);
@@ -788,16 +711,16 @@ bool MESIL1::handleGetSResp(MemEvent* event, bool inMSHR) {
     req->setMemFlags(event->getMemFlags()); // Copy MemFlags through
 
     // Update line
-    line->setData(event->getPayload(), 0);
+    line->setData(event->getPayloadBuffer(), 0);
     line->setState(S);
     if (is_debug_addr(addr))
-        printDataValue(addr, line->getData(), false);
+        printDataValue(addr, line->getDataBuffer(), false);
 
     if (req->isLoadLink())
         line->atomicStart(timestamp_ + llscBlockCycles_);
 
     if (is_debug_addr(addr))
-        printDataValue(addr, line->getData(), true);
+        printDataValue(addr, line->getDataBuffer(), true);
 
     if (localPrefetch) {
         line->setPrefetch(true);
@@ -807,7 +730,7 @@ bool MESIL1::handleGetSResp(MemEvent* event, bool inMSHR) {
     } else {
         req->setMemFlags(event->getMemFlags());
         Addr offset = req->getAddr() - addr;
-        vector<uint8_t> data(line->getData()->begin() + offset, line->getData()->begin() + offset + req->getSize());
+        vector<uint8_t> data(line->getDataBuffer().data().begin() + offset, line->getDataBuffer().data().begin() + offset + req->getSize());
         uint64_t sendTime = sendResponseUp(req, &data, true, line->getTimestamp());
         line->setTimestamp(sendTime-1);
     }
@@ -830,7 +753,7 @@ bool MESIL1::handleGetXResp(MemEvent* event, bool inMSHR) {
     stat_eventState[(int)Command::GetXResp][state]->addData(1);
 
     MemEvent * req = static_cast<MemEvent*>(mshr_->getFrontEvent(addr));
-    bool localPrefetch = req->isPrefetch() && (req->getRqstr() == cachename_);
+    bool localPrefetch = req->isPrefetch() && (req->getRqstrID() == cacheID_);
 
     if (is_debug_addr(addr))
         eventDI.prefill(event->getID(), Command::GetXResp, localPrefetch, addr, state);
@@ -844,9 +767,9 @@ bool MESIL1::handleGetXResp(MemEvent* event, bool inMSHR) {
     switch (state) {
         case IS:
             {
-                line->setData(event->getPayload(), 0);
+                line->setData(event->getPayloadBuffer(), 0);
                 if (is_debug_addr(addr))
-                    printDataValue(addr, line->getData(), true);
+                    printDataValue(addr, line->getDataBuffer(), true);
 
                 if (event->getDirty()) {
                     line->setState(M); // Sometimes get dirty data from a noninclusive cache
@@ -861,26 +784,26 @@ bool MESIL1::handleGetXResp(MemEvent* event, bool inMSHR) {
                     line->setPrefetch(true);
                     recordPrefetchLatency(req->getID(), LatType::MISS);
                 } else {
-                    data.assign(line->getData()->begin() + offset, line->getData()->begin() + offset + req->getSize());
+                    data.assign(line->getDataBuffer().data().begin() + offset, line->getDataBuffer().data().begin() + offset + req->getSize());
                     uint64_t sendTime = sendResponseUp(req, &data, true, line->getTimestamp());
                     line->setTimestamp(sendTime - 1);
                 }
                 break;
             }
         case IM:
-            line->setData(event->getPayload(), 0);
+            line->setData(event->getPayloadBuffer(), 0);
             if (is_debug_addr(addr))
-                printDataValue(addr, line->getData(), true);
+                printDataValue(addr, line->getDataBuffer(), true);
         case SM:
             {
                 line->setState(M);
 
                 if (req->getCmd() == Command::Write || req->getCmd() == Command::GetX) {
                     if (!req->isStoreConditional() || line->isAtomic()) { // Normal or successful store-conditional
-                        line->setData(req->getPayload(), offset);
+                        line->setData(req->readPayload(), offset);
 
                         if (is_debug_addr(addr))
-                            printDataValue(addr, line->getData(), true);
+                            printDataValue(addr, line->getDataBuffer(), true);
                         line->atomicEnd(); // Any write causes a future SC to fail 
                     } else {
                         success = false;
@@ -892,7 +815,7 @@ bool MESIL1::handleGetXResp(MemEvent* event, bool inMSHR) {
                 } else { // Read lock/GetSX
                     line->incLock();
                 }
-                data.assign(line->getData()->begin() + offset, line->getData()->begin() + offset + req->getSize());
+                data.assign(line->getDataBuffer().data().begin() + offset, line->getDataBuffer().data().begin() + offset + req->getSize());
                 uint64_t sendTime = sendResponseUp(req, &data, true, line->getTimestamp(), success);
                 line->setTimestamp(sendTime-1);
                 break;
@@ -1166,7 +1089,7 @@ bool MESIL1::handleEviction(Addr addr, L1CacheLine*& line) {
                 } else {
                     note << "InProg, " << StateString[state];
                 }
-                printDebugAlloc(false, line->getAddr(), note.str());
+                printDebugAlloc(false, line->getAddr(), note.str().c_str());
             }
             return false;
     }
@@ -1312,7 +1235,7 @@ void MESIL1::sendResponseDown(MemEvent * event, L1CacheLine * line, bool data) {
     MemEvent * responseEvent = event->makeResponse();
 
     if (data) {
-        responseEvent->setPayload(*line->getData());
+        responseEvent->setPayload(line->getDataBuffer());
         if (line->getState() == M)
             responseEvent->setDirty(true);
     }
@@ -1335,7 +1258,7 @@ void MESIL1::forwardFlush(MemEvent* event, L1CacheLine* line, bool evict) {
     uint64_t latency = tagLatency_; // Check coherence state/hitVmiss
     if (evict) {
         flush->setEvict(true);
-        flush->setPayload(*(line->getData()));
+        flush->setPayload(line->getDataBuffer());
         flush->setDirty(line->getState() == M);
         latency = accessLatency_; // Time to check coherence & access data (in parallel)
     } else {
@@ -1366,17 +1289,17 @@ void MESIL1::sendWriteback(Command cmd, L1CacheLine * line, bool dirty) {
     uint64_t latency = tagLatency_;
 
     if (dirty || writebackCleanBlocks_) {
-        writeback->setPayload(*line->getData());
+        writeback->setPayload(line->getDataBuffer());
         writeback->setDirty(dirty);
 
         if (is_debug_addr(line->getAddr())) {
-            printDataValue(line->getAddr(), line->getData(), false);
+            printDataValue(line->getAddr(), line->getDataBuffer(), false);
         }
 
         latency = accessLatency_;
     }
 
-    writeback->setRqstr(cachename_);
+    writeback->setRqstrID(cacheID_);
 
     uint64_t baseTime = (timestamp_ > line->getTimestamp()) ? timestamp_ : line->getTimestamp();
     uint64_t deliveryTime = baseTime + latency;
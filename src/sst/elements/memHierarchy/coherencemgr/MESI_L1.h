@@ -382,12 +382,27 @@ public:
     virtual std::set<Command> getValidReceiveEvents();
     void setSliceAware(uint64_t interleaveSize, uint64_t interleaveStep);
 
+    void saveCheckpoint(CacheCheckpoint &ckpt) { cacheArray_->saveCheckpoint(ckpt.addSection("cache")); }
+    void loadCheckpoint(const CacheCheckpoint &ckpt, CacheCheckpoint::LoadStats &stats) {
+        if (const CacheCheckpoint::Section * sec = ckpt.getSection("cache"))
+            cacheArray_->loadCheckpoint(*sec, stats);
+    }
+
     void printStatus(Output& out);
 
     Addr getBank(Addr addr);
+    State getLineState(Addr addr) { L1CacheLine* line = cacheArray_->lookup(addr, false); return line ? line->getState() : NP; }
 
 private:
 
+    /** Request handling: handleRequest() looks up the action in the request table, one function per action */
+    bool handleRequest(MemEvent * event, bool inMSHR);
+    MemEventStatus requestMiss(MemEvent * event, L1CacheLine *& line, Command cmd, bool inMSHR);
+    MemEventStatus requestUpgrade(MemEvent * event, L1CacheLine * line, Command cmd, bool inMSHR);
+    void requestReadHit(MemEvent * event, L1CacheLine * line, State state, bool inMSHR, bool localPrefetch);
+    void requestWriteHit(MemEvent * event, L1CacheLine * line, State state, bool inMSHR);
+    void requestLockHit(MemEvent * event, L1CacheLine * line, State state, bool inMSHR);
+
     /** Cache and MSHR management */
     MemEventStatus processCacheMiss(MemEvent * event, L1CacheLine * line, bool inMSHR);
     L1CacheLine* allocateLine(MemEvent * event, L1CacheLine * line);
@@ -0,0 +1,102 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_MESI_L1_TABLE_H
+#define MEMHIERARCHY_MESI_L1_TABLE_H
+
+#include <stdint.h>
+
+#include "sst/elements/memHierarchy/coherencemgr/coherenceTable.h"
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ * MESIL1 request transitions, used by MESIL1::handleRequest()
+ * Writes are looked up as GetX. States/commands without a row stall: the
+ * request waits in the MSHR until the line leaves its transient state.
+ * Only the request path (GetS, GetX, Write, GetSX) is table-driven; MESIL1's
+ * responses, snoops, and flushes still use switch statements.
+ */
+enum class L1Request : uint8_t { Stall, Miss, Upgrade, ReadHit, WriteHit, LockHit };
+
+constexpr CoherenceTable<L1Request, L1Request::Stall> l1RequestTable = {
+    { I, Command::GetS,  L1Request::Miss },
+    { I, Command::GetX,  L1Request::Miss },
+    { I, Command::GetSX, L1Request::Miss },
+    { S, Command::GetS,  L1Request::ReadHit },
+    { S, Command::GetX,  L1Request::Upgrade },
+    { S, Command::GetSX, L1Request::Upgrade },
+    { E, Command::GetS,  L1Request::ReadHit },
+    { E, Command::GetX,  L1Request::WriteHit },
+    { E, Command::GetSX, L1Request::LockHit },
+    { M, Command::GetS,  L1Request::ReadHit },
+    { M, Command::GetX,  L1Request::WriteHit },
+    { M, Command::GetSX, L1Request::LockHit },
+};
+
+static_assert(l1RequestTable.get(IS, Command::GetS) == L1Request::Stall, "Requests to lines in transient states must stall");
+static_assert(l1RequestTable.get(SM, Command::GetX) == L1Request::Stall, "Requests to lines in transient states must stall");
+static_assert(l1RequestTable.get(I, Command::Write) == L1Request::Stall, "Writes are handled as GetX");
+
+/*
+ * The decisions MESIL1's GetS, GetX, and GetSX handlers made with one switch
+ * on the line state each, before l1RequestTable. Debug builds check every
+ * request MESIL1 handles against these, and tests/unitTests/coherenceTable.cc
+ * checks the whole table.
+ */
+inline L1Request l1RequestSwitch(State state, Command cmd) {
+    switch (cmd) {
+        case Command::GetS:
+            switch (state) {
+                case I: return L1Request::Miss;
+                case S:
+                case E:
+                case M: return L1Request::ReadHit;
+                default: return L1Request::Stall;
+            }
+        case Command::GetX:
+            switch (state) {
+                case I: return L1Request::Miss;
+                case S: return L1Request::Upgrade;
+                case E:
+                case M: return L1Request::WriteHit;
+                default: return L1Request::Stall;
+            }
+        case Command::GetSX:
+            switch (state) {
+                case I: return L1Request::Miss;
+                case S: return L1Request::Upgrade;
+                case E:
+                case M: return L1Request::LockHit;
+                default: return L1Request::Stall;
+            }
+        default:
+            return L1Request::Stall;
+    }
+}
+
+/* The state those handlers left the line in when the request was accepted without stalling */
+inline State l1RequestNextState(State state, Command cmd) {
+    switch (l1RequestSwitch(state, cmd)) {
+        case L1Request::Miss:     return cmd == Command::GetS ? IS : IM;
+        case L1Request::Upgrade:  return SM;
+        case L1Request::WriteHit:
+        case L1Request::LockHit:  return M;
+        default:                  return state;
+    }
+}
+
+}}
+#endif // MEMHIERARCHY_MESI_L1_TABLE_H
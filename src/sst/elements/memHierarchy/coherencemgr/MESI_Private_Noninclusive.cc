@@ -20,15 +20,6 @@
 using namespace SST;
 using namespace SST::MemHierarchy;
 
-/* Debug macros */
-#ifdef __SST_DEBUG_OUTPUT__ /* From sst-core, enable with --enable-debug */
-#define is_debug_addr(addr) (DEBUG_ADDR.empty() || DEBUG_ADDR.find(addr) != DEBUG_ADDR.end())
-#define is_debug_event(ev) (DEBUG_ADDR.empty() || ev->doDebug(DEBUG_ADDR))
-#else
-#define is_debug_addr(addr) false
-#define is_debug_event(ev) false
-#endif
-
 /*----------------------------------------------------------------------------------------------------------------------
  * MESI/MSI Non-Inclusive Coherence Controller for private cache
  *
@@ -79,7 +70,7 @@ bool MESIPrivNoninclusive::handleGetS(MemEvent* event, bool inMSHR) {
                 notifyListenerOfAccess(event, NotifyAccessType::READ, NotifyResultType::HIT);
             }
             line->setShared(true);
-            sendTime = sendResponseUp(event, line->getData(), inMSHR, line->getTimestamp());
+            sendTime = sendResponseUp(event, line->getDataBuffer(), inMSHR, line->getTimestamp());
             recordLatencyType(event->getID(), LatType::HIT);
             line->setTimestamp(sendTime);
             if (is_debug_event(event))
@@ -98,10 +89,10 @@ bool MESIPrivNoninclusive::handleGetS(MemEvent* event, bool inMSHR) {
                 eventDI.reason = "hit";
             if (protocol_) { // Transfer ownership of dirty block
                 line->setOwned(true);
-                sendTime = sendExclusiveResponse(event, line->getData(), inMSHR, line->getTimestamp(), state == M);
+                sendTime = sendExclusiveResponse(event, line->getDataBuffer(), inMSHR, line->getTimestamp(), state == M);
             } else { // Will writeback dirty block if we evict
                 line->setShared(true);
-                sendTime = sendResponseUp(event, line->getData(), inMSHR, line->getTimestamp(), Command::GetSResp);
+                sendTime = sendResponseUp(event, line->getDataBuffer(), inMSHR, line->getTimestamp(), Command::GetSResp);
             }
             recordLatencyType(event->getID(), LatType::HIT);
             line->setTimestamp(sendTime);
@@ -182,7 +173,7 @@ bool MESIPrivNoninclusive::handleGetX(MemEvent* event, bool inMSHR) {
             }
             line->setOwned(true);
             line->setShared(false);
-            sendTime = sendExclusiveResponse(event, line->getData(), inMSHR, line->getTimestamp(), true);
+            sendTime = sendExclusiveResponse(event, line->getDataBuffer(), inMSHR, line->getTimestamp(), true);
             line->setTimestamp(sendTime);
             recordLatencyType(event->getID(), LatType::HIT);
             if (is_debug_event(event))
@@ -233,7 +224,7 @@ bool MESIPrivNoninclusive::handleFlushLine(MemEvent * event, bool inMSHR) {
     switch (state) {
         case I:
             if (status == MemEventStatus::OK) {
-                forwardFlush(event, event->getEvict(), &(event->getPayload()), event->getDirty(), 0);
+                forwardFlush(event, event->getEvict(), event->getPayloadBuffer(), event->getDirty(), 0);
                 event->setEvict(false);
                 mshr_->setInProgress(addr);
                 if (!mshr_->getProfiled(addr)) {
@@ -241,7 +232,7 @@ bool MESIPrivNoninclusive::handleFlushLine(MemEvent * event, bool inMSHR) {
                     mshr_->setProfiled(addr);
                 }
             } else if (mshr_->getAcksNeeded(addr) != 0 && event->getEvict()) {
-                mshr_->setData(addr, event->getPayload(), event->getDirty());
+                mshr_->setData(addr, event->readPayload(), event->getDirty());
                 event->setEvict(false);
                 if ((static_cast<MemEvent*>(mshr_->getFrontEvent(addr)))->getCmd() == Command::FetchInvX) {
                     responses.erase(addr);
@@ -269,13 +260,13 @@ bool MESIPrivNoninclusive::handleFlushLine(MemEvent * event, bool inMSHR) {
                     line->setOwned(false);
                     line->setShared(true);
                     if (event->getDirty()) {
-                        line->setData(event->getPayload(), 0);
+                        line->setData(event->getPayloadBuffer(), 0);
                         if (is_debug_addr(addr))
-                            printDataValue(line->getAddr(), line->getData(), true);
+                            printDataValue(line->getAddr(), line->getDataBuffer(), true);
                     }
                     event->setEvict(false);
                 }
-                forwardFlush(event, true, line->getData(), (state == M || event->getDirty()), line->getTimestamp());
+                forwardFlush(event, true, line->getDataBuffer(), (state == M || event->getDirty()), line->getTimestamp());
                 line->setState(S_B);
                 mshr_->setInProgress(addr);
                 if (!mshr_->getProfiled(addr)) {
@@ -290,9 +281,9 @@ bool MESIPrivNoninclusive::handleFlushLine(MemEvent * event, bool inMSHR) {
                 line->setOwned(false);
                 line->setShared(true);
                 if (event->getDirty()) {
-                    line->setData(event->getPayload(), 0);
+                    line->setData(event->getPayloadBuffer(), 0);
                     if (is_debug_addr(addr))
-                        printDataValue(line->getAddr(), line->getData(), true);
+                        printDataValue(line->getAddr(), line->getDataBuffer(), true);
                     line->setState(M_Inv);
                 }
                 event->setEvict(false);
@@ -304,9 +295,9 @@ bool MESIPrivNoninclusive::handleFlushLine(MemEvent * event, bool inMSHR) {
             line->setOwned(false);
             line->setShared(true);
             if (event->getDirty()) {
-                line->setData(event->getPayload(), 0);
+                line->setData(event->getPayloadBuffer(), 0);
                 if (is_debug_addr(addr))
-                    printDataValue(line->getAddr(), line->getData(), true);
+                    printDataValue(line->getAddr(), line->getDataBuffer(), true);
                 line->setState(M_Inv);
             }
             event->setEvict(false);
@@ -352,7 +343,7 @@ bool MESIPrivNoninclusive::handleFlushLineInv(MemEvent * event, bool inMSHR) {
             if (inMSHR && mshr_->getInProgress(addr))
                 break; // Triggered an unneccessary retry
             if (status == MemEventStatus::OK) {
-                forwardFlush(event, event->getEvict(), &(event->getPayload()), event->getDirty(), 0); // No need to evict since we didn't race
+                forwardFlush(event, event->getEvict(), event->getPayloadBuffer(), event->getDirty(), 0); // No need to evict since we didn't race
                 mshr_->setInProgress(addr);
                 if (!mshr_->getProfiled(addr)) {
                     stat_eventState[(int)Command::FlushLineInv][I]->addData(1);
@@ -375,7 +366,7 @@ bool MESIPrivNoninclusive::handleFlushLineInv(MemEvent * event, bool inMSHR) {
                     break;
 
                 // Copy data in and update state to resolve race with conflicting event
-                mshr_->setData(addr, event->getPayload(), event->getDirty());
+                mshr_->setData(addr, event->readPayload(), event->getDirty());
                 if (race->getCmd() == Command::FetchInvX) {
                     event->setDirty(false);
                 } else if (race->getCmd() != Command::Fetch) { // FetchInv, ForceInv, or Inv
@@ -392,7 +383,7 @@ bool MESIPrivNoninclusive::handleFlushLineInv(MemEvent * event, bool inMSHR) {
                 if (event->getEvict())
                     line->setShared(false);
                 line->setState(I_B);
-                forwardFlush(event, true, line->getData(), false, line->getTimestamp());
+                forwardFlush(event, true, line->getDataBuffer(), false, line->getTimestamp());
                 mshr_->setInProgress(addr);
                 if (!mshr_->getProfiled(addr)) {
                     stat_eventState[(int)Command::FlushLineInv][S]->addData(1);
@@ -407,13 +398,13 @@ bool MESIPrivNoninclusive::handleFlushLineInv(MemEvent * event, bool inMSHR) {
                     line->setOwned(false);
                     line->setShared(false);
                     if (event->getDirty()) {
-                        line->setData(event->getPayload(), 0);
+                        line->setData(event->getPayloadBuffer(), 0);
                         line->setState(M);
                         if (is_debug_addr(addr))
-                            printDataValue(line->getAddr(), line->getData(), true);
+                            printDataValue(line->getAddr(), line->getDataBuffer(), true);
                     }
                 }
-                forwardFlush(event, true, line->getData(), line->getState() == M, line->getTimestamp());
+                forwardFlush(event, true, line->getDataBuffer(), line->getState() == M, line->getTimestamp());
                 line->setState(I_B);
                 mshr_->setInProgress(addr);
                 if (!mshr_->getProfiled(addr)) {
@@ -437,10 +428,10 @@ bool MESIPrivNoninclusive::handleFlushLineInv(MemEvent * event, bool inMSHR) {
             line->setOwned(false);
             line->setShared(false);
             if (event->getDirty()) {
-                line->setData(event->getPayload(), 0);
+                line->setData(event->getPayloadBuffer(), 0);
                 line->setState(M);
                 if (is_debug_addr(addr))
-                    printDataValue(line->getAddr(), line->getData(), true);
+                    printDataValue(line->getAddr(), line->getDataBuffer(), true);
             } else {
                 line->setState(E);
             }
@@ -456,9 +447,9 @@ bool MESIPrivNoninclusive::handleFlushLineInv(MemEvent * event, bool inMSHR) {
             line->setOwned(false);
             line->setShared(false);
             if (event->getDirty()) {
-                line->setData(event->getPayload(), 0);
+                line->setData(event->getPayloadBuffer(), 0);
                 if (is_debug_addr(addr))
-                    printDataValue(line->getAddr(), line->getData(), true);
+                    printDataValue(line->getAddr(), line->getDataBuffer(), true);
             }
             event->setEvict(false);
             mshr_->decrementAcksNeeded(addr);
@@ -502,16 +493,16 @@ bool MESIPrivNoninclusive::handlePutS(MemEvent * event, bool inMSHR) {
     switch (state) {
         case I:
             if (!inMSHR && mshr_->exists(addr)) { // Raced with something; must be an Inv/Fetch since there can only be one cache above us
-                mshr_->setData(addr, event->getPayload(), false);
+                mshr_->setData(addr, event->readPayload(), false);
                 responses.erase(addr);
                 mshr_->decrementAcksNeeded(addr);
                 if (mshr_->getFrontType(addr) == MSHREntryType::Event && mshr_->getFrontEvent(addr)->getCmd() == Command::Fetch) {
                     status = allocateLine(event, line, false);
                     if (status == MemEventStatus::OK) {
                         line->setState(S);
-                        line->setData(event->getPayload(), 0);
+                        line->setData(event->getPayloadBuffer(), 0);
                         if (is_debug_addr(addr))
-                            printDataValue(line->getAddr(), line->getData(), true);
+                            printDataValue(line->getAddr(), line->getDataBuffer(), true);
                         mshr_->clearData(addr);
                         sendWritebackAck(event);
                         cleanUpAfterRequest(event, inMSHR);
@@ -526,9 +517,9 @@ bool MESIPrivNoninclusive::handlePutS(MemEvent * event, bool inMSHR) {
                 status = allocateLine(event, line, inMSHR);
                 if (status == MemEventStatus::OK) {
                     line->setState(S);
-                    line->setData(event->getPayload(), 0);
+                    line->setData(event->getPayloadBuffer(), 0);
                     if (is_debug_addr(addr))
-                        printDataValue(line->getAddr(), line->getData(), true);
+                        printDataValue(line->getAddr(), line->getDataBuffer(), true);
                     if (mshr_->hasData(addr)) mshr_->clearData(addr);
                     sendWritebackAck(event);
                     cleanUpAfterRequest(event, inMSHR);
@@ -608,13 +599,13 @@ bool MESIPrivNoninclusive::handlePutE(MemEvent * event, bool inMSHR) {
                 if (mshr_->getFrontType(addr) == MSHREntryType::Event && mshr_->getFrontEvent(addr)->getCmd() == Command::FetchInvX) {
                     mshr_->decrementAcksNeeded(addr);
                     responses.erase(addr);
-                    mshr_->setData(addr, event->getPayload(), false);
+                    mshr_->setData(addr, event->readPayload(), false);
                     event->setCmd(Command::PutS);
                     event->setDirty(false);
                     retry(addr);
                     status = allocateMSHR(event, false, 1, true);
                 } else {
-                    mshr_->setData(addr, event->getPayload(), false);
+                    mshr_->setData(addr, event->readPayload(), false);
                     mshr_->decrementAcksNeeded(addr);
                     responses.erase(addr);
                     sendWritebackAck(event);
@@ -625,9 +616,9 @@ bool MESIPrivNoninclusive::handlePutE(MemEvent * event, bool inMSHR) {
                 status = allocateLine(event, line, inMSHR);
                 if (status == MemEventStatus::OK) {
                     event->getDirty() ? line->setState(M) : line->setState(E);
-                    line->setData(event->getPayload(), 0);
+                    line->setData(event->getPayloadBuffer(), 0);
                     if (is_debug_addr(addr))
-                        printDataValue(line->getAddr(), line->getData(), true);
+                        printDataValue(line->getAddr(), line->getDataBuffer(), true);
                     sendWritebackAck(event);
                     if (mshr_->hasData(addr)) mshr_->clearData(addr);
                     cleanUpAfterRequest(event, inMSHR);
@@ -698,13 +689,13 @@ bool MESIPrivNoninclusive::handlePutM(MemEvent * event, bool inMSHR) {
                 if (mshr_->getFrontType(addr) == MSHREntryType::Event && mshr_->getFrontEvent(addr)->getCmd() == Command::FetchInvX) {
                     mshr_->decrementAcksNeeded(addr);
                     responses.erase(addr);
-                    mshr_->setData(addr, event->getPayload(), true);
+                    mshr_->setData(addr, event->readPayload(), true);
                     event->setCmd(Command::PutS);
                     event->setDirty(false);
                     retry(addr);
                     status = allocateMSHR(event, false, 1);
                 } else { // Eviction or invalidation -> we won't need a line
-                    mshr_->setData(addr, event->getPayload(), true);
+                    mshr_->setData(addr, event->readPayload(), true);
                     mshr_->decrementAcksNeeded(addr);
                     responses.erase(addr);
                     sendWritebackAck(event);
@@ -715,9 +706,9 @@ bool MESIPrivNoninclusive::handlePutM(MemEvent * event, bool inMSHR) {
                 status = allocateLine(event, line, inMSHR);
                 if (status == MemEventStatus::OK) {
                     line->setState(M);
-                    line->setData(event->getPayload(), 0);
+                    line->setData(event->getPayloadBuffer(), 0);
                     if (is_debug_addr(addr))
-                        printDataValue(line->getAddr(), line->getData(), true);
+                        printDataValue(line->getAddr(), line->getDataBuffer(), true);
                     if (mshr_->hasData(addr)) mshr_->clearData(addr);
                     sendWritebackAck(event);
                     cleanUpAfterRequest(event, inMSHR);
@@ -728,9 +719,9 @@ bool MESIPrivNoninclusive::handlePutM(MemEvent * event, bool inMSHR) {
         case M:
             line->setOwned(false);
             line->setState(M);
-            line->setData(event->getPayload(), 0);
+            line->setData(event->getPayloadBuffer(), 0);
             if (is_debug_addr(addr))
-                printDataValue(line->getAddr(), line->getData(), true);
+                printDataValue(line->getAddr(), line->getDataBuffer(), true);
             sendWritebackAck(event);
             cleanUpAfterRequest(event, inMSHR);
             break;
@@ -783,7 +774,7 @@ bool MESIPrivNoninclusive::handlePutX(MemEvent * event, bool inMSHR) {
     switch (state) {
         case I:
             if (mshr_->getAcksNeeded(addr)) {
-                mshr_->setData(addr, event->getPayload(), event->getDirty());
+                mshr_->setData(addr, event->readPayload(), event->getDirty());
                 sendWritebackAck(event);
                 delete event;
 
@@ -796,9 +787,9 @@ bool MESIPrivNoninclusive::handlePutX(MemEvent * event, bool inMSHR) {
                 status = allocateLine(event, line, inMSHR);
                 if (status == MemEventStatus::OK) {
                     event->getDirty() ? line->setState(M) : line->setState(E);
-                    line->setData(event->getPayload(), 0);
+                    line->setData(event->getPayloadBuffer(), 0);
                     if (is_debug_addr(addr))
-                        printDataValue(line->getAddr(), line->getData(), true);
+                        printDataValue(line->getAddr(), line->getDataBuffer(), true);
                     sendWritebackAck(event);
                     if (mshr_->hasData(addr)) mshr_->clearData(addr);
                     cleanUpAfterRequest(event, inMSHR);
@@ -811,9 +802,9 @@ bool MESIPrivNoninclusive::handlePutX(MemEvent * event, bool inMSHR) {
             line->setShared(true);
             if (event->getDirty()) {
                 line->setState(M);
-                line->setData(event->getPayload(), 0);
+                line->setData(event->getPayloadBuffer(), 0);
                 if (is_debug_addr(addr))
-                    printDataValue(line->getAddr(), line->getData(), true);
+                    printDataValue(line->getAddr(), line->getDataBuffer(), true);
             }
             sendWritebackAck(event);
             cleanUpAfterRequest(event, inMSHR);
@@ -824,9 +815,9 @@ bool MESIPrivNoninclusive::handlePutX(MemEvent * event, bool inMSHR) {
             line->setShared(true);
             if (event->getDirty()) {
                 line->setState(M_Inv);
-                line->setData(event->getPayload(), 0);
+                line->setData(event->getPayloadBuffer(), 0);
                 if (is_debug_addr(addr))
-                    printDataValue(line->getAddr(), line->getData(), true);
+                    printDataValue(line->getAddr(), line->getDataBuffer(), true);
             }
             sendWritebackAck(event);
             delete event;
@@ -839,9 +830,9 @@ bool MESIPrivNoninclusive::handlePutX(MemEvent * event, bool inMSHR) {
             line->setShared(true);
             if (event->getDirty()) {
                 line->setState(M);
-                line->setData(event->getPayload(), 0);
+                line->setData(event->getPayloadBuffer(), 0);
                 if (is_debug_addr(addr))
-                        printDataValue(line->getAddr(), line->getData(), true);
+                        printDataValue(line->getAddr(), line->getDataBuffer(), true);
             } else {
                 line->setState(E);
             }
@@ -896,7 +887,7 @@ bool MESIPrivNoninclusive::handleFetch(MemEvent * event, bool inMSHR) {
                     delete event;
                 } else if (mshr_->getFrontEvent(addr)->getCmd() == Command::PutS) { // Raced with replacement
                     MemEvent* put = static_cast<MemEvent*>(mshr_->getFrontEvent(addr));
-                    sendResponseDown(event, event->getSize(), &(put->getPayload()), false);
+                    sendResponseDown(event, event->getSize(), put->getPayloadBuffer(), false);
                     delete event;
                 } else { // Raced with GetX or FlushLine
                     status = allocateMSHR(event, true, 0);
@@ -913,7 +904,7 @@ bool MESIPrivNoninclusive::handleFetch(MemEvent * event, bool inMSHR) {
         case SM:
         case S_B:
         case S_Inv:
-            sendResponseDown(event, event->getSize(), line->getData(), false);
+            sendResponseDown(event, event->getSize(), line->getDataBuffer(), false);
             cleanUpAfterRequest(event, inMSHR);
             break;
         case I_B:
@@ -1032,7 +1023,7 @@ bool MESIPrivNoninclusive::handleInv(MemEvent * event, bool inMSHR) {
                 line->setTimestamp(sendTime);
             }
         } else {
-            sendResponseDown(event, event->getSize(), line->getData(), false);
+            sendResponseDown(event, event->getSize(), line->getDataBuffer(), false);
             line->setState(state2);
             if (mshr_->hasData(addr))
                 mshr_->clearData(addr);
@@ -1105,7 +1096,7 @@ bool MESIPrivNoninclusive::handleForceInv(MemEvent * event, bool inMSHR) {
             } else if (mshr_->exists(addr) && mshr_->getFrontEvent(addr)->getCmd() == Command::PutX) { // Drop PutX, Ack it, forward request up
                 MemEvent * put = static_cast<MemEvent*>(mshr_->swapFrontEvent(addr, event));
                 sendWritebackAck(put);
-                mshr_->setData(addr, put->getPayload(), put->getDirty());
+                mshr_->setData(addr, put->readPayload(), put->getDirty());
                 delete put;
                 sendFwdRequest(event, Command::ForceInv, upperCacheName_, event->getSize(), 0, inMSHR);
             } else if (mshr_->exists(addr) && (CommandWriteback[(int)mshr_->getFrontEvent(addr)->getCmd()])) {
@@ -1236,7 +1227,7 @@ bool MESIPrivNoninclusive::handleFetchInv(MemEvent * event, bool inMSHR){
                 if (entry) {
                     if (entry->getCmd() == Command::PutS) {
                         // Return AckInv
-                        sendResponseDown(event, event->getSize(), &(static_cast<MemEvent*>(entry)->getPayload()), false);
+                        sendResponseDown(event, event->getSize(), static_cast<MemEvent*>(entry)->getPayloadBuffer(), false);
                         delete event;
                         // Drop PutS
                         if (mshr_->hasData(addr)) mshr_->clearData(addr);
@@ -1246,7 +1237,7 @@ bool MESIPrivNoninclusive::handleFetchInv(MemEvent * event, bool inMSHR){
                         break;
                     } else if (entry->getCmd() == Command::FlushLineInv) {
                         // Handle FetchInv
-                        sendResponseDown(event, event->getSize(), &(static_cast<MemEvent*>(entry)->getPayload()), false);
+                        sendResponseDown(event, event->getSize(), static_cast<MemEvent*>(entry)->getPayloadBuffer(), false);
                         if (mshr_->hasData(addr)) mshr_->clearData(addr);
                         // Drop evict part of Flush if needed
                         MemEvent* flush = static_cast<MemEvent*>(entry);
@@ -1268,13 +1259,13 @@ bool MESIPrivNoninclusive::handleFetchInv(MemEvent * event, bool inMSHR){
             } else if (mshr_->exists(addr) && mshr_->getFrontEvent(addr)->getCmd() == Command::PutX) { // Drop PutX, Ack it, forward request up
                 MemEvent * put = static_cast<MemEvent*>(mshr_->swapFrontEvent(addr, event));
                 sendWritebackAck(put);
-                mshr_->setData(addr, put->getPayload(), put->getDirty());
+                mshr_->setData(addr, put->readPayload(), put->getDirty());
                 delete put;
                 sendFwdRequest(event, Command::FetchInv, upperCacheName_, event->getSize(), 0, inMSHR);
             } else if (mshr_->exists(addr) && (CommandWriteback[(int)mshr_->getFrontEvent(addr)->getCmd()])) {
                 MemEvent * put = static_cast<MemEvent*>(mshr_->getFrontEvent(addr));
                 sendWritebackAck(put);
-                sendResponseDown(event, put->getSize(), &(put->getPayload()), put->getDirty());
+                sendResponseDown(event, put->getSize(), put->getPayloadBuffer(), put->getDirty());
                 mshr_->removeFront(addr);
                 delete put;
                 cleanUpAfterRequest(event, inMSHR);
@@ -1332,7 +1323,7 @@ bool MESIPrivNoninclusive::handleFetchInv(MemEvent * event, bool inMSHR){
                 line->setState(state1);
             }
         } else {
-            sendResponseDown(event, event->getSize(), line->getData(), state == M);
+            sendResponseDown(event, event->getSize(), line->getDataBuffer(), state == M);
             line->setState(state2);
             cleanUpAfterRequest(event, inMSHR);
         }
@@ -1390,14 +1381,14 @@ bool MESIPrivNoninclusive::handleFetchInvX(MemEvent * event, bool inMSHR) {
                 } else if (mshr_->getFrontEvent(addr)->getCmd() == Command::PutX) {
                     MemEvent * put = static_cast<MemEvent*>(mshr_->getFrontEvent(addr));
                     sendWritebackAck(put);
-                    sendResponseDown(event, put->getSize(), &(put->getPayload()), put->getDirty());
+                    sendResponseDown(event, put->getSize(), put->getPayloadBuffer(), put->getDirty());
                     delete put;
                     mshr_->removeFront(addr);
                     cleanUpAfterRequest(event, inMSHR);
                     break;
                 } else if (mshr_->getFrontEvent(addr)->getCmd() == Command::PutE || mshr_->getFrontEvent(addr)->getCmd() == Command::PutM) {
                     MemEvent * put = static_cast<MemEvent*>(mshr_->getFrontEvent(addr));
-                    sendResponseDown(event, put->getSize(), &(put->getPayload()), put->getDirty());
+                    sendResponseDown(event, put->getSize(), put->getPayloadBuffer(), put->getDirty());
                     put->setCmd(Command::PutS); // Make this a PutS so we only record the block in shared later
                     put->setDirty(false);
                     delete event;
@@ -1423,7 +1414,7 @@ bool MESIPrivNoninclusive::handleFetchInvX(MemEvent * event, bool inMSHR) {
                 }
                 break;
             }
-            sendResponseDown(event, event->getSize(), line->getData(), state == M);
+            sendResponseDown(event, event->getSize(), line->getDataBuffer(), state == M);
             line->setState(S);
             cleanUpAfterRequest(event, inMSHR);
             break;
@@ -1467,16 +1458,16 @@ bool MESIPrivNoninclusive::handleGetSResp(MemEvent * event, bool inMSHR) {
     MemEvent * req = static_cast<MemEvent*>(mshr_->getFrontEvent(addr));
     req->setFlags(event->getMemFlags());
 
-    uint64_t sendTime = sendResponseUp(req, &(event->getPayload()), true, line ? line->getTimestamp() : 0);
+    uint64_t sendTime = sendResponseUp(req, event->getPayloadBuffer(), true, line ? line->getTimestamp() : 0);
 
     // Update line
     if (line) {
-        line->setData(event->getPayload(), 0);
+        line->setData(event->getPayloadBuffer(), 0);
         line->setState(S);
         line->setShared(true);
         line->setTimestamp(sendTime-1);
         if (is_debug_addr(addr))
-            printDataValue(line->getAddr(), line->getData(), true);
+            printDataValue(line->getAddr(), line->getDataBuffer(), true);
     }
 
     cleanUpAfterResponse(event, inMSHR);
@@ -1508,7 +1499,7 @@ bool MESIPrivNoninclusive::handleGetXResp(MemEvent * event, bool inMSHR) {
     switch (state) {
         case I:
         {
-            sendExclusiveResponse(req, &(event->getPayload()), true, 0, event->getDirty());
+            sendExclusiveResponse(req, event->getPayloadBuffer(), true, 0, event->getDirty());
             cleanUpAfterResponse(event, inMSHR);
             break;
         }
@@ -1519,7 +1510,7 @@ bool MESIPrivNoninclusive::handleGetXResp(MemEvent * event, bool inMSHR) {
             if (line->getShared())
                 line->setShared(false);
 
-            uint64_t sendTime = sendExclusiveResponse(req, line->getData(), true, line->getTimestamp(), event->getDirty());
+            uint64_t sendTime = sendExclusiveResponse(req, line->getDataBuffer(), true, line->getTimestamp(), event->getDirty());
             line->setTimestamp(sendTime-1);
             cleanUpAfterResponse(event, inMSHR);
             break;
@@ -1598,14 +1589,14 @@ bool MESIPrivNoninclusive::handleFetchResp(MemEvent * event, bool inMSHR) {
 
     if (state == I) { // Fetch or FetchInv
         MemEvent * req = static_cast<MemEvent*>(mshr_->getFrontEvent(addr));
-        sendResponseDown(req, event->getSize(), &(event->getPayload()), event->getDirty());
+        sendResponseDown(req, event->getSize(), event->getPayloadBuffer(), event->getDirty());
         cleanUpAfterResponse(event, inMSHR);
     } else {    // FetchInv only
         if (event->getDirty()) {
             line->setState(M);
-            line->setData(event->getPayload(), 0);
+            line->setData(event->getPayloadBuffer(), 0);
             if (is_debug_addr(addr))
-                printDataValue(line->getAddr(), line->getData(), true);
+                printDataValue(line->getAddr(), line->getDataBuffer(), true);
         } else if (state == M_Inv) {
             line->setState(M);
         } else {
@@ -1643,16 +1634,16 @@ bool MESIPrivNoninclusive::handleFetchXResp(MemEvent * event, bool inMSHR) {
 
     if (state == I) {
         MemEvent * req = static_cast<MemEvent*>(mshr_->getFrontEvent(addr));
-        sendResponseDown(req, event->getSize(), &(event->getPayload()), event->getDirty());
+        sendResponseDown(req, event->getSize(), event->getPayloadBuffer(), event->getDirty());
         cleanUpAfterResponse(event, inMSHR);
     } else {
         line->setOwned(false);
         line->setShared(true);
         if (event->getDirty()) {
             line->setState(M);
-            line->setData(event->getPayload(), 0);
+            line->setData(event->getPayloadBuffer(), 0);
             if (is_debug_addr(addr))
-                printDataValue(line->getAddr(), line->getData(), true);
+                printDataValue(line->getAddr(), line->getDataBuffer(), true);
         } else if (state == M_InvX) {
             line->setState(M);
         } else {
@@ -1932,7 +1923,7 @@ bool MESIPrivNoninclusive::handleEviction(Addr addr, PrivateCacheLine*& line, db
         case S:
             if (!mshr_->getPendingRetries(line->getAddr())) {
                 if (!line->getShared() && !silentEvictClean_) {
-                    uint64_t sendTime = sendWriteback(line->getAddr(), lineSize_, Command::PutS, line->getData(), false, line->getTimestamp());
+                    uint64_t sendTime = sendWriteback(line->getAddr(), lineSize_, Command::PutS, line->getDataBuffer(), false, line->getTimestamp());
                     line->setTimestamp(sendTime-1);
                     mshr_->insertWriteback(line->getAddr(), false);
                     if (is_debug_addr(line->getAddr()))
@@ -1951,7 +1942,7 @@ bool MESIPrivNoninclusive::handleEviction(Addr addr, PrivateCacheLine*& line, db
         case E:
             if (!mshr_->getPendingRetries(line->getAddr())) {
                 if (line->getShared()) {
-                    uint64_t sendTime = sendWriteback(line->getAddr(), lineSize_, Command::PutX, line->getData(), false, line->getTimestamp());
+                    uint64_t sendTime = sendWriteback(line->getAddr(), lineSize_, Command::PutX, line->getDataBuffer(), false, line->getTimestamp());
                     line->setTimestamp(sendTime-1);
                     mshr_->insertWriteback(line->getAddr(), true);
                     if (is_debug_addr(addr) || is_debug_addr(line->getAddr()))
@@ -1959,7 +1950,7 @@ bool MESIPrivNoninclusive::handleEviction(Addr addr, PrivateCacheLine*& line, db
                     if (is_debug_addr(line->getAddr()))
                         printDebugAlloc(false, line->getAddr(), "Writeback");
                 } else if (!line->getOwned() && !silentEvictClean_) {
-                    uint64_t sendTime = sendWriteback(line->getAddr(), lineSize_, Command::PutE, line->getData(), false, line->getTimestamp());
+                    uint64_t sendTime = sendWriteback(line->getAddr(), lineSize_, Command::PutE, line->getDataBuffer(), false, line->getTimestamp());
                     line->setTimestamp(sendTime-1);
                     mshr_->insertWriteback(line->getAddr(), false);
                     if (is_debug_addr(line->getAddr()))
@@ -1977,7 +1968,7 @@ bool MESIPrivNoninclusive::handleEviction(Addr addr, PrivateCacheLine*& line, db
         case M:
             if (!mshr_->getPendingRetries(line->getAddr())) {
                 if (line->getShared()) {
-                    uint64_t sendTime = sendWriteback(line->getAddr(), lineSize_, Command::PutX, line->getData(), true, line->getTimestamp());
+                    uint64_t sendTime = sendWriteback(line->getAddr(), lineSize_, Command::PutX, line->getDataBuffer(), true, line->getTimestamp());
                     line->setTimestamp(sendTime-1);
                     mshr_->insertWriteback(line->getAddr(), true);
                     if (is_debug_addr(addr) || is_debug_addr(line->getAddr()))
@@ -1985,7 +1976,7 @@ bool MESIPrivNoninclusive::handleEviction(Addr addr, PrivateCacheLine*& line, db
                     if (is_debug_addr(line->getAddr()))
                         printDebugAlloc(false, line->getAddr(), "Writeback");
                 } else if (!line->getOwned()) {
-                    uint64_t sendTime = sendWriteback(line->getAddr(), lineSize_, Command::PutM, line->getData(), true, line->getTimestamp());
+                    uint64_t sendTime = sendWriteback(line->getAddr(), lineSize_, Command::PutM, line->getDataBuffer(), true, line->getTimestamp());
                     line->setTimestamp(sendTime-1);
                     mshr_->insertWriteback(line->getAddr(), false);
                     if (is_debug_addr(addr) || is_debug_addr(line->getAddr())) {
@@ -2137,18 +2128,16 @@ void MESIPrivNoninclusive::retry(Addr addr) {
  * Protocol helper functions
  ***********************************************************************************************************/
 
-uint64_t MESIPrivNoninclusive::sendExclusiveResponse(MemEvent * event, vector<uint8_t>* data, bool inMSHR, uint64_t time, bool dirty) {
+uint64_t MESIPrivNoninclusive::sendExclusiveResponse(MemEvent * event, const LineBuffer& data, bool inMSHR, uint64_t time, bool dirty) {
     MemEvent * responseEvent = event->makeResponse();
     responseEvent->setCmd(Command::GetXResp);
 
-    if (data) {
-        responseEvent->setPayload(*data);
-        responseEvent->setSize(data->size()); // Return size that was written
-        if (is_debug_event(event)) {
-            printDataValue(event->getAddr(), data, false);
-        }
-        responseEvent->setDirty(dirty);
+    responseEvent->setPayload(data);
+    responseEvent->setSize(data.size()); // Return size that was written
+    if (is_debug_event(event)) {
+        printDataValue(event->getAddr(), data, false);
     }
+    responseEvent->setDirty(dirty);
 
     if (time < timestamp_) time = timestamp_;
     uint64_t deliveryTime = time + (inMSHR ? mshrLatency_ : accessLatency_);
@@ -2166,16 +2155,39 @@ uint64_t MESIPrivNoninclusive::sendExclusiveResponse(MemEvent * event, vector<ui
 }
 
 uint64_t MESIPrivNoninclusive::sendResponseUp(MemEvent * event, vector<uint8_t> * data, bool inMSHR, uint64_t time, Command cmd, bool success) {
+    if (data) {
+        LineBuffer buffer;
+        buffer.assign(*data);
+        return sendResponseUp(event, buffer, inMSHR, time, cmd, success);
+    }
+
     MemEvent * responseEvent = event->makeResponse();
     if (cmd != Command::NULLCMD)
         responseEvent->setCmd(cmd);
 
-    if (data) {
-        responseEvent->setPayload(*data);
-        responseEvent->setSize(data->size()); // Return size that was written
-        if (is_debug_event(event)) {
-            printDataValue(event->getAddr(), data, false);
-        }
+    if (!success)
+        responseEvent->setFail();
+
+    if (time < timestamp_) time = timestamp_;
+    uint64_t deliveryTime = time + (inMSHR ? mshrLatency_ : accessLatency_);
+    forwardByDestination(responseEvent, deliveryTime);
+
+    if (is_debug_event(responseEvent))
+        eventDI.action = "Respond";
+
+    return deliveryTime;
+}
+
+/* Respond with 'data', sharing the buffer instead of copying it */
+uint64_t MESIPrivNoninclusive::sendResponseUp(MemEvent * event, const LineBuffer& data, bool inMSHR, uint64_t time, Command cmd, bool success) {
+    MemEvent * responseEvent = event->makeResponse();
+    if (cmd != Command::NULLCMD)
+        responseEvent->setCmd(cmd);
+
+    responseEvent->setPayload(data);
+    responseEvent->setSize(data.size()); // Return size that was written
+    if (is_debug_event(event)) {
+        printDataValue(event->getAddr(), data, false);
     }
 
     if (!success)
@@ -2198,16 +2210,33 @@ uint64_t MESIPrivNoninclusive::sendResponseUp(MemEvent * event, vector<uint8_t>
 }
 
 void MESIPrivNoninclusive::sendResponseDown(MemEvent * event, uint32_t size, vector<uint8_t>* data, bool dirty) {
-    MemEvent * responseEvent = event->makeResponse();
-
     if (data) {
-        responseEvent->setPayload(*data);
-        responseEvent->setDirty(dirty);
+        LineBuffer buffer;
+        buffer.assign(*data);
+        sendResponseDown(event, size, buffer, dirty);
+        return;
     }
 
+    MemEvent * responseEvent = event->makeResponse();
+    responseEvent->setSize(size);
+
+    uint64_t deliveryTime = timestamp_ + tagLatency_;
+    forwardByDestination(responseEvent, deliveryTime);
+
+    if (is_debug_event(responseEvent))
+        eventDI.action = "Respond";
+}
+
+/* Respond with 'data', sharing the buffer instead of copying it */
+void MESIPrivNoninclusive::sendResponseDown(MemEvent * event, uint32_t size, const LineBuffer& data, bool dirty) {
+    MemEvent * responseEvent = event->makeResponse();
+
+    responseEvent->setPayload(data);
+    responseEvent->setDirty(dirty);
+
     responseEvent->setSize(size);
 
-    uint64_t deliveryTime = timestamp_ + (data ? accessLatency_ : tagLatency_);
+    uint64_t deliveryTime = timestamp_ + accessLatency_;
     forwardByDestination(responseEvent, deliveryTime);
 
     if (is_debug_event(responseEvent)) {
@@ -2219,13 +2248,21 @@ void MESIPrivNoninclusive::sendResponseDown(MemEvent * event, uint32_t size, vec
 
 
 uint64_t MESIPrivNoninclusive::forwardFlush(MemEvent * event, bool evict, std::vector<uint8_t>* data, bool dirty, uint64_t time) {
+    LineBuffer buffer;
+    if (data)
+        buffer.assign(*data);
+    return forwardFlush(event, evict, buffer, dirty, time);
+}
+
+/* Forward a flush, sharing 'data' instead of copying it. 'data' is only sent if 'evict' is set. */
+uint64_t MESIPrivNoninclusive::forwardFlush(MemEvent * event, bool evict, const LineBuffer& data, bool dirty, uint64_t time) {
     MemEvent * flush = new MemEvent(*event);
 
     uint64_t latency = tagLatency_;
     if (evict) {
         flush->setEvict(true);
         // TODO only send payload when needed
-        flush->setPayload(*data);
+        flush->setPayload(data);
         flush->setDirty(dirty);
         latency = accessLatency_;
     } else {
@@ -2257,7 +2294,7 @@ uint64_t MESIPrivNoninclusive::forwardFlush(MemEvent * event, bool evict, std::v
  *  Latency: cache access + tag to read data that is being written back and update coherence state
  */
 
-uint64_t MESIPrivNoninclusive::sendWriteback(Addr addr, uint32_t size, Command cmd, std::vector<uint8_t>* data, bool dirty, uint64_t startTime) {
+uint64_t MESIPrivNoninclusive::sendWriteback(Addr addr, uint32_t size, Command cmd, const LineBuffer& data, bool dirty, uint64_t startTime) {
     MemEvent* writeback = new MemEvent(cachename_, addr, addr, cmd);
     writeback->setSize(size);
 
@@ -2265,7 +2302,7 @@ uint64_t MESIPrivNoninclusive::sendWriteback(Addr addr, uint32_t size, Command c
 
     /* Writeback data */
     if (dirty || writebackCleanBlocks_) {
-        writeback->setPayload(*data);
+        writeback->setPayload(data);
         writeback->setDirty(dirty);
 
         if (is_debug_addr(addr)) {
@@ -2275,7 +2312,7 @@ uint64_t MESIPrivNoninclusive::sendWriteback(Addr addr, uint32_t size, Command c
         latency = accessLatency_;
     }
 
-    writeback->setRqstr(cachename_);
+    writeback->setRqstrID(cacheID_);
 
     uint64_t sendTime = timestamp_ > startTime ? timestamp_ : startTime;
     sendTime += latency;
@@ -38,7 +38,7 @@ bool MESISharNoninclusive::handleGetS(MemEvent* event, bool inMSHR) {
     DataLine * data = (tag) ? dataArray_->lookup(addr, true) : nullptr;
     if (data && data->getTag() != tag) data = nullptr;
 
-    bool localPrefetch = event->isPrefetch() && (event->getRqstr() == cachename_);
+    bool localPrefetch = event->isPrefetch() && (event->getRqstrID() == cacheID_);
     uint64_t sendTime = 0;
     MemEventStatus status = MemEventStatus::OK;
     Command respcmd;
@@ -110,7 +110,7 @@ bool MESISharNoninclusive::handleGetS(MemEvent* event, bool inMSHR) {
                 if (mshr_->hasData(addr))
                     sendTime = sendResponseUp(event, &(mshr_->getData(addr)), inMSHR, tag->getTimestamp());
                 else
-                    sendTime = sendResponseUp(event, data->getData(), inMSHR, tag->getTimestamp());
+                    sendTime = sendResponseUp(event, data->getDataBuffer(), inMSHR, tag->getTimestamp());
                 tag->setTimestamp(sendTime-1);
                 recordLatencyType(event->getID(), LatType::HIT);
                 cleanUpAfterRequest(event, inMSHR);
@@ -178,7 +178,7 @@ bool MESISharNoninclusive::handleGetS(MemEvent* event, bool inMSHR) {
                 if (mshr_->hasData(addr))
                     sendTime = sendResponseUp(event, &(mshr_->getData(addr)), inMSHR, tag->getTimestamp(), respcmd);
                 else
-                    sendTime = sendResponseUp(event, data->getData(), inMSHR, tag->getTimestamp(), respcmd);
+                    sendTime = sendResponseUp(event, data->getDataBuffer(), inMSHR, tag->getTimestamp(), respcmd);
                 tag->setTimestamp(sendTime - 1);
                 cleanUpAfterRequest(event, inMSHR);
             } else {
@@ -310,7 +310,7 @@ bool MESISharNoninclusive::handleGetX(MemEvent * event, bool inMSHR) {
                 } else if (mshr_->hasData(addr))
                     sendTime = sendResponseUp(event, &(mshr_->getData(addr)), inMSHR, tag->getTimestamp(), Command::GetXResp);
                 else
-                    sendTime = sendResponseUp(event, data->getData(), inMSHR, tag->getTimestamp(), Command::GetXResp);
+                    sendTime = sendResponseUp(event, data->getDataBuffer(), inMSHR, tag->getTimestamp(), Command::GetXResp);
                 tag->setTimestamp(sendTime - 1);
                 recordLatencyType(event->getID(), LatType::HIT);
                 cleanUpAfterRequest(event, inMSHR);
@@ -432,7 +432,7 @@ bool MESISharNoninclusive::handleFlushLine(MemEvent* event, bool inMSHR) {
                     break;
                 }
                 if (data)
-                    forwardFlush(event, true, data->getData(), tag->getState() == M, tag->getTimestamp());
+                    forwardFlush(event, true, data->getDataBuffer(), tag->getState() == M, tag->getTimestamp());
                 else
                     forwardFlush(event, true, &(mshr_->getData(addr)), tag->getState() == M, tag->getTimestamp());
                 tag->getState() == E ? tag->setState(E_B) : tag->setState(M_B);
@@ -524,7 +524,7 @@ bool MESISharNoninclusive::handleFlushLineInv(MemEvent* event, bool inMSHR) {
                 }
 
                 if (data)
-                    forwardFlush(event, true, data->getData(), false, tag->getTimestamp());
+                    forwardFlush(event, true, data->getDataBuffer(), false, tag->getTimestamp());
                 else
                     forwardFlush(event, true, &(mshr_->getData(addr)), false, tag->getTimestamp());
                 mshr_->setInProgress(addr);
@@ -554,7 +554,7 @@ bool MESISharNoninclusive::handleFlushLineInv(MemEvent* event, bool inMSHR) {
                     tag->getState() == E ? tag->setState(E_Inv) : tag->setState(M_Inv);
                 } else {
                     if (data)
-                        forwardFlush(event, true, data->getData(), tag->getState() == M, tag->getTimestamp());
+                        forwardFlush(event, true, data->getDataBuffer(), tag->getState() == M, tag->getTimestamp());
                     else
                         forwardFlush(event, true, &(mshr_->getData(addr)), tag->getState() == M, tag->getTimestamp());
                     mshr_->setInProgress(addr);
@@ -652,9 +652,9 @@ bool MESISharNoninclusive::handlePutS(MemEvent * event, bool inMSHR) {
                     break;
                 }
                 data = dataArray_->lookup(addr, true);
-                data->setData(event->getPayload(), 0);
+                data->setData(event->getPayloadBuffer(), 0);
                 if (is_debug_addr(addr))
-                    printDataValue(addr, &(event->getPayload()), true);
+                    printDataValue(addr, event->getPayloadBuffer(), true);
                 inMSHR = true;
             }
             if (!inMSHR || !mshr_->getProfiled(addr)) {
@@ -698,7 +698,7 @@ bool MESISharNoninclusive::handlePutS(MemEvent * event, bool inMSHR) {
             if (event->getSrc() == *(tag->getSharers()->begin())) { // Sent fetch to this requestor
                 // Retry the pending fetch
                 mshr_->decrementAcksNeeded(addr);
-                mshr_->setData(addr, event->getPayload());
+                mshr_->setData(addr, event->readPayload());
                 responses.find(addr)->second.erase(event->getSrc());
                 if (responses.find(addr)->second.empty())
                     responses.erase(addr);
@@ -781,9 +781,9 @@ bool MESISharNoninclusive::handlePutE(MemEvent * event, bool inMSHR) {
                     break;
                 }
                 data = dataArray_->lookup(addr, true);
-                data->setData(event->getPayload(), 0);
+                data->setData(event->getPayloadBuffer(), 0);
                 if (is_debug_addr(addr))
-                    printDataValue(addr, &(event->getPayload()), true);
+                    printDataValue(addr, event->getPayloadBuffer(), true);
                 inMSHR = true;
             }
             tag->removeOwner();
@@ -798,7 +798,7 @@ bool MESISharNoninclusive::handlePutE(MemEvent * event, bool inMSHR) {
             tag->removeOwner();
             mshr_->decrementAcksNeeded(addr);
             if (!data && !mshr_->hasData(addr))
-                mshr_->setData(addr, event->getPayload());
+                mshr_->setData(addr, event->readPayload());
             responses.find(addr)->second.erase(event->getSrc());
             if (responses.find(addr)->second.empty())
                 responses.erase(addr);
@@ -828,7 +828,7 @@ bool MESISharNoninclusive::handlePutE(MemEvent * event, bool inMSHR) {
             tag->removeOwner();
             mshr_->decrementAcksNeeded(addr);
             if (!data && !mshr_->hasData(addr))
-                mshr_->setData(addr, event->getPayload());
+                mshr_->setData(addr, event->readPayload());
             responses.find(addr)->second.erase(event->getSrc());
             if (responses.find(addr)->second.empty())
                 responses.erase(addr);
@@ -887,9 +887,9 @@ bool MESISharNoninclusive::handlePutM(MemEvent * event, bool inMSHR) {
                     break;
                 }
                 data = dataArray_->lookup(addr, true);
-                data->setData(event->getPayload(), 0);
+                data->setData(event->getPayloadBuffer(), 0);
                 if (is_debug_addr(addr))
-                    printDataValue(addr, &(event->getPayload()), true);
+                    printDataValue(addr, event->getPayloadBuffer(), true);
                 inMSHR = true;
             } else if (!inMSHR || !mshr_->getProfiled(addr)) {
                 stat_eventState[(int)Command::PutM][state]->addData(1);
@@ -916,15 +916,15 @@ bool MESISharNoninclusive::handlePutM(MemEvent * event, bool inMSHR) {
                 if (!inMSHR || !mshr_->getProfiled(addr)) {
                     stat_eventState[(int)Command::PutM][state]->addData(1);
                 }
-                data->setData(event->getPayload(), 0);
+                data->setData(event->getPayloadBuffer(), 0);
                 if (is_debug_addr(addr))
-                    printDataValue(addr, &(event->getPayload()), true);
+                    printDataValue(addr, event->getPayloadBuffer(), true);
                 sendWritebackAck(event);
                 cleanUpEvent(event, inMSHR);
             } else {
                 tag->addSharer(event->getSrc());
                 event->setCmd(Command::PutS);
-                mshr_->setData(addr, event->getPayload());
+                mshr_->setData(addr, event->readPayload());
                 if (inMSHR)
                     mshr_->removeFront(addr); // Need to reinsert after the conflicting request
                 MemEventBase* entry = mshr_->getEntryEvent(addr, 1);
@@ -945,7 +945,7 @@ bool MESISharNoninclusive::handlePutM(MemEvent * event, bool inMSHR) {
             tag->removeOwner();
             mshr_->decrementAcksNeeded(addr);
             if (!data && !mshr_->hasData(addr))
-                mshr_->setData(addr, event->getPayload());
+                mshr_->setData(addr, event->readPayload());
             responses.find(addr)->second.erase(event->getSrc());
             if (responses.find(addr)->second.empty())
                 responses.erase(addr);
@@ -999,9 +999,9 @@ bool MESISharNoninclusive::handlePutX(MemEvent * event, bool inMSHR) {
                 tag->setState(M);
 
             if (data) {
-                data->setData(event->getPayload(), 0);
+                data->setData(event->getPayloadBuffer(), 0);
                 if (is_debug_addr(addr))
-                    printDataValue(addr, &(event->getPayload()), true);
+                    printDataValue(addr, event->getPayloadBuffer(), true);
             }
             cleanUpAfterRequest(event, inMSHR);
             break;
@@ -1013,12 +1013,12 @@ bool MESISharNoninclusive::handlePutX(MemEvent * event, bool inMSHR) {
                 tag->setState(E);
 
             if (data)
-                data->setData(event->getPayload(), 0);
+                data->setData(event->getPayloadBuffer(), 0);
             else
-                mshr_->setData(addr, event->getPayload());
+                mshr_->setData(addr, event->readPayload());
             
             if (is_debug_addr(addr))
-                printDataValue(addr, &(event->getPayload()), true);
+                printDataValue(addr, event->getPayloadBuffer(), true);
 
             mshr_->decrementAcksNeeded(addr);
 
@@ -1030,12 +1030,12 @@ bool MESISharNoninclusive::handlePutX(MemEvent * event, bool inMSHR) {
                 tag->setState(M_Inv);
 
             if (data)
-                data->setData(event->getPayload(), 0);
+                data->setData(event->getPayloadBuffer(), 0);
             else
-                mshr_->setData(addr, event->getPayload());
+                mshr_->setData(addr, event->readPayload());
             
             if (is_debug_addr(addr))
-                printDataValue(addr, &(event->getPayload()), true);
+                printDataValue(addr, event->getPayloadBuffer(), true);
 
             cleanUpEvent(event, inMSHR);
             break;
@@ -1084,7 +1084,7 @@ bool MESISharNoninclusive::handleFetch(MemEvent * event, bool inMSHR) {
                 stat_eventState[(int)Command::Fetch][state]->addData(1);
             }
             if (data) {
-                sendResponseDown(event, data->getData(), false, false);
+                sendResponseDown(event, data->getDataBuffer(), false, false);
                 cleanUpEvent(event, inMSHR);
             } else if (mshr_->hasData(addr)) {
                 sendResponseDown(event, &(mshr_->getData(addr)), false, false);
@@ -1102,7 +1102,7 @@ bool MESISharNoninclusive::handleFetch(MemEvent * event, bool inMSHR) {
         case SA:
             //Look for a PutS in the MSHR
             put = static_cast<MemEvent*>(mshr_->getFirstEventEntry(addr, Command::PutS));
-            sendResponseDown(event, &(put->getPayload()), false, false);
+            sendResponseDown(event, put->getPayloadBuffer(), false, false);
             stat_eventState[(int)Command::Fetch][state]->addData(1);
             cleanUpEvent(event, inMSHR);
             break;
@@ -1111,7 +1111,7 @@ bool MESISharNoninclusive::handleFetch(MemEvent * event, bool inMSHR) {
                 stat_eventState[(int)Command::Fetch][state]->addData(1);
             }
             if (data) {
-                sendResponseDown(event, data->getData(), false, false);
+                sendResponseDown(event, data->getDataBuffer(), false, false);
                 cleanUpEvent(event, inMSHR);
             } else if (mshr_->hasData(addr)) {
                 sendResponseDown(event, &(mshr_->getData(addr)), false, false);
@@ -1135,7 +1135,7 @@ bool MESISharNoninclusive::handleFetch(MemEvent * event, bool inMSHR) {
                 stat_eventState[(int)Command::Fetch][state]->addData(1);
             }
             if (data) {
-                sendResponseDown(event, data->getData(), false, false);
+                sendResponseDown(event, data->getDataBuffer(), false, false);
                 cleanUpEvent(event, inMSHR);
             } else if (mshr_->hasData(addr)) {
                 sendResponseDown(event, &(mshr_->getData(addr)), false, false);
@@ -1544,7 +1544,7 @@ bool MESISharNoninclusive::handleFetchInv(MemEvent * event, bool inMSHR){
                         invalidateSharers(event, tag, inMSHR, !(data || mshr_->hasData(addr)), Command::Inv);
                 } else {
                     if (data)
-                        sendResponseDown(event, data->getData(), false, true);
+                        sendResponseDown(event, data->getDataBuffer(), false, true);
                     else {
                         sendResponseDown(event, &(mshr_->getData(addr)), false, true);
                         mshr_->clearData(addr);
@@ -1578,7 +1578,7 @@ bool MESISharNoninclusive::handleFetchInv(MemEvent * event, bool inMSHR){
                     state == E ? tag->setState(E_Inv) : tag->setState(M_Inv);
                 } else {
                     if (data)
-                        sendResponseDown(event, data->getData(), state == M, true);
+                        sendResponseDown(event, data->getDataBuffer(), state == M, true);
                     else {
                         sendResponseDown(event, &(mshr_->getData(addr)), state == M, true);
                         mshr_->clearData(addr);
@@ -1607,7 +1607,7 @@ bool MESISharNoninclusive::handleFetchInv(MemEvent * event, bool inMSHR){
                     tag->setState(SB_Inv);
                 } else {
                     if (data) {
-                        sendResponseDown(event, data->getData(), false, true);
+                        sendResponseDown(event, data->getDataBuffer(), false, true);
                         dataArray_->deallocate(data);
                     } else {
                         sendResponseDown(event, &(mshr_->getData(addr)), false, true);
@@ -1633,7 +1633,7 @@ bool MESISharNoninclusive::handleFetchInv(MemEvent * event, bool inMSHR){
             // TODO make sure the pending eviction won't mess anything up when it tries to replay
             put = static_cast<MemEvent*>(mshr_->getFrontEvent(addr));
             sendWritebackAck(put);
-            sendResponseDown(event, &(put->getPayload()), state == MA, true);
+            sendResponseDown(event, put->getPayloadBuffer(), state == MA, true);
             dirArray_->deallocate(tag);
             if (mshr_->hasData(addr))
                 mshr_->clearData(addr);
@@ -1647,7 +1647,7 @@ bool MESISharNoninclusive::handleFetchInv(MemEvent * event, bool inMSHR){
                 }
                 tag->setState(IM);
                 if (data)
-                    sendResponseDown(event, data->getData(), false, true);
+                    sendResponseDown(event, data->getDataBuffer(), false, true);
                 else
                     sendResponseDown(event, &(mshr_->getData(addr)), false, true);
                 tag->setState(IM);
@@ -1782,7 +1782,7 @@ bool MESISharNoninclusive::handleFetchInvX(MemEvent * event, bool inMSHR) {
             } else {
                 tag->setState(S);
                 if (data)
-                    sendResponseDown(event, data->getData(), state == M, true); // TODO Double check that a downgrade counts as an evict
+                    sendResponseDown(event, data->getDataBuffer(), state == M, true); // TODO Double check that a downgrade counts as an evict
                 else {
                     sendResponseDown(event, &(mshr_->getData(addr)), state == M, true);
                 }
@@ -1795,7 +1795,7 @@ bool MESISharNoninclusive::handleFetchInvX(MemEvent * event, bool inMSHR) {
                 stat_eventState[(int)Command::FetchInvX][state]->addData(1);
             }
             req = static_cast<MemEvent*>(mshr_->getFrontEvent(addr));
-            sendResponseDown(event, &(req->getPayload()), state == M, true); // TODO Double check that a downgrade counts as an evict
+            sendResponseDown(event, req->getPayloadBuffer(), state == M, true); // TODO Double check that a downgrade counts as an evict
             // Clean up so that when we replay the replacement we get the right downgraded state
             req->setCmd(Command::PutS);
             tag->removeOwner();
@@ -1840,7 +1840,7 @@ bool MESISharNoninclusive::handleGetSResp(MemEvent * event, bool inMSHR) {
     // Find matching request in MSHR
     MemEvent * req = static_cast<MemEvent*>(mshr_->getFrontEvent(addr));
 
-    bool localPrefetch = req->isPrefetch() && (req->getRqstr() == cachename_);
+    bool localPrefetch = req->isPrefetch() && (req->getRqstrID() == cacheID_);
     req->setFlags(event->getMemFlags());
 
     if (is_debug_event(event))
@@ -1850,9 +1850,9 @@ bool MESISharNoninclusive::handleGetSResp(MemEvent * event, bool inMSHR) {
 
     tag->setState(S);
     if (data) {
-        data->setData(event->getPayload(), 0);
+        data->setData(event->getPayloadBuffer(), 0);
         if (is_debug_addr(addr))
-            printDataValue(addr, &(event->getPayload()), true);
+            printDataValue(addr, event->getPayloadBuffer(), true);
     }
 
     if (localPrefetch) {
@@ -1861,7 +1861,7 @@ bool MESISharNoninclusive::handleGetSResp(MemEvent * event, bool inMSHR) {
             eventDI.action = "Done";
     } else {
         tag->addSharer(req->getSrc());
-        uint64_t sendTime = sendResponseUp(req, &(event->getPayload()), true, tag->getTimestamp(), Command::GetSResp);
+        uint64_t sendTime = sendResponseUp(req, event->getPayloadBuffer(), true, tag->getTimestamp(), Command::GetSResp);
         tag->setTimestamp(sendTime-1);
     }
 
@@ -1888,16 +1888,16 @@ bool MESISharNoninclusive::handleGetXResp(MemEvent * event, bool inMSHR) {
     // Get matching request
     MemEvent * req = static_cast<MemEvent*>(mshr_->getFrontEvent(event->getBaseAddr()));
 
-    bool localPrefetch = req->isPrefetch() && (req->getRqstr() == cachename_);
+    bool localPrefetch = req->isPrefetch() && (req->getRqstrID() == cacheID_);
     req->setFlags(event->getMemFlags());
 
     if (is_debug_event(event))
         eventDI.prefill(event->getID(), Command::GetXResp, localPrefetch, addr, state);
 
     if (data) {
-        data->setData(event->getPayload(), 0);
+        data->setData(event->getPayloadBuffer(), 0);
         if (is_debug_addr(addr))
-            printDataValue(addr, &(event->getPayload()), true);
+            printDataValue(addr, event->getPayloadBuffer(), true);
     }
 
     stat_eventState[(int)Command::GetXResp][state]->addData(1);
@@ -1918,11 +1918,11 @@ bool MESISharNoninclusive::handleGetXResp(MemEvent * event, bool inMSHR) {
             } else {
                 if (tag->getState() == S || !protocol_ || mshr_->getSize(addr) > 1) {
                     tag->addSharer(req->getSrc());
-                    uint64_t sendTime = sendResponseUp(req, &(event->getPayload()), true, tag->getTimestamp(), Command::GetSResp);
+                    uint64_t sendTime = sendResponseUp(req, event->getPayloadBuffer(), true, tag->getTimestamp(), Command::GetSResp);
                     tag->setTimestamp(sendTime - 1);
                 } else {
                     tag->setOwner(req->getSrc());
-                    uint64_t sendTime = sendResponseUp(req, &(event->getPayload()), true, tag->getTimestamp(), Command::GetXResp);
+                    uint64_t sendTime = sendResponseUp(req, event->getPayloadBuffer(), true, tag->getTimestamp(), Command::GetXResp);
                     tag->setTimestamp(sendTime - 1);
                 }
             }
@@ -1940,7 +1940,7 @@ bool MESISharNoninclusive::handleGetXResp(MemEvent * event, bool inMSHR) {
                 tag->removeSharer(req->getSrc());
                 sendTime = sendResponseUp(req, nullptr, true, tag->getTimestamp(), Command::GetXResp);
             } else if (event->getPayloadSize() != 0) {
-                sendTime = sendResponseUp(req, &(event->getPayload()), true, tag->getTimestamp(), Command::GetXResp);
+                sendTime = sendResponseUp(req, event->getPayloadBuffer(), true, tag->getTimestamp(), Command::GetXResp);
             } else {
                 sendTime = sendResponseUp(req, &(mshr_->getData(addr)), true, tag->getTimestamp(), Command::GetXResp);
             }
@@ -1956,7 +1956,7 @@ bool MESISharNoninclusive::handleGetXResp(MemEvent * event, bool inMSHR) {
             tag->setState(M_Inv);
             mshr_->setInProgress(addr, false);
             if (!data && event->getPayloadSize() != 0)
-                mshr_->setData(addr, event->getPayload());
+                mshr_->setData(addr, event->readPayload());
             if (is_debug_event(event)) {
                 eventDI.action = "Stall";
                 eventDI.reason = "Acks needed";
@@ -2043,12 +2043,12 @@ bool MESISharNoninclusive::handleFetchResp(MemEvent * event, bool inMSHR) {
         responses.erase(addr);
 
     if (data)
-        data->setData(event->getPayload(), 0);
+        data->setData(event->getPayloadBuffer(), 0);
     else
-        mshr_->setData(addr, event->getPayload());
+        mshr_->setData(addr, event->readPayload());
     
     if (is_debug_addr(addr))
-        printDataValue(addr, &(event->getPayload()), true);
+        printDataValue(addr, event->getPayloadBuffer(), true);
 
     stat_eventState[(int)Command::FetchResp][state]->addData(1);
 
@@ -2147,12 +2147,12 @@ bool MESISharNoninclusive::handleFetchXResp(MemEvent * event, bool inMSHR) {
 
     // Save data
     if (data)
-        data->setData(event->getPayload(), 0);
+        data->setData(event->getPayloadBuffer(), 0);
     else
-        mshr_->setData(addr, event->getPayload());
+        mshr_->setData(addr, event->readPayload());
     
     if (is_debug_addr(addr))
-        printDataValue(addr, &(event->getPayload()), true);
+        printDataValue(addr, event->getPayloadBuffer(), true);
 
     // Clean up and retry
     retry(addr);
@@ -2577,7 +2577,7 @@ bool MESISharNoninclusive::handleDirEviction(Addr addr, DirectoryLine*& tag) {
             if (is_debug_addr(tag->getAddr())) {
                 std::stringstream note;
                 note << "InProg, " << StateString[state];
-                printDebugAlloc(false, tag->getAddr(), note.str());
+                printDebugAlloc(false, tag->getAddr(), note.str().c_str());
             }
             return false;
     }
@@ -2669,7 +2669,7 @@ bool MESISharNoninclusive::handleDataEviction(Addr addr, DataLine *&data) {
             if (is_debug_addr(data->getAddr())) {
                 std::stringstream reason;
                 reason << "InProg, " << StateString[state];
-                printDebugAlloc(false, data->getAddr(), reason.str());
+                printDebugAlloc(false, data->getAddr(), reason.str().c_str());
             }
             return false;
     }
@@ -2784,17 +2784,39 @@ void MESISharNoninclusive::retry(Addr addr) {
  ***********************************************************************************************************/
 
 uint64_t MESISharNoninclusive::sendResponseUp(MemEvent * event, vector<uint8_t> * data, bool inMSHR, uint64_t time, Command cmd, bool success) {
+    if (data) {
+        LineBuffer buffer;
+        buffer.assign(*data);
+        return sendResponseUp(event, buffer, inMSHR, time, cmd, success);
+    }
+
     MemEvent * responseEvent = event->makeResponse();
     if (cmd != Command::NULLCMD)
         responseEvent->setCmd(cmd);
 
-    /* Only return the desired word */
-    if (data) {
-        responseEvent->setPayload(*data);
-        responseEvent->setSize(data->size()); // Return size that was written
-        if (is_debug_event(event)) {
-            printDataValue(event->getBaseAddr(), data, false);
-        }
+    if (!success)
+        responseEvent->setFail();
+
+    if (time < timestamp_) time = timestamp_;
+    uint64_t deliveryTime = time + (inMSHR ? mshrLatency_ : accessLatency_);
+    forwardByDestination(responseEvent, deliveryTime);
+
+    if (is_debug_event(event))
+        eventDI.action = "Respond";
+
+    return deliveryTime;
+}
+
+/* Respond with 'data', sharing the buffer instead of copying it */
+uint64_t MESISharNoninclusive::sendResponseUp(MemEvent * event, const LineBuffer& data, bool inMSHR, uint64_t time, Command cmd, bool success) {
+    MemEvent * responseEvent = event->makeResponse();
+    if (cmd != Command::NULLCMD)
+        responseEvent->setCmd(cmd);
+
+    responseEvent->setPayload(data);
+    responseEvent->setSize(data.size()); // Return size that was written
+    if (is_debug_event(event)) {
+        printDataValue(event->getBaseAddr(), data, false);
     }
 
     if (!success)
@@ -2812,18 +2834,36 @@ uint64_t MESISharNoninclusive::sendResponseUp(MemEvent * event, vector<uint8_t>
 }
 
 void MESISharNoninclusive::sendResponseDown(MemEvent * event, std::vector<uint8_t> * data, bool dirty, bool evict) {
-    MemEvent * responseEvent = event->makeResponse();
-
     if (data) {
-        responseEvent->setPayload(*data);
-        responseEvent->setDirty(dirty);
+        LineBuffer buffer;
+        buffer.assign(*data);
+        sendResponseDown(event, buffer, dirty, evict);
+        return;
     }
 
+    MemEvent * responseEvent = event->makeResponse();
+    responseEvent->setEvict(evict);
+    responseEvent->setSize(lineSize_);
+
+    uint64_t deliverTime = timestamp_ + tagLatency_;
+    forwardByDestination(responseEvent, deliverTime);
+
+    if (is_debug_event(event))
+        eventDI.action = "Respond";
+}
+
+/* Respond with 'data', sharing the buffer instead of copying it */
+void MESISharNoninclusive::sendResponseDown(MemEvent * event, const LineBuffer& data, bool dirty, bool evict) {
+    MemEvent * responseEvent = event->makeResponse();
+
+    responseEvent->setPayload(data);
+    responseEvent->setDirty(dirty);
+
     responseEvent->setEvict(evict);
 
     responseEvent->setSize(lineSize_);
 
-    uint64_t deliverTime = timestamp_ + (data ? accessLatency_ : tagLatency_);
+    uint64_t deliverTime = timestamp_ + accessLatency_;
     forwardByDestination(responseEvent, deliverTime);
 
     if (is_debug_event(event))
@@ -2832,13 +2872,21 @@ void MESISharNoninclusive::sendResponseDown(MemEvent * event, std::vector<uint8_
 
 
 uint64_t MESISharNoninclusive::forwardFlush(MemEvent * event, bool evict, std::vector<uint8_t>* data, bool dirty, uint64_t time) {
+    LineBuffer buffer;
+    if (data)
+        buffer.assign(*data);
+    return forwardFlush(event, evict, buffer, dirty, time);
+}
+
+/* Forward a flush, sharing 'data' instead of copying it. 'data' is only sent if 'evict' is set. */
+uint64_t MESISharNoninclusive::forwardFlush(MemEvent * event, bool evict, const LineBuffer& data, bool dirty, uint64_t time) {
     MemEvent * flush = new MemEvent(*event);
 
     uint64_t latency = tagLatency_;
     if (evict) {
         flush->setEvict(true);
         // TODO only send payload when needed
-        flush->setPayload(*data);
+        flush->setPayload(data);
         flush->setDirty(dirty);
         latency = accessLatency_;
     } else {
@@ -2875,17 +2923,17 @@ void MESISharNoninclusive::sendWritebackFromCache(Command cmd, DirectoryLine* ta
 
     /* Writeback data */
     if (dirty || writebackCleanBlocks_) {
-        writeback->setPayload(*(data->getData()));
+        writeback->setPayload(data->getDataBuffer());
         writeback->setDirty(dirty);
 
         if (is_debug_addr(tag->getAddr())) {
-            printDataValue(tag->getAddr(), data->getData(), false);
+            printDataValue(tag->getAddr(), data->getDataBuffer(), false);
         }
 
         latency = accessLatency_;
     }
 
-    writeback->setRqstr(cachename_);
+    writeback->setRqstrID(cacheID_);
 
     uint64_t baseTime = (timestamp_ > tag->getTimestamp()) ? timestamp_ : tag->getTimestamp();
     uint64_t deliveryTime = baseTime + latency;
@@ -2912,7 +2960,7 @@ void MESISharNoninclusive::sendWritebackFromMSHR(Command cmd, DirectoryLine* tag
         latency = accessLatency_;
     }
 
-    writeback->setRqstr(cachename_);
+    writeback->setRqstrID(cacheID_);
 
     uint64_t baseTime = (timestamp_ > tag->getTimestamp()) ? timestamp_ : tag->getTimestamp();
     uint64_t deliveryTime = baseTime + latency;
@@ -2963,14 +3011,14 @@ uint64_t MESISharNoninclusive::sendFetch(Command cmd, MemEvent * event, std::str
 
 bool MESISharNoninclusive::invalidateExceptRequestor(MemEvent * event, DirectoryLine * tag, bool inMSHR, bool needData) {
     uint64_t deliveryTime = 0;
-    std::string rqstr = event->getSrc();
+    uint32_t rqstr = SharerIDMap::findID(event->getSrcID());
 
     bool getData = needData;
     if (getData && tag->isSharer(event->getSrc()))
         getData = false;
 
-    for (set<std::string>::iterator it = tag->getSharers()->begin(); it != tag->getSharers()->end(); it++) {
-        if (*it == rqstr) continue;
+    for (SharerSet::iterator it = tag->getSharers()->begin(); it != tag->getSharers()->end(); it++) {
+        if (it.id() == rqstr) continue;
 
         if (getData) { // FetchInv
             getData = false;
@@ -2993,7 +3041,7 @@ bool MESISharNoninclusive::invalidateAll(MemEvent * event, DirectoryLine * tag,
     } else {
         if (cmd == Command::NULLCMD)
             cmd = Command::Inv;
-        for (std::set<std::string>::iterator it = tag->getSharers()->begin(); it != tag->getSharers()->end(); it++) {
+        for (SharerSet::iterator it = tag->getSharers()->begin(); it != tag->getSharers()->end(); it++) {
             deliveryTime = invalidateSharer(*it, event, tag, inMSHR, cmd);
         }
         if (deliveryTime != 0) {
@@ -3006,7 +3054,7 @@ bool MESISharNoninclusive::invalidateAll(MemEvent * event, DirectoryLine * tag,
 
 void MESISharNoninclusive::invalidateSharers(MemEvent * event, DirectoryLine * tag, bool inMSHR, bool needData, Command cmd) {
     uint64_t deliveryTime = 0;
-    for (std::set<std::string>::iterator it = tag->getSharers()->begin(); it != tag->getSharers()->end(); it++) {
+    for (SharerSet::iterator it = tag->getSharers()->begin(); it != tag->getSharers()->end(); it++) {
         if (needData) {
             deliveryTime = invalidateSharer(*it, event, tag, inMSHR, Command::FetchInv);
             needData = false;
@@ -3025,7 +3073,7 @@ uint64_t MESISharNoninclusive::invalidateSharer(std::string shr, MemEvent * even
         if (event) {
             inv->copyMetadata(event);
         } else {
-            inv->setRqstr(cachename_);
+            inv->setRqstrID(cacheID_);
         }
         inv->setDst(shr);
         inv->setSize(lineSize_);
@@ -3068,7 +3116,7 @@ bool MESISharNoninclusive::invalidateOwner(MemEvent * metaEvent, DirectoryLine *
     if (metaEvent) {
         inv->copyMetadata(metaEvent);
     } else {
-        inv->setRqstr(cachename_);
+        inv->setRqstrID(cacheID_);
     }
     inv->setDst(tag->getOwner());
     inv->setSize(lineSize_);
@@ -3137,7 +3185,7 @@ void MESISharNoninclusive::removeSharerViaInv(MemEvent * event, DirectoryLine *
     Addr addr = event->getBaseAddr();
     tag->removeSharer(event->getSrc());
     if (!data && !mshr_->hasData(addr))
-        mshr_->setData(addr, event->getPayload());
+        mshr_->setData(addr, event->readPayload());
 
     if (remove) {
         responses.find(addr)->second.erase(event->getSrc());
@@ -3150,12 +3198,12 @@ void MESISharNoninclusive::removeOwnerViaInv(MemEvent * event, DirectoryLine * t
     Addr addr = event->getBaseAddr();
     tag->removeOwner();
     if (data) 
-        data->setData(event->getPayload(), 0);
+        data->setData(event->getPayloadBuffer(), 0);
     else
-        mshr_->setData(addr, event->getPayload());
+        mshr_->setData(addr, event->readPayload());
     
     if (is_debug_addr(addr))
-        printDataValue(addr, &(event->getPayload()), true);
+        printDataValue(addr, event->getPayloadBuffer(), true);
 
     if (event->getDirty()) {
         if (tag->getState() == E)
@@ -542,11 +542,24 @@ public:
     MemEventInitCoherence* getInitCoherenceEvent();
 
     virtual Addr getBank(Addr addr) { return dirArray_->getBank(addr); }
+    virtual State getLineState(Addr addr) { DirectoryLine* tag = dirArray_->lookup(addr, false); return tag ? tag->getState() : NP; }
     virtual void setSliceAware(uint64_t size, uint64_t step) {
         dirArray_->setSliceAware(size, step);
         dataArray_->setSliceAware(size, step);
     }
 
+    void saveCheckpoint(CacheCheckpoint &ckpt) {
+        dirArray_->saveCheckpoint(ckpt.addSection("directory"));
+        dataArray_->saveCheckpoint(ckpt.addSection("data"));
+    }
+    void loadCheckpoint(const CacheCheckpoint &ckpt, CacheCheckpoint::LoadStats &stats) {
+        if (const CacheCheckpoint::Section * sec = ckpt.getSection("directory"))
+            dirArray_->loadCheckpoint(*sec, stats);
+        // Data lines take their state from the directory entry for the same address
+        if (const CacheCheckpoint::Section * sec = ckpt.getSection("data"))
+            dataArray_->loadCheckpoint(*sec, stats, [this](DataLine* line) { line->setTag(dirArray_->lookup(line->getAddr(), false)); });
+    }
+
     std::set<Command> getValidReceiveEvents() {
         std::set<Command> cmds = { Command::GetS,
             Command::GetX,
@@ -595,12 +608,15 @@ private:
 
     /** Forward a flush line request, with or without data */
     uint64_t forwardFlush(MemEvent* event, bool evict, std::vector<uint8_t>* data, bool dirty, uint64_t time);
+    uint64_t forwardFlush(MemEvent* event, bool evict, const LineBuffer& data, bool dirty, uint64_t time);
 
     /** Send response up (to processor) */
     uint64_t sendResponseUp(MemEvent * event, vector<uint8_t>* data, bool inMSHR, uint64_t baseTime, Command cmd = Command::NULLCMD, bool success = true);
+    uint64_t sendResponseUp(MemEvent * event, const LineBuffer& data, bool inMSHR, uint64_t baseTime, Command cmd = Command::NULLCMD, bool success = true);
 
     /** Send response down (towards memory) */
     void sendResponseDown(MemEvent* event, std::vector<uint8_t>* data, bool dirty, bool evict);
+    void sendResponseDown(MemEvent* event, const LineBuffer& data, bool dirty, bool evict);
 
     /** Send writeback request to lower level caches */
     void sendWritebackFromCache(Command cmd, DirectoryLine* tag, DataLine* data, bool dirty);
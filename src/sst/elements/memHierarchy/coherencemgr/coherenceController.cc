@@ -85,6 +85,8 @@ CoherenceController::CoherenceController(ComponentId_t id, Params &params, Param
 
     // Get parent component's name
     cachename_ = getParentComponentName();
+    cacheID_ = EndpointRegistry::getID(cachename_);
+    flightRecorder_ = nullptr;
 
     // Register statistics - only those that are common across all coherence managers
     // Give  all array entries a default statistic so we don't end up with segfaults during execution
@@ -148,8 +150,13 @@ ReplacementPolicy* CoherenceController::createReplacementPolicy(uint64_t lines,
     }
     if (policy == "random") return loadAnonymousSubComponent<ReplacementPolicy>("memHierarchy.replacement.random", "replacement", slotnum, ComponentInfo::SHARE_NONE, emptyparams, lines, assoc);
     if (policy == "nmru")   return loadAnonymousSubComponent<ReplacementPolicy>("memHierarchy.replacement.nmru", "replacement", slotnum, ComponentInfo::SHARE_NONE, emptyparams, lines, assoc);
+    if (policy == "plru")   return loadAnonymousSubComponent<ReplacementPolicy>("memHierarchy.replacement.plru", "replacement", slotnum, ComponentInfo::SHARE_NONE, emptyparams, lines, assoc);
+    if (policy == "srrip")  return loadAnonymousSubComponent<ReplacementPolicy>("memHierarchy.replacement.srrip", "replacement", slotnum, ComponentInfo::SHARE_NONE, emptyparams, lines, assoc);
+    if (policy == "brrip")  return loadAnonymousSubComponent<ReplacementPolicy>("memHierarchy.replacement.brrip", "replacement", slotnum, ComponentInfo::SHARE_NONE, emptyparams, lines, assoc);
+    if (policy == "drrip")  return loadAnonymousSubComponent<ReplacementPolicy>("memHierarchy.replacement.drrip", "replacement", slotnum, ComponentInfo::SHARE_NONE, emptyparams, lines, assoc);
+    if (policy == "ship")   return loadAnonymousSubComponent<ReplacementPolicy>("memHierarchy.replacement.ship", "replacement", slotnum, ComponentInfo::SHARE_NONE, emptyparams, lines, assoc);
 
-    debug->fatal(CALL_INFO, -1, "%s, Invalid param: replacement_policy - supported policies are 'lru', 'lfu', 'random', 'mru', and 'nmru'. You specified '%s'.\n", getName().c_str(), policy.c_str());
+    debug->fatal(CALL_INFO, -1, "%s, Invalid param: replacement_policy - supported policies are 'lru', 'lfu', 'random', 'mru', 'nmru', 'plru', 'srrip', 'brrip', 'drrip', and 'ship'. You specified '%s'.\n", getName().c_str(), policy.c_str());
     return nullptr;
 }
 
@@ -332,7 +339,7 @@ bool CoherenceController::sendOutgoingEvents() {
 
     // Check for ready events in outgoing 'down' queue
     uint64_t bytesLeft = maxBytesDown;
-    while (!outgoingEventQueueDown_.empty() && outgoingEventQueueDown_.front().deliveryTime <= timestamp_) {
+    while (outgoingEventQueueDown_.ready(timestamp_)) {
         MemEventBase *outgoingEvent = outgoingEventQueueDown_.front().event;
         if (maxBytesDown != 0) {
             if (bytesLeft == 0) break;
@@ -350,14 +357,19 @@ bool CoherenceController::sendOutgoingEvents() {
                     getCurrentSimCycle(), timestamp_, cachename_.c_str(), outgoingEvent->getBriefString().c_str());
         }
 
+        if (outgoingEvent->isTraced())
+            outgoingEvent->addTraceStamp(LatencyTrace::Point::CacheSend, getCurrentSimCycle());
+        if (flightRecorder_)
+            flightRecorder_->record(getCurrentSimCycle(), FlightRecorder::Send, outgoingEvent);
+
         linkDown_->send(outgoingEvent);
-        outgoingEventQueueDown_.pop_front();
+        popOutgoingQueue(outgoingEventQueueDown_, outgoingOrderDown_);
 
     }
 
     // Check for ready events in outgoing 'up' queue
     bytesLeft = maxBytesUp;
-    while (!outgoingEventQueueUp_.empty() && outgoingEventQueueUp_.front().deliveryTime <= timestamp_) {
+    while (outgoingEventQueueUp_.ready(timestamp_)) {
         MemEventBase * outgoingEvent = outgoingEventQueueUp_.front().event;
         if (maxBytesUp != 0) {
             if (bytesLeft == 0) break;
@@ -380,14 +392,41 @@ bool CoherenceController::sendOutgoingEvents() {
             startTimes_.erase(outgoingEvent->getResponseToID());
         }
 
+        if (outgoingEvent->isTraced()) {
+            outgoingEvent->addTraceStamp(LatencyTrace::Point::CacheSend, getCurrentSimCycle());
+            if (traceHandler_ && LatencyTrace::origin(outgoingEvent->getTraceID()) == EndpointRegistry::getWireID(cacheID_)
+                    && BasicCommandClassArr[(int)outgoingEvent->getCmd()] == BasicCommandClass::Response)
+                traceHandler_(outgoingEvent);
+        }
+        if (flightRecorder_)
+            flightRecorder_->record(getCurrentSimCycle(), FlightRecorder::Send, outgoingEvent);
+
         linkUp_->send(outgoingEvent);
-        outgoingEventQueueUp_.pop_front();
+        popOutgoingQueue(outgoingEventQueueUp_, outgoingOrderUp_);
     }
 
     // Return whether it's ok for the cache to turn off the clock - we need it on to be able to send waiting events
     return outgoingEventQueueDown_.empty() && outgoingEventQueueUp_.empty();
 }
 
+void CoherenceController::setWarmup(bool on) {
+    if (on) {
+        warmupSaved_.accessLatency = accessLatency_;
+        warmupSaved_.tagLatency = tagLatency_;
+        warmupSaved_.mshrLatency = mshrLatency_;
+        warmupSaved_.maxBytesUp = maxBytesUp;
+        warmupSaved_.maxBytesDown = maxBytesDown;
+        accessLatency_ = tagLatency_ = mshrLatency_ = 0;
+        maxBytesUp = maxBytesDown = 0;
+    } else {
+        accessLatency_ = warmupSaved_.accessLatency;
+        tagLatency_ = warmupSaved_.tagLatency;
+        mshrLatency_ = warmupSaved_.mshrLatency;
+        maxBytesUp = warmupSaved_.maxBytesUp;
+        maxBytesDown = warmupSaved_.maxBytesDown;
+    }
+}
+
 bool CoherenceController::checkIdle() {
     return outgoingEventQueueDown_.empty() && outgoingEventQueueUp_.empty();
 }
@@ -399,7 +438,7 @@ void CoherenceController::forwardByAddress(MemEventBase * event) {
 }
 
 void CoherenceController::forwardByAddress(MemEventBase * event, Cycle_t ts) {
-    event->setSrc(cachename_);
+    event->setSrcID(cacheID_);
     std::string dst = linkDown_->findTargetDestination(event->getRoutingAddress());
     if (dst != "") { /* Common case */
         event->setDst(dst);
@@ -428,7 +467,7 @@ void CoherenceController::forwardByDestination(MemEventBase * event) {
 
 /* Forward an event to a specific destination */
 void CoherenceController::forwardByDestination(MemEventBase * event, Cycle_t ts) {
-    event->setSrc(cachename_);
+    event->setSrcID(cacheID_);
     Response fwdReq = {event, ts, packetHeaderBytes + event->getPayloadSize()};
     
     if (linkUp_->isReachable(event->getDst())) {
@@ -613,15 +652,19 @@ MemEventStatus CoherenceController::allocateMSHR(MemEvent * event, bool fwdReq,
     // Screen prefetches first to ensure limits are not exceeeded:
     //      - Maximum number of outstanding prefetches
     //      - MSHR too full to accept prefetches
-    if (event->isPrefetch() && event->getRqstr() == cachename_) {
+    if (event->isPrefetch() && event->getRqstrID() == cacheID_) {
         if (dropPrefetchLevel_ <= mshr_->getSize()) {
-            eventDI.action = "Reject";
-            eventDI.reason = "Prefetch drop level";
+            if (is_debug_event(event)) {
+                eventDI.action = "Reject";
+                eventDI.reason = "Prefetch drop level";
+            }
             return MemEventStatus::Reject;
         }
         if (maxOutstandingPrefetch_ <= outstandingPrefetches_) {
-            eventDI.action = "Reject";
-            eventDI.reason = "Max outstanding prefetches";
+            if (is_debug_event(event)) {
+                eventDI.action = "Reject";
+                eventDI.reason = "Max outstanding prefetches";
+            }
             return MemEventStatus::Reject;
         }
     }
@@ -658,14 +701,7 @@ MemEventStatus CoherenceController::allocateMSHR(MemEvent * event, bool fwdReq,
 //
 // Prints at debug level 5
 // VERBOSE_LINE_STATE is only printed at debug level 6
-void CoherenceController::printDebugInfo() {
-    printDebugInfo(&eventDI);
-}
-
-void CoherenceController::printDebugInfo(dbgin * diStruct) {
-    if (dlevel < 5)
-        return;
-
+void CoherenceController::writeDebugInfo(dbgin * diStruct) {
     std::string cmd = CommandString[(int)diStruct->cmd];
     if (diStruct->prefetch)
         cmd += "-pref";
@@ -684,38 +720,32 @@ void CoherenceController::printDebugInfo(dbgin * diStruct) {
     debug->debug(_L5_, "\n");
 }
 
-void CoherenceController::printDebugAlloc(bool alloc, Addr addr, std::string note) {
-    if (dlevel < 5)
-        return;
-
+void CoherenceController::writeDebugAlloc(bool alloc, Addr addr, const char* note) {
     std::string action = alloc ? "Alloc" : "Dealloc";
 
     debug->debug(_L5_, "C: %-20" PRIu64 " %-20" PRIu64 " %-20s %-13s 0x%-16" PRIx64 "",
             getCurrentSimCycle(), timestamp_, cachename_.c_str(), action.c_str(), addr);
 
-    if (note != "")
-        debug->debug(_L5_, " %s\n", note.c_str());
+    if (note[0] != '\0')
+        debug->debug(_L5_, " %s\n", note);
     else
         debug->debug(_L5_, "\n");
 }
 
-void CoherenceController::printDataValue(Addr addr, vector<uint8_t> * data, bool set) {
-    if (dlevel < 11)
-        return;
-
+void CoherenceController::writeDataValue(Addr addr, const vector<uint8_t>& data, bool set) {
     std::string action = set ? "WRITE" : "READ";
     std::stringstream value;
     value << std::hex << std::setfill('0');
-    for (unsigned int i = 0; i < data->size(); i++) {
-        value << std::hex << std::setw(2) << (int)data->at(i);
+    for (unsigned int i = 0; i < data.size(); i++) {
+        value << std::hex << std::setw(2) << (int)data.at(i);
     }
     
     debug->debug(_L11_, "V: %-20" PRIu64 " %-20" PRIu64 " %-20s %-13s 0x%-16" PRIx64 " B: %-3zu %s\n",
             getCurrentSimCycle(), timestamp_, cachename_.c_str(), action.c_str(), 
-            addr, data->size(), value.str().c_str());
+            addr, data.size(), value.str().c_str());
 /*
-    for (unsigned int i = 0; i < data->size(); i++) {
-        printf("%02x", data->at(i));
+    for (unsigned int i = 0; i < data.size(); i++) {
+        printf("%02x", data.at(i));
     }
     */
 }
@@ -723,15 +753,15 @@ void CoherenceController::printDataValue(Addr addr, vector<uint8_t> * data, bool
 void CoherenceController::printStatus(Output& out) {
     out.output("  Begin MemHierarchy::CoherenceController %s\n", getName().c_str());
 
+    auto printResponse = [&out](uint64_t time, const Response &resp) {
+        out.output("      Time: %" PRIu64 ", Event: %s\n", time, resp.event->getVerboseString().c_str());
+    };
+
     out.output("    Events waiting in outgoingEventQueueDown: %zu\n", outgoingEventQueueDown_.size());
-    for (list<Response>::iterator it = outgoingEventQueueDown_.begin(); it!= outgoingEventQueueDown_.end(); it++) {
-        out.output("      Time: %" PRIu64 ", Event: %s\n", (*it).deliveryTime, (*it).event->getVerboseString().c_str());
-    }
+    outgoingEventQueueDown_.forEach(printResponse);
 
     out.output("    Events waiting in outgoingEventQueueUp: %zu\n", outgoingEventQueueUp_.size());
-    for (list<Response>::iterator it = outgoingEventQueueUp_.begin(); it!= outgoingEventQueueUp_.end(); it++) {
-        out.output("      Time: %" PRIu64 ", Event: %s\n", (*it).deliveryTime, (*it).event->getVerboseString().c_str());
-    }
+    outgoingEventQueueUp_.forEach(printResponse);
 
     out.output("  End MemHierarchy::CoherenceController\n");
 }
@@ -748,24 +778,33 @@ void CoherenceController::printStatus(Output& out) {
  * a block and then re-request it, the requests can get inverted.
  */
 void CoherenceController::addToOutgoingQueue(Response& resp) {
-    list<Response>::reverse_iterator rit;
-    for (rit = outgoingEventQueueDown_.rbegin(); rit!= outgoingEventQueueDown_.rend(); rit++) {
-        if (resp.deliveryTime >= (*rit).deliveryTime) break;
-        if (resp.event->getRoutingAddress() == (*rit).event->getRoutingAddress()) break;
-    }
-    outgoingEventQueueDown_.insert(rit.base(), resp);
+    addToOutgoingQueue(outgoingEventQueueDown_, outgoingOrderDown_, resp);
 }
 
 /* Add a new event to the outgoing queue up (towards memory)
  * Again, to do not reorder events to the same address
  */
 void CoherenceController::addToOutgoingQueueUp(Response& resp) {
-    list<Response>::reverse_iterator rit;
-    for (rit = outgoingEventQueueUp_.rbegin(); rit != outgoingEventQueueUp_.rend(); rit++) {
-        if (resp.deliveryTime >= (*rit).deliveryTime) break;
-        if (resp.event->getRoutingAddress() == (*rit).event->getRoutingAddress()) break;
-    }
-    outgoingEventQueueUp_.insert(rit.base(), resp);
+    addToOutgoingQueue(outgoingEventQueueUp_, outgoingOrderUp_, resp);
+}
+
+/* An event is never scheduled ahead of a queued event to the same address;
+ * it is delayed to that event's time and queued behind it instead */
+void CoherenceController::addToOutgoingQueue(TimingWheel<Response> &queue, AddrHashTable<AddrOrder> &order, Response &resp) {
+    AddrOrder &addrOrder = order.insert(resp.event->getRoutingAddress());
+    if (addrOrder.count != 0 && resp.deliveryTime < addrOrder.time)
+        resp.deliveryTime = addrOrder.time;
+    addrOrder.time = resp.deliveryTime;
+    addrOrder.count++;
+    queue.insert(resp.deliveryTime, resp);
+}
+
+void CoherenceController::popOutgoingQueue(TimingWheel<Response> &queue, AddrHashTable<AddrOrder> &order) {
+    Addr addr = queue.front().event->getRoutingAddress();
+    AddrOrder* addrOrder = order.find(addr);
+    if (addrOrder && --(addrOrder->count) == 0)
+        order.erase(addr);
+    queue.pop();
 }
 
 
@@ -17,6 +17,7 @@
 #define MEMHIERARCHY_COHERENCECONTROLLER_H
 
 #include <array>
+#include <functional>
 
 #include <sst/core/sst_config.h>
 #include <sst/core/subcomponent.h>
@@ -29,9 +30,14 @@
 #include "util.h"
 #include "sst/elements/memHierarchy/cacheListener.h"
 #include "sst/elements/memHierarchy/mshr.h"
+#include "sst/elements/memHierarchy/lineBuffer.h"
 #include "sst/elements/memHierarchy/memLinkBase.h"
 #include "sst/elements/memHierarchy/replacementManager.h"
 #include "sst/elements/memHierarchy/hash.h"
+#include "sst/elements/memHierarchy/cacheCheckpoint.h"
+#include "sst/elements/memHierarchy/timingWheel.h"
+#include "sst/elements/memHierarchy/addrHashTable.h"
+#include "sst/elements/memHierarchy/flightRecorder.h"
 
 namespace SST { namespace MemHierarchy {
 using namespace std;
@@ -107,12 +113,24 @@ public:
     /* For clock handling = parent updates timestamp when the clock is re-enabled */
     void updateTimestamp(uint64_t newTS) { timestamp_ = newTS; }
 
+    /* Functional warmup: zero latencies and lift bandwidth limits while on */
+    void setWarmup(bool on);
+
+    /* Latency tracing: called with each traced response whose trace this cache started */
+    void setTraceHandler(std::function<void(MemEventBase*)> handler) { traceHandler_ = handler; }
+
+    /* Flight recorder: the cache's recorder, which this manager adds sent events to */
+    void setFlightRecorder(FlightRecorder* recorder) { flightRecorder_ = recorder; }
+
     /* Check whether the event queues are empty/subcomponent is doing anything */
     bool checkIdle();
 
     /* Get which bank an address maps to (call through to cache array) */
     virtual Addr getBank(Addr addr) = 0;
 
+    /* Get the coherence state of a line, NP if it is not present (for the flight recorder) */
+    virtual State getLineState(Addr UNUSED(addr)) { return NP; }
+
 
     /*********************************************************************************
      * Initialization/finish functions used by parent
@@ -155,6 +173,10 @@ public:
     /* Call through to cache array to configure banking/slicing */
     virtual void setSliceAware(uint64_t interleaveSize, uint64_t interleaveStep) = 0;
 
+    /* Call through to cache array(s) to checkpoint/restore contents. Protocols without an array keep the defaults */
+    virtual void saveCheckpoint(CacheCheckpoint &ckpt) { }
+    virtual void loadCheckpoint(const CacheCheckpoint &ckpt, CacheCheckpoint::LoadStats &stats) { }
+
     /* Setup debug info (cache-wide) */
     void setDebug(std::set<Addr> debugAddr) { DEBUG_ADDR = debugAddr; }
 
@@ -162,7 +184,7 @@ public:
     std::vector<MemEventBase*>* getRetryBuffer();
     void clearRetryBuffer();
 
-    virtual void printDebugInfo();
+    void printDebugInfo() { printDebugInfo(&eventDI); }
 
     /*********************************************************************************
      * Statistics functions shared by parent
@@ -233,9 +255,27 @@ protected:
         }
     } eventDI, evictDI;
 
-    virtual void printDebugInfo(dbgin * diStruct);
-    virtual void printDebugAlloc(bool alloc, Addr addr, std::string note);
-    virtual void printDataValue(Addr addr, vector<uint8_t> * data, bool set);
+    /* Debug output. Calls are compiled out unless debug output is enabled (util.h) */
+    void printDebugInfo(dbgin * diStruct) {
+        if constexpr (debugEnabled) {
+            if (dlevel >= 5) writeDebugInfo(diStruct);
+        }
+    }
+    void printDebugAlloc(bool alloc, Addr addr, const char* note) {
+        if constexpr (debugEnabled) {
+            if (dlevel >= 5) writeDebugAlloc(alloc, addr, note);
+        }
+    }
+    void printDataValue(Addr addr, vector<uint8_t> * data, bool set) {
+        if constexpr (debugEnabled) {
+            if (dlevel >= 11) writeDataValue(addr, *data, set);
+        }
+    }
+    void printDataValue(Addr addr, const LineBuffer& data, bool set) {
+        if constexpr (debugEnabled) {
+            if (dlevel >= 11) writeDataValue(addr, data.data(), set);
+        }
+    }
 
     /* Initialization */
     ReplacementPolicy * createReplacementPolicy(uint64_t lines, uint64_t assoc, Params& params, bool L1, int slotnum = 0);
@@ -256,6 +296,7 @@ protected:
 
     /* Cache name - used for identifying where events came from/are going to */
     std::string cachename_;
+    EndpointID cacheID_;
 
     /* Output & debug */
     Output* output; // Output stream for warnings, notices, fatal, etc.
@@ -263,6 +304,10 @@ protected:
     std::set<Addr> DEBUG_ADDR; // Addresses to print debug info for (all if empty)
     uint32_t dlevel;    // Debug level -> used to determine output format/amount of output
 
+    void writeDebugInfo(dbgin * diStruct);
+    void writeDebugAlloc(bool alloc, Addr addr, const char* note);
+    void writeDataValue(Addr addr, const vector<uint8_t>& data, bool set);
+
     /* Latencies amd timing */
     uint64_t timestamp_;        // Local timestamp (cycles)
     uint64_t accessLatency_;    // Data/tag access latency
@@ -318,8 +363,22 @@ protected:
 
 private:
     /* Outgoing event queues - events are stalled here to account for access latencies */
-    list<Response> outgoingEventQueueDown_;
-    list<Response> outgoingEventQueueUp_;
+    TimingWheel<Response> outgoingEventQueueDown_;
+    TimingWheel<Response> outgoingEventQueueUp_;
+
+    /* Latest delivery time and number of queued events per routing address.
+     * Used to keep events to the same address in order in the outgoing queues. */
+    struct AddrOrder {
+        uint64_t time;
+        uint32_t count;
+        AddrOrder() : time(0), count(0) { }
+        void reset() { time = 0; count = 0; }
+    };
+    AddrHashTable<AddrOrder> outgoingOrderDown_;
+    AddrHashTable<AddrOrder> outgoingOrderUp_;
+
+    void addToOutgoingQueue(TimingWheel<Response> &queue, AddrHashTable<AddrOrder> &order, Response &resp);
+    void popOutgoingQueue(TimingWheel<Response> &queue, AddrHashTable<AddrOrder> &order);
 
     MemLinkBase * linkUp_;
     MemLinkBase * linkDown_;
@@ -335,6 +394,18 @@ protected:
     uint64_t maxBytesDown;
     uint64_t packetHeaderBytes;
 
+    /* Timing parameters saved during warmup */
+    struct {
+        uint64_t accessLatency;
+        uint64_t tagLatency;
+        uint64_t mshrLatency;
+        uint64_t maxBytesUp;
+        uint64_t maxBytesDown;
+    } warmupSaved_;
+
+    std::function<void(MemEventBase*)> traceHandler_;   // Empty unless this cache starts traces
+    FlightRecorder* flightRecorder_;                    // Owned by the cache, nullptr if not set
+
     /* Prefetch statistics */
     Statistic<uint64_t>* statPrefetchEvict;
     Statistic<uint64_t>* statPrefetchInv;
@@ -0,0 +1,68 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_COHERENCETABLE_H
+#define MEMHIERARCHY_COHERENCETABLE_H
+
+#include <initializer_list>
+
+#include "sst/elements/memHierarchy/memTypes.h"
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ * Compile-time coherence transition table
+ *
+ * Maps (state, command) to a protocol-defined action, usually a small enum
+ * that the coherence manager dispatches on to one function per action. The
+ * table is built from a list of rows when the manager is compiled. Pairs
+ * without a row map to 'Default', which is typically the stall/MSHR path
+ * taken for transient states.
+ *
+ * Keeping the decision in a table rather than in nested switches puts a
+ * protocol's transitions in one place, and a variant protocol (e.g., MSI
+ * vs. MESI, or adding O/F states) changes rows rather than handler code.
+ * Tables can be checked with static_assert since lookups are constexpr.
+ *
+ * Only MESIL1's request path (MESI_L1_Table.h) uses a table. Its responses,
+ * snoops, and flushes, and the other coherence managers, still decide in
+ * switch statements.
+ */
+template<typename Action, Action Default>
+class CoherenceTable {
+public:
+    struct Row {
+        State state;
+        Command cmd;
+        Action action;
+    };
+
+    constexpr CoherenceTable(std::initializer_list<Row> rows) : table_() {
+        for (int s = 0; s < (int)LAST_STATE; s++) {
+            for (int c = 0; c < (int)Command::LAST_CMD; c++)
+                table_[s][c] = Default;
+        }
+        for (const Row& row : rows)
+            table_[(int)row.state][(int)row.cmd] = row.action;
+    }
+
+    constexpr Action get(State state, Command cmd) const { return table_[(int)state][(int)cmd]; }
+
+private:
+    Action table_[LAST_STATE][(int)Command::LAST_CMD];
+};
+
+}}
+#endif // MEMHIERARCHY_COHERENCETABLE_H
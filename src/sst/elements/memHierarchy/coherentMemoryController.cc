@@ -31,12 +31,8 @@ using namespace SST::MemHierarchy;
 
 /* Debug macros */
 #ifdef __SST_DEBUG_OUTPUT__ /* From sst-core, enable with --enable-debug */
-#define is_debug_addr(addr) (DEBUG_ADDR.empty() || DEBUG_ADDR.find(addr) != DEBUG_ADDR.end())
-#define is_debug_event(ev) (DEBUG_ADDR.empty() || ev->doDebug(DEBUG_ADDR))
 #define Debug(level, fmt, ... ) dbg.debug( level, fmt, ##__VA_ARGS__ )
 #else
-#define is_debug_addr(addr) false
-#define is_debug_event(ev) false
 #define Debug(level, fmt, ... )
 #endif
 
@@ -47,6 +43,9 @@ using namespace SST::MemHierarchy;
 CoherentMemController::CoherentMemController(ComponentId_t id, Params &params) : MemController(id, params) {
     directory_ = false; /* Updated during init */
     timestamp_ = 0;
+
+    if (warmup_.end())
+        out.verbose(CALL_INFO, 1, 0, "%s, WARNING: 'warmup' is not supported by CoherentMemController and will be ignored.\n", getName().c_str());
 }
 
 /**
@@ -105,15 +104,15 @@ bool CoherentMemController::clock(Cycle_t cycle) {
     timestamp_++;
 
     bool debug = false;
-    while (!msgQueue_.empty() && msgQueue_.begin()->first < timestamp_) {
-        MemEventBase * sendEv = msgQueue_.begin()->second;
+    while (msgQueue_.ready(timestamp_ - 1)) {
+        MemEventBase * sendEv = msgQueue_.front();
 
         if (is_debug_event(sendEv)) {
             Debug(_L3_, "E: %-20" PRIu64 " %-20" PRIu64 " %-20s Event:Send    (%s)\n",
                     getCurrentSimCycle(), getNextClockCycle(clockTimeBase_) - 1, getName().c_str(), sendEv->getVerboseString(dlevel).c_str());
         }
         link_->send(sendEv);
-        msgQueue_.erase(msgQueue_.begin());
+        msgQueue_.pop();
     }
 
     /* Unclock if nothing is in clocked queues anywhere (link, backend, here) */
@@ -459,7 +458,7 @@ void CoherentMemController::handleNack(MemEvent * ev) {
         uint64_t backoff = (0x1 << retries);
         nackedEvent->incrementRetries();
 
-        msgQueue_.insert(std::make_pair(timestamp_ + backoff, nackedEvent));
+        msgQueue_.insert(timestamp_ + backoff, nackedEvent);
     } else {
         delete nackedEvent;
     }
@@ -514,7 +513,7 @@ bool CoherentMemController::doShootdown(Addr addr, MemEventBase * ev) {
         inv->copyMetadata(ev);
         inv->setDst(ev->getSrc());
 
-        msgQueue_.insert(std::make_pair(timestamp_, inv)); /* Send on next clock. TODO timing needed? */
+        msgQueue_.insert(timestamp_, inv); /* Send on next clock. TODO timing needed? */
         return true;
     }
     return false;
@@ -21,15 +21,6 @@
 
 #include "memNIC.h"
 
-/* Debug macros */
-#ifdef __SST_DEBUG_OUTPUT__ /* From sst-core, enable with --enable-debug */
-#define is_debug_addr(addr) (DEBUG_ADDR.empty() || DEBUG_ADDR.find(addr) != DEBUG_ADDR.end())
-#define is_debug_event(ev) (DEBUG_ADDR.empty() || ev->doDebug(DEBUG_ADDR))
-#else
-#define is_debug_addr(addr) false
-#define is_debug_event(ev) false
-#endif
-
 using namespace SST;
 using namespace SST::MemHierarchy;
 using namespace std;
@@ -241,6 +232,8 @@ DirectoryController::DirectoryController(ComponentId_t id, Params &params) :
     stat_getRequestLatency          = registerStatistic<uint64_t>("get_request_latency");
     stat_cacheHits                  = registerStatistic<uint64_t>("directory_cache_hits");
     stat_mshrHits                   = registerStatistic<uint64_t>("mshr_hits");
+    stat_sparseRecalls              = registerStatistic<uint64_t>("sparse_recalls");
+    stat_sparseStalls               = registerStatistic<uint64_t>("sparse_set_full_stalls");
     stat_eventRecv[(int)Command::GetX] = registerStatistic<uint64_t>("GetX_recv");
     stat_eventRecv[(int)Command::GetS] = registerStatistic<uint64_t>("GetS_recv");
     stat_eventRecv[(int)Command::GetSX] = registerStatistic<uint64_t>("GetSX_recv");
@@ -304,6 +297,20 @@ DirectoryController::DirectoryController(ComponentId_t id, Params &params) :
     entryCacheSize = 0;
     entrySize = 4; // Bytes, TODO parameterize
 
+    sparseSets = params.find<uint64_t>("sparse_directory_sets", 0);
+    sparseWays = params.find<uint64_t>("sparse_directory_ways", 8);
+    sparseTimestamp = 0;
+    if (sparseSets != 0) {
+        if (!isPowerOfTwo(sparseSets))
+            out.fatal(CALL_INFO, -1, "Invalid param(%s): sparse_directory_sets - must be a power of two. You specified: %" PRIu64 "\n", getName().c_str(), sparseSets);
+        if (sparseWays == 0)
+            out.fatal(CALL_INFO, -1, "Invalid param(%s): sparse_directory_ways - must be at least 1.\n", getName().c_str());
+        sparseEntries.assign(sparseSets * sparseWays, DirEntry(0));
+        sparseTags.assign(sparseSets * sparseWays, NO_ADDR);
+        sparseLRU.assign(sparseSets * sparseWays, 0);
+        sparseRecallPending.assign(sparseSets, false);
+    }
+
     string protstr  = params.find<std::string>("coherence_protocol", "MESI");
     if (protstr == "mesi" || protstr == "MESI") protocol = CoherenceProtocol::MESI;
     else if (protstr == "msi" || protstr == "MSI") protocol = CoherenceProtocol::MSI;
@@ -316,6 +323,28 @@ DirectoryController::DirectoryController(ComponentId_t id, Params &params) :
     /* Get latencies */
     accessLatency   = params.find<uint64_t>("access_latency_cycles", 0);
     mshrLatency     = params.find<uint64_t>("mshr_latency_cycles", 0);
+
+    /* Functional warmup */
+    if (params.find<bool>("warmup", false)) {
+        warmup.start();
+        warmupAccessLatency = accessLatency;
+        warmupMSHRLatency = mshrLatency;
+        warmupMaxRequestsPerCycle = maxRequestsPerCycle;
+        warmupMSHRSize = mshr->getMaxSize();
+        accessLatency = 0;
+        mshrLatency = 0;
+        maxRequestsPerCycle = 0;
+        mshr->setMaxSize(-1);
+
+        std::string endTime = params.find<std::string>("warmup_end", "");
+        if (!endTime.empty())
+            registerOneShot(endTime, new OneShot::Handler<DirectoryController>(this, &DirectoryController::endWarmup));
+    }
+
+    /* Flight recorder */
+    flightRecorder.init(params.find<size_t>("flight_recorder_size", 1024));
+    flightRecorderDir = params.find<std::string>("flight_recorder_dir", ".");
+    flightRecorderAtFinish = params.find<bool>("flight_recorder_dump_at_finish", false);
 }
 
 
@@ -336,6 +365,13 @@ void DirectoryController::handlePacket(SST::Event *event){
         turnClockOn();
     }
 
+    if (warmup.roiStarted())
+        endWarmup();
+
+    if (evb->isTraced())
+        evb->addTraceStamp(LatencyTrace::Point::DirArrive, getCurrentSimCycle());
+    flightRecorder.record(getCurrentSimCycle(), FlightRecorder::Recv, evb);
+
     /* Forward events that we don't handle */
     if (MemEventTypeArr[(int)evb->getCmd()] != MemEventType::Cache || evb->queryFlag(MemEvent::F_NONCACHEABLE)) {
 
@@ -453,10 +489,22 @@ bool DirectoryController::processPacket(MemEvent * ev, bool replay) {
         return false;
     }
 
+    /* Sparse directory: the line needs an entry before the event can be handled */
+    if (sparseSets != 0 && ev->isAddrGlobal() && !reserveSparseEntry(ev)) {
+        if (is_debug_addr(addr)) {
+            std::stringstream id;
+            id << "<" << ev->getID().first << "," << ev->getID().second << ">";
+            dbg.debug(_L5_, "A: %-20" PRIu64 " %-20" PRIu64 " %-20s %-13s 0x%-16" PRIx64 " %-15s %-6s %-6s %-10s %-15s\n",
+                    getCurrentSimCycle(), timestamp, getName().c_str(), CommandString[(int)ev->getCmd()],
+                    addr, id.str().c_str(), "", "", "Stall", "(directory set full)");
+        }
+        return false;
+    }
+
     bool retval = false;
     Command cmd = ev->getCmd();
 
-    if (!replay) {
+    if (!replay && sparseRecalls.find(ev->getID()) == sparseRecalls.end()) {
         stat_eventRecv[(int)cmd]->addData(1);
     }
 
@@ -465,6 +513,16 @@ bool DirectoryController::processPacket(MemEvent * ev, bool replay) {
         return true;
     }
 
+    /* Latency tracing: a response hands its stamps to the request waiting for it */
+    if (ev->isTraced()) {
+        ev->addTraceStamp(replay ? LatencyTrace::Point::DirReplay : LatencyTrace::Point::DirStart, getCurrentSimCycle());
+        if (BasicCommandClassArr[(int)cmd] == BasicCommandClass::Response) {
+            MemEventBase* req = mshr->getEntryEvent(addr, 0);
+            if (req)
+                req->adoptTrace(ev);
+        }
+    }
+
     switch (cmd) {
         case Command::GetS:
             retval = handleGetS(ev, replay);
@@ -537,6 +595,9 @@ bool DirectoryController::processPacket(MemEvent * ev, bool replay) {
     if (dbgevent)
         printDebugInfo();
 
+    if (flightRecorder.enabled())
+        flightRecorder.record(getCurrentSimCycle(), retval ? FlightRecorder::Handle : FlightRecorder::Stall, ev, peekEntryState(addr));
+
     if (retval)
         addrsThisCycle.insert(addr);
 
@@ -577,9 +638,12 @@ void DirectoryController::handleNoncacheableResponse(MemEventBase * ev) {
 }
 
 void DirectoryController::printStatus(Output &statusOut) {
+    dumpFlightRecorder();
     statusOut.output("MemHierarchy::DirectoryController %s\n", getName().c_str());
     statusOut.output("  Cached entries: %" PRIu64 "\n", entryCacheSize);
     statusOut.output("  Requests waiting to be handled:  %zu\n", eventBuffer.size());
+    if (warmup.active())
+        statusOut.output("  In functional warmup\n");
 //    for(std::list<std::pair<MemEvent*,bool> >::iterator i = workQueue.begin() ; i != workQueue.end() ; ++i){
 //        statusOut.output("    %s, %s\n", i->first->getVerboseString(dlevel).c_str(), i->second ? "replay" : "new");
 //    }
@@ -603,6 +667,10 @@ void DirectoryController::printStatus(Output &statusOut) {
     for (std::unordered_map<Addr, DirEntry*>::iterator it = directory.begin(); it != directory.end(); it++) {
         statusOut.output("    0x%" PRIx64 " %s\n", it->first, it->second->getString().c_str());
     }
+    for (size_t i = 0; i < sparseTags.size(); i++) {
+        if (sparseTags[i] != NO_ADDR && sparseEntries[i].getState() != I)
+            statusOut.output("    0x%" PRIx64 " %s\n", sparseTags[i], sparseEntries[i].getString().c_str());
+    }
     statusOut.output("End MemHierarchy::DirectoryController\n\n");
 }
 
@@ -614,15 +682,39 @@ void DirectoryController::emergencyShutdown() {
         printStatus(out);
         out.output("   Checking for unreceived events on network link:\n");
         cpuLink->emergencyShutdownDebug(out);
+    } else {
+        dumpFlightRecorder(); // printStatus() does this otherwise
     }
 }
 
 
+void DirectoryController::dumpFlightRecorder() {
+    if (!flightRecorder.enabled())
+        return;
+    std::string file = flightRecorderDir + "/" + getName() + ".flight";
+    if (!flightRecorder.dump(file, getName(), getCurrentSimCycle(), CommandString, (uint32_t)Command::LAST_CMD, StateString, LAST_STATE, EndpointRegistry::getName))
+        out.output("%s, Warning: unable to write flight recorder to '%s'\n", getName().c_str(), file.c_str());
+}
+
+
 bool DirectoryController::isRequestAddressValid(Addr addr){
     return cpuLink->isRequestAddressValid(addr);
 }
 
 
+/* Switch to timing mode. Events already in flight finish with warmup timing. */
+void DirectoryController::endWarmup() {
+    if (!warmup.end())
+        return;
+    accessLatency = warmupAccessLatency;
+    mshrLatency = warmupMSHRLatency;
+    maxRequestsPerCycle = warmupMaxRequestsPerCycle;
+    mshr->setMaxSize(warmupMSHRSize);
+    out.verbose(CALL_INFO, 2, 0, "%s, Notice: warmup ended at %" PRIu64 "ns\n", getName().c_str(), getCurrentSimTimeNano());
+    if (Warmup::firstToEnd())
+        performGlobalStatisticOutput();
+}
+
 void DirectoryController::turnClockOn() {
     clockOn = true;
     timestamp = reregisterClock(defaultTimeBase, clockHandler);
@@ -707,6 +799,8 @@ void DirectoryController::init(unsigned int phase) {
 
 void DirectoryController::finish(void){
     cpuLink->finish();
+    if (flightRecorderAtFinish)
+        dumpFlightRecorder();
 }
 
 
@@ -715,6 +809,12 @@ void DirectoryController::setup(void){
     cpuLink->setup();
     if (cpuLink != memLink)
         memLink->setup();
+
+    // Assign compact sharer IDs to our sources in name order
+    std::set<std::string> srcNames;
+    for (std::set<MemLinkBase::EndpointInfo>::iterator it = cpuLink->getSources()->begin(); it != cpuLink->getSources()->end(); it++)
+        srcNames.insert(it->name);
+    SharerIDMap::registerNames(srcNames);
     //MemLinkBase * mem = memLink ? memLink : network;
 }
 
@@ -1093,7 +1193,7 @@ bool DirectoryController::handleFlushLine(MemEvent* event, bool inMSHR) {
                 if (event->getEvict()) {
                     entry->removeOwner();
                     entry->addSharer(event->getSrc());
-                    mshr->setData(addr, event->getPayload(), event->getDirty());
+                    mshr->setData(addr, event->readPayload(), event->getDirty());
                     event->setEvict(false);
                 } else if (entry->hasOwner()) {
                     issueFetch(event, entry, Command::FetchInvX);
@@ -1108,7 +1208,7 @@ bool DirectoryController::handleFlushLine(MemEvent* event, bool inMSHR) {
             if (event->getEvict()) {
                 entry->removeOwner();
                 entry->addSharer(event->getSrc());
-                mshr->setData(addr, event->getPayload(), event->getDirty());
+                mshr->setData(addr, event->readPayload(), event->getDirty());
                 event->setEvict(false);
                 entry->setState(S_Inv);
             }
@@ -1117,7 +1217,7 @@ bool DirectoryController::handleFlushLine(MemEvent* event, bool inMSHR) {
             if (event->getEvict()) {
                 entry->removeOwner();
                 entry->addSharer(event->getSrc());
-                mshr->setData(addr, event->getPayload(), event->getDirty());
+                mshr->setData(addr, event->readPayload(), event->getDirty());
                 entry->setState(S);
                 mshr->decrementAcksNeeded(addr);
                 responses.find(addr)->second.erase(event->getSrc());
@@ -1190,7 +1290,7 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
             if (status == MemEventStatus::OK) {
                 if (event->getEvict()) {
                     entry->removeOwner();
-                    mshr->setData(addr, event->getPayload(), event->getDirty());
+                    mshr->setData(addr, event->readPayload(), event->getDirty());
                     event->setEvict(false);
                 }
 
@@ -1222,7 +1322,7 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
         case M_InvX:
             if (event->getEvict()) {
                 entry->removeOwner();
-                mshr->setData(addr, event->getPayload(), event->getDirty());
+                mshr->setData(addr, event->readPayload(), event->getDirty());
                 event->setEvict(false);
                 responses.find(addr)->second.erase(event->getSrc());
                 if (responses.find(addr)->second.empty()) responses.erase(addr);
@@ -1412,14 +1512,14 @@ bool DirectoryController::handlePutX(MemEvent * event, bool inMSHR) {
             update = true;
             break;
         case M_Inv:
-            mshr->setData(addr, event->getPayload(), event->getDirty());
+            mshr->setData(addr, event->readPayload(), event->getDirty());
             entry->setState(S_Inv);
             break;
         case M_InvX:
             mshr->decrementAcksNeeded(addr);
             responses.find(addr)->second.erase(event->getSrc());
             if (responses.find(addr)->second.empty()) responses.erase(addr);
-            mshr->setData(addr, event->getPayload(), event->getDirty());
+            mshr->setData(addr, event->readPayload(), event->getDirty());
             entry->setState(S);
             break;
         default:
@@ -1474,7 +1574,7 @@ bool DirectoryController::handlePutE(MemEvent * event, bool inMSHR) {
             mshr->decrementAcksNeeded(addr);
             responses.find(addr)->second.erase(event->getSrc());
             if (responses.find(addr)->second.empty()) responses.erase(addr);
-            mshr->setData(addr, event->getPayload(), event->getDirty());
+            mshr->setData(addr, event->readPayload(), event->getDirty());
             entry->setState(I);
             break;
         default:
@@ -1530,7 +1630,7 @@ bool DirectoryController::handlePutM(MemEvent * event, bool inMSHR) {
             mshr->decrementAcksNeeded(addr);
             responses.find(addr)->second.erase(event->getSrc());
             if (responses.find(addr)->second.empty()) responses.erase(addr);
-            mshr->setData(addr, event->getPayload(), event->getDirty());
+            mshr->setData(addr, event->readPayload(), event->getDirty());
             entry->setState(I);
             break;
         default:
@@ -1574,6 +1674,20 @@ bool DirectoryController::handleFetchInv(MemEvent * event, bool inMSHR) {
 
     switch (state) {
         case I:
+            if (sparseRecalls.erase(event->getID())) {
+                // Recall of a sparse directory entry is complete, no response needed
+                if (mshr->hasData(addr) && mshr->getDataDirty(addr))
+                    writebackDataFromMSHR(addr);
+                if (mshr->hasData(addr))
+                    mshr->clearData(addr);
+                sparseRecallPending[((addr / lineSize) & (sparseSets - 1))] = false;
+                if (is_debug_event(event)) {
+                    eventDI.action = "Done";
+                    eventDI.reason = "recall";
+                }
+                cleanUpAfterRequest(event, inMSHR);
+                break;
+            }
             if (!(mshr->pendingWriteback(addr) || (mshr->exists(addr) && mshr->getFrontEvent(addr)->getCmd() == Command::FlushLineInv))) {
                 if (mshr->hasData(addr) && mshr->getDataDirty(addr))
                     sendFetchResponse(event);
@@ -1657,8 +1771,11 @@ bool DirectoryController::handleFetchInv(MemEvent * event, bool inMSHR) {
         eventDI.verboseline = entry->getString();
     }
 
-    if (status == MemEventStatus::Reject)
+    if (status == MemEventStatus::Reject) {
+        if (sparseRecalls.find(event->getID()) != sparseRecalls.end())
+            return false; // Internal recall, retry when the MSHR has space
         sendNACK(event);
+    }
 
     return true;
 }
@@ -1796,7 +1913,7 @@ bool DirectoryController::handleGetSResp(MemEvent * event, bool inMSHR) {
     }
 
     sendDataResponse(reqEv, entry, event->getPayload(), Command::GetSResp);
-    mshr->setData(addr, event->getPayload(), false); // Save data for a subsequent GetS
+    mshr->setData(addr, event->readPayload(), false); // Save data for a subsequent GetS
     cleanUpAfterResponse(event, inMSHR);
 
     if (is_debug_addr(addr)) {
@@ -1835,7 +1952,7 @@ bool DirectoryController::handleGetXResp(MemEvent * event, bool inMSHR) {
                 entry->addSharer(reqEv->getSrc());
             }
             sendDataResponse(reqEv, entry, event->getPayload(), Command::GetSResp);
-            mshr->setData(addr, event->getPayload(), false); // So subsequent GetS can get data
+            mshr->setData(addr, event->readPayload(), false); // So subsequent GetS can get data
             break;
         case IM:
             if (incoherentSrc.find(reqEv->getSrc()) == incoherentSrc.end()) {
@@ -1848,7 +1965,7 @@ bool DirectoryController::handleGetXResp(MemEvent * event, bool inMSHR) {
             break;
         case SM_Inv:
             entry->setState(S_Inv);
-            mshr->setData(addr, event->getPayload(), false); // Save data for when the invalidations finish
+            mshr->setData(addr, event->readPayload(), false); // Save data for when the invalidations finish
             if (is_debug_addr(addr)) {
                 eventDI.newst = entry->getState();
                 eventDI.verboseline = entry->getString();
@@ -1934,13 +2051,13 @@ bool DirectoryController::handleFlushLineResp(MemEvent * event, bool inMSHR) {
 
 bool DirectoryController::handleAckPut(MemEvent* event, bool inMSHR) {
     Addr addr = event->getBaseAddr();
-    DirEntry* entry = getDirEntry(addr);
-    State state = entry->getState();
+    DirEntry* entry = sparseSets != 0 ? findSparseEntry(addr) : getDirEntry(addr);
+    State state = entry ? entry->getState() : NP;
 
     if (is_debug_addr(addr))
         eventDI.prefill(event->getID(), Command::AckPut, false, addr, state);
 
-    if (is_debug_addr(addr)) {
+    if (is_debug_addr(addr) && entry) {
         eventDI.newst = entry->getState();
         eventDI.verboseline = entry->getString();
     }
@@ -2022,7 +2139,7 @@ bool DirectoryController::handleFetchXResp(MemEvent* event, bool inMSHR) {
     responses.find(addr)->second.erase(event->getSrc());
     if (responses.find(addr)->second.empty()) responses.erase(addr);
 
-    mshr->setData(addr, event->getPayload(), event->getDirty());       // Save data for retry
+    mshr->setData(addr, event->readPayload(), event->getDirty());       // Save data for retry
 
     entry->removeOwner();
     entry->addSharer(event->getSrc());
@@ -2057,7 +2174,7 @@ bool DirectoryController::handleFetchResp(MemEvent* event, bool inMSHR) {
     responses.find(addr)->second.erase(event->getSrc());
     if (responses.find(addr)->second.empty())
         responses.erase(addr);
-    mshr->setData(addr, event->getPayload(), event->getDirty());       // Save data for retry
+    mshr->setData(addr, event->readPayload(), event->getDirty());       // Save data for retry
 
     entry->setState(I);
 
@@ -2078,8 +2195,8 @@ bool DirectoryController::handleFetchResp(MemEvent* event, bool inMSHR) {
 
 bool DirectoryController::handleNACK(MemEvent* event, bool inMSHR) {
     Addr addr = event->getBaseAddr();
-    DirEntry* entry = getDirEntry(addr);
-    State state = entry->getState();
+    DirEntry* entry = sparseSets != 0 ? findSparseEntry(addr) : getDirEntry(addr);
+    State state = entry ? entry->getState() : NP;
 
     if (is_debug_addr(addr))
         eventDI.prefill(event->getID(), Command::NACK, false, addr, state);
@@ -2114,7 +2231,7 @@ bool DirectoryController::handleNACK(MemEvent* event, bool inMSHR) {
     // Resend nack'd event
     forwardByDestination(nackedEvent, timestamp + mshrLatency);
 
-    if (is_debug_addr(addr)) {
+    if (is_debug_addr(addr) && entry) {
         eventDI.newst = entry->getState();
         eventDI.verboseline = entry->getString();
     }
@@ -2165,6 +2282,16 @@ bool DirectoryController::handleDirEntryResponse(MemEvent* event) {
  * Manage data structures
  ****************************/
 DirectoryController::DirEntry* DirectoryController::getDirEntry(Addr addr) {
+    if (sparseSets != 0) {
+        DirEntry* entry = findSparseEntry(addr);
+        if (!entry)
+            entry = allocateSparseEntry(addr);
+        if (!entry)
+            out.fatal(CALL_INFO, -1, "%s, Error: No sparse directory entry available for 0x%" PRIx64 ". Time: %" PRIu64 "ns\n",
+                    getName().c_str(), addr, getCurrentSimTimeNano());
+        return entry;
+    }
+
     std::unordered_map<Addr,DirEntry*>::iterator i = directory.find(addr);
 
     if (directory.end() == i) {
@@ -2177,6 +2304,95 @@ DirectoryController::DirEntry* DirectoryController::getDirEntry(Addr addr) {
     return i->second;
 }
 
+DirectoryController::DirEntry* DirectoryController::findSparseEntry(Addr addr) {
+    uint64_t base = ((addr / lineSize) & (sparseSets - 1)) * sparseWays;
+    for (uint64_t i = base; i < base + sparseWays; i++) {
+        if (sparseTags[i] == addr) {
+            sparseLRU[i] = ++sparseTimestamp;
+            return &sparseEntries[i];
+        }
+    }
+    return nullptr;
+}
+
+uint8_t DirectoryController::peekEntryState(Addr addr) {
+    if (sparseSets != 0) {
+        uint64_t base = ((addr / lineSize) & (sparseSets - 1)) * sparseWays;
+        for (uint64_t i = base; i < base + sparseWays; i++) {
+            if (sparseTags[i] == addr)
+                return sparseEntries[i].getState();
+        }
+        return FlightRecorder::NO_STATE;
+    }
+    std::unordered_map<Addr,DirEntry*>::iterator i = directory.find(addr);
+    return i == directory.end() ? FlightRecorder::NO_STATE : i->second->getState();
+}
+
+/* Claim a free way for addr. A way is free if it is unused or its entry is in I with no MSHR activity. */
+DirectoryController::DirEntry* DirectoryController::allocateSparseEntry(Addr addr) {
+    uint64_t base = ((addr / lineSize) & (sparseSets - 1)) * sparseWays;
+    for (uint64_t i = base; i < base + sparseWays; i++) {
+        if (sparseTags[i] == NO_ADDR || (sparseEntries[i].getState() == I && !mshr->exists(sparseTags[i]))) {
+            sparseEntries[i] = DirEntry(addr);
+            sparseEntries[i].setCached(true);
+            sparseTags[i] = addr;
+            sparseLRU[i] = ++sparseTimestamp;
+            return &sparseEntries[i];
+        }
+    }
+    return nullptr;
+}
+
+/* Returns false if the event must stall because its set is full */
+bool DirectoryController::reserveSparseEntry(MemEvent* event) {
+    if (BasicCommandClassArr[(int)event->getCmd()] != BasicCommandClass::Request)
+        return true; // Responses are for lines with an MSHR entry, which are never evicted
+    Addr addr = event->getBaseAddr();
+    if (findSparseEntry(addr) || allocateSparseEntry(addr)) {
+        sparseStalled.erase(event->getID());
+        return true;
+    }
+    // Stalled events are retried every cycle; count each one once
+    if (sparseStalled.insert(event->getID()).second)
+        stat_sparseStalls->addData(1);
+    recallSparseEntry((addr / lineSize) & (sparseSets - 1));
+    return false;
+}
+
+/* Recall the LRU stable entry in 'set' by invalidating it in all caches.
+ * The recall is an internal FetchInv handled like one from memory, except that no response is sent. */
+void DirectoryController::recallSparseEntry(uint64_t set) {
+    if (sparseRecallPending[set])
+        return;
+
+    uint64_t base = set * sparseWays;
+    uint64_t end = base + sparseWays;
+    uint64_t victim = end;
+    for (uint64_t i = base; i < end; i++) {
+        State state = sparseEntries[i].getState();
+        if ((state != S && state != M) || mshr->exists(sparseTags[i]))
+            continue;
+        if (victim == end || sparseLRU[i] < sparseLRU[victim])
+            victim = i;
+    }
+    if (victim == end)
+        return; // Every way is busy, retry once one finishes
+
+    Addr addr = sparseTags[victim];
+    MemEvent* recall = new MemEvent(getName(), addr, addr, Command::FetchInv, lineSize);
+    recall->setRqstr(getName());
+    sparseRecalls.insert(recall->getID());
+    sparseRecallPending[set] = true;
+    stat_sparseRecalls->addData(1);
+
+    if (is_debug_addr(addr))
+        dbg.debug(_L5_, "A: %-20" PRIu64 " %-20" PRIu64 " %-20s %-13s 0x%-16" PRIx64 " %-15s %-6s %-6s %-10s %-15s\n",
+                getCurrentSimCycle(), timestamp, getName().c_str(), "FetchInv", addr, "", "", "", "Recall", "(directory set full)");
+
+    // Handle ahead of new events so that later requests to the victim wait for the recall
+    eventBuffer.push_front(recall);
+}
+
 bool DirectoryController::retrieveDirEntry(DirEntry* entry, MemEvent* event, bool inMSHR) {
     MemEventStatus status = inMSHR ? MemEventStatus::OK : allocateMSHR(event, false);
     if (status == MemEventStatus::Reject)
@@ -2212,7 +2428,7 @@ bool DirectoryController::retrieveDirEntry(DirEntry* entry, MemEvent* event, boo
     uint64_t deliveryTime = timestamp + accessLatency;
 
     // Bypass destination lookup 
-    memMsgQueue.insert(std::make_pair(deliveryTime, MemMsg(me, true)));
+    memMsgQueue.insert(deliveryTime, MemMsg(me, true));
 
     return true;
 }
@@ -2275,7 +2491,9 @@ void DirectoryController::cleanUpAfterResponse(MemEvent * event, bool inMSHR) {
 }
 
 void DirectoryController::updateCache(DirEntry * entry) { // TODO replace with a proper cache!
-    if (0 == entryCacheMaxSize) {
+    if (sparseSets != 0) {
+        return; // Sparse entries are never written to memory and free themselves once in I
+    } else if (0 == entryCacheMaxSize) {
         sendEntryToMemory(entry);
     } else {
         if (entry->cacheIter != entryCache.end()) {
@@ -2316,7 +2534,7 @@ void DirectoryController::sendEntryToMemory(DirEntry *entry) {
 
     uint64_t deliveryTime = timestamp + accessLatency;
     me->setDst(memLink->getTargetDestination(0));
-    memMsgQueue.insert(std::make_pair(deliveryTime, MemMsg(me, true)));
+    memMsgQueue.insert(deliveryTime, MemMsg(me, true));
 }
 
 /****************************
@@ -2374,10 +2592,10 @@ void DirectoryController::issueFetch(MemEvent* event, DirEntry* entry, Command c
 }
 
 void DirectoryController::issueInvalidations(MemEvent* event, DirEntry* entry, Command cmd) {
-    std::string rqstr = (event->getSrc());
+    uint32_t rqstr = SharerIDMap::findID(event->getSrcID());
 
-    for (set<std::string>::iterator it = entry->getSharers()->begin(); it != entry->getSharers()->end(); it++) {
-        if (*it == rqstr) continue;
+    for (SharerSet::iterator it = entry->getSharers()->begin(); it != entry->getSharers()->end(); it++) {
+        if (it.id() == rqstr) continue;
         issueInvalidation(*it, event, entry, cmd);
     }
 }
@@ -2490,8 +2708,8 @@ void DirectoryController::sendNACK(MemEvent * event) {
 void DirectoryController::sendOutgoingEvents() {
 
     bool debugLine = false;
-    while (!cpuMsgQueue.empty() && cpuMsgQueue.begin()->first <= timestamp) {
-        MemEventBase * ev = cpuMsgQueue.begin()->second;
+    while (cpuMsgQueue.ready(timestamp)) {
+        MemEventBase * ev = cpuMsgQueue.front();
 
         if (is_debug_event(ev)) {
             dbg.debug(_L4_, "E: %-20" PRIu64 " %-20" PRIu64 " %-20s Event:Send    (%s)\n",
@@ -2505,19 +2723,22 @@ void DirectoryController::sendOutgoingEvents() {
             startTimes.erase(ev->getResponseToID());
         }
         stat_eventSent[(int)ev->getCmd()]->addData(1);
+        if (ev->isTraced())
+            ev->addTraceStamp(LatencyTrace::Point::DirSend, getCurrentSimCycle());
+        flightRecorder.record(getCurrentSimCycle(), FlightRecorder::Send, ev);
         cpuLink->send(ev);
-        cpuMsgQueue.erase(cpuMsgQueue.begin());
+        cpuMsgQueue.pop();
     }
 
-    while (!memMsgQueue.empty() && memMsgQueue.begin()->first <= timestamp) {
-        MemEventBase * ev = memMsgQueue.begin()->second.event;
+    while (memMsgQueue.ready(timestamp)) {
+        MemEventBase * ev = memMsgQueue.front().event;
 
         if (is_debug_event(ev)) {
             dbg.debug(_L4_, "E: %-20" PRIu64 " %-20" PRIu64 " %-20s Event:Send    (%s)\n",
                     getCurrentSimCycle(), timestamp, getName().c_str(), ev->getBriefString().c_str());
         }
 
-        if (memMsgQueue.begin()->second.dirAccess) {
+        if (memMsgQueue.front().dirAccess) {
             if (ev->getCmd() == Command::GetS)
                 stat_dirEntryReads->addData(1);
             else
@@ -2525,8 +2746,11 @@ void DirectoryController::sendOutgoingEvents() {
         } else {
             stat_eventSent[(int)ev->getCmd()]->addData(1);
         }
+        if (ev->isTraced())
+            ev->addTraceStamp(LatencyTrace::Point::DirSend, getCurrentSimCycle());
+        flightRecorder.record(getCurrentSimCycle(), FlightRecorder::Send, ev);
         memLink->send(ev);
-        memMsgQueue.erase(memMsgQueue.begin());
+        memMsgQueue.pop();
     }
 
 }
@@ -2538,12 +2762,12 @@ void DirectoryController::forwardByAddress(MemEventBase * ev, Cycle_t ts, bool d
     std::string dst = memLink->findTargetDestination(ev->getRoutingAddress());
     if (dst != "") { /* Common case */
         ev->setDst(dst);
-        memMsgQueue.insert(std::make_pair(ts, MemMsg(ev, dirAccess)));
+        memMsgQueue.insert(ts, MemMsg(ev, dirAccess));
     } else {
         dst = cpuLink->findTargetDestination(ev->getRoutingAddress());
         if (dst != "") {
             ev->setDst(dst);
-            cpuMsgQueue.insert(std::make_pair(ts, ev));
+            cpuMsgQueue.insert(ts, ev);
         } else {
             std::string availableDests = "cpulink:\n" + cpuLink->getAvailableDestinationsAsString();
             if (cpuLink != memLink) availableDests = availableDests + "memlink:\n" + memLink->getAvailableDestinationsAsString();
@@ -2558,9 +2782,9 @@ void DirectoryController::forwardByAddress(MemEventBase * ev, Cycle_t ts, bool d
  */
 void DirectoryController::forwardByDestination(MemEventBase* ev, Cycle_t ts, bool dirAccess) {
     if (cpuLink->isReachable(ev->getDst())) {
-        cpuMsgQueue.insert(std::make_pair(ts, ev));
+        cpuMsgQueue.insert(ts, ev);
     } else if (memLink->isReachable(ev->getDst())) {
-        memMsgQueue.insert(std::make_pair(ts, MemMsg(ev, dirAccess)));
+        memMsgQueue.insert(ts, MemMsg(ev, dirAccess));
     } else {
         out.fatal(CALL_INFO, -1, "%s, Error: Destination %s appears unreachable on both links. Event: %s\n",
                 getName().c_str(), ev->getDst().c_str(), ev->getVerboseString(dlevel).c_str());
@@ -37,6 +37,10 @@
 #include "sst/elements/memHierarchy/memEvent.h"
 #include "sst/elements/memHierarchy/util.h"
 #include "sst/elements/memHierarchy/mshr.h"
+#include "sst/elements/memHierarchy/sharerSet.h"
+#include "sst/elements/memHierarchy/timingWheel.h"
+#include "sst/elements/memHierarchy/warmup.h"
+#include "sst/elements/memHierarchy/flightRecorder.h"
 
 using namespace std;
 
@@ -51,6 +55,8 @@ public:
     SST_ELI_DOCUMENT_PARAMS(
             {"clock",                   "Clock rate of controller.", "1GHz"},
             {"entry_cache_size",        "Size (in # of entries) the controller will cache.", "0"},
+            {"sparse_directory_sets",   "Number of sets in a sparse (set-associative) directory. 0 tracks every line that is cached anywhere. If non-zero, must be a power of two and entry_cache_size is ignored.", "0"},
+            {"sparse_directory_ways",   "Associativity of the sparse directory. When a set is full, the least-recently-used line is recalled (invalidated in all caches) to make room.", "8"},
             {"debug",                   "Where to send debug output. 0: No debugging, 1: STDOUT, 2: STDERR, 3: FILE.", "0"},
             {"debug_level",             "Debugging level: 0 to 10. Must configure sst-core with '--enable-debug'. 1=info, 2-10=debug output", "0"},
             {"debug_addr",              "(comma separated uint) Address(es) to be debugged. Leave empty for all, otherwise specify one or more, comma-separated values. Start and end string with brackets",""},
@@ -62,6 +68,11 @@ public:
             {"access_latency_cycles",   "Latency of directory access in cycles", "0"},
             {"mshr_latency_cycles",     "Latency of mshr access in cycles", "0"},
             {"max_requests_per_cycle",  "Maximum number of requests to process per cycle (0 or negative is unlimited)", "0"},
+            {"warmup",                  "(bool) Start in functional warmup: latencies are zero and request and MSHR limits are lifted until 'warmup_end' or the region of interest starts", "false"},
+            {"warmup_end",              "(string) Time at which warmup ends, with units (SI ok). Leave empty to end warmup only when the region of interest starts.", ""},
+            {"flight_recorder_size",    "(uint) Number of recent events to keep in the flight recorder (rounded up to a power of 2). 0 to disable.", "1024"},
+            {"flight_recorder_dir",     "(string) Directory to write the flight recorder to as '<dir>/<name>.flight' on a fatal error or the status dump signal (SIGUSR2)", "."},
+            {"flight_recorder_dump_at_finish", "(bool) Also write the flight recorder at the end of simulation", "false"},
             {"mem_addr_start",          "Starting memory address for the chunk of memory that this directory controller addresses.", "0"},
             {"addr_range_start",        "Lowest address handled by this directory.", "0"},
             {"addr_range_end",          "Highest address handled by this directory.", "uint64_t-1"},
@@ -87,6 +98,8 @@ public:
             {"get_request_latency",         "Total latency in ns of all get* requests handled",                 "nanoseconds",  1},
             {"directory_cache_hits",        "Number of requests that hit in the directory cache",               "requests",     1},
             {"mshr_hits",                   "Number of requests that hit in the MSHRs",                         "requests",     1},
+            {"sparse_recalls",              "Number of lines recalled from caches to free a sparse directory entry", "count",   1},
+            {"sparse_set_full_stalls",      "Number of requests that stalled because their sparse directory set was full", "count", 1},
             /* Event received */
             {"GetS_recv",           "Event received: GetS (read-shared)", "count", 1},
             {"GetX_recv",           "Event received: GetX (write-exclusive)", "count", 1},
@@ -174,6 +187,8 @@ private:
     Statistic<uint64_t> * stat_getRequestLatency;           // totalGetReqProcessTime;
     Statistic<uint64_t> * stat_cacheHits;                   // numCacheHits;
     Statistic<uint64_t> * stat_mshrHits;                    // mshrHits;
+    Statistic<uint64_t> * stat_sparseRecalls;
+    Statistic<uint64_t> * stat_sparseStalls;
     // Received events
     Statistic<uint64_t> * stat_eventRecv[(int)Command::LAST_CMD];
     Statistic<uint64_t> * stat_noncacheRecv[(int)Command::LAST_CMD];
@@ -202,6 +217,20 @@ private:
 
     void turnClockOn();
 
+    /* Functional warmup */
+    Warmup      warmup;
+    uint64_t    warmupAccessLatency;
+    uint64_t    warmupMSHRLatency;
+    int         warmupMaxRequestsPerCycle;
+    int         warmupMSHRSize;
+    void endWarmup();
+
+    /* Flight recorder */
+    FlightRecorder  flightRecorder;
+    std::string     flightRecorderDir;
+    bool            flightRecorderAtFinish;
+    void dumpFlightRecorder();
+
     bool arbitrateAccess(Addr addr);
 
     inline void recordStartLatency(MemEventBase* ev);
@@ -296,8 +325,8 @@ private:
         Addr                addr;           // block address
         State               state;          // state
         std::list<DirEntry*>::iterator cacheIter;
-	std::set<std::string> sharers;      // set of sharers for block
-        std::string         owner;          // Owner of block
+	SharerSet           sharers;        // set of sharers for block
+        uint32_t            owner;          // Owner of block (SharerIDMap ID)
 
         DirEntry(Addr a) {
             clearEntry();
@@ -310,7 +339,7 @@ private:
             cached = true;
             addr = 0;
             sharers.clear();
-            owner = "";
+            owner = SharerIDMap::NO_ID;
         }
 
         std::string getString() {
@@ -318,13 +347,13 @@ private:
             str << "State: " << StateString[state];
             str << " Sharers: [";
             bool comma = false;
-            for (std::set<std::string>::iterator it = sharers.begin(); it != sharers.end(); it++) {
+            for (SharerSet::iterator it = sharers.begin(); it != sharers.end(); it++) {
                 if (comma)
                     str << ",";
                 str << *it;
                 comma = true;
             }
-            str << "] Owner: " << owner;
+            str << "] Owner: " << getOwner();
             str << " Cached: " << (cached ? "y" : "n");
             return str.str();
         }
@@ -339,23 +368,23 @@ private:
 
         void clearSharers() { sharers.clear(); }
 
-        void addSharer(std::string shr) { sharers.insert(shr); }
+        void addSharer(const std::string &shr) { sharers.insert(shr); }
 
-        bool isSharer(std::string shr) { return sharers.find(shr) != sharers.end(); }
+        bool isSharer(const std::string &shr) { return sharers.contains(shr); }
 
         bool hasSharers() { return !(sharers.empty()); }
 
-        std::set<std::string>* getSharers() { return &sharers; }
+        SharerSet* getSharers() { return &sharers; }
 
-        void removeSharer(std::string shr) { sharers.erase(shr); }
+        void removeSharer(const std::string &shr) { sharers.erase(shr); }
 
-        std::string getOwner() { return owner; }
+        const std::string& getOwner() { return SharerIDMap::getName(owner); }
 
-        bool hasOwner() { return owner != ""; }
+        bool hasOwner() { return owner != SharerIDMap::NO_ID; }
 
-        void removeOwner() { owner = ""; }
+        void removeOwner() { owner = SharerIDMap::NO_ID; }
 
-        void setOwner(std::string own) { owner = own; }
+        void setOwner(const std::string &own) { owner = own.empty() ? SharerIDMap::NO_ID : SharerIDMap::getID(own); }
 
         void setState(State nState) { state = nState; }
 
@@ -366,6 +395,11 @@ private:
     void printDebugInfo();
 
     DirEntry* getDirEntry(Addr addr); // find entry in the master list
+    DirEntry* findSparseEntry(Addr addr);   // nullptr if addr is not tracked
+    uint8_t peekEntryState(Addr addr);      // Entry state without allocating or touching LRU, NO_STATE if not tracked
+    DirEntry* allocateSparseEntry(Addr addr);
+    bool reserveSparseEntry(MemEvent* event);
+    void recallSparseEntry(uint64_t set);
     bool retrieveDirEntry(DirEntry* entry, MemEvent* event, bool inMSHR); // Simulate fetching entry from memory
 
     MemEventStatus allocateMSHR(MemEvent* event, bool fwdReq, int pos = -1);
@@ -407,8 +441,8 @@ private:
     void forwardByDestination(MemEventBase* ev, Cycle_t timestamp, bool dirAccess = false);
     void forwardByAddress(MemEventBase* ev, Cycle_t timestamp, bool dirAccess = false);
 
-    std::multimap<uint64_t,MemEventBase*>   cpuMsgQueue;
-    std::multimap<uint64_t,MemMsg>   memMsgQueue;
+    TimingWheel<MemEventBase*>  cpuMsgQueue;
+    TimingWheel<MemMsg>         memMsgQueue;
 
     uint64_t    entryCacheMaxSize;
     uint64_t    entryCacheSize;
@@ -430,6 +464,25 @@ private:
 
     std::set<std::string> incoherentSrc;
 
+    /*
+     * Sparse directory
+     * A fixed-size set-associative array of entries stored contiguously
+     * (index = set * ways + way). Tags are mirrored in their own array for
+     * lookup. An entry in I with no MSHR activity is free. A request for an
+     * untracked line in a full set stalls while the LRU stable (S/M) entry
+     * is recalled with an internal FetchInv.
+     */
+    static constexpr Addr NO_ADDR = (Addr)-1;
+    uint64_t sparseSets;    // 0 if sparse mode is off
+    uint64_t sparseWays;
+    std::vector<DirEntry> sparseEntries;
+    std::vector<Addr> sparseTags;
+    std::vector<uint64_t> sparseLRU;
+    std::vector<bool> sparseRecallPending;  // One recall in flight per set
+    uint64_t sparseTimestamp;
+    std::set<SST::Event::id_type> sparseRecalls;
+    std::set<SST::Event::id_type> sparseStalled;    // Requests counted in sparse_set_full_stalls and still waiting
+
 };
 
 }
@@ -27,7 +27,7 @@ uint64_t DMACommand::main_id = 0;
 DMAEngine::DMAEngine(ComponentId_t id, Params &params) :
     Component(id)
 {
-    dbg.init("@t:DMAEngine::@p():@l " + getName() + ": ", 0, 0,
+    dbg.init("@t:DMAEngine::@p():@l " + getName() + ": ", params.find<int>("debug_level", 0), 0,
             (Output::output_location_t)params.find<int>("debug", 0));
     statsOutputTarget = (Output::output_location_t)params.find<int>("printStats", 0);
 
@@ -36,47 +36,38 @@ DMAEngine::DMAEngine(ComponentId_t id, Params &params) :
     commandLink = configureLink("cmdLink", tc, NULL);
     if ( NULL == commandLink ) dbg.fatal(CALL_INFO, 1, "Missing cmdLink\n");
 
-    if ( !isPortConnected("netLink") ) dbg.fatal(CALL_INFO, 1, "Missing netLink\n");
-/*
-    MemNIC::ComponentInfo myInfo;
-    myInfo.link_port = "netLink";
-    myInfo.link_bandwidth = "1GiB/s";
-	myInfo.num_vcs = params.find<int>("network_num_vc", 1);
-    myInfo.name = getName();
-    myInfo.type = MemNIC::TypeDMAEngine;
-    networkLink = new MemNIC(this, &dbg, -1, myInfo);
-*/
+    memory = loadUserSubComponent<Interfaces::StandardMem>("memory", ComponentInfo::SHARE_NONE, tc,
+            new Interfaces::StandardMem::Handler<DMAEngine>(this, &DMAEngine::handleEvent));
+    if ( !memory ) dbg.fatal(CALL_INFO, 1, "Unable to load a StandardMem interface; check that the 'memory' slot is filled in the input\n");
+    handlers = new DMAHandlers(this, &dbg);
+
+    pipelined = params.find<bool>("pipelined", false);
+    maxOutstanding = params.find<uint64_t>("max_outstanding", 16);
+    maxRequestSize = params.find<uint64_t>("max_request_size", 0);
+    requestsPerCycle = params.find<uint64_t>("requests_per_cycle", 1);
+    if ( maxOutstanding == 0 ) dbg.fatal(CALL_INFO, 1, "Invalid param: max_outstanding must be at least 1\n");
+    if ( requestsPerCycle == 0 ) dbg.fatal(CALL_INFO, 1, "Invalid param: requests_per_cycle must be at least 1\n");
+    pending = AddrHashTable<Pending>(maxOutstanding);
+
     blocksize = 0;
+    numTransfers = 0;
+    bytesTransferred = 0;
+    numRequests = 0;
 }
 
 
 void DMAEngine::init(unsigned int phase)
 {
-    networkLink->init(phase);
+    memory->init(phase);
 }
 
 
 void DMAEngine::setup(void)
 {
-    networkLink->setup();
-    bool blocksizeSet = false;
-
-/*    const std::vector<MemNIC::PeerInfo_t> &peers = networkLink->getPeerInfo();
-    for ( std::vector<MemNIC::PeerInfo_t>::const_iterator i = peers.begin() ; i != peers.end() ; ++i ) {
-        switch (i->first.type) {
-        case MemNIC::TypeDirectoryCtrl:
-            break;
-        case MemNIC::TypeCache:
-            if ( !blocksizeSet ) {
-                blocksize = i->second.blocksize;
-                blocksizeSet = true;
-            }
-        default:
-            ;
-        }
-    }
-
-    networkLink->clearPeerInfo();*/
+    memory->setup();
+    blocksize = memory->getLineSize();
+    if ( blocksize == 0 ) blocksize = 64;   // No caches below us
+    if ( maxRequestSize == 0 ) maxRequestSize = blocksize;
 }
 
 
@@ -85,50 +76,46 @@ void DMAEngine::finish(void)
     Output out("", 0, 0, statsOutputTarget);
     out.output("DMA Controller %s stats:\n"
             "\t # Transfers:        %" PRIu64 "\n"
+            "\t # Requests:         %" PRIu64 "\n"
             "\t Bytes Transferred:  %" PRIu64 "\n",
             getName().c_str(),
             numTransfers,
+            numRequests,
             bytesTransferred);
 }
 
 
 bool DMAEngine::clock(Cycle_t cycle)
 {
-    /* Process Network
-     * Check Command link
+    /* Check Command link
      * If new command, check overlap, and delay if needed, otherwise process
+     * Issue reads for active commands, oldest first
+     * Responses are handled as they arrive
      */
 
-    //networkLink->clock();
-
-    MemEventBase *me = NULL;
     SST::Event *se = NULL;
 
-//    while ( NULL != (me = networkLink->recv()) ) {
-        /* Process network packet */
-/*        Request* req = findRequest(me->getResponseToID());
-#ifdef __SST_DEBUG_OUTPUT__
-        if ( NULL == req ) {
-            dbg.debug(_L10_, "Received Packet for which we have no response ID waiting.  ID received: (%" PRIx64 ", %d)\n", me->getResponseToID().first, me->getResponseToID().second);
-        }
-#endif
-        processPacket(req, me);
-    }
-*/
-
     while ( NULL != (se = commandLink->recv()) ) {
         /* Process new commands */
         DMACommand* cmd = static_cast<DMACommand*>(se);
         commandQueue.push_back(cmd);
     }
 
-    /* See if we can process the next command */
-    if ( !commandQueue.empty() ) {
+    /* See if we can process the next command(s) */
+    while ( !commandQueue.empty() ) {
         DMACommand *cmd = commandQueue.front();
-        if ( isIssuable(cmd) ) {
-            commandQueue.pop_front();
-            Request *req = new Request(cmd);
-            startRequest(req);
+        if ( !(pipelined || activeRequests.empty()) || !isIssuable(cmd) )
+            break;
+        commandQueue.pop_front();
+        startRequest(new Request(cmd));
+    }
+
+    uint64_t issued = 0;
+    for ( size_t i = 0 ; i < activeRequests.size() && issued < requestsPerCycle ; i++ ) {
+        Request *req = activeRequests[i];
+        while ( req->nextChunk < req->numChunks && pending.size() < maxOutstanding && issued < requestsPerCycle ) {
+            issueRead(req);
+            issued++;
         }
     }
 
@@ -140,7 +127,7 @@ bool DMAEngine::isIssuable(DMACommand *cmd) const
 {
     bool isOK = true;
     /* Cycle through current requests.  If any overlap, then we should wait. */
-    for ( std::set<Request*>::iterator i = activeRequests.begin() ; isOK && i != activeRequests.end() ; ++i ) {
+    for ( std::vector<Request*>::const_iterator i = activeRequests.begin() ; isOK && i != activeRequests.end() ; ++i ) {
         Request *req = (*i);
         isOK = !findOverlap(req->command, cmd);
     }
@@ -149,66 +136,140 @@ bool DMAEngine::isIssuable(DMACommand *cmd) const
 }
 
 
+/* Bytes in the chunk at 'offset'. A chunk does not cross a maxRequestSize boundary at src or dst. */
+uint64_t DMAEngine::chunkSize(Request *req, Addr offset) const
+{
+    uint64_t size = req->getSize() - offset;
+    uint64_t srcRoom = maxRequestSize - ((req->getSrc() + offset) % maxRequestSize);
+    uint64_t dstRoom = maxRequestSize - ((req->getDst() + offset) % maxRequestSize);
+    if ( srcRoom < size ) size = srcRoom;
+    if ( dstRoom < size ) size = dstRoom;
+    return size;
+}
+
+
 void DMAEngine::startRequest(Request *req)
 {
-    assert(0);
-    /*  Needs to be updated with current MemHierarchy Commands/States, MemHierarchyInterface
-    dbg.debug(_L10_, "Received request to transfer from %#" PRIx64 " to 0x%" PRIx64 "\n",
-            req->getSrc(), req->getDst());
+    dbg.debug(_L10_, "Received request to transfer %zu bytes from %#" PRIx64 " to 0x%" PRIx64 "\n",
+            req->getSize(), req->getSrc(), req->getDst());
     ++numTransfers;
-    Addr ptr = req->getSrc();
-    while ( ptr < (req->getSrc() + req->getSize()) ) {
-        MemEvent *ev = new MemEvent(this, ptr, ptr, GetS);
-        ev->setSize(blocksize);
-        ev->setFlag(MemEvent::F_NONCACHEABLE);
-        ev->setDst(networkLink->findTargetDestination(ptr));
-        req->loadKeys.insert(ev->getID());
-        networkLink->send(ev);
-        ptr += blocksize;
+
+    for ( Addr offset = 0 ; offset < req->getSize() ; offset += chunkSize(req, offset) )
+        req->numChunks++;
+    req->done.assign((req->numChunks + 63) / 64, 0);
+
+    activeRequests.push_back(req);
+    if ( req->numChunks == 0 )
+        finishRequest(req);
+}
+
+
+void DMAEngine::issueRead(Request *req)
+{
+    uint64_t size = chunkSize(req, req->nextOffset);
+    Interfaces::StandardMem::Read *rd = new Interfaces::StandardMem::Read(req->getSrc() + req->nextOffset, size);
+    rd->setNoncacheable();
+
+    Pending &p = pending.insert(rd->getID());
+    p.req = req;
+    p.chunk = req->nextChunk;
+    p.offset = req->nextOffset;
+
+    req->nextChunk++;
+    req->nextOffset += size;
+    numRequests++;
+    memory->send(rd);
+}
+
+
+void DMAEngine::handleEvent(Interfaces::StandardMem::Request *ev)
+{
+    ev->handle(handlers);
+}
+
+
+void DMAEngine::DMAHandlers::handle(Interfaces::StandardMem::ReadResp *resp)
+{
+    dma->handleReadResp(resp);
+}
+
+
+void DMAEngine::DMAHandlers::handle(Interfaces::StandardMem::WriteResp *resp)
+{
+    dma->handleWriteResp(resp);
+}
+
+
+/* A chunk has been read, write it. The write takes over the read's place in the window. */
+void DMAEngine::handleReadResp(Interfaces::StandardMem::ReadResp *resp)
+{
+    Pending *rd = pending.find(resp->getID());
+    if ( NULL == rd ) {
+        dbg.fatal(CALL_INFO, 1, "Received ReadResp for which we have no request waiting. ID: %" PRIu64 "\n", resp->getID());
     }
-    activeRequests.insert(req);
-    */
+    Request *req = rd->req;
+    uint64_t chunk = rd->chunk;
+    Addr offset = rd->offset;
+    pending.erase(resp->getID());
+
+    Interfaces::StandardMem::Write *wr = new Interfaces::StandardMem::Write(req->getDst() + offset, resp->size, std::move(resp->data));
+    wr->setNoncacheable();
+
+    Pending &p = pending.insert(wr->getID());
+    p.req = req;
+    p.chunk = chunk;
+    p.offset = offset;
+
+    numRequests++;
+    memory->send(wr);
+    delete resp;
 }
 
 
-void DMAEngine::processPacket(Request *req, MemEventBase *ev)
+void DMAEngine::handleWriteResp(Interfaces::StandardMem::WriteResp *resp)
 {
-    assert(0);
-    /*  Needs to be updated with current MemHierarchy Commands/States, MemHierarchyInterface
-    if ( ev->getCmd() == GetSResp) {
-        if ( !req->loadKeys.count(ev->getResponseToID()) ) {
-            dbg.fatal(CALL_INFO, 1, "Received GetSResp, but we don't have a corresponding request in loadKeys!\n");
-        }
-        size_t offset = ev->getAddr() - req->getSrc();
-        req->loadKeys.erase(ev->getResponseToID());
-        MemEvent *storeEV = new MemEvent(this, (req->getDst() + offset), (req->getDst() + offset), GetX);
-        storeEV->setFlag(MemEvent::F_NONCACHEABLE);
-        storeEV->setPayload(ev->getPayload());
-        storeEV->setDst(networkLink->findTargetDestination(req->getDst() + offset));
-        req->storeKeys.insert(storeEV->getID());
-        networkLink->send(storeEV);
-    } else if ( ev->getCmd() == GetXResp ) {
-        bytesTransferred += ev->getSize();
-        req->storeKeys.erase(ev->getResponseToID());
-        if ( req->storeKeys.empty() ) {
-            // Done with this request.
-            activeRequests.erase(req);
-            commandLink->send(req->command);
-            dbg.debug(_L10_, "Request to transfer 0x%" PRIx64 " to 0x%" PRIx64 " is complete.\n", req->getSrc(), req->getDst());
-            delete req;
+    Pending *wr = pending.find(resp->getID());
+    if ( NULL == wr ) {
+        dbg.fatal(CALL_INFO, 1, "Received WriteResp for which we have no request waiting. ID: %" PRIu64 "\n", resp->getID());
+    }
+    Request *req = wr->req;
+    uint64_t chunk = wr->chunk;
+    pending.erase(resp->getID());
+
+    uint64_t bit = (uint64_t)1 << (chunk % 64);
+    if ( req->done[chunk / 64] & bit ) {
+        dbg.fatal(CALL_INFO, 1, "Received a second WriteResp for chunk %" PRIu64 " of the transfer from 0x%" PRIx64 " to 0x%" PRIx64 "\n",
+                chunk, req->getSrc(), req->getDst());
+    }
+    req->done[chunk / 64] |= bit;
+    req->chunksDone++;
+    bytesTransferred += resp->size;
+    delete resp;
+
+    if ( req->chunksDone == req->numChunks )
+        finishRequest(req);
+}
+
+
+void DMAEngine::finishRequest(Request *req)
+{
+    // Done with this request.
+    for ( std::vector<Request*>::iterator i = activeRequests.begin() ; i != activeRequests.end() ; ++i ) {
+        if ( *i == req ) {
+            activeRequests.erase(i);
+            break;
         }
-    } else {
-	dbg.fatal(CALL_INFO, 1, "Received unexpected message %s 0x%" PRIx64 " from %s\n", CommandString[ev->getCmd()], ev->getAddr(), ev->getSrc().c_str());
     }
-    */
+    commandLink->send(req->command);
+    dbg.debug(_L10_, "Request to transfer 0x%" PRIx64 " to 0x%" PRIx64 " is complete.\n", req->getSrc(), req->getDst());
+    delete req;
 }
 
 
-/* Returns true if there is overlap */
+/* Returns true if either command writes memory that the other accesses */
 bool DMAEngine::findOverlap(DMACommand *c1, DMACommand *c2) const
 {
-    return (findOverlap(c1->src, c1->size, c2->src, c2->size) ||
-            findOverlap(c1->src, c1->size, c2->dst, c2->size) ||
+    return (findOverlap(c1->src, c1->size, c2->dst, c2->size) ||
             findOverlap(c1->dst, c1->size, c2->src, c2->size) ||
             findOverlap(c1->dst, c1->size, c2->dst, c2->size));
 }
@@ -220,18 +281,5 @@ bool DMAEngine::findOverlap(Addr a1, size_t s1, Addr a2, size_t s2) const
     Addr end1 = a1 + s1;
     Addr end2 = a2 + s2;
 
-    return (( a1 <= end2 ) || ( a2 <= end1 ));
-}
-
-
-DMAEngine::Request* DMAEngine::findRequest(SST::Event::id_type id)
-{
-    for ( std::set<Request*>::iterator i = activeRequests.begin() ; i != activeRequests.end() ; ++i ) {
-        Request *req = (*i);
-        if ( req->loadKeys.count(id) || req->storeKeys.count(id) )
-            return req;
-    }
-    return NULL;
+    return (( a1 < end2 ) && ( a2 < end1 ));
 }
-
-
@@ -18,15 +18,18 @@
 
 
 
+#include <deque>
 #include <vector>
 
 #include <sst/core/event.h>
 #include <sst/core/component.h>
 #include <sst/core/link.h>
 #include <sst/core/output.h>
+#include <sst/core/interfaces/stdMem.h>
 
-#include "sst/elements/memHierarchy/memEvent.h"
-#include "sst/elements/memHierarchy/memNIC.h"
+#include "sst/elements/memHierarchy/util.h"
+#include "sst/elements/memHierarchy/memTypes.h"
+#include "sst/elements/memHierarchy/addrHashTable.h"
 
 
 namespace SST {
@@ -53,50 +56,105 @@ private:
 };
 
 
+/*
+ * DMA Engine
+ *
+ * Copies 'size' bytes from 'src' to 'dst' for each DMACommand received on
+ * cmdLink, and returns the command on cmdLink when the copy is complete.
+ *
+ * A copy is split into chunks that are each moved with one read and one
+ * write. A chunk is at most 'max_request_size' bytes and does not cross a
+ * 'max_request_size'-aligned boundary at either the source or the
+ * destination, so with the default (the line size) every request stays
+ * within one line. The write for a chunk is issued as soon as its read
+ * returns, so reads and writes overlap, and at most 'max_outstanding'
+ * requests are in flight. In pipelined mode, commands that do not overlap
+ * in memory are processed at the same time and share that window.
+ * Otherwise commands are processed one at a time.
+ */
 class DMAEngine : public Component {
 public:
 /* Element Library Info */
-   /* SST_ELI_REGISTER_COMPONENT(DMAEngine, "memHierarchy", "DMAEngine", SST_ELI_ELEMENT_VERSION(1,0,0),
+    SST_ELI_REGISTER_COMPONENT(DMAEngine, "memHierarchy", "DMAEngine", SST_ELI_ELEMENT_VERSION(1,0,0),
             "DMA Engine", COMPONENT_CATEGORY_MEMORY)
 
     SST_ELI_DOCUMENT_PARAMS(
-            {"debug",           "0 (default): No debugging, 1: STDOUT, 2: STDERR, 3: FILE.", "0"},
-            {"debug_level",     "Debugging level: 0 to 10", "0"},
-            {"clockRate",       "Clock Rate for processing DMAs.", "1GHz"},
-            {"netAddr",         "Network address of component.", NULL},
-            {"network_num_vc",  "DEPRECATED. Number of virtual channels (VCs) on the on-chip network. memHierarchy only uses one VC.", "1"},
-            {"printStats",      "0 (default): Don't print, 1: STDOUT, 2: STDERR, 3: FILE.", "0"} )
-
-    SST_ELI_DOCUMENT_PORTS( {"netLink", "Network Link", {"memHierarchy.MemRtrEvent"} } )
-*/
+            {"debug",               "0 (default): No debugging, 1: STDOUT, 2: STDERR, 3: FILE.", "0"},
+            {"debug_level",         "Debugging level: 0 to 10", "0"},
+            {"clockRate",           "Clock Rate for processing DMAs.", "1GHz"},
+            {"printStats",          "0 (default): Don't print, 1: STDOUT, 2: STDERR, 3: FILE.", "0"},
+            {"pipelined",           "(bool) Process commands that do not overlap in memory at the same time. If false, commands are processed one at a time.", "false"},
+            {"max_outstanding",     "(uint) Maximum number of reads and writes in flight, across all commands", "16"},
+            {"max_request_size",    "(uint) Largest read or write to issue, in bytes. Contiguous lines are coalesced into requests of up to this size. "
+                                    "Set it above the line size only if the memory system handles noncacheable requests that span lines (e.g., DMA directly to a memory controller). 0: the line size.", "0"},
+            {"requests_per_cycle",  "(uint) Maximum number of reads to issue per cycle", "1"} )
+
+    SST_ELI_DOCUMENT_PORTS( {"cmdLink", "Link to the component that sends DMACommands", {"memHierarchy.DMACommand"} } )
+
+    SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS( {"memory", "Interface to the memory hierarchy", "SST::Interfaces::StandardMem"} )
+
 /* Begin class definition */
 private:
     struct Request {
         DMACommand *command;
-        std::set<SST::Event::id_type> loadKeys;
-        std::set<SST::Event::id_type> storeKeys;
+        uint64_t numChunks;
+        uint64_t nextChunk;         // Next chunk to read
+        Addr nextOffset;            // Offset of the next chunk from src/dst
+        uint64_t chunksDone;
+        std::vector<uint64_t> done; // Bitmap, one bit per chunk, set when the chunk has been written
 
         Addr getDst() const { return command->dst; }
         Addr getSrc() const { return command->src; }
         size_t getSize() const { return command->size; }
 
         Request(DMACommand *cmd) :
-            command(cmd)
+            command(cmd), numChunks(0), nextChunk(0), nextOffset(0), chunksDone(0)
         { }
     };
 
+    /* A read or write in flight, by StandardMem request ID */
+    struct Pending {
+        Request *req;
+        uint64_t chunk;
+        Addr offset;
+
+        Pending() { reset(); }
+        void reset() {
+            req = nullptr;
+            chunk = 0;
+            offset = 0;
+        }
+    };
+
+    class DMAHandlers : public Interfaces::StandardMem::RequestHandler {
+    public:
+        DMAHandlers(DMAEngine* dma, SST::Output* out) : Interfaces::StandardMem::RequestHandler(out), dma(dma) {}
+        virtual ~DMAHandlers() {}
+        virtual void handle(Interfaces::StandardMem::ReadResp* resp) override;
+        virtual void handle(Interfaces::StandardMem::WriteResp* resp) override;
+    private:
+        DMAEngine* dma;
+    };
+
     std::deque<DMACommand*> commandQueue;
-    std::set<Request*> activeRequests;
+    std::vector<Request*> activeRequests;   // Oldest first
+    AddrHashTable<Pending> pending;
 
     Output dbg;
     uint64_t blocksize;
+    uint64_t maxRequestSize;
+    uint64_t maxOutstanding;
+    uint64_t requestsPerCycle;
+    bool pipelined;
     Output::output_location_t statsOutputTarget;
     uint64_t numTransfers;
     uint64_t bytesTransferred;
+    uint64_t numRequests;
 
 
     Link *commandLink;
-    MemNIC *networkLink;
+    Interfaces::StandardMem *memory;
+    DMAHandlers *handlers;
 
 public:
     DMAEngine(ComponentId_t id, Params& params);
@@ -107,15 +165,18 @@ public:
 
 private:
     bool clock(Cycle_t cycle);
+    void handleEvent(Interfaces::StandardMem::Request *ev);
 
     bool isIssuable(DMACommand *cmd) const;
     void startRequest(Request *req);
-    void processPacket(Request *req, MemEventBase *ev);
+    void issueRead(Request *req);
+    void handleReadResp(Interfaces::StandardMem::ReadResp *resp);
+    void handleWriteResp(Interfaces::StandardMem::WriteResp *resp);
+    void finishRequest(Request *req);
+    uint64_t chunkSize(Request *req, Addr offset) const;
 
     bool findOverlap(DMACommand *c1, DMACommand *c2) const;
     bool findOverlap(Addr a1, size_t s1, Addr a2, size_t s2) const;
-    Request* findRequest(SST::Event::id_type id);
-    //std::string findTargetDirectory(Addr addr); Moved to MemNIC
 };
 
 }
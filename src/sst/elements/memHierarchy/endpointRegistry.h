@@ -0,0 +1,236 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_ENDPOINTREGISTRY_H
+#define MEMHIERARCHY_ENDPOINTREGISTRY_H
+
+#include <sst/core/output.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace SST { namespace MemHierarchy {
+
+typedef uint32_t EndpointID;
+
+/*
+ * Registry of memH endpoint names
+ *
+ * Events carry a 32-bit endpoint ID for src/dst/rqstr instead of a name.
+ * IDs are dense: each new name gets the next ID the first time it is seen
+ * in this process, which is during construction or init() for every
+ * endpoint, so per-endpoint tables (NIC address maps, sharer indices) can
+ * be plain vectors indexed by ID.
+ *
+ * IDs are only meaningful within a process. Each name also has a wire ID,
+ * a 32-bit hash of the name that is the same on every rank, and events
+ * that cross ranks serialize wire IDs. Init events serialize names
+ * instead, so ranks learn each other's names during init. A wire ID that
+ * arrives before its name (e.g., the requestor of an event passing through
+ * a rank) gets a placeholder ID, which is kept when the name is registered.
+ * Two names with the same wire ID on one rank are a fatal error.
+ *
+ * The process-wide table is locked; each thread keeps an unlocked cache in
+ * front of it so steady-state lookups do not contend.
+ */
+class EndpointRegistry {
+    public:
+        /* ID of "" */
+        static constexpr EndpointID NO_ENDPOINT = 0;
+
+        /* Return the ID for 'name', registering the name if it is new */
+        static EndpointID getID(const std::string &name) {
+            if (name.empty()) return NO_ENDPOINT;
+            Local &l = local();
+            std::unordered_map<std::string,EndpointID>::const_iterator it = l.ids.find(name);
+            if (it != l.ids.end())
+                return it->second;
+            EndpointID id = registerName(name);
+            l.ids.insert(std::make_pair(name, id));
+            return id;
+        }
+
+        /* Return the name for 'id' */
+        static const std::string& getName(EndpointID id) {
+            Local &l = local();
+            if (id < l.names.size() && l.names[id])
+                return *(l.names[id]);
+            bool placeholder;
+            const std::string* name = findName(id, placeholder);
+            if (placeholder)
+                return *name;   // Not cached; the name may still be registered
+            if (id >= l.names.size())
+                l.names.resize(id + 1, nullptr);
+            l.names[id] = name;
+            return *name;
+        }
+
+        /* Return the rank-independent ID for 'id', used when events are serialized */
+        static uint32_t getWireID(EndpointID id) {
+            if (id == NO_ENDPOINT) return NO_WIRE_ID;
+            Local &l = local();
+            if (id < l.wire.size() && l.wire[id] != NO_WIRE_ID)
+                return l.wire[id];
+            uint32_t wire = findWireID(id);
+            if (id >= l.wire.size())
+                l.wire.resize(id + 1, NO_WIRE_ID);
+            l.wire[id] = wire;
+            return wire;
+        }
+
+        /* Return the ID for a wire ID received from another rank */
+        static EndpointID fromWireID(uint32_t wire) {
+            if (wire == NO_WIRE_ID) return NO_ENDPOINT;
+            Local &l = local();
+            std::unordered_map<uint32_t,EndpointID>::const_iterator it = l.fromWire.find(wire);
+            if (it != l.fromWire.end())
+                return it->second;
+            EndpointID id = registerWireID(wire);
+            l.fromWire.insert(std::make_pair(wire, id));
+            return id;
+        }
+
+        /* Wire ID of 'name': 32-bit FNV-1a, with 0 reserved for "" */
+        static uint32_t hashName(const std::string &name) {
+            if (name.empty()) return NO_WIRE_ID;
+            uint32_t hash = 2166136261u;
+            for (char c : name) {
+                hash ^= (uint8_t)c;
+                hash *= 16777619u;
+            }
+            return hash == NO_WIRE_ID ? 1 : hash;
+        }
+
+        /* One more than the largest ID assigned so far */
+        static size_t size() {
+            Global &g = global();
+            std::lock_guard<std::mutex> guard(g.lock);
+            return g.names.size();
+        }
+
+    private:
+        static constexpr uint32_t NO_WIRE_ID = 0;
+
+        struct Global {
+            std::mutex lock;
+            std::deque<std::string> strings;            // Deque so pointers handed out stay valid
+            std::vector<const std::string*> names;      // Indexed by ID
+            std::vector<uint32_t> wire;                 // Indexed by ID
+            std::vector<bool> placeholder;              // Indexed by ID; true until the name is registered
+            std::unordered_map<std::string,EndpointID> ids;
+            std::unordered_map<uint32_t,EndpointID> fromWire;
+            Global() {
+                strings.push_back("");
+                names.push_back(&strings.back());
+                wire.push_back(NO_WIRE_ID);
+                placeholder.push_back(false);
+            }
+
+            EndpointID add(const std::string &name, uint32_t wireID, bool isPlaceholder) {
+                EndpointID id = names.size();
+                strings.push_back(name);
+                names.push_back(&strings.back());
+                wire.push_back(wireID);
+                placeholder.push_back(isPlaceholder);
+                fromWire.insert(std::make_pair(wireID, id));
+                return id;
+            }
+        };
+
+        struct Local {
+            std::unordered_map<std::string,EndpointID> ids;
+            std::vector<const std::string*> names;
+            std::vector<uint32_t> wire;
+            std::unordered_map<uint32_t,EndpointID> fromWire;
+        };
+
+        static Global& global() {
+            static Global g;
+            return g;
+        }
+
+        static Local& local() {
+            static thread_local Local l;
+            return l;
+        }
+
+        static EndpointID registerName(const std::string &name) {
+            Global &g = global();
+            std::lock_guard<std::mutex> guard(g.lock);
+            std::unordered_map<std::string,EndpointID>::const_iterator it = g.ids.find(name);
+            if (it != g.ids.end())
+                return it->second;
+            uint32_t wireID = hashName(name);
+            EndpointID id;
+            std::unordered_map<uint32_t,EndpointID>::const_iterator wit = g.fromWire.find(wireID);
+            if (wit == g.fromWire.end()) {
+                id = g.add(name, wireID, false);
+            } else if (g.placeholder[wit->second]) {
+                id = wit->second;
+                g.strings.push_back(name);
+                g.names[id] = &g.strings.back();
+                g.placeholder[id] = false;
+            } else {
+                Output out("", 1, 0, Output::STDOUT);
+                out.fatal(CALL_INFO, -1, "EndpointRegistry: Error - endpoint names '%s' and '%s' have the same wire ID (0x%08" PRIx32 "). Rename one of them.\n",
+                        name.c_str(), g.names[wit->second]->c_str(), wireID);
+            }
+            g.ids.insert(std::make_pair(name, id));
+            return id;
+        }
+
+        static EndpointID registerWireID(uint32_t wireID) {
+            Global &g = global();
+            std::lock_guard<std::mutex> guard(g.lock);
+            std::unordered_map<uint32_t,EndpointID>::const_iterator it = g.fromWire.find(wireID);
+            if (it != g.fromWire.end())
+                return it->second;
+            char name[32];
+            snprintf(name, sizeof(name), "endpoint:0x%08" PRIx32, wireID);
+            return g.add(name, wireID, true);
+        }
+
+        static const std::string* findName(EndpointID id, bool &placeholder) {
+            Global &g = global();
+            std::lock_guard<std::mutex> guard(g.lock);
+            checkID(g, id);
+            placeholder = g.placeholder[id];
+            return g.names[id];
+        }
+
+        static uint32_t findWireID(EndpointID id) {
+            Global &g = global();
+            std::lock_guard<std::mutex> guard(g.lock);
+            checkID(g, id);
+            return g.wire[id];
+        }
+
+        static void checkID(Global &g, EndpointID id) {
+            if (id >= g.names.size()) {
+                Output out("", 1, 0, Output::STDOUT);
+                out.fatal(CALL_INFO, -1, "EndpointRegistry: Error - endpoint ID %" PRIu32 " was never assigned. Only %zu endpoints are registered.\n",
+                        id, g.names.size());
+            }
+        }
+};
+
+}}
+#endif // MEMHIERARCHY_ENDPOINTREGISTRY_H
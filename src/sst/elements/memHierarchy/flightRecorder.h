@@ -0,0 +1,168 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_FLIGHTRECORDER_H
+#define MEMHIERARCHY_FLIGHTRECORDER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ * One flight recorder entry. Commands and states are the memHierarchy
+ * Command and State values; src and dst are EndpointIDs. The names for all
+ * of these are written to the dump, so the decoder does not depend on them.
+ */
+struct FlightRecord {
+    uint64_t cycle;     // Simulation time in core cycles
+    uint64_t addr;      // Base address, 0 for events without one
+    uint32_t src;
+    uint32_t dst;
+    uint32_t event;     // Low 32 bits of the event's unique ID
+    uint16_t cmd;
+    uint8_t  state;     // Line or directory entry state, NO_STATE if not recorded
+    uint8_t  action;
+};
+
+/*
+ * Fixed-size ring of recent events in a cache, directory, or memory
+ * controller
+ *
+ * Recording stores one 32-byte entry in a power-of-two ring and never
+ * allocates or formats anything, so the recorder can stay on in production
+ * runs. A component dumps the ring on a fatal error, on the status signal
+ * (SIGUSR2), and, if asked, at the end of simulation. The dump is read by
+ * sst-memh-flightdecode (tools/flightdecode).
+ *
+ * Dump format, all values in host byte order:
+ *   "MHFR", uint32 version (1)
+ *   string component name, uint64 dump cycle
+ *   uint32 command name count, then that many strings
+ *   uint32 state name count, then that many strings
+ *   uint32 endpoint count, then that many (uint32 id, string name) pairs
+ *   uint32 record count, then that many FlightRecords, oldest first
+ * A string is a uint32 length followed by its characters.
+ */
+class FlightRecorder {
+public:
+    enum Action : uint8_t { Recv, Handle, Stall, Send };
+
+    static const uint8_t NO_STATE = 0xff;
+    static const uint32_t VERSION = 1;
+
+    FlightRecorder() : mask_(0), count_(0) { }
+
+    /* Keep the last 'size' events, rounded up to a power of two. 0 disables the recorder. */
+    void init(size_t size) {
+        ring_.clear();
+        mask_ = 0;
+        count_ = 0;
+        if (size == 0)
+            return;
+        size_t n = 1;
+        while (n < size) n <<= 1;
+        ring_.resize(n);
+        mask_ = n - 1;
+    }
+
+    bool enabled() const { return !ring_.empty(); }
+
+    void record(uint64_t cycle, Action action, uint16_t cmd, uint64_t addr, uint8_t state, uint32_t src, uint32_t dst, uint32_t event) {
+        if (ring_.empty())
+            return;
+        FlightRecord& r = ring_[count_ & mask_];
+        r.cycle = cycle;
+        r.addr = addr;
+        r.src = src;
+        r.dst = dst;
+        r.event = event;
+        r.cmd = cmd;
+        r.state = state;
+        r.action = action;
+        count_++;
+    }
+
+    /* Record a MemEventBase (or derived) event */
+    template<typename EventT>
+    void record(uint64_t cycle, Action action, EventT* ev, uint8_t state = NO_STATE) {
+        if (ring_.empty())
+            return;
+        record(cycle, action, (uint16_t)ev->getCmd(), ev->getRoutingAddress(), state, ev->getSrcID(), ev->getDstID(), (uint32_t)ev->getID().first);
+    }
+
+    /* Number of records held and the i-th oldest */
+    size_t size() const { return count_ < ring_.size() ? count_ : ring_.size(); }
+    const FlightRecord& at(size_t i) const { return ring_[(count_ - size() + i) & mask_]; }
+
+    /*
+     * Write the ring to 'file'. 'endpointName' maps the src/dst IDs that
+     * appear in the records to names. Returns false if the file could not
+     * be written.
+     */
+    template<typename NameFn>
+    bool dump(const std::string& file, const std::string& component, uint64_t cycle,
+            const char* const* cmdNames, uint32_t numCmds, const char* const* stateNames, uint32_t numStates, NameFn endpointName) const {
+        FILE* fp = fopen(file.c_str(), "wb");
+        if (!fp)
+            return false;
+        fwrite("MHFR", 1, 4, fp);
+        writeU32(fp, VERSION);
+        writeString(fp, component);
+        fwrite(&cycle, sizeof(cycle), 1, fp);
+
+        writeU32(fp, numCmds);
+        for (uint32_t i = 0; i < numCmds; i++)
+            writeString(fp, cmdNames[i]);
+        writeU32(fp, numStates);
+        for (uint32_t i = 0; i < numStates; i++)
+            writeString(fp, stateNames[i]);
+
+        std::set<uint32_t> endpoints;
+        for (size_t i = 0; i < size(); i++) {
+            endpoints.insert(at(i).src);
+            endpoints.insert(at(i).dst);
+        }
+        writeU32(fp, endpoints.size());
+        for (std::set<uint32_t>::const_iterator it = endpoints.begin(); it != endpoints.end(); it++) {
+            writeU32(fp, *it);
+            writeString(fp, endpointName(*it));
+        }
+
+        writeU32(fp, size());
+        for (size_t i = 0; i < size(); i++)
+            fwrite(&at(i), sizeof(FlightRecord), 1, fp);
+        bool ok = !ferror(fp);
+        return (fclose(fp) == 0) && ok;
+    }
+
+private:
+    static void writeU32(FILE* fp, uint32_t val) { fwrite(&val, sizeof(val), 1, fp); }
+    static void writeString(FILE* fp, const std::string& str) {
+        writeU32(fp, str.size());
+        fwrite(str.data(), 1, str.size(), fp);
+    }
+
+    std::vector<FlightRecord> ring_;
+    size_t mask_;
+    uint64_t count_;
+};
+
+}}
+#endif // MEMHIERARCHY_FLIGHTRECORDER_H
@@ -0,0 +1,121 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_LATENCYTRACE_H
+#define MEMHIERARCHY_LATENCYTRACE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ * Per-request latency breakdown
+ *
+ * A cache with 'latency_trace_rate' set gives every Nth request it receives
+ * a trace ID. The ID is copied wherever the event is copied, so forwarded
+ * requests and responses carry it too. Caches, directories, MemNICs, and
+ * memory backend convertors add a stamp (point, time) to a traced event as it
+ * passes through. When a response comes back, the cache or directory copies
+ * its stamps to the waiting request, so the response sent further up holds
+ * the whole path. The cache that started the trace finishes it when that
+ * response leaves it.
+ *
+ * The time between two stamps is charged to a stage, by the point of the
+ * later stamp:
+ *   Queue   - waiting to be handled: event buffers, NIC send queues, memory request queues
+ *   MSHR    - stalled in an MSHR behind another request
+ *   Access  - cache or directory access latency
+ *   Network - links and the network between components
+ *   Memory  - memory backend
+ *
+ * Untraced events have trace ID 0 and no stamps.
+ *
+ * Binary trace file ('latency_trace_file'):
+ *   header: "MHLT" then uint32 version (1)
+ *   record: uint64 trace ID, uint32 command of the response, uint32 stamp count,
+ *           then one uint64 per stamp, packed as below with time in ps
+ * All values are in host byte order.
+ */
+namespace LatencyTrace {
+
+    enum class Point : uint8_t {
+        CacheArrive,    // Event received by a cache
+        CacheStart,     // Cache starts handling a new event
+        CacheReplay,    // Cache replays an event from its MSHR
+        CacheSend,      // Cache sends the event (or a copy or response)
+        DirArrive,
+        DirStart,
+        DirReplay,
+        DirSend,
+        NICSend,        // MemNIC injects the event into the network
+        NICRecv,        // MemNIC takes the event from the network
+        MemArrive,      // Memory backend convertor receives the request
+        MemIssue,       // All of the request has been issued to the backend
+        MemDone,        // The backend has completed the request
+        LAST
+    };
+
+    enum class Stage { Queue, MSHR, Access, Network, Memory, LAST };
+
+    static const unsigned NUM_STAGES = (unsigned)Stage::LAST;
+    static const unsigned TIME_BITS = 56;
+    static const uint64_t TIME_MASK = ((uint64_t)1 << TIME_BITS) - 1;
+
+    /* A stamp packs the point into the top 8 bits and the time into the rest */
+    inline uint64_t pack(Point point, uint64_t time) { return ((uint64_t)point << TIME_BITS) | (time & TIME_MASK); }
+    inline Point point(uint64_t stamp) { return (Point)(stamp >> TIME_BITS); }
+    inline uint64_t time(uint64_t stamp) { return stamp & TIME_MASK; }
+
+    /* Trace IDs hold the originating endpoint's wire ID so that it can recognize its own
+     * traces on any rank. Wire IDs are never 0, so neither is a trace ID. */
+    inline uint64_t makeID(uint32_t wire, uint32_t seq) { return ((uint64_t)wire << 32) | seq; }
+    inline uint32_t origin(uint64_t id) { return (uint32_t)(id >> 32); }
+
+    inline Stage stageOf(Point p) {
+        switch (p) {
+            case Point::CacheStart:
+            case Point::DirStart:
+            case Point::NICSend:
+            case Point::MemIssue:
+                return Stage::Queue;
+            case Point::CacheReplay:
+            case Point::DirReplay:
+                return Stage::MSHR;
+            case Point::CacheSend:
+            case Point::DirSend:
+                return Stage::Access;
+            case Point::MemDone:
+                return Stage::Memory;
+            default:
+                return Stage::Network;
+        }
+    }
+
+    /* Sum the time spent in each stage. Returns the total time. */
+    inline uint64_t breakdown(const std::vector<uint64_t>& trace, uint64_t (&stages)[NUM_STAGES]) {
+        for (unsigned i = 0; i < NUM_STAGES; i++)
+            stages[i] = 0;
+        if (trace.empty())
+            return 0;
+        for (size_t i = 1; i < trace.size(); i++)
+            stages[(int)stageOf(point(trace[i]))] += time(trace[i]) - time(trace[i-1]);
+        return time(trace.back()) - time(trace.front());
+    }
+}
+
+}}
+#endif // MEMHIERARCHY_LATENCYTRACE_H
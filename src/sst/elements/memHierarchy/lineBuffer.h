@@ -0,0 +1,187 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_LINEBUFFER_H
+#define MEMHIERARCHY_LINEBUFFER_H
+
+#include <stdint.h>
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "sst/elements/memHierarchy/memEventPool.h"
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ * Reference-counted, copy-on-write data buffer
+ *
+ * Used for MemEvent payloads and cache line data. Copying a LineBuffer
+ * shares the bytes; they are copied only when one of the holders modifies
+ * them. So copying an event (forwarding, makeResponse(), NACKs), sending a
+ * whole line as a payload, or filling a line from a full-line response does
+ * not copy data.
+ *
+ * data() gives read access without copying. mutableData() and the other
+ * modifiers first make this holder's bytes private if they are shared.
+ * Assigning new contents replaces the bytes rather than copying the shared
+ * ones first.
+ *
+ * The reference count is atomic because an event can be deleted on a
+ * different thread than the one holding a line that shares its payload.
+ * Buffers come from PayloadPool like unshared payloads did.
+ */
+class LineBuffer {
+    public:
+        LineBuffer() : rep_(nullptr) { }
+        LineBuffer(const LineBuffer& other) : rep_(other.rep_) { if (rep_) rep_->refs.fetch_add(1, std::memory_order_relaxed); }
+        LineBuffer(LineBuffer&& other) : rep_(other.rep_) { other.rep_ = nullptr; }
+        ~LineBuffer() { drop(); }
+
+        LineBuffer& operator=(const LineBuffer& other) {
+            if (rep_ != other.rep_) {
+                if (other.rep_) other.rep_->refs.fetch_add(1, std::memory_order_relaxed);
+                drop();
+                rep_ = other.rep_;
+            }
+            return *this;
+        }
+        LineBuffer& operator=(LineBuffer&& other) {
+            if (this != &other) {
+                drop();
+                rep_ = other.rep_;
+                other.rep_ = nullptr;
+            }
+            return *this;
+        }
+
+        size_t size() const { return rep_ ? rep_->bytes.size() : 0; }
+        bool empty() const { return size() == 0; }
+
+        /* Whether another buffer holds the same bytes */
+        bool shared() const { return rep_ && rep_->refs.load(std::memory_order_acquire) > 1; }
+
+        const std::vector<uint8_t>& data() const { return rep_ ? rep_->bytes : emptyBytes(); }
+
+        /* Writable bytes, copied first if shared */
+        std::vector<uint8_t>& mutableData() {
+            if (!rep_) {
+                rep_ = Rep::create();
+            } else if (shared()) {
+                Rep* copy = Rep::create();
+                copy->bytes.assign(rep_->bytes.begin(), rep_->bytes.end());
+                drop();
+                rep_ = copy;
+            }
+            return rep_->bytes;
+        }
+
+        void assign(const std::vector<uint8_t>& bytes) { assign(bytes.data(), bytes.size()); }
+        void assign(const uint8_t* bytes, size_t size) {
+            if (size == 0) {
+                clear();
+                return;
+            }
+            exclusive().assign(bytes, bytes + size);
+        }
+        void assign(size_t size, uint8_t value) {
+            if (size == 0) {
+                clear();
+                return;
+            }
+            exclusive().assign(size, value);
+        }
+
+        /* Take over 'bytes' without copying. 'bytes' is left empty. */
+        void assign(std::vector<uint8_t>&& bytes) {
+            if (bytes.empty()) {
+                clear();
+                return;
+            }
+            exclusive().swap(bytes);
+            PayloadPool::release(bytes);    // Pools our old storage, or keeps it if the pool is full
+            bytes.clear();
+        }
+
+        /* Copy 'bytes' in at 'offset'. The buffer must be large enough. */
+        void write(const std::vector<uint8_t>& bytes, size_t offset) {
+            if (bytes.empty())
+                return;
+            std::copy(bytes.begin(), bytes.end(), mutableData().begin() + offset);
+        }
+
+        /* Resize, zero-filling any new bytes */
+        void resize(size_t size) {
+            if (size == this->size())
+                return;
+            mutableData().resize(size);
+        }
+
+        /* Move the bytes into 'out', copying only if another buffer still shares them. Leaves this buffer empty. */
+        void moveTo(std::vector<uint8_t>& out) {
+            if (!rep_) {
+                out.clear();
+            } else if (shared()) {
+                out.assign(rep_->bytes.begin(), rep_->bytes.end());
+            } else {
+                out.swap(rep_->bytes);
+            }
+            drop();
+        }
+
+        void clear() { drop(); }
+
+    private:
+        struct Rep {
+            std::atomic<uint32_t> refs;
+            std::vector<uint8_t> bytes;
+
+            Rep() : refs(1) { PayloadPool::acquire(bytes); }
+            ~Rep() { PayloadPool::release(bytes); }
+
+            static Rep* create() { return new (MemEventPool::allocate(sizeof(Rep))) Rep(); }
+            static void destroy(Rep* rep) {
+                rep->~Rep();
+                MemEventPool::release(rep, sizeof(Rep));
+            }
+        };
+
+        /* An unshared Rep whose old contents are about to be replaced */
+        std::vector<uint8_t>& exclusive() {
+            if (!rep_ || shared()) {
+                drop();
+                rep_ = Rep::create();
+            }
+            return rep_->bytes;
+        }
+
+        void drop() {
+            if (rep_ && rep_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                Rep::destroy(rep_);
+            rep_ = nullptr;
+        }
+
+        static const std::vector<uint8_t>& emptyBytes() {
+            static const std::vector<uint8_t> empty;
+            return empty;
+        }
+
+        Rep* rep_;
+};
+
+}}
+#endif // MEMHIERARCHY_LINEBUFFER_H
@@ -23,6 +23,9 @@
 #include "sst/elements/memHierarchy/memTypes.h"
 #include "sst/elements/memHierarchy/util.h"
 #include "sst/elements/memHierarchy/replacementManager.h"
+#include "sst/elements/memHierarchy/sharerSet.h"
+#include "sst/elements/memHierarchy/cacheCheckpoint.h"
+#include "sst/elements/memHierarchy/lineBuffer.h"
 
 using namespace std;
 
@@ -35,6 +38,7 @@ namespace SST { namespace MemHierarchy {
  * - getString() for debug
  * - getAddr() for identifiying a line
  * - getReplacementInfo() for returning the information that a replacement policy might need
+ * - saveCheckpoint()/loadCheckpoint() to copy line state to/from a checkpoint record
  */
 
 
@@ -45,14 +49,14 @@ class DirectoryLine {
         const unsigned int index_;
         Addr addr_;
         State state_;
-        std::set<std::string> sharers_;
-        std::string owner_;
+        SharerSet sharers_;
+        uint32_t owner_;
         uint64_t lastSendTimestamp_;
         CoherenceReplacementInfo * info_;
         bool wasPrefetch_;
 
     public:
-        DirectoryLine(uint32_t size, unsigned int index) : index_(index), addr_(0), state_(I), lastSendTimestamp_(0), wasPrefetch_(false) {
+        DirectoryLine(uint32_t size, unsigned int index) : index_(index), addr_(0), state_(I), owner_(SharerIDMap::NO_ID), lastSendTimestamp_(0), wasPrefetch_(false) {
             info_ = new CoherenceReplacementInfo(index, I, false, false);
         }
         virtual ~DirectoryLine() { }
@@ -60,7 +64,7 @@ class DirectoryLine {
         void reset() {
             state_ = I;
             sharers_.clear();
-            owner_ = "";
+            owner_ = SharerIDMap::NO_ID;
             lastSendTimestamp_ = 0;
             wasPrefetch_ = false;
         }
@@ -77,29 +81,31 @@ class DirectoryLine {
         void setState(State state) { state_ = state; }
 
         // Sharers
-        set<std::string>* getSharers() { return &sharers_; }
-        bool isSharer(std::string shr) {   return sharers_.find(shr) != sharers_.end(); }
+        SharerSet* getSharers() { return &sharers_; }
+        bool isSharer(const std::string &shr) { return sharers_.contains(shr); }
+        bool isSharer(uint32_t id) { return sharers_.contains(id); }
         size_t numSharers() { return sharers_.size(); }
         bool hasSharers() { return !sharers_.empty(); }
-        bool hasOtherSharers(std::string shr) { return !(sharers_.empty() || (sharers_.size() == 1 && sharers_.find(shr) != sharers_.end())); }
-        void addSharer(std::string shr) {
+        bool hasOtherSharers(const std::string &shr) { return sharers_.hasOther(shr); }
+        void addSharer(const std::string &shr) {
             sharers_.insert(shr);
             info_->setShared(true);
         }
-        void removeSharer(std::string shr) {
+        void removeSharer(const std::string &shr) {
             sharers_.erase(shr);
             info_->setShared(!sharers_.empty());
         }
 
         // Owner
-        std::string getOwner() { return owner_; }
-        bool hasOwner() { return !owner_.empty(); }
-        void setOwner(std::string owner) {
-            owner_ = owner;
+        const std::string& getOwner() { return SharerIDMap::getName(owner_); }
+        uint32_t getOwnerID() { return owner_; }
+        bool hasOwner() { return owner_ != SharerIDMap::NO_ID; }
+        void setOwner(const std::string &owner) {
+            owner_ = owner.empty() ? SharerIDMap::NO_ID : SharerIDMap::getID(owner);
             info_->setOwned(true);
         }
         void removeOwner() {
-            owner_.clear();
+            owner_ = SharerIDMap::NO_ID;
             info_->setOwned(false);
         }
 
@@ -115,12 +121,32 @@ class DirectoryLine {
         // Replacement
         ReplacementInfo* getReplacementInfo() { return info_; }
 
+        // Checkpoint
+        void saveCheckpoint(CacheCheckpoint::Line &line) {
+            line.addr = addr_;
+            line.index = index_;
+            line.state = state_;
+            line.flags = wasPrefetch_ ? CacheCheckpoint::Line::PREFETCH : 0;
+            if (hasOwner())
+                line.owner = getOwner();
+            for (SharerSet::iterator it = sharers_.begin(); it != sharers_.end(); it++)
+                line.sharers.push_back(*it);
+        }
+        void loadCheckpoint(const CacheCheckpoint::Line &line) {
+            setState((State)line.state);
+            wasPrefetch_ = line.flags & CacheCheckpoint::Line::PREFETCH;
+            if (!line.owner.empty())
+                setOwner(line.owner);
+            for (size_t i = 0; i < line.sharers.size(); i++)
+                addSharer(line.sharers[i]);
+        }
+
         // String-ify for debugging
         std::string getString() {
             std::ostringstream str;
-            str << "O: " << (owner_.empty() ? "-" : owner_);
+            str << "O: " << (hasOwner() ? getOwner() : "-");
             str << " S: [";
-            for (std::set<std::string>::iterator it = sharers_.begin(); it != sharers_.end(); it++) {
+            for (SharerSet::iterator it = sharers_.begin(); it != sharers_.end(); it++) {
                 if (it != sharers_.begin()) str << ",";
                 str << *it;
             }
@@ -134,12 +160,12 @@ class DataLine {
     private:
         const unsigned int index_;
         Addr addr_;
-        vector<uint8_t> data_;
+        LineBuffer data_;
         DirectoryLine* tag_;
         CoherenceReplacementInfo* info_;
     public:
         DataLine(uint8_t size, unsigned int index) : index_(index), addr_(0), tag_(nullptr) {
-            data_.resize(size);
+            data_.assign(size, 0);
             info_ = new CoherenceReplacementInfo(index, I, false, false);
         }
         virtual ~DataLine() { }
@@ -162,15 +188,35 @@ class DataLine {
         }
         DirectoryLine* getTag() { return tag_; }
 
-        // Data
-        vector<uint8_t>* getData() { return &data_; }
-        void setData(vector<uint8_t> data, uint32_t offset) {
-            std::copy(data.begin(), data.end(), data_.begin() + offset);
+        // Data - getData() copies the data first if a payload still shares it; read with getDataBuffer()
+        vector<uint8_t>* getData() { return &data_.mutableData(); }
+        const LineBuffer& getDataBuffer() { return data_; }
+        void setData(const vector<uint8_t>& data, uint32_t offset) {
+            data_.write(data, offset);
+        }
+        /* Shares 'data' if it covers the whole line */
+        void setData(const LineBuffer& data, uint32_t offset) {
+            if (offset == 0 && data.size() == data_.size())
+                data_ = data;
+            else
+                data_.write(data.data(), offset);
         }
 
         // Replacement
         ReplacementInfo* getReplacementInfo() { return tag_ ? tag_->getReplacementInfo() : info_; }
 
+        // Checkpoint - state lives in the directory line, which the owner of the data array links via setTag()
+        void saveCheckpoint(CacheCheckpoint::Line &line) {
+            line.addr = addr_;
+            line.index = index_;
+            line.state = getState();
+            line.data = data_.data();
+        }
+        void loadCheckpoint(const CacheCheckpoint::Line &line) {
+            if (line.data.size() == data_.size())
+                data_.assign(line.data);
+        }
+
         // String-ify for debugging
         std::string getString() {
             return (tag_ ? "Valid" : "Invalid");
@@ -183,7 +229,7 @@ class CacheLine {
         const unsigned int index_;
         Addr addr_;
         State state_;
-        vector<uint8_t> data_;
+        LineBuffer data_;
 
         // Timing
         uint64_t lastSendTimestamp_;
@@ -194,7 +240,7 @@ class CacheLine {
         virtual void updateReplacement() = 0;
     public:
         CacheLine(uint32_t size, unsigned int index) : index_(index), addr_(0), state_(I), lastSendTimestamp_(0), wasPrefetch_(false) {
-            data_.resize(size);
+            data_.assign(size, 0);
         }
         virtual ~CacheLine() { }
 
@@ -215,10 +261,18 @@ class CacheLine {
         State getState() { return state_; }
         void setState(State state) { state_ = state; updateReplacement(); }
 
-        // Data
-        vector<uint8_t>* getData() { return &data_; }
-        void setData(vector<uint8_t> in, uint32_t offset) {
-            std::copy(in.begin(), in.end(), std::next(data_.begin(), offset));
+        // Data - getData() copies the data first if a payload still shares it; read with getDataBuffer()
+        vector<uint8_t>* getData() { return &data_.mutableData(); }
+        const LineBuffer& getDataBuffer() { return data_; }
+        void setData(const vector<uint8_t>& in, uint32_t offset) {
+            data_.write(in, offset);
+        }
+        /* Shares 'in' if it covers the whole line */
+        void setData(const LineBuffer& in, uint32_t offset) {
+            if (offset == 0 && in.size() == data_.size())
+                data_ = in;
+            else
+                data_.write(in.data(), offset);
         }
 
         // Timestamp
@@ -231,6 +285,21 @@ class CacheLine {
 
         virtual ReplacementInfo* getReplacementInfo() = 0;
 
+        // Checkpoint
+        void saveCheckpoint(CacheCheckpoint::Line &line) {
+            line.addr = addr_;
+            line.index = index_;
+            line.state = state_;
+            line.flags = wasPrefetch_ ? CacheCheckpoint::Line::PREFETCH : 0;
+            line.data = data_.data();
+        }
+        void loadCheckpoint(const CacheCheckpoint::Line &line) {
+            setState((State)line.state);
+            wasPrefetch_ = line.flags & CacheCheckpoint::Line::PREFETCH;
+            if (line.data.size() == data_.size())
+                data_.assign(line.data);
+        }
+
         // String-ify for debugging
         std::string getString() {
             std::ostringstream str;
@@ -295,13 +364,13 @@ class L1CacheLine : public CacheLine {
 /* With owner/sharer state for shared caches */
 class SharedCacheLine : public CacheLine {
     private:
-        std::set<std::string> sharers_;
-        std::string owner_;
+        SharerSet sharers_;
+        uint32_t owner_;
         CoherenceReplacementInfo * info;
     protected:
         virtual void updateReplacement() { info->setState(state_); }
     public:
-        SharedCacheLine(uint32_t size, unsigned int index) : owner_(""), CacheLine(size, index) {
+        SharedCacheLine(uint32_t size, unsigned int index) : owner_(SharerIDMap::NO_ID), CacheLine(size, index) {
             info = new CoherenceReplacementInfo(index, I, false, false);
         }
 
@@ -312,45 +381,63 @@ class SharedCacheLine : public CacheLine {
         void reset() {
             CacheLine::reset();
             sharers_.clear();
-            owner_ = "";
+            owner_ = SharerIDMap::NO_ID;
         }
 
         // Sharers
-        set<std::string>* getSharers() { return &sharers_; }
-        bool isSharer(std::string name) {   return sharers_.find(name) != sharers_.end(); }
+        SharerSet* getSharers() { return &sharers_; }
+        bool isSharer(const std::string &name) { return sharers_.contains(name); }
+        bool isSharer(uint32_t id) { return sharers_.contains(id); }
         size_t numSharers() { return sharers_.size(); }
         bool hasSharers() { return !sharers_.empty(); }
-        bool hasOtherSharers(std::string shr) { return !(sharers_.empty() || (sharers_.size() == 1 && sharers_.find(shr) != sharers_.end())); }
-        void addSharer(std::string s) {
+        bool hasOtherSharers(const std::string &shr) { return sharers_.hasOther(shr); }
+        void addSharer(const std::string &s) {
             sharers_.insert(s);
             info->setShared(true);
         }
-        void removeSharer(std::string s) {
+        void removeSharer(const std::string &s) {
             sharers_.erase(s);
             info->setShared(!sharers_.empty());
         }
 
         // Owner
-        std::string getOwner() { return owner_; }
-        bool hasOwner() { return !owner_.empty(); }
-        void setOwner(std::string owner) {
-            owner_ = owner;
+        const std::string& getOwner() { return SharerIDMap::getName(owner_); }
+        uint32_t getOwnerID() { return owner_; }
+        bool hasOwner() { return owner_ != SharerIDMap::NO_ID; }
+        void setOwner(const std::string &owner) {
+            owner_ = owner.empty() ? SharerIDMap::NO_ID : SharerIDMap::getID(owner);
             info->setOwned(true);
         }
         void removeOwner() {
-            owner_.clear();
+            owner_ = SharerIDMap::NO_ID;
             info->setOwned(false);
         }
 
         // Replacement
         ReplacementInfo * getReplacementInfo() { return info; }
 
+        // Checkpoint
+        void saveCheckpoint(CacheCheckpoint::Line &line) {
+            CacheLine::saveCheckpoint(line);
+            if (hasOwner())
+                line.owner = getOwner();
+            for (SharerSet::iterator it = sharers_.begin(); it != sharers_.end(); it++)
+                line.sharers.push_back(*it);
+        }
+        void loadCheckpoint(const CacheCheckpoint::Line &line) {
+            CacheLine::loadCheckpoint(line);
+            if (!line.owner.empty())
+                setOwner(line.owner);
+            for (size_t i = 0; i < line.sharers.size(); i++)
+                addSharer(line.sharers[i]);
+        }
+
         // String-ify for debugging
         std::string getString() {
             std::ostringstream str;
-            str << "O: " << (owner_.empty() ? "-" : owner_);
+            str << "O: " << (hasOwner() ? getOwner() : "-");
             str << " S: [";
-            for (std::set<std::string>::iterator it = sharers_.begin(); it != sharers_.end(); it++) {
+            for (SharerSet::iterator it = sharers_.begin(); it != sharers_.end(); it++) {
                 if (it != sharers_.begin()) str << ",";
                 str << *it;
             }
@@ -391,6 +478,18 @@ class PrivateCacheLine : public CacheLine {
         // Replacement
         ReplacementInfo * getReplacementInfo() { return info; }
 
+        // Checkpoint
+        void saveCheckpoint(CacheCheckpoint::Line &line) {
+            CacheLine::saveCheckpoint(line);
+            if (shared) line.flags |= CacheCheckpoint::Line::SHARED;
+            if (owned) line.flags |= CacheCheckpoint::Line::OWNED;
+        }
+        void loadCheckpoint(const CacheCheckpoint::Line &line) {
+            CacheLine::loadCheckpoint(line);
+            setShared(line.flags & CacheCheckpoint::Line::SHARED);
+            setOwned(line.flags & CacheCheckpoint::Line::OWNED);
+        }
+
         // String-ify for debugging
         std::string getString() {
             std::string str = "O: ";
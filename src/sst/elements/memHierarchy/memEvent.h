@@ -23,6 +23,7 @@
 
 #include "sst/elements/memHierarchy/util.h"
 #include "sst/elements/memHierarchy/memEventBase.h"
+#include "sst/elements/memHierarchy/lineBuffer.h"
 #include "sst/elements/memHierarchy/memTypes.h"
 
 namespace SST { namespace MemHierarchy {
@@ -83,8 +84,21 @@ public:
         baseAddr_ = baseAddr;
         setPayload(data);
     }
+    /** Takes over 'data' rather than copying it */
+    MemEvent(std::string src, Addr addr, Addr baseAddr, Command cmd, std::vector<uint8_t>&& data) : MemEventBase(src, cmd) {
+        initialize();
+        addr_ = addr;
+        baseAddr_ = baseAddr;
+        setPayload(std::move(data));
+    }
+
+
 
+    /** Copy an event. The copy shares the payload (LineBuffer) until one of the two modifies it.
+     * The make*Response() functions adjust the fields a response needs after copying. */
+    MemEvent(const MemEvent &ev) = default;
 
+    virtual ~MemEvent() { }
 
     /** Create a new MemEvent instance, pre-configured to act as a NACK response */
     MemEvent* makeNACKResponse(MemEvent* NACKedEvent) {
@@ -191,18 +205,44 @@ public:
     void setSuccess(bool b) { b ? clearFlag(MemEventBase::F_FAIL) : setFlag(MemEventBase::F_FAIL); }
     bool success() { return !queryFlag(MemEventBase::F_FAIL); }
 
-    /** @return  the data payload. */
+    /** @return  the data payload, for modification. A payload shared with other events is copied first;
+     * use readPayload() or getPayloadBuffer() if the data is only read. */
     dataVec& getPayload(void) {
         /* Lazily allocate space for payload */
-        if ( payload_.size() < size_ )  payload_.resize(size_);
-        return payload_;
+        if ( payload_.size() < size_ )
+            payload_.resize(size_);
+        return payload_.mutableData();
+    }
+
+    /** @return  the data payload, read-only and without copying */
+    const dataVec& readPayload(void) {
+        return getPayloadBuffer().data();
     }
 
+    /** @return  the payload buffer, to share with another event or a cache line */
+    const LineBuffer& getPayloadBuffer(void) {
+        if ( payload_.size() < size_ )
+            payload_.resize(size_);
+        return payload_;
+    }
 
     /** Sets the data payload and payload size.
      * @param[in] data  Vector from which to copy data
      */
-    void setPayload(std::vector<uint8_t>& data) {
+    void setPayload(const std::vector<uint8_t>& data) {
+        setSize(data.size());
+        if (&data == &payload_.data()) return;
+        payload_.assign(data);
+    }
+
+    /** Sets the data payload and payload size, taking over 'data' rather than copying it */
+    void setPayload(std::vector<uint8_t>&& data) {
+        setSize(data.size());
+        payload_.assign(std::move(data));
+    }
+
+    /** Sets the data payload and payload size, sharing 'data' */
+    void setPayload(const LineBuffer& data) {
         setSize(data.size());
         payload_ = data;
     }
@@ -213,16 +253,19 @@ public:
      */
     void setPayload(uint32_t size, uint8_t* data) {
         setSize(size);
-        payload_.resize(size);
-        for ( uint32_t i = 0 ; i < size ; i++ ) {
-            payload_[i] = data[i];
-        }
+        payload_.assign(data, size);
     }
 
     void setZeroPayload(uint32_t size) {
         setSize(size);
-        payload_.clear();
-        payload_.resize(size, 0);
+        payload_.assign(size, 0);
+    }
+
+    /** Moves the payload into 'data', copying only if another event shares it. Leaves this event without a payload. */
+    void takePayload(std::vector<uint8_t>& data) {
+        if ( payload_.size() < size_ )
+            payload_.resize(size_);
+        payload_.moveTo(data);
     }
 
     size_t getPayloadSize() override {
@@ -267,7 +310,7 @@ public:
             std::stringstream value;
             value << std::hex << std::setfill('0');
             for (unsigned int i = 0; i < payload_.size(); i++)
-                value << std::hex << std::setw(2) << (int)payload_[i];
+                value << std::hex << std::setw(2) << (int)payload_.data()[i];
             str << " Data: 0x" << value.str();
         }
         str << " VA: 0x" << vAddr_ << " IP: 0x" << instPtr_;
@@ -303,7 +346,7 @@ private:
     bool            addrGlobal_;        // Whether address is a local or global address
     MemEvent*       NACKedEvent_;       // For a NACK, pointer to the NACKed event
     int             retries_;           // For NACKed events, how many times a retry has been sent
-    dataVec         payload_;           // Data
+    LineBuffer      payload_;           // Data
     bool            prefetch_;          // Whether this request came from a prefetcher
     bool            dirty_;             // For a replacement, whether the data is dirty or not
     bool            isEvict_;           // Whether an event is an eviction
@@ -321,7 +364,12 @@ public:
         ser & addrGlobal_;
         ser & NACKedEvent_;
         ser & retries_;
-        ser & payload_;
+        dataVec payload;
+        if (ser.mode() != SST::Core::Serialization::serializer::UNPACK)
+            payload = payload_.data();
+        ser & payload;
+        if (ser.mode() == SST::Core::Serialization::serializer::UNPACK)
+            payload_.assign(std::move(payload));
         ser & prefetch_;
         ser & dirty_;
         ser & isEvict_;
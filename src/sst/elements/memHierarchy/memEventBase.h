@@ -22,6 +22,9 @@
 
 #include "sst/elements/memHierarchy/util.h"
 #include "sst/elements/memHierarchy/memTypes.h"
+#include "sst/elements/memHierarchy/memEventPool.h"
+#include "sst/elements/memHierarchy/endpointRegistry.h"
+#include "sst/elements/memHierarchy/latencyTrace.h"
 
 namespace SST { namespace MemHierarchy {
 
@@ -48,19 +51,29 @@ public:
     MemEventBase(std::string src, Command cmd) : SST::Event() {
         setDefaults();
         cmd_ = cmd;
-        src_ = src;
+        src_ = EndpointRegistry::getID(src);
     }
 
+#ifdef SST_MEMH_EVENT_POOL
+    /* Recycle memH events (including derived types) through a per-thread pool (--enable-memh-event-pool).
+     * These replace Activity's allocator, including sst-core's USE_MEMPOOL pool: core's pool stores a
+     * size header with every block and looks the pool up by size, this one is a thread-local free list
+     * per size class. memH events then do not appear in core's undeleted-event reports. */
+    static void* operator new(std::size_t size) { return MemEventPool::allocate(size); }
+    static void operator delete(void* ptr, std::size_t size) { MemEventPool::release(ptr, size); }
+#endif
+
     virtual void setDefaults() {
         eventID_        = generateUniqueId();  // Defined in SST::Event
         responseToID_   = NO_ID;
-        dst_            = NONE;
-        src_            = NONE;
-        rqstr_          = NONE;
+        dst_            = noneID();
+        src_            = noneID();
+        rqstr_          = noneID();
         tid_            = 0;
         cmd_            = Command::NULLCMD;
         flags_          = 0;
         memFlags_       = 0;
+        traceID_        = 0;
     }
 
     virtual MemEventBase* makeResponse() {
@@ -99,19 +112,31 @@ public:
     void setCmd(Command newcmd) { cmd_ = newcmd; }
 
     /** @return the source string - who sent this MemEvent */
-    const std::string& getSrc(void) const { return src_; }
+    const std::string& getSrc(void) const { return EndpointRegistry::getName(src_); }
     /** Sets the source string - who sent this MemEvent */
-    void setSrc(const std::string& src) { src_ = src; }
+    void setSrc(const std::string& src) { src_ = EndpointRegistry::getID(src); }
+    /** @return the source endpoint ID */
+    EndpointID getSrcID(void) const { return src_; }
+    /** Sets the source endpoint ID */
+    void setSrcID(EndpointID src) { src_ = src; }
 
     /** @return the destination string - who receives this MemEvent */
-    const std::string& getDst(void) const { return dst_; }
+    const std::string& getDst(void) const { return EndpointRegistry::getName(dst_); }
     /** Sets the destination string - who received this MemEvent */
-    void setDst(const std::string& dst) { dst_ = dst; }
+    void setDst(const std::string& dst) { dst_ = EndpointRegistry::getID(dst); }
+    /** @return the destination endpoint ID */
+    EndpointID getDstID(void) const { return dst_; }
+    /** Sets the destination endpoint ID */
+    void setDstID(EndpointID dst) { dst_ = dst; }
 
     /** @return the requestor string - whose original request caused this MemEvent */
-    const std::string& getRqstr(void) const { return rqstr_; }
+    const std::string& getRqstr(void) const { return EndpointRegistry::getName(rqstr_); }
     /** Sets the requestor string - whose original request caused this MemEvent */
-    void setRqstr(const std::string& rqstr) { rqstr_ = rqstr; }
+    void setRqstr(const std::string& rqstr) { rqstr_ = EndpointRegistry::getID(rqstr); }
+    /** @return the requestor endpoint ID */
+    EndpointID getRqstrID(void) const { return rqstr_; }
+    /** Sets the requestor endpoint ID */
+    void setRqstrID(EndpointID rqstr) { rqstr_ = rqstr; }
 
     /** @return the thread ID that originated the original request */
     const uint32_t getThreadId(void) const { return tid_; }
@@ -171,6 +196,18 @@ public:
         return str;
     }
 
+    /** Latency tracing (see latencyTrace.h) */
+    bool isTraced() const { return traceID_ != 0; }
+    uint64_t getTraceID() const { return traceID_; }
+    void startTrace(uint64_t id) { traceID_ = id; trace_.clear(); }
+    void addTraceStamp(LatencyTrace::Point point, SimTime_t time) { trace_.push_back(LatencyTrace::pack(point, time)); }
+    const std::vector<uint64_t>& getTrace() const { return trace_; }
+    /** Take the stamps from a response to this event, which extend this event's own */
+    void adoptTrace(const MemEventBase* resp) {
+        if (resp->traceID_ == traceID_ && resp->trace_.size() > trace_.size())
+            trace_ = resp->trace_;
+    }
+
     /** Return size of the event - for calculating bandwidth used */
     virtual uint32_t getEventSize() { return 0; }
 
@@ -181,7 +218,7 @@ public:
         std::string cmdStr(CommandString[(int)cmd_]);
         std::ostringstream str;
         str << " Flags: " << getFlagString();
-        return idstring.str() + cmdStr + " Src: " + src_ + " Dst: " + dst_ + " Rq: " + rqstr_ + "Tid: " + std::to_string(tid_) + str.str();
+        return idstring.str() + cmdStr + " Src: " + getSrc() + " Dst: " + getDst() + " Rq: " + getRqstr() + "Tid: " + std::to_string(tid_) + str.str();
     }
 
     /** Get brief print of the event */
@@ -189,7 +226,7 @@ public:
         std::string cmdStr(CommandString[(int)cmd_]);
         std::ostringstream idstring;
         idstring << "<" << eventID_.first << "," << eventID_.second << "> ";
-        return idstring.str() + cmdStr + " Src: " + src_ + " Dst: " + dst_;
+        return idstring.str() + cmdStr + " Src: " + getSrc() + " Dst: " + getDst();
     }
 
     virtual bool doDebug(std::set<Addr> &UNUSED(addr)) {
@@ -211,28 +248,54 @@ public:
 protected:
     id_type         eventID_;           // Unique ID for this event
     id_type         responseToID_;      // For responses, holds the ID to which this event matches
-    string          src_;               // Source ID
-    string          dst_;               // Destination ID
-    string          rqstr_;             // Cache that originated this request
+    EndpointID      src_;               // Source ID
+    EndpointID      dst_;               // Destination ID
+    EndpointID      rqstr_;             // Cache that originated this request
     uint32_t        tid_;               // Thread ID that originated this request
     Command         cmd_;               // Command
     uint32_t        flags_;
     uint32_t        memFlags_;
+    uint64_t        traceID_;           // Latency trace, 0 if not traced
+    std::vector<uint64_t> trace_;       // Latency trace stamps
 
     MemEventBase() {} // For serialization only
 
+    static EndpointID noneID() {
+        static const EndpointID id = EndpointRegistry::getID(NONE);
+        return id;
+    }
+
+    /* Endpoint IDs are local to a process, so events send each endpoint's wire ID (see EndpointRegistry) */
+    virtual void serializeEndpoints(SST::Core::Serialization::serializer &ser) {
+        uint32_t src, dst, rqstr;
+        if ( ser.mode() != SST::Core::Serialization::serializer::UNPACK ) {
+            src = EndpointRegistry::getWireID(src_);
+            dst = EndpointRegistry::getWireID(dst_);
+            rqstr = EndpointRegistry::getWireID(rqstr_);
+        }
+        ser & src;
+        ser & dst;
+        ser & rqstr;
+        if ( ser.mode() == SST::Core::Serialization::serializer::UNPACK ) {
+            src_ = EndpointRegistry::fromWireID(src);
+            dst_ = EndpointRegistry::fromWireID(dst);
+            rqstr_ = EndpointRegistry::fromWireID(rqstr);
+        }
+    }
+
 public:
     void serialize_order(SST::Core::Serialization::serializer &ser)  override {
         Event::serialize_order(ser);
         ser & eventID_;
         ser & responseToID_;
-        ser & src_;
-        ser & dst_;
-        ser & rqstr_;
+        serializeEndpoints(ser);
         ser & tid_;
         ser & cmd_;
         ser & flags_;
         ser & memFlags_;
+        ser & traceID_;
+        if (traceID_ != 0)
+            ser & trace_;
     }
 
     ImplementSerializable(SST::MemHierarchy::MemEventBase);
@@ -303,6 +366,25 @@ protected:
     std::vector<uint8_t> payload_;
 
     MemEventInit() {} // For serialization only
+
+    /* Init events send names, which is how ranks learn each other's endpoint names */
+    virtual void serializeEndpoints(SST::Core::Serialization::serializer &ser) override {
+        std::string src, dst, rqstr;
+        if ( ser.mode() != SST::Core::Serialization::serializer::UNPACK ) {
+            src = getSrc();
+            dst = getDst();
+            rqstr = getRqstr();
+        }
+        ser & src;
+        ser & dst;
+        ser & rqstr;
+        if ( ser.mode() == SST::Core::Serialization::serializer::UNPACK ) {
+            src_ = EndpointRegistry::getID(src);
+            dst_ = EndpointRegistry::getID(dst);
+            rqstr_ = EndpointRegistry::getID(rqstr);
+        }
+    }
+
 public:
     void serialize_order(SST::Core::Serialization::serializer &ser) override {
         MemEventBase::serialize_order(ser);
@@ -0,0 +1,188 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_MEMEVENTPOOL_H
+#define MEMHIERARCHY_MEMEVENTPOOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <new>
+#include <vector>
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ * Per-thread recycling for memH events and their payloads
+ *
+ * MemEventPool is a size-class free-list allocator used by MemEventBase's
+ * class-specific operator new/delete. Blocks are ordinary ::operator new
+ * allocations, so an event created on one thread and deleted on another
+ * simply lands on the deleting thread's free list; no locking is needed.
+ * Free lists are capped so a burst of events does not pin memory forever.
+ * MemEventBase only uses the pool when elements are configured with
+ * --enable-memh-event-pool (SST_MEMH_EVENT_POOL); by default events use
+ * SST Core's allocator so they show up in Core's undeleted-event reports.
+ *
+ * Objects may be deleted after a thread's pools have been destroyed (e.g.,
+ * by static destructors at shutdown). Each pool has a trivially destructible
+ * per-thread flag that is set when its free lists are torn down; from then
+ * on releases go straight to the heap.
+ *
+ * PayloadPool recycles payload vectors. When the last LineBuffer holding
+ * a payload goes away its vector is handed back and the next payload takes
+ * it, so steady-state traffic with line-sized payloads does not allocate.
+ * Buffers are reserved at PAYLOAD_RESERVE bytes (one typical line) and only
+ * buffers up to MAX_POOLED bytes are kept; larger payloads use the heap.
+ */
+class MemEventPool {
+    public:
+        static void* allocate(size_t size) {
+            size_t cls = sizeClass(size);
+            if (cls >= NUM_CLASSES)
+                return ::operator new(size);
+            Lists* l = lists();
+            if (!l)
+                return ::operator new((cls + 1) * GRANULE);
+            FreeList &fl = l->cls[cls];
+            if (fl.head) {
+                Block* b = fl.head;
+                fl.head = b->next;
+                fl.count--;
+                return b;
+            }
+            return ::operator new((cls + 1) * GRANULE);
+        }
+
+        static void release(void* ptr, size_t size) {
+            if (!ptr) return;
+            size_t cls = sizeClass(size);
+            if (cls >= NUM_CLASSES) {
+                ::operator delete(ptr);
+                return;
+            }
+            Lists* l = lists();
+            if (!l) {
+                ::operator delete(ptr);
+                return;
+            }
+            FreeList &fl = l->cls[cls];
+            if (fl.count >= MAX_FREE) {
+                ::operator delete(ptr);
+                return;
+            }
+            Block* b = static_cast<Block*>(ptr);
+            b->next = fl.head;
+            fl.head = b;
+            fl.count++;
+        }
+
+    private:
+        static constexpr size_t GRANULE = 16;
+        static constexpr size_t NUM_CLASSES = 64;     // Blocks up to 1KiB
+        static constexpr size_t MAX_FREE = 4096;      // Per class, per thread
+
+        struct Block { Block* next; };
+
+        struct FreeList {
+            Block* head;
+            size_t count;
+        };
+
+        struct Lists {
+            FreeList cls[NUM_CLASSES];
+            Lists() {
+                for (size_t i = 0; i < NUM_CLASSES; i++) {
+                    cls[i].head = nullptr;
+                    cls[i].count = 0;
+                }
+            }
+            ~Lists() {
+                for (size_t i = 0; i < NUM_CLASSES; i++) {
+                    while (cls[i].head) {
+                        Block* b = cls[i].head;
+                        cls[i].head = b->next;
+                        ::operator delete(b);
+                    }
+                }
+                tornDown() = true;
+            }
+        };
+
+        static size_t sizeClass(size_t size) { return size == 0 ? 0 : (size - 1) / GRANULE; }
+
+        static bool& tornDown() {
+            static thread_local bool done = false;
+            return done;
+        }
+
+        /* This thread's free lists, or nullptr once they have been destroyed */
+        static Lists* lists() {
+            if (tornDown()) return nullptr;
+            static thread_local Lists l;
+            return &l;
+        }
+};
+
+class PayloadPool {
+    public:
+        static constexpr size_t PAYLOAD_RESERVE = 64;
+        static constexpr size_t MAX_POOLED = 256;
+
+        /* Give 'payload' a recycled buffer if it has none. Contents are cleared. */
+        static void acquire(std::vector<uint8_t> &payload) {
+            if (payload.capacity() != 0) return;
+            Spares* spare = buffers();
+            if (spare && !spare->list.empty()) {
+                payload.swap(spare->list.back());
+                spare->list.pop_back();
+                payload.clear();
+            } else {
+                payload.reserve(PAYLOAD_RESERVE);
+            }
+        }
+
+        /* Take back the buffer owned by 'payload', leaving it empty */
+        static void release(std::vector<uint8_t> &payload) {
+            size_t cap = payload.capacity();
+            if (cap == 0 || cap > MAX_POOLED) return;
+            Spares* spare = buffers();
+            if (!spare || spare->list.size() >= MAX_SPARE) return;
+            spare->list.push_back(std::vector<uint8_t>());
+            spare->list.back().swap(payload);
+        }
+
+    private:
+        static constexpr size_t MAX_SPARE = 4096;
+
+        struct Spares {
+            std::vector<std::vector<uint8_t> > list;
+            ~Spares() { tornDown() = true; }
+        };
+
+        static bool& tornDown() {
+            static thread_local bool done = false;
+            return done;
+        }
+
+        /* This thread's spare buffers, or nullptr once they have been destroyed */
+        static Spares* buffers() {
+            if (tornDown()) return nullptr;
+            static thread_local Spares spare;
+            return &spare;
+        }
+};
+
+}}
+#endif // MEMHIERARCHY_MEMEVENTPOOL_H
@@ -18,6 +18,8 @@
 
 #include <string>
 #include <unordered_map>
+#include <vector>
+#include <algorithm>
 #include <queue>
 
 #include <sst/core/event.h>
@@ -290,7 +292,7 @@ class MemNICBase : public MemLinkBase {
                 InitMemRtrEvent * imre = dynamic_cast<InitMemRtrEvent*>(payload);
                 if (imre) {
                     // Record name->address map for all other endpoints
-                    networkAddressMap.insert(std::make_pair(imre->info.name, imre->info.addr));
+                    setNetworkAddress(EndpointRegistry::getID(imre->info.name), imre->info.addr);
                     processInitMemRtrEvent(imre);
                     delete imre;
                 } else {
@@ -396,8 +398,9 @@ class MemNICBase : public MemLinkBase {
                 dbg.debug(_L2_, "%s, Notice: Too many regions to complete error check for overlapping destination regions. Checked first 20 pairs.\n",
                         getName().c_str());
 
-            for (auto it = networkAddressMap.begin(); it != networkAddressMap.end(); it++) {
-                dbg.debug(_L10_, "    Address: %s -> %" PRIu64 "\n", it->first.c_str(), it->second);
+            for (EndpointID id = 0; id < networkAddressMap.size(); id++) {
+                if (networkAddressMap[id] != NO_NETWORK_ADDRESS)
+                    dbg.debug(_L10_, "    Address: %s -> %" PRIu64 "\n", EndpointRegistry::getName(id).c_str(), networkAddressMap[id]);
             }
             for (auto it = sourceEndpointInfo.begin(); it != sourceEndpointInfo.end(); it++) {
                 dbg.debug(_L10_, "    Source: %s\n", it->toString().c_str()); 
@@ -416,18 +419,31 @@ class MemNICBase : public MemLinkBase {
         }
 
         // Lookup the network address for a given endpoint
-        virtual uint64_t lookupNetworkAddress(const std::string &dst) const {
-            std::unordered_map<std::string,uint64_t>::const_iterator it = networkAddressMap.find(dst);
-            if (it == networkAddressMap.end()) {
-                dbg.fatal(CALL_INFO, -1, "%s (MemNICBase), Network address for destination '%s' not found in networkAddressMap.\n", getName().c_str(), dst.c_str());
+        virtual uint64_t lookupNetworkAddress(EndpointID dst) const {
+            if (!hasNetworkAddress(dst)) {
+                dbg.fatal(CALL_INFO, -1, "%s (MemNICBase), Network address for destination '%s' not found in networkAddressMap.\n", getName().c_str(), EndpointRegistry::getName(dst).c_str());
             }
-            return it->second;
+            return networkAddressMap[dst];
+        }
+
+        virtual uint64_t lookupNetworkAddress(const std::string &dst) const {
+            return lookupNetworkAddress(EndpointRegistry::getID(dst));
         }
 
         /*
          * Some helper functions to avoid needing to repeat code everywhere
          */
 
+        bool hasNetworkAddress(EndpointID id) const {
+            return id < networkAddressMap.size() && networkAddressMap[id] != NO_NETWORK_ADDRESS;
+        }
+
+        void setNetworkAddress(EndpointID id, uint64_t addr) {
+            if (id >= networkAddressMap.size())
+                networkAddressMap.resize(std::max((size_t)id + 1, EndpointRegistry::size()), (uint64_t)NO_NETWORK_ADDRESS);
+            networkAddressMap[id] = addr;
+        }
+
         // Get a packet header size parameter & error check it
         size_t extractPacketHeaderSize(Params &params, std::string pname, std::string defsize = "8B") {
             UnitAlgebra size = UnitAlgebra(params.find<std::string>(pname, defsize));
@@ -441,13 +457,16 @@ class MemNICBase : public MemLinkBase {
         void drainQueue(std::queue<SST::Interfaces::SimpleNetwork::Request*>* queue, SST::Interfaces::SimpleNetwork* linkcontrol) {
             while (!(queue->empty())) {
                 SST::Interfaces::SimpleNetwork::Request* head = queue->front();
-#ifdef __SST_DEBUG_OUTPUT__
                 MemEventBase* ev = (static_cast<MemRtrEvent*>(head->inspectPayload()))->event;
+#ifdef __SST_DEBUG_OUTPUT__
                 std::string debugEvStr = ev ? ev->getBriefString() : "";
                 uint64_t dst = head->dest;
                 bool doDebug = ev ? is_debug_event(ev) : false;
 #endif
-                if (linkcontrol->spaceToSend(0, head->size_in_bits) && linkcontrol->send(head, 0)) {
+                bool space = linkcontrol->spaceToSend(0, head->size_in_bits);
+                if (space && ev && ev->isTraced())
+                    ev->addTraceStamp(LatencyTrace::Point::NICSend, getCurrentSimCycle());
+                if (space && linkcontrol->send(head, 0)) {
 
 #ifdef __SST_DEBUG_OUTPUT__
                     if (!debugEvStr.empty() && doDebug) {
@@ -469,10 +488,12 @@ class MemNICBase : public MemLinkBase {
                 delete req;
 
                 if (mre->hasClientData()) {
+                    if (mre->event && mre->event->isTraced())
+                        mre->event->addTraceStamp(LatencyTrace::Point::NICRecv, getCurrentSimCycle());
                     return mre;
                 } else {
                     InitMemRtrEvent * imre = static_cast<InitMemRtrEvent*>(mre);
-                    if (networkAddressMap.find(imre->info.name) == networkAddressMap.end()) {
+                    if (!hasNetworkAddress(EndpointRegistry::getID(imre->info.name))) {
                         dbg.fatal(CALL_INFO, -1, "%s received information about previously unknown endpoint. This case is not handled. Endpoint name: %s\n",
                                 getName().c_str(), imre->info.name.c_str());
                     }
@@ -492,7 +513,8 @@ class MemNICBase : public MemLinkBase {
         bool initMsgSent;
 
         // Data structures
-        std::unordered_map<std::string,uint64_t> networkAddressMap; // Map of name -> address for each network endpoint
+        static constexpr uint64_t NO_NETWORK_ADDRESS = (uint64_t)-1;
+        std::vector<uint64_t> networkAddressMap; // Endpoint ID -> network address, NO_NETWORK_ADDRESS if not a network endpoint
         std::set<EndpointInfo> sourceEndpointInfo;
         std::set<EndpointInfo> destEndpointInfo;
         std::set<EndpointInfo> endpointInfo;
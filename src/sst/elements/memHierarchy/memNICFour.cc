@@ -22,15 +22,6 @@ using namespace SST;
 using namespace SST::MemHierarchy;
 using namespace SST::Interfaces;
 
-/* Debug macros */
-#ifdef __SST_DEBUG_OUTPUT__ /* From sst-core, enable with --enable-debug */
-#define is_debug_addr(addr) (DEBUG_ADDR.empty() || DEBUG_ADDR.find(addr) != DEBUG_ADDR.end())
-#define is_debug_event(ev) (DEBUG_ADDR.empty() || ev->doDebug(DEBUG_ADDR))
-#else
-#define is_debug_addr(addr) false
-#define is_debug_event(ev) false
-#endif
-
 /* Constructor */
 
 MemNICFour::MemNICFour(ComponentId_t id, Params &params, TimeConverter* tc) : MemNICBase(id, params, tc) {
@@ -73,8 +64,15 @@ MemNICFour::MemNICFour(ComponentId_t id, Params &params, TimeConverter* tc) : Me
     stat_oooDepth = registerStatistic<uint64_t>("outoforder_depth_at_event_receive");
     stat_oooDepthSrc = registerStatistic<uint64_t>("outoforder_depth_at_event_receive_src");
     stat_orderLatency = registerStatistic<uint64_t>("ordering_latency");
+    stat_oooDistance = registerStatistic<uint64_t>("outoforder_tag_distance");
+    stat_reorderResize = registerStatistic<uint64_t>("reorder_buffer_resize");
     totalOOO = 0;
 
+    reorderBufferSize = 1;
+    size_t entries = params.find<size_t>("reorder_buffer_size", 64);
+    while (reorderBufferSize < entries)
+        reorderBufferSize <<= 1;
+
     // TimeBase for statistics
     std::string timebase = params.find<std::string>("clock", "1GHz", found);
     if (found)
@@ -98,15 +96,18 @@ void MemNICFour::setup() {
 
     MemNICBase::setup();
 
-    for (std::set<EndpointInfo>::iterator it = sourceEndpointInfo.begin(); it != sourceEndpointInfo.end(); it++) {
-        recvTags[it->addr] = 0;
-        sendTags[it->addr] = 0;
-    }
+    for (std::set<EndpointInfo>::iterator it = sourceEndpointInfo.begin(); it != sourceEndpointInfo.end(); it++)
+        getPeer(it->addr);
 
-    for (std::set<EndpointInfo>::iterator it = destEndpointInfo.begin(); it != destEndpointInfo.end(); it++) {
-        recvTags[it->addr] = 0;
-        sendTags[it->addr] = 0;
-    }
+    for (std::set<EndpointInfo>::iterator it = destEndpointInfo.begin(); it != destEndpointInfo.end(); it++)
+        getPeer(it->addr);
+}
+
+/* Network addresses are small, dense IDs so peers are indexed by them directly */
+MemNICFour::Peer& MemNICFour::getPeer(uint64_t netAddr) {
+    if (netAddr >= peers.size())
+        peers.resize(netAddr + 1);
+    return peers[netAddr];
 }
 
 
@@ -141,10 +142,9 @@ void MemNICFour::send(MemEventBase *ev) {
     SimpleNetwork::Request * req = new SimpleNetwork::Request();
     req->vn = 0;
     req->src = info.addr;
-    req->dest = lookupNetworkAddress(ev->getDst());
+    req->dest = lookupNetworkAddress(ev->getDstID());
 
-    unsigned int tag = sendTags[req->dest];
-    sendTags[req->dest]++;
+    unsigned int tag = getPeer(req->dest).sendTag++;
 
     OrderedMemRtrEvent * omre = new OrderedMemRtrEvent(ev, tag);
 
@@ -203,11 +203,12 @@ void MemNICFour::doRecv(SimpleNetwork::Request * req, NetType net) {
         dbg.debug(_L3_, "%s, memNIC received a message: <%" PRIu64 ", %u>\n",
                 getName().c_str(), src, mre->tag);
 
-        stat_oooDepthSrc->addData(orderBuffer[src].size());
+        Peer& peer = getPeer(src);
+        stat_oooDepthSrc->addData(peer.recv.buffered());
         stat_oooDepth->addData(totalOOO);
-        if (mre->tag == recvTags[src]) { // Got the tag we were expecting
+        if (peer.recv.inOrder(mre->tag)) { // Got the tag we were expecting
             stat_oooEvent[net]->addData(0); // Count total number of events received
-            recvTags[src]++;
+            peer.recv.advance();
 
             if (recvQueue.empty())
                 recvNotify(mre);
@@ -218,17 +219,22 @@ void MemNICFour::doRecv(SimpleNetwork::Request * req, NetType net) {
                 recvQueue.pop();
             }
 
-            while (orderBuffer[src].find(recvTags[src]) != orderBuffer[src].end()) {
+            // The parent may have sent events, adding peers, so look the sender up again
+            Peer& sender = peers[src];
+            uint64_t arrived;
+            while (OrderedMemRtrEvent* next = sender.recv.pop(arrived)) {
                 totalOOO--;
-                recvQueue.push(orderBuffer[src][recvTags[src]].first);
-                stat_orderLatency->addData(getCurrentSimTime() - orderBuffer[src][recvTags[src]].second);
-                orderBuffer[src].erase(recvTags[src]);
-                recvTags[src]++;
+                recvQueue.push(next);
+                stat_orderLatency->addData(getCurrentSimTime() - arrived);
             }
         } else {
+            bool grew;
+            unsigned int distance = peer.recv.insert(mre->tag, mre, getCurrentSimTime(), reorderBufferSize, grew);
+            if (grew)
+                stat_reorderResize->addData(1);
             totalOOO++;
             stat_oooEvent[net]->addData(1); // Count number of out of order events received
-            orderBuffer[src][mre->tag] = std::make_pair(mre,getCurrentSimTime());
+            stat_oooDistance->addData(distance);
         }
         if (!clockOn && !recvQueue.empty()) {
             clockOn = true;
@@ -243,6 +249,9 @@ void MemNICFour::recvNotify(OrderedMemRtrEvent* mre) {
 
     if (!me) return;
 
+    if (me->isTraced())
+        me->addTraceStamp(LatencyTrace::Point::NICRecv, getCurrentSimCycle());
+
     if (is_debug_event(me)) {
         dbg.debug(_L3_, "%s, memNIC notify parent: src: %s. cmd: %s\n",
                 getName().c_str(), me->getSrc().c_str(), CommandString[(int)me->getCmd()]);
@@ -267,7 +276,7 @@ MemNICFour::OrderedMemRtrEvent* MemNICFour::processRecv(SimpleNetwork::Request *
             return smre;
         } else {
             InitMemRtrEvent *imre = static_cast<InitMemRtrEvent*>(mre);
-            if (networkAddressMap.find(imre->info.name) == networkAddressMap.end()) {
+            if (!hasNetworkAddress(EndpointRegistry::getID(imre->info.name))) {
                 dbg.fatal(CALL_INFO, -1, "%s (MemNIC), received information about previously unknown endpoint. This case is not handled. Endpoint name: %s\n",
                         getName().c_str(), imre->info.name.c_str());
             }
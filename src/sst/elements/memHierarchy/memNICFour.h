@@ -19,6 +19,7 @@
 #include <string>
 #include <map>
 #include <queue>
+#include <vector>
 
 #include <sst/core/event.h>
 #include <sst/core/output.h>
@@ -27,6 +28,7 @@
 
 #include "sst/elements/memHierarchy/memEventBase.h"
 #include "sst/elements/memHierarchy/util.h"
+#include "sst/elements/memHierarchy/reorderRing.h"
 #include "sst/elements/memHierarchy/memNIC.h"
 
 namespace SST {
@@ -57,7 +59,8 @@ public:
         { "fwd.network_output_buffer_size", "(string) Fwd network. Size of output buffer", "1KiB"},\
         { "fwd.min_packet_size",            "(string) Fwd network. Size of a packet without a payload (e.g., control message size)", "8B"},\
         { "fwd.port",                       "(string) Fwd network. Set by parent component. Name of port this NIC sits on.", ""},\
-        { "clock",                          "(string) Units for latency statistics. If not specified, units provided by parent component will be used.", "1GHz"}
+        { "clock",                          "(string) Units for latency statistics. If not specified, units provided by parent component will be used.", "1GHz"},\
+        { "reorder_buffer_size",            "(uint) Initial number of out-of-order events buffered per sender. Rounded up to a power of two. Grows if a sender gets further ahead; use the 'outoforder_tag_distance' statistic to size it.", "64"}
 
 
     SST_ELI_REGISTER_SUBCOMPONENT(MemNICFour, "memHierarchy", "MemNICFour", SST_ELI_ELEMENT_VERSION(1,0,0),
@@ -76,7 +79,9 @@ public:
             { "outoforder_fwd_events", "Number of out of order events on forward request network", "count", 1},
             { "outoforder_depth_at_event_receive", "Depth of re-order buffer at an event receive", "count", 1},
             { "outoforder_depth_at_event_receive_src", "Depth of re-order buffer for the sender of an event at event receive", "count", 1},
-            { "ordering_latency", "For events that arrived out of order, cycles spent in buffer. Cycles in units determined by 'clock' parameter (default 1GHz)", "cycles", 1})
+            { "ordering_latency", "For events that arrived out of order, cycles spent in buffer. Cycles in units determined by 'clock' parameter (default 1GHz)", "cycles", 1},
+            { "outoforder_tag_distance", "For events that arrived out of order, how many events ahead of the next expected event from the same sender they were", "events", 1},
+            { "reorder_buffer_resize", "Number of times a sender's reorder buffer had to grow", "count", 1})
 
     SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(
             {"data", "Link control subcomponent to data network", "SST::Interfaces::SimpleNetwork"},
@@ -167,16 +172,27 @@ private:
     std::queue<MemNICFour::OrderedMemRtrEvent*> recvQueue;
 
     // Order tag tracking
-    std::map<uint64_t, unsigned int> sendTags;
-    std::map<uint64_t, unsigned int> recvTags;
-    std::map<uint64_t, std::map<unsigned int, std::pair<OrderedMemRtrEvent*,SimTime_t> > > orderBuffer;
+    // Tags are per (sender, receiver) sequence numbers. Out-of-order events wait in the
+    // receiver's ring for that sender (reorderRing.h). A sender can only be as far ahead
+    // as it has events in flight, which the network's buffering (credits) bounds.
+    struct Peer {
+        unsigned int sendTag;   // Next tag to send to this peer
+        ReorderRing<OrderedMemRtrEvent> recv; // Next tag expected from this peer, and events that arrived ahead of it
+        Peer() : sendTag(0) { }
+    };
+    Peer& getPeer(uint64_t netAddr);
+
+    std::vector<Peer> peers;    // Indexed by network address
+    size_t reorderBufferSize;
 
     // Statistics
     Statistic<uint64_t>* stat_oooEvent[4];
     Statistic<uint64_t>* stat_oooDepth;
     Statistic<uint64_t>* stat_oooDepthSrc;
     Statistic<uint64_t>* stat_orderLatency;
-    uint64_t totalOOO; // Since there's no simple count of orderBuffer size
+    Statistic<uint64_t>* stat_oooDistance;
+    Statistic<uint64_t>* stat_reorderResize;
+    uint64_t totalOOO; // Sum of Peer::recv.buffered()
 };
 
 } //namespace memHierarchy
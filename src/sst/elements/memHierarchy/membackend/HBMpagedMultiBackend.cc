@@ -69,6 +69,8 @@ HBMpagedMultiMemory::HBMpagedMultiMemory(ComponentId_t id, Params &params)
         replaceStrat = BiLRU;
     } else if (stratStr == "SCLRU") {
         replaceStrat = SCLRU;
+    } else if (stratStr == "HOT") {
+        replaceStrat = HOT;
     } else {
         dbg.fatal(CALL_INFO, -1, "Invalid page replacement Strategy (page_replace_strategy)\n");
     }
@@ -89,6 +91,8 @@ HBMpagedMultiMemory::HBMpagedMultiMemory(ComponentId_t id, Params &params)
         addStrat = addSCF;
     } else if (stratStr == "RAND") {
         addStrat = addRAND;
+    } else if (stratStr == "HOT") {
+        addStrat = addHOT;
     } else {
         dbg.fatal(CALL_INFO, -1, "Invalid page addition Strategy (page_add_strategy)\n");
     }
@@ -99,6 +103,22 @@ HBMpagedMultiMemory::HBMpagedMultiMemory(ComponentId_t id, Params &params)
       }
     }
 
+    if (replaceStrat == HOT && addStrat != addHOT) {
+        dbg.fatal(CALL_INFO, -1, "HOT page replacement strategy requires HOT page addition strategy\n");
+    }
+    if (addStrat == addHOT && (replaceStrat == LFU || replaceStrat == LFU8)) {
+        dbg.fatal(CALL_INFO, -1, "HOT page addition strategy does not support LFU page replacement strategies\n");
+    }
+
+    hotPages = nullptr;
+    if (addStrat == addHOT) {
+        unsigned hotK = params.find<unsigned int>("hot_pages", 0);
+        hotPages = new HotPageTracker(params.find<unsigned int>("sketch_width", 4096),
+                                      params.find<unsigned int>("sketch_depth", 4),
+                                      hotK ? hotK : maxFastPages);
+        victimSample = params.find<unsigned int>("victim_sample", 8);
+    }
+
     dramBackpressure = params.find<bool>("dramBackpressure", 1);
 
     threshold = params.find<unsigned int>("threshold", 4);
@@ -123,6 +143,7 @@ HBMpagedMultiMemory::HBMpagedMultiMemory(ComponentId_t id, Params &params)
     fastHits = registerStatistic<uint64_t>("fast_hits","1");
     fastSwaps = registerStatistic<uint64_t>("fast_swaps","1");
     fastAccesses = registerStatistic<uint64_t>("fast_acc","1");
+    slowAccesses = registerStatistic<uint64_t>("slow_acc","1");
     tPages = registerStatistic<uint64_t>("t_pages","1");
     cantSwapOut = registerStatistic<uint64_t>("cant_swap","1");
     swapDelays = registerStatistic<uint64_t>("swap_delays","1");
@@ -223,6 +244,9 @@ bool HBMpagedMultiMemory::checkAdd(HBMpageInfo &page) {
         } else {
             return false;
         }
+    case addHOT:
+        // The sketch is updated once the access is accepted, so ask whether it will be hot then
+        return (page.touched > threshold) && hotPages->wouldBeHot(page.pageAddr, page.touched);
     default:
         dbg.fatal(CALL_INFO, -1, "Strategy not supported\n");
         return 0;
@@ -371,14 +395,101 @@ void HBMpagedMultiMemory::do_LFU( Addr addr, HBMpageInfo &page, bool &inFast, bo
     }
 }
 
+void HBMpagedMultiMemory::do_HOT( HBMpageInfo &page, bool &inFast, bool &swapping) {
+    swapping = 0;
+    inFast = 0;
+    if (page.inFast) {
+        // keep LRU order so victims are sampled from the least recently used pages
+        pageList.erase(page.listEntry);
+        pageList.push_front(&page);
+        page.listEntry = pageList.begin();
+        inFast = 1;
+        return;
+    }
+
+    if (!checkAdd(page)) return;
+
+    if (pagesInFast < maxFastPages) { // there is room to spare!
+        page.inFast = 1;
+        pagesInFast++;
+        pageList.push_front(&page);
+        page.listEntry = pageList.begin();
+        swapping = 1;
+        if (modelSwaps) {moveToFast(page);}
+        return;
+    }
+
+    // evict the coldest of the least recently used pages, if it is colder than this one
+    HBMpageInfo *victimPage = NULL;
+    uint32_t victimCount = page.touched;
+    uint32_t sampled = 0;
+    for (auto e = pageList.rbegin(); e != pageList.rend() && sampled < victimSample; ++e) {
+        if ((*e)->swapDir != HBMpageInfo::NONE) continue;
+        sampled++;
+        uint32_t count = hotPages->estimate((*e)->pageAddr);
+        if (count < victimCount) {
+            victimPage = *e;
+            victimCount = count;
+        }
+    }
+
+    if (!victimPage) {
+        dbg.debug(_L10_, "no pages to swap out (%d sampled)\n", (int)sampled);
+        cantSwapOut->addData(1);
+        return;
+    }
+
+    victimPage->inFast = 0;
+    pageList.erase(victimPage->listEntry);
+    victimPage->listEntry = pageList.end();
+    if (modelSwaps) {moveToSlow(victimPage);}
+
+    page.inFast = 1;
+    swapping = 1;
+    if (modelSwaps) {moveToFast(page);}
+    pageList.push_front(&page);
+    page.listEntry = pageList.begin();
+
+    fastSwaps->addData(1);
+}
+
+/* Send an access to an untracked or unpromoted page to slow memory. Deletes 'req' if it is rejected. */
+bool HBMpagedMultiMemory::issueToSlow(Req *req) {
+    uint64_t pageAddr = req->addr >> pageShift;
+    if (modelSwaps) {
+        queueRequest(req);
+    } else if (!HBMDRAMSimMemory::issueRequest((ReqId)req, req->addr, req->isWrite, req->numBytes)) {
+        delete req;
+        return false;
+    }
+    slowAccesses->addData(1);
+    hotPages->touch(pageAddr);
+    return true;
+}
+
 bool HBMpagedMultiMemory::issueRequest(ReqId id, Addr addr, bool isWrite, unsigned numBytes ){
     uint64_t pageAddr = addr >> pageShift;
     bool inFast = 0;
     bool swapping = 0;
     SimTime_t extraDelay = 0;
+    uint32_t hotCount = 0;
+
+    if (hotPages) {
+        // only track pages that are, or may become, fast. The sketch is
+        // touched once the access is accepted so a rejected and retried
+        // request is counted once.
+        hotCount = hotPages->peek(pageAddr);
+        if (pageMap.find(pageAddr) == pageMap.end() &&
+            !(maxFastPages > 0 && hotCount > threshold && hotPages->wouldBeHot(pageAddr, hotCount))) {
+            return issueToSlow(new Req(id,addr,isWrite,numBytes));
+        }
+    }
+
     auto &page = pageMap[pageAddr];
 
-    page.record(addr, isWrite, getRequestor(id), collectStats, pageAddr, replaceStrat == LFU8);
+    page.record(addr, isWrite, collectStats ? EndpointRegistry::getID(getRequestor(id)) : EndpointRegistry::NO_ENDPOINT,
+                collectStats, pageAddr, replaceStrat == LFU8);
+    if (hotPages) page.touched = hotCount;
 
     if (maxFastPages > 0) {
         if (modelSwaps && pageIsSwapping(page)) {
@@ -387,6 +498,8 @@ bool HBMpagedMultiMemory::issueRequest(ReqId id, Addr addr, bool isWrite, unsign
         } else {
             if (replaceStrat == LFU || replaceStrat == LFU8) {
                 do_LFU( addr, page, inFast, swapping);
+            } else if (replaceStrat == HOT) {
+                do_HOT( page, inFast, swapping);
             } else {
                 do_FIFO_LRU( page, inFast, swapping);
             }
@@ -395,6 +508,12 @@ bool HBMpagedMultiMemory::issueRequest(ReqId id, Addr addr, bool isWrite, unsign
 
     Req* req = new Req(id,addr,isWrite,numBytes );
 
+    if (hotPages && !page.inFast && !pageIsSwapping(page)) {
+        // not promoted, stop tracking it
+        pageMap.erase(pageAddr);
+        return issueToSlow(req);
+    }
+
     if (modelSwaps) {
         fastAccesses->addData(1);
         if (pageIsSwapping(page)) {
@@ -412,7 +531,6 @@ bool HBMpagedMultiMemory::issueRequest(ReqId id, Addr addr, bool isWrite, unsign
                 queueRequest(req);
             }
         }
-        return true;
     } else {
         if (transferDelay > 0) {
             SimTime_t now = getCurrentSimTimeNano();
@@ -425,9 +543,7 @@ bool HBMpagedMultiMemory::issueRequest(ReqId id, Addr addr, bool isWrite, unsign
             }
         }
 
-        fastAccesses->addData(1);
         if (inFast) {
-            fastHits->addData(1);
             if (extraDelay > 0) {
                 self_link->send(extraDelay,
                                 nanoConv,
@@ -435,11 +551,16 @@ bool HBMpagedMultiMemory::issueRequest(ReqId id, Addr addr, bool isWrite, unsign
             } else {
                 self_link->send(1, new MemCtrlEvent(req));
             }
-            return true;
-        } else {
-            return HBMDRAMSimMemory::issueRequest((ReqId)req, addr, isWrite, numBytes);
+        } else if (!HBMDRAMSimMemory::issueRequest((ReqId)req, addr, isWrite, numBytes)) {
+            delete req;
+            return false;
         }
+        fastAccesses->addData(1);
+        if (inFast) fastHits->addData(1);
     }
+
+    if (hotPages) hotPages->touch(pageAddr);
+    return true;
 }
 
 bool HBMpagedMultiMemory::clock(Cycle_t cycle){
@@ -528,6 +649,8 @@ bool HBMpagedMultiMemory::quantaClock(SST::Cycle_t _cycle) {
 
     lastMin = 0;
 
+    if (hotPages) hotPages->decay();
+
     for (auto p = pageMap.begin(); p != pageMap.end(); ++p) {
       //p->second.touched = p->second.touched >> 4;
       p->second.touched = 0;
@@ -651,6 +774,11 @@ void HBMpagedMultiMemory::swapDone(HBMpageInfo *page, const uint64_t addr) {
 
     // mark page as ready
     page->swapDir = HBMpageInfo::NONE;
+
+    // pages in slow memory are only tracked by the sketch
+    if (hotPages && !page->inFast) {
+        pageMap.erase(pageAddr);
+    }
 }
 
 
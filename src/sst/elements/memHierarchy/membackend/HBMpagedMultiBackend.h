@@ -21,6 +21,8 @@
 
 #include <queue>
 #include <sst/core/rng/rng.h>
+#include "sst/elements/memHierarchy/endpointRegistry.h"
+#include "sst/elements/memHierarchy/membackend/hotPageTracker.h"
 #include "sst/elements/memHierarchy/membackend/HBMdramSimBackend.h"
 
 #ifdef DEBUG
@@ -58,9 +60,9 @@ struct HBMpageInfo {
     // stats
     typedef enum {LT_NEG_ONE, NEG_ONE, ZERO, ONE, GT_ONE, LAST_CASE} AcCases;
     uint64_t accPat[LAST_CASE];
-    set<string> rqstrs; // requestors who have touched this page
+    set<EndpointID> rqstrs; // requestors who have touched this page
 
-    void record( Addr addr, bool isWrite, const std::string& requestor,
+    void record( Addr addr, bool isWrite, EndpointID requestor,
                     const bool collectStats, const uint64_t pAddr, const bool limitTouch) {
 
         // record the pageAddr
@@ -96,7 +98,6 @@ struct HBMpageInfo {
         // is modified to send along the requestor info
         if (1 == collectStats) {
             rqstrs.insert(requestor);
-            //printf("%s\n", requestor.c_str());
         }
 
         if (0 == lastRef) {
@@ -161,18 +162,23 @@ public:
             {"threshold", "Threshold (touches/quantum)", "4"},
             {"scan_threshold", "Scan Threshold (for SC strategies)", "4"},
             {"seed", "RNG Seed", "1447"},
-            {"page_add_strategy", "Page Addition Strategy", "T"},
-            {"page_replace_strategy", "Page Replacement Strategy", "FIFO"},
+            {"page_add_strategy", "Page Addition Strategy: MFU, T, MRPU, MFRPU, SC, SCF, RAND, or HOT (in the sketch's top pages and over threshold)", "T"},
+            {"page_replace_strategy", "Page Replacement Strategy: FIFO, LFU, LFU8, LRU, BiLRU, SCLRU, or HOT (coldest by sketch count among the least recently used fast pages). HOT requires the HOT addition strategy.", "FIFO"},
             {"access_time", "Constant time memory access for \"fast\" memory", "35ns"},
             {"max_fast_pages", "Number of \"fast\" (constant time) pages", "256"},
             {"page_shift", "Size of page (2^x bytes)", "12"},
             {"quantum", "Time period for when page access counts is shifted", "5ms"},
-            {"accStatsPrefix", "File name for acces pattern statistics", ""} )
+            {"accStatsPrefix", "File name for acces pattern statistics", ""},
+            {"sketch_width", "HOT strategies: counters per row of the count-min sketch used to estimate page access counts. Rounded up to a power of 2.", "4096"},
+            {"sketch_depth", "HOT strategies: rows in the count-min sketch", "4"},
+            {"hot_pages", "HOT strategies: number of hottest pages tracked. 0 means max_fast_pages.", "0"},
+            {"victim_sample", "HOT replacement: number of least recently used fast pages considered when choosing a victim", "8"} )
 
     SST_ELI_DOCUMENT_STATISTICS( HBMDRAMSIMMEMORY_ELI_STATS,
             {"fast_hits", "Number of accesses that 'hit' a fast page", "count", 1},
             {"fast_swaps", "Number of pages swapped between 'fast' and 'slow' memory", "count", 1},
-            {"fast_acc", "Number of total accesses to the memory backend", "count", 1},
+            {"fast_acc", "Number of total accesses to the memory backend, excluding slow_acc", "count", 1},
+            {"slow_acc", "Number of accesses to untracked or unpromoted pages sent straight to slow memory (addHOT only)", "count", 1},
             {"t_pages", "Number of total pages", "count", 1},
             {"cant_swap", "Number of times a page could not be swapped in because no victim page could be found because all candidates were swapping", "count", 1},
             {"swap_delays", "Number of an access is delayed because the page is swapping", "count", 1} )
@@ -214,7 +220,8 @@ private:
                   addMFRPU, // threshold + most recent previous add
                   addSC, // thresh + scan detection
                   addSCF, // thresh + scan detection
-                  addRAND // thresh + random
+                  addRAND, // thresh + random
+                  addHOT // thresh + sketch top-K
     } pageAddStrat_t;
     pageAddStrat_t addStrat;
     // replacement / insertion strategy
@@ -224,14 +231,22 @@ private:
                   LRU, // LRU replacement
                   BiLRU, // bimodal LRU
                   SCLRU, // scan aware
+                  HOT, // sketch count, sampled from LRU end
                   LAST_STRAT} pageReplaceStrat_t;
     pageReplaceStrat_t replaceStrat;
 
     bool dramBackpressure;
 
+    // Access counts for HOT strategies. With these, only pages in fast
+    // memory or moving between levels have an entry in pageMap.
+    HotPageTracker *hotPages;
+    uint32_t victimSample;
+
     bool checkAdd(HBMpageInfo &page);
     void do_FIFO_LRU( HBMpageInfo &page, bool &inFast, bool &swapping);
     void do_LFU( Addr, HBMpageInfo &page, bool &inFast, bool &swapping);
+    void do_HOT( HBMpageInfo &page, bool &inFast, bool &swapping);
+    bool issueToSlow(Req *req);
 
     void printAccStats();
     queue<Req *> dramQ;
@@ -302,6 +317,7 @@ public:
     Statistic<uint64_t> *fastHits;
     Statistic<uint64_t> *fastSwaps;
     Statistic<uint64_t> *fastAccesses;
+    Statistic<uint64_t> *slowAccesses;
     Statistic<uint64_t> *tPages;
     Statistic<uint64_t> *cantSwapOut;
     Statistic<uint64_t> *swapDelays;
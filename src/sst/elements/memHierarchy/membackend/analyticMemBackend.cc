@@ -0,0 +1,361 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+#include <sst/core/link.h>
+
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+#include "sst/elements/memHierarchy/util.h"
+#include "membackend/analyticMemBackend.h"
+
+using namespace SST;
+using namespace SST::MemHierarchy;
+
+/* Weight of the newest window in the smoothed features */
+#define WINDOW_WEIGHT 0.5
+
+/* Utilization at which the closed-form queueing term stops growing */
+#define MAX_QUEUE_UTIL 0.95
+
+AnalyticMemory::AnalyticMemory(ComponentId_t id, Params &params) : SimpleMemBackend(id, params),
+    m_windowEnd(0), m_windowBytes(0), m_windowReqs(0), m_windowHits(0), m_windowWrites(0),
+    m_util(0.0), m_hitRate(1.0), m_writeFrac(0.0), m_haveTable(false), m_backend(nullptr)
+{
+    m_timeBase = getTimeConverter("1ps");
+    m_selfLink = configureSelfLink("Self", "1ps", new Event::Handler<AnalyticMemory>(this, &AnalyticMemory::handleSelfEvent));
+
+    UnitAlgebra window = params.find<UnitAlgebra>("window", UnitAlgebra("1us"));
+    if (!window.hasUnits("s") || window.getValue() <= 0) {
+        output->fatal(CALL_INFO, -1, "Invalid param(%s): window - must be a positive time with units of 's' (seconds). You specified '%s'.\n",
+                getName().c_str(), window.toString().c_str());
+    }
+    m_windowPs = (window * UnitAlgebra("1THz")).getRoundedValue();
+    if (m_windowPs == 0) m_windowPs = 1;
+
+    UnitAlgebra bandwidth = params.find<UnitAlgebra>("peak_bandwidth", UnitAlgebra("25.6GB/s"));
+    if (!bandwidth.hasUnits("B/s") || bandwidth.getValue() <= 0) {
+        output->fatal(CALL_INFO, -1, "Invalid param(%s): peak_bandwidth - must be a positive bandwidth with units of 'B/s'. You specified '%s'.\n",
+                getName().c_str(), bandwidth.toString().c_str());
+    }
+    m_peakBytesPerWindow = (bandwidth * window).getDoubleValue();
+
+    // Row-hit model, same address map as simpleDRAM
+    uint64_t banks = params.find<uint64_t>("banks", 16);
+    UnitAlgebra lineSize(params.find<std::string>("bank_interleave_granularity", "64B"));
+    UnitAlgebra rowSize(params.find<std::string>("row_size", "8KiB"));
+    if (!isPowerOfTwo(banks)) {
+        output->fatal(CALL_INFO, -1, "Invalid param(%s): banks - must be a power of two. You specified %" PRIu64 ".\n", getName().c_str(), banks);
+    }
+    if (!lineSize.hasUnits("B") || !isPowerOfTwo(lineSize.getRoundedValue())) {
+        output->fatal(CALL_INFO, -1, "Invalid param(%s): bank_interleave_granularity - must be a power of two with units of 'B' (bytes). You specified '%s'.\n",
+                getName().c_str(), lineSize.toString().c_str());
+    }
+    if (!rowSize.hasUnits("B") || !isPowerOfTwo(rowSize.getRoundedValue())) {
+        output->fatal(CALL_INFO, -1, "Invalid param(%s): row_size - must be a power of two with units of 'B' (bytes). You specified '%s'.\n",
+                getName().c_str(), rowSize.toString().c_str());
+    }
+    m_bankMask = banks - 1;
+    m_bankShift = log2Of(lineSize.getRoundedValue());
+    m_rowShift = log2Of(rowSize.getRoundedValue());
+    m_openRow.resize(banks, (Addr)-1);
+
+    stat_rowHits = registerStatistic<uint64_t>("row_hits");
+    stat_rowMisses = registerStatistic<uint64_t>("row_misses");
+    stat_latency = registerStatistic<uint64_t>("latency");
+    stat_utilization = registerStatistic<uint64_t>("utilization");
+
+    if (params.find<bool>("calibrate", false)) {
+        m_backend = loadUserSubComponent<SimpleMemBackend>("backend");
+        if (!m_backend) {
+            output->fatal(CALL_INFO, -1, "%s, Error: 'calibrate' is set but no backend was loaded into the 'backend' subcomponent slot.\n", getName().c_str());
+        }
+        using std::placeholders::_1;
+        m_backend->setResponseHandler( std::bind( &AnalyticMemory::handleBackendResponse, this, _1 ) );
+        m_backend->setGetRequestorHandler( m_getRequestor );
+        m_memSize = m_backend->getMemSize();
+
+        m_calibrationFile = params.find<std::string>("calibration_output", "analyticMem.samples");
+        m_table.init(params.find<unsigned>("util_points", 11), params.find<unsigned>("hit_points", 5), params.find<unsigned>("write_points", 5));
+        return;
+    }
+
+    std::string table = params.find<std::string>("table", "");
+    if (!table.empty()) {
+        std::string error = m_table.read(table);
+        if (error.empty()) {
+            for (size_t i = 0; i < m_table.latency.size() && error.empty(); i++) {
+                if (m_table.latency[i] < 0)
+                    error = "table has grid points without samples; fit the samples with tools/analyticMem/analyticMemCalibration.py before using them";
+            }
+        }
+        if (!error.empty())
+            output->fatal(CALL_INFO, -1, "%s, Error: unable to load latency table '%s': %s\n", getName().c_str(), table.c_str(), error.c_str());
+        m_haveTable = true;
+        return;
+    }
+
+    UnitAlgebra idle = params.find<UnitAlgebra>("idle_latency", UnitAlgebra("50ns"));
+    UnitAlgebra rowMiss = params.find<UnitAlgebra>("row_miss_penalty", UnitAlgebra("15ns"));
+    UnitAlgebra write = params.find<UnitAlgebra>("write_penalty", UnitAlgebra("0ns"));
+    if (!idle.hasUnits("s") || !rowMiss.hasUnits("s") || !write.hasUnits("s")) {
+        output->fatal(CALL_INFO, -1, "Invalid param(%s): idle_latency, row_miss_penalty, and write_penalty must have units of 's' (seconds).\n", getName().c_str());
+    }
+    m_idleLatency = (idle * UnitAlgebra("1GHz")).getDoubleValue();
+    m_rowMissPenalty = (rowMiss * UnitAlgebra("1GHz")).getDoubleValue();
+    m_writePenalty = (write * UnitAlgebra("1GHz")).getDoubleValue();
+}
+
+void AnalyticMemory::setup() {
+    if (m_backend) m_backend->setup();
+}
+
+void AnalyticMemory::finish() {
+    if (!m_backend) return;
+    m_backend->finish();
+
+    // Merge with samples from earlier runs
+    LatencyTable previous;
+    if (previous.read(m_calibrationFile).empty() && previous.points == m_table.points) {
+        for (size_t i = 0; i < previous.samples.size(); i++) {
+            if (previous.samples[i] != 0)
+                m_table.addSample(i, previous.latency[i], previous.samples[i]);
+        }
+    }
+    if (!m_table.write(m_calibrationFile))
+        output->fatal(CALL_INFO, -1, "%s, Error: unable to write calibration samples to '%s'\n", getName().c_str(), m_calibrationFile.c_str());
+}
+
+bool AnalyticMemory::issueRequest(ReqId id, Addr addr, bool isWrite, unsigned numBytes) {
+    SimTime_t now = getCurrentSimTime(m_timeBase);
+    updateWindow(now);
+
+    if (m_backend) {
+        if (!m_backend->issueRequest(id, addr, isWrite, numBytes))
+            return false;
+        Outstanding &req = m_outstanding[id];
+        req.issueTime = now;
+        req.cell = m_table.nearest(m_util, m_hitRate, m_writeFrac);
+    }
+
+    bool hit = isRowHit(addr);
+    m_windowBytes += numBytes;
+    m_windowReqs++;
+    if (hit) m_windowHits++;
+    if (isWrite) m_windowWrites++;
+
+    if (m_backend) return true;
+
+    double latency;
+    if (m_haveTable) {
+        latency = m_table.lookup(m_util, m_hitRate, m_writeFrac);
+    } else {
+        double util = m_util < MAX_QUEUE_UTIL ? m_util : MAX_QUEUE_UTIL;
+        double service = m_idleLatency + (1.0 - m_hitRate) * m_rowMissPenalty + m_writeFrac * m_writePenalty;
+        latency = service * (1.0 + util / (2.0 * (1.0 - util)));
+    }
+
+#ifdef __SST_DEBUG_OUTPUT__
+    output->debug(_L10_, "%s: Issued transaction for address %" PRIx64 " id %" PRIx64 ", util %.3f, hit rate %.3f, write fraction %.3f, latency %.1fns\n",
+            getName().c_str(), (Addr)addr, id, m_util, m_hitRate, m_writeFrac, latency);
+#endif
+    stat_latency->addData((uint64_t)(latency + 0.5));
+    SimTime_t delay = (SimTime_t)(latency * 1000.0 + 0.5);
+    m_selfLink->send(delay ? delay : 1, new MemCtrlEvent(id));
+    return true;
+}
+
+void AnalyticMemory::handleSelfEvent(SST::Event *event) {
+    MemCtrlEvent *ev = static_cast<MemCtrlEvent*>(event);
+    handleMemResponse(ev->reqId);
+    delete event;
+}
+
+void AnalyticMemory::handleBackendResponse(ReqId id) {
+    std::unordered_map<ReqId,Outstanding>::iterator it = m_outstanding.find(id);
+    if (it == m_outstanding.end())
+        output->fatal(CALL_INFO, -1, "%s, Error: response for unknown request %" PRIx64 "\n", getName().c_str(), id);
+
+    double latency = (getCurrentSimTime(m_timeBase) - it->second.issueTime) / 1000.0;
+    m_table.addSample(it->second.cell, latency);
+    stat_latency->addData((uint64_t)(latency + 0.5));
+    m_outstanding.erase(it);
+
+    handleMemResponse(id);
+}
+
+void AnalyticMemory::updateWindow(SimTime_t now) {
+    if (now < m_windowEnd) return;
+
+    if (m_windowEnd != 0 || m_windowReqs != 0) {
+        double util = m_windowBytes / m_peakBytesPerWindow;
+        m_util = (1.0 - WINDOW_WEIGHT) * m_util + WINDOW_WEIGHT * (util < 1.0 ? util : 1.0);
+        if (m_windowReqs != 0) {
+            m_hitRate = (1.0 - WINDOW_WEIGHT) * m_hitRate + WINDOW_WEIGHT * ((double)m_windowHits / m_windowReqs);
+            m_writeFrac = (1.0 - WINDOW_WEIGHT) * m_writeFrac + WINDOW_WEIGHT * ((double)m_windowWrites / m_windowReqs);
+            stat_utilization->addData((uint64_t)(util * 100.0 + 0.5));
+        }
+    }
+    m_windowBytes = m_windowReqs = m_windowHits = m_windowWrites = 0;
+    m_windowEnd += m_windowPs;
+
+    // Windows with no traffic only decay the utilization
+    if (now >= m_windowEnd) {
+        SimTime_t idle = (now - m_windowEnd) / m_windowPs + 1;
+        m_util *= std::pow(1.0 - WINDOW_WEIGHT, (double)idle);
+        m_windowEnd += idle * m_windowPs;
+    }
+}
+
+bool AnalyticMemory::isRowHit(Addr addr) {
+    Addr &openRow = m_openRow[(addr >> m_bankShift) & m_bankMask];
+    Addr row = addr >> m_rowShift;
+    bool hit = (openRow == row);
+    openRow = row;
+    if (hit)
+        stat_rowHits->addData(1);
+    else
+        stat_rowMisses->addData(1);
+    return hit;
+}
+
+/*------------------------------- Latency table ------------------------------- */
+/*
+ * File format (text):
+ *   # comment lines
+ *   analyticMem 1
+ *   grid <util points> <hit points> <write points>
+ *   <util index> <hit index> <write index> <latency ns> <samples>    one line per grid point
+ * Grid point i of a feature with n points is at i/(n-1). Points without
+ * samples have a negative latency.
+ */
+
+void AnalyticMemory::LatencyTable::init(unsigned util, unsigned hit, unsigned write) {
+    points.clear();
+    points.push_back(util < 2 ? 2 : util);
+    points.push_back(hit < 2 ? 2 : hit);
+    points.push_back(write < 2 ? 2 : write);
+    latency.assign((size_t)points[0] * points[1] * points[2], -1.0);
+    samples.assign(latency.size(), 0);
+}
+
+static unsigned nearestPoint(double x, unsigned points) {
+    if (x <= 0.0) return 0;
+    if (x >= 1.0) return points - 1;
+    return (unsigned)(x * (points - 1) + 0.5);
+}
+
+size_t AnalyticMemory::LatencyTable::nearest(double util, double hit, double write) {
+    return index(nearestPoint(util, points[0]), nearestPoint(hit, points[1]), nearestPoint(write, points[2]));
+}
+
+double AnalyticMemory::LatencyTable::lookup(double util, double hit, double write) {
+    double x[3] = { util, hit, write };
+    unsigned lo[3];
+    double frac[3];
+    for (int d = 0; d < 3; d++) {
+        double pos = (x[d] <= 0.0 ? 0.0 : (x[d] >= 1.0 ? 1.0 : x[d])) * (points[d] - 1);
+        lo[d] = (unsigned)pos;
+        if (lo[d] >= points[d] - 1) lo[d] = points[d] - 2;
+        frac[d] = pos - lo[d];
+    }
+
+    // Trilinear interpolation between the 8 surrounding grid points
+    double result = 0.0;
+    for (int corner = 0; corner < 8; corner++) {
+        double weight = 1.0;
+        unsigned i[3];
+        for (int d = 0; d < 3; d++) {
+            bool upper = corner & (1 << d);
+            i[d] = lo[d] + (upper ? 1 : 0);
+            weight *= upper ? frac[d] : 1.0 - frac[d];
+        }
+        if (weight != 0.0)
+            result += weight * latency[index(i[0], i[1], i[2])];
+    }
+    return result;
+}
+
+void AnalyticMemory::LatencyTable::addSample(size_t i, double lat, uint64_t count) {
+    if (samples[i] == 0) {
+        latency[i] = lat;
+    } else {
+        latency[i] = (latency[i] * samples[i] + lat * count) / (samples[i] + count);
+    }
+    samples[i] += count;
+}
+
+std::string AnalyticMemory::LatencyTable::read(const std::string &file) {
+    std::ifstream in(file.c_str());
+    if (!in.is_open()) return "unable to open file";
+
+    std::string line;
+    bool haveHeader = false;
+    size_t filled = 0;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream str(line);
+        if (!haveHeader) {
+            std::string magic;
+            int version;
+            if (!(str >> magic >> version) || magic != "analyticMem" || version != 1)
+                return "not an analyticMem version 1 table";
+            haveHeader = true;
+            continue;
+        }
+        if (points.empty()) {
+            std::string keyword;
+            unsigned u, h, w;
+            if (!(str >> keyword >> u >> h >> w) || keyword != "grid" || u < 2 || h < 2 || w < 2)
+                return "missing or invalid 'grid' line";
+            init(u, h, w);
+            continue;
+        }
+        unsigned u, h, w;
+        double lat;
+        uint64_t count;
+        if (!(str >> u >> h >> w >> lat >> count) || u >= points[0] || h >= points[1] || w >= points[2])
+            return "invalid grid point: '" + line + "'";
+        size_t i = index(u, h, w);
+        latency[i] = lat;
+        samples[i] = count;
+        filled++;
+    }
+    if (points.empty()) return "missing 'grid' line";
+    if (filled != latency.size()) return "table does not list every grid point";
+    return "";
+}
+
+bool AnalyticMemory::LatencyTable::write(const std::string &file) {
+    std::ofstream out(file.c_str());
+    if (!out.is_open()) return false;
+    out << "# analyticMem latency table: util hit write latency(ns) samples\n";
+    out.precision(10);
+    out << "analyticMem 1\n";
+    out << "grid " << points[0] << " " << points[1] << " " << points[2] << "\n";
+    for (unsigned u = 0; u < points[0]; u++) {
+        for (unsigned h = 0; h < points[1]; h++) {
+            for (unsigned w = 0; w < points[2]; w++) {
+                size_t i = index(u, h, w);
+                out << u << " " << h << " " << w << " " << latency[i] << " " << samples[i] << "\n";
+            }
+        }
+    }
+    out.close();
+    return !out.fail();
+}
@@ -0,0 +1,179 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_MEMH_ANALYTIC_MEM_BACKEND
+#define _H_SST_MEMH_ANALYTIC_MEM_BACKEND
+
+#include <sst/core/timeConverter.h>
+
+#include <unordered_map>
+#include <vector>
+
+#include "sst/elements/memHierarchy/membackend/memBackend.h"
+
+namespace SST {
+namespace MemHierarchy {
+
+/*
+ * Load-aware analytical memory model
+ *
+ * Latency is looked up from a table indexed by three features of recent
+ * traffic, each measured over a 'window' and smoothed across windows:
+ *   - bandwidth utilization (bytes requested / peak_bandwidth)
+ *   - row-hit rate, using an open-row model of 'banks' banks
+ *   - fraction of requests that are writes
+ * The table is a uniform grid over [0,1] for each feature. Lookups
+ * interpolate between grid points. Each request costs a few arithmetic
+ * operations and one self-link event, the same as simpleMem.
+ *
+ * Tables come from a detailed backend. With 'calibrate' set, this backend
+ * forwards every request to its 'backend' subcomponent and records the
+ * measured latency at the grid point nearest the features at issue time.
+ * The samples are merged into 'calibration_output' at the end of the run.
+ * tools/analyticMem/analyticMemCalibration.py sweeps standardCPU traffic over a detailed
+ * backend in this mode, then fits the samples into a complete table.
+ *
+ * Without a table, latency is 'idle_latency' plus a row-miss and write
+ * penalty, stretched by an M/D/1 queueing term in the utilization.
+ */
+class AnalyticMemory : public SimpleMemBackend {
+public:
+/* Element Library Info */
+    SST_ELI_REGISTER_SUBCOMPONENT(AnalyticMemory, "memHierarchy", "analyticMem", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "Fast memory timing model with latency that depends on bandwidth utilization, row-hit rate, and read/write mix", SST::MemHierarchy::SimpleMemBackend)
+
+    SST_ELI_DOCUMENT_PARAMS( MEMBACKEND_ELI_PARAMS,
+            /* Own parameters */
+            {"table",               "(string) Latency table produced by tools/analyticMem/analyticMemCalibration.py. If not set, a closed-form model is used.", ""},
+            {"peak_bandwidth",      "(string) Peak bandwidth of the modeled memory, used to compute utilization. With units (SI ok).", "25.6GB/s"},
+            {"window",              "(string) Time over which utilization, row-hit rate, and write fraction are measured. With units (SI ok).", "1us"},
+            {"idle_latency",        "(string) Without a table: latency of a row hit on an idle memory. With units (SI ok).", "50ns"},
+            {"row_miss_penalty",    "(string) Without a table: additional latency when no requests hit an open row. With units (SI ok).", "15ns"},
+            {"write_penalty",       "(string) Without a table: additional latency when all requests are writes. With units (SI ok).", "0ns"},
+            {"banks",               "(uint) Number of banks modeled for the row-hit rate. Must be a power of 2.", "16"},
+            {"bank_interleave_granularity", "(string) Granularity of interleaving across banks in bytes (B). Must be a power of 2.", "64B"},
+            {"row_size",            "(string) Size of a row in bytes (B). Must be a power of 2.", "8KiB"},
+            {"calibrate",           "(bool) Forward requests to the 'backend' subcomponent and record its latencies instead of modeling them", "false"},
+            {"calibration_output",  "(string) Calibration: file to write samples to. Samples are merged into the file if it already exists.", "analyticMem.samples"},
+            {"util_points",         "(uint) Calibration: number of grid points for utilization", "11"},
+            {"hit_points",          "(uint) Calibration: number of grid points for row-hit rate", "5"},
+            {"write_points",        "(uint) Calibration: number of grid points for write fraction", "5"} )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+            {"row_hits",    "Requests that hit the open row in the row-hit model", "count", 1},
+            {"row_misses",  "Requests that missed the open row in the row-hit model", "count", 1},
+            {"latency",     "Latency of each request (modeled, or measured when calibrating)", "ns", 1},
+            {"utilization", "Bandwidth utilization of each window with traffic", "percent", 1} )
+
+    SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS( {"backend", "Calibration: detailed backend to measure", "SST::MemHierarchy::SimpleMemBackend"} )
+
+/* Begin class definition */
+    AnalyticMemory(ComponentId_t id, Params &params);
+    bool issueRequest( ReqId, Addr, bool, unsigned );
+    virtual bool isClocked() { return m_backend ? m_backend->isClocked() : false; }
+    virtual bool clock(Cycle_t cycle) { return m_backend ? m_backend->clock(cycle) : true; }
+    virtual void setup();
+    virtual void finish();
+
+    class MemCtrlEvent : public SST::Event {
+    public:
+        MemCtrlEvent( ReqId id_) : SST::Event(), reqId(id_)
+        { }
+
+        ReqId reqId;
+
+    private:
+        MemCtrlEvent() {} // For Serialization only
+
+    public:
+        void serialize_order(SST::Core::Serialization::serializer &ser)  override {
+            Event::serialize_order(ser);
+            ser & reqId;
+       }
+
+        ImplementSerializable(SST::MemHierarchy::AnalyticMemory::MemCtrlEvent);
+    };
+
+    /* Latency (ns) at each grid point, plus the number of samples behind it */
+    struct LatencyTable {
+        std::vector<unsigned> points;   // Grid points per feature: utilization, row-hit rate, write fraction
+        std::vector<double> latency;    // Negative if there are no samples
+        std::vector<uint64_t> samples;
+
+        void init( unsigned util, unsigned hit, unsigned write );
+        size_t index( unsigned u, unsigned h, unsigned w ) { return ((size_t)u * points[1] + h) * points[2] + w; }
+        size_t nearest( double util, double hit, double write );
+        double lookup( double util, double hit, double write );
+        void addSample( size_t index, double latency, uint64_t count = 1 );
+        std::string read( const std::string &file );    // Returns an error description, empty on success
+        bool write( const std::string &file );
+    };
+
+private:
+    void handleSelfEvent(SST::Event *event);
+    void handleBackendResponse(ReqId id);
+
+    /* Advance the measurement windows to 'now' */
+    void updateWindow( SimTime_t now );
+    bool isRowHit( Addr addr );
+
+    Link*           m_selfLink;
+    TimeConverter*  m_timeBase;         // Simulation time in ps
+
+    // Features of recent traffic
+    SimTime_t   m_windowPs;
+    SimTime_t   m_windowEnd;
+    double      m_peakBytesPerWindow;
+    uint64_t    m_windowBytes;
+    uint64_t    m_windowReqs;
+    uint64_t    m_windowHits;
+    uint64_t    m_windowWrites;
+    double      m_util;
+    double      m_hitRate;
+    double      m_writeFrac;
+
+    // Row-hit model
+    std::vector<Addr> m_openRow;
+    uint64_t    m_bankMask;
+    unsigned    m_bankShift;
+    unsigned    m_rowShift;
+
+    // Latency model
+    bool        m_haveTable;
+    LatencyTable m_table;
+    double      m_idleLatency;      // ns, closed-form model only
+    double      m_rowMissPenalty;
+    double      m_writePenalty;
+
+    // Calibration
+    SimpleMemBackend* m_backend;
+    std::string m_calibrationFile;
+    struct Outstanding {
+        SimTime_t issueTime;
+        size_t cell;
+    };
+    std::unordered_map<ReqId,Outstanding> m_outstanding;
+
+    Statistic<uint64_t>* stat_rowHits;
+    Statistic<uint64_t>* stat_rowMisses;
+    Statistic<uint64_t>* stat_latency;
+    Statistic<uint64_t>* stat_utilization;
+};
+
+}
+}
+
+#endif
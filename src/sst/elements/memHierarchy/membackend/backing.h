@@ -19,12 +19,33 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <sys/mman.h>
+#include <string.h>
+#include <algorithm>
 #include "sst/elements/memHierarchy/util.h"
+#include "sst/elements/memHierarchy/membackend/backingImage.h"
 
 namespace SST {
 namespace MemHierarchy {
 namespace Backend {
 
+/* Read-only view of contiguous backing store bytes (std::span-style) */
+class BackingSpan {
+public:
+    BackingSpan() : m_data(nullptr), m_size(0) { }
+    BackingSpan(const uint8_t* data, size_t size) : m_data(data), m_size(size) { }
+
+    const uint8_t* data() const { return m_data; }
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    const uint8_t& operator[](size_t i) const { return m_data[i]; }
+    const uint8_t* begin() const { return m_data; }
+    const uint8_t* end() const { return m_data + m_size; }
+
+private:
+    const uint8_t* m_data;
+    size_t m_size;
+};
+
 class Backing {
 public:
     Backing( ) { }
@@ -35,6 +56,19 @@ public:
 
     virtual uint8_t get( Addr addr) = 0;
     virtual void get( Addr addr, size_t size, std::vector<uint8_t>& data) = 0;
+
+    /* Zero-copy read of up to 'size' bytes at 'addr'. The returned span is
+     * shorter than 'size' if the range is not contiguous in the backing store
+     * (e.g., crosses a BackingMalloc chunk); callers loop on the remainder.
+     * The span is invalidated by any later set() to the same bytes.
+     */
+    virtual BackingSpan getSpan( Addr addr, size_t size ) = 0;
+
+    /* Snapshot contents to a sparse image (see backingImage.h). Returns false on an I/O error */
+    virtual bool saveImage( const std::string &file ) = 0;
+
+    /* Overwrite contents with those in an image. Image pages are read lazily where possible */
+    virtual void loadImage( const std::string &file ) = 0;
 };
 
 class BackingMMAP : public Backing {
@@ -54,6 +88,11 @@ public:
         if ( m_buffer == MAP_FAILED) {
             throw 2;
         }
+
+        // Largest power of two (up to the image alignment) that evenly divides the mapping
+        m_chunkSize = std::min((uint64_t)BackingImage::IMAGE_ALIGN, (uint64_t)(m_size & -m_size));
+        if (m_fd == -1)
+            m_touched.resize((m_size / m_chunkSize + 63) / 64, 0);
     }
 
     ~BackingMMAP() {
@@ -64,12 +103,13 @@ public:
     }
 
     void set( Addr addr, uint8_t value ) {
+        touch(addr - m_offset, 1);
         m_buffer[addr - m_offset ] = value;
     }
 
     void set (Addr addr, size_t size, std::vector<uint8_t> &data) {
-        for (size_t i = 0; i < size; i++)
-            m_buffer[addr + i] = data[i];
+        touch(addr - m_offset, size);
+        memcpy(m_buffer + (addr - m_offset), data.data(), size);
     }
 
     uint8_t get( Addr addr ) {
@@ -77,17 +117,85 @@ public:
     }
 
     void get( Addr addr, size_t size, std::vector<uint8_t> &data) {
-        for (size_t i = 0; i < size; i++)
-            data[i] = m_buffer[addr + i];
+        memcpy(data.data(), m_buffer + (addr - m_offset), size);
+    }
+
+    BackingSpan getSpan( Addr addr, size_t size ) {
+        return BackingSpan(m_buffer + (addr - m_offset), size);
+    }
+
+    bool saveImage( const std::string &file ) {
+        std::vector<std::pair<Addr, const uint8_t*> > chunks;
+        for (size_t off = 0; off < m_size; off += m_chunkSize) {
+            // Anonymous chunks that were never written or restored read as zero, skip them
+            if (m_fd == -1 && !touched(off / m_chunkSize))
+                continue;
+            chunks.push_back(std::make_pair(off + m_offset, m_buffer + off));
+        }
+        return BackingImage::write(file, m_chunkSize, chunks);
+    }
+
+    void loadImage( const std::string &file ) {
+        BackingImage image(file);
+        uint64_t chunkSize = image.chunkSize();
+        size_t pageSize = sysconf(_SC_PAGESIZE);
+
+        uint64_t i = 0;
+        while (i < image.numChunks()) {
+            Addr addr = image.chunkAddr(i);
+            if (addr < m_offset || addr - m_offset + chunkSize > m_size) {
+                Output out("", 1, 0, Output::STDOUT);
+                out.fatal(CALL_INFO, -1, "BackingMMAP: Error - image '%s' contains address 0x%" PRIx64 " which is outside this backing store.\n",
+                        file.c_str(), addr);
+            }
+            // Coalesce chunks that are contiguous in both memory and the image
+            uint64_t run = 1;
+            while (i + run < image.numChunks() && image.chunkAddr(i + run) == addr + run * chunkSize)
+                run++;
+
+            uint8_t* dst = m_buffer + (addr - m_offset);
+            size_t len = run * chunkSize;
+            bool mapped = false;
+            // Anonymous store: map the image pages copy-on-write in place so they are only read when touched
+            if (m_fd == -1 && ((uintptr_t)dst % pageSize) == 0 && (chunkSize % pageSize) == 0 && (image.fileOffset(i) % pageSize) == 0)
+                mapped = mmap(dst, len, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_FIXED, image.fd(), image.fileOffset(i)) != MAP_FAILED;
+            if (!mapped)
+                memcpy(dst, image.chunkData(i), len);
+            touch(addr - m_offset, len);
+            i += run;
+        }
     }
 
 private:
+    /* Record the chunks that may hold non-zero data. Residency (mincore) is not enough: swapped-out
+     * pages and pages mapped from a loaded image but not yet read are not resident either. */
+    void touch( size_t off, size_t len ) {
+        if (m_touched.empty() || len == 0)
+            return;
+        for (uint64_t c = off / m_chunkSize; c <= (off + len - 1) / m_chunkSize; c++)
+            m_touched[c / 64] |= (uint64_t)1 << (c % 64);
+    }
+
+    bool touched( uint64_t chunk ) {
+        return (m_touched[chunk / 64] >> (chunk % 64)) & 1;
+    }
+
     uint8_t* m_buffer;
     int m_fd;
-    int m_size;
+    size_t m_size;
     size_t m_offset;
+    uint64_t m_chunkSize;
+    std::vector<uint64_t> m_touched;    // Anonymous mappings only: bit per chunk written or restored since creation
 };
 
+/*
+ * Sparse backing store allocated in power-of-two chunks on first touch
+ *
+ * Chunks are located through a radix table (RADIX_BITS of the chunk number
+ * per level, like a page table) and the most recent translation is cached,
+ * so streaming accesses within a chunk skip the walk entirely. Multi-byte
+ * accesses are split at chunk boundaries and copied with memcpy.
+ */
 class BackingMalloc : public Backing {
 public:
     BackingMalloc(size_t size, bool init = false ) : m_init(init) {
@@ -98,78 +206,168 @@ public:
             out.fatal(CALL_INFO, -1, "BackingMalloc: Error - size must be a power of two. Got: %zu\n", size);
         }
         m_shift = log2Of(m_allocUnit);
+        m_levels = (64 - m_shift + RADIX_BITS - 1) / RADIX_BITS;
+        m_root = allocNode();
+        m_lastChunk = 0;
+        m_lastData = nullptr;
+        m_image = nullptr;
+    }
+
+    ~BackingMalloc() {
+        freeNode(m_root, m_levels - 1);
+        if (m_image)
+            delete m_image;
     }
 
     void set( Addr addr, uint8_t value ) {
-        Addr bAddr = addr >> m_shift;
-        Addr offset = addr - (bAddr << m_shift);
-        allocIfNeeded(bAddr);
-        m_buffer[bAddr][offset] = value;
+        Addr offset = addr & (m_allocUnit - 1);
+        chunk(addr >> m_shift)[offset] = value;
     }
 
     void set( Addr addr, size_t size, std::vector<uint8_t> &data ) {
-        /* Account for size exceeding alloc unit size */
-        Addr bAddr = addr >> m_shift;
-        Addr offset = addr - (bAddr << m_shift);
-        size_t dataOffset = 0;
-
-        allocIfNeeded(bAddr);
-
-        while (dataOffset != size) {
-            m_buffer[bAddr][offset] = data[dataOffset];
-            offset++;
-            dataOffset++;
-
-            if (offset == m_allocUnit) {
-                offset = 0;
-                bAddr++;
-                allocIfNeeded(bAddr);
-            }
+        const uint8_t* src = data.data();
+        while (size > 0) {
+            Addr offset = addr & (m_allocUnit - 1);
+            size_t len = std::min(size, (size_t)(m_allocUnit - offset));
+            memcpy(chunk(addr >> m_shift) + offset, src, len);
+            addr += len;
+            src += len;
+            size -= len;
         }
     }
 
     void get (Addr addr, size_t size, std::vector<uint8_t> &data) {
-        Addr bAddr = addr >> m_shift;
-        Addr offset = addr - (bAddr << m_shift);
-        size_t dataOffset = 0;
-
-        allocIfNeeded(bAddr);
-
-        while (dataOffset != size) {
-            data[dataOffset] = m_buffer[bAddr][offset];
-            offset++;
-            dataOffset++;
-            if (offset == m_allocUnit) {
-                bAddr++;
-                offset = 0;
-                allocIfNeeded(bAddr);
-            }
+        uint8_t* dst = data.data();
+        while (size > 0) {
+            Addr offset = addr & (m_allocUnit - 1);
+            size_t len = std::min(size, (size_t)(m_allocUnit - offset));
+            memcpy(dst, chunk(addr >> m_shift) + offset, len);
+            addr += len;
+            dst += len;
+            size -= len;
         }
     }
 
     uint8_t get( Addr addr ) {
-        Addr bAddr = addr >> m_shift;
-        Addr offset = addr - (bAddr << m_shift);
-        allocIfNeeded(bAddr);
-        return m_buffer[bAddr][offset];
+        Addr offset = addr & (m_allocUnit - 1);
+        return chunk(addr >> m_shift)[offset];
     }
 
-private:
-    void allocIfNeeded(Addr bAddr) {
-        if (m_buffer.find(bAddr) == m_buffer.end()) {
-            uint8_t* data = (uint8_t*) malloc(sizeof(uint8_t)*m_allocUnit);
-            if ( m_init ) {
-                bzero( data, m_allocUnit );
+    BackingSpan getSpan( Addr addr, size_t size ) {
+        Addr offset = addr & (m_allocUnit - 1);
+        return BackingSpan(chunk(addr >> m_shift) + offset, std::min(size, (size_t)(m_allocUnit - offset)));
+    }
+
+    bool saveImage( const std::string &file ) {
+        // Fault in any image contents that were never touched so they are carried forward
+        if (m_image) {
+            for (uint64_t i = 0; i < m_image->numChunks(); i++) {
+                Addr end = m_image->chunkAddr(i) + m_image->chunkSize();
+                for (Addr addr = m_image->chunkAddr(i); addr < end; addr += m_allocUnit)
+                    chunk(addr >> m_shift);
             }
-            if (!data) {
-                Output out("", 1, 0, Output::STDOUT);
-                out.fatal(CALL_INFO, -1, "BackingMalloc: Error - malloc failed.\n");
+        }
+        std::vector<std::pair<Addr, const uint8_t*> > chunks;
+        collectChunks(m_root, m_levels - 1, 0, chunks);
+        return BackingImage::write(file, m_allocUnit, chunks);
+    }
+
+    /* Chunks are filled from the image when first touched; any already allocated are filled now */
+    void loadImage( const std::string &file ) {
+        if (m_image)
+            delete m_image;
+        m_image = new BackingImage(file);
+
+        std::vector<std::pair<Addr, const uint8_t*> > chunks;
+        collectChunks(m_root, m_levels - 1, 0, chunks);
+        for (size_t i = 0; i < chunks.size(); i++)
+            m_image->copyRange(chunks[i].first, m_allocUnit, const_cast<uint8_t*>(chunks[i].second));
+    }
+
+private:
+    static constexpr unsigned int RADIX_BITS = 9;
+    static constexpr unsigned int RADIX_SIZE = 1 << RADIX_BITS;
+
+    struct Node {
+        void* child[RADIX_SIZE];   // Node* above the last level, chunk data at the last level
+    };
+
+    /* Translate a chunk number to its data, allocating on first touch */
+    uint8_t* chunk(Addr bAddr) {
+        if (m_lastData && bAddr == m_lastChunk)
+            return m_lastData;
+
+        Node* node = m_root;
+        for (unsigned int level = m_levels - 1; level > 0; level--) {
+            void* &next = node->child[(bAddr >> (level * RADIX_BITS)) & (RADIX_SIZE - 1)];
+            if (!next)
+                next = allocNode();
+            node = (Node*)next;
+        }
+        void* &data = node->child[bAddr & (RADIX_SIZE - 1)];
+        if (!data) {
+            data = allocChunk();
+            if (m_image) {
+                if (!m_init)
+                    bzero(data, m_allocUnit);
+                m_image->copyRange(bAddr << m_shift, m_allocUnit, (uint8_t*)data);
             }
-            m_buffer[bAddr] = data;
         }
+
+        m_lastChunk = bAddr;
+        m_lastData = (uint8_t*)data;
+        return m_lastData;
+    }
+
+    Node* allocNode() {
+        Node* node = (Node*) calloc(1, sizeof(Node));
+        if (!node) {
+            Output out("", 1, 0, Output::STDOUT);
+            out.fatal(CALL_INFO, -1, "BackingMalloc: Error - malloc failed.\n");
+        }
+        return node;
+    }
+
+    uint8_t* allocChunk() {
+        uint8_t* data = (uint8_t*) malloc(sizeof(uint8_t)*m_allocUnit);
+        if (!data) {
+            Output out("", 1, 0, Output::STDOUT);
+            out.fatal(CALL_INFO, -1, "BackingMalloc: Error - malloc failed.\n");
+        }
+        if ( m_init ) {
+            bzero( data, m_allocUnit );
+        }
+        return data;
+    }
+
+    /* Gather allocated chunks in address order */
+    void collectChunks(Node* node, unsigned int level, Addr prefix, std::vector<std::pair<Addr, const uint8_t*> > &chunks) {
+        for (unsigned int i = 0; i < RADIX_SIZE; i++) {
+            if (!node->child[i]) continue;
+            Addr bAddr = (prefix << RADIX_BITS) | i;
+            if (level == 0)
+                chunks.push_back(std::make_pair(bAddr << m_shift, (const uint8_t*)node->child[i]));
+            else
+                collectChunks((Node*)node->child[i], level - 1, bAddr, chunks);
+        }
+    }
+
+    void freeNode(Node* node, unsigned int level) {
+        for (unsigned int i = 0; i < RADIX_SIZE; i++) {
+            if (!node->child[i]) continue;
+            if (level == 0)
+                free(node->child[i]);
+            else
+                freeNode((Node*)node->child[i], level - 1);
+        }
+        free(node);
     }
 
-    std::unordered_map<Addr,uint8_t*> m_buffer;
+    Node* m_root;
+    unsigned int m_levels;
+    Addr m_lastChunk;
+    uint8_t* m_lastData;
+    BackingImage* m_image;      // Image contents not yet copied into chunks, if loaded
     unsigned int m_allocUnit;
     unsigned int m_shift;
     bool m_init;
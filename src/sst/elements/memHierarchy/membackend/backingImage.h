@@ -0,0 +1,178 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef __SST_MEMH_BACKEND_BACKINGIMAGE
+#define __SST_MEMH_BACKEND_BACKINGIMAGE
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <vector>
+#include "sst/elements/memHierarchy/util.h"
+
+namespace SST {
+namespace MemHierarchy {
+namespace Backend {
+
+/*
+ * Sparse on-disk image of a backing store
+ *
+ * Layout (host byte order):
+ *   Header      magic "SSTMEMIM", version, chunk size, chunk count, data offset
+ *   Index       one uint64_t start address per chunk, ascending
+ *   Data        chunk i at dataOffset + i * chunkSize; dataOffset is aligned to
+ *               IMAGE_ALIGN so that page-multiple chunks can be mmap'd in place
+ *
+ * Only chunks that were touched (and are not all zero) are written. Readers
+ * mmap the file, so restoring only reads the pages that are actually used.
+ * Addresses are the backing store's local addresses.
+ */
+class BackingImage {
+public:
+    static constexpr uint32_t VERSION = 1;
+    static constexpr uint64_t IMAGE_ALIGN = 65536;
+
+    struct Header {
+        char     magic[8];
+        uint32_t version;
+        uint32_t reserved;
+        uint64_t chunkSize;
+        uint64_t numChunks;
+        uint64_t dataOffset;
+    };
+
+    /* Open and map an existing image. Fatal on error. */
+    BackingImage(const std::string &file) : m_file(file), m_map(nullptr), m_mapSize(0) {
+        m_fd = open(file.c_str(), O_RDONLY);
+        if (m_fd < 0)
+            error("unable to open image file");
+
+        struct stat st;
+        if (fstat(m_fd, &st) != 0 || (size_t)st.st_size < sizeof(Header))
+            error("image file is truncated");
+        m_mapSize = st.st_size;
+
+        m_map = (uint8_t*)mmap(NULL, m_mapSize, PROT_READ, MAP_PRIVATE, m_fd, 0);
+        if (m_map == MAP_FAILED)
+            error("unable to mmap image file");
+
+        memcpy(&m_header, m_map, sizeof(Header));
+        if (memcmp(m_header.magic, "SSTMEMIM", 8) != 0)
+            error("not a memory image");
+        if (m_header.version != VERSION)
+            error("unsupported image version");
+        if (m_header.chunkSize == 0 || sizeof(Header) + m_header.numChunks * sizeof(uint64_t) > m_header.dataOffset ||
+                m_header.dataOffset + m_header.numChunks * m_header.chunkSize > m_mapSize)
+            error("corrupt image header");
+
+        m_index = (const uint64_t*)(m_map + sizeof(Header));
+    }
+
+    ~BackingImage() {
+        if (m_map && m_map != MAP_FAILED)
+            munmap(m_map, m_mapSize);
+        if (m_fd >= 0)
+            close(m_fd);
+    }
+
+    uint64_t chunkSize() const { return m_header.chunkSize; }
+    uint64_t numChunks() const { return m_header.numChunks; }
+    Addr chunkAddr(uint64_t i) const { return m_index[i]; }
+    const uint8_t* chunkData(uint64_t i) const { return m_map + fileOffset(i); }
+    uint64_t fileOffset(uint64_t i) const { return m_header.dataOffset + i * m_header.chunkSize; }
+    int fd() const { return m_fd; }
+
+    /* Copy the imaged bytes that overlap [addr, addr+size) into dst; bytes not in the image are left alone */
+    void copyRange(Addr addr, size_t size, uint8_t* dst) const {
+        Addr end = addr + size;
+        // First chunk that ends after addr
+        const uint64_t* it = std::upper_bound(m_index, m_index + m_header.numChunks, addr);
+        if (it != m_index && *(it - 1) + m_header.chunkSize > addr)
+            it--;
+        for (; it != m_index + m_header.numChunks && *it < end; it++) {
+            Addr lo = std::max(addr, (Addr)*it);
+            Addr hi = std::min(end, (Addr)(*it + m_header.chunkSize));
+            memcpy(dst + (lo - addr), chunkData(it - m_index) + (lo - *it), hi - lo);
+        }
+    }
+
+    /*
+     * Write an image. 'chunks' holds (start address, data) pairs sorted by address,
+     * each 'chunkSize' bytes long. All-zero chunks are dropped.
+     * Returns false on an I/O error.
+     */
+    static bool write(const std::string &file, uint64_t chunkSize, const std::vector<std::pair<Addr, const uint8_t*> > &chunks) {
+        std::vector<uint64_t> index;
+        std::vector<const uint8_t*> data;
+        index.reserve(chunks.size());
+        data.reserve(chunks.size());
+        for (size_t i = 0; i < chunks.size(); i++) {
+            if (isZero(chunks[i].second, chunkSize)) continue;
+            index.push_back(chunks[i].first);
+            data.push_back(chunks[i].second);
+        }
+
+        Header header;
+        memcpy(header.magic, "SSTMEMIM", 8);
+        header.version = VERSION;
+        header.reserved = 0;
+        header.chunkSize = chunkSize;
+        header.numChunks = index.size();
+        header.dataOffset = sizeof(Header) + index.size() * sizeof(uint64_t);
+        if (!index.empty())
+            header.dataOffset = (header.dataOffset + IMAGE_ALIGN - 1) & ~(IMAGE_ALIGN - 1);
+
+        FILE* fp = fopen(file.c_str(), "wb");
+        if (!fp) return false;
+        bool ok = fwrite(&header, sizeof(Header), 1, fp) == 1;
+        if (ok && !index.empty())
+            ok = fwrite(index.data(), sizeof(uint64_t), index.size(), fp) == index.size();
+        if (ok)
+            ok = fseek(fp, header.dataOffset, SEEK_SET) == 0;
+        for (size_t i = 0; ok && i < data.size(); i++)
+            ok = fwrite(data[i], 1, chunkSize, fp) == chunkSize;
+        ok = (fclose(fp) == 0) && ok;
+        return ok;
+    }
+
+private:
+    static bool isZero(const uint8_t* data, uint64_t size) {
+        for (uint64_t i = 0; i < size; i++)
+            if (data[i]) return false;
+        return true;
+    }
+
+    void error(const char* msg) {
+        Output out("", 1, 0, Output::STDOUT);
+        out.fatal(CALL_INFO, -1, "BackingImage: Error - %s: '%s'.\n", msg, m_file.c_str());
+    }
+
+    std::string m_file;
+    int m_fd;
+    uint8_t* m_map;
+    size_t m_mapSize;
+    Header m_header;
+    const uint64_t* m_index;
+};
+
+}
+}
+}
+
+#endif
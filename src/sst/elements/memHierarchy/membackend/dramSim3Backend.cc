@@ -51,10 +51,21 @@ bool DRAMSim3Memory::issueRequest(ReqId id, Addr addr, bool isWrite, unsigned ){
     return true;
 }
 
+size_t DRAMSim3Memory::issueRequests(const std::vector<BackendReq>& reqs, unsigned numBytes){
+    size_t issued = 0;
+    while (issued < reqs.size() && DRAMSim3Memory::issueRequest(reqs[issued].id, reqs[issued].addr, reqs[issued].isWrite, numBytes))
+        issued++;
+    return issued;
+}
+
 
 
 bool DRAMSim3Memory::clock(Cycle_t cycle){
     memSystem->ClockTick();
+    if (!completedReqs.empty()) {
+        handleMemResponses(completedReqs);
+        completedReqs.clear();
+    }
     return false;
 }
 
@@ -78,5 +89,5 @@ void DRAMSim3Memory::dramSimDone(unsigned int id, uint64_t addr, uint64_t clockc
     if(0 == reqs.size())
         dramReqs.erase(addr);
 
-    handleMemResponse(reqId);
+    completedReqs.push_back(reqId);
 }
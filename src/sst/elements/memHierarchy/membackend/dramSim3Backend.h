@@ -52,6 +52,7 @@ public:
     DRAMSim3Memory(ComponentId_t id, Params &params);
 
     virtual bool issueRequest(ReqId, Addr, bool, unsigned );
+    virtual size_t issueRequests(const std::vector<BackendReq>& reqs, unsigned numBytes);
     virtual bool clock(Cycle_t cycle);
     virtual void finish();
 
@@ -60,6 +61,7 @@ protected:
 
     dramsim3::MemorySystem *memSystem;
     std::map<uint64_t, std::deque<ReqId> > dramReqs;
+    std::vector<ReqId> completedReqs;   // Completed during this clock, returned together
 
 private:
     std::function<void(uint64_t)> readCB;
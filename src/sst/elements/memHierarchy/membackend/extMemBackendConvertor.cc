@@ -37,6 +37,8 @@ ExtMemBackendConvertor::ExtMemBackendConvertor(ComponentId_t id, Params &params,
     using std::placeholders::_1;
     using std::placeholders::_2;
     static_cast<ExtMemBackend*>(m_backend)->setResponseHandler( std::bind( &ExtMemBackendConvertor::handleMemResponse, this, _1,_2 ) );
+    static_cast<ExtMemBackend*>(m_backend)->setResponseBatchHandler( std::bind( &ExtMemBackendConvertor::handleMemResponses, this, _1 ) );
+    m_batchIssue = true;
 }
 
 bool ExtMemBackendConvertor::issue( BaseReq *req ) {
@@ -60,4 +62,8 @@ bool ExtMemBackendConvertor::issue( BaseReq *req ) {
     }
 }
 
+size_t ExtMemBackendConvertor::issueBatch( std::vector<BackendReq>& reqs ) {
+    return static_cast<ExtMemBackend*>(m_backend)->issueRequests( reqs, m_backendRequestWidth );
+}
+
 // EOF
@@ -36,9 +36,14 @@ public:
     ExtMemBackendConvertor(ComponentId_t id, Params &params, MemBackend* backend, uint32_t reqWidth);
 
     virtual bool issue( BaseReq* req );
+    virtual size_t issueBatch( std::vector<BackendReq>& reqs );
     virtual void handleMemResponse( ReqId reqId, uint32_t flags  ) {
         doResponse( reqId, flags );
     }
+    virtual void handleMemResponses( const std::vector<std::pair<ReqId,uint32_t> >& resps ) {
+        for (std::vector<std::pair<ReqId,uint32_t> >::const_iterator it = resps.begin(); it != resps.end(); it++)
+            doResponse( it->first, it->second );
+    }
 };
 
 }
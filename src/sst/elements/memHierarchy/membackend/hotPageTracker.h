@@ -0,0 +1,190 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_MEMH_HOT_PAGE_TRACKER
+#define _H_SST_MEMH_HOT_PAGE_TRACKER
+
+#include <stddef.h>
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+namespace SST {
+namespace MemHierarchy {
+
+/*
+ * Bounded-memory page access frequency tracking
+ *
+ * Used by the paged multi-level backends in place of per-page access
+ * records. A count-min sketch ('depth' rows of 'width' counters) estimates
+ * the number of accesses to any page. The estimate never undercounts, and it
+ * overcounts by at most a small fraction of the total accesses. Conservative
+ * update (only raise the counters that hold the minimum) keeps the
+ * overcount low for skewed access patterns.
+ *
+ * A min-heap of the 'k' pages with the highest estimates sits beside the
+ * sketch. A page joins the heap when its estimate passes the smallest count
+ * in the heap, which then drops out.
+ *
+ * decay() halves every counter. It is called once per epoch so that the
+ * counts follow recent behavior. Halving keeps the heap order, so the heap
+ * needs no rebuild.
+ *
+ * Memory is fixed at construction: width * depth counters plus k heap entries.
+ */
+class HotPageTracker {
+public:
+    HotPageTracker( unsigned width, unsigned depth, unsigned k ) : m_k(k) {
+        unsigned w = 1;
+        m_widthBits = 0;
+        while (w < width) { w <<= 1; m_widthBits++; }
+        if (m_widthBits == 0) { w = 2; m_widthBits = 1; }
+        m_width = w;
+        m_depth = depth ? depth : 1;
+        m_counters.assign((size_t)m_width * m_depth, 0);
+
+        // Fixed odd multipliers so runs are repeatable
+        uint64_t s = 0x9e3779b97f4a7c15ULL;
+        for (unsigned r = 0; r < m_depth; r++) {
+            s += 0x9e3779b97f4a7c15ULL;
+            uint64_t z = s;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            m_seeds.push_back((z ^ (z >> 31)) | 1);
+        }
+        m_heap.reserve(k);
+        m_heapIndex.reserve(k);
+    }
+
+    /* Record an access to 'page' and return its new estimated count */
+    uint32_t touch( uint64_t page ) {
+        uint32_t est = estimate(page);
+        if (est != UINT32_MAX) est++;
+        for (unsigned r = 0; r < m_depth; r++) {
+            uint32_t &c = m_counters[slot(r, page)];
+            if (c < est) c = est;
+        }
+        updateHeap(page, est);
+        return est;
+    }
+
+    uint32_t estimate( uint64_t page ) const {
+        uint32_t est = UINT32_MAX;
+        for (unsigned r = 0; r < m_depth; r++) {
+            uint32_t c = m_counters[slot(r, page)];
+            if (c < est) est = c;
+        }
+        return est;
+    }
+
+    /* Estimate that the next touch(page) will return, without recording an access */
+    uint32_t peek( uint64_t page ) const {
+        uint32_t est = estimate(page);
+        return est == UINT32_MAX ? est : est + 1;
+    }
+
+    /* Whether 'page' is currently one of the 'k' hottest pages */
+    bool isHot( uint64_t page ) const { return m_heapIndex.find(page) != m_heapIndex.end(); }
+
+    /* Whether 'page' would be one of the 'k' hottest pages once its estimate reaches 'count' */
+    bool wouldBeHot( uint64_t page, uint32_t count ) const {
+        if (isHot(page)) return true;
+        if (m_k == 0) return false;
+        return m_heap.size() < m_k || count > m_heap[0].count;
+    }
+
+    void decay() {
+        for (size_t i = 0; i < m_counters.size(); i++)
+            m_counters[i] >>= 1;
+        for (size_t i = 0; i < m_heap.size(); i++)
+            m_heap[i].count >>= 1;
+    }
+
+    size_t numHot() const { return m_heap.size(); }
+
+private:
+    struct HeapEntry {
+        uint64_t page;
+        uint32_t count;
+    };
+
+    size_t slot( unsigned row, uint64_t page ) const {
+        return (size_t)row * m_width + (size_t)((page * m_seeds[row]) >> (64 - m_widthBits));
+    }
+
+    void updateHeap( uint64_t page, uint32_t count ) {
+        if (m_k == 0) return;
+        std::unordered_map<uint64_t,size_t>::iterator it = m_heapIndex.find(page);
+        if (it != m_heapIndex.end()) {
+            m_heap[it->second].count = count;
+            siftDown(it->second);
+        } else if (m_heap.size() < m_k) {
+            HeapEntry e = { page, count };
+            m_heap.push_back(e);
+            m_heapIndex[page] = m_heap.size() - 1;
+            siftUp(m_heap.size() - 1);
+        } else if (count > m_heap[0].count) {
+            m_heapIndex.erase(m_heap[0].page);
+            m_heap[0].page = page;
+            m_heap[0].count = count;
+            m_heapIndex[page] = 0;
+            siftDown(0);
+        }
+    }
+
+    void siftUp( size_t i ) {
+        while (i > 0) {
+            size_t parent = (i - 1) / 2;
+            if (m_heap[parent].count <= m_heap[i].count) break;
+            swapEntries(i, parent);
+            i = parent;
+        }
+    }
+
+    void siftDown( size_t i ) {
+        for (;;) {
+            size_t smallest = i;
+            size_t l = 2 * i + 1, r = l + 1;
+            if (l < m_heap.size() && m_heap[l].count < m_heap[smallest].count) smallest = l;
+            if (r < m_heap.size() && m_heap[r].count < m_heap[smallest].count) smallest = r;
+            if (smallest == i) break;
+            swapEntries(i, smallest);
+            i = smallest;
+        }
+    }
+
+    void swapEntries( size_t a, size_t b ) {
+        HeapEntry tmp = m_heap[a];
+        m_heap[a] = m_heap[b];
+        m_heap[b] = tmp;
+        m_heapIndex[m_heap[a].page] = a;
+        m_heapIndex[m_heap[b].page] = b;
+    }
+
+    unsigned m_width;
+    unsigned m_widthBits;
+    unsigned m_depth;
+    size_t m_k;
+    std::vector<uint64_t> m_seeds;
+    std::vector<uint32_t> m_counters;
+    std::vector<HeapEntry> m_heap;
+    std::unordered_map<uint64_t,size_t> m_heapIndex;
+};
+
+}
+}
+
+#endif
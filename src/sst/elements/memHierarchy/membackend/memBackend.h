@@ -49,6 +49,7 @@ public:
             {"mem_size", "(string) Size of memory with units (SI ok). E.g., '2GiB'.", NULL}
 
     typedef MemBackendConvertor::ReqId ReqId;
+    typedef MemBackendConvertor::BackendReq BackendReq;
     MemBackend();
 
     MemBackend(ComponentId_t id, Params &params) : SubComponent(id) { 
@@ -119,20 +120,44 @@ class SimpleMemBackend : public MemBackend {
 
     virtual bool issueRequest( ReqId, Addr, bool isWrite, unsigned numBytes ) = 0;
 
+    /* Issue requests in order until one is rejected and return the number accepted.
+     * Backends with a high per-request cost can override this to take a cycle's requests at once. */
+    virtual size_t issueRequests( const std::vector<BackendReq>& reqs, unsigned numBytes ) {
+        size_t issued = 0;
+        while (issued < reqs.size() && issueRequest(reqs[issued].id, reqs[issued].addr, reqs[issued].isWrite, numBytes))
+            issued++;
+        return issued;
+    }
+
     void handleMemResponse( ReqId id ) {
         m_respFunc( id );
     }
 
+    /* Return several completed requests at once */
+    void handleMemResponses( const std::vector<ReqId>& ids ) {
+        if (m_respBatchFunc) {
+            m_respBatchFunc( ids );
+        } else {
+            for (std::vector<ReqId>::const_iterator it = ids.begin(); it != ids.end(); it++)
+                m_respFunc( *it );
+        }
+    }
+
     virtual void setResponseHandler( std::function<void(ReqId)> func ) {
         m_respFunc = func;
     }
 
+    virtual void setResponseBatchHandler( std::function<void(const std::vector<ReqId>&)> func ) {
+        m_respBatchFunc = func;
+    }
+
     virtual std::string getBackendConvertorType() {
         return "memHierarchy.simpleMemBackendConvertor";
     }
 
   private:
     std::function<void(ReqId)> m_respFunc;
+    std::function<void(const std::vector<ReqId>&)> m_respBatchFunc;
 };
 
 /* MemBackend - timing and passes request/response flags */
@@ -167,20 +192,44 @@ class ExtMemBackend : public MemBackend {
                                uint32_t flags, unsigned numBytes ) = 0;
     virtual bool issueCustomRequest( ReqId, Interfaces::StandardMem::CustomData* ) = 0;
 
+    /* Issue requests in order until one is rejected and return the number accepted */
+    virtual size_t issueRequests( const std::vector<BackendReq>& reqs, unsigned numBytes ) {
+        std::vector<uint64_t> NULLVEC;
+        size_t issued = 0;
+        while (issued < reqs.size() && issueRequest(reqs[issued].id, reqs[issued].addr, reqs[issued].isWrite, NULLVEC, reqs[issued].flags, numBytes))
+            issued++;
+        return issued;
+    }
+
     void handleMemResponse( ReqId id, uint32_t flags ) {
         m_respFunc( id, flags );
     }
 
+    /* Return several completed requests (ID, flags) at once */
+    void handleMemResponses( const std::vector<std::pair<ReqId,uint32_t> >& resps ) {
+        if (m_respBatchFunc) {
+            m_respBatchFunc( resps );
+        } else {
+            for (std::vector<std::pair<ReqId,uint32_t> >::const_iterator it = resps.begin(); it != resps.end(); it++)
+                m_respFunc( it->first, it->second );
+        }
+    }
+
     virtual void setResponseHandler( std::function<void(ReqId,uint32_t)> func ) {
         m_respFunc = func;
     }
 
+    virtual void setResponseBatchHandler( std::function<void(const std::vector<std::pair<ReqId,uint32_t> >&)> func ) {
+        m_respBatchFunc = func;
+    }
+
     virtual std::string getBackendConvertorType() {
         return "memHierarchy.extMemBackendConvertor";
     }
 
   private:
     std::function<void(ReqId,uint32_t)> m_respFunc;
+    std::function<void(const std::vector<std::pair<ReqId,uint32_t> >&)> m_respBatchFunc;
 };
 
 }}
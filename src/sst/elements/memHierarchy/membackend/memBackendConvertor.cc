@@ -31,7 +31,7 @@ using namespace SST::MemHierarchy;
 
 
 MemBackendConvertor::MemBackendConvertor(ComponentId_t id, Params& params, MemBackend* backend, uint32_t request_width) :
-    SubComponent(id), m_cycleCount(0), m_reqId(0), m_backend(backend)
+    SubComponent(id), m_cycleCount(0), m_reqId(0), m_backend(backend), m_batchIssue(false)
 {
     m_dbg.init("",
             params.find<uint32_t>("debug_level", 0),
@@ -76,6 +76,8 @@ void MemBackendConvertor::setCallbackHandlers( std::function<void(Event::id_type
 void MemBackendConvertor::handleMemEvent(  MemEvent* ev ) {
 
     ev->setDeliveryTime(m_cycleCount);
+    if (ev->isTraced())
+        ev->addTraceStamp(LatencyTrace::Point::MemArrive, getCurrentSimCycle());
 
     doReceiveStat( ev->getCmd() );
 
@@ -91,7 +93,7 @@ void MemBackendConvertor::handleCustomEvent( Interfaces::StandardMem::CustomData
     uint32_t id = genReqId();
     CustomReq* req = new CustomReq( info, evId, rqstr, id );
     m_requestQueue.push_back( req );
-    m_pendingRequests[id] = req;
+    m_pendingRequests.insert(id, req);
 }
 
 bool MemBackendConvertor::clock(Cycle_t cycle) {
@@ -104,6 +106,24 @@ bool MemBackendConvertor::clock(Cycle_t cycle) {
             break;
         }
 
+        // Hand the backend every memory request it may accept this cycle in one call
+        if ( m_batchIssue && m_requestQueue.front()->isMemEv() ) {
+            int maxReqs = m_backend->getMaxReqPerCycle();
+            size_t batched = buildBatch( maxReqs < 0 ? (size_t)-1 : (size_t)(maxReqs - reqsThisCycle) );
+            size_t issued = issueBatch( m_batch );
+            Debug(_L10_, "Issued %zu of %zu requests in batch\n", issued, batched);
+            retireBatch( issued );
+            reqsThisCycle += issued;
+
+            if ( issued < batched ) {
+                cycleWithIssue = false;
+                stat_cyclesAttemptIssueButRejected->addData(1);
+                break;
+            }
+            cycleWithIssue = true;
+            continue;
+        }
+
         BaseReq* req = m_requestQueue.front();
         Debug(_L10_, "Processing request: %s\n", req->getString().c_str());
 
@@ -120,6 +140,7 @@ bool MemBackendConvertor::clock(Cycle_t cycle) {
 
         if ( req->issueDone() ) {
             Debug(_L10_, "Completed issue of request\n");
+            traceIssued( req );
             m_requestQueue.pop_front();
         }
     }
@@ -142,6 +163,55 @@ bool MemBackendConvertor::clock(Cycle_t cycle) {
     return false;
 }
 
+/*
+ * Collect up to maxReqs backend requests from the consecutive memory
+ * requests at the head of the request queue. Returns the batch size.
+ */
+size_t MemBackendConvertor::buildBatch( size_t maxReqs ) {
+    m_batch.clear();
+    for (std::deque<BaseReq*>::iterator it = m_requestQueue.begin(); it != m_requestQueue.end() && m_batch.size() < maxReqs; it++) {
+        if ( !(*it)->isMemEv() )
+            break;
+        MemReq* req = static_cast<MemReq*>(*it);
+        Debug(_L10_, "Processing request: %s\n", req->getString().c_str());
+
+        // Same split as issuing one at a time: at least one piece, then one per backend request width
+        uint32_t offset = req->processed();
+        do {
+            BackendReq breq;
+            breq.id = ((uint64_t)BaseReq::getBaseId(req->id()) << 32) | offset;
+            breq.addr = req->baseAddr() + offset;
+            breq.isWrite = req->isWrite();
+            breq.flags = req->getMemEvent()->getFlags();
+            m_batch.push_back(breq);
+            offset += m_backendRequestWidth;
+        } while ( offset < req->size() && m_batch.size() < maxReqs );
+    }
+    return m_batch.size();
+}
+
+/* Advance the request queue past the first 'issued' requests of the batch */
+void MemBackendConvertor::retireBatch( size_t issued ) {
+    for (size_t i = 0; i < issued; i++) {
+        BaseReq* req = m_requestQueue.front();
+        req->increment( m_backendRequestWidth );
+        if ( req->issueDone() ) {
+            Debug(_L10_, "Completed issue of request\n");
+            traceIssued( req );
+            m_requestQueue.pop_front();
+        }
+    }
+}
+
+/* Latency tracing: stamp a memory request once all of it has been issued */
+void MemBackendConvertor::traceIssued( BaseReq* req ) {
+    if ( !req->isMemEv() )
+        return;
+    MemEvent* event = static_cast<MemReq*>(req)->getMemEvent();
+    if ( event->isTraced() )
+        event->addTraceStamp(LatencyTrace::Point::MemIssue, getCurrentSimCycle());
+}
+
 /*
  * Called by MemController to turn the clock back on
  * cycle = current cycle
@@ -170,14 +240,12 @@ void MemBackendConvertor::doResponse( ReqId reqId, uint32_t flags ) {
     }
 
     uint32_t id = BaseReq::getBaseId(reqId);
-    MemEvent* resp = NULL;
 
-    if ( m_pendingRequests.find( id ) == m_pendingRequests.end() ) {
+    BaseReq* req = m_pendingRequests.find( id );
+    if ( req == nullptr ) {
         m_dbg.fatal(CALL_INFO, -1, "memory request not found; id=%" PRId32 "\n", id);
     }
 
-    BaseReq* req = m_pendingRequests[id];
-
     req->decrement( );
 
     if ( req->isDone() ) {
@@ -188,32 +256,29 @@ void MemBackendConvertor::doResponse( ReqId reqId, uint32_t flags ) {
             sendResponse(creq->getEvId(), flags);
         } else {
 
-            MemEvent* event = static_cast<MemReq*>(req)->getMemEvent();
+            MemReq* mreq = static_cast<MemReq*>(req);
+            MemEvent* event = mreq->getMemEvent();
 
             Debug(_L10_,"doResponse req is done. %s\n", event->getBriefString().c_str());
 
             Cycle_t latency = m_cycleCount - event->getDeliveryTime();
+            if (event->isTraced())
+                event->addTraceStamp(LatencyTrace::Point::MemDone, getCurrentSimCycle());
 
             doResponseStat( event->getCmd(), latency );
 
             if (!flags) flags = event->getFlags();
-            SST::Event::id_type evID = event->getID();
             sendResponse(event->getID(), flags); // Needs to occur before a flush is completed since flush is dependent
 
             // TODO clock responses
             // Check for flushes that are waiting on this event to finish
-            if (m_dependentRequests.find(evID) != m_dependentRequests.end()) {
-                std::set<MemEvent*, memEventCmp> flushes = m_dependentRequests.find(evID)->second;
-
-                for (std::set<MemEvent*, memEventCmp>::iterator it = flushes.begin(); it != flushes.end(); it++) {
-                    (m_waitingFlushes.find(*it)->second).erase(evID);
-                    if ((m_waitingFlushes.find(*it)->second).empty()) {
-                        MemEvent * flush = *it;
-                        sendResponse(flush->getID(), flush->getFlags());
-                        m_waitingFlushes.erase(flush);
-                    }
+            std::vector<WaitingFlushList::iterator>& flushes = mreq->getWaitingFlushes();
+            for (std::vector<WaitingFlushList::iterator>::iterator it = flushes.begin(); it != flushes.end(); it++) {
+                if (--((*it)->waitCount) == 0) {
+                    MemEvent * flush = (*it)->flush;
+                    sendResponse(flush->getID(), flush->getFlags());
+                    m_waitingFlushes.erase(*it);
                 }
-                m_dependentRequests.erase(evID);
             }
         }
         delete req;
@@ -21,7 +21,13 @@
 #include <sst/core/event.h>
 #include <sst/core/warnmacros.h>
 
+#include <list>
+#include <vector>
+#include <unordered_map>
+
 #include "sst/elements/memHierarchy/memEvent.h"
+#include "sst/elements/memHierarchy/memEventPool.h"
+#include "sst/elements/memHierarchy/membackend/pendingRequestRing.h"
 #include "sst/elements/memHierarchy/customcmd/customCmdMemory.h"
 
 namespace SST {
@@ -61,6 +67,21 @@ class MemBackendConvertor : public SubComponent {
 
     typedef uint64_t ReqId;
 
+    /* One backend-sized piece of a request, for backends that accept a batch of requests per call */
+    struct BackendReq {
+        ReqId id;
+        Addr addr;
+        bool isWrite;
+        uint32_t flags;
+    };
+
+    /* A flush that is waiting for earlier requests to the same line to complete */
+    struct WaitingFlush {
+        MemEvent* flush;
+        uint32_t waitCount;
+    };
+    typedef std::list<WaitingFlush> WaitingFlushList;
+
     class BaseReq {
     public:
 
@@ -69,6 +90,10 @@ class MemBackendConvertor : public SubComponent {
         BaseReq( uint32_t reqId, ReqType(type) ) : m_reqId(reqId), m_type(type) { }
         virtual ~BaseReq() { }
 
+        /* Requests are created and destroyed for every memory access; recycle them */
+        static void* operator new(std::size_t size) { return MemEventPool::allocate(size); }
+        static void operator delete(void* ptr, std::size_t size) { MemEventPool::release(ptr, size); }
+
         static uint32_t getBaseId( ReqId id) { return id >> 32; }
         virtual uint64_t id()   { return ((uint64_t)m_reqId << 32); }
         virtual void decrement() { }
@@ -128,6 +153,10 @@ class MemBackendConvertor : public SubComponent {
         uint32_t size()         { return m_event->getSize(); }
         const std::string getRqstr() override { return m_event->getRqstr(); }
 
+        /* Flushes that cannot complete until this request does */
+        void addWaitingFlush( WaitingFlushList::iterator flush ) { m_flushes.push_back(flush); }
+        std::vector<WaitingFlushList::iterator>& getWaitingFlushes() { return m_flushes; }
+
         void increment( uint32_t bytes ) {
             m_offset += bytes;
             ++m_numReq;
@@ -151,8 +180,12 @@ class MemBackendConvertor : public SubComponent {
         MemEvent*   m_event;
         uint32_t    m_offset;
         uint32_t    m_numReq;
+        std::vector<WaitingFlushList::iterator> m_flushes;
     };
 
+    /* Outstanding requests indexed by request ID */
+    typedef PendingRequestRing<BaseReq> PendingRequests;
+
   public:
 
     MemBackendConvertor(ComponentId_t id, Params& params, MemBackend* backend, uint32_t request_width);
@@ -168,11 +201,12 @@ class MemBackendConvertor : public SubComponent {
 
     virtual const std::string getRequestor( ReqId reqId ) {
         uint32_t id = BaseReq::getBaseId(reqId);
-        if ( m_pendingRequests.find( id ) == m_pendingRequests.end() ) {
+        BaseReq* req = m_pendingRequests.find( id );
+        if ( req == nullptr ) {
             m_dbg.fatal(CALL_INFO, -1, "memory request not found\n");
         }
 
-        return m_pendingRequests[id]->getRqstr();
+        return req->getRqstr();
     }
 
     virtual void setCallbackHandlers(std::function<void(Event::id_type,uint32_t)> responseCB, std::function<Cycle_t()> clockenableCB);
@@ -196,42 +230,44 @@ class MemBackendConvertor : public SubComponent {
 
     bool m_clockBackend;
 
+    // Set by subclasses that implement issueBatch()
+    bool m_batchIssue;
+
   private:
     virtual bool issue(BaseReq*) = 0;
 
+    /* Issue memory requests in order; return how many the backend accepted */
+    virtual size_t issueBatch( std::vector<BackendReq>& UNUSED(reqs) ) { return 0; }
+
+    size_t buildBatch( size_t maxReqs );
+    void retireBatch( size_t issued );
+    void traceIssued( BaseReq* req );
 
 
 
     bool setupMemReq( MemEvent* ev ) {
         if ( Command::FlushLine == ev->getCmd() || Command::FlushLineInv == ev->getCmd() ) {
             // TODO optimize if this becomes a problem, it is slow
-            std::set<SST::Event::id_type> dependsOn;
+            WaitingFlushList::iterator flush = m_waitingFlushes.end();
             for (std::deque<BaseReq*>::iterator it = m_requestQueue.begin(); it != m_requestQueue.end(); it++) {
                 if (!(*it)->isMemEv())
                     continue;
                 MemReq * mr = static_cast<MemReq*>(*it);
                 if (mr->baseAddr() == ev->getBaseAddr()) {
-                    MemEvent * req = mr->getMemEvent();
-                    dependsOn.insert(req->getID());
-                    if (m_dependentRequests.find(req->getID()) == m_dependentRequests.end()) {
-                        std::set<MemEvent*, memEventCmp> flushSet;
-                        flushSet.insert(ev);
-                        m_dependentRequests.insert(std::make_pair(req->getID(), flushSet));
-                    } else {
-                        (m_dependentRequests.find(req->getID())->second).insert(ev);
-                    }
+                    if (flush == m_waitingFlushes.end())
+                        flush = m_waitingFlushes.insert(m_waitingFlushes.end(), WaitingFlush{ev, 0});
+                    flush->waitCount++;
+                    mr->addWaitingFlush(flush);
                 }
             }
 
-            if (dependsOn.empty()) return false;
-            m_waitingFlushes.insert(std::make_pair(ev, dependsOn));
-            return true;
+            return flush != m_waitingFlushes.end();
         }
 
         uint32_t id = genReqId();
         MemReq* req = new MemReq( ev, id );
         m_requestQueue.push_back( req );
-        m_pendingRequests[id] = req;
+        m_pendingRequests.insert(id, req);
         return true;
     }
 
@@ -297,14 +333,13 @@ class MemBackendConvertor : public SubComponent {
 
     uint32_t m_reqId;
 
-    typedef std::map<uint32_t,BaseReq*> PendingRequests;
-
     std::deque<BaseReq*>    m_requestQueue;
     PendingRequests         m_pendingRequests;
     uint32_t                m_frontendRequestWidth;
 
-    std::map<MemEvent*, std::set<SST::Event::id_type> > m_waitingFlushes; // Set of request IDs for each flush
-    std::map<SST::Event::id_type, std::set<MemEvent*, memEventCmp> > m_dependentRequests; // Reverse map, set of flushes for each request ID, for faster lookup
+    WaitingFlushList        m_waitingFlushes;   // Flushes waiting on earlier requests, each request points to its flushes
+
+    std::vector<BackendReq> m_batch;            // Requests being issued this cycle if m_batchIssue
 
     Statistic<uint64_t>* stat_GetSLatency;
     Statistic<uint64_t>* stat_GetSXLatency;
@@ -0,0 +1,115 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_MEMH_PENDING_REQUEST_RING
+#define _H_SST_MEMH_PENDING_REQUEST_RING
+
+#include <stddef.h>
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+namespace SST {
+namespace MemHierarchy {
+
+/*
+ * Outstanding memory backend requests indexed by request ID
+ *
+ * IDs are handed out sequentially, so outstanding requests occupy a
+ * window [oldest, next) of the ID space. The window is stored in a
+ * power-of-two ring indexed by the low ID bits; the ring doubles if a
+ * long-running request makes the window wider than the ring, up to
+ * MAX_SLOTS. Beyond that the oldest requests are moved to a side map
+ * so one straggler cannot make the ring grow without bound.
+ */
+template <typename T>
+class PendingRequestRing {
+  public:
+    static constexpr uint32_t MAX_SLOTS = 4096;
+
+    PendingRequestRing() : m_slots(64, nullptr), m_mask(63), m_oldest(0), m_next(0), m_count(0) { }
+
+    size_t size() { return m_count; }
+    bool empty() { return m_count == 0; }
+    size_t slots() { return m_slots.size(); }
+    size_t stragglers() { return m_stragglers.size(); }
+
+    T* find( uint32_t id ) {
+        if ( (uint32_t)(id - m_oldest) < (uint32_t)(m_next - m_oldest) )
+            return m_slots[id & m_mask];
+        if ( m_stragglers.empty() )
+            return nullptr;
+        typename std::unordered_map<uint32_t,T*>::iterator it = m_stragglers.find(id);
+        return it == m_stragglers.end() ? nullptr : it->second;
+    }
+
+    /* IDs must be inserted in increasing order */
+    void insert( uint32_t id, T* req ) {
+        if (m_count == m_stragglers.size())
+            m_oldest = m_next = id;
+        while ( (uint32_t)(id - m_oldest) > m_mask ) {
+            if (m_slots.size() < MAX_SLOTS) {
+                grow();
+                continue;
+            }
+            T* old = m_slots[m_oldest & m_mask];
+            if (old) {
+                m_stragglers.insert(std::make_pair(m_oldest, old));
+                m_slots[m_oldest & m_mask] = nullptr;
+            }
+            if (++m_oldest == m_next)
+                m_oldest = m_next = id;
+        }
+        while (m_next != id)
+            m_slots[(m_next++) & m_mask] = nullptr;
+        m_slots[id & m_mask] = req;
+        m_next = id + 1;
+        m_count++;
+    }
+
+    void erase( uint32_t id ) {
+        if ( (uint32_t)(id - m_oldest) >= (uint32_t)(m_next - m_oldest) ) {
+            if (m_stragglers.erase(id))
+                m_count--;
+            return;
+        }
+        m_slots[id & m_mask] = nullptr;
+        m_count--;
+        while (m_oldest != m_next && m_slots[m_oldest & m_mask] == nullptr)
+            m_oldest++;
+    }
+
+  private:
+    void grow() {
+        std::vector<T*> slots(m_slots.size() * 2, nullptr);
+        uint32_t mask = slots.size() - 1;
+        for (uint32_t id = m_oldest; id != m_next; id++)
+            slots[id & mask] = m_slots[id & m_mask];
+        m_slots.swap(slots);
+        m_mask = mask;
+    }
+
+    std::vector<T*> m_slots;
+    uint32_t m_mask;
+    uint32_t m_oldest;  // Oldest outstanding ID in the ring
+    uint32_t m_next;    // One past the newest ID
+    size_t   m_count;   // Requests in the ring and the side map
+    std::unordered_map<uint32_t,T*> m_stragglers; // Requests that fell out of the ring's window
+};
+
+}
+}
+#endif
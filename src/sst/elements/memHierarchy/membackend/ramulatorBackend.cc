@@ -68,12 +68,21 @@ bool ramulatorMemory::issueRequest(ReqId reqId, Addr addr, bool isWrite, unsigne
     return ok;
 }
 
+size_t ramulatorMemory::issueRequests(const std::vector<BackendReq>& reqs, unsigned numBytes){
+    size_t issued = 0;
+    while (issued < reqs.size() && ramulatorMemory::issueRequest(reqs[issued].id, reqs[issued].addr, reqs[issued].isWrite, numBytes))
+        issued++;
+    return issued;
+}
+
 bool ramulatorMemory::clock(Cycle_t cycle){
     memSystem->tick();
     // Ack writes since ramulator won't
-    while (!writes.empty()) {
-        handleMemResponse(*writes.begin());
-        writes.erase(writes.begin());
+    completedReqs.insert(completedReqs.end(), writes.begin(), writes.end());
+    writes.clear();
+    if (!completedReqs.empty()) {
+        handleMemResponses(completedReqs);
+        completedReqs.clear();
     }
     return false;
 }
@@ -99,5 +108,5 @@ void ramulatorMemory::ramulatorDone(ramulator::Request& ramReq) {
     if(0 == reqs.size())
         dramReqs.erase(addr);
 
-    handleMemResponse(req);
+    completedReqs.push_back(req);
 }
@@ -43,6 +43,7 @@ public:
 /* Begin class definition */
     ramulatorMemory(ComponentId_t id, Params &params);
     bool issueRequest(ReqId, Addr, bool, unsigned );
+    size_t issueRequests(const std::vector<BackendReq>& reqs, unsigned numBytes);
     //virtual bool issueRequest(DRAMReq *req);
     virtual bool clock(Cycle_t cycle);
     virtual void finish();
@@ -54,6 +55,7 @@ protected:
     // Track outstanding requests
     std::map<uint64_t, std::deque<ReqId> > dramReqs;
     std::set<ReqId> writes;
+    std::vector<ReqId> completedReqs;   // Completed during this clock, returned together
 
     void ramulatorDone(ramulator::Request& req);
 
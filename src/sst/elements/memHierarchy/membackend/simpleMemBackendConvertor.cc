@@ -29,6 +29,8 @@ SimpleMemBackendConvertor::SimpleMemBackendConvertor(ComponentId_t id, Params &p
 {
     using std::placeholders::_1;
     static_cast<SimpleMemBackend*>(m_backend)->setResponseHandler( std::bind( &SimpleMemBackendConvertor::handleMemResponse, this, _1 ) );
+    static_cast<SimpleMemBackend*>(m_backend)->setResponseBatchHandler( std::bind( &SimpleMemBackendConvertor::handleMemResponses, this, _1 ) );
+    m_batchIssue = true;
 }
 
 bool SimpleMemBackendConvertor::issue( BaseReq* req ) {
@@ -40,3 +42,7 @@ bool SimpleMemBackendConvertor::issue( BaseReq* req ) {
         return static_cast<SimpleMemBackend*>(m_backend)->issueCustomRequest( creq->id(), creq->getInfo() );
     }
 }
+
+size_t SimpleMemBackendConvertor::issueBatch( std::vector<BackendReq>& reqs ) {
+    return static_cast<SimpleMemBackend*>(m_backend)->issueRequests( reqs, m_backendRequestWidth );
+}
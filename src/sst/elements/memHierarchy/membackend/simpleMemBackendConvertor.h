@@ -39,10 +39,16 @@ public:
     SimpleMemBackendConvertor(ComponentId_t id, Params &params, MemBackend* backend, uint32_t);
 
     virtual bool issue( BaseReq* req );
+    virtual size_t issueBatch( std::vector<BackendReq>& reqs );
 
     virtual void handleMemResponse( ReqId reqId ) {
         doResponse(reqId);
     }
+
+    virtual void handleMemResponses( const std::vector<ReqId>& reqIds ) {
+        for (std::vector<ReqId>::const_iterator it = reqIds.begin(); it != reqIds.end(); it++)
+            doResponse(*it);
+    }
 };
 
 }
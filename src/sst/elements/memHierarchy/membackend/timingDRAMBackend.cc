@@ -22,7 +22,7 @@ bool TimingDRAM::Channel::m_printConfig = true;
 bool TimingDRAM::Rank::m_printConfig = true;
 bool TimingDRAM::Bank::m_printConfig = true;
 
-TimingDRAM::TimingDRAM(ComponentId_t id, Params &params) : SimpleMemBackend(id, params), m_cycle(0) { 
+TimingDRAM::TimingDRAM(ComponentId_t id, Params &params) : SimpleMemBackend(id, params), m_cycle(0), m_needSource(false) { 
 
     int dram_id = params.find<int>("id", -1);
     assert( dram_id != -1 );
@@ -61,13 +61,19 @@ TimingDRAM::TimingDRAM(ComponentId_t id, Params &params) : SimpleMemBackend(id,
         using std::placeholders::_1;
         m_channels.push_back(loadComponentExtension<Channel>( std::bind(&TimingDRAM::handleResponse, this, _1), tmpParams, dram_id, i, output, m_mapper ));
     }
+
+    if ( !m_channels.empty() )
+        m_needSource = m_channels[0]->needsSource();
 }
 
 bool TimingDRAM::issueRequest( ReqId id, Addr addr, bool isWrite, unsigned numBytes )
 {
     unsigned chan = m_mapper->getChannel(addr);
 
-    bool ret = m_channels[chan]->issue(m_cycle, id, addr, isWrite, numBytes );
+    // Requestors are identified by the same IDs events use for endpoints
+    uint32_t source = m_needSource ? EndpointRegistry::getID( getRequestor(id) ) : 0;
+
+    bool ret = m_channels[chan]->issue(m_cycle, id, addr, isWrite, numBytes, source );
 
     if ( ret ) {
         output->verbose(CALL_INFO, 2, DBG_MASK, "chan=%d reqId=%" PRIu64 " addr=%#" PRIx64 "\n",chan,id,addr);
@@ -92,7 +98,8 @@ bool TimingDRAM::clock(Cycle_t cycle)
 //==================================================================================
 
 TimingDRAM::Channel::Channel( ComponentId_t id, std::function<void(ReqId)> handler, Params& params, unsigned mc, unsigned myNum, Output* output, AddrMapper* mapper ) :
-    ComponentExtension(id), m_responseHandler(handler), m_output( output ), m_mapper( mapper ), m_nextRankUp(0), m_dataBusAvailCycle(0)
+    ComponentExtension(id), m_responseHandler(handler), m_output( output ), m_mapper( mapper ), m_nextRankUp(0), m_dataBusAvailCycle(0),
+    m_scheduler(nullptr), m_schedulerPolicy(BankScheduler::FRFCFS)
 {
     std::ostringstream tmp;
     tmp << "@t:TimingDRAM:Channel:@p():@l:mc=" << mc << ":chan=" << myNum << ": ";
@@ -101,6 +108,8 @@ TimingDRAM::Channel::Channel( ComponentId_t id, std::function<void(ReqId)> handl
     unsigned numRanks = params.find<unsigned>("numRanks", 1);
     m_maxPendingTrans = params.find<unsigned>("transaction_Q_size", 32);
 
+    std::string scheduler = params.find<std::string>("scheduler", "fifo");
+
     m_pendingCount = 0;
 
     m_mapper->setNumRanks( numRanks );
@@ -110,13 +119,56 @@ TimingDRAM::Channel::Channel( ComponentId_t id, std::function<void(ReqId)> handl
     if ( m_printConfig ) {
         m_output->verbosePrefix(prefix(),CALL_INFO, 1, DBG_MASK, "max pending trans: %d\n",m_maxPendingTrans);
         m_output->verbosePrefix(prefix(),CALL_INFO, 1, DBG_MASK, "number of ranks:   %d\n",numRanks);
+        m_output->verbosePrefix(prefix(),CALL_INFO, 1, DBG_MASK, "scheduler:         %s\n",scheduler.c_str());
         m_printConfig = false;
     }
 
     Params tmpParams = params.get_scoped_params("rank" );
-    for ( unsigned i=0; i<numRanks; i++ ) {
-        m_ranks.push_back( loadComponentExtension<Rank>( tmpParams, mc, myNum, i, output, mapper ) );
+
+    if ( scheduler == "fifo" ) {
+        for ( unsigned i=0; i<numRanks; i++ ) {
+            m_ranks.push_back( loadComponentExtension<Rank>( tmpParams, mc, myNum, i, output, mapper ) );
+        }
+        return;
+    }
+
+    if ( scheduler == "frfcfs" ) {
+        m_schedulerPolicy = BankScheduler::FRFCFS;
+    } else if ( scheduler == "bliss" ) {
+        m_schedulerPolicy = BankScheduler::BLISS;
+    } else {
+        m_output->fatal(CALL_INFO, -1, "%sInvalid param: scheduler - must be 'fifo', 'frfcfs', or 'bliss'. You specified '%s'\n",
+                prefix(), scheduler.c_str());
+    }
+
+    // Banks are modeled by the scheduler, so read their timing here instead of creating Rank/Bank objects
+    unsigned numBanks = tmpParams.find<unsigned>("numBanks", 8);
+    m_mapper->setNumBanks( numBanks );
+
+    Params bankParams = tmpParams.get_scoped_params("bank" );
+    BankScheduler::Timing timing;
+    timing.CL = bankParams.find<unsigned>("CL", 11);
+    timing.CL_WR = bankParams.find<unsigned>("CL_WR", timing.CL);
+    timing.RCD = bankParams.find<unsigned>("RCD", 11);
+    timing.TRP = bankParams.find<unsigned>("TRP", 11);
+    timing.RAS = bankParams.find<unsigned>("RAS", 0);
+    timing.WR = bankParams.find<unsigned>("WR", 0);
+    timing.WTR = bankParams.find<unsigned>("WTR", 0);
+    timing.dataCycles = bankParams.find<unsigned>("dataCycles", 4);
+
+    if ( numRanks * numBanks == 0 || numRanks * numBanks > BankScheduler::MAX_BANKS ) {
+        m_output->fatal(CALL_INFO, -1, "%sError: the %s scheduler supports 1 to %u banks per channel (ranks * banks), configured %u\n",
+                prefix(), scheduler.c_str(), BankScheduler::MAX_BANKS, numRanks * numBanks);
     }
+
+    BankScheduler::Options options;
+    options.rowHitCap = params.find<unsigned>("row_hit_cap", 16);
+    options.idleClose = params.find<unsigned>("idle_close_cycles", 0);
+    options.blissThreshold = params.find<unsigned>("bliss_threshold", 4);
+    options.blissInterval = params.find<SimTime_t>("bliss_clear_interval", 10000);
+
+    m_scheduler = new BankScheduler( m_schedulerPolicy, numRanks, numBanks, timing, options,
+            [this](unsigned level, const char* msg) { m_output->verbosePrefix(prefix(), CALL_INFO, level, BankScheduler::DBG_MASK, "%s", msg); } );
 }
 
 void TimingDRAM::Channel::clock( SimTime_t cycle )
@@ -124,6 +176,13 @@ void TimingDRAM::Channel::clock( SimTime_t cycle )
     if (is_debug)
         m_output->verbosePrefix(prefix(),CALL_INFO, 5, DBG_MASK, "cycle %" PRIu64 "\n",cycle);
 
+    if ( m_scheduler ) {
+        m_scheduler->retire( cycle, m_retiredTrans );
+        sendResponse();
+        m_scheduler->issue( cycle );
+        return;
+    }
+
     std::list<Cmd*>::iterator iter = m_issuedCmds.begin();
 
     /* Check all outstanding commands to see if anything is finished */
@@ -146,18 +205,7 @@ void TimingDRAM::Channel::clock( SimTime_t cycle )
         }
     }
 
-    /* Return a response if possible */
-    if ( ! m_retiredTrans.empty() ) {
-        if (is_debug)
-            m_output->verbosePrefix(prefix(),CALL_INFO, 3, DBG_MASK, "send response: reqId=%" PRIu64 " bank=%d addr=%#" PRIx64 ", createTime=%" PRIu64 "\n",
-                    m_retiredTrans.front()->id, m_retiredTrans.front()->bank, m_retiredTrans.front()->addr, m_retiredTrans.front()->createTime);
-
-        m_responseHandler(m_retiredTrans.front()->id);
-        delete m_retiredTrans.front();
-
-        m_retiredTrans.pop();
-        m_pendingCount--;
-    }
+    sendResponse();
 
     /* For each rank, check if there's a command to issue */
     Cmd* cmd = popCmd( cycle, m_dataBusAvailCycle );
@@ -172,6 +220,22 @@ void TimingDRAM::Channel::clock( SimTime_t cycle )
     }
 }
 
+/* Return a response if possible */
+void TimingDRAM::Channel::sendResponse()
+{
+    if ( ! m_retiredTrans.empty() ) {
+        if (is_debug)
+            m_output->verbosePrefix(prefix(),CALL_INFO, 3, DBG_MASK, "send response: reqId=%" PRIu64 " bank=%d addr=%#" PRIx64 ", createTime=%" PRIu64 "\n",
+                    m_retiredTrans.front()->id, m_retiredTrans.front()->bank, m_retiredTrans.front()->addr, m_retiredTrans.front()->createTime);
+
+        m_responseHandler(m_retiredTrans.front()->id);
+        delete m_retiredTrans.front();
+
+        m_retiredTrans.pop();
+        m_pendingCount--;
+    }
+}
+
 TimingDRAM::Cmd* TimingDRAM::Channel::popCmd( SimTime_t cycle, SimTime_t dataBusAvailCycle )
 {
     Cmd* cmd = nullptr;
@@ -205,7 +269,7 @@ TimingDRAM::Cmd* TimingDRAM::Channel::popCmd( SimTime_t cycle, SimTime_t dataBus
 //==================================================================================
 
 TimingDRAM::Rank::Rank( ComponentId_t id, Params& params, unsigned mc, unsigned chan, unsigned myNum, Output* output, AddrMapper* mapper ) :
-    ComponentExtension(id), m_output( output ), m_mapper( mapper ), m_nextBankUp(0)
+    ComponentExtension(id), m_output( output ), m_mapper( mapper ), m_nextBankUp(0), m_numActive(0)
 {
     std::ostringstream tmp;
     tmp << "@t:TimingDRAM:Rank:@p():@l:mc=" << mc << ":chan=" << chan << ":rank=" << myNum <<": ";
@@ -214,6 +278,7 @@ TimingDRAM::Rank::Rank( ComponentId_t id, Params& params, unsigned mc, unsigned
     int banks = params.find<int>("numBanks", 8);
 
     m_mapper->setNumBanks( banks );
+    m_banksActive.resize( (banks + 63) / 64, 0 );
 
     if (m_printConfig)
         m_printConfig = params.find<bool>("printconfig", true);
@@ -235,11 +300,11 @@ TimingDRAM::Cmd* TimingDRAM::Rank::popCmd( SimTime_t cycle, SimTime_t dataBusAva
 
     unsigned current = m_nextBankUp;
     for ( unsigned i = 0; i < m_banks.size(); i++ ) {
-        if (m_banksActive.find(current) != m_banksActive.end()) {
+        if (isActive(current)) {
             Cmd* cmd = m_banks[current]->popCmd( cycle, dataBusAvailCycle );
 
             if (m_banks[current]->isIdle())
-                m_banksActive.erase(current);
+                setIdle(current);
 
             if ( cmd ) {
                 if ( current == m_nextBankUp ) {
@@ -21,6 +21,9 @@
 #include "sst/elements/memHierarchy/membackend/timingAddrMapper.h"
 #include "sst/elements/memHierarchy/membackend/timingTransaction.h"
 #include "sst/elements/memHierarchy/membackend/timingPagePolicy.h"
+#include "sst/elements/memHierarchy/membackend/timingScheduler.h"
+#include "sst/elements/memHierarchy/endpointRegistry.h"
+#include "sst/elements/memHierarchy/memEventPool.h"
 #include "sst/elements/memHierarchy/util.h"
 
 namespace SST {
@@ -44,12 +47,20 @@ public:
             {"channels", "Number of channels", "1"},
             {"channel.numRanks", "Number of ranks per channel", "1"},
             {"channel.transaction_Q_size", "Size of transaction queue", "32"},
+            {"channel.scheduler", "Command scheduler. 'fifo': per-bank transaction queue and page policy subcomponents. 'frfcfs': first-ready FCFS over all banks in the channel. 'bliss': FR-FCFS with requestor blacklisting (BLISS). 'frfcfs' and 'bliss' ignore the transactionQ and pagePolicy subcomponents and support up to 64 banks per channel.", "fifo"},
+            {"channel.row_hit_cap", "(frfcfs/bliss) Maximum consecutive row hits to a bank while an older miss to that bank waits. 0 for no limit.", "16"},
+            {"channel.idle_close_cycles", "(frfcfs/bliss) Precharge a bank with no pending transactions after its row has been idle for this many cycles. 0 to leave rows open.", "0"},
+            {"channel.bliss_threshold", "(bliss) Blacklist a requestor after this many consecutive column commands", "4"},
+            {"channel.bliss_clear_interval", "(bliss) Clear the blacklist every this many cycles", "10000"},
             {"channel.rank.numBanks", "Number of banks per rank", "8"},
             {"channel.rank.bank.CL", "Column access latency in cycles", "11"},
             {"channel.rank.bank.CL_WR", "Column write latency", "11"},
             {"channel.rank.bank.RCD", "Row access latency in cycles", "11"},
             {"channel.rank.bank.TRP", "Precharge delay in cycles", "11"},
             {"channel.rank.bank.dataCycles", "", "4"},
+            {"channel.rank.bank.RAS", "(frfcfs/bliss) Minimum cycles from activate to precharge", "0"},
+            {"channel.rank.bank.WR", "(frfcfs/bliss) Write recovery, cycles from the end of write data to precharge", "0"},
+            {"channel.rank.bank.WTR", "(frfcfs/bliss) Write to read turnaround, cycles from the end of write data to the next read's data", "0"},
             {"channel.rank.bank.transactionQ", "Transaction queue model (subcomponent)", "memHierarchy.fifoTransactionQ"},
             {"channel.rank.bank.pagePolicy", "Policy subcomponent for managing row buffer", "memHierarchy.simplePagePolicy"})
 
@@ -131,6 +142,11 @@ private:
     class Cmd {
       public:
         enum Op { PRE, ACT, COL } m_op;
+
+        /* Commands are created for every transaction; recycle them */
+        static void* operator new(std::size_t size) { return MemEventPool::allocate(size); }
+        static void operator delete(void* ptr, std::size_t size) { MemEventPool::release(ptr, size); }
+
         Cmd( Bank* bank, Op op, unsigned cycles, unsigned row = -1, unsigned dataCycles = 0, Transaction* trans  = NULL  ) :
             m_bank(bank), m_op(op), m_cycles(cycles), m_row(row), m_dataCycles(dataCycles), m_trans(trans)
         {
@@ -249,11 +265,14 @@ private:
 
             m_banks[bank]->pushTrans( trans );
 
-            m_banksActive.insert(bank);
+            if ( !isActive(bank) ) {
+                m_banksActive[bank / 64] |= (1ULL << (bank % 64));
+                m_numActive++;
+            }
         }
 
         bool hasActiveBanks() {
-            return !m_banksActive.empty();
+            return m_numActive != 0;
         }
 
       private:
@@ -263,9 +282,19 @@ private:
         AddrMapper*     m_mapper;
         std::string     m_pre;
 
+        bool isActive( unsigned bank ) {
+            return m_banksActive[bank / 64] & (1ULL << (bank % 64));
+        }
+
+        void setIdle( unsigned bank ) {
+            m_banksActive[bank / 64] &= ~(1ULL << (bank % 64));
+            m_numActive--;
+        }
+
         unsigned            m_nextBankUp;
         std::vector<Bank*>  m_banks;
-        std::set<unsigned>  m_banksActive;
+        std::vector<uint64_t> m_banksActive;    // Bitset of banks with work
+        unsigned            m_numActive;
     };
 
     class Channel : public ComponentExtension {
@@ -277,7 +306,7 @@ private:
 
         Channel( ComponentId_t, std::function<void(ReqId)>, Params&, unsigned mc, unsigned chan, Output*, AddrMapper* );
 
-        bool issue( SimTime_t createTime, ReqId id, Addr addr, bool isWrite, unsigned numBytes ) {
+        bool issue( SimTime_t createTime, ReqId id, Addr addr, bool isWrite, unsigned numBytes, uint32_t source ) {
 
             if ( m_maxPendingTrans == m_pendingCount ) {
                 return false;
@@ -289,16 +318,24 @@ private:
                 m_output->verbosePrefix(prefix(),CALL_INFO, 3, DBG_MASK,"reqId=%" PRIu64 " rank=%d addr=%#" PRIx64 ", createTime=%" PRIu64 "\n", id, rank, addr, createTime );
 
             Transaction* trans = new Transaction( createTime, id, addr, isWrite, numBytes, m_mapper->getBank(addr),
-                                                m_mapper->getRow(addr) );
+                                                m_mapper->getRow(addr), source );
             m_pendingCount++;
-            m_ranks[ rank ]->pushTrans( trans );
+            if ( m_scheduler )
+                m_scheduler->push( trans, rank );
+            else
+                m_ranks[ rank ]->pushTrans( trans );
             return true;
         }
 
+        bool needsSource() {
+            return m_scheduler && m_schedulerPolicy == BankScheduler::BLISS;
+        }
+
         void clock(SimTime_t );
 
       private:
         Cmd* popCmd( SimTime_t cycle, SimTime_t dataBusAvailCycle );
+        void sendResponse();
         const char* prefix() { return m_pre.c_str(); }
         Output*             m_output;
         AddrMapper*         m_mapper;
@@ -314,6 +351,9 @@ private:
         std::list<Cmd*>     m_issuedCmds;
         std::queue<Transaction*> m_retiredTrans;
 
+        BankScheduler*      m_scheduler;        // Null for the 'fifo' scheduler
+        BankScheduler::Policy m_schedulerPolicy;
+
         std::function<void(ReqId)> m_responseHandler;
     };
 
@@ -334,6 +374,7 @@ private:
     std::vector<Channel*> m_channels;
     AddrMapper* m_mapper;
     SimTime_t   m_cycle;
+    bool        m_needSource;   // Scheduler needs the requestor of each request
 
 };
 
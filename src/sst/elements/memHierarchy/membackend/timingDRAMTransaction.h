@@ -0,0 +1,57 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_MEMH_TIMING_DRAM_TRANSACTION
+#define _H_SST_MEMH_TIMING_DRAM_TRANSACTION
+
+#include <sst/core/sst_types.h>
+
+#include "sst/elements/memHierarchy/util.h"
+#include "sst/elements/memHierarchy/memEventPool.h"
+
+namespace SST {
+namespace MemHierarchy {
+namespace TimingDRAM_NS {
+
+typedef uint64_t ReqId;
+
+/* A request as seen by a TimingDRAM channel. Kept apart from the transaction
+ * queue subcomponents so the bank scheduler does not depend on them. */
+struct Transaction {
+    Transaction( SimTime_t _createTime, ReqId id, Addr addr, bool isWrite, unsigned numBytes, unsigned _bank, unsigned _row, uint32_t _source = 0) :
+        createTime(_createTime), id(id), addr(addr), isWrite(isWrite), numBytes(numBytes),
+	bank(_bank), row(_row), retired(false), source(_source), seq(0)
+    {}
+
+    static void* operator new(std::size_t size) { return MemEventPool::allocate(size); }
+    static void operator delete(void* ptr, std::size_t size) { MemEventPool::release(ptr, size); }
+
+    void setRetired() { retired = true; }
+    bool isRetired() { return retired; }
+
+    SimTime_t createTime;
+    ReqId id;
+    Addr addr;
+    bool isWrite;
+    unsigned numBytes;
+    unsigned bank;
+    unsigned row;
+    bool retired;
+    uint32_t source;    // Requestor, used by the BLISS scheduler
+    uint64_t seq;       // Arrival order, set by the bank scheduler
+};
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,367 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_MEMH_TIMING_SCHEDULER
+#define _H_SST_MEMH_TIMING_SCHEDULER
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <functional>
+#include <queue>
+#include <string>
+#include <vector>
+
+#include "sst/elements/memHierarchy/util.h"
+#include "sst/elements/memHierarchy/timingWheel.h"
+#include "sst/elements/memHierarchy/membackend/timingDRAMTransaction.h"
+
+namespace SST {
+namespace MemHierarchy {
+namespace TimingDRAM_NS {
+
+/*
+ * Bank-indexed command scheduler for one TimingDRAM channel
+ *
+ * Replaces the Rank/Bank/Cmd model when a channel's 'scheduler' is
+ * 'frfcfs' or 'bliss'. No command objects are created. Each bank keeps its
+ * transactions in arrival order, its open row, and the earliest cycle at
+ * which each command (ACT, PRE, RD, WR) is legal. The channel keeps the
+ * same table for constraints shared by all banks (data bus, write-to-read
+ * turnaround). A command is legal once the cycle reaches both entries.
+ *
+ * Each bank caches its best candidate transaction. The candidate is only
+ * recomputed when the bank's queue or open row changes. Per-bank bitmasks
+ * track which banks have work, whose candidate is a row hit, and whose
+ * candidate is stale. Each cycle the scheduler walks the set bits of the
+ * pending mask, so picking a command costs O(banks) regardless of queue
+ * depth.
+ *
+ * Priority, highest first:
+ *   frfcfs: row hit, then oldest
+ *   bliss:  not blacklisted, row hit, then oldest. A requestor is
+ *           blacklisted after more than 'bliss_threshold' consecutive column
+ *           commands, and the blacklist is cleared every
+ *           'bliss_clear_interval' cycles.
+ * Only banks whose next command is legal this cycle compete, so a ready
+ * miss is not held up behind a row hit that is still waiting on timing.
+ * 'row_hit_cap' limits back-to-back hits to one row while an older miss to
+ * the same bank waits. With 'idle_close_cycles' set, a bank with no queued
+ * work is precharged once its row has been idle that long.
+ *
+ * The owning channel reads the parameters and passes debug output through
+ * a callback, so the scheduler has no link-time dependence on sst-core and
+ * is unit tested on its own (tests/unitTests/bankScheduler.cc).
+ */
+class BankScheduler {
+  public:
+    static const uint64_t DBG_MASK = (1 << 4);
+
+    enum Policy { FRFCFS, BLISS };
+
+    struct Timing {
+        unsigned CL;
+        unsigned CL_WR;
+        unsigned RCD;
+        unsigned TRP;
+        unsigned RAS;           // ACT to PRE
+        unsigned WR;            // End of write data to PRE
+        unsigned WTR;           // End of write data to RD
+        unsigned dataCycles;
+    };
+
+    struct Options {
+        unsigned rowHitCap;         // row_hit_cap
+        unsigned idleClose;         // idle_close_cycles
+        unsigned blissThreshold;    // bliss_threshold
+        SimTime_t blissInterval;    // bliss_clear_interval
+        Options() : rowHitCap(16), idleClose(0), blissThreshold(4), blissInterval(10000) { }
+    };
+
+    /* Receives debug output: verbosity level and message */
+    typedef std::function<void(unsigned, const char*)> DebugHandler;
+
+    static const unsigned MAX_BANKS = 64;
+
+    /* numRanks * numBanks must be between 1 and MAX_BANKS */
+    BankScheduler( Policy policy, unsigned numRanks, unsigned numBanks, Timing timing, Options options, DebugHandler debug = nullptr ) :
+        m_policy(policy), m_numBanks(numBanks), m_timing(timing), m_debug(debug),
+        m_pendingMask(0), m_hitMask(0), m_staleMask(0), m_openMask(0), m_seq(0),
+        m_rowHitCap(options.rowHitCap), m_idleClose(options.idleClose),
+        m_blissThreshold(options.blissThreshold), m_blissInterval(options.blissInterval),
+        m_lastSource(0), m_sourceCount(0), m_nextClear(0)
+    {
+        m_banks.resize(numRanks * numBanks);
+        for ( unsigned i = 0; i < NUM_CMDS; i++ )
+            m_chanNext[i] = 0;
+        if ( m_blissInterval == 0 ) m_blissInterval = 1;
+    }
+
+    void push( Transaction* trans, unsigned rank ) {
+        unsigned b = rank * m_numBanks + trans->bank;
+        trans->seq = m_seq++;
+        m_banks[b].queue.push_back(trans);
+        m_pendingMask |= bit(b);
+        m_staleMask |= bit(b);
+    }
+
+    /* Move transactions whose data completes by 'cycle' to 'retired' */
+    void retire( SimTime_t cycle, std::queue<Transaction*>& retired ) {
+        while ( m_inflight.ready(cycle) ) {
+            retired.push(m_inflight.front());
+            m_inflight.pop();
+        }
+    }
+
+    /* Issue at most one command this cycle */
+    void issue( SimTime_t cycle ) {
+        if ( m_policy == BLISS && cycle >= m_nextClear ) {
+            if ( !m_blacklist.empty() ) {
+                m_blacklist.clear();
+                m_staleMask |= m_pendingMask;
+            }
+            m_nextClear = cycle + m_blissInterval;
+        }
+
+        for ( uint64_t stale = m_staleMask & m_pendingMask; stale; stale &= stale - 1 )
+            updateCandidate( __builtin_ctzll(stale) );
+        m_staleMask = 0;
+
+        // Under FR-FCFS any ready hit beats any miss, so only look at misses if no hit can issue
+        int best;
+        if ( m_policy == FRFCFS ) {
+            best = pick( m_pendingMask & m_hitMask, cycle );
+            if ( best < 0 )
+                best = pick( m_pendingMask & ~m_hitMask, cycle );
+        } else {
+            best = pick( m_pendingMask, cycle );
+        }
+
+        if ( best >= 0 ) {
+            issueCandidate( best, cycle );
+            return;
+        }
+
+        if ( m_idleClose == 0 )
+            return;
+
+        // Nothing to do; close a row that has been idle long enough
+        for ( uint64_t idle = m_openMask & ~m_pendingMask; idle; idle &= idle - 1 ) {
+            unsigned b = __builtin_ctzll(idle);
+            Bank& bank = m_banks[b];
+            if ( bank.lastUse + m_idleClose <= cycle && bank.next[PRE] <= cycle ) {
+                precharge( b, cycle );
+                return;
+            }
+        }
+    }
+
+  private:
+    enum CmdType { ACT, PRE, RD, WR, NUM_CMDS };
+
+    static constexpr unsigned NO_ROW = (unsigned)-1;
+    static constexpr uint64_t BLACKLIST_KEY = 1ULL << 63;
+    static constexpr uint64_t MISS_KEY = 1ULL << 62;
+
+    struct Bank {
+        std::vector<Transaction*> queue;    // Arrival order
+        unsigned row;                       // Open row or NO_ROW
+        unsigned hits;                      // Column commands to the open row since ACT
+        SimTime_t lastUse;
+        SimTime_t next[NUM_CMDS];           // Earliest legal cycle for each command
+        size_t cand;                        // Index of the candidate in 'queue'
+        uint64_t key;                       // Candidate priority, lower is better
+        Bank() : row(NO_ROW), hits(0), lastUse(0), cand(0), key(~0ULL) {
+            for ( unsigned i = 0; i < NUM_CMDS; i++ ) next[i] = 0;
+        }
+    };
+
+    static uint64_t bit( unsigned b ) { return 1ULL << b; }
+
+    bool isBlacklisted( uint32_t source ) {
+        for ( size_t i = 0; i < m_blacklist.size(); i++ )
+            if ( m_blacklist[i] == source ) return true;
+        return false;
+    }
+
+    /* Return the bank in 'mask' with the best candidate whose next command is legal now, or -1 */
+    int pick( uint64_t mask, SimTime_t cycle ) {
+        int best = -1;
+        uint64_t bestKey = ~0ULL;
+        for ( ; mask; mask &= mask - 1 ) {
+            unsigned b = __builtin_ctzll(mask);
+            Bank& bank = m_banks[b];
+            if ( bank.key < bestKey && nextCmdTime(bank) <= cycle ) {
+                best = b;
+                bestKey = bank.key;
+            }
+        }
+        return best;
+    }
+
+    void updateCandidate( unsigned b ) {
+        Bank& bank = m_banks[b];
+        // Once the hit cap is reached, hits no longer outrank an older miss
+        bool allowHits = bank.row != NO_ROW && ( m_rowHitCap == 0 || bank.hits < m_rowHitCap );
+        bank.key = ~0ULL;
+        for ( size_t i = 0; i < bank.queue.size(); i++ ) {
+            Transaction* trans = bank.queue[i];
+            uint64_t key = trans->seq;
+            if ( !allowHits || trans->row != bank.row )
+                key |= MISS_KEY;
+            if ( m_policy == BLISS && isBlacklisted(trans->source) )
+                key |= BLACKLIST_KEY;
+            if ( key < bank.key ) {
+                bank.key = key;
+                bank.cand = i;
+            }
+        }
+        if ( bank.row != NO_ROW && bank.queue[bank.cand]->row == bank.row )
+            m_hitMask |= bit(b);
+        else
+            m_hitMask &= ~bit(b);
+    }
+
+    /* Cycle at which the bank's next command for its candidate is legal */
+    SimTime_t nextCmdTime( Bank& bank ) {
+        Transaction* trans = bank.queue[bank.cand];
+        if ( bank.row == trans->row ) {
+            CmdType col = trans->isWrite ? WR : RD;
+            return std::max( bank.next[col], m_chanNext[col] );
+        }
+        return bank.row == NO_ROW ? bank.next[ACT] : bank.next[PRE];
+    }
+
+    void issueCandidate( unsigned b, SimTime_t cycle ) {
+        Bank& bank = m_banks[b];
+        Transaction* trans = bank.queue[bank.cand];
+
+        if ( bank.row != NO_ROW && bank.row != trans->row ) {
+            precharge( b, cycle );
+            return;
+        }
+
+        if ( bank.row == NO_ROW ) {
+            if (is_debug)
+                debug(2, "cycle=%" PRIu64 " issue ACT for bank=%u row=%u\n", cycle, b, trans->row);
+            bank.row = trans->row;
+            bank.hits = 0;
+            bank.lastUse = cycle;
+            bank.next[RD] = bank.next[WR] = cycle + m_timing.RCD;
+            bank.next[PRE] = std::max( bank.next[PRE], (SimTime_t)(cycle + m_timing.RAS) );
+            m_openMask |= bit(b);
+            m_staleMask |= bit(b);
+            return;
+        }
+
+        // Column command; the data burst must start after the bus frees up
+        unsigned lat = trans->isWrite ? m_timing.CL_WR : m_timing.CL;
+        SimTime_t dataEnd = cycle + lat + m_timing.dataCycles;
+
+        if (is_debug)
+            debug(2, "cycle=%" PRIu64 " issue COL for bank=%u row=%u reqId=%" PRIu64 " done=%" PRIu64 "\n",
+                    cycle, b, trans->row, trans->id, dataEnd);
+
+        bank.next[RD] = bank.next[WR] = cycle + m_timing.dataCycles;
+        bank.next[PRE] = std::max( bank.next[PRE], dataEnd + (trans->isWrite ? m_timing.WR : 0) );
+        bank.lastUse = cycle;
+        bank.hits++;
+
+        // Data bus: the next burst starts no earlier than dataEnd - dataCycles from now
+        SimTime_t busFree = dataEnd;
+        m_chanNext[RD] = std::max( m_chanNext[RD], busFree > m_timing.CL ? busFree - m_timing.CL : 0 );
+        m_chanNext[WR] = std::max( m_chanNext[WR], busFree > m_timing.CL_WR ? busFree - m_timing.CL_WR : 0 );
+        if ( trans->isWrite )
+            m_chanNext[RD] = std::max( m_chanNext[RD], dataEnd + m_timing.WTR > m_timing.CL ? dataEnd + m_timing.WTR - m_timing.CL : 0 );
+
+        if ( m_policy == BLISS )
+            countSource( trans->source );
+
+        bank.queue.erase( bank.queue.begin() + bank.cand );
+        if ( bank.queue.empty() )
+            m_pendingMask &= ~bit(b);
+        m_staleMask |= bit(b);
+
+        m_inflight.insert( dataEnd, trans );
+    }
+
+    void precharge( unsigned b, SimTime_t cycle ) {
+        Bank& bank = m_banks[b];
+        if (is_debug)
+            debug(2, "cycle=%" PRIu64 " issue PRE for bank=%u row=%u\n", cycle, b, bank.row);
+        bank.row = NO_ROW;
+        bank.next[ACT] = cycle + m_timing.TRP;
+        m_openMask &= ~bit(b);
+        m_staleMask |= bit(b);
+    }
+
+    void countSource( uint32_t source ) {
+        if ( source == m_lastSource ) {
+            m_sourceCount++;
+        } else {
+            m_lastSource = source;
+            m_sourceCount = 1;
+        }
+        if ( m_sourceCount > m_blissThreshold && !isBlacklisted(source) ) {
+            if (is_debug)
+                debug(3, "blacklist source=%#" PRIx32 "\n", source);
+            m_blacklist.push_back(source);
+            m_staleMask |= m_pendingMask;
+        }
+    }
+
+    void debug( unsigned level, const char* fmt, ... ) {
+        if ( !m_debug ) return;
+        char buf[256];
+        va_list args;
+        va_start(args, fmt);
+        vsnprintf(buf, sizeof(buf), fmt, args);
+        va_end(args);
+        m_debug(level, buf);
+    }
+
+    Policy          m_policy;
+    unsigned        m_numBanks;     // Per rank
+    Timing          m_timing;
+    DebugHandler    m_debug;
+
+    std::vector<Bank>   m_banks;    // Indexed by rank * m_numBanks + bank
+    SimTime_t       m_chanNext[NUM_CMDS];
+
+    uint64_t        m_pendingMask;  // Bank has queued transactions
+    uint64_t        m_hitMask;      // Bank's candidate is a row hit
+    uint64_t        m_staleMask;    // Bank's candidate must be recomputed
+    uint64_t        m_openMask;     // Bank has an open row
+    uint64_t        m_seq;
+
+    unsigned        m_rowHitCap;
+    unsigned        m_idleClose;
+
+    // BLISS
+    unsigned        m_blissThreshold;
+    SimTime_t       m_blissInterval;
+    uint32_t        m_lastSource;
+    unsigned        m_sourceCount;
+    SimTime_t       m_nextClear;
+    std::vector<uint32_t> m_blacklist;
+
+    TimingWheel<Transaction*> m_inflight;   // Column commands by data completion time
+};
+
+}
+}
+}
+
+#endif
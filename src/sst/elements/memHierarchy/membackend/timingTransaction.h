@@ -15,31 +15,12 @@
 
 #include <sst/core/subcomponent.h>
 
+#include "sst/elements/memHierarchy/membackend/timingDRAMTransaction.h"
+
 namespace SST {
 namespace MemHierarchy {
 namespace TimingDRAM_NS {
 
-typedef uint64_t ReqId;
-
-struct Transaction {
-    Transaction( SimTime_t _createTime, ReqId id, Addr addr, bool isWrite, unsigned numBytes, unsigned _bank, unsigned _row) :
-        createTime(_createTime), id(id), addr(addr), isWrite(isWrite), numBytes(numBytes),
-	bank(_bank), row(_row), retired(false)
-    {}
-
-    void setRetired() { retired = true; }
-    bool isRetired() { return retired; }
-
-    SimTime_t createTime;
-    ReqId id;
-    Addr addr;
-    bool isWrite;
-    unsigned numBytes;
-    unsigned bank;
-    unsigned row;
-    bool retired;
-};
-
 class TransactionQ : public SST::SubComponent {
   public:
 /* Element Library Info */
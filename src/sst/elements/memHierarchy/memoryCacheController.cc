@@ -36,12 +36,8 @@ using namespace SST::MemHierarchy;
 
 // Debug macros
 #ifdef __SST_DEBUG_OUTPUT__
-#define is_debug_addr(addr) (DEBUG_ADDR.empty() || DEBUG_ADDR.find(addr) != DEBUG_ADDR.end())
-#define is_debug_event(ev) (DEBUG_ADDR.empty() || ev->doDebug(DEBUG_ADDR))
 #define Debug(level, fmt, ... ) dbg.debug( level, fmt, ##__VA_ARGS__  )
 #else
-#define is_debug_addr(addr) false
-#define is_debug_event(ev) false
 #define Debug(level, fmt, ... )
 #endif
 /*
@@ -187,17 +183,50 @@ MemCacheController::MemCacheController(ComponentId_t id, Params &params) : Compo
     }
 
     /* Initialize cache */
-    uint64_t cachesize = memSize_ / lineSize_;
     if (memSize_ % lineSize_ != 0)
         out.fatal(CALL_INFO, -1, "%s, Error - memory size must be a multiple of line size. Memory size is %zu bytes and line size is %" PRIu64 " bytes\n",
                 getName().c_str(), memSize_, lineSize_);
-    cache_.resize(cachesize, CacheState(0,I));
+
+    std::string organization = params.find<std::string>("organization", "direct");
+    assoc_ = 1;
+    slotSize_ = lineSize_;
+    tagBytes_ = 0;
+    tagBase_ = 0;
+    if (organization == "direct") {
+        organization_ = Organization::Direct;
+        numSets_ = memSize_ / lineSize_;
+    } else if (organization == "alloy") {
+        organization_ = Organization::Alloy;
+        tagBytes_ = params.find<uint64_t>("alloy_tag_bytes", 8);
+        slotSize_ = lineSize_ + tagBytes_;
+        numSets_ = memSize_ / slotSize_;
+    } else if (organization == "set_assoc") {
+        organization_ = Organization::SetAssoc;
+        assoc_ = params.find<uint64_t>("associativity", 8);
+        tagBytes_ = params.find<uint64_t>("tag_block_size", 64);
+        if (assoc_ == 0)
+            out.fatal(CALL_INFO, -1, "%s, Error - Invalid param: associativity. Must be at least 1.\n", getName().c_str());
+        numSets_ = memSize_ / (assoc_ * lineSize_ + tagBytes_);
+        tagBase_ = numSets_ * assoc_ * lineSize_;   // Tag blocks follow the data
+    } else {
+        out.fatal(CALL_INFO, -1, "%s, Error - Invalid param: organization. Must be one of 'direct', 'alloy', or 'set_assoc'. You specified: %s\n",
+                getName().c_str(), organization.c_str());
+    }
+    if (numSets_ == 0)
+        out.fatal(CALL_INFO, -1, "%s, Error - memory size (%zu bytes) is too small to hold one set of the '%s' organization\n",
+                getName().c_str(), memSize_, organization.c_str());
+    useCount_ = 0;
+
+    uint64_t mshrEntries = params.find<uint64_t>("mshr_entries", 256);
+    outstandingEvents_ = AddrHashTable<MemAccessRecord, SST::Event::id_type>(mshrEntries);
+    mshr_ = AddrHashTable<SetQueue>(mshrEntries);
 
     /* Statistics */
     statReadHit = registerStatistic<uint64_t>("CacheHits_Read");
     statReadMiss = registerStatistic<uint64_t>("CacheMisses_Read");
     statWriteHit = registerStatistic<uint64_t>("CacheHits_Write");
     statWriteMiss = registerStatistic<uint64_t>("CacheMisses_Write");
+    statWriteback = registerStatistic<uint64_t>("CacheWritebacks");
 
 }
 
@@ -229,14 +258,14 @@ void MemCacheController::handleEvent(SST::Event* event) {
         case Command::GetS:
         case Command::GetSX:
         case Command::GetX:
-            handleRead(ev, false);
+            handleAccess(ev, false, false);
             break;
         case Command::Write:
-            handleWrite(ev, false);
+            handleAccess(ev, false, true);
             break;
         case Command::PutM:
             ev->setFlag(MemEvent::F_NORESPONSE);
-            handleWrite(ev, false);
+            handleAccess(ev, false, true);
             break;
         case Command::FlushLine:
         case Command::FlushLineInv:
@@ -256,96 +285,83 @@ void MemCacheController::handleEvent(SST::Event* event) {
 }
 
 
-void MemCacheController::handleRead(MemEvent* event, bool replay) {
-    Addr cacheIndex = toLocalAddr(event->getBaseAddr());
-    if (cacheIndex >= cache_.size())
-        out.fatal(CALL_INFO, -1, "%s, Error: cache index exceeds cache size, try again!\n", getName().c_str());
-    Addr blockAddr = cache_[cacheIndex].addr;
-    State blockState = cache_[cacheIndex].state;
-
-    if (is_debug_event(event)) {
-        Debug(_L3_, "%" PRIu64 " (%s) handleRead, Line: %" PRIu64 ", 0x%" PRIx64 ", %s\n",
-                getCurrentSimTimeNano(),
-                getName().c_str(),
-                cacheIndex,
-                blockAddr,
-                StateString[blockState]);
-    }
+/* Reads and writes. Requests to a set are handled in order, one at a time. */
+void MemCacheController::handleAccess(MemEvent* event, bool replay, bool write) {
+    Addr set = getSet(event->getBaseAddr());
+    MemAccessRecord* rec;
 
     if (!replay) {
-        MemAccessRecord rec;
-        rec.event = event;
-        outstandingEvents_.insert(std::make_pair(event->getID(), rec));
-        mshr_[cacheIndex].push(event->getID());
+        rec = &outstandingEvents_.insert(event->getID());
+        rec->event = event;
+        rec->set = set;
+        SetQueue& queue = mshr_.insert(set);
+        if (queue.tail)
+            queue.tail->next = rec;
+        else
+            queue.head = rec;
+        queue.tail = rec;
+    } else {
+        rec = outstandingEvents_.find(event->getID());
     }
-    std::map<SST::Event::id_type, MemAccessRecord>::iterator it = outstandingEvents_.find(event->getID());
 
-    if (mshr_.find(cacheIndex)->second.front() != event->getID()) {         // Transition
-        it->second.status = AccessStatus::STALL;
+    if (mshr_.find(set)->head != rec) {                                     // Transition
+        rec->status = AccessStatus::STALL;
         if (is_debug_event(event))
             Debug(_L3_, "%" PRIu64 " (%s) StateTransition %" PRIu64 ", STALL\n", getCurrentSimTimeNano(), getName().c_str(), event->getID().first);
         return;
-    } else if (blockState == I || blockAddr != event->getBaseAddr()) {      // MISS
-        it->second.status = (blockState == M) ? AccessStatus::MISS_WB : AccessStatus::MISS;
-        statReadMiss->addData(1);
-        if (is_debug_event(event))
-            Debug(_L3_, "%" PRIu64 " (%s) StateTransition %" PRIu64 ", %s\n", getCurrentSimTimeNano(), getName().c_str(), event->getID().first, (blockState == M) ? "MISS_WB" : "MISS");
-    } else {                                                                // HIT
-        statReadHit->addData(1);
-        it->second.status = AccessStatus::HIT;
-        if (is_debug_event(event))
-            Debug(_L3_, "%" PRIu64 " (%s) StateTransition %" PRIu64 ", HIT\n", getCurrentSimTimeNano(), getName().c_str(), event->getID().first);
     }
 
-    it->second.reqev = new MemEvent(*event);
-    it->second.reqev->setBaseAddr(cacheIndex);
-    it->second.reqev->setAddr(event->getAddr() - event->getBaseAddr() + cacheIndex);
-    it->second.reqev->setCmd(Command::GetS);
-
-    memBackendConvertor_->handleMemEvent(it->second.reqev);
-}
-
-void MemCacheController::handleWrite(MemEvent* event, bool replay) {
-    Addr cacheIndex = toLocalAddr(event->getBaseAddr());
-    Addr blockAddr = cache_[cacheIndex].addr;
-    State blockState = cache_[cacheIndex].state;
-
-    if (is_debug_event(event))
-        Debug(_L3_, "\n%" PRIu64 " (%s) handleWrite, Line: %" PRIu64 ", 0x%" PRIx64 ", %s\n", getCurrentSimTimeNano(), getName().c_str(), cacheIndex, blockAddr, StateString[blockState]);
-
-    if (!replay) {
-        MemAccessRecord rec;
-        rec.event = event;
-        outstandingEvents_.insert(std::make_pair(event->getID(), rec));
-        mshr_[cacheIndex].push(event->getID());
+    /* Look for the line in the set; on a miss, replace an invalid way or else the LRU way */
+    std::vector<CacheWay>& ways = getCacheSet(set).ways;
+    uint32_t way = 0;
+    bool hit = false;
+    for (uint32_t i = 0; i < ways.size(); i++) {
+        if (ways[i].state != I && ways[i].addr == event->getBaseAddr()) {
+            way = i;
+            hit = true;
+            break;
+        }
+        if (ways[way].state != I && (ways[i].state == I || ways[i].lastUse < ways[way].lastUse))
+            way = i;
     }
-    std::map<SST::Event::id_type, MemAccessRecord>::iterator it = outstandingEvents_.find(event->getID());
+    rec->way = way;
 
-    if (mshr_.find(cacheIndex)->second.front() != event->getID()) {         // Transition
-        it->second.status = AccessStatus::STALL;
-        if (is_debug_event(event))
-            Debug(_L3_, "\n%" PRIu64 " (%s) StateTransition %" PRIu64 ", STALL\n", getCurrentSimTimeNano(), getName().c_str(), event->getID().first);
-        return;
-    } else if (blockState == I || blockAddr != event->getBaseAddr()) {      // MISS
-        // Do a read to time the state lookup
-        statWriteMiss->addData(1);
-        it->second.status = (blockState == M ) ? AccessStatus::MISS_WB : AccessStatus::MISS;
-        if (is_debug_event(event))
-            Debug(_L3_, "\n%" PRIu64 " (%s) StateTransition %" PRIu64 ", %s\n", getCurrentSimTimeNano(), getName().c_str(), event->getID().first, (blockState == M) ? "MISS_WB" : "MISS");
-    } else {                                                                // HIT
-        statWriteHit->addData(1);
-        it->second.status = AccessStatus::HIT_TAG;
-        if (is_debug_event(event))
-            Debug(_L3_, "\n%" PRIu64 " (%s) StateTransition %" PRIu64 ", HIT\n", getCurrentSimTimeNano(), getName().c_str(), event->getID().first);
+    if (is_debug_event(event)) {
+        Debug(_L3_, "%" PRIu64 " (%s) handleAccess, Set: %" PRIu64 ", Way: %" PRIu32 ", 0x%" PRIx64 ", %s\n",
+                getCurrentSimTimeNano(), getName().c_str(), set, way, ways[way].addr, StateString[ways[way].state]);
+    }
+
+    if (!hit) {                                                             // MISS
+        rec->status = (ways[way].state == M) ? AccessStatus::MISS_WB : AccessStatus::MISS;
+        (write ? statWriteMiss : statReadMiss)->addData(1);
+    } else if (write || organization_ == Organization::SetAssoc) {         // HIT, but the tag must be checked before the data access
+        ways[way].lastUse = ++useCount_;
+        rec->status = AccessStatus::HIT_TAG;
+        (write ? statWriteHit : statReadHit)->addData(1);
+    } else {                                                                // HIT, the tag and data are read together
+        ways[way].lastUse = ++useCount_;
+        rec->status = AccessStatus::HIT;
+        statReadHit->addData(1);
+    }
+    if (is_debug_event(event)) {
+        const char* status = rec->status == AccessStatus::MISS ? "MISS" : (rec->status == AccessStatus::MISS_WB ? "MISS_WB" : (rec->status == AccessStatus::HIT ? "HIT" : "HIT_TAG"));
+        Debug(_L3_, "%" PRIu64 " (%s) StateTransition %" PRIu64 ", %s\n", getCurrentSimTimeNano(), getName().c_str(), event->getID().first, status);
     }
 
     /* Lookup tag data -> required whether or not this is a hit */
-    it->second.reqev = new MemEvent(*event);
-    it->second.reqev->setBaseAddr(cacheIndex);
-    it->second.reqev->setAddr(event->getAddr() - event->getBaseAddr() + cacheIndex);
-    it->second.reqev->setCmd(Command::GetS);
-
-    memBackendConvertor_->handleMemEvent(it->second.reqev);
+    MemEvent* lookup;
+    switch (organization_) {
+        case Organization::Direct:
+            lookup = makeLocalRequest(rec, Command::GetS, getSlot(rec) * slotSize_, event->getSize());
+            break;
+        case Organization::Alloy:
+            lookup = makeLocalRequest(rec, Command::GetS, getSlot(rec) * slotSize_, slotSize_);
+            break;
+        default:
+            lookup = makeLocalRequest(rec, Command::GetS, tagBase_ + set * tagBytes_, tagBytes_);
+            break;
+    }
+    memBackendConvertor_->handleMemEvent(lookup); // May respond immediately, so the record must be up to date
 }
 
 
@@ -357,56 +373,57 @@ void MemCacheController::handleFlush(MemEvent* event) {
 
 /* Response from remote memory */
 void MemCacheController::handleDataResponse(MemEvent* event) {
-    std::map<SST::Event::id_type,MemAccessRecord>::iterator it = outstandingEvents_.find(event->getID());
-    Addr cacheIndex = toLocalAddr(event->getBaseAddr());
-    Addr blockAddr = cache_[cacheIndex].addr;
-    State blockState = cache_[cacheIndex].state;
+    MemAccessRecord* rec = outstandingEvents_.find(event->getResponseToID());
+    if (rec == nullptr)
+        out.fatal(CALL_INFO, -1, "%s, MemoryCache received unrecognized response: %s\n", getName().c_str(), event->getVerboseString(dlevel).c_str());
+
+    Addr slot = getSlot(rec);
+    CacheWay& way = getCacheSet(rec->set).ways[rec->way];
 
     if (is_debug_event(event))
-        Debug(_L3_, "\n%" PRIu64 " (%s) handleDataResponse, Line: %" PRIu64 ", 0x%" PRIx64 ", %s\n",
-                getCurrentSimTimeNano(), getName().c_str(), cacheIndex, blockAddr, StateString[blockState]);
+        Debug(_L3_, "\n%" PRIu64 " (%s) handleDataResponse, Set: %" PRIu64 ", Way: %" PRIu32 ", 0x%" PRIx64 ", %s\n",
+                getCurrentSimTimeNano(), getName().c_str(), rec->set, rec->way, way.addr, StateString[way.state]);
 
     // update the backing store from the remote memory response
     if (backing_)
-        writeData(event);
-
-    // Update local memory
-    it->second.reqev = new MemEvent(*it->second.event);
-    it->second.reqev->setAddr(cacheIndex);
-    it->second.reqev->setBaseAddr(cacheIndex);
-    it->second.reqev->setCmd(Command::PutM);
-    it->second.reqev->setPayload(event->getPayload());
-    it->second.reqev->clearFlag();
-    it->second.reqev->setFlag(MemEvent::F_NORESPONSE);
-    it->second.status = AccessStatus::FIN;
-    if (is_debug_event(event))
-        Debug(_L3_, "\n%" PRIu64 " (%s) StateTransition %" PRIu64 ", FIN\n", getCurrentSimTimeNano(), getName().c_str(), it->second.event->getID().first);
-    memBackendConvertor_->handleMemEvent(it->second.reqev);
+        writeData(event, slot);
 
     // Update backing store from the request that missed if it was a write
-    if (it->second.event->getCmd() == Command::PutM || it->second.event->getCmd() == Command::Write) {
-        cache_[cacheIndex].state = M;
+    if (rec->event->getCmd() == Command::PutM || rec->event->getCmd() == Command::Write) {
+        way.state = M;
         if (backing_)
-            writeData(it->second.event);
+            writeData(rec->event, slot);
     } else {
-        cache_[cacheIndex].state = E;
+        way.state = E;
     }
 
     // Respond to requestor
-    if (!(it->second.event->queryFlag(MemEvent::F_NORESPONSE))) {
-        sendResponse(it->second.event, 0);
+    if (!(rec->event->queryFlag(MemEvent::F_NORESPONSE))) {
+        sendResponse(rec->event, slot, 0);
     }
+
+    // Update local memory (for 'set_assoc', the tag block update is assumed to be part of the fill)
+    MemEvent* fill = makeLocalRequest(rec, Command::PutM, slot * slotSize_, slotSize_);
+    fill->setPayload(event->getPayloadBuffer());
+    fill->setSize(slotSize_);
+    fill->clearFlag();
+    fill->setFlag(MemEvent::F_NORESPONSE);
+    rec->status = AccessStatus::FIN;
+    if (is_debug_event(event))
+        Debug(_L3_, "\n%" PRIu64 " (%s) StateTransition %" PRIu64 ", FIN\n", getCurrentSimTimeNano(), getName().c_str(), rec->event->getID().first);
     delete event;
+    memBackendConvertor_->handleMemEvent(fill);
 }
 
 /* Response from memory cache */
 void MemCacheController::handleLocalMemResponse( Event::id_type id, uint32_t flags) {
-    std::map<SST::Event::id_type,MemAccessRecord>::iterator it = outstandingEvents_.find(id);
-    if (it == outstandingEvents_.end())
+    MemAccessRecord* rec = outstandingEvents_.find(id);
+    if (rec == nullptr)
         out.fatal(CALL_INFO, -1, "%s, MemoryCache received unrecognized response ID: %" PRIu64 ", %" PRIu32 "", getName().c_str(), id.first, id.second);
 
-    delete it->second.reqev;
-    MemEventBase * evb = it->second.event;
+    delete rec->reqev;
+    rec->reqev = nullptr;
+    MemEventBase * evb = rec->event;
 
     if (is_debug_event(evb)) {
         Debug(_L3_, "MemoryCache: %s - Response received to (%s)\n", getName().c_str(), evb->getVerboseString(dlevel).c_str());
@@ -422,69 +439,76 @@ void MemCacheController::handleLocalMemResponse( Event::id_type id, uint32_t fla
     }
 
     MemEvent * ev = static_cast<MemEvent*>(evb);
+    bool write = ev->getCmd() == Command::PutM || ev->getCmd() == Command::Write;
 
-    bool noncacheable  = ev->queryFlag(MemEvent::F_NONCACHEABLE);
-
-    Addr cacheIndex = toLocalAddr(ev->getBaseAddr());
-    Addr blockAddr = cache_[cacheIndex].addr;
-    State blockState = cache_[cacheIndex].state;
+    Addr set = rec->set;
+    Addr slot = getSlot(rec);
+    CacheWay& way = getCacheSet(set).ways[rec->way];
 
     if (is_debug_event(ev))
-        Debug(_L3_, "\n%" PRIu64 " (%s) handleLocalResponse, Line: %" PRIu64 ", 0x%" PRIx64 ", %s\n",
-                getCurrentSimTimeNano(), getName().c_str(), cacheIndex, blockAddr, StateString[blockState]);
+        Debug(_L3_, "\n%" PRIu64 " (%s) handleLocalResponse, Set: %" PRIu64 ", Way: %" PRIu32 ", 0x%" PRIx64 ", %s\n",
+                getCurrentSimTimeNano(), getName().c_str(), set, rec->way, way.addr, StateString[way.state]);
 
-    MemEvent * remoteRd, *remoteWr;
-    Addr localIndex;
-    switch (it->second.status) {
+    MemEvent * remoteRd, *remoteWr, *access;
+    SetQueue * queue;
+    switch (rec->status) {
         case AccessStatus::MISS_WB:
             /* Write back data to memory */
-            remoteWr = new MemEvent(getName(), blockAddr, blockAddr, Command::PutM, lineSize_);
-            readData(remoteWr);
+            remoteWr = new MemEvent(getName(), way.addr, way.addr, Command::PutM, lineSize_);
+            readData(remoteWr, slot);
             remoteWr->setFlag(MemEvent::F_NORESPONSE); // Don't send a response to this
             remoteWr->setDst(link_->getTargetDestination(remoteWr->getBaseAddr()));
             link_->send(remoteWr);
+            statWriteback->addData(1);
         case AccessStatus::MISS:
-            /* Read new data from memory */
+            /* Read the whole line from memory */
             remoteRd = new MemEvent(*ev);
             remoteRd->setCmd(Command::GetS);
+            remoteRd->setAddr(ev->getBaseAddr());
+            remoteRd->setPayload(std::vector<uint8_t>());
+            remoteRd->setSize(lineSize_);
             remoteRd->setSrc(getName());
             remoteRd->setDst(link_->getTargetDestination(remoteRd->getBaseAddr()));
             if (remoteRd->queryFlag(MemEvent::F_NORESPONSE))
                 remoteRd->clearFlag(MemEvent::F_NORESPONSE);
-            it->second.reqev = remoteRd;
+            if (remoteRd->queryFlag(MemEvent::F_NONCACHEABLE))
+                remoteRd->clearFlag(MemEvent::F_NONCACHEABLE);
+            rec->status = AccessStatus::DATA; // We've request data, waiting for response
+            if (is_debug_event(ev))
+                Debug(_L3_, "\n%" PRIu64 " (%s) StateTransition %" PRIu64 ", DATA\n", getCurrentSimTimeNano(), getName().c_str(), ev->getID().first);
+            way.addr = ev->getBaseAddr();
+            way.state = IM;
+            way.lastUse = ++useCount_;
             link_->send(remoteRd);
-            it->second.status = AccessStatus::DATA; // We've request data, waiting for response
-            if (is_debug_event(it->second.event))
-                Debug(_L3_, "\n%" PRIu64 " (%s) StateTransition %" PRIu64 ", DATA\n", getCurrentSimTimeNano(), getName().c_str(), it->second.event->getID().first);
-            cache_[cacheIndex].addr = ev->getBaseAddr();
-            cache_[cacheIndex].state = IM;
             break;
-        case AccessStatus::HIT_TAG: // tag hit, issue write
-            it->second.reqev = new MemEvent(*ev);
-            it->second.status = AccessStatus::HIT;
-            if (is_debug_event(it->second.event))
-                Debug(_L3_, "\n%" PRIu64 " (%s) StateTransition %" PRIu64 ", HIT\n", getCurrentSimTimeNano(), getName().c_str(), it->second.event->getID().first);
-            memBackendConvertor_->handleMemEvent(ev);
-            cache_[cacheIndex].state = M;
+        case AccessStatus::HIT_TAG: // tag hit, issue the data access
+            rec->status = AccessStatus::HIT;
+            if (is_debug_event(ev))
+                Debug(_L3_, "\n%" PRIu64 " (%s) StateTransition %" PRIu64 ", HIT\n", getCurrentSimTimeNano(), getName().c_str(), ev->getID().first);
+            if (write)
+                way.state = M;
+            access = makeLocalRequest(rec, write ? Command::PutM : Command::GetS, slot * slotSize_, ev->getSize());
+            memBackendConvertor_->handleMemEvent(access);
             break;
         case AccessStatus::HIT:
             /* Write data. Here instead of receive to try to match backing access order to backend execute order */
-            if (backing_ && (ev->getCmd() == Command::PutM || ev->getCmd() == Command::Write))
-                writeData(ev);
+            if (backing_ && write)
+                writeData(ev, slot);
 
             if (!ev->queryFlag(MemEvent::F_NORESPONSE)) {
-                sendResponse(ev, flags);
+                sendResponse(ev, slot, flags);
             }
         case AccessStatus::FIN: // Just finished updating the cache, ready for new requests now
-            if (is_debug_event(it->second.event))
-                Debug(_L3_, "\n%" PRIu64 " (%s) StateTransition %" PRIu64 ", ERASE\n", getCurrentSimTimeNano(), getName().c_str(), it->second.event->getID().first);
+            if (is_debug_event(ev))
+                Debug(_L3_, "\n%" PRIu64 " (%s) StateTransition %" PRIu64 ", ERASE\n", getCurrentSimTimeNano(), getName().c_str(), ev->getID().first);
             delete ev;
-            mshr_[cacheIndex].pop();
-            outstandingEvents_.erase(it);
-            if (mshr_[cacheIndex].empty())
-                mshr_.erase(cacheIndex);
+            queue = mshr_.find(set);
+            queue->head = rec->next;
+            outstandingEvents_.erase(id);
+            if (queue->head == nullptr)
+                mshr_.erase(set);
             else
-                retry(cacheIndex);
+                retry(set);
             break;
         default:
             out.fatal(CALL_INFO, -1, "%s, MemoryCache encountered unhandled record status. Event is %s\n",
@@ -492,8 +516,8 @@ void MemCacheController::handleLocalMemResponse( Event::id_type id, uint32_t fla
     }
 }
 
-void MemCacheController::retry(uint64_t cacheIndex) {
-    MemEvent* ev = outstandingEvents_.find(mshr_[cacheIndex].front())->second.event;
+void MemCacheController::retry(Addr set) {
+    MemEvent* ev = mshr_.find(set)->head->event;
 
     if (is_debug_event(ev)) {
         Debug(_L3_, "\n%" PRIu64 " (%s) Retrying: %s\n", getCurrentSimTimeNano(), getName().c_str(), ev->getVerboseString(dlevel).c_str());
@@ -502,24 +526,50 @@ void MemCacheController::retry(uint64_t cacheIndex) {
         case Command::GetS:
         case Command::GetSX:
         case Command::GetX:
-            handleRead(ev, true);
+            handleAccess(ev, true, false);
             break;
         case Command::Write:
         case Command::PutM:
-            handleWrite(ev, true);
+            handleAccess(ev, true, true);
             break;
         default:
             break;
     }
 }
 
-void MemCacheController::sendResponse(MemEvent* ev, uint32_t flags) {
+/* Access to the memory cache's DRAM on behalf of 'rec'. The request keeps the ID of rec's event so the response finds the record. */
+MemEvent* MemCacheController::makeLocalRequest(MemAccessRecord* rec, Command cmd, Addr localAddr, uint32_t size) {
+    MemEvent* req = new MemEvent(*rec->event);
+    req->setBaseAddr(localAddr);
+    req->setAddr(localAddr);
+    req->setCmd(cmd);
+    req->setSize(size);
+    rec->reqev = req;
+    return req;
+}
+
+/* Which set a line maps to. Lines are interleaved across the memory caches, so drop the interleave before indexing. */
+Addr MemCacheController::getSet(Addr baseAddr) {
+    Addr line = baseAddr >> lineOffset_;
+    Addr set = (line / (region_.interleaveStep / region_.interleaveSize)) % numSets_;
+
+    if (is_debug_addr(baseAddr)) { Debug(_L10_,"\tConverting global address 0x%" PRIx64 " to set %" PRIu64 "\n", baseAddr, set); }
+    return set;
+}
+
+MemCacheController::CacheSet& MemCacheController::getCacheSet(Addr set) {
+    CacheSet& cset = tags_.insert(set);
+    if (cset.ways.empty())
+        cset.ways.resize(assoc_);
+    return cset;
+}
+
+void MemCacheController::sendResponse(MemEvent* ev, Addr slot, uint32_t flags) {
     MemEvent * resp = ev->makeResponse();
 
-    bool noncacheable = ev->queryFlag(MemEvent::F_NONCACHEABLE);
     /* Read order matches execute order so that mis-ordering at backend can result in bad data */
     if (resp->getCmd() == Command::GetSResp || resp->getCmd() == Command::GetXResp) {
-        readData(resp);
+        readData(resp, slot);
         resp->setCmd(Command::GetXResp);
     }
 
@@ -585,37 +635,21 @@ void MemCacheController::finish(void) {
     link_->finish();
 }
 
-void MemCacheController::writeData(MemEvent* event) {
+/* The backing store holds the cached lines, by slot */
+void MemCacheController::writeData(MemEvent* event, Addr slot) {
     /* Noncacheable events occur on byte addresses, others on line addresses */
     bool noncacheable = event->queryFlag(MemEvent::F_NONCACHEABLE);
-    Addr addr = noncacheable ? event->getAddr() : event->getBaseAddr();
-
-    addr = toLocalAddr(addr);
+    Addr addr = slot * lineSize_ + (noncacheable ? event->getAddr() - event->getBaseAddr() : 0);
 
-    if (event->getCmd() == Command::PutM) { /* Write request to memory */
-        if (is_debug_event(event)) { Debug(_L4_, "\tUpdate backing. Addr = %" PRIx64 ", Size = %i\n", addr, event->getSize()); }
-
-        backing_->set(addr, event->getSize(), event->getPayload());
-
-        return;
-    }
-
-    if (event->getCmd() == Command::Write) {
-        if (is_debug_event(event)) { Debug(_L4_, "\tUpdate backing. Addr = %" PRIx64 ", Size = %i\n", addr, event->getSize()); }
-
-        backing_->set(addr, event->getSize(), event->getPayload());
-
-        return;
-    }
+    if (is_debug_event(event)) { Debug(_L4_, "\tUpdate backing. Addr = %" PRIx64 ", Size = %i\n", addr, event->getSize()); }
 
+    backing_->set(addr, event->getSize(), event->getPayload());
 }
 
 
-void MemCacheController::readData(MemEvent* event) {
+void MemCacheController::readData(MemEvent* event, Addr slot) {
     bool noncacheable = event->queryFlag(MemEvent::F_NONCACHEABLE);
-    Addr localAddr = noncacheable ? event->getAddr() : event->getBaseAddr();
-
-    localAddr = toLocalAddr(localAddr);
+    Addr localAddr = slot * lineSize_ + (noncacheable ? event->getAddr() - event->getBaseAddr() : 0);
 
     vector<uint8_t> payload;
     payload.resize(event->getSize(), 0);
@@ -623,7 +657,7 @@ void MemCacheController::readData(MemEvent* event) {
     if (backing_)
         backing_->get(localAddr, event->getSize(), payload);
 
-    event->setPayload(payload);
+    event->setPayload(std::move(payload));
 }
 
 
@@ -631,8 +665,7 @@ void MemCacheController::readData(MemEvent* event) {
 void MemCacheController::writeData(Addr addr, std::vector<uint8_t> * data) {
     if (!backing_) return;
 
-    for (size_t i = 0; i < data->size(); i++)
-        backing_->set(addr + i, data->at(i));
+    backing_->set(addr, data->size(), *data);
 }
 
 
@@ -641,26 +674,10 @@ void MemCacheController::readData(Addr addr, size_t bytes, std::vector<uint8_t>
 
     if (!backing_) return;
 
-    for (size_t i = 0; i < bytes; i++)
-        data[i] = backing_->get(addr + i);
+    backing_->get(addr, bytes, data);
 }
 
 
-/* Translations assume interleaveStep is divisible by interleaveSize */
-Addr MemCacheController::toLocalAddr(Addr addr) {
-    Addr shift = addr >> lineOffset_;
-    Addr rAddr = shift / (region_.interleaveSize >> lineOffset_); // Divide by num caches
-    //Addr step = shift / region_.interleaveStep;
-    //Addr offset = shift % region_.interleaveStep;
-    //Addr rAddr = (step * region_.interleaveSize) + offset;
-    rAddr = rAddr % cache_.size();
-
-    if (is_debug_addr(addr)) { Debug(_L10_,"\tConverting global address 0x%" PRIx64 " to local index %" PRIu64 "\n", addr, rAddr); }
-    return rAddr;
-}
-
-
-
 void MemCacheController::processInitEvent( MemEventInit* me ) {
     /* Forward data to remote memory */
     if (Command::NULLCMD == me->getCmd()) {
@@ -679,10 +696,10 @@ void MemCacheController::printStatus(Output &statusOut) {
     statusOut.output("MemHierarchy::MemoryController %s\n", getName().c_str());
 
     statusOut.output("  Outstanding events: %zu\n", outstandingEvents_.size());
-/*    for (std::map<SST::Event::id_type, MemEventBase*>::iterator it = outstandingEvents_.begin(); it != outstandingEvents_.end(); it++) {
-        statusOut.output("    %s\n", it->second->getVerboseString(dlevel).c_str());
+    for (AddrHashTable<MemAccessRecord, SST::Event::id_type>::iterator it = outstandingEvents_.begin(); it != outstandingEvents_.end(); ++it) {
+        statusOut.output("    Set %" PRIu64 ": %s\n", it.value().set, it.value().event->getVerboseString(dlevel).c_str());
     }
-    */
+    statusOut.output("  Sets with waiting requests: %zu, sets accessed: %zu of %" PRIu64 "\n", mshr_.size(), tags_.size(), numSets_);
 
     statusOut.output("  Link Status: ");
     if (link_)
@@ -22,6 +22,7 @@
 #include <sst/core/event.h>
 
 #include "sst/elements/memHierarchy/memEvent.h"
+#include "sst/elements/memHierarchy/addrHashTable.h"
 #include "sst/elements/memHierarchy/cacheListener.h"
 #include "sst/elements/memHierarchy/memLinkBase.h"
 #include "sst/elements/memHierarchy/membackend/backing.h"
@@ -42,6 +43,11 @@ public:
             {"num_caches",          "(uint) Total number of memory caches", "1"},\
             {"cache_num",           "(uint) Index of this cache between 0 and num_caches-1", "0"}, \
             {"cache_line_size",     "(uint) Cache line size in bytes", "64"}, \
+            {"organization",        "(string) Cache organization. 'direct': direct-mapped, the tag is checked by reading the line. 'alloy': direct-mapped with tag and data stored together and read in one access (Alloy cache). 'set_assoc': set-associative with each set's tags in a block in DRAM; a lookup reads the tag block, then a hit accesses the data.", "direct"}, \
+            {"associativity",       "(uint) For 'set_assoc', number of ways per set. LRU replacement.", "8"}, \
+            {"alloy_tag_bytes",     "(uint) For 'alloy', bytes of tag stored and read with each line", "8"}, \
+            {"tag_block_size",      "(uint) For 'set_assoc', bytes read to look up a set's tags", "64"}, \
+            {"mshr_entries",        "(uint) Number of outstanding requests the request table and MSHR are sized for. Not a limit: more are accepted but then allocate.", "256"}, \
             {"backing",             "(string) Type of backing store to use. Options: 'none' - no backing store (only use if simulation does not require correct memory values), 'malloc', or 'mmap'", "mmap"},\
             {"backing_size_unit",   "(string) For 'malloc' backing stores, malloc granularity", "1MiB"},\
             {"memory_file",         "(string) Optional backing-store file to pre-load memory, or store resulting state", "N/A"},\
@@ -57,6 +63,7 @@ public:
             {"CacheHits_Write",  "Number of write hits", "count", 1},
             {"CacheMisses_Read",  "Number of read misses", "count", 1},
             {"CacheMisses_Write",  "Number of write misses", "count", 1},
+            {"CacheWritebacks",  "Number of dirty lines written back to remote memory", "count", 1},
             )
 
 #define MEMCACHE_ELI_SUBCOMPONENTSLOTS {"backend", "Memory controller and/or memory timing model.", "SST::MemHierarchy::MemBackend"},\
@@ -94,34 +101,83 @@ protected:
      *  HIT_TAG: The lookup will be a hit but we need to check the tag first (needed for a write)
      *  MISS: The lookup will be a miss; the current access is to check the tag
      *  MISS_WB: The lookup will be a miss and require a writeback; the current access is to check the tag
-     *  STALL: Another access for the same line is outstanding, stall until it finishes -> may not actually be how MCDRAM works...
+     *  STALL: Another access to the same set is outstanding, stall until it finishes -> may not actually be how MCDRAM works...
      *  DATA: Sent a request for data to the remote memroy
      */
     enum class AccessStatus { HIT, HIT_TAG, MISS, MISS_WB, DATA, STALL, FIN };
 
+    enum class Organization { Direct, Alloy, SetAssoc };
+
+    /* Outstanding requests, in a pooled slot table keyed by event ID */
     struct MemAccessRecord {
         MemEvent* event;
         AccessStatus status;
         MemEvent* reqev;
-
-        MemAccessRecord() : event(nullptr), status(AccessStatus::MISS), reqev(nullptr) { }
-        MemAccessRecord(MemEvent* ev, AccessStatus stat) : event(ev), status(stat), reqev(nullptr) { }
+        Addr set;
+        uint32_t way;
+        MemAccessRecord* next;  // Next request waiting on the same set
+
+        MemAccessRecord() { reset(); }
+        void reset() {
+            event = nullptr;
+            status = AccessStatus::MISS;
+            reqev = nullptr;
+            set = 0;
+            way = 0;
+            next = nullptr;
+        }
     };
 
-    std::map<SST::Event::id_type, MemAccessRecord> outstandingEvents_;
+    /* MSHR: requests to a set are handled one at a time, oldest first */
+    struct SetQueue {
+        MemAccessRecord* head;
+        MemAccessRecord* tail;
 
-    std::map<uint64_t, std::queue<SST::Event::id_type> > mshr_;
+        SetQueue() { reset(); }
+        void reset() { head = tail = nullptr; }
+    };
 
-    struct CacheState {
-        Addr addr;
+    struct CacheWay {
+        Addr addr;          // Base address of the line held
         State state;
-        CacheState(Addr a, State s) : addr(a), state(s) { }
+        uint64_t lastUse;   // For LRU
+
+        CacheWay() : addr(0), state(I), lastUse(0) { }
     };
 
-    std::vector<CacheState> cache_;
+    /* Tags are only allocated for sets that have been accessed */
+    struct CacheSet {
+        std::vector<CacheWay> ways;
+        void reset() { ways.clear(); }
+    };
+
+    /*
+     * The request table and MSHR are sized for 'mshr_entries' but are not a
+     * hard limit. Like MemController, this component has no way to push back:
+     * memory controllers never NACK, so nothing above expects to retry a
+     * request sent to memory, and the caches and directories above already
+     * bound what they send with their own MSHRs. Past 'mshr_entries' the
+     * tables grow instead, as the backend convertor's request queue does.
+     */
+    AddrHashTable<MemAccessRecord, SST::Event::id_type> outstandingEvents_;
+    AddrHashTable<SetQueue> mshr_;
+    AddrHashTable<CacheSet> tags_;
+
+    Organization organization_;
+    uint64_t assoc_;
+    uint64_t numSets_;
+    uint64_t slotSize_;     // Bytes of DRAM per line, including the tag for 'alloy'
+    uint64_t tagBytes_;     // Bytes read by a tag lookup ('alloy' and 'set_assoc')
+    Addr tagBase_;          // For 'set_assoc', local address of the first tag block
+    uint64_t useCount_;     // LRU timestamp
     Addr lineSize_;
     Addr lineOffset_;
 
+    Addr getSet(Addr baseAddr);
+    CacheSet& getCacheSet(Addr set);
+    Addr getSlot(MemAccessRecord* rec) { return rec->set * assoc_ + rec->way; }
+    MemEvent* makeLocalRequest(MemAccessRecord* rec, Command cmd, Addr localAddr, uint32_t size);
+
     void notifyListeners( MemEvent* ev ) {
         if (  ! listeners_.empty()) {
             // AFR: should this pass the base Addr?
@@ -139,13 +195,12 @@ protected:
 
     virtual bool clock( SST::Cycle_t );
 
-    void handleRead(MemEvent* ev, bool replay);
-    void handleWrite(MemEvent* ev, bool replay);
+    void handleAccess(MemEvent* ev, bool replay, bool write);
     void handleFlush(MemEvent* ev);
     void handleDataResponse(MemEvent* ev);
-    void retry(Addr cacheIndex);
+    void retry(Addr set);
 
-    void sendResponse(MemEvent* ev, uint32_t flags);
+    void sendResponse(MemEvent* ev, Addr slot, uint32_t flags);
 
     Output out;
     Output dbg;
@@ -164,15 +219,14 @@ protected:
         return region_.contains(addr);
     }
 
-    void writeData( MemEvent* );
-    void readData( MemEvent* );
+    void writeData( MemEvent*, Addr slot );
+    void readData( MemEvent*, Addr slot );
 
     size_t memSize_;
 
     bool clockOn_;
 
     MemRegion region_; // Which address region we are, for translating to local addresses
-    Addr toLocalAddr(Addr addr);
 
     Clock::Handler<MemCacheController>* clockHandler_;
     TimeConverter* clockTimeBase_;
@@ -187,6 +241,7 @@ protected:
     Statistic<uint64_t>* statReadMiss;
     Statistic<uint64_t>* statWriteHit;
     Statistic<uint64_t>* statWriteMiss;
+    Statistic<uint64_t>* statWriteback;
 
 private:
     void handleCustomEvent(MemEventBase* ev);
@@ -36,12 +36,8 @@ using namespace SST::MemHierarchy;
 
 // Debug macros
 #ifdef __SST_DEBUG_OUTPUT__
-#define is_debug_addr(addr) (DEBUG_ADDR.empty() || DEBUG_ADDR.find(addr) != DEBUG_ADDR.end())
-#define is_debug_event(ev) (DEBUG_ADDR.empty() || ev->doDebug(DEBUG_ADDR))
 #define Debug(level, fmt, ... ) dbg.debug( level, fmt, ##__VA_ARGS__  )
 #else
-#define is_debug_addr(addr) false
-#define is_debug_event(ev) false
 #define Debug(level, fmt, ... )
 #endif
 /*
@@ -313,6 +309,27 @@ MemController::MemController(ComponentId_t id, Params &params) : Component(id),
         backing_ = new Backend::BackingMalloc(sizeBytes,initBacking);
     }
 
+    /* Backing store images */
+    std::string imageIn = params.find<std::string>("backing_image_in", "");
+    backingImageOut_ = params.find<std::string>("backing_image_out", "");
+    if ((imageIn != "" || backingImageOut_ != "") && !backing_)
+        out.fatal(CALL_INFO, -1, "%s, Error - 'backing_image_in' and 'backing_image_out' require a backing store but 'backing' is 'none'.\n", getName().c_str());
+    if (imageIn != "")
+        backing_->loadImage(imageIn);
+
+    /* Functional warmup */
+    if (params.find<bool>("warmup", false)) {
+        warmup_.start();
+        std::string endTime = params.find<std::string>("warmup_end", "");
+        if (!endTime.empty())
+            registerOneShot(endTime, new OneShot::Handler<MemController>(this, &MemController::endWarmup));
+    }
+
+    /* Flight recorder */
+    flightRecorder_.init(params.find<size_t>("flight_recorder_size", 1024));
+    flightRecorderDir_ = params.find<std::string>("flight_recorder_dir", ".");
+    flightRecorderAtFinish_ = params.find<bool>("flight_recorder_dump_at_finish", false);
+
     /* Custom command handler */
     using std::placeholders::_3;
     customCommandHandler_ = loadUserSubComponent<CustomCmdMemHandler>("customCmdHandler", ComponentInfo::SHARE_NONE,
@@ -334,7 +351,11 @@ void MemController::handleEvent(SST::Event* event) {
         memBackendConvertor_->turnClockOn(cycle);
     }
 
+    if (warmup_.roiStarted())
+        endWarmup();
+
     MemEventBase *meb = static_cast<MemEventBase*>(event);
+    flightRecorder_.record(getCurrentSimCycle(), FlightRecorder::Recv, meb);
 
     if (is_debug_event(meb)) {
         Debug(_L3_, "E: %-20" PRIu64 " %-20" PRIu64 " %-20s Event:New     (%s)\n",
@@ -404,7 +425,7 @@ void MemController::handleEvent(SST::Event* event) {
                         getCurrentSimCycle(), getNextClockCycle(clockTimeBase_) - 1, getName().c_str(), 
                         ev->getVerboseString().c_str());
             }
-            memBackendConvertor_->handleMemEvent( ev );
+            issueMemEvent( ev );
             break;
 
         case Command::FlushLine:
@@ -420,7 +441,7 @@ void MemController::handleEvent(SST::Event* event) {
                                 getCurrentSimCycle(), getNextClockCycle(clockTimeBase_) - 1, getName().c_str(), 
                                 put->getVerboseString().c_str());
                     }
-                    memBackendConvertor_->handleMemEvent( put );
+                    issueMemEvent( put );
                 }
 
                 outstandingEvents_.insert(std::make_pair(ev->getID(), ev));
@@ -430,7 +451,7 @@ void MemController::handleEvent(SST::Event* event) {
                             getCurrentSimCycle(), getNextClockCycle(clockTimeBase_) - 1, getName().c_str(), 
                             ev->getVerboseString().c_str());
                 }
-                memBackendConvertor_->handleMemEvent( ev );
+                issueMemEvent( ev );
 
             }
             break;
@@ -444,6 +465,23 @@ void MemController::handleEvent(SST::Event* event) {
     }
 }
 
+/* During warmup the backend is skipped and the request completes in the same cycle */
+void MemController::issueMemEvent(MemEvent* ev) {
+    if (warmup_.active())
+        handleMemResponse(ev->getID(), 0);
+    else
+        memBackendConvertor_->handleMemEvent(ev);
+}
+
+/* Switch to timing mode. Custom commands always use the backend. */
+void MemController::endWarmup() {
+    if (!warmup_.end())
+        return;
+    out.verbose(CALL_INFO, 2, 0, "%s, Notice: warmup ended at %" PRIu64 "ns\n", getName().c_str(), getCurrentSimTimeNano());
+    if (Warmup::firstToEnd())
+        performGlobalStatisticOutput();
+}
+
 bool MemController::clock(Cycle_t cycle) {
     bool unclockLink = true;
     if (clockLink_) {
@@ -506,8 +544,10 @@ void MemController::handleMemResponse( Event::id_type id, uint32_t flags ) {
     /* Handle custom events */
     if (evb->getCmd() == Command::CustomReq) {
         MemEventBase * resp = customCommandHandler_->finish(evb, flags);
-        if (resp != nullptr)
+        if (resp != nullptr) {
+            flightRecorder_.record(getCurrentSimCycle(), FlightRecorder::Send, resp);
             link_->send(resp);
+        }
         delete evb;
         return;
     }
@@ -546,6 +586,7 @@ void MemController::handleMemResponse( Event::id_type id, uint32_t flags ) {
                 getCurrentSimCycle(), getNextClockCycle(clockTimeBase_) - 1, getName().c_str(), resp->getVerboseString(dlevel).c_str());
     }
 
+    flightRecorder_.record(getCurrentSimCycle(), FlightRecorder::Send, resp);
     link_->send( resp );
     delete ev;
 }
@@ -579,6 +620,12 @@ void MemController::finish(void) {
     cycle--;
     memBackendConvertor_->finish(cycle);
     link_->finish();
+
+    if (backingImageOut_ != "" && !backing_->saveImage(backingImageOut_))
+        out.fatal(CALL_INFO, -1, "%s, Error - unable to write backing store image to '%s'.\n", getName().c_str(), backingImageOut_.c_str());
+
+    if (flightRecorderAtFinish_)
+        dumpFlightRecorder();
 }
 
 void MemController::writeData(MemEvent* event) {
@@ -630,9 +677,7 @@ void MemController::readData(MemEvent* event) {
 void MemController::writeData(Addr addr, std::vector<uint8_t> * data) {
     if (!backing_) return;
 
-    for (size_t i = 0; i < data->size(); i++) {
-        backing_->set(addr + i, data->at(i));
-    }
+    backing_->set(addr, data->size(), *data);
 
     if (is_debug_addr(addr))
         printDataValue(addr, data, true);
@@ -644,8 +689,7 @@ void MemController::readData(Addr addr, size_t bytes, std::vector<uint8_t> &data
 
     if (!backing_) return;
 
-    for (size_t i = 0; i < bytes; i++)
-        data[i] = backing_->get(addr + i);
+    backing_->get(addr, bytes, data);
     
     if (is_debug_addr(addr))
         printDataValue(addr, &data, false);
@@ -746,8 +790,11 @@ void MemController::adjustRegionToMemSize() {
 }
 
 void MemController::printStatus(Output &statusOut) {
+    dumpFlightRecorder();
     statusOut.output("MemHierarchy::MemoryController %s\n", getName().c_str());
 
+    if (warmup_.active())
+        statusOut.output("  In functional warmup\n");
     statusOut.output("  Outstanding events: %zu\n", outstandingEvents_.size());
     for (std::map<SST::Event::id_type, MemEventBase*>::iterator it = outstandingEvents_.begin(); it != outstandingEvents_.end(); it++) {
         statusOut.output("    %s\n", it->second->getVerboseString(dlevel).c_str());
@@ -771,9 +818,19 @@ void MemController::emergencyShutdown() {
             out.output("  Checking for unreceived events on link: \n");
             link_->emergencyShutdownDebug(out);
         }
+    } else {
+        dumpFlightRecorder(); // printStatus() does this otherwise
     }
 }
 
+void MemController::dumpFlightRecorder() {
+    if (!flightRecorder_.enabled())
+        return;
+    std::string file = flightRecorderDir_ + "/" + getName() + ".flight";
+    if (!flightRecorder_.dump(file, getName(), getCurrentSimCycle(), CommandString, (uint32_t)Command::LAST_CMD, StateString, LAST_STATE, EndpointRegistry::getName))
+        out.output("%s, Warning: unable to write flight recorder to '%s'\n", getName().c_str(), file.c_str());
+}
+
 void MemController::printDataValue(Addr addr, std::vector<uint8_t>* data, bool set) {
     if (dlevel < 11) return;
 
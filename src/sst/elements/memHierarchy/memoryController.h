@@ -26,6 +26,8 @@
 #include "sst/elements/memHierarchy/memLinkBase.h"
 #include "sst/elements/memHierarchy/membackend/backing.h"
 #include "sst/elements/memHierarchy/customcmd/customCmdMemory.h"
+#include "sst/elements/memHierarchy/warmup.h"
+#include "sst/elements/memHierarchy/flightRecorder.h"
 
 namespace SST {
 namespace MemHierarchy {
@@ -53,11 +55,18 @@ public:
             {"backing",             "(string) Type of backing store to use. Options: 'none' - no backing store (only use if simulation does not require correct memory values), 'malloc', or 'mmap'", "mmap"},\
             {"backing_size_unit",   "(string) For 'malloc' backing stores, malloc granularity", "1MiB"},\
             {"memory_file",         "(string) Optional backing-store file to pre-load memory, or store resulting state", "N/A"},\
+            {"backing_image_in",    "(string) Optional sparse memory image (written by 'backing_image_out') to restore into the backing store before init. Image pages are read on first touch.", ""},\
+            {"backing_image_out",   "(string) Optional file to write a sparse image of the backing store to at the end of simulation", ""},\
             {"addr_range_start",    "(uint) Lowest address handled by this memory.", "0"},\
             {"addr_range_end",      "(uint) Highest address handled by this memory.", "uint64_t-1"},\
             {"interleave_size",     "(string) Size of interleaved chunks. E.g., to interleave 8B chunks among 3 memories, set size=8B, step=24B", "0B"},\
             {"interleave_step",     "(string) Distance between interleaved chunks. E.g., to interleave 8B chunks among 3 memories, set size=8B, step=24B", "0B"},\
-            {"customCmdMemHandler", "(string) Name of the custom command handler to load", ""}
+            {"customCmdMemHandler", "(string) Name of the custom command handler to load", ""},\
+            {"warmup",              "(bool) Start in functional warmup: requests update the backing store and are answered at once, without the backend, until 'warmup_end' or the region of interest starts. Not supported by CoherentMemController.", "false"},\
+            {"warmup_end",          "(string) Time at which warmup ends, with units (SI ok). Leave empty to end warmup only when the region of interest starts.", ""},\
+            {"flight_recorder_size", "(uint) Number of recent events to keep in the flight recorder (rounded up to a power of 2). 0 to disable.", "1024"},\
+            {"flight_recorder_dir", "(string) Directory to write the flight recorder to as '<dir>/<name>.flight' on a fatal error or the status dump signal (SIGUSR2)", "."},\
+            {"flight_recorder_dump_at_finish", "(bool) Also write the flight recorder at the end of simulation", "false"}
 
     SST_ELI_DOCUMENT_PARAMS( MEMCONTROLLER_ELI_PARAMS )
 
@@ -127,6 +136,7 @@ protected:
 
     MemBackendConvertor*    memBackendConvertor_;
     Backend::Backing*       backing_;
+    std::string             backingImageOut_;   // If set, snapshot the backing store here in finish()
 
     MemLinkBase* link_;         // Link to the rest of memHierarchy
     bool clockLink_;            // Flag - should we call clock() on this link or not
@@ -154,6 +164,17 @@ protected:
 
     CustomCmdMemHandler * customCommandHandler_;
 
+    /* Functional warmup */
+    Warmup warmup_;
+    void endWarmup();
+    void issueMemEvent( MemEvent* ev );  // To the backend, or answered at once during warmup
+
+    /* Flight recorder */
+    FlightRecorder flightRecorder_;
+    std::string flightRecorderDir_;
+    bool flightRecorderAtFinish_;
+    void dumpFlightRecorder();
+
     /* Debug -triggered by output.fatal() and/or SIGUSR2 */
     virtual void printStatus(Output &out);
     virtual void emergencyShutdown();
@@ -28,6 +28,7 @@
 
 #include "sst/elements/memHierarchy/memEvent.h"
 #include "sst/elements/memHierarchy/util.h"
+#include "sst/elements/memHierarchy/addrHashTable.h"
 
 namespace SST { namespace MemHierarchy {
 
@@ -165,7 +166,7 @@ class MSHREntry {
 
 struct MSHRRegister {
     MSHRRegister() : acksNeeded(0), dataDirty(false), pendingRetries(0) { }
-    list<MSHREntry> entries;
+    vector<MSHREntry> entries;  // Front of the queue is entries[0]; short, so a vector beats a list
     uint32_t acksNeeded;
     vector<uint8_t> dataBuffer;
     bool dataDirty;
@@ -174,9 +175,20 @@ struct MSHRRegister {
     uint32_t getPendingRetries() { return pendingRetries; }
     void addPendingRetry() { pendingRetries++; }
     void removePendingRetry() { pendingRetries--; }
+
+    /* Called when the register is returned to the pool; keeps vector capacity for reuse */
+    void reset() {
+        entries.clear();
+        acksNeeded = 0;
+        dataBuffer.clear();
+        dataDirty = false;
+        pendingRetries = 0;
+    }
 };
 
-typedef map<Addr, MSHRRegister> MSHRBlock;
+/* Registers are kept in an open-addressed table sized from the MSHR size. The MSHR
+ * enforces its size limit itself; the table only grows for entries outside that limit. */
+typedef AddrHashTable<MSHRRegister> MSHRBlock;
 
 /**
  *  Implements an MSHR with entries of type mshrEntry
@@ -188,6 +200,7 @@ public:
     MSHR(ComponentId_t cid, Output* dbg, int maxSize, string cacheName, std::set<Addr> debugAddr);
 
     int getMaxSize();
+    void setMaxSize(int maxSize);   // Negative is unlimited
     int getSize();
     unsigned int getSize(Addr addr);
     bool exists(Addr addr);
@@ -244,7 +257,7 @@ public:
     bool decrementAcksNeeded(Addr addr);
     uint32_t getAcksNeeded(Addr addr);
 
-    void setData(Addr addr, vector<uint8_t>& data, bool dirty = false);
+    void setData(Addr addr, const vector<uint8_t>& data, bool dirty = false);
     void clearData(Addr addr);
     vector<uint8_t>& getData(Addr addr);
     bool hasData(Addr addr);
@@ -257,6 +270,8 @@ private:
 
     void printDebug(uint32_t level, std::string action, Addr addr, std::string reason);
 
+    void eraseEntry(MSHRRegister* reg, Addr addr, size_t index);
+
     MSHRBlock mshr_;
     Output* d_;
     Output* d2_;
@@ -0,0 +1,111 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_MEMH_REORDER_RING
+#define _H_SST_MEMH_REORDER_RING
+
+#include <stddef.h>
+#include <stdint.h>
+#include <utility>
+#include <vector>
+
+namespace SST {
+namespace MemHierarchy {
+
+/*
+ * Events from one sender that arrived ahead of the next expected tag
+ *
+ * Tags are per (sender, receiver) sequence numbers and wrap. An event
+ * 'distance' tags ahead of the expected one waits in slot
+ * (tag & (size - 1)) of a power-of-two ring, which doubles when an event
+ * arrives further ahead than the ring is large. Used by MemNICFour.
+ */
+template <typename T>
+class ReorderRing {
+  public:
+    ReorderRing(unsigned int first = 0) : next_(first), buffered_(0) { }
+
+    /* Next tag expected from the sender */
+    unsigned int expected() const { return next_; }
+
+    /* Whether 'tag' is the next expected tag. If so, the caller delivers the event and calls advance(). */
+    bool inOrder(unsigned int tag) const { return tag == next_; }
+    void advance() { next_++; }
+
+    /*
+     * Buffer an event that arrived ahead of the expected one. The ring starts at
+     * 'initialSize' entries (a power of two) and grows to fit. Returns how far ahead
+     * the event is; 'grew' is set if an existing ring had to grow.
+     */
+    unsigned int insert(unsigned int tag, T* item, uint64_t time, size_t initialSize, bool& grew) {
+        unsigned int distance = tag - next_; // Tags wrap, so this is modular
+        grew = false;
+        if (distance >= ring_.size()) {
+            grew = !ring_.empty();
+            grow(distance, initialSize);
+        }
+        ring_[tag & (ring_.size() - 1)] = std::make_pair(item, time);
+        buffered_++;
+        return distance;
+    }
+
+    /* Remove and return the event with the expected tag if it has arrived, else nullptr. Advances on success. */
+    T* pop(uint64_t& time) {
+        if (buffered_ == 0)
+            return nullptr;
+        std::pair<T*, uint64_t>& slot = ring_[next_ & (ring_.size() - 1)];
+        if (slot.first == nullptr)
+            return nullptr;
+        T* item = slot.first;
+        time = slot.second;
+        slot.first = nullptr;
+        buffered_--;
+        next_++;
+        return item;
+    }
+
+    /* Events waiting */
+    unsigned int buffered() const { return buffered_; }
+
+    /* Ring entries, 0 until the first out-of-order event */
+    size_t size() const { return ring_.size(); }
+
+  private:
+    /* Make room for an event 'distance' tags ahead of the next expected one */
+    void grow(unsigned int distance, size_t initialSize) {
+        size_t size = ring_.empty() ? initialSize : ring_.size();
+        while (size <= distance)
+            size <<= 1;
+
+        /* Buffered events are all within ring_.size() of next_, which identifies their tags */
+        std::vector<std::pair<T*, uint64_t> > ring(size, std::make_pair((T*)nullptr, (uint64_t)0));
+        for (size_t i = 0; i < ring_.size(); i++) {
+            if (ring_[i].first) {
+                unsigned int tag = next_ + ((i - next_) & (ring_.size() - 1));
+                ring[tag & (size - 1)] = ring_[i];
+            }
+        }
+        ring_.swap(ring);
+    }
+
+    unsigned int next_;     // Next tag expected
+    unsigned int buffered_; // Events waiting in ring_
+    std::vector<std::pair<T*, uint64_t> > ring_;
+};
+
+}}
+
+#endif
@@ -33,18 +33,34 @@ namespace MemHierarchy {
  */
 class ReplacementInfo {
     public:
-        ReplacementInfo(unsigned int i, State s) : index(i), state(s) { }
+        ReplacementInfo(unsigned int i, State s) : index(i), state(s), invalidWays(nullptr), wayBit(0) { }
         virtual ~ReplacementInfo() { }
 
         unsigned int getIndex() { return index; }
         void setIndex(unsigned int i) { index = i; }
 
         State getState() { return state; }
-        void setState(State s) { state = s; }
+        void setState(State s) {
+            state = s;
+            if (invalidWays) {
+                if (s == I) *invalidWays |= wayBit;
+                else *invalidWays &= ~wayBit;
+            }
+        }
+
+        /* Keep bit 'bit' of the set's invalid-way mask equal to (state == I). Set up by CacheArray. */
+        void trackInvalid(uint64_t * mask, uint64_t bit) {
+            invalidWays = mask;
+            wayBit = bit;
+            setState(state);
+        }
+        const uint64_t * getInvalidWays() { return invalidWays; }
 
     protected:
         unsigned int index;
         State state;
+        uint64_t * invalidWays;
+        uint64_t wayBit;
 };
 
 class CoherenceReplacementInfo : public ReplacementInfo {
@@ -77,9 +93,57 @@ class ReplacementPolicy : public SubComponent{
         virtual void update(uint64_t id, ReplacementInfo * rInfo) = 0;
         virtual void replaced(uint64_t id) = 0;
 
+        // A new block with address 'addr' was placed in line 'id'. Policies that treat fills
+        // differently from hits (e.g., RRIP insertion) override this; default treats it as an access
+        virtual void insert(uint64_t id, Addr addr, ReplacementInfo * rInfo) { update(id, rInfo); }
+
         // Get replacement candidates
         virtual uint64_t getBestCandidate() = 0;
         virtual uint64_t findBestCandidate(std::vector<ReplacementInfo*> &rInfo) = 0;
+
+        // Checkpoint support. Policies append their state to 'state' and restore it from the same layout.
+        // loadState() returns false if 'state' does not fit this policy instance (e.g., geometry changed),
+        // in which case the caller replays accesses instead. Stateless policies keep the defaults.
+        virtual void saveState(std::vector<uint64_t> &state) { }
+        virtual bool loadState(const std::vector<uint64_t> &state) { return state.empty(); }
+
+    protected:
+        /* Find an invalid way in the set, which is always replaced first. Uses the set's invalid-way
+         * mask when the cache array keeps one (associativity <= 64), otherwise scans the set. */
+        static bool findInvalid(std::vector<ReplacementInfo*> &rInfo, uint64_t &index) {
+            const uint64_t * invalid = rInfo[0]->getInvalidWays();
+            if (invalid) {
+                if (*invalid == 0)
+                    return false;
+                index = rInfo[__builtin_ctzll(*invalid)]->getIndex();
+                return true;
+            }
+            for (size_t i = 0; i < rInfo.size(); i++) {
+                if (rInfo[i]->getState() == I) {
+                    index = rInfo[i]->getIndex();
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        template <typename T>
+        static void saveVector(std::vector<uint64_t> &state, const std::vector<T> &vec) {
+            state.push_back(vec.size());
+            for (size_t i = 0; i < vec.size(); i++)
+                state.push_back((uint64_t)vec[i]);
+        }
+
+        /* Read a vector written by saveVector into 'vec', which must already be the saved size */
+        template <typename T>
+        static bool loadVector(const std::vector<uint64_t> &state, size_t &pos, std::vector<T> &vec) {
+            if (pos >= state.size() || state[pos] != vec.size() || pos + 1 + vec.size() > state.size())
+                return false;
+            pos++;
+            for (size_t i = 0; i < vec.size(); i++)
+                vec[i] = (T)state[pos++];
+            return true;
+        }
 };
 
 /* ------------------------------------------------------------------------------------------
@@ -133,6 +197,19 @@ public:
         return bestCandidate;
     }
 
+    void saveState(std::vector<uint64_t> &state) {
+        state.push_back(timestamp);
+        saveVector(state, array);
+    }
+
+    bool loadState(const std::vector<uint64_t> &state) {
+        size_t pos = 1;
+        if (state.empty() || !loadVector(state, pos, array) || pos != state.size())
+            return false;
+        timestamp = state[0];
+        return true;
+    }
+
     uint64_t getBestCandidate() { return bestCandidate; }
 
 private:
@@ -205,6 +282,19 @@ public:
         return bestCandidate;
     }
 
+    void saveState(std::vector<uint64_t> &state) {
+        state.push_back(timestamp);
+        saveVector(state, array);
+    }
+
+    bool loadState(const std::vector<uint64_t> &state) {
+        size_t pos = 1;
+        if (state.empty() || !loadVector(state, pos, array) || pos != state.size())
+            return false;
+        timestamp = state[0];
+        return true;
+    }
+
     uint64_t getBestCandidate() { return bestCandidate; }
 
 private:
@@ -286,6 +376,26 @@ public:
         return bestCandidate;
     }
 
+    void saveState(std::vector<uint64_t> &state) {
+        state.push_back(timestamp);
+        state.push_back(array.size());
+        for (size_t i = 0; i < array.size(); i++) {
+            state.push_back(array[i].ts);
+            state.push_back(array[i].acc);
+        }
+    }
+
+    bool loadState(const std::vector<uint64_t> &state) {
+        if (state.size() != 2 + 2 * array.size() || state[1] != array.size())
+            return false;
+        timestamp = state[0];
+        for (size_t i = 0; i < array.size(); i++) {
+            array[i].ts = state[2 + 2 * i];
+            array[i].acc = state[3 + 2 * i];
+        }
+        return true;
+    }
+
     uint64_t getBestCandidate() { return bestCandidate; }
 
     //void replaced(uint64_t id) { array[id].acc = 0; }
@@ -369,6 +479,26 @@ public:
         return bestCandidate;
     }
 
+    void saveState(std::vector<uint64_t> &state) {
+        state.push_back(timestamp);
+        state.push_back(array.size());
+        for (size_t i = 0; i < array.size(); i++) {
+            state.push_back(array[i].ts);
+            state.push_back(array[i].acc);
+        }
+    }
+
+    bool loadState(const std::vector<uint64_t> &state) {
+        if (state.size() != 2 + 2 * array.size() || state[1] != array.size())
+            return false;
+        timestamp = state[0];
+        for (size_t i = 0; i < array.size(); i++) {
+            array[i].ts = state[2 + 2 * i];
+            array[i].acc = state[3 + 2 * i];
+        }
+        return true;
+    }
+
     uint64_t getBestCandidate() { return bestCandidate; }
 
     //void replaced(uint64_t id) { array[id].acc = 0; }
@@ -491,6 +621,19 @@ public:
         return bestCandidate;
     }
 
+    void saveState(std::vector<uint64_t> &state) {
+        state.push_back(timestamp);
+        saveVector(state, array);
+    }
+
+    bool loadState(const std::vector<uint64_t> &state) {
+        size_t pos = 1;
+        if (state.empty() || !loadVector(state, pos, array) || pos != state.size())
+            return false;
+        timestamp = state[0];
+        return true;
+    }
+
     uint64_t getBestCandidate() { return bestCandidate;}
 
 };
@@ -579,6 +722,19 @@ public:
         return bestCandidate;
     }
 
+    void saveState(std::vector<uint64_t> &state) {
+        state.push_back(timestamp);
+        saveVector(state, array);
+    }
+
+    bool loadState(const std::vector<uint64_t> &state) {
+        size_t pos = 1;
+        if (state.empty() || !loadVector(state, pos, array) || pos != state.size())
+            return false;
+        timestamp = state[0];
+        return true;
+    }
+
     uint64_t getBestCandidate() { return bestCandidate; }
 
 };
@@ -701,10 +857,364 @@ public:
         return bestCandidate;
     }
 
+    void saveState(std::vector<uint64_t> &state) { saveVector(state, array); }
+
+    bool loadState(const std::vector<uint64_t> &state) {
+        size_t pos = 0;
+        return loadVector(state, pos, array) && pos == state.size();
+    }
+
     uint64_t getBestCandidate() { return bestCandidate; }
 };
 
 
+/* ------------------------------------------------------------------------------------------
+ *  Tree pseudo-LRU
+ *  - One bit per internal node of a binary tree over the ways of each set; each bit points
+ *    toward the less-recently-used half. Update and victim selection walk log2(ways) bits.
+ *  - Requires power-of-two associativity of at most 64. Assumes indices are contiguous for the set.
+ * ------------------------------------------------------------------------------------------*/
+class TreePLRU : public ReplacementPolicy {
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT(TreePLRU, "memHierarchy", "replacement.plru", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "tree pseudo-LRU replacement policy, requires power-of-two associativity", SST::MemHierarchy::ReplacementPolicy);
+
+    TreePLRU(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : ReplacementPolicy(id, params, lines, associativity), bestCandidate(0) {
+        ways = associativity;
+        levels = 0;
+        while ((1ULL << levels) < ways) levels++;
+        if ((1ULL << levels) != ways || ways > 64) {
+            Output out("", 1, 0, Output::STDOUT);
+            out.fatal(CALL_INFO, -1, "%s, Error: replacement.plru requires a power-of-two associativity of at most 64. Associativity is %" PRIu64 ".\n",
+                    getName().c_str(), ways);
+        }
+        tree.resize(lines / associativity, 0);
+    }
+
+    virtual ~TreePLRU() { }
+
+    bool checkCompatibility(ReplacementInfo * rInfo) { return true; } // No cast
+
+    /* Point every node on the path to this way away from it */
+    void update(uint64_t id, ReplacementInfo * rInfo) {
+        uint64_t &bits = tree[id / ways];
+        uint64_t way = id % ways;
+        uint64_t node = 0;
+        for (int l = levels - 1; l >= 0; l--) {
+            uint64_t dir = (way >> l) & 1;
+            if (dir) bits &= ~(1ULL << node);
+            else     bits |= (1ULL << node);
+            node = 2 * node + 1 + dir;
+        }
+    }
+
+    void replaced(uint64_t id) { }
+
+    uint64_t findBestCandidate(std::vector<ReplacementInfo*> &rInfo) {
+        if (findInvalid(rInfo, bestCandidate))
+            return bestCandidate;
+        uint64_t setBegin = rInfo[0]->getIndex();
+        uint64_t bits = tree[setBegin / ways];
+        uint64_t node = 0;
+        uint64_t way = 0;
+        for (int l = 0; l < levels; l++) {
+            uint64_t dir = (bits >> node) & 1;
+            way = (way << 1) | dir;
+            node = 2 * node + 1 + dir;
+        }
+        bestCandidate = setBegin + way;
+        return bestCandidate;
+    }
+
+    void saveState(std::vector<uint64_t> &state) { saveVector(state, tree); }
+
+    bool loadState(const std::vector<uint64_t> &state) {
+        size_t pos = 0;
+        return loadVector(state, pos, tree) && pos == state.size();
+    }
+
+    uint64_t getBestCandidate() { return bestCandidate; }
+
+private:
+    uint64_t bestCandidate;
+    uint64_t ways;
+    int levels;
+    std::vector<uint64_t> tree; // One word of tree bits per set
+};
+
+/* ------------------------------------------------------------------------------------------
+ *  Re-reference interval prediction (RRIP) family
+ *  Jaleel et al., "High Performance Cache Replacement Using Re-Reference Interval Prediction", ISCA 2010
+ *  Wu et al., "SHiP: Signature-based Hit Predictor for High Performance Caching", MICRO 2011
+ *
+ *  Each line holds an M-bit re-reference prediction value (RRPV) in a flat per-line array.
+ *  Hits promote to 0; the victim is the first way predicted 'distant' (RRPV = 2^M-1), after
+ *  aging the whole set by the amount needed to produce one. Derived policies differ only in
+ *  the RRPV assigned on insertion.
+ *  Assumes indices are contiguous for the set.
+ * ------------------------------------------------------------------------------------------*/
+#define RRIP_ELI_PARAMS { "rrpv_bits",  "(uint) Number of bits in each line's re-reference prediction value", "2" }
+
+class RRIPBase : public ReplacementPolicy {
+public:
+    RRIPBase(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : ReplacementPolicy(id, params, lines, associativity), bestCandidate(0) {
+        ways = associativity;
+        uint32_t bits = params.find<uint32_t>("rrpv_bits", 2);
+        if (bits == 0 || bits > 7) {
+            Output out("", 1, 0, Output::STDOUT);
+            out.fatal(CALL_INFO, -1, "%s, Invalid param: rrpv_bits - must be between 1 and 7. You specified %" PRIu32 ".\n", getName().c_str(), bits);
+        }
+        maxRRPV = (1 << bits) - 1;
+        rrpv.resize(lines, maxRRPV);
+    }
+
+    virtual ~RRIPBase() { }
+
+    bool checkCompatibility(ReplacementInfo * rInfo) { return true; } // No cast
+
+    /* Hit priority: a re-referenced line is predicted to be re-referenced soon */
+    void update(uint64_t id, ReplacementInfo * rInfo) { rrpv[id] = 0; }
+
+    void replaced(uint64_t id) { rrpv[id] = maxRRPV; }
+
+    uint64_t findBestCandidate(std::vector<ReplacementInfo*> &rInfo) {
+        if (findInvalid(rInfo, bestCandidate))
+            return bestCandidate;
+        uint64_t setBegin = rInfo[0]->getIndex();
+        uint8_t * set = &rrpv[setBegin];
+        uint8_t oldest = 0;
+        uint64_t way = 0;
+        for (uint64_t i = 0; i < ways; i++) {
+            if (set[i] > oldest) {
+                oldest = set[i];
+                way = i;
+            }
+        }
+        // Age the set in one step instead of repeatedly incrementing until a line reaches maxRRPV
+        if (oldest < maxRRPV) {
+            uint8_t delta = maxRRPV - oldest;
+            for (uint64_t i = 0; i < ways; i++)
+                set[i] += delta;
+        }
+        bestCandidate = setBegin + way;
+        return bestCandidate;
+    }
+
+    void saveState(std::vector<uint64_t> &state) { saveVector(state, rrpv); }
+
+    bool loadState(const std::vector<uint64_t> &state) {
+        size_t pos = 0;
+        return loadVector(state, pos, rrpv) && pos == state.size();
+    }
+
+    uint64_t getBestCandidate() { return bestCandidate; }
+
+protected:
+    uint64_t bestCandidate;
+    uint64_t ways;
+    uint8_t maxRRPV;
+    std::vector<uint8_t> rrpv;
+};
+
+/* Static RRIP: insert with a 'long' re-reference prediction */
+class SRRIP : public RRIPBase {
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT(SRRIP, "memHierarchy", "replacement.srrip", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "static re-reference interval prediction (SRRIP-HP) replacement policy", SST::MemHierarchy::ReplacementPolicy);
+
+    SST_ELI_DOCUMENT_PARAMS( RRIP_ELI_PARAMS )
+
+    SRRIP(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : RRIPBase(id, params, lines, associativity) { }
+    virtual ~SRRIP() { }
+
+    void insert(uint64_t id, Addr addr, ReplacementInfo * rInfo) { rrpv[id] = maxRRPV - 1; }
+};
+
+#define BRRIP_ELI_PARAMS RRIP_ELI_PARAMS, \
+    { "brrip_throttle", "(uint) BRRIP inserts with a 'long' prediction once every this many fills, and 'distant' otherwise", "32" }
+
+/* Bimodal RRIP: mostly insert 'distant' so that scanning/thrashing blocks leave quickly */
+class BRRIP : public RRIPBase {
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT(BRRIP, "memHierarchy", "replacement.brrip", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "bimodal re-reference interval prediction (BRRIP) replacement policy", SST::MemHierarchy::ReplacementPolicy);
+
+    SST_ELI_DOCUMENT_PARAMS( BRRIP_ELI_PARAMS )
+
+    BRRIP(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : RRIPBase(id, params, lines, associativity), fills(0) {
+        throttle = params.find<uint32_t>("brrip_throttle", 32);
+        if (throttle == 0) throttle = 1;
+    }
+    virtual ~BRRIP() { }
+
+    void insert(uint64_t id, Addr addr, ReplacementInfo * rInfo) {
+        rrpv[id] = (++fills % throttle == 0) ? maxRRPV - 1 : maxRRPV;
+    }
+
+private:
+    uint32_t throttle;
+    uint32_t fills;
+};
+
+/* Dynamic RRIP: set dueling between SRRIP and BRRIP leader sets picks the insertion policy for the rest */
+class DRRIP : public RRIPBase {
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT(DRRIP, "memHierarchy", "replacement.drrip", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "dynamic re-reference interval prediction (DRRIP) replacement policy, set-dueling between SRRIP and BRRIP", SST::MemHierarchy::ReplacementPolicy);
+
+    SST_ELI_DOCUMENT_PARAMS( BRRIP_ELI_PARAMS,
+            { "psel_bits",      "(uint) Width of the policy selection counter", "10" },
+            { "leader_sets",    "(uint) Number of leader sets dedicated to each of SRRIP and BRRIP", "32" } )
+
+    DRRIP(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : RRIPBase(id, params, lines, associativity), fills(0) {
+        throttle = params.find<uint32_t>("brrip_throttle", 32);
+        if (throttle == 0) throttle = 1;
+        uint32_t pselBits = params.find<uint32_t>("psel_bits", 10);
+        pselMax = (1 << pselBits) - 1;
+        psel = pselMax / 2;
+        uint64_t sets = lines / associativity;
+        uint64_t leaders = params.find<uint64_t>("leader_sets", 32);
+        // Spread leaders evenly: one SRRIP and one BRRIP leader per constituency
+        constituency = (leaders == 0 || sets < 2 * leaders) ? 2 : sets / leaders;
+    }
+    virtual ~DRRIP() { }
+
+    void insert(uint64_t id, Addr addr, ReplacementInfo * rInfo) {
+        uint64_t offset = (id / ways) % constituency;
+        bool brrip;
+        if (offset == 0) {          // SRRIP leader: a fill is a miss under SRRIP
+            if (psel < pselMax) psel++;
+            brrip = false;
+        } else if (offset == 1) {   // BRRIP leader
+            if (psel > 0) psel--;
+            brrip = true;
+        } else {                    // Follower: use whichever leader is missing less
+            brrip = psel > pselMax / 2;
+        }
+        if (brrip)
+            rrpv[id] = (++fills % throttle == 0) ? maxRRPV - 1 : maxRRPV;
+        else
+            rrpv[id] = maxRRPV - 1;
+    }
+
+    void saveState(std::vector<uint64_t> &state) {
+        RRIPBase::saveState(state);
+        state.push_back(psel);
+        state.push_back(fills);
+    }
+
+    bool loadState(const std::vector<uint64_t> &state) {
+        if (state.size() < 2)
+            return false;
+        std::vector<uint64_t> base(state.begin(), state.end() - 2);
+        if (!RRIPBase::loadState(base))
+            return false;
+        psel = std::min((uint32_t)state[state.size() - 2], pselMax);
+        fills = state.back();
+        return true;
+    }
+
+private:
+    uint32_t throttle;
+    uint32_t fills;
+    uint32_t psel;
+    uint32_t pselMax;
+    uint64_t constituency;
+};
+
+/* SHiP-Mem: predict re-reference on insertion from a per-memory-region hit counter.
+ * memHierarchy has no PC at the cache array, so the signature is the address region.
+ *
+ * Only evictions train the counters. replaced() also runs when a line that a coherence
+ * invalidation already emptied is refilled or deallocated, so a line counts as evicted only
+ * if this policy chose it as a victim while it was valid. */
+class SHiP : public RRIPBase {
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT(SHiP, "memHierarchy", "replacement.ship", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "signature-based hit predictor (SHiP-Mem) on top of SRRIP, signatures are memory regions", SST::MemHierarchy::ReplacementPolicy);
+
+    SST_ELI_DOCUMENT_PARAMS( RRIP_ELI_PARAMS,
+            { "region_bits",    "(uint) log2 of the memory region size that forms a signature", "14" },
+            { "shct_entries",   "(uint) Number of signature history counters, rounded down to a power of two", "16384" },
+            { "shct_bits",      "(uint) Width of each signature history counter", "3" } )
+
+    SHiP(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : RRIPBase(id, params, lines, associativity) {
+        regionShift = params.find<uint32_t>("region_bits", 14);
+        uint64_t entries = params.find<uint64_t>("shct_entries", 16384);
+        uint64_t size = 1;
+        while (size * 2 <= entries) size *= 2;
+        shctMask = size - 1;
+        uint32_t bits = params.find<uint32_t>("shct_bits", 3);
+        shctMax = (1 << bits) - 1;
+        shct.resize(size, 1);
+        signature.resize(lines, 0);
+        reused.resize(lines, 0);
+        valid.resize(lines, 0);
+        victim.resize(lines, 0);
+    }
+    virtual ~SHiP() { }
+
+    void update(uint64_t id, ReplacementInfo * rInfo) {
+        rrpv[id] = 0;
+        victim[id] = 0;
+        if (valid[id] && !reused[id]) {
+            reused[id] = 1;
+            if (shct[signature[id]] < shctMax) shct[signature[id]]++;
+        }
+    }
+
+    uint64_t findBestCandidate(std::vector<ReplacementInfo*> &rInfo) {
+        RRIPBase::findBestCandidate(rInfo);
+        victim[bestCandidate] = rInfo[bestCandidate - rInfo[0]->getIndex()]->getState() != I;
+        return bestCandidate;
+    }
+
+    void replaced(uint64_t id) {
+        if (valid[id] && victim[id] && !reused[id] && shct[signature[id]] > 0)
+            shct[signature[id]]--;  // Evicted without reuse
+        valid[id] = 0;
+        victim[id] = 0;
+        rrpv[id] = maxRRPV;
+    }
+
+    void insert(uint64_t id, Addr addr, ReplacementInfo * rInfo) {
+        uint64_t region = addr >> regionShift;
+        signature[id] = (uint32_t)((region ^ (region >> 17) ^ (region >> 31)) & shctMask);
+        reused[id] = 0;
+        valid[id] = 1;
+        victim[id] = 0;
+        rrpv[id] = (shct[signature[id]] == 0) ? maxRRPV : maxRRPV - 1;
+    }
+
+    void saveState(std::vector<uint64_t> &state) {
+        RRIPBase::saveState(state);
+        saveVector(state, shct);
+        saveVector(state, signature);
+        saveVector(state, reused);
+        saveVector(state, valid);
+    }
+
+    bool loadState(const std::vector<uint64_t> &state) {
+        size_t pos = 0;
+        if (!loadVector(state, pos, rrpv) || !loadVector(state, pos, shct) || !loadVector(state, pos, signature) ||
+                !loadVector(state, pos, reused) || !loadVector(state, pos, valid) || pos != state.size())
+            return false;
+        for (size_t i = 0; i < signature.size(); i++)
+            signature[i] &= shctMask;
+        return true;
+    }
+
+private:
+    uint32_t regionShift;
+    uint64_t shctMask;
+    uint8_t shctMax;
+    std::vector<uint8_t> shct;
+    std::vector<uint32_t> signature;
+    std::vector<uint8_t> reused;
+    std::vector<uint8_t> valid;
+    std::vector<uint8_t> victim;    // Chosen as a victim while valid; cleared by a hit or refill
+};
+
 }}
 
 
@@ -16,6 +16,7 @@
 
 #include <sst_config.h>
 #include <sst/core/params.h>
+#include <algorithm>
 
 #include "scratchpad.h"
 #include "membackend/scratchBackendConvertor.h"
@@ -28,15 +29,6 @@ using namespace std;
 using namespace SST;
 using namespace SST::MemHierarchy;
 
-/* Debug macros */
-#ifdef __SST_DEBUG_OUTPUT__ /* From sst-core, enable with --enable-debug */
-#define is_debug_addr(addr) (DEBUG_ADDR.empty() || DEBUG_ADDR.find(addr) != DEBUG_ADDR.end())
-#define is_debug_event(ev) (DEBUG_ADDR.empty() || ev->doDebug(DEBUG_ADDR))
-#else
-#define is_debug_addr(addr) false
-#define is_debug_event(ev) false
-#endif
-
 /*
  *
  *  ScratchPad Controller
@@ -101,6 +93,15 @@ Scratchpad::Scratchpad(ComponentId_t id, Params &params) : Component(id) {
     // Throughput limits
     responsesPerCycle_ = params.find<uint32_t>("response_per_cycle",0);
 
+    // Streamed moves
+    moveStreamLines_ = params.find<uint32_t>("move_stream_lines", 0);
+    moveWindow_ = params.find<uint32_t>("move_window", 8);
+
+    // Outstanding event & MSHR tables
+    uint64_t mshrEntries = params.find<uint64_t>("mshr_entries", 256);
+    outstandingEvents_ = AddrHashTable<OutstandingEvent, SST::Event::id_type>(mshrEntries);
+    mshr_ = AddrHashTable<MSHRQueue>(mshrEntries);
+
     // Remote address computation
     remoteAddrOffset_ = params.find<uint64_t>("memory_addr_offset", scratchSize_);
 
@@ -416,20 +417,19 @@ void Scratchpad::processIncomingRemoteEvent(SST::Event * event) {
                 getCurrentSimCycle(), timestamp_, getName().c_str(), ev->getVerboseString(dlevel).c_str());
 
     // Determine what kind of event spawned this and pass off to handler
-    std::map<SST::Event::id_type,SST::Event::id_type>::iterator it = responseIDMap_.find(ev->getResponseToID());
+    OutstandingEvent * forward = getOutstanding(ev->getResponseToID());
 
-    if (it == responseIDMap_.end()) {
-        dbg.fatal(CALL_INFO, -1, "(%s) Received data response from remote but no matching request in responseIDMap_, id is (%" PRIu64 ", %" PRIu32 "), timestamp is %" PRIu64 "\n",
+    if (forward == nullptr) {
+        dbg.fatal(CALL_INFO, -1, "(%s) Received data response from remote but no matching outstanding request, id is (%" PRIu64 ", %" PRIu32 "), timestamp is %" PRIu64 "\n",
                 getName().c_str(), ev->getResponseToID().first, ev->getResponseToID().second, timestamp_);
     }
 
-    SST::Event::id_type requestID = it->second;
-    responseIDMap_.erase(it);
+    OutstandingEvent * request = forward->owner;
+    Addr offset = forward->addr;
+    eraseOutstanding(ev->getResponseToID());
 
-    MemEventBase * requestBase = outstandingEventList_.find(requestID)->second.request;
-
-    if (requestBase->getCmd() == Command::Get) handleRemoteGetResponse(ev, requestID);
-    else handleRemoteReadResponse(ev, requestID);
+    if (request->request->getCmd() == Command::Get) handleRemoteGetResponse(ev, request, offset);
+    else handleRemoteReadResponse(ev, request);
 }
 
 
@@ -537,21 +537,20 @@ void Scratchpad::handleScratchRead(MemEvent * ev) {
     MemEvent * read = new MemEvent(getName(), ev->getAddr(), ev->getBaseAddr(), Command::GetS, ev->getSize());
     read->copyMetadata(ev);
 
-    responseIDMap_.insert(std::make_pair(read->getID(),ev->getID()));
-    responseIDAddrMap_.insert(std::make_pair(read->getID(),ev->getBaseAddr()));
-    outstandingEventList_.insert(std::make_pair(ev->getID(),OutstandingEvent(ev,response)));
+    addForward(read, addOutstanding(ev, response), ev->getBaseAddr());
 
-    if (mshr_.find(ev->getBaseAddr()) == mshr_.end()) {
-        std::vector<uint8_t> data = doScratchRead(read);
-        response->setPayload(data);
-        mshr_.insert(std::make_pair(ev->getBaseAddr(), std::list<MSHREntry>(1,MSHREntry(ev->getID(), Command::GetS, true, false))));
+    MSHRQueue * queue = mshr_.find(ev->getBaseAddr());
+    if (queue == nullptr) {
+        response->setPayload(doScratchRead(read));
+        queue = &(mshr_.insert(ev->getBaseAddr()));
+        queue->entries.push_back(MSHREntry(ev->getID(), Command::GetS, true, false));
         if (caching_ && !ev->queryFlag(MemEvent::F_NONCACHEABLE)) {
             cacheStatus_.at(ev->getBaseAddr()/scratchLineSize_) = true;
         }
         if (is_debug_addr(addr))
             eventDI.action = "ScrRead";
     } else {
-        mshr_.find(ev->getBaseAddr())->second.push_back(MSHREntry(ev->getID(), Command::GetS, read));
+        queue->entries.push_back(MSHREntry(ev->getID(), Command::GetS, read));
         if (is_debug_addr(addr)) {
             eventDI.action = "stall";
             eventDI.reason = "MSHR conflict";
@@ -560,7 +559,7 @@ void Scratchpad::handleScratchRead(MemEvent * ev) {
 
     if (is_debug_event(ev)) {
         dbg.debug(_L10_, "M: %-20" PRIu64 " %-20" PRIu64 " %-20s MSHR:InsEv    0x%-16" PRIx64 " %s\n",
-                getCurrentSimCycle(), timestamp_, getName().c_str(), ev->getBaseAddr(), mshr_.find(ev->getBaseAddr())->second.back().getString().c_str());
+                getCurrentSimCycle(), timestamp_, getName().c_str(), ev->getBaseAddr(), queue->entries.back().getString().c_str());
     }
 }
 
@@ -584,16 +583,17 @@ void Scratchpad::handleScratchWrite(MemEvent * ev) {
     if (is_debug_addr(addr))
         eventDI.prefill(ev->getID(), ev->getCmd(), addr);
 
-    bool doWrite = false; // Decide whether to handle this write immediately EVEN if a conflict
-    bool inserted = false;
+    MSHRQueue * queue = mshr_.find(ev->getBaseAddr());
+
     /* Check for writeback/invalidation races */
-    if (!directory_ && ev->isWriteback() && mshr_.find(ev->getBaseAddr()) != mshr_.end()) {
-        MSHREntry * entry = &(mshr_.find(ev->getBaseAddr())->second.front());
-        if (outstandingEventList_.find(entry->id)->second.request->getCmd() == Command::Get) {
+    if (!directory_ && ev->isWriteback() && queue != nullptr) {
+        MSHREntry * entry = &(queue->entries.front());
+        Command requestCmd = getOutstanding(entry->id)->request->getCmd();
+        if (requestCmd == Command::Get) {
             handleAckInv(ev);
             return;
             // TODO handle corner cases where Get only writes partial line
-        } else if (outstandingEventList_.find(entry->id)->second.request->getCmd() == Command::Put) {
+        } else if (requestCmd == Command::Put) {
             if (ev->getPayload().empty()) {
                 handleAckInv(ev);
             } else {
@@ -601,10 +601,10 @@ void Scratchpad::handleScratchWrite(MemEvent * ev) {
             }
             return;
         }
-    } else if (directory_ && ev->isWriteback() && mshr_.find(ev->getBaseAddr()) != mshr_.end()) {
+    } else if (directory_ && ev->isWriteback() && queue != nullptr) {
         /* Drop writeback if we're stalled waiting for a ForceInv response */
-        MSHREntry * entry = &(mshr_.find(ev->getBaseAddr())->second.front());
-        if (outstandingEventList_.find(entry->id)->second.request->getCmd() == Command::Get) {
+        MSHREntry * entry = &(queue->entries.front());
+        if (getOutstanding(entry->id)->request->getCmd() == Command::Get) {
             MemEvent * response = ev->makeResponse();
             sendResponse(response);
             delete ev;
@@ -632,19 +632,19 @@ void Scratchpad::handleScratchWrite(MemEvent * ev) {
     write->copyMetadata(ev);
     write->setFlag(MemEvent::F_NORESPONSE);
 
-    if (directory_ && ev->isWriteback() && mshr_.find(ev->getBaseAddr()) != mshr_.end()) {
+    if (directory_ && ev->isWriteback() && queue != nullptr) {
         /* For directory - jump write ahead of a Put so we have correct data but otherwise
          * do not resolve race by treating writeback as ackinv since it may not actually signal that
          * the block is not present in caches */
-        std::list<MSHREntry>* entry = &(mshr_.find(ev->getBaseAddr())->second);
-        for (std::list<MSHREntry>::iterator it = entry->begin(); it != entry->end(); it++) {
+        std::vector<MSHREntry>* entry = &(queue->entries);
+        for (std::vector<MSHREntry>::iterator it = entry->begin(); it != entry->end(); it++) {
             if (it->cmd == Command::Put) {
                 if (it == entry->begin()) {
                     doScratchWrite(write);
                     sendResponse(response); /* Send response when request is sent to scratch, since scratch doesn't respond */
                     delete ev;
                 } else {
-                    outstandingEventList_.insert(std::make_pair(ev->getID(),OutstandingEvent(ev,response)));
+                    addOutstanding(ev, response);
                     it = entry->insert(it, MSHREntry(ev->getID(), Command::GetX, write));
 
                     if (is_debug_event(ev))
@@ -656,21 +656,21 @@ void Scratchpad::handleScratchWrite(MemEvent * ev) {
         }
     }
 
-    if (mshr_.find(ev->getBaseAddr()) == mshr_.end()) {
-        doScratchWrite(write);
-        sendResponse(response); /* Send response when request is sent to scratch since scratch doesn't respond */
-        delete ev;
+    if (queue == nullptr) {
         /* Update cache state */
         if (caching_ && !ev->queryFlag(MemEvent::F_NONCACHEABLE)) {
             cacheStatus_.at(ev->getBaseAddr()/scratchLineSize_) = directory_;
         }
+        doScratchWrite(write);
+        sendResponse(response); /* Send response when request is sent to scratch since scratch doesn't respond */
+        delete ev;
     } else {
-        outstandingEventList_.insert(std::make_pair(ev->getID(),OutstandingEvent(ev,response)));
-        mshr_.find(ev->getBaseAddr())->second.push_back(MSHREntry(ev->getID(), Command::GetX, write));
+        addOutstanding(ev, response);
+        queue->entries.push_back(MSHREntry(ev->getID(), Command::GetX, write));
 
         if (is_debug_event(ev))
             dbg.debug(_L10_, "M: %-20" PRIu64 " %-20" PRIu64 " %-20s MSHR:InsEv    0x%-16" PRIx64 " %s\n",
-                        getCurrentSimCycle(), timestamp_, getName().c_str(), ev->getBaseAddr(), mshr_.find(ev->getBaseAddr())->second.back().getString().c_str());
+                        getCurrentSimCycle(), timestamp_, getName().c_str(), ev->getBaseAddr(), queue->entries.back().getString().c_str());
     }
 }
 
@@ -680,40 +680,26 @@ void Scratchpad::handleScratchWrite(MemEvent * ev) {
  * srcAddr to scratch address dstAddr. 'Size' may exceed the scratch
  * line size.
  *
- * 1. Issue read to remote for 'size' bytes from srcAddr
+ * 1. Issue read(s) to remote for 'size' bytes from srcAddr. If
+ *    move_stream_lines is set, the region is read in chunks of that
+ *    many scratch lines with up to move_window reads in flight.
  * 2. If caching, send shootdowns for any cached blocks between
  *    dstAddr & dstAddr+size. All dirty data is discarded.
- * 3. Once the remote read returns, issue writes to the local scratch
- *    starting at address dstAddr (may mean writing multiple blocks).
+ * 3. As each remote read returns, issue writes to the local scratch
+ *    for the lines it covers.
  * 4. Once all writes are sent and all shootdown responses received,
  *    send AckMove to processor. At this point, any scratch reads sent
  *    by the processor are guaranteed to return new data.
  */
 void Scratchpad::handleScratchGet(MemEventBase * event) {
     MoveEvent * ev = static_cast<MoveEvent*>(event);
-    Addr saddr = ev->getSrcBaseAddr();
-    Addr daddr = ev->getDstBaseAddr();
 
     stat_ScratchGetReceived->addData(1);
 
     MoveEvent * response = ev->makeResponse();
-    outstandingEventList_.insert(std::make_pair(ev->getID(),OutstandingEvent(ev,response)));
+    OutstandingEvent * get = addOutstanding(ev, response);
 
-    // Issue remote read
     ev->setSrcBaseAddr((ev->getSrcAddr() - remoteAddrOffset_) & ~(remoteLineSize_ - 1));
-    MemEvent * remoteRead = new MemEvent(getName(), ev->getSrcAddr() - remoteAddrOffset_, ev->getSrcBaseAddr(), Command::GetS, ev->getSize());
-    remoteRead->MemEventBase::copyMetadata(ev);
-    remoteRead->setFlag(MemEvent::F_NONCACHEABLE);
-    remoteRead->setVirtualAddress(ev->getSrcVirtualAddress());
-    remoteRead->setInstructionPointer(ev->getInstructionPointer());
-    responseIDMap_.insert(std::make_pair(remoteRead->getID(), ev->getID()));
-
-    if (is_debug_event(remoteRead)) {
-        dbg.debug(_L10_, "C: %-20" PRIu64 " %-20" PRIu64 " %-20s Get           0x%-16" PRIx64 " 0x%-16" PRIx64 " Remote Read (<%" PRIu64 ", %" PRIu32 ">, 0x%" PRIx64 ")\n",
-                getCurrentSimCycle(), timestamp_, getName().c_str(), saddr, daddr, remoteRead->getID().first, remoteRead->getID().second, remoteRead->getBaseAddr());
-    }
-
-    memMsgQueue_.insert(std::make_pair(timestamp_, remoteRead));
 
     // Insert into mshr and send inv if needed
     // start base addr -> end base addr
@@ -721,18 +707,56 @@ void Scratchpad::handleScratchGet(MemEventBase * event) {
     uint32_t lineCount = 1 + (ev->getDstAddr() + ev->getSize() - ev->getDstBaseAddr() - 1)/ scratchLineSize_;
     for (uint32_t i = 0; i < lineCount; i++) {
         Addr baseAddr = ev->getDstBaseAddr() + i*scratchLineSize_;
-        if (mshr_.find(baseAddr) == mshr_.end()) {
+        MSHRQueue * queue = mshr_.find(baseAddr);
+        if (queue == nullptr) {
             bool needAck = startGet(baseAddr, ev);
-            mshr_.insert(std::make_pair(baseAddr, std::list<MSHREntry>(1, MSHREntry(ev->getID(), Command::Get, true, needAck))));
+            queue = &(mshr_.insert(baseAddr));
+            queue->entries.push_back(MSHREntry(ev->getID(), Command::Get, true, needAck));
         } else {
-            mshr_.find(baseAddr)->second.push_back(MSHREntry(ev->getID(), Command::Get, true));
+            queue->entries.push_back(MSHREntry(ev->getID(), Command::Get, true));
         }
 
         if (is_debug_addr(baseAddr))
             dbg.debug(_L10_, "M: %-20" PRIu64 " %-20" PRIu64 " %-20s MSHR:InsEv    0x%-16" PRIx64 " %s\n",
-                    getCurrentSimCycle(), timestamp_, getName().c_str(), baseAddr, mshr_.find(baseAddr)->second.back().getString().c_str());
+                    getCurrentSimCycle(), timestamp_, getName().c_str(), baseAddr, queue->entries.back().getString().c_str());
+
+        get->count++;
+    }
+
+    issueGetReads(get);
+}
+
+
+/*
+ * Issue remote reads for a Get until the whole region has been requested
+ * or move_window reads are outstanding
+ */
+void Scratchpad::issueGetReads(OutstandingEvent * get) {
+    MoveEvent * ev = static_cast<MoveEvent*>(get->request);
+
+    while (get->nextOffset < ev->getSize() && (moveWindow_ == 0 || get->readsOutstanding < moveWindow_)) {
+        Addr offset = get->nextOffset;
+        Addr addr = ev->getDstAddr() + offset;
+        Addr baseAddr = (offset == 0) ? ev->getDstBaseAddr() : addr;
+        uint32_t size = moveChunkSize(addr, baseAddr, ev->getSize() - offset);
+
+        Addr remoteAddr = ev->getSrcAddr() - remoteAddrOffset_ + offset;
+        MemEvent * remoteRead = new MemEvent(getName(), remoteAddr, remoteAddr & ~(remoteLineSize_ - 1), Command::GetS, size);
+        remoteRead->MemEventBase::copyMetadata(ev);
+        remoteRead->setFlag(MemEvent::F_NONCACHEABLE);
+        remoteRead->setVirtualAddress(ev->getSrcVirtualAddress() + offset);
+        remoteRead->setInstructionPointer(ev->getInstructionPointer());
+        addForward(remoteRead, get, offset);
+
+        if (is_debug_event(remoteRead)) {
+            dbg.debug(_L10_, "C: %-20" PRIu64 " %-20" PRIu64 " %-20s Get           0x%-16" PRIx64 " 0x%-16" PRIx64 " Remote Read (<%" PRIu64 ", %" PRIu32 ">, 0x%" PRIx64 ")\n",
+                    getCurrentSimCycle(), timestamp_, getName().c_str(), ev->getSrcBaseAddr(), ev->getDstBaseAddr(), remoteRead->getID().first, remoteRead->getID().second, remoteRead->getBaseAddr());
+        }
 
-        outstandingEventList_.find(ev->getID())->second.incrementCount();
+        memMsgQueue_.insert(std::make_pair(timestamp_, remoteRead));
+
+        get->nextOffset += size;
+        get->readsOutstanding++;
     }
 }
 
@@ -747,8 +771,10 @@ void Scratchpad::handleScratchGet(MemEventBase * event) {
  *    srcAddr & srcAddr+size.
  * 3. Collect data scratch & shootdown responses in the payload of a write event.
  *    If a shootdown response arrives without data (i.e., was clean or uncached),
- *    send a scratch read.
- * 4. Once all data is received, send write to remote and AckMove to processor
+ *    send a scratch read. If move_stream_lines is set, there is one write per
+ *    chunk of that many scratch lines.
+ * 4. Send each write to remote once its data is complete, and AckMove to
+ *    processor once all data is received
  */
 void Scratchpad::handleScratchPut(MemEventBase * event) {
     MoveEvent *ev = static_cast<MoveEvent*>(event);
@@ -758,37 +784,56 @@ void Scratchpad::handleScratchPut(MemEventBase * event) {
     MoveEvent * response = ev->makeResponse();
     ev->setDstBaseAddr((ev->getDstBaseAddr() - remoteAddrOffset_) & ~(remoteLineSize_ - 1));
 
-    MemEvent * remoteWrite = new MemEvent(getName(), ev->getDstAddr() - remoteAddrOffset_, ev->getDstBaseAddr(), Command::GetX, ev->getSize());
-    remoteWrite->setZeroPayload(ev->getSize());
-    remoteWrite->setFlag(MemEvent::F_NONCACHEABLE);
-    remoteWrite->setFlag(MemEvent::F_NORESPONSE);
-
-    outstandingEventList_.insert(std::make_pair(ev->getID(), OutstandingEvent(ev, response, remoteWrite)));
+    OutstandingEvent * put = addOutstanding(ev, response);
 
+    // Create a remote write for each chunk
     Addr addr = ev->getSrcAddr();
     Addr baseAddr = ev->getSrcBaseAddr();
     uint32_t bytesLeft = ev->getSize();
+    while (bytesLeft != 0) {
+        uint32_t size = moveChunkSize(addr, baseAddr, bytesLeft);
+
+        Addr remoteAddr = ev->getDstAddr() - remoteAddrOffset_ + (addr - ev->getSrcAddr());
+        MemEvent * remoteWrite = new MemEvent(getName(), remoteAddr, remoteAddr & ~(remoteLineSize_ - 1), Command::Write, size);
+        remoteWrite->setZeroPayload(size);
+        remoteWrite->setFlag(MemEvent::F_NONCACHEABLE);
+        remoteWrite->setFlag(MemEvent::F_NORESPONSE);
+
+        put->chunkWrites.push_back(remoteWrite);
+        put->chunkLines.push_back(0);
+
+        bytesLeft -= size;
+        addr += size;
+        baseAddr = addr;
+    }
+
+    addr = ev->getSrcAddr();
+    baseAddr = ev->getSrcBaseAddr();
+    bytesLeft = ev->getSize();
     while (bytesLeft != 0) {
         uint32_t size = (baseAddr + scratchLineSize_) - addr;
         if (size > bytesLeft) size = bytesLeft;
 
-        if (mshr_.find(baseAddr) == mshr_.end()) {
+        put->chunkLines[moveChunk(baseAddr, ev->getSrcBaseAddr())]++;
+        put->count++;
+
+        MSHRQueue * queue = mshr_.find(baseAddr);
+        if (queue == nullptr) {
             bool needAck = startPut(baseAddr, ev);
-            mshr_.insert(std::make_pair(baseAddr, std::list<MSHREntry>(1, MSHREntry(ev->getID(), Command::Put, !needAck, needAck))));
+            queue = &(mshr_.insert(baseAddr));
+            queue->entries.push_back(MSHREntry(ev->getID(), Command::Put, !needAck, needAck));
         } else {
-            mshr_.find(baseAddr)->second.push_back(MSHREntry(ev->getID(), Command::Put));
+            queue->entries.push_back(MSHREntry(ev->getID(), Command::Put));
         }
 
         if (is_debug_addr(baseAddr))
             dbg.debug(_L10_, "M: %-20" PRIu64 " %-20" PRIu64 " %-20s MSHR:InsEv    0x%-16" PRIx64 " %s\n",
                     getCurrentSimCycle(), timestamp_, getName().c_str(),
-                    baseAddr, mshr_.find(baseAddr)->second.back().getString().c_str());
+                    baseAddr, queue->entries.back().getString().c_str());
 
         bytesLeft -= size;
         baseAddr += scratchLineSize_;
         addr = baseAddr;
-
-        outstandingEventList_.find(ev->getID())->second.incrementCount();
     }
 }
 
@@ -801,20 +846,19 @@ void Scratchpad::handleScratchPut(MemEventBase * event) {
  *  All others (regular read responses): call finishRequest()
  */
 void Scratchpad::handleScratchResponse(SST::Event::id_type responseID) {
-    SST::Event::id_type requestID = responseIDMap_.find(responseID)->second;
-    responseIDMap_.erase(responseID);
-
-    Addr baseAddr = responseIDAddrMap_.find(responseID)->second;
-    responseIDAddrMap_.erase(responseID);
+    OutstandingEvent * forward = getOutstanding(responseID);
+    OutstandingEvent * request = forward->owner;
+    Addr baseAddr = forward->addr;
+    eraseOutstanding(responseID);
 
     if (is_debug_addr(baseAddr))
         dbg.debug(_L5_, "C: %-20" PRIu64 " %-20" PRIu64 " %-20s Scratch:Recv  0x%-16" PRIx64 " <%" PRIu64 ", %" PRIu32 ">\n",
                 getCurrentSimCycle(), timestamp_, getName().c_str(), baseAddr, responseID.first, responseID.second);
 
-    if (outstandingEventList_.find(requestID)->second.request->getCmd() == Command::Put) {
-        updatePut(requestID);
+    if (request->request->getCmd() == Command::Put) {
+        updatePut(request, baseAddr);
     } else { // Anything else - GetS, GetX, etc.
-        finishRequest(requestID);
+        finishRequest(request->request->getID());
     }
     updateMSHR(baseAddr);
 }
@@ -834,9 +878,9 @@ void Scratchpad::handleAckInv(MemEventBase * event) {
     Addr baseAddr = response->getBaseAddr();
 
     /* Look up request in mshr */
-    MSHREntry * entry = &(mshr_.find(baseAddr)->second.front());
-    SST::Event::id_type requestID = entry->id;
-    MoveEvent * request = static_cast<MoveEvent*>(outstandingEventList_.find(requestID)->second.request);
+    MSHREntry * entry = &(mshr_.find(baseAddr)->entries.front());
+    OutstandingEvent * outstanding = getOutstanding(entry->id);
+    MoveEvent * request = static_cast<MoveEvent*>(outstanding->request);
 
     /* Update cache status */
     if (is_debug_addr(baseAddr))
@@ -853,7 +897,7 @@ void Scratchpad::handleAckInv(MemEventBase * event) {
                     getCurrentSimCycle(), timestamp_, getName().c_str(), baseAddr, entry->getString().c_str());
 
         if (!entry->needData) {
-            updateGet(entry->id);
+            updateGet(outstanding);
             updateMSHR(baseAddr);
         }
     } else if (entry->cmd == Command::Put) { // Command::Put
@@ -877,16 +921,9 @@ void Scratchpad::handleAckInv(MemEventBase * event) {
         read->MemEventBase::copyMetadata(request);
         read->setVirtualAddress(request->getSrcVirtualAddress());
         read->setInstructionPointer(request->getInstructionPointer());
-        responseIDMap_.insert(std::make_pair(read->getID(),requestID));
-        responseIDAddrMap_.insert(std::make_pair(read->getID(), baseAddr));
-
-        std::vector<uint8_t> data = doScratchRead(read);
-        std::vector<uint8_t> payload = outstandingEventList_.find(requestID)->second.remoteWrite->getPayload();
-        uint32_t offset = addr - request->getSrcAddr();
-        for (uint32_t i = 0; i < size; i++) {
-            payload[i+offset] = data[i];
-        }
-        outstandingEventList_.find(requestID)->second.remoteWrite->setPayload(payload);
+        addForward(read, outstanding, baseAddr);
+
+        addPutData(outstanding, addr, baseAddr, doScratchRead(read), size);
     } else {
         dbg.fatal(CALL_INFO, -1, "%s, Error: unhandled case in handleAckInv. Time = %" PRIu64 ", Event = (%s).\n",
                 getName().c_str(), timestamp_, event->getVerboseString(dlevel).c_str());
@@ -909,9 +946,9 @@ void Scratchpad::handleFetchResp(MemEventBase * event) {
     Addr baseAddr = response->getBaseAddr();
 
     /* Look up request in mshr */
-    MSHREntry * entry = &(mshr_.find(baseAddr)->second.front());
-    SST::Event::id_type requestID = entry->id;
-    MoveEvent * put = static_cast<MoveEvent*>(outstandingEventList_.find(requestID)->second.request);
+    MSHREntry * entry = &(mshr_.find(baseAddr)->entries.front());
+    OutstandingEvent * outstanding = getOutstanding(entry->id);
+    MoveEvent * put = static_cast<MoveEvent*>(outstanding->request);
 
     /* Update cache status */
     cacheStatus_.at(baseAddr/scratchLineSize_) = false;
@@ -933,15 +970,10 @@ void Scratchpad::handleFetchResp(MemEventBase * event) {
     uint32_t size = deriveSize(addr, baseAddr, put->getSrcAddr(), put->getSize());
 
     // Update write payload
-    std::vector<uint8_t> payload = outstandingEventList_.find(requestID)->second.remoteWrite->getPayload();
-    uint32_t offset = addr - put->getSrcAddr();
-    for (uint32_t i = 0; i < size; i++) {
-        payload[i+offset] = response->getPayload()[i];
-    }
-    outstandingEventList_.find(requestID)->second.remoteWrite->setPayload(payload);
+    addPutData(outstanding, addr, baseAddr, response->readPayload(), size);
 
     // Clear this mshr entry
-    updatePut(requestID);
+    updatePut(outstanding, baseAddr);
     updateMSHR(baseAddr);   // Delete mshr entry
     delete response;        // Delete response
 }
@@ -961,13 +993,14 @@ void Scratchpad::handleNack(MemEventBase * event) {
      * been resolved.
      */
     MemEvent * nackedEvent = nack->getNACKedEvent();
-    if (mshr_.find(nackedEvent->getBaseAddr()) == mshr_.end()) {
+    MSHRQueue * queue = mshr_.find(nackedEvent->getBaseAddr());
+    if (queue == nullptr) {
         delete nackedEvent;
         delete nack;
         return;
     }
 
-    MSHREntry * entry = &(mshr_.find(nackedEvent->getBaseAddr())->second.front());
+    MSHREntry * entry = &(queue->entries.front());
     if (entry->needAck) {
         // Determine whether nackedEvent actually matches request -> if not, don't resend
         // resend inv
@@ -1001,8 +1034,7 @@ void Scratchpad::handleRemoteRead(MemEvent * event) {
     request->setFlag(MemEvent::F_NONCACHEABLE); // Use byte not line address
 
     MemEvent * response = event->makeResponse();
-    outstandingEventList_.insert(std::make_pair(event->getID(), OutstandingEvent(event, response)));
-    responseIDMap_.insert(std::make_pair(request->getID(), event->getID()));
+    addForward(request, addOutstanding(event, response), event->getBaseAddr());
 
     memMsgQueue_.insert(std::make_pair(timestamp_, request));
 }
@@ -1035,54 +1067,64 @@ void Scratchpad::handleRemoteWrite(MemEvent * event) {
 
 /*
  * Handle a read response from remote memory in response to a ScratchGet
- * If from a ScratchGet, write data to scratchpad and send a response
+ * Write the chunk's data to scratchpad and send a response
  * to the processor once all data is written.
  */
-void Scratchpad::handleRemoteGetResponse(MemEvent * response, SST::Event::id_type requestID) {
+void Scratchpad::handleRemoteGetResponse(MemEvent * response, OutstandingEvent * get, Addr offset) {
+
+    MoveEvent * request = static_cast<MoveEvent*>(get->request);
+    SST::Event::id_type requestID = request->getID();
 
-    MoveEvent * request = static_cast<MoveEvent*>(outstandingEventList_.find(requestID)->second.request);
+    // Keep the window full before writing this chunk
+    get->readsOutstanding--;
+    issueGetReads(get);
 
-    uint32_t bytesLeft = request->getSize();
-    Addr addr = request->getDstAddr();
-    Addr baseAddr = request->getDstBaseAddr();
+    Addr addr = request->getDstAddr() + offset;
+    Addr baseAddr = (offset == 0) ? request->getDstBaseAddr() : addr;
+    uint32_t bytesLeft = moveChunkSize(addr, baseAddr, request->getSize() - offset);
     uint32_t payloadOffset = 0;
+    Addr dstVirtualAddr = request->getDstVirtualAddress();
+    uint64_t instPtr = request->getInstructionPointer();
+    const std::vector<uint8_t>& payload = response->readPayload();
 
     while (bytesLeft != 0) {
         // Create write
         uint32_t size = (baseAddr + scratchLineSize_) - addr;
         if (size > bytesLeft) size = bytesLeft;
-        std::vector<uint8_t> data((response->getPayload()).begin() + payloadOffset, (response->getPayload()).begin() + payloadOffset + size);
-        MemEvent * write = new MemEvent(getName(), addr, baseAddr, Command::PutM, data);
+        std::vector<uint8_t> data(payload.begin() + payloadOffset, payload.begin() + payloadOffset + size);
+        MemEvent * write = new MemEvent(getName(), addr, baseAddr, Command::PutM, std::move(data));
         write->MemEventBase::copyMetadata(request);
-        write->setVirtualAddress(request->getDstVirtualAddress());
-        write->setInstructionPointer(request->getInstructionPointer());
+        write->setVirtualAddress(dstVirtualAddr);
+        write->setInstructionPointer(instPtr);
         write->setFlag(MemEvent::F_NORESPONSE);
 
-        if (mshr_.find(baseAddr)->second.front().id == requestID) {
+        MSHRQueue * queue = mshr_.find(baseAddr);
+        if (queue == nullptr) {
+            dbg.fatal(CALL_INFO, -1, "ERROR: remoteGetResponse but no matching entry in mshr for address 0x%" PRIx64 "\n", baseAddr);
+        }
+
+        if (queue->entries.front().id == requestID) {
             doScratchWrite(write);
-            mshr_.find(baseAddr)->second.front().needData = false;
+            queue->entries.front().needData = false;
 
             if (is_debug_addr(baseAddr))
                 dbg.debug(_L10_, "M: %-20" PRIu64 " %-20" PRIu64 " %-20s MSHR:Update   0x%-16" PRIx64 " %s\n",
-                        getCurrentSimCycle(), timestamp_, getName().c_str(), baseAddr, mshr_.find(baseAddr)->second.front().getString().c_str());
+                        getCurrentSimCycle(), timestamp_, getName().c_str(), baseAddr, queue->entries.front().getString().c_str());
 
-            if (!mshr_.find(baseAddr)->second.front().needAck) {
-                updateGet(requestID);
+            if (!queue->entries.front().needAck) {
+                updateGet(get); // May complete the Get; 'get' and 'request' are not used after the last line
                 updateMSHR(baseAddr);
             }
         } else {
             // Find it
-            if (mshr_.find(baseAddr) == mshr_.end()) {
-                dbg.fatal(CALL_INFO, -1, "ERROR: remoteGetResponse but no matching entry in mshr for address 0x%" PRIx64 "\n", baseAddr);
-            }
-            for (std::list<MSHREntry>::iterator it = mshr_.find(baseAddr)->second.begin(); it != mshr_.find(baseAddr)->second.end(); it++) {
+            for (std::vector<MSHREntry>::iterator it = queue->entries.begin(); it != queue->entries.end(); it++) {
                 if (it->id == requestID) {
                     it->scratch = write;
                     it->needData = false;
 
                     if (is_debug_addr(baseAddr))
                         dbg.debug(_L10_, "M: %-20" PRIu64 " %-20" PRIu64 " %-20s MSHR:Update   0x%-16" PRIx64 " %s\n",
-                                getCurrentSimCycle(), timestamp_, getName().c_str(), baseAddr, mshr_.find(baseAddr)->second.front().getString().c_str());
+                                getCurrentSimCycle(), timestamp_, getName().c_str(), baseAddr, queue->entries.front().getString().c_str());
                 }
             }
         }
@@ -1094,55 +1136,58 @@ void Scratchpad::handleRemoteGetResponse(MemEvent * response, SST::Event::id_typ
     delete response;
 }
 
-void Scratchpad::handleRemoteReadResponse(MemEvent * response, SST::Event::id_type requestID) {
+void Scratchpad::handleRemoteReadResponse(MemEvent * response, OutstandingEvent * read) {
     // Update response with payload and finish request
-    MemEvent * fwdResponse = static_cast<MemEvent*>(outstandingEventList_.find(requestID)->second.response);
-    fwdResponse->setPayload(response->getPayload());
+    MemEvent * fwdResponse = static_cast<MemEvent*>(read->response);
+    fwdResponse->setPayload(response->getPayloadBuffer());
 
-    finishRequest(requestID);
+    finishRequest(read->request->getID());
 
     delete response;
 }
 
 // Update MSHR
 void Scratchpad::updateMSHR(Addr baseAddr) {
+    MSHRQueue * queue = mshr_.find(baseAddr);
+
     // Remove top event
-    mshr_.find(baseAddr)->second.pop_front();
+    queue->entries.erase(queue->entries.begin());
 
     // Start next event
-    while (!mshr_.find(baseAddr)->second.empty()) {
-        MSHREntry * entry = &(mshr_.find(baseAddr)->second.front());
+    while (!queue->entries.empty()) {
+        MSHREntry * entry = &(queue->entries.front());
 
         if (entry->cmd == Command::GetS) {
-            std::vector<uint8_t> readData = doScratchRead(entry->scratch);
-            static_cast<MemEvent*>(outstandingEventList_.find(entry->id)->second.response)->setPayload(readData);
+            OutstandingEvent * request = getOutstanding(entry->id);
+            static_cast<MemEvent*>(request->response)->setPayload(doScratchRead(entry->scratch));
 
             if (is_debug_addr(baseAddr))
                 dbg.debug(_L10_, "M: %-20" PRIu64 " %-20" PRIu64 " %-20s MSHR:Update   0x%-16" PRIx64 " %s\n",
                         getCurrentSimCycle(), timestamp_, getName().c_str(), baseAddr, entry->getString().c_str());
 
-            if (caching_ && (outstandingEventList_.find(entry->id)->second.request->queryFlag(MemEvent::F_NONCACHEABLE))) {
+            if (caching_ && (request->request->queryFlag(MemEvent::F_NONCACHEABLE))) {
                 cacheStatus_.at(baseAddr/scratchLineSize_) = true;
             }
             break;
         } else if (entry->cmd == Command::GetX || entry->cmd == Command::Write) {
             doScratchWrite(entry->scratch);
             finishRequest(entry->id);
-            mshr_.find(baseAddr)->second.pop_front();
+            queue->entries.erase(queue->entries.begin());
 
             if (is_debug_addr(baseAddr))
                 dbg.debug(_L10_, "M: %-20" PRIu64 " %-20" PRIu64 " %-20s MSHR:Remove   0x%-16" PRIx64 "\n",
                         getCurrentSimCycle(), timestamp_, getName().c_str(), baseAddr);
 
         } else if (entry->cmd == Command::Get) {
-            entry->needAck = startGet(baseAddr, static_cast<MoveEvent*>(outstandingEventList_.find(entry->id)->second.request));
+            OutstandingEvent * get = getOutstanding(entry->id);
+            entry->needAck = startGet(baseAddr, static_cast<MoveEvent*>(get->request));
             if (!entry->needData) {
                 doScratchWrite(entry->scratch);
                 entry->scratch = nullptr;
             }
             if (!entry->needAck && !entry->needData) {
-                updateGet(entry->id);
-                mshr_.find(baseAddr)->second.pop_front();
+                updateGet(get);
+                queue->entries.erase(queue->entries.begin());
 
                 if (is_debug_addr(baseAddr))
                     dbg.debug(_L10_, "M: %-20" PRIu64 " %-20" PRIu64 " %-20s MSHR:Remove   0x%-16" PRIx64 "\n",
@@ -1155,7 +1200,7 @@ void Scratchpad::updateMSHR(Addr baseAddr) {
                 break; // Still waiting on something
             }
         } else if (entry->cmd == Command::Put) {
-            entry->needAck = startPut(baseAddr, static_cast<MoveEvent*>(outstandingEventList_.find(entry->id)->second.request));
+            entry->needAck = startPut(baseAddr, static_cast<MoveEvent*>(getOutstanding(entry->id)->request));
             entry->needData = !entry->needAck;
 
             if (is_debug_addr(baseAddr))
@@ -1169,7 +1214,7 @@ void Scratchpad::updateMSHR(Addr baseAddr) {
     }
 
     // Clear mshr entry if list is empty
-    if (mshr_.find(baseAddr)->second.empty()) {
+    if (queue->entries.empty()) {
         mshr_.erase(baseAddr);
 
         if (is_debug_addr(baseAddr))
@@ -1255,56 +1300,63 @@ bool Scratchpad::startPut(Addr baseAddr, MoveEvent * put) {
         read->MemEventBase::copyMetadata(put);
         read->setVirtualAddress(put->getSrcVirtualAddress());
         read->setInstructionPointer(put->getInstructionPointer());
-        responseIDMap_.insert(std::make_pair(read->getID(), put->getID()));
-        responseIDAddrMap_.insert(std::make_pair(read->getID(), baseAddr));
 
-        std::vector<uint8_t> data = doScratchRead(read);
+        OutstandingEvent * outstanding = getOutstanding(put->getID());
+        addForward(read, outstanding, baseAddr);
 
-        std::vector<uint8_t> payload = outstandingEventList_.find(put->getID())->second.remoteWrite->getPayload();
-        uint32_t offset = addr - put->getSrcAddr();
-        for (uint32_t i = 0; i < size; i++) {
-            payload[i+offset] = data[i];
-        }
-        outstandingEventList_.find(put->getID())->second.remoteWrite->setPayload(payload);
+        addPutData(outstanding, addr, baseAddr, doScratchRead(read), size);
         return false;
     }
 }
 
-void Scratchpad::updatePut(SST::Event::id_type putID) {
-    uint32_t count = outstandingEventList_.find(putID)->second.decrementCount();
-    if (count == 0) {
-        MoveEvent * put = static_cast<MoveEvent*>(outstandingEventList_.find(putID)->second.request);
+/*
+ * Record that a line of a Put has its data. Send the chunk's
+ * remote write once all of its lines are in, and finish the Put
+ * once all lines are.
+ */
+void Scratchpad::updatePut(OutstandingEvent * put, Addr baseAddr) {
+    MoveEvent * request = static_cast<MoveEvent*>(put->request);
+    uint32_t chunk = moveChunk(baseAddr, request->getSrcBaseAddr());
+
+    put->chunkLines[chunk]--;
+    if (put->chunkLines[chunk] == 0) {
+        MemEvent * remoteWrite = put->chunkWrites[chunk];
         dbg.debug(_L10_, "C: %-20" PRIu64 " %-20" PRIu64 " %-20s Put            0x%-16" PRIx64 " 0x%-16" PRIx64 " Scratch Done (<%" PRIu64 ", %" PRIu32 ">, 0x%" PRIx64 ")\n",
                 getCurrentSimCycle(), timestamp_, getName().c_str(),
-                put->getSrcBaseAddr(),
-                put->getDstBaseAddr(),
-                outstandingEventList_.find(putID)->second.remoteWrite->getID().first,
-                outstandingEventList_.find(putID)->second.remoteWrite->getID().second,
-                outstandingEventList_.find(putID)->second.remoteWrite->getBaseAddr());
-//        dbg.debug(_L5_, "C: %-20" PRIu64 " %-20" PRIu64 " %-20s Finish        0x%-16" PRIx64 " <%" PRIu64 ", %" PRIu32 ">\n",
-//                getCurrentSimCycle(), timestamp_, getName().c_str(), outstandingEventList_.find(putID)->second.remoteWrite->getBaseAddr(), baseAddr, responseID.first, responseID.second);
-        memMsgQueue_.insert(std::make_pair(timestamp_, outstandingEventList_.find(putID)->second.remoteWrite));
-        sendResponse(outstandingEventList_.find(putID)->second.response);
-        delete outstandingEventList_.find(putID)->second.request;
-        outstandingEventList_.erase(putID);
+                request->getSrcBaseAddr(),
+                request->getDstBaseAddr(),
+                remoteWrite->getID().first,
+                remoteWrite->getID().second,
+                remoteWrite->getBaseAddr());
+        memMsgQueue_.insert(std::make_pair(timestamp_, remoteWrite));
+        put->chunkWrites[chunk] = nullptr;
     }
 
+    put->count--;
+    if (put->count == 0) {
+        SST::Event::id_type putID = request->getID();
+        sendResponse(put->response);
+        delete request;
+        eraseOutstanding(putID);
+    }
 }
 
-void Scratchpad::updateGet(SST::Event::id_type getID) {
-    uint32_t count = outstandingEventList_.find(getID)->second.decrementCount();
-    if (count == 0) {
-        sendResponse(outstandingEventList_.find(getID)->second.response);
-        delete outstandingEventList_.find(getID)->second.request;
-        outstandingEventList_.erase(getID);
+void Scratchpad::updateGet(OutstandingEvent * get) {
+    get->count--;
+    if (get->count == 0) {
+        SST::Event::id_type getID = get->request->getID();
+        sendResponse(get->response);
+        delete get->request;
+        eraseOutstanding(getID);
     }
 }
 
 void Scratchpad::finishRequest(SST::Event::id_type requestID) {
-    if (outstandingEventList_.find(requestID)->second.response != nullptr)
-        sendResponse(outstandingEventList_.find(requestID)->second.response);
-    delete outstandingEventList_.find(requestID)->second.request;
-    outstandingEventList_.erase(requestID);
+    OutstandingEvent * request = getOutstanding(requestID);
+    if (request->response != nullptr)
+        sendResponse(request->response);
+    delete request->request;
+    eraseOutstanding(requestID);
 }
 
 uint32_t Scratchpad::deriveSize(Addr addr, Addr baseAddr, Addr requestAddr, uint32_t requestSize) {
@@ -1314,3 +1366,43 @@ uint32_t Scratchpad::deriveSize(Addr addr, Addr baseAddr, Addr requestAddr, uint
     }
     return size;
 }
+
+/* Track a request received from the processor */
+Scratchpad::OutstandingEvent * Scratchpad::addOutstanding(MemEventBase * request, MemEventBase * response) {
+    OutstandingEvent * outstanding = &(outstandingEvents_.insert(request->getID()));
+    outstanding->request = request;
+    outstanding->response = response;
+    return outstanding;
+}
+
+/* Track a scratch or remote read sent on behalf of 'owner' */
+void Scratchpad::addForward(MemEventBase * forward, OutstandingEvent * owner, Addr addr) {
+    OutstandingEvent * outstanding = &(outstandingEvents_.insert(forward->getID()));
+    outstanding->owner = owner;
+    outstanding->addr = addr;
+}
+
+/* Number of bytes of a move, starting at 'addr' on the line at 'baseAddr', that go in one chunk */
+uint32_t Scratchpad::moveChunkSize(Addr addr, Addr baseAddr, uint32_t bytesLeft) {
+    if (moveStreamLines_ == 0)
+        return bytesLeft;
+    uint32_t size = baseAddr + moveStreamLines_ * scratchLineSize_ - addr;
+    return (size > bytesLeft) ? bytesLeft : size;
+}
+
+/* Index of the chunk that holds the line at 'baseAddr', for a move whose first line is at 'firstBaseAddr' */
+uint32_t Scratchpad::moveChunk(Addr baseAddr, Addr firstBaseAddr) {
+    if (moveStreamLines_ == 0)
+        return 0;
+    return ((baseAddr - firstBaseAddr) / scratchLineSize_) / moveStreamLines_;
+}
+
+/* Copy 'size' bytes of scratch data for 'addr' into the Put's remote write for that line */
+void Scratchpad::addPutData(OutstandingEvent * put, Addr addr, Addr baseAddr, const std::vector<uint8_t> &data, uint32_t size) {
+    MoveEvent * request = static_cast<MoveEvent*>(put->request);
+    uint32_t chunk = moveChunk(baseAddr, request->getSrcBaseAddr());
+    Addr chunkAddr = (chunk == 0) ? request->getSrcAddr() : request->getSrcBaseAddr() + chunk * moveStreamLines_ * scratchLineSize_;
+
+    std::vector<uint8_t> &payload = put->chunkWrites[chunk]->getPayload();
+    std::copy(data.begin(), data.begin() + size, payload.begin() + (addr - chunkAddr));
+}
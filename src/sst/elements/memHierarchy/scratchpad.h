@@ -23,9 +23,10 @@
 #include <sst/core/link.h>
 #include <sst/core/output.h>
 #include <map>
-#include <list>
+#include <vector>
 
 #include "sst/elements/memHierarchy/membackend/backing.h"
+#include "sst/elements/memHierarchy/addrHashTable.h"
 #include "sst/elements/memHierarchy/moveEvent.h"
 #include "sst/elements/memHierarchy/memEvent.h"
 #include "sst/elements/memHierarchy/memLinkBase.h"
@@ -50,6 +51,9 @@ public:
             {"backing_size_unit",   "(string) For 'malloc' backing stores, malloc granularity", "1MiB"},\
             {"memory_addr_offset",  "(uint) Amount to offset remote addresses by. Default is 'size' so that remote memory addresses start at 0", "size"},
             {"response_per_cycle",  "(uint) Maximum number of responses to return to processor each cycle. 0 is unlimited", "0"},
+            {"move_stream_lines",   "(uint) Stream Gets and Puts to/from remote memory in requests of this many scratch lines, so that a multi-line move overlaps its remote and scratch accesses. 0 moves the whole region with one remote request.", "0"},
+            {"move_window",         "(uint) For streamed Gets, maximum number of remote reads outstanding per Get. 0 is unlimited", "8"},
+            {"mshr_entries",        "(uint) Number of outstanding requests and MSHR lines the scratchpad's tables are sized for. They grow if exceeded.", "256"},
             {"backendConvertor",    "(string) Backend convertor to use for the scratchpad", "memHierarchy.scratchpadBackendConvertor"},
             {"debug",               "(uint) Where to print debug output. Options: 0[no output], 1[stdout], 2[stderr], 3[file]", "0"},
             {"debug_level",         "(uint) Debug verbosity level. Between 0 and 10", "0"} )
@@ -114,6 +118,8 @@ private:
     // Local variables
     uint64_t timestamp_;
 
+    struct OutstandingEvent;
+
     // Event handling
     bool clock(SST::Cycle_t cycle);
 
@@ -134,8 +140,8 @@ private:
     void handleFetchResp(MemEventBase * event);
     void handleNack(MemEventBase * event);
 
-    void handleRemoteGetResponse(MemEvent * response, SST::Event::id_type id);
-    void handleRemoteReadResponse(MemEvent * response, SST::Event::id_type id);
+    void handleRemoteGetResponse(MemEvent * response, OutstandingEvent * get, Addr offset);
+    void handleRemoteReadResponse(MemEvent * response, OutstandingEvent * read);
 
     // Helper methods
     void updateMSHR(Addr baseAddr);
@@ -147,8 +153,8 @@ private:
     bool startGet(Addr baseAddr, MoveEvent * get);
     bool startPut(Addr baseAddr, MoveEvent * put);
 
-    void updateGet(SST::Event::id_type id);
-    void updatePut(SST::Event::id_type id);
+    void updateGet(OutstandingEvent * get);
+    void updatePut(OutstandingEvent * put, Addr baseAddr);
     void finishRequest(SST::Event::id_type id);
 
     uint32_t deriveSize(Addr addr, Addr baseAddr, Addr requestAddr, uint32_t requestSize);
@@ -157,21 +163,41 @@ private:
     MemLinkBase* linkUp_;     // To cache/cpu
     MemLinkBase* linkDown_;   // To memory
 
-    class OutstandingEvent {
-        public:
-            MemEventBase * request;     // Request (outstanding event)
-            MemEventBase * response;    // Sent to processor when complete
-            MemEvent * remoteWrite;     // For Put requests, collect scratch read responses here
-            uint32_t count;             // Number of lines we are waiting on - when 0, the request is complete
-                                        // i.e., for a read or write, just 1, for a get or put, the size/lineSize
-
-            OutstandingEvent(MemEventBase * request, MemEventBase * response) : request(request), response(response), remoteWrite(nullptr), count(0) { }
-            OutstandingEvent(MemEventBase * request, MemEventBase * response, MemEvent * write) : request(request), response(response), remoteWrite(write), count(0) { }
-
-            uint32_t decrementCount() { count--; return count; }
-            void incrementCount() { count++; }
-            uint32_t getCount() { return count; }
+    /*
+     * Outstanding requests, and the scratch and remote reads sent for them,
+     * share one pooled table keyed by event ID. A read's record points at
+     * the request it was sent for.
+     */
+    struct OutstandingEvent {
+        MemEventBase * request;     // Request (outstanding event)
+        MemEventBase * response;    // Sent to processor when complete
+        uint32_t count;             // Number of lines we are waiting on - when 0, the request is complete
+                                    // i.e., for a read or write, just 1, for a get or put, the number of scratch lines
+
+        // Gets and Puts move their region in chunks of moveStreamLines_ scratch lines (one chunk if 0)
+        std::vector<MemEvent*> chunkWrites; // Put: remote write for each chunk, collects scratch data and is sent once complete
+        std::vector<uint32_t> chunkLines;   // Put: number of lines each chunk is waiting on
+        Addr nextOffset;                    // Get: offset of the next chunk to read from remote
+        uint32_t readsOutstanding;          // Get: remote reads in flight
+
+        // For a scratch or remote read sent on behalf of a request
+        OutstandingEvent * owner;   // The request
+        Addr addr;                  // Scratch read: base address of the line. Get remote read: offset of the chunk.
+
+        OutstandingEvent() { reset(); }
+        void reset() {
+            request = nullptr;
+            response = nullptr;
+            count = 0;
+            chunkWrites.clear();
+            chunkLines.clear();
+            nextOffset = 0;
+            readsOutstanding = 0;
+            owner = nullptr;
+            addr = 0;
+        }
     };
+
     // MSHR entry
     // MSHR consists of a base address and queue of these
     class MSHREntry {
@@ -203,6 +229,12 @@ private:
             }
     };
 
+    // MSHR queue for one scratch line; front is entries[0]
+    struct MSHRQueue {
+        std::vector<MSHREntry> entries;
+        void reset() { entries.clear(); }
+    };
+
     struct dbgin {
         SST::Event::id_type id;
         Command cmd;
@@ -226,10 +258,27 @@ private:
         }
     } eventDI;
 
-    std::map<SST::Event::id_type,SST::Event::id_type> responseIDMap_;   // Map a forwarded request ID to a original request ID
-    std::map<SST::Event::id_type,Addr> responseIDAddrMap_;              // Map an outstanding scratch request ID to the request's baseAddr
-    std::map<SST::Event::id_type,OutstandingEvent> outstandingEventList_; // List of all outstanding events
-    std::map<Addr,std::list<MSHREntry> > mshr_; // MSHR for scratch accesses
+    /*
+     * Both tables are sized for 'mshr_entries' and grow past it rather than
+     * refuse an event. The processor link has no flow control to push back
+     * on, and the requests the scratchpad issues itself for a move are
+     * already bounded by 'move_window'.
+     */
+    AddrHashTable<OutstandingEvent, SST::Event::id_type> outstandingEvents_;   // All outstanding events and the reads sent for them, by event ID
+    AddrHashTable<MSHRQueue> mshr_;                                             // MSHR for scratch accesses, by line base address
+
+    OutstandingEvent * addOutstanding(MemEventBase * request, MemEventBase * response);
+    OutstandingEvent * getOutstanding(SST::Event::id_type id) { return outstandingEvents_.find(id); }
+    void addForward(MemEventBase * forward, OutstandingEvent * owner, Addr addr);
+    void eraseOutstanding(SST::Event::id_type id) { outstandingEvents_.erase(id); }
+
+    // Streamed moves
+    uint32_t moveStreamLines_;
+    uint32_t moveWindow_;
+    uint32_t moveChunkSize(Addr addr, Addr baseAddr, uint32_t bytesLeft);
+    uint32_t moveChunk(Addr baseAddr, Addr firstBaseAddr);
+    void issueGetReads(OutstandingEvent * get);
+    void addPutData(OutstandingEvent * put, Addr addr, Addr baseAddr, const std::vector<uint8_t> &data, uint32_t size);
 
 
     // Outgoing message queues - map send timestamp to event
@@ -243,7 +292,6 @@ private:
     bool caching_;  // Whether or not caching is possible
     bool directory_; // Whether or not a directory is managing the caches - if so we cannot assume on a writeback that the data is not cached
     std::vector<bool> cacheStatus_; // One entry per scratchpad line, whether line may be cached
-    std::map<SST::Event::id_type, uint64_t> cacheCounters_; // Map of a Get or Put ID to the number of cache acks/data responses we are waiting for
 
     // Statistics
     Statistic<uint64_t>* stat_ScratchReadReceived;
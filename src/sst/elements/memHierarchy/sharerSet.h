@@ -0,0 +1,206 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_SHARERSET_H
+#define MEMHIERARCHY_SHARERSET_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <set>
+
+#include "sst/elements/memHierarchy/endpointRegistry.h"
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ * Compact sharer/owner tracking for coherence state
+ *
+ * Endpoints are mapped to small, dense integer IDs by SharerIDMap and
+ * sharers are recorded as a bitset indexed by ID. Membership is a bit test
+ * and iteration walks set bits with ctz, so invalidation fan-out no longer
+ * does string compares or tree walks.
+ *
+ * Sharer IDs are a per-thread renumbering of the process-wide endpoint IDs
+ * (EndpointRegistry), looked up by indexing a vector with the endpoint ID,
+ * so the event's source ID finds its sharer ID without touching the name.
+ * The renumbering exists so that sharer iteration order is deterministic:
+ * endpoint IDs are assigned in whatever order threads register names, while
+ * registerNames() numbers a component's sources in name order. A component
+ * (and therefore every line it owns) runs on a single thread, so sharer IDs
+ * never need to be consistent across threads and lookups need no locking.
+ */
+class SharerIDMap {
+    public:
+        static constexpr uint32_t NO_ID = (uint32_t)-1;
+
+        /* Return the ID for an endpoint, assigning the next free ID if it is new */
+        static uint32_t getID(EndpointID endpoint) {
+            Table &t = table();
+            if (endpoint >= t.ids.size())
+                t.ids.resize(endpoint + 1, NO_ID);
+            if (t.ids[endpoint] == NO_ID) {
+                t.ids[endpoint] = t.endpoints.size();
+                t.endpoints.push_back(endpoint);
+            }
+            return t.ids[endpoint];
+        }
+
+        /* Return the ID for an endpoint or NO_ID if it has never been registered */
+        static uint32_t findID(EndpointID endpoint) {
+            Table &t = table();
+            return endpoint < t.ids.size() ? t.ids[endpoint] : NO_ID;
+        }
+
+        static uint32_t getID(const std::string &name) { return getID(EndpointRegistry::getID(name)); }
+        static uint32_t findID(const std::string &name) { return findID(EndpointRegistry::getID(name)); }
+
+        static const std::string& getName(uint32_t id) {
+            Table &t = table();
+            return EndpointRegistry::getName(id < t.endpoints.size() ? t.endpoints[id] : EndpointRegistry::NO_ENDPOINT);
+        }
+
+        /* Pre-register a group of names. Called during setup() with a component's
+         * known sources so that IDs (and so sharer iteration order) follow name order */
+        static void registerNames(const std::set<std::string> &names) {
+            for (std::set<std::string>::const_iterator it = names.begin(); it != names.end(); it++)
+                getID(*it);
+        }
+
+    private:
+        struct Table {
+            std::vector<uint32_t> ids;          // Endpoint ID -> sharer ID
+            std::vector<EndpointID> endpoints;  // Sharer ID -> endpoint ID
+        };
+
+        static Table& table() {
+            static thread_local Table t;
+            return t;
+        }
+};
+
+/* Dynamic bitset of sharer IDs. IDs below 64 are held inline; larger IDs spill into extra words. */
+class SharerSet {
+    public:
+        /* Iterates set bits in ID order. Dereferences to the sharer's name so that
+         * callers written against std::set<std::string> keep working. */
+        class iterator {
+            public:
+                iterator(const SharerSet * set, uint32_t id) : set_(set), id_(id) { }
+                const std::string& operator*() const { return SharerIDMap::getName(id_); }
+                const std::string* operator->() const { return &SharerIDMap::getName(id_); }
+                uint32_t id() const { return id_; }
+                iterator& operator++() { id_ = set_->next(id_ + 1); return *this; }
+                iterator operator++(int) { iterator tmp = *this; ++(*this); return tmp; }
+                bool operator==(const iterator &o) const { return id_ == o.id_; }
+                bool operator!=(const iterator &o) const { return id_ != o.id_; }
+            private:
+                const SharerSet * set_;
+                uint32_t id_;
+        };
+
+        SharerSet() : bits_(0), count_(0) { }
+
+        /* ID interface */
+        bool contains(uint32_t id) const {
+            if (id < 64) return (bits_ >> id) & 1;
+            uint32_t w = (id >> 6) - 1;
+            return w < ext_.size() && ((ext_[w] >> (id & 63)) & 1);
+        }
+
+        void insert(uint32_t id) {
+            uint64_t * word = wordFor(id, true);
+            uint64_t mask = 1ULL << (id & 63);
+            if (!(*word & mask)) {
+                *word |= mask;
+                count_++;
+            }
+        }
+
+        void erase(uint32_t id) {
+            uint64_t * word = wordFor(id, false);
+            if (!word) return;
+            uint64_t mask = 1ULL << (id & 63);
+            if (*word & mask) {
+                *word &= ~mask;
+                count_--;
+            }
+        }
+
+        void clear() {
+            bits_ = 0;
+            for (size_t i = 0; i < ext_.size(); i++)
+                ext_[i] = 0;
+            count_ = 0;
+        }
+
+        size_t size() const { return count_; }
+        bool empty() const { return count_ == 0; }
+
+        /* Lowest set ID at or above 'from', or NO_ID */
+        uint32_t next(uint32_t from) const {
+            if (from < 64) {
+                uint64_t w = bits_ & (~0ULL << from);
+                if (w) return __builtin_ctzll(w);
+                from = 64;
+            }
+            size_t i = (from >> 6) - 1;
+            if (i >= ext_.size()) return SharerIDMap::NO_ID;
+            uint64_t w = ext_[i] & (~0ULL << (from & 63));
+            while (!w) {
+                if (++i >= ext_.size()) return SharerIDMap::NO_ID;
+                w = ext_[i];
+            }
+            return ((i + 1) << 6) + __builtin_ctzll(w);
+        }
+
+        iterator begin() const { return iterator(this, next(0)); }
+        iterator end() const { return iterator(this, SharerIDMap::NO_ID); }
+
+        /* Name adapters */
+        bool contains(const std::string &name) const {
+            uint32_t id = SharerIDMap::findID(name);
+            return id != SharerIDMap::NO_ID && contains(id);
+        }
+        void insert(const std::string &name) { insert(SharerIDMap::getID(name)); }
+        void erase(const std::string &name) {
+            uint32_t id = SharerIDMap::findID(name);
+            if (id != SharerIDMap::NO_ID) erase(id);
+        }
+
+        /* True if any sharer other than 'id' is present */
+        bool hasOther(uint32_t id) const {
+            return count_ > 1 || (count_ == 1 && !contains(id));
+        }
+        bool hasOther(const std::string &name) const { return hasOther(SharerIDMap::findID(name)); }
+
+    private:
+        uint64_t * wordFor(uint32_t id, bool grow) {
+            if (id < 64) return &bits_;
+            uint32_t w = (id >> 6) - 1;
+            if (w >= ext_.size()) {
+                if (!grow) return nullptr;
+                ext_.resize(w + 1, 0);
+            }
+            return &ext_[w];
+        }
+
+        uint64_t bits_;
+        std::vector<uint64_t> ext_;
+        uint32_t count_;
+};
+
+}}
+#endif // MEMHIERARCHY_SHARERSET_H
@@ -365,7 +365,8 @@ SST::Event* StandardInterface::MemEventConverter::convert(StandardMem::Write* re
     }
     
     Addr bAddr = (iface->lineSize_ == 0 || noncacheable) ? req->pAddr : req->pAddr & iface->baseAddrMask_;
-    MemEvent* write = new MemEvent(iface->getName(), req->pAddr, bAddr, Command::Write, req->data);
+    uint64_t dataSize = req->data.size();
+    MemEvent* write = new MemEvent(iface->getName(), req->pAddr, bAddr, Command::Write, std::move(req->data)); // Request keeps no data once converted
     
     write->setRqstr(iface->getName());
     write->setThreadID(req->tid);
@@ -379,13 +380,13 @@ SST::Event* StandardInterface::MemEventConverter::convert(StandardMem::Write* re
     if (req->posted)
         write->setFlag(MemEvent::F_NORESPONSE);
     
-    if (req->data.size() == 0) { // Endpoint isn't using real data values & didn't give a dummy payload
+    if (dataSize == 0) { // Endpoint isn't using real data values & didn't give a dummy payload
         write->setZeroPayload(req->size);
     }
 #ifdef __SST_DEBUG_OUTPUT__
-    else if (req->data.size() != req->size) {
-        output.verbose(CALL_INFO, 1, 0, "Warning (%s): Write request size is %" PRIu64 " and payload size is %zu. MemEvent will use payload size.\n",
-            iface->getName().c_str(), req->size, req->data.size());
+    else if (dataSize != req->size) {
+        output.verbose(CALL_INFO, 1, 0, "Warning (%s): Write request size is %" PRIu64 " and payload size is %" PRIu64 ". MemEvent will use payload size.\n",
+            iface->getName().c_str(), req->size, dataSize);
     } 
     debugChecks(write);
 #endif
@@ -431,14 +432,15 @@ Event* StandardInterface::MemEventConverter::convert(StandardMem::ReadLock* req)
 }
 SST::Event* StandardInterface::MemEventConverter::convert(StandardMem::WriteUnlock* req) {
     Addr bAddr = (iface->lineSize_ == 0 || req->getNoncacheable()) ? req->pAddr : req->pAddr & iface->baseAddrMask_;
-    MemEvent* write = new MemEvent(iface->getName(), req->pAddr, bAddr, Command::Write, req->data);
+    bool noData = req->data.empty();
+    MemEvent* write = new MemEvent(iface->getName(), req->pAddr, bAddr, Command::Write, std::move(req->data));
     write->setRqstr(iface->getName());
     write->setThreadID(req->tid);
     write->setDst(iface->link_->getTargetDestination(bAddr));
     write->setVirtualAddress(req->vAddr);
     write->setInstructionPointer(req->iPtr);
     write->setFlag(MemEvent::F_LOCKED);
-    if (req->data.size() == 0) { // Endpoint isn't using real data values & didn't give a dummy payload
+    if (noData) { // Endpoint isn't using real data values & didn't give a dummy payload
         write->setZeroPayload(req->size);
     }
     if (req->getNoncacheable())
@@ -470,7 +472,8 @@ SST::Event* StandardInterface::MemEventConverter::convert(StandardMem::LoadLink*
 
 SST::Event* StandardInterface::MemEventConverter::convert(StandardMem::StoreConditional* req) {
     Addr bAddr = (iface->lineSize_ == 0 || req->getNoncacheable()) ? req->pAddr : req->pAddr & iface->baseAddrMask_;
-    MemEvent* store = new MemEvent(iface->getName(), req->pAddr, bAddr, Command::Write, req->data);
+    bool noData = req->data.empty();
+    MemEvent* store = new MemEvent(iface->getName(), req->pAddr, bAddr, Command::Write, std::move(req->data));
     store->setFlag(MemEvent::F_LLSC);
     store->setRqstr(iface->getName());
     store->setThreadID(req->tid);
@@ -478,7 +481,7 @@ SST::Event* StandardInterface::MemEventConverter::convert(StandardMem::StoreCond
     store->setVirtualAddress(req->vAddr);
     store->setInstructionPointer(req->iPtr);
     
-    if (req->data.size() == 0) { // Endpoint isn't using real data values & didn't give a dummy payload
+    if (noData) { // Endpoint isn't using real data values & didn't give a dummy payload
         store->setZeroPayload(req->size);
     }
     if (req->getNoncacheable())
@@ -527,7 +530,7 @@ SST::Event* StandardInterface::MemEventConverter::convert(StandardMem::ReadResp*
     MemEvent* mereq = static_cast<MemEvent*>(it->second); // Matching memEvent req
     iface->responses_.erase(it);
     MemEvent* meresp = mereq->makeResponse();
-    meresp->setPayload(resp->data);
+    meresp->setPayload(std::move(resp->data)); // Response is deleted once converted
     if (!resp->getSuccess()) {
         meresp->setFail();
     }
@@ -568,10 +571,10 @@ StandardMem::Request* StandardInterface::convertResponseGetSResp(StandardMem::Re
     MemEvent* me = static_cast<MemEvent*>(meb);
     StandardMem::ReadResp* resp = static_cast<StandardMem::ReadResp*>(req->makeResponse());
     if (resp->size == me->getSize()) {
-        resp->data = me->getPayload();
+        me->takePayload(resp->data); // Response event is deleted once converted
     } else { // Need to extract just the relevant bit of the payload
         Addr offset = me->getAddr() - me->getBaseAddr();
-        auto payload = me->getPayload();
+        const auto& payload = me->readPayload();
         resp->data.assign(payload.begin() + offset, payload.begin() + offset + resp->size);
     }
     if (!me->success()) {
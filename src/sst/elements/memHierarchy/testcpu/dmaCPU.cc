@@ -0,0 +1,170 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+#include "testcpu/dmaCPU.h"
+#include "util.h"
+
+using namespace std;
+using namespace SST;
+using namespace SST::MemHierarchy;
+
+DMACPU::DMACPU(ComponentId_t id, Params& params) : Component(id), rng(id, 13)
+{
+    // Restart the RNG to ensure completely consistent results
+    uint32_t z_seed = params.find<uint32_t>("rngseed", 7);
+    rng.restart(z_seed, 13);
+
+    out.init("", params.find<int>("verbose", 0), 0, Output::STDOUT);
+
+    memLineSize = params.find<uint64_t>("memLineSize", 64);
+    maxCommandSize = params.find<uint64_t>("maxCommandSize", 2048);
+    commandsToIssue = params.find<uint64_t>("commandsToIssue", 64);
+    uint32_t maxOutstanding = params.find<uint32_t>("maxOutstandingCommands", 4);
+
+    if (memLineSize < 1) out.fatal(CALL_INFO, -1, "Error (%s): invalid param 'memLineSize' - must be greater than 0\n", getName().c_str());
+    if (maxCommandSize < 1) out.fatal(CALL_INFO, -1, "Error (%s): invalid param 'maxCommandSize' - must be greater than 0\n", getName().c_str());
+    if (maxOutstanding < 1) out.fatal(CALL_INFO, -1, "Error (%s): invalid param 'maxOutstandingCommands' - must be greater than 0\n", getName().c_str());
+    transfers.resize(maxOutstanding);
+
+    UnitAlgebra clock = params.find<UnitAlgebra>("clock", "1GHz");
+    TimeConverter * clockTC = registerClock( clock, new Clock::Handler<DMACPU>(this, &DMACPU::tick) );
+
+    dmaLink = configureLink("dma_link", new Event::Handler<DMACPU>(this, &DMACPU::handleDMA));
+    sst_assert(dmaLink, CALL_INFO, -1, "%s, Error: unable to configure 'dma_link'\n", getName().c_str());
+
+    memory = loadUserSubComponent<Interfaces::StandardMem>("memory", ComponentInfo::SHARE_NONE, clockTC, new Interfaces::StandardMem::Handler<DMACPU>(this, &DMACPU::handleEvent) );
+    sst_assert(memory, CALL_INFO, -1, "Unable to load a StandardMem interface; check that the 'memory' slot is filled in the input\n");
+
+    // tell the simulator not to end without us
+    registerAsPrimaryComponent();
+    primaryComponentDoNotEndSim();
+
+    commandsIssued = commandsChecked = bytesChecked = 0;
+}
+
+void DMACPU::init(unsigned int phase) {
+    memory->init(phase);
+}
+
+void DMACPU::finish() {
+    out.output("DMACPU %s checked %" PRIu64 " transfers, %" PRIu64 " bytes\n", getName().c_str(), commandsChecked, bytesChecked);
+}
+
+bool DMACPU::tick(Cycle_t time) {
+    for (size_t slot = 0; slot < transfers.size() && commandsIssued < commandsToIssue; slot++) {
+        if (transfers[slot].phase == Phase::Idle)
+            startTransfer(slot);
+    }
+
+    if (commandsChecked == commandsToIssue) {
+        primaryComponentOKToEndSim();
+        return true;
+    }
+    return false;
+}
+
+/* Each slot owns two regions of 2 * maxCommandSize bytes; a transfer goes from somewhere in the first to somewhere in the second */
+void DMACPU::startTransfer(size_t slot) {
+    Transfer &t = transfers[slot];
+    uint64_t region = 2 * maxCommandSize;
+    uint64_t size = 1 + rng.generateNextUInt64() % maxCommandSize;
+    t.src = 2 * slot * region + rng.generateNextUInt64() % maxCommandSize;
+    t.dst = (2 * slot + 1) * region + rng.generateNextUInt64() % maxCommandSize;
+    t.data.resize(size);
+    for (uint64_t i = 0; i < size; i++)
+        t.data[i] = (uint8_t)rng.generateNextUInt32();
+
+    t.phase = Phase::Fill;
+    t.pending = 0;
+    commandsIssued++;
+
+    uint64_t offset = 0;
+    while (offset < size) {
+        uint64_t chunk = memLineSize - ((t.src + offset) % memLineSize);
+        if (chunk > size - offset) chunk = size - offset;
+        std::vector<uint8_t> data(t.data.begin() + offset, t.data.begin() + offset + chunk);
+        Interfaces::StandardMem::Write * wr = new Interfaces::StandardMem::Write(t.src + offset, chunk, data);
+        wr->setNoncacheable();
+        accesses[wr->getID()] = { slot, offset };
+        t.pending++;
+        memory->send(wr);
+        offset += chunk;
+    }
+    out.debug(_L3_, "DMACPU (%s) filling %" PRIu64 " bytes at 0x%" PRIx64 " for a copy to 0x%" PRIx64 "\n",
+            getName().c_str(), size, t.src, t.dst);
+}
+
+/* The copy is done; read the destination back */
+void DMACPU::startCheck(size_t slot) {
+    Transfer &t = transfers[slot];
+    t.phase = Phase::Check;
+    t.pending = 0;
+
+    uint64_t offset = 0;
+    while (offset < t.data.size()) {
+        uint64_t chunk = memLineSize - ((t.dst + offset) % memLineSize);
+        if (chunk > t.data.size() - offset) chunk = t.data.size() - offset;
+        Interfaces::StandardMem::Read * rd = new Interfaces::StandardMem::Read(t.dst + offset, chunk);
+        rd->setNoncacheable();
+        accesses[rd->getID()] = { slot, offset };
+        t.pending++;
+        memory->send(rd);
+        offset += chunk;
+    }
+}
+
+void DMACPU::handleDMA(SST::Event * ev) {
+    DMACommand * cmd = static_cast<DMACommand*>(ev);
+    size_t slot = cmd->src / (4 * maxCommandSize);
+    sst_assert(slot < transfers.size() && transfers[slot].phase == Phase::Copy && transfers[slot].src == cmd->src,
+            CALL_INFO, -1, "%s, Error: received a completed DMACommand from 0x%" PRIx64 " that was not sent\n", getName().c_str(), cmd->src);
+    delete cmd;
+    startCheck(slot);
+}
+
+// Memory response handler
+void DMACPU::handleEvent(Interfaces::StandardMem::Request * response) {
+    std::unordered_map<uint64_t, Access>::iterator it = accesses.find(response->getID());
+    sst_assert(it != accesses.end(), CALL_INFO, -1, "Received response but request not found! ID = %" PRIu64 "\n", response->getID());
+    Transfer &t = transfers[it->second.slot];
+    uint64_t offset = it->second.offset;
+    size_t slot = it->second.slot;
+    accesses.erase(it);
+
+    if (t.phase == Phase::Check) {
+        Interfaces::StandardMem::ReadResp * resp = static_cast<Interfaces::StandardMem::ReadResp*>(response);
+        for (size_t i = 0; i < resp->data.size(); i++) {
+            if (resp->data[i] != t.data[offset + i]) {
+                out.fatal(CALL_INFO, -1, "%s, Error: copy of %zu bytes from 0x%" PRIx64 " to 0x%" PRIx64 " has 0x%x at 0x%" PRIx64 ", expected 0x%x\n",
+                        getName().c_str(), t.data.size(), t.src, t.dst, resp->data[i], t.dst + offset + i, t.data[offset + i]);
+            }
+        }
+    }
+    delete response;
+
+    if (--t.pending != 0)
+        return;
+
+    if (t.phase == Phase::Fill) {
+        t.phase = Phase::Copy;
+        dmaLink->send(new DMACommand(this, t.dst, t.src, t.data.size()));
+    } else {
+        out.debug(_L3_, "DMACPU (%s) checked slot %zu, %zu bytes at 0x%" PRIx64 "\n", getName().c_str(), slot, t.data.size(), t.dst);
+        commandsChecked++;
+        bytesChecked += t.data.size();
+        t.phase = Phase::Idle;
+    }
+}
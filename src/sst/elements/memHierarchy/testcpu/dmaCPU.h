@@ -0,0 +1,116 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _DMACPU_H
+#define _DMACPU_H
+
+#include <sst/core/interfaces/stdMem.h>
+#include <sst/core/component.h>
+#include <sst/core/link.h>
+#include <sst/core/params.h>
+#include <sst/core/rng/marsaglia.h>
+
+#include <unordered_map>
+#include <vector>
+
+#include "sst/elements/memHierarchy/dmaEngine.h"
+
+namespace SST {
+namespace MemHierarchy {
+
+/*
+ * Self-checking test CPU for the DMAEngine
+ *
+ * Each transfer fills a source range with random bytes, asks the DMAEngine
+ * to copy it, then reads the destination back and compares. Up to
+ * 'maxOutstandingCommands' transfers are in progress at a time, each in its
+ * own pair of regions so the DMAEngine may overlap them. A mismatch is a
+ * fatal error. Memory accesses are noncacheable, like the DMAEngine's.
+ */
+class DMACPU : public Component {
+
+public:
+/* Element Library Info */
+    SST_ELI_REGISTER_COMPONENT(DMACPU, "memHierarchy", "DMACPU", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "Simple self-checking test CPU for the DMAEngine", COMPONENT_CATEGORY_PROCESSOR)
+
+    SST_ELI_DOCUMENT_PARAMS(
+            {"verbose",                 "(uint) Output verbosity", "0"},
+            {"rngseed",                 "(int) Set a seed for the random generator used to create transfers", "7"},
+            {"clock",                   "(string) Clock frequency in Hz or period in s", "1GHz"},
+            {"memLineSize",             "(uint) Largest read or write this CPU issues; accesses do not cross a 'memLineSize' boundary", "64"},
+            {"maxCommandSize",          "(uint) Largest transfer in bytes", "2048"},
+            {"maxOutstandingCommands",  "(uint) Maximum number of transfers in progress at a time", "4"},
+            {"commandsToIssue",         "(uint) Number of transfers to check before ending simulation", "64"} )
+
+    SST_ELI_DOCUMENT_PORTS( {"dma_link", "Connection to the DMAEngine's cmdLink", { "memHierarchy.DMACommand" } } )
+
+    SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS( {"memory", "Interface to memory", "SST::Interfaces::StandardMem"} )
+
+/* Begin class definition */
+    DMACPU(ComponentId_t id, Params& params);
+    ~DMACPU() {}
+    virtual void init(unsigned int phase);
+    virtual void finish();
+    virtual void setup() {}
+
+private:
+    enum class Phase { Idle, Fill, Copy, Check };
+
+    struct Transfer {
+        Phase phase;
+        Interfaces::StandardMem::Addr src;
+        Interfaces::StandardMem::Addr dst;
+        std::vector<uint8_t> data;  // Bytes written to src, expected at dst
+        uint32_t pending;           // Accesses in flight
+
+        Transfer() : phase(Phase::Idle), src(0), dst(0), pending(0) { }
+    };
+
+    /* An access in flight, by StandardMem request ID */
+    struct Access {
+        size_t slot;
+        uint64_t offset;
+    };
+
+    void handleEvent(Interfaces::StandardMem::Request *ev);
+    void handleDMA(SST::Event *ev);
+    virtual bool tick(Cycle_t);
+
+    void startTransfer(size_t slot);
+    void startCheck(size_t slot);
+
+    Output out;
+
+    // Parameters
+    uint64_t memLineSize;
+    uint64_t maxCommandSize;
+    uint64_t commandsToIssue;
+
+    // Local variables
+    Interfaces::StandardMem * memory;
+    Link * dmaLink;
+    std::vector<Transfer> transfers;                // One per slot
+    std::unordered_map<uint64_t, Access> accesses;
+    SST::RNG::MarsagliaRNG rng;
+
+    uint64_t commandsIssued;
+    uint64_t commandsChecked;
+    uint64_t bytesChecked;
+};
+
+}
+}
+#endif /* _DMACPU_H */
@@ -19,6 +19,8 @@
 
 #include <sst/core/interfaces/stringEvent.h>
 
+#include <algorithm>
+
 using namespace std;
 using namespace SST;
 using namespace SST::MemHierarchy;
@@ -73,6 +75,13 @@ ScratchCPU::ScratchCPU(ComponentId_t id, Params& params) : Component(id), rng(id
     // Initialize local variables
     timestamp = 0;
     num_events_issued = num_events_returned = 0;
+
+    checkData = params.find<bool>("check_data", false);
+    if (checkData)
+        image.resize(maxAddr, 0); // Scratch and memory start zeroed
+    blocked = nullptr;
+    dataSeq = 0;
+    bytesChecked = 0;
 }
 
 // SST Component functions
@@ -83,6 +92,8 @@ void ScratchCPU::init(unsigned int phase) {
 void ScratchCPU::finish() {
     out.output("ScratchCPU %s Finished after %" PRIu64 " issued memory events, %" PRIu64 " returned, %" PRIu64 " cycles\n",
             getName().c_str(), num_events_issued, num_events_returned, timestamp);
+    if (checkData)
+        out.output("ScratchCPU %s checked %" PRIu64 " bytes read\n", getName().c_str(), bytesChecked);
 }
 
 // Clock tick - create and send events here
@@ -97,6 +108,14 @@ bool ScratchCPU::tick(Cycle_t time) {
     } else {
         // Can we issue requests this cycle?
         if (requests.size() < reqQueueSize) {
+            if (blocked != nullptr) {
+                if (overlapsOutstanding(blocked)) return false;
+                issue(blocked);
+                blocked = nullptr;
+                if (requests.size() == reqQueueSize) return false;
+                if (num_events_issued == reqsToIssue) return false;
+            }
+
             // Determine how many requests to issue this cycle
             uint32_t reqCount = rng.generateNextUInt32() % (reqPerCycle + 1);
 
@@ -122,7 +141,9 @@ bool ScratchCPU::tick(Cycle_t time) {
                     uint32_t size = 1 << log2Size;
                     Interfaces::StandardMem::Addr addr = (Interfaces::StandardMem::Addr) (((rng.generateNextUInt64() % scratchSize) >> log2Size) << log2Size);
                     std::vector<uint8_t> data(size, 0);
+                    if (checkData) fillData(data);
                     req = new Interfaces::StandardMem::Write(addr, size, data);
+                    if (checkData) req->setNoncacheable(); // With no cache above it, the scratchpad writes only noncacheable Writes to scratch
                     out.debug(_L3_, "ScratchCPU (%s) sending Write. Addr: %" PRIu64 ", Size: %u\n\n", getName().c_str(), addr, size);
                 } else if (instType == 2) { // Scratch Get (copy from memory to scratch)
                     uint32_t log2Size = rng.generateNextUInt32() % (log2MemLineSize + 1);
@@ -161,18 +182,20 @@ bool ScratchCPU::tick(Cycle_t time) {
                     addr += scratchSize;
 
                     std::vector<uint8_t> data(size, 0);
+                    if (checkData) fillData(data);
 
                     req = new Interfaces::StandardMem::Write(addr, size, data);
                     req->setNoncacheable();
                     out.debug(_L3_, "ScratchCPU (%s) sending mem Write. Addr: %" PRIu64 ", Size: %u\n\n", getName().c_str(), addr, size);
                 }
 
-		// Send request
-		requests[req->getID()] = timestamp;
-                memory->send(req);
+                // Hold a request that overlaps an outstanding one so the expected data is known
+                if (checkData && overlapsOutstanding(req)) {
+                    blocked = req;
+                    break;
+                }
 
-                // Update counter info
-                num_events_issued++;
+                issue(req);
 
                 // Check if we can issue more
                 if (requests.size() == reqQueueSize) break;
@@ -183,11 +206,90 @@ bool ScratchCPU::tick(Cycle_t time) {
     return false;
 }
 
+// Send a request
+void ScratchCPU::issue(Interfaces::StandardMem::Request * req) {
+    requests[req->getID()] = timestamp;
+
+    if (checkData) {
+        Access access = getAccess(req);
+        accesses[req->getID()] = access;
+        // Nothing outstanding overlaps, so the result does not depend on the order requests complete in
+        if (Interfaces::StandardMem::Write * wr = dynamic_cast<Interfaces::StandardMem::Write*>(req)) {
+            std::copy(wr->data.begin(), wr->data.end(), image.begin() + access.writeAddr);
+        } else if (access.writeSize != 0) {
+            std::copy(image.begin() + access.readAddr, image.begin() + access.readAddr + access.readSize, image.begin() + access.writeAddr);
+        }
+    }
+
+    memory->send(req);
+
+    // Update counter info
+    num_events_issued++;
+}
+
+ScratchCPU::Access ScratchCPU::getAccess(Interfaces::StandardMem::Request * req) {
+    Access access = { 0, 0, 0, 0 };
+    if (Interfaces::StandardMem::Read * rd = dynamic_cast<Interfaces::StandardMem::Read*>(req)) {
+        access.readAddr = rd->pAddr;
+        access.readSize = rd->size;
+    } else if (Interfaces::StandardMem::Write * wr = dynamic_cast<Interfaces::StandardMem::Write*>(req)) {
+        access.writeAddr = wr->pAddr;
+        access.writeSize = wr->size;
+    } else if (Interfaces::StandardMem::MoveData * mv = dynamic_cast<Interfaces::StandardMem::MoveData*>(req)) {
+        access.readAddr = mv->pSrc;
+        access.readSize = mv->size;
+        access.writeAddr = mv->pDst;
+        access.writeSize = mv->size;
+    }
+    return access;
+}
+
+/* Whether 'req' writes bytes an outstanding request reads or writes, or reads bytes one writes */
+bool ScratchCPU::overlapsOutstanding(Interfaces::StandardMem::Request * req) {
+    Access access = getAccess(req);
+    for (std::unordered_map<uint64_t, Access>::iterator it = accesses.begin(); it != accesses.end(); it++) {
+        const Access &other = it->second;
+        if (access.writeSize != 0 && other.readSize != 0 && access.writeAddr < other.readAddr + other.readSize && other.readAddr < access.writeAddr + access.writeSize)
+            return true;
+        if (other.writeSize != 0 && access.writeSize != 0 && access.writeAddr < other.writeAddr + other.writeSize && other.writeAddr < access.writeAddr + access.writeSize)
+            return true;
+        if (other.writeSize != 0 && access.readSize != 0 && access.readAddr < other.writeAddr + other.writeSize && other.writeAddr < access.readAddr + access.readSize)
+            return true;
+    }
+    return false;
+}
+
+void ScratchCPU::fillData(std::vector<uint8_t> &data) {
+    for (size_t i = 0; i < data.size(); i++)
+        data[i] = (uint8_t)((dataSeq++ * 2654435761u) >> 24);
+}
+
+/* Compare a read's data with the bytes expected when it issued */
+void ScratchCPU::checkRead(Interfaces::StandardMem::Request * resp, const Access &access) {
+    Interfaces::StandardMem::ReadResp * rd = static_cast<Interfaces::StandardMem::ReadResp*>(resp);
+    if (rd->data.size() != access.readSize)
+        out.fatal(CALL_INFO, -1, "%s, Error: read of %" PRIu64 " bytes at 0x%" PRIx64 " returned %zu bytes\n",
+                getName().c_str(), access.readSize, access.readAddr, rd->data.size());
+    for (size_t i = 0; i < rd->data.size(); i++) {
+        if (rd->data[i] != image[access.readAddr + i]) {
+            out.fatal(CALL_INFO, -1, "%s, Error: read of %" PRIu64 " bytes at 0x%" PRIx64 " has 0x%x at 0x%" PRIx64 ", expected 0x%x\n",
+                    getName().c_str(), access.readSize, access.readAddr, rd->data[i], access.readAddr + i, image[access.readAddr + i]);
+        }
+    }
+    bytesChecked += rd->data.size();
+}
+
 // Memory response handler
 void ScratchCPU::handleEvent(Interfaces::StandardMem::Request * response) {
     std::unordered_map<uint64_t, SimTime_t>::iterator i = requests.find(response->getID());
     sst_assert(i != requests.end(), CALL_INFO, -1, "Received response but request not found! ID = %" PRIu64 "\n", response->getID());
     requests.erase(i);
+    if (checkData) {
+        std::unordered_map<uint64_t, Access>::iterator a = accesses.find(response->getID());
+        if (a->second.readSize != 0 && a->second.writeSize == 0)
+            checkRead(response, a->second);
+        accesses.erase(a);
+    }
     num_events_returned++;
     delete response;
 }
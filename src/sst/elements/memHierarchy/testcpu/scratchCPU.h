@@ -22,6 +22,7 @@
 #include <sst/core/rng/marsaglia.h>
 
 #include <unordered_map>
+#include <vector>
 
 using namespace std;
 
@@ -44,7 +45,8 @@ public:
             {"clock",                   "(string) Clock frequency in Hz or period in s", "1GHz"},
             {"maxOutstandingRequests",  "(uint) Maximum number of requests outstanding at a time", "8"},
             {"maxRequestsPerCycle",     "(uint) Maximum number of requests to issue per cycle", "2"},
-            {"reqsToIssue",             "(uint) Number of requests to issue before ending simulation", "1000"} )
+            {"reqsToIssue",             "(uint) Number of requests to issue before ending simulation", "1000"},
+            {"check_data",              "(bool) Write varied data and check every read against the expected contents of scratch and memory. Requests that overlap an outstanding one wait for it.", "false"} )
 
     SST_ELI_DOCUMENT_PORTS( {"mem_link", "Connection to cache", { "memHierarchy.MemEventBase" } } )
 
@@ -60,6 +62,17 @@ public:
 private:
     void handleEvent( Interfaces::StandardMem::Request *ev );
     virtual bool tick( Cycle_t );
+    void issue( Interfaces::StandardMem::Request *req );
+
+    /* check_data: bytes a request reads and writes. Moves read their source and write their destination. */
+    struct Access {
+        Interfaces::StandardMem::Addr readAddr, writeAddr;
+        uint64_t readSize, writeSize;
+    };
+    Access getAccess( Interfaces::StandardMem::Request *req );
+    bool overlapsOutstanding( Interfaces::StandardMem::Request *req );
+    void fillData( std::vector<uint8_t> &data );
+    void checkRead( Interfaces::StandardMem::Request *resp, const Access &access );
 
     Output out;
 
@@ -85,6 +98,14 @@ private:
     uint64_t timestamp;     // current timestamp
     uint64_t num_events_issued;      // number of events that have been issued at a given time
     uint64_t num_events_returned;    // number of events that have returned
+
+    // Data checking
+    bool checkData;
+    std::vector<uint8_t> image;     // Expected contents of scratch and memory, updated as requests issue
+    std::unordered_map<uint64_t, Access> accesses; // Bytes touched by each outstanding request
+    Interfaces::StandardMem::Request * blocked; // Request waiting for an overlapping one to finish
+    uint32_t dataSeq;               // Varies the data written
+    uint64_t bytesChecked;
 };
 
 }
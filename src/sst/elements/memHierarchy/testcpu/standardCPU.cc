@@ -77,13 +77,14 @@ standardCPU::standardCPU(ComponentId_t id, Params& params) :
     unsigned flushinvf = params.find<unsigned>("flushinv_freq", 0);
     unsigned customf = params.find<unsigned>("custom_freq", 0);
     unsigned llscf = params.find<unsigned>("llsc_freq", 0);
+    unsigned lockf = params.find<unsigned>("lock_freq", 0);
     unsigned mmiof = params.find<unsigned>("mmio_freq", 0);
 
     if (mmiof != 0 && mmioAddr == 0) {
         out.fatal(CALL_INFO, -1, "%s, Error: mmio_freq is > 0 but no mmio device has been specified via mmio_addr\n", getName().c_str());
     }
 
-    high_mark = readf + writef + flushf + flushinvf + customf + llscf + mmiof; /* Numbers less than this and above other marks indicate read */
+    high_mark = readf + writef + flushf + flushinvf + customf + llscf + lockf + mmiof; /* Numbers less than this and above other marks indicate read */
     if (high_mark == 0) {
         out.fatal(CALL_INFO, -1, "%s, Error: The input doesn't indicate a frequency for any command type.\n", getName().c_str());
     }
@@ -92,7 +93,8 @@ standardCPU::standardCPU(ComponentId_t id, Params& params) :
     flushinv_mark = flush_mark + flushinvf; /* Numbers less than this indicate flush-inv */
     custom_mark = flushinv_mark + customf; /* Numbers less than this indicate flush */
     llsc_mark = custom_mark + llscf; /* Numbers less than this indicate LL-SC */
-    mmio_mark = llsc_mark + mmiof; /* Numbers less than this indicate MMIO read or write */
+    lock_mark = llsc_mark + lockf; /* Numbers less than this indicate ReadLock-WriteUnlock */
+    mmio_mark = lock_mark + mmiof; /* Numbers less than this indicate MMIO read or write */
 
     noncacheableRangeStart = params.find<uint64_t>("noncacheableRangeStart", 0);
     noncacheableRangeEnd = params.find<uint64_t>("noncacheableRangeEnd", 0);
@@ -142,6 +144,16 @@ standardCPU::standardCPU(ComponentId_t id, Params& params) :
         num_llsc_success = registerStatistic<uint64_t>("llsc_success");
     }
     ll_issued = false;
+
+    if (lockf != 0) {
+        num_locks_issued = registerStatistic<uint64_t>("locks");
+    }
+    lock_issued = false;
+
+    check_data = params.find<bool>("check_data", false);
+    if (check_data) {
+        num_reads_checked = registerStatistic<uint64_t>("reads_checked");
+    }
 }
 
 void standardCPU::init(unsigned int phase)
@@ -166,12 +178,39 @@ void standardCPU::handleEvent(StandardMem::Request *req)
         SimTime_t et = getCurrentSimTime() - i->second.first;
         if (i->second.second == "StoreConditional" && req->getSuccess())
             num_llsc_success->addData(1);
+        if (check_data) {
+            std::map<Req::id_t, std::pair<Addr, bool>>::iterator c = checks.find(req->getID());
+            if (c != checks.end()) {
+                if (i->second.second == "StoreConditional") {
+                    if (req->getSuccess())
+                        written.insert(c->second.first);
+                } else {
+                    checkRead(req, c->second.first, c->second.second);
+                }
+                checks.erase(c);
+            }
+        }
         requests.erase(i);
     }
 
     delete req;
 }
 
+/* Every write stores the word's own address, so a read returns that or, if no write has reached the word yet, 0 */
+void standardCPU::checkRead(StandardMem::Request* resp, Addr addr, bool mustBeWritten) {
+    StandardMem::ReadResp* rd = static_cast<StandardMem::ReadResp*>(resp);
+    uint32_t value = 0;
+    for (size_t i = 0; i < rd->data.size(); i++)
+        value = (value << 8) | rd->data[i];
+
+    if (rd->data.size() != 4 || (value != (uint32_t)addr && (mustBeWritten || value != 0))) {
+        out.fatal(CALL_INFO, -1, "%s, Error: read of %zu bytes at 0x%" PRIx64 " returned 0x%" PRIx32 ", expected 0x%" PRIx32 "%s\n",
+                getName().c_str(), rd->data.size(), addr, value, (uint32_t)addr, mustBeWritten ? "" : " or 0");
+    }
+    if (mustBeWritten)
+        num_reads_checked->addData(1);
+}
+
 
 bool standardCPU::clockTic( Cycle_t )
 {
@@ -210,7 +249,10 @@ bool standardCPU::clockTic( Cycle_t )
                 if (ll_issued) {
                     req = createSC();
                     cmdString = "StoreConditional";
-                }else if (instNum < write_mark) {
+                } else if (lock_issued) {
+                    req = createWriteUnlock();
+                    cmdString = "WriteUnlock";
+                } else if (instNum < write_mark) {
                     req = createWrite(addr);
                     cmdString = "Write";
                 } else if (instNum < flush_mark) {
@@ -223,6 +265,13 @@ bool standardCPU::clockTic( Cycle_t )
                 } else if (instNum < llsc_mark) {
                     req = createLL(addr);
                     cmdString = "LoadLink";
+                } else if (instNum < lock_mark) {
+                    if (ops > 1) { // Leave an op for the unlock so the line is not left locked
+                        req = createReadLock(addr);
+                        cmdString = "ReadLock";
+                    } else {
+                        req = createRead(addr);
+                    }
                 } else if (instNum < mmio_mark) {
                     bool opType = rng.generateNextUInt32() % 2;
                     if (opType) {
@@ -271,6 +320,8 @@ StandardMem::Request* standardCPU::createWrite(Addr addr) {
 
     StandardMem::Request* req = new Interfaces::StandardMem::Write(addr, data.size(), data);
     num_writes_issued->addData(1);
+    if (check_data)
+        written.insert(addr);
     if (addr >= noncacheableRangeStart && addr < noncacheableRangeEnd) {
         req->setNoncacheable();
         noncacheableWrites->addData(1);
@@ -283,6 +334,8 @@ StandardMem::Request* standardCPU::createRead(Addr addr) {
     addr = ((addr % maxAddr)>>2) << 2;
     StandardMem::Request* req = new Interfaces::StandardMem::Read(addr, 4);
     num_reads_issued->addData(1);
+    if (check_data)
+        checks[req->getID()] = std::make_pair(addr, written.count(addr) != 0);
     if (addr >= noncacheableRangeStart && addr < noncacheableRangeEnd) {
         req->setNoncacheable();
         noncacheableReads->addData(1);
@@ -324,6 +377,8 @@ StandardMem::Request* standardCPU::createLL(Addr addr) {
     addr = (addr >> 2) << 2;
 
     StandardMem::Request* req = new Interfaces::StandardMem::LoadLink(addr, 4);
+    if (check_data)
+        checks[req->getID()] = std::make_pair(addr, written.count(addr) != 0);
     // Set these so we issue a matching sc 
     ll_addr = addr;
     ll_issued = true;
@@ -340,12 +395,49 @@ StandardMem::Request* standardCPU::createSC() {
     data[2] = (ll_addr >>  8) & 0xff;
     data[3] = (ll_addr >>  0) & 0xff;
     StandardMem::Request* req = new Interfaces::StandardMem::StoreConditional(ll_addr, data.size(), data);
+    if (check_data) // Only a successful SC writes the word
+        checks[req->getID()] = std::make_pair(ll_addr, false);
     num_llsc_issued->addData(1);
     ll_issued = false;
     out.verbose(CALL_INFO, 2, 0, "%s: %" PRIu64 " Issued StoreConditional for address 0x%" PRIx64 "\n", getName().c_str(), ops, ll_addr);
     return req;
 }
 
+StandardMem::Request* standardCPU::createReadLock(Addr addr) {
+    // Addr needs to be a cacheable range
+    Addr cacheableSize = maxAddr + 1 - noncacheableRangeEnd + noncacheableRangeStart;
+    addr = (addr % (cacheableSize >> 2)) << 2;
+    if (addr >= noncacheableRangeStart && addr < noncacheableRangeEnd) {
+        addr += noncacheableRangeEnd;
+    }
+
+    StandardMem::Request* req = new Interfaces::StandardMem::ReadLock(addr, 4);
+    if (check_data)
+        checks[req->getID()] = std::make_pair(addr, written.count(addr) != 0);
+    // Set these so we issue a matching unlock
+    lock_addr = addr;
+    lock_issued = true;
+
+    out.verbose(CALL_INFO, 2, 0, "%s: %" PRIu64 " Issued ReadLock for address 0x%" PRIx64 "\n", getName().c_str(), ops, addr);
+    return req;
+}
+
+StandardMem::Request* standardCPU::createWriteUnlock() {
+    std::vector<uint8_t> data;
+    data.resize(4);
+    data[0] = (lock_addr >> 24) & 0xff;
+    data[1] = (lock_addr >> 16) & 0xff;
+    data[2] = (lock_addr >>  8) & 0xff;
+    data[3] = (lock_addr >>  0) & 0xff;
+    StandardMem::Request* req = new Interfaces::StandardMem::WriteUnlock(lock_addr, data.size(), data);
+    if (check_data)
+        written.insert(lock_addr);
+    num_locks_issued->addData(1);
+    lock_issued = false;
+    out.verbose(CALL_INFO, 2, 0, "%s: %" PRIu64 " Issued WriteUnlock for address 0x%" PRIx64 "\n", getName().c_str(), ops, lock_addr);
+    return req;
+}
+
 StandardMem::Request* standardCPU::createMMIOWrite() {
     bool posted = rng.generateNextUInt32() % 2;
     int32_t payload = rng.generateNextInt32();
@@ -20,6 +20,7 @@
 #define __STDC_FORMAT_MACROS
 #endif
 #include <inttypes.h>
+#include <set>
 
 #include <sst/core/interfaces/stdMem.h>
 #include <sst/core/event.h>
@@ -59,10 +60,12 @@ public:
         {"flushinv_freq",           "(uint) Relative flush-inv frequency", "0"},
         {"custom_freq",             "(uint) Relative custom op frequency", "0"},
         {"llsc_freq",               "(uint) Relative LLSC frequency", "0"},
+        {"lock_freq",               "(uint) Relative frequency of ReadLock-WriteUnlock pairs", "0"},
         {"mmio_addr",               "(uint) Base address of the test MMIO component. 0 means not present.", "0"},
         {"noncacheableRangeStart",  "(uint) Beginning of range of addresses that are noncacheable.", "0x0"},
         {"noncacheableRangeEnd",    "(uint) End of range of addresses that are noncacheable.", "0x0"},
-        {"addressoffset",           "(uint) Apply an offset to a calculated address to check for non-alignment issues", "0"} )
+        {"addressoffset",           "(uint) Apply an offset to a calculated address to check for non-alignment issues", "0"},
+        {"check_data",              "(bool) Check read data. Writes store each word's own address, so a read must return 0 or its address, and its address once this CPU has written the word.", "false"} )
 
     SST_ELI_DOCUMENT_STATISTICS( 
         {"pendCycle", "Number of pending requests per cycle", "count", 1},
@@ -73,8 +76,10 @@ public:
         {"customReqs", "Number of custom requests issued", "count", 1},
         {"llsc", "Number of LL-SC pairs issued", "count", 1},
         {"llsc_success", "Number of successful LLSC pairs issued", "count", 1},
+        {"locks", "Number of ReadLock-WriteUnlock pairs issued", "count", 1},
         {"readNoncache", "Number of noncacheable reads issued", "count", 1},
-        {"writeNoncache", "Number of noncacheable writes issued", "count", 1}
+        {"writeNoncache", "Number of noncacheable writes issued", "count", 1},
+        {"reads_checked", "Number of reads checked against an earlier write by this CPU (check_data)", "count", 1}
     )
 
     /* Slot for a memory interface. This must be user defined (aka defined in Python config) */
@@ -104,6 +109,7 @@ private:
     unsigned flushinv_mark;
     unsigned custom_mark;
     unsigned llsc_mark;
+    unsigned lock_mark;
     unsigned mmio_mark;
     uint32_t maxReqsPerIssue;
     uint64_t noncacheableRangeStart, noncacheableRangeEnd, noncacheableSize;
@@ -116,14 +122,24 @@ private:
     Statistic<uint64_t>* num_custom_issued;
     Statistic<uint64_t>* num_llsc_issued;
     Statistic<uint64_t>* num_llsc_success;
+    Statistic<uint64_t>* num_locks_issued;
     Statistic<uint64_t>* noncacheableReads;
     Statistic<uint64_t>* noncacheableWrites;
+    Statistic<uint64_t>* num_reads_checked;
 
     bool ll_issued;
     Interfaces::StandardMem::Addr ll_addr;
+    bool lock_issued;
+    Interfaces::StandardMem::Addr lock_addr;
 
     std::map<Interfaces::StandardMem::Request::id_t, std::pair<SimTime_t, std::string>> requests;
 
+    /* check_data: words this CPU has written and, per outstanding read or SC, its address and whether it follows a write */
+    bool check_data;
+    std::set<Interfaces::StandardMem::Addr> written;
+    std::map<Interfaces::StandardMem::Request::id_t, std::pair<Interfaces::StandardMem::Addr, bool>> checks;
+    void checkRead(Interfaces::StandardMem::Request* resp, Interfaces::StandardMem::Addr addr, bool mustBeWritten);
+
     Interfaces::StandardMem *memory;
 
     SST::RNG::MarsagliaRNG rng;
@@ -138,6 +154,8 @@ private:
     Interfaces::StandardMem::Request* createFlushInv(Addr addr);
     Interfaces::StandardMem::Request* createLL(Addr addr);
     Interfaces::StandardMem::Request* createSC();
+    Interfaces::StandardMem::Request* createReadLock(Addr addr);
+    Interfaces::StandardMem::Request* createWriteUnlock();
     Interfaces::StandardMem::Request* createMMIOWrite();
     Interfaces::StandardMem::Request* createMMIORead();
 };
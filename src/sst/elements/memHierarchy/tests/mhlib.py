@@ -4,6 +4,7 @@ componentlist = (
     "memHierarchy.Cache",
     "memHierarchy.CoherentMemController",
     "memHierarchy.DirectoryController",
+    "memHierarchy.MemCacheController",
     "memHierarchy.MemController",
     "memHierarchy.ScratchCPU",
     "memHierarchy.Scratchpad",
@@ -0,0 +1,100 @@
+import sst
+import argparse
+from mhlib import componentlist
+
+# Test the analyticMem backend. Cores with small caches send nearly every
+# access to memory, whose backend is chosen with '--model':
+#   simpleMem   fixed latency, for comparison
+#   closed      analyticMem without a table (closed-form model)
+#   table       analyticMem with tools/analyticMem/example.table
+#   calibrate   analyticMem measuring a simpleMem backend, writing '--samples'
+#   sst testAnalyticMem.py --model-options="--model=closed --cores=4 --mem_freq=1"
+# testsuite_default_memHierarchy_selfcheck.py runs each model at two loads.
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--model", help="simpleMem, closed, table, or calibrate", default="closed")
+parser.add_argument("--cores", help="number of cores", default="1")
+parser.add_argument("--mem_freq", help="cycles between each core's requests", default="64")
+parser.add_argument("--samples", help="calibrate: file to write samples to", default="analyticMem.samples")
+args = parser.parse_args()
+
+DEBUG_MEM = 0
+
+cores = int(args.cores)
+
+bus = sst.Component("bus", "memHierarchy.Bus")
+bus.addParams({ "bus_frequency" : "1GHz" })
+
+for i in range(0, cores):
+    cpu = sst.Component("core" + str(i), "memHierarchy.standardCPU")
+    cpu.addParams({
+        "memFreq" : args.mem_freq,
+        "memSize" : "1MiB",
+        "verbose" : 0,
+        "clock" : "1GHz",
+        "rngseed" : 101 + 200 * i,
+        "maxOutstanding" : 16,
+        "opCount" : 4000,
+        "reqsPerIssue" : 4,
+        "write_freq" : 25,
+        "read_freq" : 75,
+    })
+    iface = cpu.setSubComponent("memory", "memHierarchy.standardInterface")
+
+    # Small cache so that nearly every request reaches memory
+    l1cache = sst.Component("l1cache" + str(i), "memHierarchy.Cache")
+    l1cache.addParams({
+        "access_latency_cycles" : "1",
+        "cache_frequency" : "1GHz",
+        "replacement_policy" : "lru",
+        "coherence_protocol" : "none",
+        "associativity" : "1",
+        "cache_line_size" : "64",
+        "cache_size" : "1KiB",
+        "L1" : "1",
+    })
+
+    link_cpu_l1 = sst.Link("link_cpu_l1_" + str(i))
+    link_cpu_l1.connect( (iface, "port", "500ps"), (l1cache, "high_network_0", "500ps") )
+    link_l1_bus = sst.Link("link_l1_bus_" + str(i))
+    link_l1_bus.connect( (l1cache, "low_network_0", "500ps"), (bus, "high_network_" + str(i), "500ps") )
+
+memctrl = sst.Component("memory", "memHierarchy.MemController")
+memctrl.addParams({
+    "debug" : DEBUG_MEM,
+    "debug_level" : 10,
+    "clock" : "1GHz",
+    "backing" : "none",
+    "addr_range_end" : 512*1024*1024-1,
+})
+
+analytic_params = {
+    "mem_size" : "512MiB",
+    "peak_bandwidth" : "12.8GB/s",
+    "window" : "1us",
+    "banks" : "8",
+    "row_size" : "8KiB",
+}
+if args.model == "simpleMem":
+    memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+    memory.addParams({ "access_time" : "60ns", "mem_size" : "512MiB" })
+else:
+    memory = memctrl.setSubComponent("backend", "memHierarchy.analyticMem")
+    memory.addParams(analytic_params)
+    if args.model == "table":
+        memory.addParams({ "table" : "../tools/analyticMem/example.table" })
+    elif args.model == "calibrate":
+        memory.addParams({ "calibrate" : True, "calibration_output" : args.samples })
+        detailed = memory.setSubComponent("backend", "memHierarchy.simpleMem")
+        detailed.addParams({ "access_time" : "60ns", "mem_size" : "512MiB" })
+    elif args.model != "closed":
+        raise ValueError("Unknown --model '{0}'".format(args.model))
+
+# Enable statistics
+sst.setStatisticLoadLevel(7)
+sst.setStatisticOutput("sst.statOutputConsole")
+for a in componentlist:
+    sst.enableAllStatisticsForComponentType(a)
+
+link_bus_mem = sst.Link("link_bus_mem")
+link_bus_mem.connect( (bus, "low_network_0", "500ps"), (memctrl, "direct_link", "500ps") )
@@ -0,0 +1,75 @@
+import sst
+import argparse
+from mhlib import componentlist
+
+# Test the DMAEngine. A DMACPU fills source ranges, has the DMAEngine copy
+# them, and reads the destinations back; a wrong byte is a fatal error.
+# Both share a bus to one memory controller, so accesses need no cache.
+#   sst testDMAEngine.py --model-options="--pipelined=1 --max_request_size=256"
+# testsuite_default_memHierarchy_selfcheck.py runs the engine's modes.
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--pipelined", help="process non-overlapping commands at the same time (0 or 1)", default="0")
+parser.add_argument("--max_outstanding", help="reads and writes the DMAEngine keeps in flight", default="16")
+parser.add_argument("--max_request_size", help="largest DMAEngine request in bytes, 0 for the line size", default="0")
+args = parser.parse_args()
+
+DEBUG_DMA = 0
+DEBUG_MEM = 0
+
+cpu = sst.Component("core", "memHierarchy.DMACPU")
+cpu.addParams({
+    "clock" : "2GHz",
+    "rngseed" : 11,
+    "memLineSize" : 64,
+    "maxCommandSize" : 2048,
+    "maxOutstandingCommands" : 4,
+    "commandsToIssue" : 64,
+    "verbose" : 1,
+})
+cpu_iface = cpu.setSubComponent("memory", "memHierarchy.standardInterface")
+
+dma = sst.Component("dma", "memHierarchy.DMAEngine")
+dma.addParams({
+    "debug" : DEBUG_DMA,
+    "debug_level" : 10,
+    "clockRate" : "2GHz",
+    "printStats" : 1,
+    "pipelined" : args.pipelined,
+    "max_outstanding" : args.max_outstanding,
+    "max_request_size" : args.max_request_size,
+    "requests_per_cycle" : 2,
+})
+dma_iface = dma.setSubComponent("memory", "memHierarchy.standardInterface")
+
+bus = sst.Component("bus", "memHierarchy.Bus")
+bus.addParams({ "bus_frequency" : "2GHz" })
+
+memctrl = sst.Component("memory", "memHierarchy.MemController")
+memctrl.addParams({
+    "debug" : DEBUG_MEM,
+    "debug_level" : 10,
+    "clock" : "1GHz",
+    "addr_range_end" : 512*1024*1024-1,
+})
+memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+memory.addParams({
+    "access_time" : "100ns",
+    "mem_size" : "512MiB"
+})
+
+# Enable statistics
+sst.setStatisticLoadLevel(7)
+sst.setStatisticOutput("sst.statOutputConsole")
+for a in componentlist:
+    sst.enableAllStatisticsForComponentType(a)
+
+# Define the simulation links
+link_cpu_dma = sst.Link("link_cpu_dma")
+link_cpu_dma.connect( (cpu, "dma_link", "500ps"), (dma, "cmdLink", "500ps") )
+link_cpu_bus = sst.Link("link_cpu_bus")
+link_cpu_bus.connect( (cpu_iface, "port", "500ps"), (bus, "high_network_0", "500ps") )
+link_dma_bus = sst.Link("link_dma_bus")
+link_dma_bus.connect( (dma_iface, "port", "500ps"), (bus, "high_network_1", "500ps") )
+link_bus_mem = sst.Link("link_bus_mem")
+link_bus_mem.connect( (bus, "low_network_0", "500ps"), (memctrl, "direct_link", "500ps") )
@@ -0,0 +1,99 @@
+import sst
+import argparse
+from mhlib import componentlist
+
+# Test the flight recorder (flightRecorder.h). The caches and the memory
+# controller keep their last 'flight_size' events and write them to
+# '<flight_dir>/<name>.flight' at the end of simulation. The directory must
+# exist. Decode the dumps with sst-memh-flightdecode.
+#   sst testFlightRecorder.py --model-options="--flight_dir=a --flight_size=64"
+# testsuite_default_memHierarchy_selfcheck.py decodes and checks the dumps.
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--flight_dir", help="directory to write the flight recorder dumps to", default=".")
+parser.add_argument("--flight_size", help="events each flight recorder keeps", default="64")
+args = parser.parse_args()
+
+verbose = 2
+cores = 2
+
+flight_params = {
+    "flight_recorder_size" : args.flight_size,
+    "flight_recorder_dir" : args.flight_dir,
+    "flight_recorder_dump_at_finish" : 1,
+}
+
+bus = sst.Component("bus", "memHierarchy.Bus")
+bus.addParams({ "bus_frequency" : "2GHz" })
+
+for i in range(0, cores):
+    cpu = sst.Component("core" + str(i), "memHierarchy.standardCPU")
+    cpu.addParams({
+        "memFreq" : 2,
+        "memSize" : "64KiB",
+        "clock" : "2GHz",
+        "rngseed" : 5 + i,
+        "maxOutstanding" : 16,
+        "opCount" : 2000,
+        "write_freq" : 40,
+        "read_freq" : 60,
+    })
+    iface = cpu.setSubComponent("memory", "memHierarchy.standardInterface")
+
+    l1cache = sst.Component("l1cache" + str(i), "memHierarchy.Cache")
+    l1cache.addParams({
+        "access_latency_cycles" : "2",
+        "cache_frequency" : "2GHz",
+        "replacement_policy" : "lru",
+        "coherence_protocol" : "MESI",
+        "associativity" : "4",
+        "cache_line_size" : "64",
+        "cache_size" : "2KiB",
+        "L1" : "1",
+        "verbose" : verbose,
+    })
+    l1cache.addParams(flight_params)
+
+    link_cpu_l1 = sst.Link("link_cpu_l1_" + str(i))
+    link_cpu_l1.connect( (iface, "port", "500ps"), (l1cache, "high_network_0", "500ps") )
+    link_l1_bus = sst.Link("link_l1_bus_" + str(i))
+    link_l1_bus.connect( (l1cache, "low_network_0", "500ps"), (bus, "high_network_" + str(i), "500ps") )
+
+l2cache = sst.Component("l2cache", "memHierarchy.Cache")
+l2cache.addParams({
+    "access_latency_cycles" : "8",
+    "mshr_latency_cycles" : 2,
+    "cache_frequency" : "2GHz",
+    "replacement_policy" : "lru",
+    "coherence_protocol" : "MESI",
+    "associativity" : "8",
+    "cache_line_size" : "64",
+    "cache_size" : "16KiB",
+    "verbose" : verbose,
+})
+l2cache.addParams(flight_params)
+
+memctrl = sst.Component("memory", "memHierarchy.MemController")
+memctrl.addParams({
+    "clock" : "1GHz",
+    "verbose" : verbose,
+    "addr_range_end" : 512*1024*1024-1,
+})
+memctrl.addParams(flight_params)
+
+memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+memory.addParams({
+    "access_time" : "100ns",
+    "mem_size" : "512MiB"
+})
+
+link_bus_l2 = sst.Link("link_bus_l2")
+link_bus_l2.connect( (bus, "low_network_0", "500ps"), (l2cache, "high_network_0", "500ps") )
+link_l2_mem = sst.Link("link_l2_mem")
+link_l2_mem.connect( (l2cache, "low_network_0", "500ps"), (memctrl, "direct_link", "500ps") )
+
+# Enable statistics
+sst.setStatisticLoadLevel(7)
+sst.setStatisticOutput("sst.statOutputConsole")
+for a in componentlist:
+    sst.enableAllStatisticsForComponentType(a)
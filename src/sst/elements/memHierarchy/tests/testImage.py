@@ -0,0 +1,114 @@
+import sst
+import argparse
+from mhlib import componentlist
+
+# Test saving and restoring memory images and cache checkpoints.
+#   sst testImage.py --model-options="--backing=mmap --save_dir=a"
+#   sst testImage.py --model-options="--backing=mmap --load_dir=a --save_dir=b"
+# The memory controller writes '<save_dir>/memory.img' at the end of
+# simulation; with 'load_dir' it is restored from there before the run
+# starts. With '--checkpoint=1' each cache also saves and restores
+# '<dir>/<cache>.ckpt'. Directories must exist.
+# '--lock_freq' mixes in ReadLock-WriteUnlock pairs, which the L1s see as GetSX.
+# testsuite_default_memHierarchy_selfcheck.py runs a save and then a restore.
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--backing", help="memory backing store: mmap or malloc", default="mmap")
+parser.add_argument("--save_dir", help="directory to save the memory image to", default="")
+parser.add_argument("--load_dir", help="directory to restore the memory image from", default="")
+parser.add_argument("--checkpoint", help="also save/restore cache contents (0 or 1)", default="0")
+parser.add_argument("--line_size", help="cache line size", default="64")
+parser.add_argument("--read_only", help="issue only reads, so memory contents do not change (0 or 1)", default="0")
+parser.add_argument("--mem_size", help="range of addresses the CPUs access", default="64KiB")
+parser.add_argument("--lock_freq", help="relative frequency of ReadLock-WriteUnlock pairs", default="0")
+args = parser.parse_args()
+
+verbose = 2
+cores = 2
+
+ckpt_params = {}
+if args.checkpoint == "1":
+    if args.save_dir != "":
+        ckpt_params["checkpoint_save_dir"] = args.save_dir
+    if args.load_dir != "":
+        ckpt_params["checkpoint_load_dir"] = args.load_dir
+
+bus = sst.Component("bus", "memHierarchy.Bus")
+bus.addParams({ "bus_frequency" : "2GHz" })
+
+for i in range(0, cores):
+    cpu = sst.Component("core" + str(i), "memHierarchy.standardCPU")
+    cpu.addParams({
+        "memFreq" : 2,
+        "memSize" : args.mem_size,
+        "clock" : "2GHz",
+        "rngseed" : 7 + i,
+        "maxOutstanding" : 16,
+        "opCount" : 5000,
+        "write_freq" : 0 if args.read_only == "1" else 40,
+        "read_freq" : 100 if args.read_only == "1" else 60,
+        "lock_freq" : args.lock_freq,
+    })
+    iface = cpu.setSubComponent("memory", "memHierarchy.standardInterface")
+
+    l1cache = sst.Component("l1cache" + str(i), "memHierarchy.Cache")
+    l1cache.addParams({
+        "access_latency_cycles" : "2",
+        "cache_frequency" : "2GHz",
+        "replacement_policy" : "lru",
+        "coherence_protocol" : "MESI",
+        "associativity" : "4",
+        "cache_line_size" : args.line_size,
+        "cache_size" : "2KiB",
+        "L1" : "1",
+        "verbose" : verbose,
+    })
+    l1cache.addParams(ckpt_params)
+
+    link_cpu_l1 = sst.Link("link_cpu_l1_" + str(i))
+    link_cpu_l1.connect( (iface, "port", "500ps"), (l1cache, "high_network_0", "500ps") )
+    link_l1_bus = sst.Link("link_l1_bus_" + str(i))
+    link_l1_bus.connect( (l1cache, "low_network_0", "500ps"), (bus, "high_network_" + str(i), "500ps") )
+
+l2cache = sst.Component("l2cache", "memHierarchy.Cache")
+l2cache.addParams({
+    "access_latency_cycles" : "8",
+    "mshr_latency_cycles" : 2,
+    "cache_frequency" : "2GHz",
+    "replacement_policy" : "lru",
+    "coherence_protocol" : "MESI",
+    "associativity" : "8",
+    "cache_line_size" : args.line_size,
+    "cache_size" : "16KiB",
+    "verbose" : verbose,
+})
+l2cache.addParams(ckpt_params)
+
+memctrl = sst.Component("memory", "memHierarchy.MemController")
+memctrl.addParams({
+    "clock" : "1GHz",
+    "verbose" : verbose,
+    "addr_range_end" : 512*1024*1024-1,
+    "backing" : args.backing,
+})
+if args.save_dir != "":
+    memctrl.addParams({ "backing_image_out" : args.save_dir + "/memory.img" })
+if args.load_dir != "":
+    memctrl.addParams({ "backing_image_in" : args.load_dir + "/memory.img" })
+
+memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+memory.addParams({
+    "access_time" : "100ns",
+    "mem_size" : "512MiB"
+})
+
+link_bus_l2 = sst.Link("link_bus_l2")
+link_bus_l2.connect( (bus, "low_network_0", "500ps"), (l2cache, "high_network_0", "500ps") )
+link_l2_mem = sst.Link("link_l2_mem")
+link_l2_mem.connect( (l2cache, "low_network_0", "500ps"), (memctrl, "direct_link", "500ps") )
+
+# Enable statistics
+sst.setStatisticLoadLevel(7)
+sst.setStatisticOutput("sst.statOutputConsole")
+for a in componentlist:
+    sst.enableAllStatisticsForComponentType(a)
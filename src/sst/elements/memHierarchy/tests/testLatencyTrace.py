@@ -0,0 +1,126 @@
+import sst
+import argparse
+from mhlib import componentlist
+
+# Test per-request latency tracing (latencyTrace.h). Two cores with private
+# L1s share a directory on a network, so traced requests pass through caches,
+# MemNICs, the directory and the memory backend. Each L1 traces 1 in every
+# 'trace_rate' requests and writes '<trace_dir>/<cache>.trace'. The trace
+# directory must exist. Run with several ranks to trace across ranks.
+#   sst testLatencyTrace.py --model-options="--trace_rate=8 --trace_dir=a"
+# testsuite_default_memHierarchy_selfcheck.py compares traced and untraced runs
+# and decodes the trace files.
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--trace_rate", help="trace 1 in every N requests each L1 receives, 0 to not trace", default="0")
+parser.add_argument("--trace_dir", help="directory to write trace files to, empty for statistics only", default="")
+args = parser.parse_args()
+
+DEBUG_L1 = 0
+DEBUG_DIR = 0
+DEBUG_MEM = 0
+
+cores = 2
+
+chiprtr = sst.Component("network", "merlin.hr_router")
+chiprtr.addParams({
+      "xbar_bw" : "1GB/s",
+      "link_bw" : "1GB/s",
+      "input_buf_size" : "1KB",
+      "num_ports" : str(cores + 1),
+      "flit_size" : "72B",
+      "output_buf_size" : "1KB",
+      "id" : "0",
+      "topology" : "merlin.singlerouter"
+})
+chiprtr.setSubComponent("topology","merlin.singlerouter")
+
+for i in range(0, cores):
+    cpu = sst.Component("core" + str(i), "memHierarchy.standardCPU")
+    cpu.addParams({
+        "memFreq" : 2,
+        "memSize" : "16KiB",
+        "verbose" : 0,
+        "clock" : "2GHz",
+        "rngseed" : 3 + i,
+        "maxOutstanding" : 16,
+        "opCount" : 5000,
+        "write_freq" : 40,
+        "read_freq" : 60,
+    })
+    iface = cpu.setSubComponent("memory", "memHierarchy.standardInterface")
+
+    l1cache = sst.Component("l1cache" + str(i), "memHierarchy.Cache")
+    l1cache.addParams({
+        "access_latency_cycles" : "2",
+        "cache_frequency" : "2GHz",
+        "replacement_policy" : "lru",
+        "coherence_protocol" : "MESI",
+        "associativity" : "4",
+        "cache_line_size" : "64",
+        "cache_size" : "4KiB",
+        "L1" : "1",
+        "debug" : DEBUG_L1,
+        "debug_level" : 10,
+        "verbose" : 2,
+        "latency_trace_rate" : args.trace_rate,
+    })
+    if args.trace_dir != "":
+        l1cache.addParams({ "latency_trace_file" : args.trace_dir + "/l1cache" + str(i) + ".trace" })
+    l1ToC = l1cache.setSubComponent("cpulink", "memHierarchy.MemLink")
+    l1NIC = l1cache.setSubComponent("memlink", "memHierarchy.MemNIC")
+    l1NIC.addParams({
+        "network_bw" : "25GB/s",
+        "group" : 1,
+        "verbose" : 2,
+    })
+
+    link_cpu_l1 = sst.Link("link_cpu_l1_" + str(i))
+    link_cpu_l1.connect( (iface, "port", "500ps"), (l1ToC, "port", "500ps") )
+    link_l1_net = sst.Link("link_l1_net_" + str(i))
+    link_l1_net.connect( (l1NIC, "port", "1000ps"), (chiprtr, "port" + str(i + 1), "1000ps") )
+
+dirctrl = sst.Component("directory", "memHierarchy.DirectoryController")
+dirctrl.addParams({
+      "coherence_protocol" : "MESI",
+      "debug" : DEBUG_DIR,
+      "debug_level" : "10",
+      "entry_cache_size" : "16384",
+      "addr_range_end" : "0x1F000000",
+      "addr_range_start" : "0x0",
+      "verbose" : 2,
+})
+dirNIC = dirctrl.setSubComponent("cpulink", "memHierarchy.MemNIC")
+dirNIC.addParams({
+      "network_bw" : "25GB/s",
+      "group" : 2,
+      "verbose" : 2,
+})
+dirMemLink = dirctrl.setSubComponent("memlink", "memHierarchy.MemLink")
+
+memctrl = sst.Component("memory", "memHierarchy.MemController")
+memctrl.addParams({
+    "debug" : DEBUG_MEM,
+    "debug_level" : 10,
+    "clock" : "1GHz",
+    "verbose" : 2,
+    "addr_range_end" : 512*1024*1024-1,
+})
+memToDir = memctrl.setSubComponent("cpulink", "memHierarchy.MemLink")
+memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+memory.addParams({
+      "access_time" : "100 ns",
+      "mem_size" : "512MiB"
+})
+
+# Enable statistics
+sst.setStatisticLoadLevel(7)
+sst.setStatisticOutput("sst.statOutputConsole")
+for a in componentlist:
+    sst.enableAllStatisticsForComponentType(a)
+
+# Define the simulation links
+link_dir_net = sst.Link("link_dir_net")
+link_dir_net.connect( (chiprtr, "port0", "1000ps"), (dirNIC, "port", "1000ps") )
+link_dir_mem = sst.Link("link_dir_mem")
+link_dir_mem.connect( (dirMemLink, "port", "1000ps"), (memToDir, "port", "1000ps") )
@@ -0,0 +1,163 @@
+import sst
+import argparse
+from mhlib import componentlist
+
+# Test the data path of memory caches (MemCacheController). Two cores with
+# private L1s share a directory that fronts 'num_caches' line-interleaved
+# memory caches; misses and dirty victims in the memory caches go to a
+# remote memory. All share one network. The memory caches are much smaller
+# than the range the cores access, so lines are evicted, written back and
+# fetched again. The cores check every read (standardCPU 'check_data').
+#   sst testMemoryCacheData.py --model-options="--organization=set_assoc --num_caches=2"
+# testsuite_default_memHierarchy_selfcheck.py runs each organization.
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--organization", help="memory cache organization: direct, alloy or set_assoc", default="direct")
+parser.add_argument("--num_caches", help="number of memory caches", default="2")
+parser.add_argument("--cache_size", help="capacity of each memory cache", default="8KiB")
+args = parser.parse_args()
+
+DEBUG_L1 = 0
+DEBUG_DIR = 0
+DEBUG_MEMCACHE = 0
+DEBUG_MEM = 0
+
+cores = 2
+num_caches = int(args.num_caches)
+
+chiprtr = sst.Component("network", "merlin.hr_router")
+chiprtr.addParams({
+      "xbar_bw" : "1GB/s",
+      "link_bw" : "1GB/s",
+      "input_buf_size" : "1KB",
+      "num_ports" : str(cores + num_caches + 2),
+      "flit_size" : "72B",
+      "output_buf_size" : "1KB",
+      "id" : "0",
+      "topology" : "merlin.singlerouter"
+})
+chiprtr.setSubComponent("topology","merlin.singlerouter")
+
+port = 0
+for i in range(0, cores):
+    cpu = sst.Component("core" + str(i), "memHierarchy.standardCPU")
+    cpu.addParams({
+        "memFreq" : 2,
+        "memSize" : "64KiB",
+        "verbose" : 0,
+        "clock" : "2GHz",
+        "rngseed" : 5 + i,
+        "maxOutstanding" : 16,
+        "opCount" : 5000,
+        "write_freq" : 40,
+        "read_freq" : 60,
+        "check_data" : 1,
+    })
+    iface = cpu.setSubComponent("memory", "memHierarchy.standardInterface")
+
+    l1cache = sst.Component("l1cache" + str(i), "memHierarchy.Cache")
+    l1cache.addParams({
+        "access_latency_cycles" : "2",
+        "cache_frequency" : "2GHz",
+        "replacement_policy" : "lru",
+        "coherence_protocol" : "MESI",
+        "associativity" : "4",
+        "cache_line_size" : "64",
+        "cache_size" : "4KiB",
+        "L1" : "1",
+        "debug" : DEBUG_L1,
+        "debug_level" : 10,
+        "verbose" : 2,
+    })
+    l1ToC = l1cache.setSubComponent("cpulink", "memHierarchy.MemLink")
+    l1NIC = l1cache.setSubComponent("memlink", "memHierarchy.MemNIC")
+    l1NIC.addParams({
+        "network_bw" : "25GB/s",
+        "group" : 1,
+        "verbose" : 2,
+    })
+
+    link_cpu_l1 = sst.Link("link_cpu_l1_" + str(i))
+    link_cpu_l1.connect( (iface, "port", "500ps"), (l1ToC, "port", "500ps") )
+    link_l1_net = sst.Link("link_l1_net_" + str(i))
+    link_l1_net.connect( (l1NIC, "port", "1000ps"), (chiprtr, "port" + str(port), "1000ps") )
+    port = port + 1
+
+# The directory has no memlink, so it reaches the memory caches over the network
+dirctrl = sst.Component("directory", "memHierarchy.DirectoryController")
+dirctrl.addParams({
+      "coherence_protocol" : "MESI",
+      "debug" : DEBUG_DIR,
+      "debug_level" : "10",
+      "entry_cache_size" : "16384",
+      "addr_range_end" : "0x1F000000",
+      "addr_range_start" : "0x0",
+      "verbose" : 2,
+})
+dirNIC = dirctrl.setSubComponent("cpulink", "memHierarchy.MemNIC")
+dirNIC.addParams({
+      "network_bw" : "25GB/s",
+      "group" : 2,
+      "verbose" : 2,
+})
+link_dir_net = sst.Link("link_dir_net")
+link_dir_net.connect( (dirNIC, "port", "1000ps"), (chiprtr, "port" + str(port), "1000ps") )
+port = port + 1
+
+# Memory cache 'n' holds lines n, n + num_caches, ... and sends its misses and writebacks to the remote memory
+for i in range(0, num_caches):
+    memcache = sst.Component("memcache" + str(i), "memHierarchy.MemCacheController")
+    memcache.addParams({
+        "clock" : "1GHz",
+        "num_caches" : num_caches,
+        "cache_num" : i,
+        "cache_line_size" : 64,
+        "organization" : args.organization,
+        "backing" : "mmap",
+        "debug" : DEBUG_MEMCACHE,
+        "debug_level" : 10,
+        "verbose" : 2,
+    })
+    memcacheBackend = memcache.setSubComponent("backend", "memHierarchy.simpleMem")
+    memcacheBackend.addParams({
+        "access_time" : "20ns",
+        "mem_size" : args.cache_size,
+    })
+    memcacheNIC = memcache.setSubComponent("cpulink", "memHierarchy.MemNIC")
+    memcacheNIC.addParams({
+        "network_bw" : "25GB/s",
+        "group" : 3,
+        "verbose" : 2,
+    })
+    link_memcache_net = sst.Link("link_memcache_net_" + str(i))
+    link_memcache_net.connect( (memcacheNIC, "port", "1000ps"), (chiprtr, "port" + str(port), "1000ps") )
+    port = port + 1
+
+memctrl = sst.Component("memory", "memHierarchy.MemController")
+memctrl.addParams({
+    "debug" : DEBUG_MEM,
+    "debug_level" : 10,
+    "clock" : "1GHz",
+    "verbose" : 2,
+    "addr_range_end" : 512*1024*1024-1,
+    "backing" : "mmap",
+})
+memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+memory.addParams({
+      "access_time" : "100 ns",
+      "mem_size" : "512MiB"
+})
+memNIC = memctrl.setSubComponent("cpulink", "memHierarchy.MemNIC")
+memNIC.addParams({
+      "network_bw" : "25GB/s",
+      "group" : 4,
+      "verbose" : 2,
+})
+link_mem_net = sst.Link("link_mem_net")
+link_mem_net.connect( (memNIC, "port", "1000ps"), (chiprtr, "port" + str(port), "1000ps") )
+
+# Enable statistics
+sst.setStatisticLoadLevel(7)
+sst.setStatisticOutput("sst.statOutputConsole")
+for a in componentlist:
+    sst.enableAllStatisticsForComponentType(a)
@@ -0,0 +1,76 @@
+import sst
+import argparse
+from mhlib import componentlist
+
+# Test streamed scratchpad moves. Remote memory lines are 8 scratch lines, so
+# Gets and Puts span several scratch lines and 'move_stream_lines' splits them.
+# The CPU writes varied data and checks every read of scratch and memory.
+#   sst testScratchStream.py --model-options="--move_stream_lines=2 --move_window=2"
+# testsuite_default_memHierarchy_selfcheck.py compares streamed and unstreamed moves.
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--move_stream_lines", help="scratch lines per streamed remote request, 0 to not stream", default="0")
+parser.add_argument("--move_window", help="remote reads outstanding per streamed Get, 0 for unlimited", default="8")
+args = parser.parse_args()
+
+DEBUG_SCRATCH = 0
+DEBUG_MEM = 0
+
+# Define the simulation components
+comp_cpu = sst.Component("core", "memHierarchy.ScratchCPU")
+comp_cpu.addParams({
+    "scratchSize" : 4096,   # 4K scratch
+    "maxAddr" : 65536,      # 60K mem
+    "scratchLineSize" : 64,
+    "memLineSize" : 512,
+    "clock" : "1GHz",
+    "maxOutstandingRequests" : 16,
+    "maxRequestsPerCycle" : 2,
+    "reqsToIssue" : 1000,
+    "check_data" : 1,
+    "verbose" : 1
+})
+iface = comp_cpu.setSubComponent("memory", "memHierarchy.standardInterface")
+comp_scratch = sst.Component("scratch", "memHierarchy.Scratchpad")
+comp_scratch.addParams({
+    "debug" : DEBUG_SCRATCH,
+    "debug_level" : 10,
+    "clock" : "2GHz",
+    "size" : "4KiB",
+    "scratch_line_size" : 64,
+    "memory_line_size" : 512,
+    "backing" : "mmap",
+    "move_stream_lines" : args.move_stream_lines,
+    "move_window" : args.move_window,
+})
+scratch_conv = comp_scratch.setSubComponent("backendConvertor", "memHierarchy.simpleMemScratchBackendConvertor")
+scratch_back = scratch_conv.setSubComponent("backend", "memHierarchy.simpleMem")
+scratch_back.addParams({
+    "access_time" : "10ns",
+})
+
+memctrl = sst.Component("memory", "memHierarchy.MemController")
+memctrl.addParams({
+      "debug" : DEBUG_MEM,
+      "debug_level" : 10,
+      "clock" : "1GHz",
+      "addr_range_start" : 0,
+})
+memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+memory.addParams({
+    "access_time" : "100 ns",
+    "mem_size" : "512MiB"
+})
+
+# Enable statistics
+sst.setStatisticLoadLevel(7)
+sst.setStatisticOutput("sst.statOutputConsole")
+for a in componentlist:
+    sst.enableAllStatisticsForComponentType(a)
+
+
+# Define the simulation links
+link_cpu_scratch = sst.Link("link_cpu_scratch")
+link_cpu_scratch.connect( (iface, "port", "1000ps"), (comp_scratch, "cpu", "1000ps") )
+link_scratch_mem = sst.Link("link_scratch_mem")
+link_scratch_mem.connect( (comp_scratch, "memory", "100ps"), (memctrl, "direct_link", "100ps") )
@@ -0,0 +1,100 @@
+import sst
+import argparse
+from mhlib import componentlist
+
+# Test functional warmup. The warmup mode is selected on the command line:
+#   sst testWarmup.py --model-options="--warmup=roi"
+#   none: no warmup
+#   time: the L1s, L2, and memory leave warmup at 'warmup_end'
+#   roi:  the L1s start the region of interest when they see address 0
+# testsuite_default_memHierarchy_selfcheck.py compares the modes against each other.
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--warmup", help="warmup mode: none, time, or roi", default="time")
+args = parser.parse_args()
+
+verbose = 2
+cores = 2
+
+warmup_params = {}
+if args.warmup != "none":
+    warmup_params["warmup"] = 1
+if args.warmup == "time":
+    warmup_params["warmup_end"] = "2us"
+
+bus = sst.Component("bus", "memHierarchy.Bus")
+bus.addParams({ "bus_frequency" : "2GHz" })
+
+for i in range(0, cores):
+    cpu = sst.Component("core" + str(i), "memHierarchy.standardCPU")
+    cpu.addParams({
+        "memFreq" : 2,
+        "memSize" : "4KiB",     # Small, so address 0 is requested early in 'roi' mode
+        "clock" : "2GHz",
+        "rngseed" : 7 + i,
+        "maxOutstanding" : 16,
+        "opCount" : 10000,
+        "write_freq" : 30,
+        "read_freq" : 70,
+    })
+    iface = cpu.setSubComponent("memory", "memHierarchy.standardInterface")
+
+    l1cache = sst.Component("l1cache" + str(i), "memHierarchy.Cache")
+    l1cache.addParams({
+        "access_latency_cycles" : "2",
+        "cache_frequency" : "2GHz",
+        "replacement_policy" : "lru",
+        "coherence_protocol" : "MESI",
+        "associativity" : "4",
+        "cache_line_size" : "64",
+        "cache_size" : "1KiB",
+        "L1" : "1",
+        "verbose" : verbose,
+    })
+    l1cache.addParams(warmup_params)
+    if args.warmup == "roi":
+        l1cache.addParams({ "warmup_roi_addr" : 0 })
+
+    link_cpu_l1 = sst.Link("link_cpu_l1_" + str(i))
+    link_cpu_l1.connect( (iface, "port", "500ps"), (l1cache, "high_network_0", "500ps") )
+    link_l1_bus = sst.Link("link_l1_bus_" + str(i))
+    link_l1_bus.connect( (l1cache, "low_network_0", "500ps"), (bus, "high_network_" + str(i), "500ps") )
+
+l2cache = sst.Component("l2cache", "memHierarchy.Cache")
+l2cache.addParams({
+    "access_latency_cycles" : "8",
+    "mshr_latency_cycles" : 2,
+    "cache_frequency" : "2GHz",
+    "replacement_policy" : "lru",
+    "coherence_protocol" : "MESI",
+    "associativity" : "8",
+    "cache_line_size" : "64",
+    "cache_size" : "2KiB",
+    "verbose" : verbose,
+})
+l2cache.addParams(warmup_params)
+
+memctrl = sst.Component("memory", "memHierarchy.MemController")
+memctrl.addParams({
+    "clock" : "1GHz",
+    "verbose" : verbose,
+    "addr_range_end" : 512*1024*1024-1,
+})
+memctrl.addParams(warmup_params)
+
+memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+memory.addParams({
+    "access_time" : "100ns",
+    "mem_size" : "512MiB"
+})
+
+link_bus_l2 = sst.Link("link_bus_l2")
+link_bus_l2.connect( (bus, "low_network_0", "500ps"), (l2cache, "high_network_0", "500ps") )
+link_l2_mem = sst.Link("link_l2_mem")
+link_l2_mem.connect( (l2cache, "low_network_0", "500ps"), (memctrl, "direct_link", "500ps") )
+
+# Enable statistics
+sst.setStatisticLoadLevel(7)
+sst.setStatisticOutput("sst.statOutputConsole")
+for a in componentlist:
+    sst.enableAllStatisticsForComponentType(a)
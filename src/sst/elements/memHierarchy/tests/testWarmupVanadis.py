@@ -0,0 +1,169 @@
+import sst
+import argparse
+import struct
+from mhlib import componentlist
+
+# Test a core starting the region of interest. A Vanadis core runs a MIPS
+# program with every memHierarchy component in functional warmup; when the
+# core retires the instruction at 'roi_start_retire_address' the ROI starts
+# and the components leave warmup.
+#   sst testWarmupVanadis.py --model-options="--exe=<path to hello-world>"
+# The ROI address defaults to the program's entry point.
+# testsuite_default_memHierarchy_selfcheck.py runs this with vanadis/tests/small/basic-io/hello-world.
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--exe", help="MIPS (mipsel) executable to run", required=True)
+parser.add_argument("--roi_addr", help="start the ROI when this instruction retires, default is the entry point", default="")
+args = parser.parse_args()
+
+def entry_point(path):
+    with open(path, 'rb') as fp:
+        header = fp.read(32)
+    if header[0:4] != b"\x7fELF":
+        raise ValueError("{0} is not an ELF file".format(path))
+    endian = "<" if header[5] == 1 else ">"
+    if header[4] == 1:
+        return struct.unpack_from(endian + "I", header, 24)[0]
+    return struct.unpack_from(endian + "Q", header, 24)[0]
+
+roi_addr = int(args.roi_addr, 0) if args.roi_addr != "" else entry_point(args.exe)
+exe_name = args.exe.split("/")[-1]
+
+verbose = 2
+clock = "2GHz"
+
+warmup_params = { "warmup" : 1, "verbose" : verbose }
+
+sst.setProgramOption("timebase", "1ps")
+
+cpu = sst.Component("v0", "vanadis.dbg_VanadisCPU")
+cpu.addParams({
+    "clock" : clock,
+    "verbose" : 1,
+    "dbg_mask" : 0,
+    "physical_fp_registers" : 168,
+    "physical_int_registers" : 180,
+    "reorder_slots" : 64,
+    "decodes_per_cycle" : 4,
+    "issues_per_cycle" : 4,
+    "retires_per_cycle" : 4,
+    "roi_start_retire_address" : roi_addr,
+})
+decoder = cpu.setSubComponent("decoder0", "vanadis.VanadisMIPSDecoder")
+os_hdlr = decoder.setSubComponent("os_handler", "vanadis.VanadisMIPSOSHandler")
+decoder.setSubComponent("branch_unit", "vanadis.VanadisBasicBranchUnit").addParams({ "branch_entries" : 32 })
+decoder.addParams({
+    "uop_cache_entries" : 1536,
+    "predecode_cache_entries" : 4
+})
+os_hdlr.addParams({ "brk_zero_memory" : "yes" })
+
+icache_if = cpu.setSubComponent("mem_interface_inst", "memHierarchy.standardInterface")
+lsq = cpu.setSubComponent("lsq", "vanadis.VanadisBasicLoadStoreQueue")
+lsq.addParams({
+    "address_mask" : 0xFFFFFFFF,
+    "load_store_entries" : 32
+})
+dcache_if = lsq.setSubComponent("memory_interface", "memHierarchy.standardInterface")
+
+node_os = sst.Component("os", "vanadis.VanadisNodeOS")
+node_os.addParams({
+    "cores" : 1,
+    "heap_start" : 512 * 1024 * 1024,
+    "heap_end" : (2 * 1024 * 1024 * 1024) - 4096,
+    "page_size" : 4096,
+    "executable" : args.exe,
+    "app.arg0" : exe_name,
+})
+os_if = node_os.setSubComponent("mem_interface", "memHierarchy.standardInterface")
+
+l1_params = {
+    "access_latency_cycles" : "2",
+    "cache_frequency" : clock,
+    "replacement_policy" : "lru",
+    "coherence_protocol" : "MESI",
+    "associativity" : "8",
+    "cache_line_size" : "64",
+    "cache_size" : "32KiB",
+    "L1" : "1",
+}
+
+l1d = sst.Component("cpu0.l1dcache", "memHierarchy.Cache")
+l1d.addParams(l1_params)
+l1d.addParams(warmup_params)
+l1i = sst.Component("cpu0.l1icache", "memHierarchy.Cache")
+l1i.addParams(l1_params)
+l1i.addParams(warmup_params)
+os_l1d = sst.Component("os.l1dcache", "memHierarchy.Cache")
+os_l1d.addParams(l1_params)
+os_l1d.addParams(warmup_params)
+
+bus = sst.Component("bus", "memHierarchy.Bus")
+bus.addParams({ "bus_frequency" : clock })
+
+l2cache = sst.Component("l2cache", "memHierarchy.Cache")
+l2cache.addParams({
+    "access_latency_cycles" : "14",
+    "cache_frequency" : clock,
+    "replacement_policy" : "lru",
+    "coherence_protocol" : "MESI",
+    "associativity" : "16",
+    "cache_line_size" : "64",
+    "cache_size" : "256KiB",
+})
+l2cache.addParams(warmup_params)
+
+dirctrl = sst.Component("dirctrl", "memHierarchy.DirectoryController")
+dirctrl.addParams({
+    "coherence_protocol" : "MESI",
+    "entry_cache_size" : "1024",
+    "addr_range_start" : "0x0",
+    "addr_range_end" : "0xFFFFFFFF",
+})
+dirctrl.addParams(warmup_params)
+dir_cpulink = dirctrl.setSubComponent("cpulink", "memHierarchy.MemLink")
+dir_memlink = dirctrl.setSubComponent("memlink", "memHierarchy.MemLink")
+
+memctrl = sst.Component("memory", "memHierarchy.MemController")
+memctrl.addParams({
+    "clock" : clock,
+    "backing" : "malloc",
+    "initBacking" : 1,
+    "addr_range_start" : 0,
+    "addr_range_end" : 0xffffffff,
+})
+memctrl.addParams(warmup_params)
+mem_cpulink = memctrl.setSubComponent("cpulink", "memHierarchy.MemLink")
+memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+memory.addParams({
+    "mem_size" : "4GiB",
+    "access_time" : "50ns"
+})
+
+# Enable statistics
+sst.setStatisticLoadLevel(7)
+sst.setStatisticOutput("sst.statOutputConsole")
+for a in componentlist:
+    sst.enableAllStatisticsForComponentType(a)
+
+# Define the simulation links
+link_cpu_l1d = sst.Link("link_cpu_l1d")
+link_cpu_l1d.connect( (dcache_if, "port", "1ns"), (l1d, "high_network_0", "1ns") )
+link_cpu_l1i = sst.Link("link_cpu_l1i")
+link_cpu_l1i.connect( (icache_if, "port", "1ns"), (l1i, "high_network_0", "1ns") )
+link_os_l1d = sst.Link("link_os_l1d")
+link_os_l1d.connect( (os_if, "port", "1ns"), (os_l1d, "high_network_0", "1ns") )
+link_l1d_bus = sst.Link("link_l1d_bus")
+link_l1d_bus.connect( (l1d, "low_network_0", "1ns"), (bus, "high_network_0", "1ns") )
+link_l1i_bus = sst.Link("link_l1i_bus")
+link_l1i_bus.connect( (l1i, "low_network_0", "1ns"), (bus, "high_network_1", "1ns") )
+link_os_bus = sst.Link("link_os_bus")
+link_os_bus.connect( (os_l1d, "low_network_0", "1ns"), (bus, "high_network_2", "1ns") )
+link_bus_l2 = sst.Link("link_bus_l2")
+link_bus_l2.connect( (bus, "low_network_0", "1ns"), (l2cache, "high_network_0", "1ns") )
+link_l2_dir = sst.Link("link_l2_dir")
+link_l2_dir.connect( (l2cache, "low_network_0", "1ns"), (dir_cpulink, "port", "1ns") )
+link_dir_mem = sst.Link("link_dir_mem")
+link_dir_mem.connect( (dir_memlink, "port", "1ns"), (mem_cpulink, "port", "1ns") )
+link_core_os = sst.Link("link_core_os")
+link_core_os.connect( (cpu, "os_link", "5ns"), (node_os, "core0", "5ns") )
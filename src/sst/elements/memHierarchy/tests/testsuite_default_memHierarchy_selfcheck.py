@@ -0,0 +1,515 @@
+# -*- coding: utf-8 -*-
+
+from sst_unittest import *
+from sst_unittest_support import *
+import os.path
+import re
+import struct
+import time
+
+################################################################################
+# Self-checking memHierarchy tests
+#
+# These tests do not diff against a reference file. Each one runs one or more
+# configurations and checks properties of the output that must hold regardless
+# of timing: the simulation completes, every request a memory controller
+# received was answered, and configurations that issue the same traffic issue
+# the same number of requests.
+################################################################################
+
+module_init = 0
+module_sema = threading.Semaphore()
+
+def initializeTestModule_SingleInstance(class_inst):
+    global module_init
+    global module_sema
+
+    module_sema.acquire()
+    if module_init != 1:
+        try:
+            # Put your single instance Init Code Here
+            pass
+        except:
+            pass
+        module_init = 1
+    module_sema.release()
+
+################################################################################
+################################################################################
+################################################################################
+
+class testcase_memHierarchy_selfcheck(SSTTestCase):
+
+    def initializeClass(self, testName):
+        super(type(self), self).initializeClass(testName)
+        # Put test based setup code here. it is called before testing starts
+        # NOTE: This method is called once for every test
+
+    def setUp(self):
+        super(type(self), self).setUp()
+        initializeTestModule_SingleInstance(self)
+        # Put test based setup code here. it is called once before every test
+
+    def tearDown(self):
+        # Put test based teardown code here. it is called once after every test
+        super(type(self), self).tearDown()
+
+#####
+
+    # Every scheduler sees the same CPU traffic and must answer all of it
+    def test_selfcheck_TimingDRAM_schedulers(self):
+        runs = {}
+        for sched in [ "fifo", "frfcfs", "bliss" ]:
+            runs[sched] = self.selfcheck_Run("BackendTimingDRAM-sched", sched, "--scheduler={0}".format(sched))[0]
+        for sched in [ "frfcfs", "bliss" ]:
+            self.selfcheck_SameIssued(runs["fifo"], runs[sched], "fifo", sched)
+
+    # Row hit cap and idle close change the command order, not the result
+    def test_selfcheck_TimingDRAM_schedulerOptions(self):
+        base = self.selfcheck_Run("BackendTimingDRAM-sched", "base", "--scheduler=frfcfs")[0]
+        capped = self.selfcheck_Run("BackendTimingDRAM-sched", "rowHitCap", "--scheduler=frfcfs --row_hit_cap=1 --idle_close=20")[0]
+        self.selfcheck_SameIssued(base, capped, "frfcfs", "frfcfs/row_hit_cap=1/idle_close=20")
+
+    # Warmup changes timing only. Every warmed component leaves warmup, and the
+    # first one to do so starts a second statistics output period.
+    def test_selfcheck_Warmup(self):
+        base = self.selfcheck_Run("Warmup", "none", "--warmup=none")[0]
+        for mode in [ "time", "roi" ]:
+            stats, output = self.selfcheck_Run("Warmup", mode, "--warmup={0}".format(mode))
+            self.selfcheck_SameIssued(base, stats, "no warmup", "warmup=" + mode)
+            ended = output.count("Notice: warmup ended")
+            self.assertEqual(ended, 4, "warmup={0}: expected 4 components to leave warmup, {1} did".format(mode, ended))
+            periods = output.count(" core0.reads : ")
+            self.assertEqual(periods, 2, "warmup={0}: expected 2 statistics output periods, found {1}".format(mode, periods))
+
+    # A Vanadis core starts the ROI when it retires 'roi_start_retire_address',
+    # here the program's entry point. Every warmed component must leave
+    # warmup, and the first one to do so starts a second statistics period.
+    def test_selfcheck_WarmupVanadis(self):
+        exe = os.path.abspath(os.path.join(self.get_testsuite_dir(), "../../vanadis/tests/small/basic-io/hello-world/mipsel/hello-world"))
+        if not os.path.isfile(exe):
+            self.skipTest("Vanadis test program {0} not found".format(exe))
+        # Vanadis writes the program's stdout/stderr to the working directory
+        rundir = os.path.join(self.get_test_output_run_dir(), "warmup_vanadis")
+        os.makedirs(rundir, exist_ok=True)
+        output = self.selfcheck_Run("WarmupVanadis", "roi", "--exe={0}".format(exe), cwd=rundir)[1]
+        self.assertTrue("starting the region of interest" in output, "Vanadis did not start the region of interest")
+        self.assertFalse("memHierarchy is not loaded" in output, "Vanadis could not find memHierarchy's ROI flag")
+        ended = output.count("Notice: warmup ended")
+        self.assertEqual(ended, 6, "expected 6 components to leave warmup, {0} did".format(ended))
+        periods = output.count(" l2cache.TotalEventsReceived : ")
+        self.assertEqual(periods, 2, "expected 2 statistics output periods, found {0}".format(periods))
+
+    # The DMACPU checks every copied byte itself. Each mode copies the same
+    # bytes; coalescing lines into larger requests must issue fewer of them.
+    def test_selfcheck_DMAEngine(self):
+        modes = [ ("serial", "--pipelined=0"),
+                  ("pipelined", "--pipelined=1"),
+                  ("coalesced", "--pipelined=1 --max_request_size=256 --max_outstanding=4") ]
+        requests = {}
+        for name, options in modes:
+            output = self.selfcheck_Run("DMAEngine", name, options)[1]
+            checked = re.search(r"DMACPU core checked (\d+) transfers, (\d+) bytes", output)
+            self.assertTrue(checked is not None, "{0}: DMACPU did not report".format(name))
+            self.assertEqual(int(checked.group(1)), 64, "{0}: DMACPU checked {1} of 64 transfers".format(name, checked.group(1)))
+            moved = re.search(r"Bytes Transferred:\s+(\d+)", output)
+            self.assertTrue(moved is not None, "{0}: DMAEngine did not report".format(name))
+            self.assertEqual(moved.group(1), checked.group(2),
+                    "{0}: DMAEngine transferred {1} bytes, DMACPU checked {2}".format(name, moved.group(1), checked.group(2)))
+            requests[name] = int(re.search(r"# Requests:\s+(\d+)", output).group(1))
+        self.assertEqual(requests["serial"], requests["pipelined"], "Pipelining changed the number of DMA requests")
+        self.assertLess(requests["coalesced"], requests["pipelined"], "max_request_size=256 did not coalesce any DMA requests")
+
+    # Streaming a move splits it into smaller remote requests. Every request
+    # the ScratchCPU issues must still be received and answered, and the
+    # ScratchCPU checks the data of every read, so bytes a Get or Put moves to
+    # the wrong place or drops fail the run.
+    def test_selfcheck_ScratchStream(self):
+        modes = [ ("whole", "--move_stream_lines=0"),
+                  ("lines1", "--move_stream_lines=1 --move_window=0"),
+                  ("lines2window2", "--move_stream_lines=2 --move_window=2") ]
+        for name, options in modes:
+            stats, output = self.selfcheck_Run("ScratchStream", name, options)
+            done = re.search(r"ScratchCPU core Finished after (\d+) issued memory events, (\d+) returned", output)
+            self.assertTrue(done is not None, "{0}: ScratchCPU did not report".format(name))
+            self.assertEqual(done.group(1), "1000", "{0}: ScratchCPU issued {1} of 1000 requests".format(name, done.group(1)))
+            self.assertEqual(done.group(2), "1000", "{0}: ScratchCPU received {1} of 1000 responses".format(name, done.group(2)))
+            received = sum([ v[0] for k, v in stats.items() if k[0] == "scratch" and k[1].startswith("request_received_") ])
+            self.assertEqual(received, 1000, "{0}: scratchpad received {1} of 1000 requests".format(name, received))
+            checked = re.search(r"ScratchCPU core checked (\d+) bytes read", output)
+            self.assertTrue(checked is not None and int(checked.group(1)) > 0, "{0}: ScratchCPU checked no data".format(name))
+
+    # Save a memory image, then restore it into a run that only reads and
+    # save again. standardCPU writes each word's own address into it, so the
+    # first image must hold only such words, and since nothing is written
+    # after the restore the second image must hold the first's bytes exactly,
+    # including chunks that were restored but never touched.
+    def test_selfcheck_Image(self):
+        outdir = self.get_test_output_run_dir()
+        for backing in [ "mmap", "malloc" ]:
+            saved = os.path.join(outdir, "image_{0}_saved".format(backing))
+            resaved = os.path.join(outdir, "image_{0}_resaved".format(backing))
+            for d in [ saved, resaved ]:
+                os.makedirs(d, exist_ok=True)
+            self.selfcheck_Run("Image", backing + "_save", "--backing={0} --save_dir={1}".format(backing, saved))
+            self.selfcheck_Run("Image", backing + "_restore",
+                    "--backing={0} --read_only=1 --load_dir={1} --save_dir={2}".format(backing, saved, resaved))
+
+            chunkSize, chunks = self._parse_image(os.path.join(saved, "memory.img"))
+            written = 0
+            for addr, data in chunks.items():
+                for off in range(0, chunkSize, 4):
+                    word = struct.unpack(">I", data[off:off + 4])[0]
+                    if word != 0:
+                        self.assertEqual(word, (addr + off) & 0xffffffff,
+                                "{0}: saved image holds 0x{1:x} at 0x{2:x}, not a value the CPUs wrote".format(backing, word, addr + off))
+                        written += 1
+            self.assertTrue(written > 0, "{0}: saved image holds none of the CPUs' writes".format(backing))
+
+            reChunkSize, rechunks = self._parse_image(os.path.join(resaved, "memory.img"))
+            self.assertEqual(chunkSize, reChunkSize, "{0}: image chunk size changed from {1} to {2}".format(backing, chunkSize, reChunkSize))
+            for addr, data in chunks.items():
+                self.assertTrue(addr in rechunks, "{0}: chunk 0x{1:x} was restored but not saved again".format(backing, addr))
+                self.assertTrue(data == rechunks[addr], "{0}: chunk 0x{1:x} differs after restoring and saving again".format(backing, addr))
+
+    # ReadLock-WriteUnlock pairs reach the L1s as GetSX. The CPUs share a
+    # small address range so that the L1s see GetSX in I, S and M. Every word
+    # in memory must hold zero or the value the CPUs write there (its address).
+    def test_selfcheck_Locks(self):
+        saved = os.path.join(self.get_test_output_run_dir(), "locks_saved")
+        os.makedirs(saved, exist_ok=True)
+        stats = self.selfcheck_Run("Image", "locks", "--lock_freq=20 --mem_size=4KiB --save_dir={0}".format(saved))[0]
+
+        locks = sum([ v[0] for k, v in stats.items() if k[1] == "locks" ])
+        self.assertTrue(locks > 0, "No ReadLock-WriteUnlock pairs were issued")
+        for state in [ "I", "S", "M" ]:
+            seen = sum([ v[0] for k, v in stats.items() if k[0].startswith("l1cache") and k[1] == "stateEvent_GetSX_" + state ])
+            self.assertTrue(seen > 0, "No L1 saw a GetSX in state {0}".format(state))
+
+        chunkSize, chunks = self._parse_image(os.path.join(saved, "memory.img"))
+        for addr, data in chunks.items():
+            for off in range(0, chunkSize, 4):
+                word = struct.unpack(">I", data[off:off + 4])[0]
+                self.assertTrue(word == 0 or word == (addr + off) & 0xffffffff,
+                        "Saved image holds 0x{0:x} at 0x{1:x}, not a value the CPUs wrote".format(word, addr + off))
+
+    # Save cache checkpoints with the memory image and restore them, both
+    # into the same cache geometry and into caches with half the line size.
+    # Each 128B line splits into two 64B lines in a set with room for both,
+    # so nothing may be dropped.
+    def test_selfcheck_CacheCheckpoint(self):
+        outdir = self.get_test_output_run_dir()
+        caches = [ "l1cache0", "l1cache1", "l2cache" ]
+        for line in [ "64", "128" ]:
+            saved = os.path.join(outdir, "checkpoint_{0}_saved".format(line))
+            resaved = os.path.join(outdir, "checkpoint_{0}_resaved".format(line))
+            for d in [ saved, resaved ]:
+                os.makedirs(d, exist_ok=True)
+            base = self.selfcheck_Run("Image", "checkpoint" + line + "_save",
+                    "--checkpoint=1 --line_size={0} --save_dir={1}".format(line, saved))[0]
+            for cache in caches:
+                ckpt = os.path.join(saved, cache + ".ckpt")
+                self.assertTrue(os.path.isfile(ckpt), "line_size={0}: {1} wrote no checkpoint to {2}".format(line, cache, ckpt))
+
+            stats, output = self.selfcheck_Run("Image", "checkpoint" + line + "_restore",
+                    "--checkpoint=1 --line_size=64 --load_dir={0} --save_dir={1}".format(saved, resaved))
+            self.selfcheck_SameIssued(base, stats, "line_size=" + line, "restored at line_size=64")
+            for cache in caches:
+                self.assertTrue(os.path.isfile(os.path.join(resaved, cache + ".ckpt")), "{0} did not save again after restoring".format(cache))
+
+            notices = re.findall(r"Notice: cache geometry or replacement policy differs from checkpoint .*dropped (\d+) lines", output)
+            if line == "64":
+                self.assertEqual(len(notices), 0, "Restoring into the same geometry reported a difference")
+            else:
+                self.assertEqual(len(notices), len(caches), "line_size=128: expected every cache to report re-inserted lines")
+                for dropped in notices:
+                    self.assertEqual(dropped, "0", "line_size=128: {0} lines were dropped when splitting into 64B lines".format(dropped))
+
+    # A sparse directory much smaller than the L1s must recall lines to make
+    # room, and requests wait while their set is full. Each waiting request is
+    # counted once however many cycles it waits, so stalls cannot exceed the
+    # requests the directory received. The CPUs issue the same traffic either way.
+    def test_selfcheck_SparseDirectory(self):
+        full = self.selfcheck_Run("SparseDirectory", "full", "--sparse_sets=0")[0]
+        for sets, ways in [ (4, 4), (16, 2) ]:
+            name = "sets{0}ways{1}".format(sets, ways)
+            stats = self.selfcheck_Run("SparseDirectory", name, "--sparse_sets={0} --sparse_ways={1}".format(sets, ways))[0]
+            self.selfcheck_SameIssued(full, stats, "full directory", name)
+            self.assertTrue(("directory", "sparse_recalls") in stats, "{0}: no sparse directory statistics found".format(name))
+            recalls = stats[("directory", "sparse_recalls")][0]
+            stalls = stats[("directory", "sparse_set_full_stalls")][0]
+            requests = sum([ stats[("directory", cmd + "_recv")][0] for cmd in [ "GetS", "GetX", "GetSX", "Write" ] if ("directory", cmd + "_recv") in stats ])
+            self.assertTrue(recalls > 0, "{0}: the sparse directory recalled no lines".format(name))
+            self.assertTrue(stalls > 0, "{0}: no request waited for a full set".format(name))
+            self.assertTrue(stalls <= requests, "{0}: {1} set-full stalls counted for {2} requests".format(name, stalls, requests))
+        self.assertEqual(full.get(("directory", "sparse_recalls"), [0])[0], 0, "A full directory recalled lines")
+
+    # Two line-interleaved memory caches, far smaller than the range the CPUs
+    # access, in front of a remote memory. The CPUs check every read and stop
+    # the simulation on a wrong value, so a line misplaced in a set or lost on
+    # writeback fails the run. Each cache must hit, miss and write back.
+    def test_selfcheck_MemoryCache(self):
+        for organization in [ "direct", "alloy", "set_assoc" ]:
+            stats = self.selfcheck_Run("MemoryCacheData", organization, "--organization={0} --num_caches=2".format(organization))[0]
+            checked = sum([ v[0] for k, v in stats.items() if k[1] == "reads_checked" ])
+            self.assertTrue(checked > 0, "{0}: no read followed a write by the same CPU".format(organization))
+            for cache in [ "memcache0", "memcache1" ]:
+                for stat in [ "CacheHits_Read", "CacheMisses_Read", "CacheWritebacks" ]:
+                    self.assertTrue(stats.get((cache, stat), [0])[0] > 0, "{0}: {1} has no {2}".format(organization, cache, stat))
+
+    # analyticMem answers the same traffic as simpleMem in every mode. The
+    # closed-form model and the example table must give higher latency under
+    # heavy load than under light load. Calibrating around simpleMem must not
+    # change simpleMem's latencies, and must write a sample for each request.
+    def test_selfcheck_AnalyticMem(self):
+        outdir = self.get_test_output_run_dir()
+        loads = [ ("light", "--cores=1 --mem_freq=64"), ("heavy", "--cores=4 --mem_freq=1") ]
+        latency = {}
+        for load, options in loads:
+            base = self.selfcheck_Run("AnalyticMem", "simpleMem_" + load, "--model=simpleMem " + options)[0]
+
+            samples = os.path.join(outdir, "analyticMem_{0}.samples".format(load))
+            if os.path.isfile(samples):
+                os.remove(samples)
+            calib = self.selfcheck_Run("AnalyticMem", "calibrate_" + load, "--model=calibrate --samples={0} {1}".format(samples, options))[0]
+            self.selfcheck_SameIssued(base, calib, "simpleMem", "calibrate")
+            self.assertEqual(self._mean_latency(base), self._mean_latency(calib),
+                    "{0}: calibrating changed simpleMem's mean latency".format(load))
+            self.assertTrue(os.path.isfile(samples), "{0}: calibration wrote no samples to {1}".format(load, samples))
+            with open(samples, 'r') as fp:
+                points = [ l.split() for l in fp if l[0].isdigit() ]
+            sampled = sum([ int(p[4]) for p in points ])
+            received = sum([ v[0] for k, v in calib.items() if k[1].startswith("requests_received_") ])
+            self.assertEqual(sampled, received, "{0}: {1} samples recorded for {2} requests".format(load, sampled, received))
+
+            for model in [ "closed", "table" ]:
+                stats = self.selfcheck_Run("AnalyticMem", model + "_" + load, "--model={0} {1}".format(model, options))[0]
+                self.selfcheck_SameIssued(base, stats, "simpleMem", model)
+                latency[(model, load)] = self._mean_latency(stats)
+
+        for model in [ "closed", "table" ]:
+            self.assertGreater(latency[(model, "heavy")], latency[(model, "light")],
+                    "{0}: mean latency under heavy load ({1:.1f}) is not above light load ({2:.1f})".format(
+                        model, latency[(model, "heavy")], latency[(model, "light")]))
+
+    # Tracing 1 in 8 requests must not change what the simulation does: the
+    # CPUs issue the same traffic and memory sees the same latencies. Each L1's
+    # trace file holds one record per traced request it finished, identified by
+    # that L1's wire ID, with stamps in time order from arrival at the L1 to the
+    # response leaving it. Run times are logged to compare tracing overhead.
+    def test_selfcheck_LatencyTrace(self):
+        outdir = self.get_test_output_run_dir()
+        tracedir = os.path.join(outdir, "latency_trace")
+        os.makedirs(tracedir, exist_ok=True)
+        start = time.time()
+        base = self.selfcheck_Run("LatencyTrace", "off", "--trace_rate=0")[0]
+        middle = time.time()
+        traced = self.selfcheck_Run("LatencyTrace", "on", "--trace_rate=8 --trace_dir={0}".format(tracedir))[0]
+        end = time.time()
+        log_debug("LatencyTrace: untraced run {0:.2f}s, traced run {1:.2f}s".format(middle - start, end - middle))
+
+        self.selfcheck_SameIssued(base, traced, "untraced", "traced")
+        self.assertEqual(self._mean_latency(base), self._mean_latency(traced), "Tracing changed the mean memory latency")
+
+        for cache in [ "l1cache0", "l1cache1" ]:
+            records = self._parse_trace(os.path.join(tracedir, cache + ".trace"))
+            self.assertTrue(len(records) > 0, "{0}: no traced requests were written".format(cache))
+            self.assertEqual(len(records), traced[(cache, "latency_trace_total")][2],
+                    "{0}: {1} trace records for {2} latency_trace_total samples".format(cache, len(records), traced[(cache, "latency_trace_total")][2]))
+            reachedMemory = 0
+            for traceID, cmd, stamps in records:
+                self.assertEqual(traceID >> 32, self._wire_id(cache), "{0}: trace 0x{1:x} was not started by this cache".format(cache, traceID))
+                points = [ s >> 56 for s in stamps ]
+                times = [ s & ((1 << 56) - 1) for s in stamps ]
+                self.assertEqual(points[0], 0, "{0}: trace 0x{1:x} does not start with CacheArrive".format(cache, traceID))
+                self.assertEqual(points[-1], 3, "{0}: trace 0x{1:x} does not end with CacheSend".format(cache, traceID))
+                self.assertEqual(times, sorted(times), "{0}: trace 0x{1:x} has stamps out of time order".format(cache, traceID))
+                if 4 in points and 12 in points:
+                    reachedMemory += 1
+            self.assertTrue(reachedMemory > 0, "{0}: no trace passed through the directory and memory".format(cache))
+
+    # Each cache and the memory controller dumps its last 64 events at the end
+    # of simulation. sst-memh-flightdecode, built from tools/flightdecode, must
+    # read every dump: a full ring of known commands in time order, no later
+    # than the dump, and its address and count filters must select from it.
+    def test_selfcheck_FlightRecorder(self):
+        outdir = self.get_test_output_run_dir()
+        flightdir = os.path.join(outdir, "flight_recorder")
+        os.makedirs(flightdir, exist_ok=True)
+        self.selfcheck_Run("FlightRecorder", "dump", "--flight_dir={0} --flight_size=64".format(flightdir))
+
+        header = re.compile(r'# (\S+): (\d+) of (\d+) events, dumped at cycle (\d+)$')
+        record = re.compile(r'(\d+) +(Recv|Handle|Stall|Send) +(\S+) +0x([0-9a-f]+) +(\S+) +(\d+) +(.*) -> (.*)$')
+        for comp in [ "l1cache0", "l1cache1", "l2cache", "memory" ]:
+            dump = os.path.join(flightdir, comp + ".flight")
+            self.assertTrue(os.path.isfile(dump), "{0}: no flight recorder dump written to {1}".format(comp, dump))
+            status, output = self._flightdecode(dump)
+            self.assertEqual(status, 0, "{0}: sst-memh-flightdecode failed:\n{1}".format(comp, output))
+            lines = output.splitlines()
+            m = header.match(lines[0])
+            self.assertTrue(m is not None, "{0}: unexpected decoder header '{1}'".format(comp, lines[0]))
+            self.assertEqual(m.group(1), comp, "{0}: dump is labelled '{1}'".format(comp, m.group(1)))
+            self.assertEqual((m.group(2), m.group(3)), ("64", "64"), "{0}: expected a full ring of 64 events, got '{1}'".format(comp, lines[0]))
+            dumpCycle = int(m.group(4))
+
+            records = [ record.match(l) for l in lines[2:] ]
+            self.assertEqual(len(records), 64, "{0}: decoder printed {1} events".format(comp, len(records)))
+            self.assertTrue(None not in records, "{0}: decoder printed an unexpected line".format(comp))
+            cycles = [ int(r.group(1)) for r in records ]
+            self.assertEqual(cycles, sorted(cycles), "{0}: events are not oldest first".format(comp))
+            self.assertTrue(cycles[-1] <= dumpCycle, "{0}: an event at cycle {1} is after the dump at {2}".format(comp, cycles[-1], dumpCycle))
+            for r in records:
+                self.assertFalse(r.group(3).startswith("?"), "{0}: unknown command in '{1}'".format(comp, r.group(0)))
+                self.assertFalse(r.group(5).startswith("?"), "{0}: unknown state in '{1}'".format(comp, r.group(0)))
+            if comp != "memory":
+                self.assertTrue(any([ r.group(5) != "-" for r in records ]), "{0}: no line states were recorded".format(comp))
+
+            addr = "0x" + records[-1].group(4)
+            status, output = self._flightdecode("-a {0} {1}".format(addr, dump))
+            filtered = output.splitlines()[2:]
+            self.assertEqual(status, 0, "{0}: sst-memh-flightdecode -a failed:\n{1}".format(comp, output))
+            self.assertEqual(filtered, [ r.group(0) for r in records if "0x" + r.group(4) == addr ],
+                    "{0}: '-a {1}' did not select exactly the events for that address".format(comp, addr))
+            status, output = self._flightdecode("-n 5 {0}".format(dump))
+            self.assertEqual(output.splitlines()[2:], lines[-5:], "{0}: '-n 5' did not print the last 5 events".format(comp))
+
+        status, output = self._flightdecode(os.path.join(outdir, "test_selfcheck_FlightRecorder_dump.out"))
+        self.assertNotEqual(status, 0, "sst-memh-flightdecode accepted a file that is not a flight recorder dump")
+
+#####
+
+    # Run 'test<testcase>.py' with 'options' passed as model options and return its statistics and output.
+    # The run's working directory is 'cwd', by default the test directory.
+    # Fails if SST fails, the run does not complete, or a memory controller has unanswered requests.
+    def selfcheck_Run(self, testcase, runname, options="", testtimeout=240, cwd=None):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+        if cwd is None:
+            cwd = test_path
+
+        testDataFileName = "test_selfcheck_{0}_{1}".format(testcase, runname)
+        sdlfile = "{0}/test{1}.py".format(test_path, testcase)
+        outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+        errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+        mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+
+        log_debug("testcase = {0} ({1})".format(testcase, runname))
+        log_debug("sdl file = {0}".format(sdlfile))
+
+        otherargs = ""
+        if options != "":
+            otherargs = '--model-options="{0}"'.format(options)
+        self.run_sst(sdlfile, outfile, errfile, set_cwd=cwd, other_args=otherargs,
+                     timeout_sec=testtimeout, mpi_out_files=mpioutfiles)
+
+        if os_test_file(errfile, "-s"):
+            log_testing_note("selfcheck test {0} has a Non-Empty Error File {1}".format(testDataFileName, errfile))
+
+        with open(outfile, 'r') as fp:
+            output = fp.read()
+        self.assertTrue("Simulation is complete" in output, "{0}: simulation did not complete, see {1}".format(testDataFileName, outfile))
+
+        stats = self._parse_stats(output)
+        self.selfcheck_AllAnswered(stats, testDataFileName)
+        return stats, output
+
+    # Each memory controller records one latency sample per response, so the
+    # sample count for each command must equal the number of requests received
+    def selfcheck_AllAnswered(self, stats, name):
+        received = 0
+        for (comp, stat), value in stats.items():
+            if not stat.startswith("requests_received_"):
+                continue
+            cmd = stat[len("requests_received_"):]
+            latency = stats.get((comp, "latency_" + cmd))
+            if latency is None:
+                continue
+            received += value[0]
+            self.assertEqual(value[0], latency[2],
+                    "{0}: {1} received {2} {3} requests but answered {4}".format(name, comp, value[0], cmd, latency[2]))
+        self.assertTrue(received > 0, "{0}: no memory controller statistics found".format(name))
+
+    # Both runs issued the same CPU-side requests
+    def selfcheck_SameIssued(self, a, b, aname, bname):
+        issued = [ "reads", "writes", "flushes", "flushinvs", "customReqs", "llsc" ]
+        keys = [ k for k in a if k[1] in issued ]
+        self.assertTrue(len(keys) > 0, "No CPU statistics found for {0}".format(aname))
+        for k in keys:
+            self.assertTrue(k in b, "{0}.{1} missing from {2}".format(k[0], k[1], bname))
+            self.assertEqual(a[k][0], b[k][0], "{0}.{1}: {2} issued {3}, {4} issued {5}".format(
+                k[0], k[1], aname, a[k][0], bname, b[k][0]))
+
+    # Mean latency over every request the memory controllers answered
+    def _mean_latency(self, stats):
+        total = sum([ v[0] for k, v in stats.items() if k[1].startswith("latency_") ])
+        count = sum([ v[2] for k, v in stats.items() if k[1].startswith("latency_") ])
+        self.assertTrue(count > 0, "No memory controller latency statistics found")
+        return float(total) / count
+
+    # Parse a memory image (membackend/backingImage.h) into (chunk size, {address : bytes})
+    def _parse_image(self, path):
+        self.assertTrue(os.path.isfile(path), "No memory image written to {0}".format(path))
+        with open(path, 'rb') as fp:
+            image = fp.read()
+        magic, version, reserved, chunkSize, numChunks, dataOffset = struct.unpack_from("=8sIIQQQ", image, 0)
+        self.assertEqual(magic, b"SSTMEMIM", "{0} is not a memory image".format(path))
+        index = struct.unpack_from("={0}Q".format(numChunks), image, struct.calcsize("=8sIIQQQ"))
+        chunks = {}
+        for i, addr in enumerate(index):
+            chunks[addr] = image[dataOffset + i * chunkSize : dataOffset + (i + 1) * chunkSize]
+        return chunkSize, chunks
+
+    # Parse a latency trace file (latencyTrace.h) into [(trace ID, command, [stamps])]
+    def _parse_trace(self, path):
+        self.assertTrue(os.path.isfile(path), "No latency trace written to {0}".format(path))
+        with open(path, 'rb') as fp:
+            trace = fp.read()
+        magic, version = struct.unpack_from("=4sI", trace, 0)
+        self.assertEqual(magic, b"MHLT", "{0} is not a latency trace".format(path))
+        self.assertEqual(version, 1, "{0}: unknown latency trace version {1}".format(path, version))
+        records = []
+        offset = struct.calcsize("=4sI")
+        while offset < len(trace):
+            traceID, cmd, count = struct.unpack_from("=QII", trace, offset)
+            offset += struct.calcsize("=QII")
+            stamps = list(struct.unpack_from("={0}Q".format(count), trace, offset))
+            offset += 8 * count
+            records.append((traceID, cmd, stamps))
+        return records
+
+    # An endpoint's wire ID, the FNV-1a hash of its name (EndpointRegistry::hashName)
+    def _wire_id(self, name):
+        wire = 2166136261
+        for c in name.encode():
+            wire = ((wire ^ c) * 16777619) & 0xffffffff
+        return 1 if wire == 0 else wire
+
+    # Run sst-memh-flightdecode with 'args' and return (exit status, output). The
+    # decoder is built from tools/flightdecode with the compiler sst-config reports.
+    def _flightdecode(self, args):
+        outdir = self.get_test_output_run_dir()
+        exefile = os.path.join(outdir, "sst-memh-flightdecode")
+        if not os.path.isfile(exefile):
+            test_path = self.get_testsuite_dir()
+            srcfile = "{0}/../tools/flightdecode/flightdecode.cc".format(test_path)
+            incdir = os.path.abspath("{0}/../../../..".format(test_path))
+            cxx = os_simple_command("sst-config --CXX")[1].strip()
+            cxxflags = os_simple_command("sst-config --ELEMENT_CXXFLAGS")[1].strip()
+            rtn = os_simple_command("{0} {1} -I{2} -o {3} {4}".format(cxx, cxxflags, incdir, exefile, srcfile))
+            self.assertEqual(rtn[0], 0, "Building sst-memh-flightdecode failed:\n{0}".format(rtn[1]))
+        return os_simple_command("{0} {1}".format(exefile, args))
+
+    # Parse console statistics into {(component, stat) : [sum, sumSQ, count, min, max]}
+    def _parse_stats(self, output):
+        cons_accum = re.compile(r' ([\w.]+)\.(\w+) : Accumulator : Sum.\w+ = (\d+); SumSQ.\w+ = (\d+); Count.\w+ = (\d+); Min.\w+ = (\d+); Max.\w+ = (\d+);')
+        stats = {}
+        for line in output.splitlines():
+            m = cons_accum.match(line)
+            if m is None:
+                continue
+            value = [ int(m.group(i)) for i in range(3, 8) ]
+            key = (m.group(1), m.group(2))
+            # Stats are printed once per output period and are cumulative unless
+            # 'resetOnOutput' is set, which these tests do not use; keep the last
+            stats[key] = value
+        return stats
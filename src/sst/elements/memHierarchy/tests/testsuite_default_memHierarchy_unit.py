@@ -0,0 +1,88 @@
+# -*- coding: utf-8 -*-
+
+from sst_unittest import *
+from sst_unittest_support import *
+import os.path
+
+################################################################################
+# Unit tests for memHierarchy's standalone data structures
+#
+# Each test compiles one program from unitTests/ against the element source
+# tree with the compiler and flags sst-config reports, runs it, and passes if
+# it exits with status 0. The programs compare the structure against a
+# reference implementation (usually an STL container).
+################################################################################
+
+class testcase_memHierarchy_unit(SSTTestCase):
+
+    def setUp(self):
+        super(type(self), self).setUp()
+        # Put test based setup code here. it is called once before every test
+
+    def tearDown(self):
+        # Put test based teardown code here. it is called once after every test
+        super(type(self), self).tearDown()
+
+#####
+
+    def test_unit_sharerSet(self):
+        self.unit_Template("sharerSet")
+
+    def test_unit_addrHashTable(self):
+        self.unit_Template("addrHashTable")
+
+    def test_unit_timingWheel(self):
+        self.unit_Template("timingWheel")
+
+    def test_unit_bankScheduler(self):
+        self.unit_Template("bankScheduler")
+
+    def test_unit_hotPageTracker(self):
+        self.unit_Template("hotPageTracker")
+
+    def test_unit_coherenceTable(self):
+        self.unit_Template("coherenceTable")
+
+    def test_unit_lineBuffer(self):
+        self.unit_Template("lineBuffer")
+
+    def test_unit_memEventPool(self):
+        self.unit_Template("memEventPool")
+
+    def test_unit_endpointRegistry(self):
+        self.unit_Template("endpointRegistry")
+
+    def test_unit_pendingRequestRing(self):
+        self.unit_Template("pendingRequestRing")
+
+    def test_unit_reorderRing(self):
+        self.unit_Template("reorderRing")
+
+#####
+
+    def unit_Template(self, testcase, testtimeout=120):
+        # Get the path to the test files
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+
+        srcfile = "{0}/unitTests/{1}.cc".format(test_path, testcase)
+        exefile = "{0}/unit_{1}".format(outdir, testcase)
+        # Tests include headers as "sst/elements/memHierarchy/..."
+        incdir = os.path.abspath("{0}/../../../..".format(test_path))
+
+        cxx = os_simple_command("sst-config --CXX")[1].strip()
+        cxxflags = os_simple_command("sst-config --ELEMENT_CXXFLAGS")[1].strip()
+
+        log_debug("testcase = {0}".format(testcase))
+        log_debug("src file = {0}".format(srcfile))
+
+        compile_cmd = "{0} {1} -I{2} -I{3}/unitTests -O1 -o {4} {5}".format(cxx, cxxflags, incdir, test_path, exefile, srcfile)
+        rtn = os_simple_command(compile_cmd)
+        if rtn[0] != 0:
+            log_failure("Compiling {0} failed:\n{1}".format(srcfile, rtn[1]))
+        self.assertEqual(rtn[0], 0, "Unit test {0} failed to compile".format(testcase))
+
+        rtn = os_simple_command(exefile, timeout_sec=testtimeout)
+        if rtn[0] != 0:
+            log_failure("Unit test {0} output:\n{1}".format(testcase, rtn[1]))
+        self.assertEqual(rtn[0], 0, "Unit test {0} failed".format(testcase))
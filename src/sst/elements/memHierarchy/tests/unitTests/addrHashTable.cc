@@ -0,0 +1,249 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/*
+ * AddrHashTable against std::map
+ *
+ * Run with 'bench' as the first argument to also time an MSHR-like
+ * workload (a bounded window of line addresses, each with a short list of
+ * entries) on both containers.
+ */
+
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <list>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "sst/elements/memHierarchy/addrHashTable.h"
+#include "unitTest.h"
+
+using namespace SST::MemHierarchy;
+
+struct Value {
+    uint64_t data;
+    std::vector<uint64_t> list;
+    Value() : data(0) { }
+    void reset() { data = 0; list.clear(); }
+};
+
+static void testRandom() {
+    UnitTestRNG rng(2);
+    AddrHashTable<Value> table(4);
+    std::map<uint64_t, uint64_t> ref;
+    std::map<uint64_t, Value*> pointers;
+
+    for (int i = 0; i < 500000; i++) {
+        /* Line-aligned keys in a range small enough to collide often */
+        uint64_t key = rng.next(2048) << 6;
+        switch (rng.next(3)) {
+            case 0: {
+                Value &v = table.insert(key);
+                if (ref.count(key)) {
+                    CHECK_EQ(v.data, ref[key]);
+                    CHECK(&v == pointers[key]);    // Existing values are returned, not replaced
+                } else {
+                    CHECK_EQ(v.data, 0u);          // New values start reset
+                    CHECK(v.list.empty());
+                    pointers[key] = &v;
+                }
+                v.data = i + 1;
+                v.list.push_back(i);
+                ref[key] = i + 1;
+                break;
+            }
+            case 1:
+                CHECK_EQ(table.erase(key), ref.erase(key) == 1);
+                pointers.erase(key);
+                break;
+            default: {
+                Value * v = table.find(key);
+                CHECK_EQ(v != nullptr, ref.count(key) == 1);
+                if (v) {
+                    CHECK_EQ(v->data, ref[key]);
+                    CHECK(v == pointers[key]);     // Pointers survive other inserts, erases and rehashes
+                }
+                break;
+            }
+        }
+        CHECK_EQ(table.size(), ref.size());
+    }
+
+    size_t count = 0;
+    for (AddrHashTable<Value>::iterator it = table.begin(); it != table.end(); ++it) {
+        CHECK_EQ(ref.count(it.key()), 1u);
+        CHECK_EQ(it.value().data, ref[it.key()]);
+        count++;
+    }
+    CHECK_EQ(count, ref.size());
+}
+
+/* Keys whose hashes collide in the low bucket bits, so erase has to backward-shift long probe runs */
+static void testClusters() {
+    AddrHashTable<Value> table(16);
+    std::vector<uint64_t> keys;
+    for (uint64_t k = 0; k < 12; k++)
+        keys.push_back(k << 40);
+    for (size_t i = 0; i < keys.size(); i++)
+        table.insert(keys[i]).data = i + 1;
+    for (size_t i = 0; i < keys.size(); i += 2)
+        CHECK(table.erase(keys[i]));
+    for (size_t i = 0; i < keys.size(); i++) {
+        Value * v = table.find(keys[i]);
+        if (i % 2 == 0) {
+            CHECK(v == nullptr);
+        } else {
+            CHECK(v != nullptr && v->data == i + 1);
+        }
+    }
+    CHECK(!table.erase(1));
+    CHECK_EQ(table.size(), keys.size() / 2);
+}
+
+/*
+ * Event-ID keys (counter, rank). IDs that agree in the low bits of the
+ * counter or rank, and so would collide if packed into one word, must stay
+ * separate entries.
+ */
+static void testPairKeys() {
+    typedef std::pair<uint64_t, int> ID;
+    AddrHashTable<Value, ID> table(16);
+    std::vector<ID> ids;
+    for (uint64_t counter = 0; counter < 4; counter++) {
+        for (int rank = 0; rank < 4; rank++) {
+            ids.push_back(ID(counter, (rank + 1) << 16));
+            ids.push_back(ID(counter | (1ULL << 48), rank));
+            ids.push_back(ID(counter, rank));
+        }
+    }
+    for (size_t i = 0; i < ids.size(); i++)
+        table.insert(ids[i]).data = i + 1;
+    CHECK_EQ(table.size(), ids.size());
+    for (size_t i = 0; i < ids.size(); i++) {
+        Value * v = table.find(ids[i]);
+        CHECK(v != nullptr && v->data == i + 1);
+    }
+    for (size_t i = 0; i < ids.size(); i += 3)
+        CHECK(table.erase(ids[i]));
+    for (size_t i = 0; i < ids.size(); i++)
+        CHECK_EQ(table.find(ids[i]) != nullptr, i % 3 != 0);
+}
+
+/* A table sized for its maximum occupancy never rehashes, so a bounded MSHR sees fixed-capacity behavior */
+static void testPresized() {
+    AddrHashTable<Value> table(64);
+    std::vector<Value*> values;
+    for (uint64_t k = 0; k < 64; k++)
+        values.push_back(&table.insert(k << 6));
+    for (uint64_t k = 0; k < 64; k++)
+        CHECK(table.find(k << 6) == values[k]);
+    for (uint64_t k = 0; k < 64; k++)
+        table.erase(k << 6);
+    CHECK(table.empty());
+    /* Recycled slots are reused rather than allocating new ones */
+    Value * reused = &table.insert(12345 << 6);
+    bool found = false;
+    for (size_t i = 0; i < values.size(); i++)
+        found |= (values[i] == reused);
+    CHECK(found);
+}
+
+template <typename Fn>
+static double timeIt(Fn fn) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+struct MapEntries {
+    std::list<uint64_t> entries;
+};
+
+struct TableEntries {
+    std::vector<uint64_t> entries;
+    void reset() { entries.clear(); }
+};
+
+/*
+ * Window of at most 'window' outstanding lines, retired oldest first. Each
+ * access looks the line up and either allocates it, appends an entry, or
+ * retires it. Both containers run the same access and retire sequence.
+ */
+template <typename Lookup, typename Allocate, typename Append, typename Retire, typename Size>
+static uint64_t mshrWorkload(size_t window, int ops, Lookup lookup, Allocate allocate, Append append, Retire retire, Size size) {
+    UnitTestRNG rng(3);
+    std::deque<uint64_t> fifo;
+    for (int i = 0; i < ops; i++) {
+        uint64_t addr = rng.next(window * 4) << 6;
+        size_t entries = lookup(addr);
+        if (entries == 0) {
+            while (size() >= window) {
+                retire(fifo.front());   // No-op if already retired
+                fifo.pop_front();
+            }
+            allocate(addr, i);
+            fifo.push_back(addr);
+        } else if (entries > 2) {
+            retire(addr);
+        } else {
+            append(addr, i);
+        }
+    }
+    return size();
+}
+
+static void benchmark(size_t window, int ops) {
+    uint64_t mapSize = 0, tableSize = 0;
+
+    double mapMs = timeIt([&]() {
+        std::map<uint64_t, MapEntries> mshr;
+        mapSize = mshrWorkload(window, ops,
+                [&](uint64_t a) -> size_t { std::map<uint64_t, MapEntries>::iterator it = mshr.find(a); return it == mshr.end() ? 0 : it->second.entries.size(); },
+                [&](uint64_t a, uint64_t v) { mshr[a].entries.push_back(v); },
+                [&](uint64_t a, uint64_t v) { mshr.find(a)->second.entries.push_back(v); },
+                [&](uint64_t a) { mshr.erase(a); },
+                [&]() -> size_t { return mshr.size(); });
+    });
+
+    double tableMs = timeIt([&]() {
+        AddrHashTable<TableEntries> mshr(window);
+        tableSize = mshrWorkload(window, ops,
+                [&](uint64_t a) -> size_t { TableEntries * e = mshr.find(a); return e ? e->entries.size() : 0; },
+                [&](uint64_t a, uint64_t v) { mshr.insert(a).entries.push_back(v); },
+                [&](uint64_t a, uint64_t v) { mshr.find(a)->entries.push_back(v); },
+                [&](uint64_t a) { mshr.erase(a); },
+                [&]() -> size_t { return mshr.size(); });
+    });
+
+    CHECK_EQ(mapSize, tableSize);
+    printf("  window %5zu: std::map %8.1f ms, AddrHashTable %8.1f ms (%.2fx)\n", window, mapMs, tableMs, mapMs / tableMs);
+}
+
+int main(int argc, char* argv[]) {
+    testRandom();
+    testClusters();
+    testPresized();
+    testPairKeys();
+
+    if (argc > 1 && strcmp(argv[1], "bench") == 0) {
+        printf("MSHR-like workload, 4M accesses:\n");
+        size_t windows[] = { 16, 64, 256, 1024 };
+        for (size_t i = 0; i < sizeof(windows)/sizeof(windows[0]); i++)
+            benchmark(windows[i], 4000000);
+    }
+    return unitTestResult("addrHashTable");
+}
@@ -0,0 +1,329 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/*
+ * TimingDRAM's BankScheduler against a direct implementation of the same rules
+ *
+ * The reference recomputes every bank's candidate every cycle and scans all
+ * banks, where BankScheduler caches candidates and walks bitmasks. Both get
+ * the same transactions and must issue the same commands, which shows up as
+ * the same transactions retiring in the same cycles and order.
+ */
+
+#include <map>
+#include <queue>
+#include <vector>
+
+#include "sst/elements/memHierarchy/membackend/timingScheduler.h"
+#include "unitTest.h"
+
+using namespace SST;
+using namespace SST::MemHierarchy::TimingDRAM_NS;
+
+typedef BankScheduler::Timing Timing;
+typedef BankScheduler::Options Options;
+
+class ReferenceScheduler {
+    public:
+        ReferenceScheduler(BankScheduler::Policy policy, unsigned numRanks, unsigned numBanks, Timing timing, Options options) :
+            policy_(policy), numBanks_(numBanks), timing_(timing), options_(options), seq_(0), lastSource_(0), sourceCount_(0), nextClear_(0) {
+            banks_.resize(numRanks * numBanks);
+            for (int i = 0; i < NUM_CMDS; i++) chanNext_[i] = 0;
+            if (options_.blissInterval == 0) options_.blissInterval = 1;
+        }
+
+        void push(Transaction* trans, unsigned rank) {
+            trans->seq = seq_++;
+            banks_[rank * numBanks_ + trans->bank].queue.push_back(trans);
+        }
+
+        void retire(SimTime_t cycle, std::queue<Transaction*>& retired) {
+            while (!inflight_.empty() && inflight_.begin()->first <= cycle) {
+                retired.push(inflight_.begin()->second);
+                inflight_.erase(inflight_.begin());
+            }
+        }
+
+        void issue(SimTime_t cycle) {
+            if (policy_ == BankScheduler::BLISS && cycle >= nextClear_) {
+                blacklist_.clear();
+                nextClear_ = cycle + options_.blissInterval;
+            }
+
+            int best = -1;
+            uint64_t bestKey = ~0ULL;
+            bool bestHit = false;
+            for (size_t b = 0; b < banks_.size(); b++) {
+                Bank &bank = banks_[b];
+                if (bank.queue.empty()) continue;
+                size_t cand = candidate(bank);
+                uint64_t key = keyOf(bank, cand);
+                bool hit = bank.row != NO_ROW && bank.queue[cand]->row == bank.row;
+                if (nextCmdTime(bank, cand) > cycle) continue;
+                // FR-FCFS: any ready hit beats any ready miss
+                bool better = (policy_ == BankScheduler::FRFCFS && hit != bestHit && best >= 0) ? hit : key < bestKey;
+                if (best < 0 || better) {
+                    best = b;
+                    bestKey = key;
+                    bestHit = hit;
+                }
+            }
+            if (best >= 0) {
+                issueCommand(best, candidate(banks_[best]), cycle);
+                return;
+            }
+            if (options_.idleClose == 0) return;
+            for (size_t b = 0; b < banks_.size(); b++) {
+                Bank &bank = banks_[b];
+                if (bank.queue.empty() && bank.row != NO_ROW && bank.lastUse + options_.idleClose <= cycle && bank.next[PRE] <= cycle) {
+                    precharge(bank, cycle);
+                    return;
+                }
+            }
+        }
+
+    private:
+        enum { ACT, PRE, RD, WR, NUM_CMDS };
+        static const unsigned NO_ROW = (unsigned)-1;
+
+        struct Bank {
+            std::vector<Transaction*> queue;
+            unsigned row;
+            unsigned hits;
+            SimTime_t lastUse;
+            SimTime_t next[NUM_CMDS];
+            Bank() : row(NO_ROW), hits(0), lastUse(0) { for (int i = 0; i < NUM_CMDS; i++) next[i] = 0; }
+        };
+
+        bool blacklisted(uint32_t source) {
+            for (size_t i = 0; i < blacklist_.size(); i++)
+                if (blacklist_[i] == source) return true;
+            return false;
+        }
+
+        /* Priority: not blacklisted (BLISS), then row hit while under the cap, then oldest. Lower is better. */
+        uint64_t keyOf(Bank &bank, size_t i) {
+            Transaction* trans = bank.queue[i];
+            bool hitsAllowed = bank.row != NO_ROW && (options_.rowHitCap == 0 || bank.hits < options_.rowHitCap);
+            uint64_t key = trans->seq;
+            if (!hitsAllowed || trans->row != bank.row) key |= 1ULL << 62;
+            if (policy_ == BankScheduler::BLISS && blacklisted(trans->source)) key |= 1ULL << 63;
+            return key;
+        }
+
+        size_t candidate(Bank &bank) {
+            size_t best = 0;
+            for (size_t i = 1; i < bank.queue.size(); i++)
+                if (keyOf(bank, i) < keyOf(bank, best)) best = i;
+            return best;
+        }
+
+        SimTime_t nextCmdTime(Bank &bank, size_t cand) {
+            Transaction* trans = bank.queue[cand];
+            if (bank.row == trans->row) {
+                int col = trans->isWrite ? WR : RD;
+                return std::max(bank.next[col], chanNext_[col]);
+            }
+            return bank.row == NO_ROW ? bank.next[ACT] : bank.next[PRE];
+        }
+
+        void precharge(Bank &bank, SimTime_t cycle) {
+            bank.row = NO_ROW;
+            bank.next[ACT] = cycle + timing_.TRP;
+        }
+
+        void issueCommand(unsigned b, size_t cand, SimTime_t cycle) {
+            Bank &bank = banks_[b];
+            Transaction* trans = bank.queue[cand];
+            if (bank.row != NO_ROW && bank.row != trans->row) {
+                precharge(bank, cycle);
+                return;
+            }
+            if (bank.row == NO_ROW) {
+                bank.row = trans->row;
+                bank.hits = 0;
+                bank.lastUse = cycle;
+                bank.next[RD] = bank.next[WR] = cycle + timing_.RCD;
+                bank.next[PRE] = std::max(bank.next[PRE], (SimTime_t)(cycle + timing_.RAS));
+                return;
+            }
+            unsigned lat = trans->isWrite ? timing_.CL_WR : timing_.CL;
+            SimTime_t dataEnd = cycle + lat + timing_.dataCycles;
+            bank.next[RD] = bank.next[WR] = cycle + timing_.dataCycles;
+            bank.next[PRE] = std::max(bank.next[PRE], dataEnd + (trans->isWrite ? timing_.WR : 0));
+            bank.lastUse = cycle;
+            bank.hits++;
+            chanNext_[RD] = std::max(chanNext_[RD], dataEnd > timing_.CL ? dataEnd - timing_.CL : 0);
+            chanNext_[WR] = std::max(chanNext_[WR], dataEnd > timing_.CL_WR ? dataEnd - timing_.CL_WR : 0);
+            if (trans->isWrite)
+                chanNext_[RD] = std::max(chanNext_[RD], dataEnd + timing_.WTR > timing_.CL ? dataEnd + timing_.WTR - timing_.CL : 0);
+            if (policy_ == BankScheduler::BLISS) {
+                if (trans->source == lastSource_) {
+                    sourceCount_++;
+                } else {
+                    lastSource_ = trans->source;
+                    sourceCount_ = 1;
+                }
+                if (sourceCount_ > options_.blissThreshold && !blacklisted(trans->source))
+                    blacklist_.push_back(trans->source);
+            }
+            bank.queue.erase(bank.queue.begin() + cand);
+            inflight_.insert(std::make_pair(dataEnd, trans));
+        }
+
+        BankScheduler::Policy policy_;
+        unsigned numBanks_;
+        Timing timing_;
+        Options options_;
+        std::vector<Bank> banks_;
+        SimTime_t chanNext_[NUM_CMDS];
+        uint64_t seq_;
+        uint32_t lastSource_;
+        unsigned sourceCount_;
+        SimTime_t nextClear_;
+        std::vector<uint32_t> blacklist_;
+        std::multimap<SimTime_t, Transaction*> inflight_;
+};
+
+static Timing testTiming() {
+    Timing t;
+    t.CL = 5;
+    t.CL_WR = 4;
+    t.RCD = 5;
+    t.TRP = 5;
+    t.RAS = 12;
+    t.WR = 3;
+    t.WTR = 2;
+    t.dataCycles = 2;
+    return t;
+}
+
+/* Run both schedulers on the same random traffic and compare retirements cycle by cycle */
+static void testAgainstReference(BankScheduler::Policy policy, Options options, uint64_t seed) {
+    const unsigned ranks = 2, banks = 4;
+    UnitTestRNG rng(seed);
+    BankScheduler sched(policy, ranks, banks, testTiming(), options);
+    ReferenceScheduler ref(policy, ranks, banks, testTiming(), options);
+    std::vector<Transaction*> live;
+    std::map<ReqId, SimTime_t> pushed;
+    ReqId nextId = 0;
+    size_t outstanding = 0;
+    uint64_t retiredCount = 0;
+
+    for (SimTime_t cycle = 0; cycle < 40000 || outstanding > 0; cycle++) {
+        if (cycle < 40000 && outstanding < 24 && rng.next(3) == 0) {
+            unsigned rank = rng.next(ranks);
+            unsigned bank = rng.next(banks);
+            unsigned row = rng.next(4);
+            bool write = rng.next(10) < 3;
+            uint32_t source = rng.next(5) == 0 ? 1 : rng.next(4);  // Source 1 is heavier so BLISS blacklists it
+            Transaction* a = new Transaction(cycle, nextId, nextId * 64, write, 64, bank, row, source);
+            Transaction* b = new Transaction(cycle, nextId, nextId * 64, write, 64, bank, row, source);
+            sched.push(a, rank);
+            ref.push(b, rank);
+            pushed[nextId] = cycle;
+            nextId++;
+            outstanding++;
+        }
+
+        std::queue<Transaction*> gotSched, gotRef;
+        sched.retire(cycle, gotSched);
+        ref.retire(cycle, gotRef);
+        CHECK_EQ(gotSched.size(), gotRef.size());
+        while (!gotSched.empty() && !gotRef.empty()) {
+            CHECK_EQ(gotSched.front()->id, gotRef.front()->id);
+            /* Nothing completes faster than a column command on an open row */
+            CHECK(cycle >= pushed[gotSched.front()->id] + testTiming().CL_WR + testTiming().dataCycles);
+            pushed.erase(gotSched.front()->id);
+            delete gotSched.front();
+            delete gotRef.front();
+            gotSched.pop();
+            gotRef.pop();
+            outstanding--;
+            retiredCount++;
+        }
+        sched.issue(cycle);
+        ref.issue(cycle);
+        if (cycle > 200000) break;  // Something is stuck; the checks below report it
+    }
+    CHECK_EQ(outstanding, 0u);
+    CHECK(pushed.empty());
+    CHECK(retiredCount > 1000);
+}
+
+/* Push to one bank at cycle 0 and return the order in which transactions retire */
+static std::vector<ReqId> retireOrder(BankScheduler::Policy policy, Options options, const std::vector<unsigned> &rows) {
+    BankScheduler sched(policy, 1, 1, testTiming(), options);
+    for (size_t i = 0; i < rows.size(); i++)
+        sched.push(new Transaction(0, i, i * 64, false, 64, 0, rows[i]), 0);
+    std::vector<ReqId> order;
+    for (SimTime_t cycle = 0; cycle < 1000 && order.size() < rows.size(); cycle++) {
+        std::queue<Transaction*> retired;
+        sched.retire(cycle, retired);
+        while (!retired.empty()) {
+            order.push_back(retired.front()->id);
+            delete retired.front();
+            retired.pop();
+        }
+        sched.issue(cycle);
+    }
+    return order;
+}
+
+static void testRowHitFirst() {
+    std::vector<unsigned> rows;
+    rows.push_back(5);
+    rows.push_back(7);
+    rows.push_back(5);
+
+    /* The younger hit to row 5 goes ahead of the older miss to row 7 */
+    Options options;
+    std::vector<ReqId> order = retireOrder(BankScheduler::FRFCFS, options, rows);
+    CHECK_EQ(order.size(), 3u);
+    if (order.size() == 3) {
+        CHECK_EQ(order[0], 0u);
+        CHECK_EQ(order[1], 2u);
+        CHECK_EQ(order[2], 1u);
+    }
+
+    /* With a hit cap of one, the older miss wins once row 5 has had its hit */
+    options.rowHitCap = 1;
+    order = retireOrder(BankScheduler::FRFCFS, options, rows);
+    CHECK_EQ(order.size(), 3u);
+    if (order.size() == 3) {
+        CHECK_EQ(order[0], 0u);
+        CHECK_EQ(order[1], 1u);
+        CHECK_EQ(order[2], 2u);
+    }
+}
+
+int main() {
+    Options options;
+    testAgainstReference(BankScheduler::FRFCFS, options, 5);
+    testAgainstReference(BankScheduler::BLISS, options, 6);
+
+    options.rowHitCap = 2;
+    options.idleClose = 20;
+    options.blissThreshold = 2;
+    options.blissInterval = 300;
+    testAgainstReference(BankScheduler::FRFCFS, options, 7);
+    testAgainstReference(BankScheduler::BLISS, options, 8);
+
+    options.rowHitCap = 0;  // No cap
+    testAgainstReference(BankScheduler::FRFCFS, options, 9);
+
+    testRowHitFirst();
+    return unitTestResult("bankScheduler");
+}
@@ -0,0 +1,76 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/* CoherenceTable against std::map, and MESIL1's request table against the switches it replaced (l1RequestSwitch) */
+
+#include <map>
+#include <utility>
+
+#include "sst/elements/memHierarchy/coherencemgr/MESI_L1_Table.h"
+#include "unitTest.h"
+
+using namespace SST::MemHierarchy;
+
+enum class TestAction : uint8_t { None, A, B, C };
+
+/* Random rows, with repeats in a small state/command range so the last row for a pair must win */
+static void testRandom() {
+    UnitTestRNG rng(20);
+    typedef CoherenceTable<TestAction, TestAction::None> Table;
+    for (int i = 0; i < 2000; i++) {
+        Table::Row rows[4];
+        std::map<std::pair<int,int>, TestAction> ref;
+        for (int r = 0; r < 4; r++) {
+            rows[r].state = (State)rng.next(4);
+            rows[r].cmd = (Command)rng.next(3);
+            rows[r].action = (TestAction)(1 + rng.next(3));
+            ref[std::make_pair((int)rows[r].state, (int)rows[r].cmd)] = rows[r].action;
+        }
+
+        Table table = { rows[0], rows[1], rows[2], rows[3] };
+        for (int s = 0; s < (int)LAST_STATE; s++) {
+            for (int c = 0; c < (int)Command::LAST_CMD; c++) {
+                std::map<std::pair<int,int>, TestAction>::iterator it = ref.find(std::make_pair(s, c));
+                TestAction expect = it == ref.end() ? TestAction::None : it->second;
+                CHECK(table.get((State)s, (Command)c) == expect);
+            }
+        }
+    }
+}
+
+/* Lookups are usable in constant expressions */
+static void testConstexpr() {
+    constexpr CoherenceTable<TestAction, TestAction::C> table = { { M, Command::PutM, TestAction::A } };
+    static_assert(table.get(M, Command::PutM) == TestAction::A, "Row lookup");
+    static_assert(table.get(I, Command::PutM) == TestAction::C, "Default lookup");
+    CHECK(table.get(S, Command::GetS) == TestAction::C);
+}
+
+static void testL1Requests() {
+    for (int s = 0; s < (int)LAST_STATE; s++) {
+        for (int c = 0; c < (int)Command::LAST_CMD; c++) {
+            State state = (State)s;
+            Command cmd = (Command)c;
+            CHECK(l1RequestTable.get(state, cmd) == l1RequestSwitch(state, cmd));
+        }
+    }
+}
+
+int main() {
+    testRandom();
+    testConstexpr();
+    testL1Requests();
+    return unitTestResult("coherenceTable");
+}
@@ -0,0 +1,78 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/* EndpointRegistry IDs and wire IDs against a std::map of names */
+
+#include <map>
+#include <string>
+
+#include "sst/elements/memHierarchy/endpointRegistry.h"
+#include "unitTest.h"
+
+using namespace SST::MemHierarchy;
+
+/*
+ * Names registered in random order get dense IDs, and each name's wire ID
+ * is its hash whatever its local ID, so another rank that registered the
+ * names in a different order maps the wire ID back to the same name.
+ */
+static void testNames() {
+    UnitTestRNG rng(9);
+    std::map<std::string, EndpointID> ids;
+    for (int i = 0; i < 2000; i++) {
+        std::string name = "l1cache" + std::to_string(rng.next(500));
+        EndpointID id = EndpointRegistry::getID(name);
+        std::map<std::string, EndpointID>::iterator it = ids.find(name);
+        if (it == ids.end()) {
+            CHECK_EQ((size_t)id + 1, EndpointRegistry::size());
+            ids[name] = id;
+        } else {
+            CHECK_EQ(id, it->second);
+        }
+    }
+    for (std::map<std::string, EndpointID>::iterator it = ids.begin(); it != ids.end(); it++) {
+        CHECK(EndpointRegistry::getName(it->second) == it->first);
+        uint32_t wire = EndpointRegistry::getWireID(it->second);
+        CHECK_EQ(wire, EndpointRegistry::hashName(it->first));
+        CHECK_EQ(EndpointRegistry::fromWireID(wire), it->second);
+    }
+    CHECK_EQ(EndpointRegistry::getID(""), EndpointRegistry::NO_ENDPOINT);
+    CHECK_EQ(EndpointRegistry::getWireID(EndpointRegistry::NO_ENDPOINT), 0u);
+    CHECK_EQ(EndpointRegistry::fromWireID(0), EndpointRegistry::NO_ENDPOINT);
+}
+
+/*
+ * A wire ID whose name has not been seen here (an event passing through this
+ * rank) gets a placeholder ID that serializes to the same wire ID. When the
+ * name is registered later it takes over the placeholder.
+ */
+static void testPlaceholder() {
+    std::string name = "remote.memory";
+    uint32_t wire = EndpointRegistry::hashName(name);
+    EndpointID id = EndpointRegistry::fromWireID(wire);
+    CHECK_EQ(EndpointRegistry::fromWireID(wire), id);
+    CHECK_EQ(EndpointRegistry::getWireID(id), wire);
+    CHECK(EndpointRegistry::getName(id) != name);
+
+    CHECK_EQ(EndpointRegistry::getID(name), id);
+    CHECK(EndpointRegistry::getName(id) == name);
+    CHECK_EQ(EndpointRegistry::getWireID(id), wire);
+}
+
+int main() {
+    testNames();
+    testPlaceholder();
+    return unitTestResult("endpointRegistry");
+}
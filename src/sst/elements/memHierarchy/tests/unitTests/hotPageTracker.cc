@@ -0,0 +1,136 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/* HotPageTracker against exact per-page counts in a std::map */
+
+#include <map>
+#include <vector>
+
+#include "sst/elements/memHierarchy/membackend/hotPageTracker.h"
+#include "unitTest.h"
+
+using namespace SST::MemHierarchy;
+
+/* Skewed page stream: mostly a few hot pages, sometimes any page in a large range */
+static uint64_t nextPage(UnitTestRNG &rng) {
+    if (rng.next(4) != 0)
+        return rng.next(16) * 7919;
+    return rng.next(20000);
+}
+
+/* Estimates never undercount and overcount by a small fraction of all accesses */
+static void testEstimates() {
+    UnitTestRNG rng(11);
+    HotPageTracker tracker(1024, 4, 32);
+    std::map<uint64_t, uint32_t> exact;
+    const int accesses = 200000;
+
+    for (int i = 0; i < accesses; i++) {
+        uint64_t page = nextPage(rng);
+        uint32_t est = tracker.touch(page);
+        exact[page]++;
+        CHECK(est >= exact[page]);
+    }
+
+    uint64_t overcount = 0;
+    for (std::map<uint64_t, uint32_t>::iterator it = exact.begin(); it != exact.end(); it++) {
+        uint32_t est = tracker.estimate(it->first);
+        CHECK(est >= it->second);
+        overcount += est - it->second;
+    }
+    /* Count-min bound with conservative update is about accesses / width per page on average */
+    CHECK(overcount / exact.size() <= (uint64_t)accesses / 1024);
+}
+
+/* peek() and wouldBeHot() predict what touch() will do, which the backends rely on to touch only accepted requests */
+static void testPredict() {
+    UnitTestRNG rng(12);
+    HotPageTracker tracker(256, 3, 8);
+    for (int i = 0; i < 100000; i++) {
+        uint64_t page = nextPage(rng);
+        uint32_t predicted = tracker.peek(page);
+        bool hot = tracker.wouldBeHot(page, predicted);
+        if (rng.next(3) == 0)
+            continue;   // Rejected: nothing may change
+        CHECK_EQ(tracker.touch(page), predicted);
+        CHECK_EQ(tracker.isHot(page), hot);
+        CHECK(tracker.numHot() <= 8);
+        if ((i & 8191) == 0)
+            tracker.decay();
+    }
+}
+
+/* The k hottest pages end up in the heap when they are clearly hotter than the rest */
+static void testHotSet() {
+    UnitTestRNG rng(13);
+    HotPageTracker tracker(4096, 4, 16);
+    for (int i = 0; i < 100000; i++)
+        tracker.touch(nextPage(rng));
+    for (uint64_t p = 0; p < 16; p++)
+        CHECK(tracker.isHot(p * 7919));
+    CHECK_EQ(tracker.numHot(), 16u);
+
+    size_t cold = 0;
+    for (uint64_t p = 1; p < 20000; p++) {
+        if (p % 7919 != 0 && tracker.isHot(p))
+            cold++;
+    }
+    CHECK_EQ(cold, 0u);
+}
+
+/* decay() halves every estimate and leaves the hot set alone */
+static void testDecay() {
+    UnitTestRNG rng(14);
+    HotPageTracker tracker(512, 4, 8);
+    std::vector<uint64_t> pages;
+    for (int i = 0; i < 50000; i++) {
+        uint64_t page = nextPage(rng);
+        tracker.touch(page);
+        if (i < 2000)
+            pages.push_back(page);
+    }
+
+    std::vector<uint32_t> before;
+    std::vector<bool> hot;
+    for (size_t i = 0; i < pages.size(); i++) {
+        before.push_back(tracker.estimate(pages[i]));
+        hot.push_back(tracker.isHot(pages[i]));
+    }
+    tracker.decay();
+    for (size_t i = 0; i < pages.size(); i++) {
+        CHECK_EQ(tracker.estimate(pages[i]), before[i] >> 1);
+        CHECK_EQ(tracker.isHot(pages[i]), (bool)hot[i]);
+    }
+}
+
+/* A tracker without a heap still counts but never reports hot pages */
+static void testNoHeap() {
+    HotPageTracker tracker(64, 2, 0);
+    for (int i = 0; i < 10; i++)
+        tracker.touch(5);
+    CHECK(tracker.estimate(5) >= 10u);
+    CHECK(!tracker.isHot(5));
+    CHECK(!tracker.wouldBeHot(5, 100));
+    CHECK_EQ(tracker.numHot(), 0u);
+}
+
+int main() {
+    testEstimates();
+    testPredict();
+    testHotSet();
+    testDecay();
+    testNoHeap();
+    return unitTestResult("hotPageTracker");
+}
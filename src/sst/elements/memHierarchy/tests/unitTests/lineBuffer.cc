@@ -0,0 +1,192 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/* LineBuffer against plain std::vector copies, including copy-on-write sharing */
+
+#include <utility>
+#include <vector>
+
+#include "sst/elements/memHierarchy/lineBuffer.h"
+#include "unitTest.h"
+
+using namespace SST::MemHierarchy;
+
+typedef std::vector<uint8_t> Bytes;
+
+static Bytes randomBytes(UnitTestRNG &rng, size_t size) {
+    Bytes bytes(size);
+    for (size_t i = 0; i < size; i++)
+        bytes[i] = (uint8_t)rng.next(256);
+    return bytes;
+}
+
+/*
+ * A set of buffers copied, moved, and modified at random. Each buffer must
+ * always hold what a std::vector given the same operations would hold, so a
+ * write through one holder never shows through another.
+ */
+static void testRandom() {
+    UnitTestRNG rng(30);
+    const size_t N = 8;
+    LineBuffer bufs[N];
+    Bytes ref[N];
+
+    for (int i = 0; i < 300000; i++) {
+        size_t a = rng.next(N);
+        size_t b = rng.next(N);
+        size_t size = rng.next(5) == 0 ? 0 : 1 + rng.next(128);
+        switch (rng.next(11)) {
+            case 0:     // Copy
+                bufs[a] = bufs[b];
+                ref[a] = ref[b];
+                if (a != b && !ref[a].empty())
+                    CHECK(&bufs[a].data() == &bufs[b].data());  // Shared, not copied
+                break;
+            case 1: {   // Move
+                LineBuffer tmp(std::move(bufs[b]));
+                bufs[a] = std::move(tmp);
+                Bytes moved = ref[b];
+                ref[b].clear();
+                ref[a] = moved;
+                break;
+            }
+            case 2: {   // Assign a copy
+                Bytes bytes = randomBytes(rng, size);
+                bufs[a].assign(bytes);
+                ref[a] = bytes;
+                break;
+            }
+            case 3: {   // Assign by move
+                Bytes bytes = randomBytes(rng, size);
+                ref[a] = bytes;
+                bufs[a].assign(std::move(bytes));
+                CHECK(bytes.empty());
+                break;
+            }
+            case 4: {   // Fill
+                uint8_t value = (uint8_t)rng.next(256);
+                bufs[a].assign(size, value);
+                ref[a].assign(size, value);
+                break;
+            }
+            case 5: {   // Partial write
+                if (ref[a].empty())
+                    break;
+                size_t offset = rng.next(ref[a].size());
+                Bytes bytes = randomBytes(rng, rng.next(ref[a].size() - offset + 1));
+                bufs[a].write(bytes, offset);
+                std::copy(bytes.begin(), bytes.end(), ref[a].begin() + offset);
+                break;
+            }
+            case 6:     // Resize
+                bufs[a].resize(size);
+                ref[a].resize(size);
+                break;
+            case 7: {   // Modify in place
+                Bytes &bytes = bufs[a].mutableData();
+                if (!bytes.empty()) {
+                    size_t at = rng.next(bytes.size());
+                    bytes[at] ^= 0x5a;
+                    ref[a][at] ^= 0x5a;
+                }
+                CHECK(!bufs[a].shared());
+                break;
+            }
+            case 8: {   // Move the bytes out
+                Bytes out = randomBytes(rng, 3);
+                bufs[a].moveTo(out);
+                CHECK(out == ref[a]);
+                CHECK(bufs[a].empty());
+                ref[a].clear();
+                break;
+            }
+            case 9:
+                bufs[a].clear();
+                ref[a].clear();
+                break;
+            default: {  // Copy-construct and let the copy go out of scope
+                LineBuffer copy(bufs[b]);
+                CHECK(copy.data() == ref[b]);
+                break;
+            }
+        }
+
+        for (size_t n = 0; n < N; n++) {
+            CHECK_EQ(bufs[n].size(), ref[n].size());
+            CHECK_EQ(bufs[n].empty(), ref[n].empty());
+            CHECK(bufs[n].data() == ref[n]);
+        }
+    }
+}
+
+/* Copies share until one writes; the writer gets its own bytes and the others keep theirs */
+static void testCopyOnWrite() {
+    LineBuffer a;
+    a.assign(64, 7);
+    LineBuffer b(a);
+    LineBuffer c = b;
+    CHECK(a.shared() && b.shared() && c.shared());
+    CHECK(&a.data() == &c.data());
+
+    b.mutableData()[0] = 1;
+    CHECK(!b.shared());
+    CHECK(a.shared() && c.shared());
+    CHECK_EQ(b.data()[0], 1u);
+    CHECK_EQ(a.data()[0], 7u);
+    CHECK_EQ(c.data()[0], 7u);
+
+    /* Replacing the contents of a shared buffer leaves the other holder alone */
+    c.assign(8, 9);
+    CHECK(!a.shared());
+    CHECK_EQ(a.size(), 64u);
+    CHECK_EQ(c.size(), 8u);
+
+    /* moveTo() copies out of a shared buffer and swaps out of an unshared one */
+    LineBuffer d(a);
+    Bytes out;
+    d.moveTo(out);
+    CHECK_EQ(out.size(), 64u);
+    CHECK(!a.shared());
+    CHECK_EQ(a.size(), 64u);
+    const uint8_t* bytes = a.data().data();
+    a.moveTo(out);
+    CHECK(out.data() == bytes);
+    CHECK(a.empty());
+}
+
+/* Empty buffers hold no storage and compare equal to an empty vector */
+static void testEmpty() {
+    LineBuffer a;
+    CHECK(a.empty());
+    CHECK(!a.shared());
+    CHECK(a.data().empty());
+    LineBuffer b(a);
+    CHECK(!b.shared());
+    a.assign(Bytes());
+    CHECK(a.empty());
+    a.resize(0);
+    CHECK(a.empty());
+    a.write(Bytes(), 0);
+    CHECK(a.empty());
+    a.resize(4);
+    CHECK(a.data() == Bytes(4, 0));
+}
+
+int main() {
+    testRandom();
+    testCopyOnWrite();
+    testEmpty();
+    return unitTestResult("lineBuffer");
+}
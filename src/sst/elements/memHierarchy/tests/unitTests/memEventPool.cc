@@ -0,0 +1,104 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/* MemEventPool and PayloadPool reuse, and releases after the pools are torn down */
+
+#include <cstring>
+#include <vector>
+
+#include "sst/elements/memHierarchy/memEventPool.h"
+#include "sst/elements/memHierarchy/lineBuffer.h"
+#include "unitTest.h"
+
+using namespace SST::MemHierarchy;
+
+/* A released block is handed out again for any size in the same class */
+static void testReuse() {
+    void* a = MemEventPool::allocate(40);
+    memset(a, 0xab, 40);
+    MemEventPool::release(a, 40);
+    void* b = MemEventPool::allocate(48);
+    CHECK(a == b);
+    MemEventPool::release(b, 48);
+
+    // Blocks too large for a size class come from the heap and are usable
+    void* big = MemEventPool::allocate(4096);
+    memset(big, 0xcd, 4096);
+    MemEventPool::release(big, 4096);
+    MemEventPool::release(nullptr, 16);
+}
+
+/* A payload buffer given back is reused by the next payload */
+static void testPayload() {
+    std::vector<uint8_t> p;
+    PayloadPool::acquire(p);
+    CHECK(p.capacity() >= PayloadPool::PAYLOAD_RESERVE);
+    p.assign(64, 7);
+    const uint8_t* buf = p.data();
+    PayloadPool::release(p);
+    CHECK_EQ(p.capacity(), 0u);
+
+    std::vector<uint8_t> q;
+    PayloadPool::acquire(q);
+    CHECK(q.data() == buf);
+    CHECK(q.empty());
+    PayloadPool::release(q);
+}
+
+/*
+ * Objects deleted during shutdown. The main thread's thread_local pools are
+ * destroyed before static objects, so this destructor releases into pools
+ * that no longer exist; those releases must go to the heap (run under
+ * AddressSanitizer/LeakSanitizer to catch a regression).
+ */
+struct LateRelease {
+    std::vector<void*> blocks;
+    std::vector<std::vector<uint8_t> > payloads;
+    std::vector<LineBuffer> lines;
+
+    ~LateRelease() {
+        for (void* b : blocks)
+            MemEventPool::release(b, 64);
+        for (std::vector<uint8_t> &p : payloads)
+            PayloadPool::release(p);
+        lines.clear();
+
+        // Allocating after teardown also works
+        void* b = MemEventPool::allocate(64);
+        MemEventPool::release(b, 64);
+        std::vector<uint8_t> p;
+        PayloadPool::acquire(p);
+        PayloadPool::release(p);
+    }
+};
+
+static LateRelease late;
+
+static void testLateRelease() {
+    for (int i = 0; i < 16; i++) {
+        late.blocks.push_back(MemEventPool::allocate(64));
+        late.payloads.push_back(std::vector<uint8_t>());
+        PayloadPool::acquire(late.payloads.back());
+        late.lines.push_back(LineBuffer());
+        late.lines.back().assign(64, (uint8_t)i);
+    }
+}
+
+int main() {
+    testReuse();
+    testPayload();
+    testLateRelease();
+    return unitTestResult("memEventPool");
+}
@@ -0,0 +1,121 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/* PendingRequestRing against a std::map of outstanding requests */
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include "sst/elements/memHierarchy/membackend/pendingRequestRing.h"
+#include "unitTest.h"
+
+using namespace SST::MemHierarchy;
+
+typedef PendingRequestRing<int> Ring;
+
+static void checkAll(Ring &ring, std::map<uint32_t, int*> &ref, uint32_t lo, uint32_t hi) {
+    CHECK_EQ(ring.size(), ref.size());
+    for (uint32_t id = lo; id != hi; id++) {
+        std::map<uint32_t, int*>::iterator it = ref.find(id);
+        CHECK(ring.find(id) == (it == ref.end() ? nullptr : it->second));
+    }
+}
+
+/*
+ * Requests complete in random order, a few of them only much later. IDs
+ * start near 2^32 so they wrap. The ring must never grow past MAX_SLOTS;
+ * requests that fall out of its window are moved to the side map and must
+ * still be found and erased.
+ */
+static void testStragglers() {
+    UnitTestRNG rng(12);
+    Ring ring;
+    std::map<uint32_t, int*> ref;
+    std::vector<int> values(1 << 16);
+    uint32_t start = 0xffffff00u;
+    uint32_t next = start;
+    size_t maxStragglers = 0;
+
+    for (int step = 0; step < 200000; step++) {
+        bool issue = ref.empty() || rng.next(100) < 52;
+        if (issue && ref.size() < 2000) {
+            int* req = &values[next & 0xffff];
+            ring.insert(next, req);
+            ref[next] = req;
+            next++;
+        } else {
+            // Mostly finish one of the newest requests, rarely an old one
+            std::map<uint32_t, int*>::iterator it;
+            if (rng.next(50) == 0) {
+                it = ref.begin();
+            } else {
+                it = ref.end();
+                for (uint64_t back = rng.next(std::min<size_t>(ref.size(), 32)) + 1; back > 0; back--)
+                    it--;
+            }
+            CHECK(ring.find(it->first) == it->second);
+            ring.erase(it->first);
+            ref.erase(it);
+        }
+        CHECK(ring.slots() <= Ring::MAX_SLOTS);
+        CHECK_EQ(ring.size(), ref.size());
+        if (ring.stragglers() > maxStragglers)
+            maxStragglers = ring.stragglers();
+        if (step % 10000 == 0)
+            checkAll(ring, ref, next - 8192, next + 16);
+    }
+    checkAll(ring, ref, next - 70000, next + 16);
+    CHECK(maxStragglers > 0);   // The test did reach the cap
+    CHECK_EQ(ring.slots(), (size_t)Ring::MAX_SLOTS);
+
+    while (!ref.empty()) {
+        ring.erase(ref.begin()->first);
+        ref.erase(ref.begin());
+    }
+    CHECK(ring.empty());
+    CHECK_EQ(ring.stragglers(), 0u);
+}
+
+/* A single straggler: the ring grows to MAX_SLOTS and then moves it aside */
+static void testOneStraggler() {
+    Ring ring;
+    int old = 0, req = 1;
+    ring.insert(100, &old);
+    uint32_t id = 101;
+    for (; id < 101 + 4 * Ring::MAX_SLOTS; id++) {
+        ring.insert(id, &req);
+        ring.erase(id);
+    }
+    CHECK(ring.slots() <= Ring::MAX_SLOTS);
+    CHECK_EQ(ring.stragglers(), 1u);
+    CHECK(ring.find(100) == &old);
+    CHECK(ring.find(id) == nullptr);
+    CHECK_EQ(ring.size(), 1u);
+
+    // Back to empty, then reuse
+    ring.erase(100);
+    CHECK(ring.empty());
+    CHECK(ring.find(100) == nullptr);
+    ring.insert(id, &req);
+    CHECK(ring.find(id) == &req);
+    CHECK_EQ(ring.size(), 1u);
+}
+
+int main() {
+    testStragglers();
+    testOneStraggler();
+    return unitTestResult("pendingRequestRing");
+}
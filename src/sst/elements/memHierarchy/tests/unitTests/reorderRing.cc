@@ -0,0 +1,157 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/* ReorderRing (MemNICFour's per-sender reorder buffer) against in-order delivery */
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include "sst/elements/memHierarchy/reorderRing.h"
+#include "unitTest.h"
+
+using namespace SST::MemHierarchy;
+
+struct Event {
+    unsigned int tag;
+};
+
+typedef ReorderRing<Event> Ring;
+
+/* Receive 'ev' the way MemNICFour::doRecv() does, appending what is delivered to 'out' */
+static void receive(Ring &ring, Event* ev, uint64_t time, size_t initialSize, std::vector<unsigned int> &out, int &grows) {
+    if (ring.inOrder(ev->tag)) {
+        ring.advance();
+        out.push_back(ev->tag);
+        uint64_t arrived;
+        while (Event* next = ring.pop(arrived)) {
+            CHECK(arrived <= time);
+            out.push_back(next->tag);
+        }
+    } else {
+        bool grew;
+        unsigned int expected = ring.expected();
+        unsigned int distance = ring.insert(ev->tag, ev, time, initialSize, grew);
+        CHECK_EQ(distance, ev->tag - expected);
+        CHECK(distance < ring.size());
+        if (grew)
+            grows++;
+    }
+}
+
+/*
+ * A sender's events arrive shuffled within a window that widens and narrows.
+ * Tags start just below 2^32 so they wrap. Every event must be delivered once,
+ * in tag order, and the ring must grow past its initial size.
+ */
+static void testShuffled() {
+    UnitTestRNG rng(22);
+    unsigned int first = 0xfffff000u;
+    Ring ring(first);
+    std::vector<Event> events(1 << 16);
+    std::vector<unsigned int> out;
+    std::vector<Event*> inflight;
+    int grows = 0;
+    size_t maxBuffered = 0;
+    unsigned int sent = 0;
+
+    for (uint64_t time = 0; out.size() < events.size(); time++) {
+        // Send a few, then deliver a random in-flight one; the window is how far ahead senders get
+        size_t window = (time / 4096) % 2 ? 300 : 20;
+        while (sent < events.size() && inflight.size() < window) {
+            events[sent].tag = first + sent;
+            inflight.push_back(&events[sent]);
+            sent++;
+        }
+        CHECK(!inflight.empty());      // Otherwise an event was lost in the ring
+        if (inflight.empty())
+            break;
+        size_t pick = rng.next(inflight.size());
+        Event* ev = inflight[pick];
+        inflight[pick] = inflight.back();
+        inflight.pop_back();
+        receive(ring, ev, time, 8, out, grows);
+        CHECK_EQ(ring.buffered() + out.size() + inflight.size(), (size_t)sent);
+        maxBuffered = std::max<size_t>(maxBuffered, ring.buffered());
+    }
+
+    CHECK_EQ(out.size(), events.size());
+    for (size_t i = 0; i < out.size(); i++)
+        CHECK_EQ(out[i], first + (unsigned int)i);
+    CHECK_EQ(ring.expected(), first + (unsigned int)events.size());
+    CHECK_EQ(ring.buffered(), 0u);
+    CHECK(grows > 0);
+    CHECK(maxBuffered > 8);
+    CHECK(ring.size() > 8 && (ring.size() & (ring.size() - 1)) == 0);
+}
+
+/* Growing keeps every buffered event in its slot, including across the tag wrap */
+static void testGrowth() {
+    Ring ring(0xfffffffeu);
+    Event ev[8];
+    for (unsigned int i = 0; i < 8; i++)
+        ev[i].tag = 0xfffffffeu + i;    // 0xfffffffe, 0xffffffff, 0, 1, ...
+    bool grew;
+    uint64_t time;
+
+    CHECK_EQ(ring.size(), 0u);
+    CHECK_EQ(ring.insert(ev[1].tag, &ev[1], 1, 4, grew), 1u);
+    CHECK(!grew);                       // First allocation is not a resize
+    CHECK_EQ(ring.size(), 4u);
+    CHECK_EQ(ring.insert(ev[3].tag, &ev[3], 2, 4, grew), 3u);
+    CHECK(!grew);
+    CHECK_EQ(ring.insert(ev[6].tag, &ev[6], 3, 4, grew), 6u);
+    CHECK(grew);
+    CHECK_EQ(ring.size(), 8u);
+    CHECK_EQ(ring.buffered(), 3u);
+
+    CHECK(ring.pop(time) == nullptr);   // 0xfffffffe has not arrived
+    CHECK(ring.inOrder(ev[0].tag));
+    ring.advance();
+    CHECK(ring.pop(time) == &ev[1]);
+    CHECK_EQ(time, 1u);
+    CHECK(ring.pop(time) == nullptr);   // 0 has not arrived
+    CHECK_EQ(ring.expected(), 0u);
+
+    // Far ahead: grows to the next power of two above the distance
+    Event far;
+    far.tag = 200;
+    CHECK_EQ(ring.insert(far.tag, &far, 4, 4, grew), 200u);
+    CHECK(grew);
+    CHECK_EQ(ring.size(), 256u);
+    CHECK_EQ(ring.buffered(), 3u);
+
+    ring.advance();                     // 0 delivered in order
+    CHECK(ring.pop(time) == &ev[3]);
+    CHECK_EQ(time, 2u);
+    CHECK(ring.pop(time) == nullptr);
+    ring.advance();                     // 2
+    ring.advance();                     // 3
+    CHECK(ring.pop(time) == &ev[6]);
+    CHECK_EQ(time, 3u);
+    CHECK_EQ(ring.expected(), 5u);
+    CHECK_EQ(ring.buffered(), 1u);
+    while (!ring.inOrder(far.tag))      // 5 through 199 delivered in order
+        ring.advance();
+    CHECK(ring.pop(time) == &far);
+    CHECK_EQ(ring.expected(), 201u);
+    CHECK_EQ(ring.buffered(), 0u);
+}
+
+int main() {
+    testShuffled();
+    testGrowth();
+    return unitTestResult("reorderRing");
+}
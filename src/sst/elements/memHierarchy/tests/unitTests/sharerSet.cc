@@ -0,0 +1,125 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/* SharerSet against std::set, including IDs that spill past the inline word */
+
+#include <set>
+#include <string>
+
+#include "sst/elements/memHierarchy/sharerSet.h"
+#include "unitTest.h"
+
+using namespace SST::MemHierarchy;
+
+static bool sameAs(const SharerSet &set, const std::set<uint32_t> &ref) {
+    if (set.size() != ref.size() || set.empty() != ref.empty())
+        return false;
+    std::set<uint32_t>::const_iterator it = ref.begin();
+    for (SharerSet::iterator st = set.begin(); st != set.end(); st++, it++) {
+        if (it == ref.end() || st.id() != *it)
+            return false;
+    }
+    return it == ref.end();
+}
+
+static void testRandom() {
+    UnitTestRNG rng(1);
+    SharerSet set;
+    std::set<uint32_t> ref;
+    for (int i = 0; i < 200000; i++) {
+        uint32_t id = rng.next(300);
+        switch (rng.next(4)) {
+            case 0:
+            case 1:
+                set.insert(id);
+                ref.insert(id);
+                break;
+            case 2:
+                set.erase(id);
+                ref.erase(id);
+                break;
+            default:
+                CHECK_EQ(set.contains(id), ref.count(id) == 1);
+                CHECK_EQ(set.hasOther(id), ref.size() > 1 || (ref.size() == 1 && ref.count(id) == 0));
+                break;
+        }
+        if (rng.next(5000) == 0) {
+            set.clear();
+            ref.clear();
+        }
+        if ((i & 1023) == 0)
+            CHECK(sameAs(set, ref));
+    }
+    CHECK(sameAs(set, ref));
+}
+
+static void testNext() {
+    SharerSet set;
+    CHECK_EQ(set.next(0), SharerIDMap::NO_ID);
+    set.insert(3);
+    set.insert(63);
+    set.insert(64);
+    set.insert(200);
+    CHECK_EQ(set.next(0), 3u);
+    CHECK_EQ(set.next(4), 63u);
+    CHECK_EQ(set.next(64), 64u);
+    CHECK_EQ(set.next(65), 200u);
+    CHECK_EQ(set.next(201), SharerIDMap::NO_ID);
+    CHECK_EQ(set.next(100000), SharerIDMap::NO_ID);
+
+    /* Erasing beyond the allocated words is a no-op */
+    set.erase(5000);
+    CHECK_EQ(set.size(), 4u);
+}
+
+static void testNames() {
+    std::set<std::string> names;
+    names.insert("l1.cpu1");
+    names.insert("l1.cpu0");
+    SharerIDMap::registerNames(names);
+    uint32_t id0 = SharerIDMap::findID("l1.cpu0");
+    uint32_t id1 = SharerIDMap::findID("l1.cpu1");
+    CHECK(id0 != SharerIDMap::NO_ID);
+    CHECK(id0 < id1);
+    CHECK_EQ(SharerIDMap::getID("l1.cpu0"), id0);
+    CHECK_EQ(SharerIDMap::findID("l1.unknown"), SharerIDMap::NO_ID);
+    CHECK(SharerIDMap::getName(id1) == "l1.cpu1");
+    CHECK(SharerIDMap::getName(SharerIDMap::NO_ID).empty());
+
+    /* Events look sharers up by their dense endpoint ID */
+    CHECK_EQ(SharerIDMap::findID(EndpointRegistry::getID("l1.cpu1")), id1);
+    CHECK(EndpointRegistry::getName(EndpointRegistry::getID("l1.cpu0")) == "l1.cpu0");
+    CHECK_EQ(SharerIDMap::findID(EndpointRegistry::getID("l1.other")), SharerIDMap::NO_ID);
+
+    SharerSet set;
+    set.insert("l1.cpu1");
+    set.insert("l1.cpu0");
+    CHECK(set.contains("l1.cpu0"));
+    CHECK(!set.contains("l1.unknown"));
+    CHECK(set.hasOther("l1.cpu0"));
+    CHECK(*set.begin() == "l1.cpu0");
+    set.erase("l1.cpu0");
+    set.erase("l1.unknown");
+    CHECK_EQ(set.size(), 1u);
+    CHECK(!set.hasOther("l1.cpu1"));
+    CHECK(set.hasOther("l1.cpu0"));
+}
+
+int main() {
+    testRandom();
+    testNext();
+    testNames();
+    return unitTestResult("sharerSet");
+}
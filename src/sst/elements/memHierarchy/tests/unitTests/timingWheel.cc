@@ -0,0 +1,126 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/* TimingWheel against the std::multimap send queue it replaces */
+
+#include <map>
+
+#include "sst/elements/memHierarchy/timingWheel.h"
+#include "unitTest.h"
+
+using namespace SST::MemHierarchy;
+
+typedef std::multimap<uint64_t, uint64_t> RefQueue;
+
+/* Deliver up to 'limit' items due at 'now' from both queues and compare them */
+static void drain(TimingWheel<uint64_t> &wheel, RefQueue &ref, uint64_t now, int limit) {
+    for (int n = 0; n < limit; n++) {
+        bool due = !ref.empty() && ref.begin()->first <= now;
+        CHECK_EQ(wheel.ready(now), due);
+        if (!due)
+            return;
+        CHECK_EQ(wheel.front(), ref.begin()->second);
+        CHECK_EQ(wheel.frontTime(), ref.begin()->first);
+        wheel.pop();
+        ref.erase(ref.begin());
+    }
+}
+
+/* Per-cycle inserts with delays inside and beyond the window, drained with a bandwidth limit */
+static void testRandom() {
+    UnitTestRNG rng(4);
+    TimingWheel<uint64_t> wheel(64);
+    RefQueue ref;
+    uint64_t item = 0;
+    uint64_t now = 0;
+
+    for (int cycle = 0; cycle < 200000; cycle++) {
+        /* Mostly step one cycle, sometimes skip ahead like a clock that was turned off */
+        now += rng.next(20) == 0 ? 1 + rng.next(500) : 1;
+        unsigned inserts = rng.next(4);
+        for (unsigned i = 0; i < inserts; i++) {
+            uint64_t delay = rng.next(8) == 0 ? rng.next(300) : rng.next(4);
+            wheel.insert(now + delay, item);
+            ref.insert(std::make_pair(now + delay, item));
+            item++;
+        }
+        drain(wheel, ref, now, 1 + rng.next(3));
+        CHECK_EQ(wheel.size(), ref.size());
+        CHECK_EQ(wheel.empty(), ref.empty());
+    }
+    drain(wheel, ref, (uint64_t)-1, (int)ref.size() + 1);
+    CHECK(wheel.empty());
+}
+
+/* An item inserted for 'now' after ready(now) found nothing due must precede later items */
+static void testNoAdvancePastNow() {
+    TimingWheel<uint64_t> wheel(16);
+    wheel.insert(11, 1);
+    CHECK(!wheel.ready(10));
+    wheel.insert(10, 2);
+    CHECK(wheel.ready(10));
+    CHECK_EQ(wheel.front(), 2u);
+    CHECK_EQ(wheel.frontTime(), 10u);
+    wheel.pop();
+    CHECK(!wheel.ready(10));
+    CHECK(wheel.ready(11));
+    CHECK_EQ(wheel.front(), 1u);
+    wheel.pop();
+    CHECK(wheel.empty());
+}
+
+/* Items scheduled in the past are delivered at the current time, after items already due */
+static void testPast() {
+    TimingWheel<uint64_t> wheel(16);
+    wheel.insert(5, 1);
+    CHECK(wheel.ready(5));
+    wheel.insert(3, 2);
+    CHECK_EQ(wheel.front(), 1u);
+    wheel.pop();
+    CHECK(wheel.ready(5));
+    CHECK_EQ(wheel.front(), 2u);
+    CHECK_EQ(wheel.frontTime(), 5u);
+    wheel.pop();
+    CHECK(!wheel.ready(5));
+}
+
+/* forEach visits items in delivery order, including the overflow map */
+static void testForEach() {
+    TimingWheel<uint64_t> wheel(8);
+    RefQueue ref;
+    uint64_t times[] = { 3, 1, 100, 3, 7, 40 };
+    for (uint64_t i = 0; i < sizeof(times)/sizeof(times[0]); i++) {
+        wheel.insert(times[i], i);
+        ref.insert(std::make_pair(times[i], i));
+    }
+    RefQueue::const_iterator it = ref.begin();
+    bool match = true;
+    wheel.forEach([&](uint64_t t, const uint64_t &v) {
+        if (it == ref.end() || it->first != t || it->second != v)
+            match = false;
+        else
+            it++;
+    });
+    CHECK(match);
+    CHECK(it == ref.end());
+}
+
+int main() {
+    testRandom();
+    testNoAdvancePastNow();
+    testPast();
+    testForEach();
+    return unitTestResult("timingWheel");
+}
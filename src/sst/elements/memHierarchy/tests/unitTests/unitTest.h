@@ -0,0 +1,68 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/*
+ * Minimal checks for memHierarchy's standalone unit tests
+ *
+ * Each test is a single program run by testsuite_default_memHierarchy_unit.py.
+ * CHECK() records a failure and keeps going; main() returns unitTestResult(),
+ * which is non-zero if any check failed.
+ */
+
+#ifndef MEMHIERARCHY_UNITTEST_H
+#define MEMHIERARCHY_UNITTEST_H
+
+#include <cstdio>
+
+static int unitTestFailures = 0;
+
+#define CHECK(cond) do { \
+        if (!(cond)) { \
+            fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+            unitTestFailures++; \
+        } \
+    } while (0)
+
+#define CHECK_EQ(a, b) do { \
+        if (!((a) == (b))) { \
+            fprintf(stderr, "%s:%d: CHECK_EQ failed: %s == %s\n", __FILE__, __LINE__, #a, #b); \
+            unitTestFailures++; \
+        } \
+    } while (0)
+
+/* Small deterministic generator so failures reproduce */
+class UnitTestRNG {
+    public:
+        UnitTestRNG(unsigned long long seed) : state_(seed ? seed : 1) { }
+        unsigned long long next() {
+            state_ ^= state_ << 13;
+            state_ ^= state_ >> 7;
+            state_ ^= state_ << 17;
+            return state_;
+        }
+        unsigned long long next(unsigned long long bound) { return next() % bound; }
+    private:
+        unsigned long long state_;
+};
+
+static int unitTestResult(const char * name) {
+    if (unitTestFailures == 0)
+        printf("%s: PASS\n", name);
+    else
+        printf("%s: FAIL (%d checks)\n", name, unitTestFailures);
+    return unitTestFailures == 0 ? 0 : 1;
+}
+
+#endif // MEMHIERARCHY_UNITTEST_H
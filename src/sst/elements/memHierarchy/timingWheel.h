@@ -0,0 +1,130 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_TIMINGWHEEL_H
+#define MEMHIERARCHY_TIMINGWHEEL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+#include <deque>
+#include <map>
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ * Timing wheel for delaying items by a (usually small) number of cycles
+ *
+ * A replacement for std::multimap<time, T> send queues. The wheel has one
+ * FIFO bucket per cycle over a window of 'slots' cycles starting at the
+ * current time; an item is appended to the bucket for its delivery time so
+ * insert and removal are O(1) and do not allocate once the buckets have
+ * grown. Items further out than the window wait in an overflow map and move
+ * into the wheel as the window reaches them. Items scheduled in the past are
+ * delivered at the current time.
+ *
+ * Delivery order matches the multimap: by time, then by insertion order.
+ *
+ * Usage:
+ *   while (wheel.ready(now)) { send(wheel.front()); wheel.pop(); }
+ * The caller may stop early (e.g., for bandwidth limits); undelivered items
+ * stay at the front.
+ */
+template <typename T>
+class TimingWheel {
+    public:
+        TimingWheel(size_t slots = 256) : cur_(0), inWheel_(0) {
+            size_t n = 1;
+            while (n < slots) n <<= 1;
+            slots_.resize(n);
+            mask_ = n - 1;
+        }
+
+        void insert(uint64_t time, const T& item) {
+            if (time < cur_)
+                time = cur_;
+            if (time - cur_ > mask_) {
+                overflow_.insert(std::make_pair(time, item));
+            } else {
+                slots_[time & mask_].push_back(item);
+                inWheel_++;
+            }
+        }
+
+        /* Advance to 'now' and return whether an item is due. The wheel never advances past
+         * 'now', so items inserted later for time 'now' still go into the bucket for 'now'. */
+        bool ready(uint64_t now) {
+            while (cur_ < now) {
+                if (!slots_[cur_ & mask_].empty())
+                    return true;    // Overdue items, e.g., left by a caller that stopped early
+                if (inWheel_ == 0) {
+                    // Nothing in the window, jump ahead rather than stepping through empty buckets
+                    if (overflow_.empty() || overflow_.begin()->first > now)
+                        cur_ = now;
+                    else
+                        cur_ = overflow_.begin()->first;
+                } else {
+                    cur_++;
+                }
+                refill();
+            }
+            return cur_ <= now && !slots_[cur_ & mask_].empty();
+        }
+
+        /* Front item; only valid after ready() returns true */
+        T& front() { return slots_[cur_ & mask_].front(); }
+
+        /* Delivery time of the front item; only valid after ready() returns true */
+        uint64_t frontTime() const { return cur_; }
+
+        void pop() {
+            slots_[cur_ & mask_].pop_front();
+            inWheel_--;
+        }
+
+        bool empty() const { return inWheel_ == 0 && overflow_.empty(); }
+        size_t size() const { return inWheel_ + overflow_.size(); }
+
+        /* Visit every (time, item) in delivery order, e.g., for printStatus */
+        template <typename F>
+        void forEach(F f) const {
+            for (uint64_t t = cur_; t <= cur_ + mask_; t++) {
+                const std::deque<T> &slot = slots_[t & mask_];
+                for (typename std::deque<T>::const_iterator it = slot.begin(); it != slot.end(); it++)
+                    f(t, *it);
+            }
+            for (typename std::multimap<uint64_t,T>::const_iterator it = overflow_.begin(); it != overflow_.end(); it++)
+                f(it->first, it->second);
+        }
+
+    private:
+        /* Move overflow items that now fall inside the window into the wheel */
+        void refill() {
+            while (!overflow_.empty() && overflow_.begin()->first - cur_ <= mask_) {
+                slots_[overflow_.begin()->first & mask_].push_back(overflow_.begin()->second);
+                inWheel_++;
+                overflow_.erase(overflow_.begin());
+            }
+        }
+
+        std::vector<std::deque<T> > slots_;
+        std::multimap<uint64_t,T> overflow_;
+        uint64_t mask_;
+        uint64_t cur_;      // Time of the bucket at the front of the wheel
+        size_t inWheel_;    // Items in buckets (not overflow)
+};
+
+}}
+#endif // MEMHIERARCHY_TIMINGWHEEL_H
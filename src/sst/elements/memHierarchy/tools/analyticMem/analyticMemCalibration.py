@@ -0,0 +1,212 @@
+# Calibration harness for the memHierarchy.analyticMem backend
+#
+# Run with python to sweep a detailed backend and fit a latency table:
+#   python analyticMemCalibration.py --backend=memHierarchy.simpleDRAM --output=simpleDRAM.table
+# Each sweep point runs this file under sst with the analyticMem backend in
+# 'calibrate' mode wrapped around the detailed backend. Samples from every
+# run are merged into one samples file, which is then fit into a table:
+# empty grid points are filled from their nearest populated neighbors and
+# latency is made non-decreasing in utilization.
+#
+# Use the table with:
+#   memory = memctrl.setSubComponent("backend", "memHierarchy.analyticMem")
+#   memory.addParams({ "table" : "simpleDRAM.table", "peak_bandwidth" : ... })
+# 'peak_bandwidth', 'window', and the bank/row parameters must match the
+# ones used during calibration.
+# example.table in this directory shows the table format.
+
+import itertools
+import os
+import subprocess
+import sys
+
+# Defaults; override with --param=value
+config = {
+    "backend"           : "memHierarchy.simpleDRAM",
+    "backend_params"    : "mem_size=512MiB,tCAS=9,tRCD=9,tRP=9,cycle_time=1.25ns,row_size=8KiB,row_policy=open,banks=8",
+    "clock"             : "1GHz",           # Memory controller and CPU clock
+    "peak_bandwidth"    : "12.8GB/s",
+    "window"            : "1us",
+    "banks"             : "8",
+    "row_size"          : "8KiB",
+    "util_points"       : "11",
+    "hit_points"        : "5",
+    "write_points"      : "5",
+    "samples"           : "analyticMem.samples",
+    "output"            : "analyticMem.table",
+    "sst"               : "sst",
+    # Per-run sweep parameters, set by the driver
+    "cores"             : "1",
+    "mem_freq"          : "1",              # Cycles between requests per core
+    "footprint"         : "1MiB",           # Smaller footprints give more row hits
+    "write_freq"        : "0",              # Percent writes
+    "ops"               : "20000",
+}
+
+# Sweep grid: utilization via core count and issue rate, row-hit rate via
+# footprint, write fraction via write_freq
+sweep_cores = [1, 2, 4, 8]
+sweep_mem_freq = [1, 4, 16, 64]
+sweep_footprint = ["16KiB", "1MiB", "256MiB"]
+sweep_write_freq = [0, 25, 50, 75, 100]
+
+
+def parse_args(argv):
+    for arg in argv:
+        if arg.startswith("--") and "=" in arg:
+            key, value = arg[2:].split("=", 1)
+            if key not in config:
+                sys.exit("analyticMemCalibration: unknown parameter '%s'" % key)
+            config[key] = value
+
+
+def build_sst():
+    import sst
+
+    cores = int(config["cores"])
+
+    memctrl = sst.Component("memory", "memHierarchy.MemController")
+    memctrl.addParams({
+        "clock" : config["clock"],
+        "backing" : "none",
+        "addr_range_end" : 512*1024*1024-1,
+    })
+    analytic = memctrl.setSubComponent("backend", "memHierarchy.analyticMem")
+    analytic.addParams({
+        "mem_size" : "512MiB",
+        "calibrate" : True,
+        "calibration_output" : config["samples"],
+        "peak_bandwidth" : config["peak_bandwidth"],
+        "window" : config["window"],
+        "banks" : config["banks"],
+        "row_size" : config["row_size"],
+        "util_points" : config["util_points"],
+        "hit_points" : config["hit_points"],
+        "write_points" : config["write_points"],
+    })
+    detailed = analytic.setSubComponent("backend", config["backend"])
+    for kv in config["backend_params"].split(","):
+        if kv:
+            key, value = kv.split("=", 1)
+            detailed.addParams({ key : value })
+
+    bus = sst.Component("bus", "memHierarchy.Bus")
+    bus.addParams({ "bus_frequency" : config["clock"] })
+
+    for i in range(cores):
+        cpu = sst.Component("core" + str(i), "memHierarchy.standardCPU")
+        iface = cpu.setSubComponent("memory", "memHierarchy.standardInterface")
+        cpu.addParams({
+            "memFreq" : config["mem_freq"],
+            "rngseed" : str(101 + 200 * i),
+            "clock" : config["clock"],
+            "memSize" : config["footprint"],
+            "verbose" : 0,
+            "maxOutstanding" : 16,
+            "opCount" : config["ops"],
+            "reqsPerIssue" : 4,
+            "write_freq" : config["write_freq"],
+            "read_freq" : str(100 - int(config["write_freq"])),
+        })
+        # Small cache so that nearly every request reaches memory
+        l1 = sst.Component("l1cache" + str(i), "memHierarchy.Cache")
+        l1.addParams({
+            "access_latency_cycles" : "1",
+            "cache_frequency" : config["clock"],
+            "replacement_policy" : "lru",
+            "coherence_protocol" : "none",
+            "associativity" : "1",
+            "cache_line_size" : "64",
+            "cache_size" : "1 KB",
+            "L1" : "1",
+        })
+        link_cpu = sst.Link("link_cpu_l1_" + str(i))
+        link_cpu.connect( (iface, "port", "500ps"), (l1, "high_network_0", "500ps") )
+        link_bus = sst.Link("link_l1_bus_" + str(i))
+        link_bus.connect( (l1, "low_network_0", "500ps"), (bus, "high_network_" + str(i), "500ps") )
+
+    link_mem = sst.Link("link_bus_mem")
+    link_mem.connect( (bus, "low_network_0", "500ps"), (memctrl, "direct_link", "500ps") )
+
+
+# Latency table, same text format as AnalyticMemory::LatencyTable
+def read_table(path):
+    grid = None
+    cells = {}
+    with open(path) as f:
+        for line in f:
+            fields = line.split()
+            if not fields or fields[0].startswith("#") or fields[0] == "analyticMem":
+                continue
+            if fields[0] == "grid":
+                grid = tuple(int(x) for x in fields[1:4])
+                continue
+            u, h, w = (int(x) for x in fields[0:3])
+            cells[(u, h, w)] = (float(fields[3]), int(fields[4]))
+    return grid, cells
+
+
+def write_table(path, grid, cells):
+    with open(path, "w") as f:
+        f.write("# analyticMem latency table: util hit write latency(ns) samples\n")
+        f.write("analyticMem 1\n")
+        f.write("grid %d %d %d\n" % grid)
+        for key in itertools.product(range(grid[0]), range(grid[1]), range(grid[2])):
+            f.write("%d %d %d %r %d\n" % (key + cells[key]))
+
+
+def fit(grid, cells):
+    populated = [key for key, (lat, count) in cells.items() if count > 0]
+    if not populated:
+        sys.exit("analyticMemCalibration: no samples were collected")
+
+    # Fill empty grid points with the sample-weighted mean of the nearest populated points
+    fitted = {}
+    for key in itertools.product(range(grid[0]), range(grid[1]), range(grid[2])):
+        lat, count = cells.get(key, (-1.0, 0))
+        if count > 0:
+            fitted[key] = (lat, count)
+            continue
+        dist = lambda p: sum((a - b) * (a - b) for a, b in zip(p, key))
+        best = min(dist(p) for p in populated)
+        near = [cells[p] for p in populated if dist(p) == best]
+        total = sum(c for l, c in near)
+        fitted[key] = (sum(l * c for l, c in near) / total, 0)
+
+    # Queueing delay does not go down as utilization goes up
+    for h, w in itertools.product(range(grid[1]), range(grid[2])):
+        floor = 0.0
+        for u in range(grid[0]):
+            lat, count = fitted[(u, h, w)]
+            floor = max(floor, lat)
+            fitted[(u, h, w)] = (floor, count)
+    return fitted
+
+
+def drive():
+    if os.path.exists(config["samples"]):
+        os.remove(config["samples"])
+
+    script = os.path.abspath(__file__)
+    overrides = ["--%s=%s" % (k, v) for k, v in config.items() if k not in ("cores", "mem_freq", "footprint", "write_freq")]
+    for cores, mem_freq, footprint, write_freq in itertools.product(sweep_cores, sweep_mem_freq, sweep_footprint, sweep_write_freq):
+        args = overrides + ["--cores=%d" % cores, "--mem_freq=%d" % mem_freq, "--footprint=%s" % footprint, "--write_freq=%d" % write_freq]
+        print("analyticMemCalibration: cores=%d mem_freq=%d footprint=%s write_freq=%d" % (cores, mem_freq, footprint, write_freq))
+        result = subprocess.run([config["sst"], script, "--model-options=" + " ".join(args)],
+                stdout=subprocess.DEVNULL, stderr=subprocess.PIPE, universal_newlines=True)
+        if result.returncode != 0:
+            sys.exit("analyticMemCalibration: sst failed:\n" + result.stderr)
+
+    grid, cells = read_table(config["samples"])
+    write_table(config["output"], grid, fit(grid, cells))
+    print("analyticMemCalibration: wrote %s" % config["output"])
+
+
+try:
+    import sst
+    parse_args(sys.argv[1:])
+    build_sst()
+except ImportError:
+    if __name__ == "__main__":
+        parse_args(sys.argv[1:])
+        drive()
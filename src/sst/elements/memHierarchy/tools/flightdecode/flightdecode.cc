@@ -0,0 +1,174 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/*
+ * sst-memh-flightdecode: print a memHierarchy flight recorder dump
+ * ('<name>.flight') as text, oldest event first.
+ *
+ * usage: sst-memh-flightdecode [-a addr] [-n count] <file>...
+ *   -a addr   Only print events for this address (line base address, hex or decimal)
+ *   -n count  Only print the last 'count' matching events of each file
+ */
+
+#include <inttypes.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "sst/elements/memHierarchy/flightRecorder.h"
+
+using SST::MemHierarchy::FlightRecord;
+using SST::MemHierarchy::FlightRecorder;
+
+namespace {
+
+bool readU32(FILE* fp, uint32_t& val) {
+    return fread(&val, sizeof(val), 1, fp) == 1;
+}
+
+bool readString(FILE* fp, std::string& str) {
+    uint32_t len;
+    if (!readU32(fp, len))
+        return false;
+    str.resize(len);
+    return len == 0 || fread(&str[0], 1, len, fp) == len;
+}
+
+bool readNames(FILE* fp, std::vector<std::string>& names) {
+    uint32_t count;
+    if (!readU32(fp, count))
+        return false;
+    names.resize(count);
+    for (uint32_t i = 0; i < count; i++) {
+        if (!readString(fp, names[i]))
+            return false;
+    }
+    return true;
+}
+
+std::string lookup(const std::vector<std::string>& names, uint32_t index) {
+    if (index < names.size())
+        return names[index];
+    char buf[16];
+    snprintf(buf, sizeof(buf), "?%u", index);
+    return buf;
+}
+
+const char* actionName(uint8_t action) {
+    switch (action) {
+        case FlightRecorder::Recv:   return "Recv";
+        case FlightRecorder::Handle: return "Handle";
+        case FlightRecorder::Stall:  return "Stall";
+        case FlightRecorder::Send:   return "Send";
+        default:                     return "?";
+    }
+}
+
+/* Returns 0 on success, 1 if the file could not be read */
+int decode(const char* path, bool filterAddr, uint64_t addr, size_t last) {
+    FILE* fp = fopen(path, "rb");
+    if (!fp) {
+        fprintf(stderr, "%s: cannot be opened\n", path);
+        return 1;
+    }
+
+    char magic[4];
+    uint32_t version = 0;
+    std::string component;
+    uint64_t cycle = 0;
+    std::vector<std::string> cmds, states;
+    std::map<uint32_t, std::string> endpoints;
+    std::vector<FlightRecord> records;
+
+    bool ok = fread(magic, 1, 4, fp) == 4 && memcmp(magic, "MHFR", 4) == 0 && readU32(fp, version);
+    if (ok && version != FlightRecorder::VERSION) {
+        fprintf(stderr, "%s: unsupported version %u\n", path, version);
+        fclose(fp);
+        return 1;
+    }
+    ok = ok && readString(fp, component) && fread(&cycle, sizeof(cycle), 1, fp) == 1;
+    ok = ok && readNames(fp, cmds) && readNames(fp, states);
+
+    uint32_t count = 0;
+    ok = ok && readU32(fp, count);
+    for (uint32_t i = 0; ok && i < count; i++) {
+        uint32_t id;
+        std::string name;
+        ok = readU32(fp, id) && readString(fp, name);
+        endpoints[id] = name;
+    }
+
+    ok = ok && readU32(fp, count);
+    if (ok) {
+        records.resize(count);
+        ok = count == 0 || fread(&records[0], sizeof(FlightRecord), count, fp) == count;
+    }
+    fclose(fp);
+    if (!ok) {
+        fprintf(stderr, "%s: not a flight recorder file or truncated\n", path);
+        return 1;
+    }
+
+    std::vector<const FlightRecord*> shown;
+    for (size_t i = 0; i < records.size(); i++) {
+        if (!filterAddr || records[i].addr == addr)
+            shown.push_back(&records[i]);
+    }
+    size_t start = (last != 0 && shown.size() > last) ? shown.size() - last : 0;
+
+    printf("# %s: %zu of %zu events, dumped at cycle %" PRIu64 "\n", component.c_str(), shown.size() - start, records.size(), cycle);
+    printf("# %-18s %-7s %-14s %-18s %-8s %-10s %s\n", "cycle", "action", "cmd", "addr", "state", "event", "src -> dst");
+    for (size_t i = start; i < shown.size(); i++) {
+        const FlightRecord& r = *shown[i];
+        std::string state = r.state == FlightRecorder::NO_STATE ? "-" : lookup(states, r.state);
+        printf("%-20" PRIu64 " %-7s %-14s 0x%-16" PRIx64 " %-8s %-10" PRIu32 " %s -> %s\n",
+                r.cycle, actionName(r.action), lookup(cmds, r.cmd).c_str(), r.addr, state.c_str(), r.event,
+                endpoints[r.src].c_str(), endpoints[r.dst].c_str());
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    bool filterAddr = false;
+    uint64_t addr = 0;
+    size_t last = 0;
+    int arg = 1;
+
+    for (; arg < argc && argv[arg][0] == '-'; arg++) {
+        if (strcmp(argv[arg], "-a") == 0 && arg + 1 < argc) {
+            filterAddr = true;
+            addr = strtoull(argv[++arg], NULL, 0);
+        } else if (strcmp(argv[arg], "-n") == 0 && arg + 1 < argc) {
+            last = strtoull(argv[++arg], NULL, 0);
+        } else {
+            break;
+        }
+    }
+
+    if (arg >= argc) {
+        fprintf(stderr, "usage: sst-memh-flightdecode [-a addr] [-n count] <file>...\n");
+        exit(1);
+    }
+
+    int status = 0;
+    for (; arg < argc; arg++)
+        status |= decode(argv[arg], filterAddr, addr, last);
+    return status;
+}
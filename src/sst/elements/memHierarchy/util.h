@@ -25,16 +25,20 @@ using namespace std;
 namespace SST {
 namespace MemHierarchy {
 
-/* Debug macros */
+/* Debug macros
+ * debugEnabled is true only if sst-core was configured with --enable-debug.
+ * Guard debug-only work that is not already behind is_debug_addr/is_debug_event
+ * with 'if constexpr (debugEnabled)' so that it is compiled out of other builds
+ * but still type-checked.
+ */
 #ifdef __SST_DEBUG_OUTPUT__ /* From sst-core, enable with --enable-debug */
-#define is_debug_addr(addr) (DEBUG_ADDR.empty() || DEBUG_ADDR.find(addr) != DEBUG_ADDR.end())
-#define is_debug_event(ev) (DEBUG_ADDR.empty() || ev->doDebug(DEBUG_ADDR))
-#define is_debug true
+constexpr bool debugEnabled = true;
 #else
-#define is_debug_addr(addr) false
-#define is_debug_event(ev) false
-#define is_debug false
+constexpr bool debugEnabled = false;
 #endif
+#define is_debug_addr(addr) (SST::MemHierarchy::debugEnabled && (DEBUG_ADDR.empty() || DEBUG_ADDR.find(addr) != DEBUG_ADDR.end()))
+#define is_debug_event(ev) (SST::MemHierarchy::debugEnabled && (DEBUG_ADDR.empty() || ev->doDebug(DEBUG_ADDR)))
+#define is_debug SST::MemHierarchy::debugEnabled
 
 #define _INFO_ CALL_INFO,1,0
 #define _L2_ CALL_INFO,2,0      //Debug notes, potential error warnings, etc.
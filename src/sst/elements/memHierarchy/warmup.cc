@@ -0,0 +1,30 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+
+#include "sst/elements/memHierarchy/warmup.h"
+
+/* The single definition of the process-wide warmup flags (see warmup.h) */
+
+extern "C" __attribute__((visibility("default"))) std::atomic<bool>* sst_memh_warmup_roi_flag() {
+    static std::atomic<bool> flag(false);
+    return &flag;
+}
+
+extern "C" __attribute__((visibility("default"))) std::atomic<bool>* sst_memh_warmup_ended_flag() {
+    static std::atomic<bool> flag(false);
+    return &flag;
+}
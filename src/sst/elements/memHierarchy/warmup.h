@@ -0,0 +1,96 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_WARMUP_H
+#define MEMHIERARCHY_WARMUP_H
+
+#include <atomic>
+#include <dlfcn.h>
+
+/* Process-wide warmup flags, defined in warmup.cc. C linkage so that other
+ * element libraries can look them up with dlsym(). */
+extern "C" std::atomic<bool>* sst_memh_warmup_roi_flag();
+extern "C" std::atomic<bool>* sst_memh_warmup_ended_flag();
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ * Functional warmup state for a cache, directory, or memory controller
+ *
+ * During warmup a component keeps updating its functional state: tags,
+ * coherence state, replacement metadata, and the backing store. It does not
+ * model time:
+ *   - access, tag, and MSHR latencies are zero
+ *   - per-cycle request limits, bank conflicts, and link bandwidth limits are lifted
+ *   - MSHRs are unbounded, so requests never stall on a full MSHR
+ *   - memory controllers respond at once, without their timing backend
+ * Events still cross SST links, so link latencies still apply. Statistics
+ * keep counting during warmup. The first component in a process to leave
+ * warmup outputs all statistics, so warmup and the ROI fall in separate
+ * output periods. Set 'resetOnOutput' on a statistic to have the ROI period
+ * count only the ROI.
+ *
+ * A component leaves warmup at its 'warmup_end' time, or when the region of
+ * interest starts. The ROI starts when:
+ *   - a cache with 'warmup_roi_addr' set sees a request to that address
+ *   - an Ariel application calls ariel_enable() (use arielmode=1 so the code
+ *     before it is traced)
+ *   - a Vanadis core retires the instruction at 'roi_start_retire_address'
+ * The ROI flag is process-wide. It is defined once, in libmemHierarchy
+ * (warmup.cc), and other element libraries find it by name at run time, so
+ * they do not link against memHierarchy. Every component in the same
+ * process sees it on its next event. Multi-rank runs should use 'warmup_end'.
+ */
+class Warmup {
+    public:
+        Warmup() : active_(false) { }
+
+        bool active() const { return active_; }
+
+        void start() { active_ = true; }
+
+        /* Leave warmup. Returns false if warmup was already over. */
+        bool end() {
+            bool wasActive = active_;
+            active_ = false;
+            return wasActive;
+        }
+
+        /* Whether this component is in warmup but the ROI has started */
+        bool roiStarted() const { return active_ && sst_memh_warmup_roi_flag()->load(std::memory_order_relaxed); }
+
+        /* Start the ROI (from memHierarchy) */
+        static void startROI() { sst_memh_warmup_roi_flag()->store(true, std::memory_order_relaxed); }
+
+        /* Start the ROI from another element library (Ariel, Vanadis). The flag is
+         * looked up by name so the caller does not link against memHierarchy.
+         * Returns false if memHierarchy is not loaded in this process. */
+        static bool startROIExternal() {
+            typedef std::atomic<bool>* (*FlagFunc)();
+            FlagFunc func = (FlagFunc)dlsym(RTLD_DEFAULT, "sst_memh_warmup_roi_flag");
+            if (!func) return false;
+            func()->store(true, std::memory_order_relaxed);
+            return true;
+        }
+
+        /* True for the first caller in the process, which starts a new statistics output period */
+        static bool firstToEnd() { return !sst_memh_warmup_ended_flag()->exchange(true, std::memory_order_relaxed); }
+
+    private:
+        bool active_;
+};
+
+}}
+#endif // MEMHIERARCHY_WARMUP_H
@@ -20,6 +20,7 @@
 #include "velf/velfinfo.h"
 
 #include "os/resp/vosexitresp.h"
+#include "sst/elements/memHierarchy/warmup.h"
 
 #include <cstdio>
 #include <sst/core/output.h>
@@ -341,6 +342,7 @@ VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params)
 
     pause_on_retire_address = params.find<uint64_t>("pause_when_retire_address", 0);
     stop_verbose_when_retire_address = params.find<uint64_t>("stop_verbose_when_retire_address", 0);
+    roi_start_retire_address = params.find<uint64_t>("roi_start_retire_address", 0);
 
     setVerboseWhenIssueAddress( params.find<std::string>("start_verbose_when_issue_address", "") );
 
@@ -872,6 +874,12 @@ VANADIS_COMPONENT::performRetire(int rob_num, VanadisCircularQueue<VanadisInstru
                     output->setVerboseLevel(0);
                     output->setVerboseMask(-1);
                 }
+                if ( UNLIKELY(roi_start_retire_address > 0 && (rob_front->getInstructionAddress() == roi_start_retire_address)) ) {
+                    output->verbose(CALL_INFO, 1, 0, "Retired 0x%" PRIx64 ", starting the region of interest\n", roi_start_retire_address);
+                    if ( !SST::MemHierarchy::Warmup::startROIExternal() )
+                        output->verbose(CALL_INFO, 1, 0, "memHierarchy is not loaded, no warmup to end\n");
+                    roi_start_retire_address = 0;
+                }
                 if ( (pause_on_retire_address > 0) &&
                      (rob_front->getInstructionAddress() == pause_on_retire_address) ) {
 
@@ -992,6 +1000,12 @@ VANADIS_COMPONENT::performRetire(int rob_num, VanadisCircularQueue<VanadisInstru
                     output->setVerboseLevel(0);
                     output->setVerboseMask(-1);
                 }
+                if ( UNLIKELY(roi_start_retire_address > 0 && (rob_front->getInstructionAddress() == roi_start_retire_address)) ) {
+                    output->verbose(CALL_INFO, 1, 0, "Retired 0x%" PRIx64 ", starting the region of interest\n", roi_start_retire_address);
+                    if ( !SST::MemHierarchy::Warmup::startROIExternal() )
+                        output->verbose(CALL_INFO, 1, 0, "memHierarchy is not loaded, no warmup to end\n");
+                    roi_start_retire_address = 0;
+                }
             if ( UNLIKELY(
                      (pause_on_retire_address > 0) &&
                      (rob_front->getInstructionAddress() == pause_on_retire_address)) ) {
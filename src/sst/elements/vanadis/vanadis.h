@@ -136,6 +136,7 @@ public:
         { "retires_per_cycle", "Number of instruction retires per cycle" },
         { "decodes_per_cycle", "Number of instruction decodes per cycle" },
         { "print_retire_tables", "Print registers during retirement step (default is yes)" },
+        { "roi_start_retire_address", "Start the region of interest when an instruction at this address retires, ending functional warmup in memHierarchy components in this process. 0 to disable.", "0" },
         { "print_issue_tables", "Print registers during issue step (default is yes)" },
         { "print_int_reg", "Print integer registers true/false, auto set to true if verbose > 16" },
         { "print_fp_reg", "Print floating-point registers true/false, auto set to "
@@ -344,6 +345,7 @@ private:
     uint64_t pause_on_retire_address;
     std::deque<uint64_t> start_verbose_when_issue_address;
     uint64_t stop_verbose_when_retire_address;
+    uint64_t roi_start_retire_address;
 
     std::vector<VanadisFloatingPointFlags*> fp_flags;
 